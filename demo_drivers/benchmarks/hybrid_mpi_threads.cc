@@ -0,0 +1,201 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Benchmark for the hybrid MPI+threads execution model: Time the
+// assembly of the Jacobian and the distributed vector operations (dot
+// products, norms and updates) for a 3D Poisson problem. Run with the
+// same total number of cores split differently between MPI ranks and
+// threads, e.g.
+//
+//   OMP_NUM_THREADS=1  mpirun -np 128 ./hybrid_mpi_threads
+//   OMP_NUM_THREADS=8  mpirun -np 16  ./hybrid_mpi_threads
+//   OMP_NUM_THREADS=16 mpirun -np 8   ./hybrid_mpi_threads
+//
+// (the number of threads can also be set with --n_thread; the problem
+// size with --n_element). The library must be built with OpenMP
+// support for the threads to be used.
+
+// Generic oomph-lib routines
+#include "generic.h"
+
+// The Poisson equations
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_cubic_mesh.h"
+
+using namespace std;
+
+using namespace oomph;
+
+
+//===== start_of_namespace=============================================
+/// Namespace for the source function and the benchmark parameters
+//=====================================================================
+namespace TestSpace
+{
+  /// Source function
+  void get_source(const Vector<double>& x, double& source)
+  {
+    source = -1.0 + x[0] * x[1] * x[2];
+  }
+
+  /// Number of elements in each coordinate direction
+  unsigned N_element = 32;
+
+  /// Number of repetitions of the timed operations
+  unsigned N_repeat = 5;
+
+  /// Number of threads on each rank (0: use the OpenMP default)
+  unsigned N_thread = 0;
+
+} // end of namespace
+
+
+//====== start_of_problem_class=======================================
+/// 3D Poisson problem in a unit cube
+//====================================================================
+template<class ELEMENT>
+class PoissonBenchmarkProblem : public Problem
+{
+public:
+  /// Constructor: Build the mesh and pin the boundary values
+  PoissonBenchmarkProblem()
+  {
+    // Build the mesh
+    unsigned n = TestSpace::N_element;
+    Problem::mesh_pt() = new SimpleCubicMesh<ELEMENT>(n, n, n, 1.0, 1.0, 1.0);
+
+    // Pin the nodal values on the boundary
+    unsigned n_bound = mesh_pt()->nboundary();
+    for (unsigned b = 0; b < n_bound; b++)
+    {
+      unsigned n_node = mesh_pt()->nboundary_node(b);
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        mesh_pt()->boundary_node_pt(b, j)->pin(0);
+      }
+    }
+
+    // Set the source function
+    unsigned n_element = mesh_pt()->nelement();
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      ELEMENT* el_pt = dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+      el_pt->source_fct_pt() = &TestSpace::get_source;
+    }
+
+    // Setup equation numbering scheme
+    oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+  }
+
+  /// Update the problem specs before solve (empty)
+  void actions_before_newton_solve() {}
+
+  /// Update the problem specs after solve (empty)
+  void actions_after_newton_solve() {}
+
+}; // end of problem class
+
+
+//======start_of_main==================================================
+/// Time the assembly and the distributed linear algebra for a given
+/// split of the cores into MPI ranks and threads.
+//=====================================================================
+int main(int argc, char** argv)
+{
+  // Initialise MPI (with thread support if required)
+  MPI_Helpers::init(argc, argv);
+
+  // Store command line arguments
+  CommandLineArgs::setup(argc, argv);
+  CommandLineArgs::specify_command_line_flag(
+    "--n_element", &TestSpace::N_element, "Elements in each direction");
+  CommandLineArgs::specify_command_line_flag(
+    "--n_repeat", &TestSpace::N_repeat, "Repetitions of timed operations");
+  CommandLineArgs::specify_command_line_flag(
+    "--n_thread", &TestSpace::N_thread, "Number of threads on each rank");
+  CommandLineArgs::parse_and_assign();
+  CommandLineArgs::doc_specified_flags();
+
+  // Only output from the root processor
+  oomph_mpi_output.restrict_output_to_single_processor();
+
+  // Set the number of threads on each rank
+  if (TestSpace::N_thread != 0)
+  {
+    ThreadingHelpers::set_nthread(TestSpace::N_thread);
+  }
+
+  // Build and distribute the problem
+  PoissonBenchmarkProblem<QPoissonElement<3, 2>> problem;
+  problem.distribute();
+  problem.enable_threaded_assembly();
+
+  OomphCommunicator* comm_pt = MPI_Helpers::communicator_pt();
+  unsigned n_repeat = TestSpace::N_repeat;
+
+  // Time the assembly of the residuals and the Jacobian
+  DoubleVector residuals;
+  CRDoubleMatrix jacobian;
+  MPI_Barrier(comm_pt->mpi_comm());
+  double t_start = TimingHelpers::timer();
+  for (unsigned r = 0; r < n_repeat; r++)
+  {
+    problem.get_jacobian(residuals, jacobian);
+  }
+  double t_assembly = (TimingHelpers::timer() - t_start) / double(n_repeat);
+
+  // Time the distributed vector operations (the matrix-vector product
+  // for distributed matrices requires Trilinos, so it isn't timed here)
+  DoubleVector y(residuals.distribution_pt(), 1.0);
+  double dot = 0.0;
+  MPI_Barrier(comm_pt->mpi_comm());
+  t_start = TimingHelpers::timer();
+  for (unsigned r = 0; r < n_repeat; r++)
+  {
+    y += residuals;
+    y *= 0.5;
+    dot += y.dot(residuals) / y.norm();
+  }
+  double t_linear_algebra =
+    (TimingHelpers::timer() - t_start) / double(n_repeat);
+
+  // Report the slowest rank
+  double t_local[2] = {t_assembly, t_linear_algebra};
+  double t_max[2];
+  MPI_Reduce(t_local, t_max, 2, MPI_DOUBLE, MPI_MAX, 0, comm_pt->mpi_comm());
+  oomph_info << "Ranks x threads: " << comm_pt->nproc() << " x "
+             << ThreadingHelpers::nthread() << std::endl
+             << "MPI thread support level: "
+             << MPI_Helpers::mpi_thread_support_level() << std::endl
+             << "Time for assembly [sec]: " << t_max[0] << std::endl
+             << "Time for vector operations [sec]: " << t_max[1] << std::endl
+             << "(check sum: " << dot << ")" << std::endl;
+
+  // Shut down MPI
+  MPI_Helpers::finalize();
+
+} // end of main
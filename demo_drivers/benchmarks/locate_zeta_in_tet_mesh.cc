@@ -0,0 +1,182 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Benchmark for the bin-based locate_zeta(...) in 3D tet meshes: Time
+// the setup of the sample point container and the location of (by
+// default) 10^6 randomly distributed points, with and without the
+// element bounding-box prefilter. Run with, e.g.,
+//
+//   OMP_NUM_THREADS=8 ./locate_zeta_in_tet_mesh --n_element 20
+//
+// (the threads are only used for the setup of the bin array).
+
+// Generic oomph-lib routines
+#include "generic.h"
+
+// The Poisson equations
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_cubic_tet_mesh.h"
+
+using namespace std;
+
+using namespace oomph;
+
+
+//===== start_of_namespace=============================================
+/// Namespace for the benchmark parameters
+//=====================================================================
+namespace TestSpace
+{
+  /// Number of (cubic) cells in each coordinate direction; each cell is
+  /// split into tets
+  unsigned N_element = 10;
+
+  /// Number of points to be located
+  unsigned N_query = 1000000;
+
+} // end of namespace
+
+
+//=====================================================================
+/// Locate the points in zeta in the mesh, using (or not) the element
+/// bounding-box prefilter. Return the number of points that were found
+/// and the maximum difference between the points and the positions
+/// computed from the located elements and local coordinates; doc the
+/// timings.
+//=====================================================================
+unsigned locate_points(Mesh* mesh_pt,
+                       const Vector<Vector<double>>& zeta,
+                       const bool& use_bounding_box_prefilter,
+                       double& max_error)
+{
+  SamplePointContainer::Use_element_bounding_box_prefilter =
+    use_bounding_box_prefilter;
+
+  // Set up the sample point container
+  double t_start = TimingHelpers::timer();
+  MeshAsGeomObject* mesh_geom_obj_pt = new MeshAsGeomObject(mesh_pt);
+  double t_setup = TimingHelpers::timer() - t_start;
+
+  // Locate the points
+  unsigned n_query = zeta.size();
+  unsigned n_found = 0;
+  max_error = 0.0;
+  Vector<double> s(3);
+  Vector<double> x(3);
+  GeomObject* sub_geom_obj_pt = 0;
+  t_start = TimingHelpers::timer();
+  for (unsigned q = 0; q < n_query; q++)
+  {
+    mesh_geom_obj_pt->locate_zeta(zeta[q], sub_geom_obj_pt, s);
+    if (sub_geom_obj_pt != 0)
+    {
+      n_found++;
+      sub_geom_obj_pt->position(s, x);
+      for (unsigned i = 0; i < 3; i++)
+      {
+        max_error = std::max(max_error, std::fabs(x[i] - zeta[q][i]));
+      }
+    }
+  }
+  double t_locate = TimingHelpers::timer() - t_start;
+
+  oomph_info << "Bounding-box prefilter: "
+             << (use_bounding_box_prefilter ? "on" : "off") << std::endl
+             << "  Time for setup of sample point container [sec]: "
+             << t_setup << std::endl
+             << "  Time for " << n_query << " calls to locate_zeta [sec]: "
+             << t_locate << std::endl
+             << "  Time per call [microsec]: "
+             << 1.0e6 * t_locate / double(n_query) << std::endl
+             << "  Number of points located: " << n_found << std::endl
+             << "  Max. error in located positions: " << max_error
+             << std::endl;
+
+  delete mesh_geom_obj_pt;
+  return n_found;
+}
+
+
+//======start_of_main==================================================
+/// Time the setup of the sample point container and the location of
+/// randomly distributed points in a 3D tet mesh.
+//=====================================================================
+int main(int argc, char** argv)
+{
+#ifdef OOMPH_HAS_MPI
+  MPI_Helpers::init(argc, argv);
+#endif
+
+  // Store command line arguments
+  CommandLineArgs::setup(argc, argv);
+  CommandLineArgs::specify_command_line_flag(
+    "--n_element", &TestSpace::N_element, "Cells in each direction");
+  CommandLineArgs::specify_command_line_flag(
+    "--n_query", &TestSpace::N_query, "Number of points to be located");
+  CommandLineArgs::parse_and_assign();
+  CommandLineArgs::doc_specified_flags();
+
+  // Build the mesh of quadratic tets in the unit cube
+  unsigned n = TestSpace::N_element;
+  Mesh* mesh_pt =
+    new SimpleCubicTetMesh<TPoissonElement<3, 3>>(n, n, n, 1.0, 1.0, 1.0);
+  oomph_info << "Number of elements: " << mesh_pt->nelement() << std::endl;
+
+  // Randomly distributed points in the interior of the cube (with a
+  // fixed seed so the runs are reproducible)
+  srand(1234);
+  unsigned n_query = TestSpace::N_query;
+  Vector<Vector<double>> zeta(n_query, Vector<double>(3));
+  for (unsigned q = 0; q < n_query; q++)
+  {
+    for (unsigned i = 0; i < 3; i++)
+    {
+      zeta[q][i] = 0.001 + 0.998 * double(rand()) / double(RAND_MAX);
+    }
+  }
+
+  // Time the location with and without the prefilter
+  double max_error = 0.0;
+  bool use_bounding_box_prefilter = false;
+  unsigned n_found_without_prefilter =
+    locate_points(mesh_pt, zeta, use_bounding_box_prefilter, max_error);
+  use_bounding_box_prefilter = true;
+  unsigned n_found_with_prefilter =
+    locate_points(mesh_pt, zeta, use_bounding_box_prefilter, max_error);
+
+  if (n_found_with_prefilter != n_found_without_prefilter)
+  {
+    oomph_info << "Warning: Number of located points differs!" << std::endl;
+  }
+
+  delete mesh_pt;
+
+#ifdef OOMPH_HAS_MPI
+  MPI_Helpers::finalize();
+#endif
+
+} // end of main
@@ -0,0 +1,186 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Startup benchmark for the deferred setup of the lookup schemes for
+// the elements next to the mesh boundaries: Time the construction of
+// structured meshes with the setup deferred until the schemes are first
+// accessed (the default) and done eagerly. Run with, e.g.,
+//
+//   ./mesh_construction --n_element 12 --n_repeat 5
+
+// Generic oomph-lib routines
+#include "generic.h"
+
+// The Poisson equations
+#include "poisson.h"
+
+// The meshes
+#include "meshes/simple_cubic_mesh.h"
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+
+using namespace oomph;
+
+
+//===== start_of_namespace=============================================
+/// Namespace for the benchmark parameters
+//=====================================================================
+namespace TestSpace
+{
+  /// Number of elements in each coordinate direction of the 3D mesh
+  /// (the 2D mesh has ten times as many)
+  unsigned N_element = 12;
+
+  /// Number of meshes built for each timing
+  unsigned N_repeat = 5;
+
+  /// Build a 3D mesh of trilinear bricks in the unit cube
+  Mesh* build_cubic_mesh()
+  {
+    return new SimpleCubicMesh<QPoissonElement<3, 2>>(
+      N_element, N_element, N_element, 1.0, 1.0, 1.0);
+  }
+
+  /// Build a 2D mesh of bilinear quads in the unit square
+  Mesh* build_quad_mesh()
+  {
+    return new SimpleRectangularQuadMesh<QPoissonElement<2, 2>>(
+      10 * N_element, 10 * N_element, 1.0, 1.0);
+  }
+
+  /// Function pointer to a function that builds a mesh
+  typedef Mesh* (*BuildMeshFctPt)();
+
+} // end of namespace
+
+
+//=====================================================================
+/// Build (and delete) TestSpace::N_repeat meshes with the function
+/// pointed to by build_mesh_fct_pt, with the setup of the boundary
+/// lookup schemes deferred or done eagerly (by switching
+/// Mesh::Setup_boundary_element_info_on_demand). Return the average
+/// construction time (in seconds) and the total number of boundary
+/// elements of the last mesh (accessed after the timing, so that
+/// a deferred setup is done then).
+//=====================================================================
+double time_mesh_construction(TestSpace::BuildMeshFctPt build_mesh_fct_pt,
+                              const bool& defer_setup,
+                              unsigned& n_boundary_element)
+{
+  // Remember the current setting
+  bool setup_on_demand_backup = Mesh::Setup_boundary_element_info_on_demand;
+  Mesh::Setup_boundary_element_info_on_demand = defer_setup;
+
+  double t_total = 0.0;
+  n_boundary_element = 0;
+  unsigned n_repeat = std::max(TestSpace::N_repeat, unsigned(1));
+  for (unsigned r = 0; r < n_repeat; r++)
+  {
+    double t_start = TimingHelpers::timer();
+    Mesh* mesh_pt = build_mesh_fct_pt();
+    t_total += TimingHelpers::timer() - t_start;
+
+    // Check that the lookup schemes are (set up) on first access
+    if (r == n_repeat - 1)
+    {
+      unsigned n_bound = mesh_pt->nboundary();
+      for (unsigned b = 0; b < n_bound; b++)
+      {
+        n_boundary_element += mesh_pt->nboundary_element(b);
+      }
+    }
+    delete mesh_pt;
+  }
+
+  // Reset
+  Mesh::Setup_boundary_element_info_on_demand = setup_on_demand_backup;
+
+  return t_total / double(n_repeat);
+}
+
+
+//=====================================================================
+/// Time the construction of the mesh built by build_mesh_fct_pt
+/// with deferred and eager setup of the boundary lookup schemes
+/// and doc the results.
+//=====================================================================
+void doc_mesh_construction(const std::string& label,
+                           TestSpace::BuildMeshFctPt build_mesh_fct_pt)
+{
+  bool defer_setup = true;
+  unsigned n_boundary_element_deferred = 0;
+  double t_deferred = time_mesh_construction(
+    build_mesh_fct_pt, defer_setup, n_boundary_element_deferred);
+  defer_setup = false;
+  unsigned n_boundary_element_eager = 0;
+  double t_eager = time_mesh_construction(
+    build_mesh_fct_pt, defer_setup, n_boundary_element_eager);
+
+  oomph_info << label << ":" << std::endl
+             << "  Construction time with deferred setup [sec]: "
+             << t_deferred << std::endl
+             << "  Construction time with eager setup [sec]:    " << t_eager
+             << std::endl
+             << "  Number of boundary elements (deferred/eager): "
+             << n_boundary_element_deferred << " / "
+             << n_boundary_element_eager << std::endl;
+
+  if (n_boundary_element_deferred != n_boundary_element_eager)
+  {
+    oomph_info << "Warning: Number of boundary elements differs!"
+               << std::endl;
+  }
+}
+
+
+//======start_of_main==================================================
+/// Time the construction of structured meshes with deferred and eager
+/// setup of the lookup schemes for the elements next to the boundaries.
+//=====================================================================
+int main(int argc, char** argv)
+{
+#ifdef OOMPH_HAS_MPI
+  MPI_Helpers::init(argc, argv);
+#endif
+
+  // Store command line arguments
+  CommandLineArgs::setup(argc, argv);
+  CommandLineArgs::specify_command_line_flag(
+    "--n_element", &TestSpace::N_element, "Elements in each direction");
+  CommandLineArgs::specify_command_line_flag(
+    "--n_repeat", &TestSpace::N_repeat, "Number of meshes for each timing");
+  CommandLineArgs::parse_and_assign();
+  CommandLineArgs::doc_specified_flags();
+
+  doc_mesh_construction("SimpleCubicMesh", &TestSpace::build_cubic_mesh);
+  doc_mesh_construction("SimpleRectangularQuadMesh",
+                        &TestSpace::build_quad_mesh);
+
+#ifdef OOMPH_HAS_MPI
+  MPI_Helpers::finalize();
+#endif
+
+} // end of main
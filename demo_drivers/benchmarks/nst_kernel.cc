@@ -0,0 +1,295 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Self-test and micro-benchmark for the optimised (fixed-size) assembly
+// kernels of the Navier-Stokes elements: Compare the residuals, Jacobian
+// and mass matrix computed by the optimised and the generic kernels
+// (for random nodal values and positions, so the time-derivative and
+// ALE terms are exercised) and time the two kernels. Run with, e.g.,
+//
+//   ./nst_kernel --n_repeat 1000
+
+// Generic oomph-lib routines
+#include "generic.h"
+
+// The Navier-Stokes equations
+#include "navier_stokes.h"
+
+// The meshes
+#include "meshes/simple_rectangular_quadmesh.h"
+#include "meshes/simple_cubic_mesh.h"
+
+using namespace std;
+
+using namespace oomph;
+
+
+//===== start_of_namespace=============================================
+/// Namespace for the benchmark parameters
+//=====================================================================
+namespace TestSpace
+{
+  /// Number of evaluations of the kernels per element for the timings
+  unsigned N_repeat = 1000;
+
+  /// Reynolds number
+  double Re = 100.0;
+
+  /// Womersley number
+  double ReSt = 100.0;
+
+  /// Reynolds number divided by the Froude number
+  double ReInvFr = 10.0;
+
+  /// Direction of gravity
+  Vector<double> G;
+
+  /// Random number between -1 and 1
+  double random_value()
+  {
+    return 2.0 * double(rand()) / double(RAND_MAX) - 1.0;
+  }
+
+} // end of namespace
+
+
+//=====================================================================
+/// Consistency check for the optimised assembly kernel of the element:
+/// Compute the residuals, Jacobian and mass matrix with the optimised and
+/// the generic kernels and return the maximum absolute difference
+/// between the two.
+//=====================================================================
+template<unsigned DIM>
+double max_error_of_optimised_kernel(NavierStokesEquations<DIM>* el_pt)
+{
+  // Storage for the results from the two kernels
+  unsigned n_dof = el_pt->ndof();
+  Vector<double> residuals_generic(n_dof), residuals_optimised(n_dof);
+  DenseMatrix<double> jacobian_generic(n_dof), jacobian_optimised(n_dof);
+  DenseMatrix<double> mass_matrix_generic(n_dof);
+  DenseMatrix<double> mass_matrix_optimised(n_dof);
+
+  // Compute everything with the generic kernel...
+  NavierStokesEquations<DIM>::disable_optimised_nst_kernel();
+  el_pt->get_jacobian_and_mass_matrix(
+    residuals_generic, jacobian_generic, mass_matrix_generic);
+
+  // ...and with the optimised one
+  NavierStokesEquations<DIM>::enable_optimised_nst_kernel();
+  el_pt->get_jacobian_and_mass_matrix(
+    residuals_optimised, jacobian_optimised, mass_matrix_optimised);
+
+  // Find the maximum difference
+  double max_error = 0.0;
+  for (unsigned i = 0; i < n_dof; i++)
+  {
+    max_error = std::max(
+      max_error, std::fabs(residuals_generic[i] - residuals_optimised[i]));
+    for (unsigned j = 0; j < n_dof; j++)
+    {
+      max_error =
+        std::max(max_error,
+                 std::fabs(jacobian_generic(i, j) - jacobian_optimised(i, j)));
+      max_error = std::max(
+        max_error,
+        std::fabs(mass_matrix_generic(i, j) - mass_matrix_optimised(i, j)));
+    }
+  }
+  return max_error;
+}
+
+
+//=====================================================================
+/// Compute the residuals and Jacobian of the element
+/// TestSpace::N_repeat times with the current kernel and return the
+/// average time per evaluation (in seconds).
+//=====================================================================
+template<unsigned DIM>
+double time_kernel(NavierStokesEquations<DIM>* el_pt)
+{
+  unsigned n_dof = el_pt->ndof();
+  Vector<double> residuals(n_dof);
+  DenseMatrix<double> jacobian(n_dof);
+  unsigned n_repeat = std::max(TestSpace::N_repeat, unsigned(1));
+  double t_start = TimingHelpers::timer();
+  for (unsigned r = 0; r < n_repeat; r++)
+  {
+    el_pt->get_jacobian(residuals, jacobian);
+  }
+  return (TimingHelpers::timer() - t_start) / double(n_repeat);
+}
+
+
+//=====================================================================
+/// Check and time the kernels for the elements of type ELEMENT in the
+/// mesh (whose nodes must have a BDF<2> timestepper) and doc the results.
+//=====================================================================
+template<class ELEMENT, unsigned DIM>
+void check_and_time_kernels(const std::string& label,
+                            Mesh* mesh_pt,
+                            Problem* problem_pt)
+{
+  // Random values and positions at all time levels
+  unsigned n_node = mesh_pt->nnode();
+  for (unsigned j = 0; j < n_node; j++)
+  {
+    Node* nod_pt = mesh_pt->node_pt(j);
+    unsigned n_time = nod_pt->ntstorage();
+    for (unsigned t = 0; t < n_time; t++)
+    {
+      for (unsigned i = 0; i < nod_pt->nvalue(); i++)
+      {
+        nod_pt->set_value(t, i, TestSpace::random_value());
+      }
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        nod_pt->x(t, i) += 0.01 * TestSpace::random_value();
+      }
+    }
+  }
+
+  // Set the physical parameters and random internal (pressure) values
+  TestSpace::G.resize(DIM, 0.0);
+  TestSpace::G[DIM - 1] = -1.0;
+  unsigned n_element = mesh_pt->nelement();
+  for (unsigned e = 0; e < n_element; e++)
+  {
+    ELEMENT* el_pt = dynamic_cast<ELEMENT*>(mesh_pt->element_pt(e));
+    el_pt->re_pt() = &TestSpace::Re;
+    el_pt->re_st_pt() = &TestSpace::ReSt;
+    el_pt->re_invfr_pt() = &TestSpace::ReInvFr;
+    el_pt->g_pt() = &TestSpace::G;
+    unsigned n_internal = el_pt->ninternal_data();
+    for (unsigned i = 0; i < n_internal; i++)
+    {
+      Data* data_pt = el_pt->internal_data_pt(i);
+      for (unsigned k = 0; k < data_pt->nvalue(); k++)
+      {
+        data_pt->set_value(k, TestSpace::random_value());
+      }
+    }
+  }
+  problem_pt->assign_eqn_numbers();
+
+  // Check all elements
+  double max_error = 0.0;
+  for (unsigned e = 0; e < n_element; e++)
+  {
+    ELEMENT* el_pt = dynamic_cast<ELEMENT*>(mesh_pt->element_pt(e));
+    max_error = std::max(max_error, max_error_of_optimised_kernel(el_pt));
+  }
+
+  // Time the kernels for the first element
+  ELEMENT* el_pt = dynamic_cast<ELEMENT*>(mesh_pt->element_pt(0));
+  NavierStokesEquations<DIM>::disable_optimised_nst_kernel();
+  double t_generic = time_kernel(el_pt);
+  NavierStokesEquations<DIM>::enable_optimised_nst_kernel();
+  double t_optimised = time_kernel(el_pt);
+
+  oomph_info << label << ":" << std::endl
+             << "  Max. difference between the kernels: " << max_error
+             << std::endl
+             << "  Time per element with generic kernel [microsec]:   "
+             << 1.0e6 * t_generic << std::endl
+             << "  Time per element with optimised kernel [microsec]: "
+             << 1.0e6 * t_optimised << std::endl
+             << "  Speedup: " << t_generic / t_optimised << std::endl;
+}
+
+
+//=====================================================================
+/// Problem that holds the timestepper and the meshes
+//=====================================================================
+class KernelProblem : public Problem
+{
+public:
+  /// Constructor: Build the timestepper
+  KernelProblem()
+  {
+    add_time_stepper_pt(new BDF<2>);
+    initialise_dt(0.1);
+  }
+
+  /// Build a mesh of the specified type and make it the problem's mesh
+  /// (the previous one is deleted)
+  template<class MESH>
+  MESH* build_mesh(MESH* mesh_pt)
+  {
+    delete this->mesh_pt();
+    this->mesh_pt() = mesh_pt;
+    return mesh_pt;
+  }
+};
+
+
+//======start_of_main==================================================
+/// Check and time the optimised assembly kernels of the 2D and 3D
+/// Crouzeix-Raviart and Taylor-Hood elements.
+//=====================================================================
+int main(int argc, char** argv)
+{
+#ifdef OOMPH_HAS_MPI
+  MPI_Helpers::init(argc, argv);
+#endif
+
+  // Store command line arguments
+  CommandLineArgs::setup(argc, argv);
+  CommandLineArgs::specify_command_line_flag(
+    "--n_repeat", &TestSpace::N_repeat, "Evaluations per timing");
+  CommandLineArgs::parse_and_assign();
+  CommandLineArgs::doc_specified_flags();
+
+  // Fixed seed so the runs are reproducible
+  srand(1234);
+
+  KernelProblem problem;
+  TimeStepper* time_stepper_pt = problem.time_stepper_pt();
+
+  problem.build_mesh(
+    new SimpleRectangularQuadMesh<QCrouzeixRaviartElement<2>>(
+      4, 4, 1.0, 1.0, time_stepper_pt));
+  check_and_time_kernels<QCrouzeixRaviartElement<2>, 2>(
+    "QCrouzeixRaviartElement<2>", problem.mesh_pt(), &problem);
+
+  problem.build_mesh(new SimpleRectangularQuadMesh<QTaylorHoodElement<2>>(
+    4, 4, 1.0, 1.0, time_stepper_pt));
+  check_and_time_kernels<QTaylorHoodElement<2>, 2>(
+    "QTaylorHoodElement<2>", problem.mesh_pt(), &problem);
+
+  problem.build_mesh(new SimpleCubicMesh<QCrouzeixRaviartElement<3>>(
+    2, 2, 2, 1.0, 1.0, 1.0, time_stepper_pt));
+  check_and_time_kernels<QCrouzeixRaviartElement<3>, 3>(
+    "QCrouzeixRaviartElement<3>", problem.mesh_pt(), &problem);
+
+  problem.build_mesh(new SimpleCubicMesh<QTaylorHoodElement<3>>(
+    2, 2, 2, 1.0, 1.0, 1.0, time_stepper_pt));
+  check_and_time_kernels<QTaylorHoodElement<3>, 3>(
+    "QTaylorHoodElement<3>", problem.mesh_pt(), &problem);
+
+#ifdef OOMPH_HAS_MPI
+  MPI_Helpers::finalize();
+#endif
+
+} // end of main
@@ -201,6 +201,56 @@ namespace oomph
       }
     }
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      if (i > DIM)
+      {
+        std::stringstream error_stream;
+        error_stream << "Advection Diffusion Elements only store " << DIM + 1
+                     << " fields " << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Vector of local and Eulerian coordinates
+      Vector<double> s(DIM);
+      Vector<double> x(DIM);
+
+      // Storage for the wind
+      Vector<double> wind(DIM);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Winds
+        if (i < DIM)
+        {
+          // Get Eulerian coordinate of plot point
+          interpolated_x(s, x);
+
+          // Dummy ipt argument
+          unsigned ipt = 0;
+          get_wind_adv_diff(ipt, s, x, wind);
+          value[iplot] = wind[i];
+        }
+        // Advection Diffusion
+        else
+        {
+          value[iplot] = interpolated_u_adv_diff(s);
+        }
+      }
+    }
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
@@ -212,6 +212,56 @@ namespace oomph
       }
     }
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      if (i > 3)
+      {
+        std::stringstream error_stream;
+        error_stream << "Advection Diffusion Elements only store 4 fields "
+                     << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Vector of local and Eulerian coordinates
+      Vector<double> s(2);
+      Vector<double> x(2);
+
+      // Storage for the wind
+      Vector<double> wind(3);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Winds
+        if (i < 3)
+        {
+          // Get Eulerian coordinate of plot point
+          interpolated_x(s, x);
+
+          // Dummy ipt argument
+          unsigned ipt = 0;
+          get_wind_axi_adv_diff(ipt, s, x, wind);
+          value[iplot] = wind[i];
+        }
+        // Advection Diffusion
+        else
+        {
+          value[iplot] = this->interpolated_u_axi_adv_diff(s);
+        }
+      }
+    }
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
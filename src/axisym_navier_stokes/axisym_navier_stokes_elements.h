@@ -765,6 +765,47 @@ namespace oomph
       }
     }
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      if (i > 3)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Axisymmetric Navier-Stokes Elements only store 4 fields "
+          << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Vector of local coordinates
+      Vector<double> s(2);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Velocities
+        if (i < 3)
+        {
+          value[iplot] = interpolated_u_axi_nst(s, i);
+        }
+        // Pressure
+        else
+        {
+          value[iplot] = interpolated_p_axi_nst(s);
+        }
+      }
+    }
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
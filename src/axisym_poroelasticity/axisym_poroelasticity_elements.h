@@ -1115,6 +1115,66 @@ namespace oomph
       }
     }
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      if (i > 7)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Axisymmetric poroelasticity elements only store 8 fields "
+          << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Vector of local coordinates
+      Vector<double> s(2);
+
+      // Skeleton velocity
+      Vector<double> du_dt(2);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Displacements
+        if (i < 2)
+        {
+          value[iplot] = interpolated_u(s, i);
+        }
+        // Flux
+        else if (i < 4)
+        {
+          value[iplot] = interpolated_q(s, i - 2);
+        }
+        // Divergence of flux
+        else if (i == 4)
+        {
+          value[iplot] = interpolated_div_q(s);
+        }
+        // Pressure
+        else if (i == 5)
+        {
+          value[iplot] = interpolated_p(s);
+        }
+        // Skeleton velocity
+        else
+        {
+          interpolated_du_dt(s, du_dt);
+          value[iplot] = du_dt[i - 6];
+        }
+      }
+    }
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
@@ -0,0 +1,481 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline member functions for asynchronous (background) output
+
+#include <fstream>
+#include <sstream>
+
+#include "async_output.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// Constructor: Specify the maximum number of output files that may
+  /// be pending. Starts the background thread (only once the arguments
+  /// have been checked: a thread that's still joinable when it's
+  /// destroyed during stack unwinding would terminate the program).
+  //====================================================================
+  AsyncOutputWriter::AsyncOutputWriter(const unsigned& max_npending)
+    : Max_npending(max_npending),
+      Background_writing_enabled(true),
+      Writing(false),
+      Shutdown(false),
+      Background_error_message("")
+  {
+#ifdef PARANOID
+    if (max_npending == 0)
+    {
+      throw OomphLibError("The maximum number of pending output files must "
+                          "be positive.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    Background_thread =
+      std::thread(&AsyncOutputWriter::write_pending_output, this);
+  }
+
+
+  //====================================================================
+  /// Destructor: Write all pending output and terminate the
+  /// background thread
+  //====================================================================
+  AsyncOutputWriter::~AsyncOutputWriter()
+  {
+    {
+      std::unique_lock<std::mutex> lock(Queue_mutex);
+      Shutdown = true;
+    }
+    Queue_changed.notify_all();
+    Background_thread.join();
+
+    // Can't throw from the destructor
+    if (Background_error_message != "")
+    {
+      OomphLibWarning(Background_error_message,
+                      OOMPH_CURRENT_FUNCTION,
+                      OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
+  //====================================================================
+  /// Set the maximum number of pending output files
+  //====================================================================
+  void AsyncOutputWriter::set_max_npending(const unsigned& max_npending)
+  {
+#ifdef PARANOID
+    if (max_npending == 0)
+    {
+      throw OomphLibError("The maximum number of pending output files must "
+                          "be positive.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+    {
+      std::unique_lock<std::mutex> lock(Queue_mutex);
+      Max_npending = max_npending;
+    }
+
+    // Blocked submissions may now be able to proceed
+    Queue_changed.notify_all();
+  }
+
+
+  //====================================================================
+  /// Number of output files that are waiting to be written
+  //====================================================================
+  unsigned AsyncOutputWriter::npending()
+  {
+    std::unique_lock<std::mutex> lock(Queue_mutex);
+    return Pending_output.size();
+  }
+
+
+  //====================================================================
+  /// Queue the specified contents for writing to the specified file.
+  /// The contents are swapped out to avoid copying. Blocks if the
+  /// maximum number of pending output files has been reached.
+  //====================================================================
+  void AsyncOutputWriter::submit(const std::string& filename,
+                                 std::string& contents,
+                                 const bool& binary,
+                                 const bool& append)
+  {
+    PendingOutput output;
+    output.Filename = filename;
+    output.Contents.swap(contents);
+    output.Binary = binary;
+    output.Append = append;
+    enqueue(output);
+  }
+
+
+  //====================================================================
+  /// Write the specified output on the calling thread (if background
+  /// writing is disabled) or add it to the queue. Blocks if the
+  /// maximum number of pending output files has been reached.
+  /// Ownership of the output's contents (and paraview data) is
+  /// taken over.
+  //====================================================================
+  void AsyncOutputWriter::enqueue(PendingOutput& output)
+  {
+    // Write on the calling thread
+    if (!Background_writing_enabled)
+    {
+      std::string error_message = write(output);
+      delete output.Paraview_binary_data_pt;
+      output.Paraview_binary_data_pt = 0;
+      if (error_message != "")
+      {
+        throw OomphLibError(
+          error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(Queue_mutex);
+
+      // Back-pressure: Wait until there's space in the queue
+      while (Pending_output.size() >= Max_npending)
+      {
+        Queue_changed.wait(lock);
+      }
+      try
+      {
+        report_background_error();
+      }
+      catch (...)
+      {
+        delete output.Paraview_binary_data_pt;
+        output.Paraview_binary_data_pt = 0;
+        throw;
+      }
+
+      Pending_output.push_back(PendingOutput());
+      Pending_output.back().Filename = output.Filename;
+      Pending_output.back().Contents.swap(output.Contents);
+      Pending_output.back().Binary = output.Binary;
+      Pending_output.back().Append = output.Append;
+      Pending_output.back().Paraview_binary_data_pt =
+        output.Paraview_binary_data_pt;
+      output.Paraview_binary_data_pt = 0;
+    }
+    Queue_changed.notify_all();
+  }
+
+
+  //====================================================================
+  /// Tecplot-style output of the mesh
+  //====================================================================
+  void AsyncOutputWriter::output(Mesh* mesh_pt,
+                                 const std::string& filename,
+                                 const unsigned& nplot)
+  {
+    std::ostringstream buffer;
+    mesh_pt->output(buffer, nplot);
+    std::string contents = buffer.str();
+    submit(filename, contents);
+  }
+
+
+  //====================================================================
+  /// Output of the mesh and the exact (steady) solution
+  //====================================================================
+  void AsyncOutputWriter::output_fct(
+    Mesh* mesh_pt,
+    const std::string& filename,
+    const unsigned& nplot,
+    FiniteElement::SteadyExactSolutionFctPt exact_soln_pt)
+  {
+    std::ostringstream buffer;
+    mesh_pt->output_fct(buffer, nplot, exact_soln_pt);
+    std::string contents = buffer.str();
+    submit(filename, contents);
+  }
+
+
+  //====================================================================
+  /// Output of the mesh and the exact (unsteady) solution
+  //====================================================================
+  void AsyncOutputWriter::output_fct(
+    Mesh* mesh_pt,
+    const std::string& filename,
+    const unsigned& nplot,
+    const double& time,
+    FiniteElement::UnsteadyExactSolutionFctPt exact_soln_pt)
+  {
+    std::ostringstream buffer;
+    mesh_pt->output_fct(buffer, nplot, time, exact_soln_pt);
+    std::string contents = buffer.str();
+    submit(filename, contents);
+  }
+
+
+  //====================================================================
+  /// Paraview output of the mesh. Mesh::output_paraview(...) requires
+  /// an ofstream so we redirect the stream's buffer to a string buffer.
+  //====================================================================
+  void AsyncOutputWriter::output_paraview(Mesh* mesh_pt,
+                                          const std::string& filename,
+                                          const unsigned& nplot)
+  {
+    std::ofstream buffered_file;
+    std::stringbuf string_buffer;
+    std::streambuf* backed_up_buffer_pt =
+      static_cast<std::ostream&>(buffered_file).rdbuf(&string_buffer);
+    buffered_file.clear();
+    mesh_pt->output_paraview(buffered_file, nplot);
+    static_cast<std::ostream&>(buffered_file).rdbuf(backed_up_buffer_pt);
+
+    std::string contents = string_buffer.str();
+    submit(filename, contents);
+  }
+
+
+  //====================================================================
+  /// Binary paraview output of the mesh: Take a snapshot of the
+  /// numerical data here; the vtu file is formatted (via
+  /// ParaviewHelper::write_binary_vtu_file(...)) when it's written.
+  //====================================================================
+  void AsyncOutputWriter::output_paraview_binary(
+    Mesh* mesh_pt,
+    const std::string& filename,
+    const unsigned& nplot,
+    const bool& merge_nodal_plot_points)
+  {
+    PendingOutput output;
+    output.Filename = filename;
+    output.Binary = true;
+    output.Paraview_binary_data_pt = new ParaviewBinaryData;
+    ParaviewBinaryData& data = *output.Paraview_binary_data_pt;
+    try
+    {
+      mesh_pt->get_paraview_binary_data(nplot,
+                                        merge_nodal_plot_points,
+                                        data.Scalar_name,
+                                        data.Point_value,
+                                        data.Point_coord,
+                                        data.Connectivity,
+                                        data.Offset,
+                                        data.Cell_type);
+    }
+    catch (...)
+    {
+      delete output.Paraview_binary_data_pt;
+      throw;
+    }
+    enqueue(output);
+  }
+
+
+  //====================================================================
+  /// Tecplot-style output of the mesh to the file specified by the
+  /// DocInfo
+  //====================================================================
+  void AsyncOutputWriter::output(Mesh* mesh_pt,
+                                 const DocInfo& doc_info,
+                                 const std::string& stem,
+                                 const unsigned& nplot)
+  {
+    if (doc_info.is_doc_enabled())
+    {
+      output(mesh_pt, doc_filename(doc_info, stem, ".dat"), nplot);
+    }
+  }
+
+
+  //====================================================================
+  /// Paraview output of the mesh to the file specified by the DocInfo
+  //====================================================================
+  void AsyncOutputWriter::output_paraview(Mesh* mesh_pt,
+                                          const DocInfo& doc_info,
+                                          const std::string& stem,
+                                          const unsigned& nplot)
+  {
+    if (doc_info.is_doc_enabled())
+    {
+      output_paraview(mesh_pt, doc_filename(doc_info, stem, ".vtu"), nplot);
+    }
+  }
+
+
+  //====================================================================
+  /// Filename [directory]/[stem][number][extension] specified by the
+  /// DocInfo (with the suffix _on_proc[rank] if run on multiple
+  /// processors)
+  //====================================================================
+  std::string AsyncOutputWriter::doc_filename(const DocInfo& doc_info,
+                                              const std::string& stem,
+                                              const std::string& extension)
+  {
+    std::ostringstream filename;
+    filename << doc_info.directory() << "/" << stem << doc_info.number();
+#ifdef OOMPH_HAS_MPI
+    if (MPI_Helpers::mpi_has_been_initialised())
+    {
+      if (MPI_Helpers::communicator_pt()->nproc() > 1)
+      {
+        filename << "_on_proc" << MPI_Helpers::communicator_pt()->my_rank();
+      }
+    }
+#endif
+    filename << extension;
+    return filename.str();
+  }
+
+
+  //====================================================================
+  /// Block until all pending output has been written
+  //====================================================================
+  void AsyncOutputWriter::flush()
+  {
+    std::unique_lock<std::mutex> lock(Queue_mutex);
+    while ((!Pending_output.empty()) || Writing)
+    {
+      Queue_changed.wait(lock);
+    }
+    report_background_error();
+  }
+
+
+  //====================================================================
+  /// Function executed by the background thread: Write pending output
+  /// until we're shut down (pending output is written before we
+  /// terminate)
+  //====================================================================
+  void AsyncOutputWriter::write_pending_output()
+  {
+    std::unique_lock<std::mutex> lock(Queue_mutex);
+    while (true)
+    {
+      // Wait for work
+      while (Pending_output.empty() && (!Shutdown))
+      {
+        Queue_changed.wait(lock);
+      }
+      if (Pending_output.empty() && Shutdown)
+      {
+        break;
+      }
+
+      // Take the first pending output out of the queue (leaving its
+      // contents in place until they have been written)
+      PendingOutput output;
+      output.Filename = Pending_output.front().Filename;
+      output.Contents.swap(Pending_output.front().Contents);
+      output.Binary = Pending_output.front().Binary;
+      output.Append = Pending_output.front().Append;
+      output.Paraview_binary_data_pt =
+        Pending_output.front().Paraview_binary_data_pt;
+      Pending_output.pop_front();
+      Writing = true;
+
+      // Format and write without holding the lock
+      lock.unlock();
+      Queue_changed.notify_all();
+      std::string error_message = write(output);
+      delete output.Paraview_binary_data_pt;
+      output.Paraview_binary_data_pt = 0;
+      lock.lock();
+
+      Writing = false;
+      if ((error_message != "") && (Background_error_message == ""))
+      {
+        Background_error_message = error_message;
+      }
+      Queue_changed.notify_all();
+    }
+  }
+
+
+  //====================================================================
+  /// Write the specified output to disk; its paraview data (if any) is
+  /// formatted straight into the file. Returns an error message
+  /// (empty if successful)
+  //====================================================================
+  std::string AsyncOutputWriter::write(const PendingOutput& output)
+  {
+    std::ios_base::openmode mode = std::ios_base::out;
+    if (output.Binary)
+    {
+      mode |= std::ios_base::binary;
+    }
+    if (output.Append)
+    {
+      mode |= std::ios_base::app;
+    }
+    std::ofstream file(output.Filename.c_str(), mode);
+    if (!file.is_open())
+    {
+      return "Couldn't open file " + output.Filename + " for output.\n";
+    }
+    if (output.Paraview_binary_data_pt != 0)
+    {
+      const ParaviewBinaryData& data = *output.Paraview_binary_data_pt;
+      ParaviewHelper::write_binary_vtu_file(file,
+                                            data.Scalar_name,
+                                            data.Point_value,
+                                            data.Point_coord,
+                                            data.Connectivity,
+                                            data.Offset,
+                                            data.Cell_type);
+    }
+    else
+    {
+      file.write(output.Contents.data(), output.Contents.size());
+    }
+    file.close();
+    if (file.fail())
+    {
+      return "Error while writing to file " + output.Filename + "\n";
+    }
+    return "";
+  }
+
+
+  //====================================================================
+  /// Throw an error if the background thread has encountered one (must
+  /// be called with the queue mutex locked). The error is only
+  /// reported once.
+  //====================================================================
+  void AsyncOutputWriter::report_background_error()
+  {
+    if (Background_error_message != "")
+    {
+      std::string error_message =
+        "Error in background output:\n" + Background_error_message;
+      Background_error_message = "";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+} // namespace oomph
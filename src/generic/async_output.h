@@ -0,0 +1,298 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for asynchronous (background) output
+
+// Include guard to prevent multiple inclusions of the header
+#ifndef OOMPH_ASYNC_OUTPUT_HEADER
+#define OOMPH_ASYNC_OUTPUT_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// oomph-lib includes
+#include "oomph_utilities.h"
+#include "mesh.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// \short Class that writes output files on a background thread so
+  /// that the disk I/O overlaps with the computation (e.g. with the
+  /// next timestep's unsteady_newton_solve(...)). On the calling thread
+  /// we take a snapshot of the current solution that is not affected by
+  /// subsequent changes to the nodal values: For binary paraview output
+  /// this is the numerical data (see Mesh::get_paraview_binary_data(...))
+  /// which is formatted into the vtu file by the background thread;
+  /// all other output is produced by the elements' (text) output
+  /// functions and therefore has to be formatted into an in-memory
+  /// buffer on the calling thread. The snapshots are then queued
+  /// and written to disk by a single background thread. NOTE: Only
+  /// binary paraview output is therefore fully asynchronous. For Tecplot
+  /// and ASCII paraview output, whose formatting usually costs more than
+  /// the disk I/O, only the write to disk is taken off the calling
+  /// thread. (Moving the formatting to the background thread would
+  /// require the elements' output functions to work on a copy of the
+  /// solution, and they operate on the live nodal values.) The queue is
+  /// bounded: If the maximum number of pending output files is reached,
+  /// further output blocks until the background thread has caught up.
+  /// Errors encountered by the background thread (e.g. files that can't
+  /// be opened) are reported by throwing an OomphLibError from the
+  /// next call on the calling thread.
+  //====================================================================
+  class AsyncOutputWriter
+  {
+  public:
+    /// \short Constructor: Specify the maximum number of output files
+    /// that may be pending (default: two, i.e. double buffering)
+    AsyncOutputWriter(const unsigned& max_npending = 2);
+
+    /// Broken copy constructor
+    AsyncOutputWriter(const AsyncOutputWriter& dummy)
+    {
+      BrokenCopy::broken_copy("AsyncOutputWriter");
+    }
+
+    /// Broken assignment operator
+    void operator=(const AsyncOutputWriter&)
+    {
+      BrokenCopy::broken_assign("AsyncOutputWriter");
+    }
+
+    /// \short Destructor: Writes all pending output and terminates the
+    /// background thread
+    ~AsyncOutputWriter();
+
+    /// \short Maximum number of pending output files; if exceeded,
+    /// further output blocks until the background thread has caught up
+    void set_max_npending(const unsigned& max_npending);
+
+    /// Maximum number of pending output files
+    unsigned max_npending() const
+    {
+      return Max_npending;
+    }
+
+    /// Number of output files that are waiting to be written
+    unsigned npending();
+
+    /// \short Write output on the calling thread (e.g. for debugging)
+    void disable_background_writing()
+    {
+      flush();
+      Background_writing_enabled = false;
+    }
+
+    /// \short Write output on the background thread (default)
+    void enable_background_writing()
+    {
+      Background_writing_enabled = true;
+    }
+
+    /// \short Queue the specified contents for writing to the specified
+    /// file. The contents are swapped out (i.e. contents is returned
+    /// empty) to avoid copying. If append is true, the contents are
+    /// appended to the file.
+    void submit(const std::string& filename,
+                std::string& contents,
+                const bool& binary = false,
+                const bool& append = false);
+
+    /// \short Tecplot-style output of the mesh (via Mesh::output(...)),
+    /// using nplot plot points in each coordinate direction. The output
+    /// is formatted on the calling thread; only the write to disk is
+    /// asynchronous.
+    void output(Mesh* mesh_pt,
+                const std::string& filename,
+                const unsigned& nplot);
+
+    /// \short Output of the mesh and the exact (steady) solution
+    /// (via Mesh::output_fct(...)). Formatted on the calling thread.
+    void output_fct(Mesh* mesh_pt,
+                    const std::string& filename,
+                    const unsigned& nplot,
+                    FiniteElement::SteadyExactSolutionFctPt exact_soln_pt);
+
+    /// \short Output of the mesh and the exact (unsteady) solution
+    /// (via Mesh::output_fct(...)). Formatted on the calling thread.
+    void output_fct(Mesh* mesh_pt,
+                    const std::string& filename,
+                    const unsigned& nplot,
+                    const double& time,
+                    FiniteElement::UnsteadyExactSolutionFctPt exact_soln_pt);
+
+    /// \short Paraview output of the mesh (via Mesh::output_paraview(...)).
+    /// The ASCII vtu file is formatted on the calling thread; use
+    /// output_paraview_binary(...) to move the formatting to the
+    /// background thread as well.
+    void output_paraview(Mesh* mesh_pt,
+                         const std::string& filename,
+                         const unsigned& nplot);
+
+    /// \short Binary paraview output of the mesh (equivalent to
+    /// Mesh::output_paraview_binary(...)). Only the numerical data is
+    /// extracted on the calling thread; the vtu file is formatted
+    /// by the background thread.
+    void output_paraview_binary(Mesh* mesh_pt,
+                                const std::string& filename,
+                                const unsigned& nplot,
+                                const bool& merge_nodal_plot_points = true);
+
+    /// \short Tecplot-style output of the mesh to the file
+    /// [directory]/[stem][number].dat specified by the DocInfo
+    /// (with the suffix _on_proc[rank] if run on multiple processors).
+    /// No output if documentation is disabled in the DocInfo.
+    void output(Mesh* mesh_pt,
+                const DocInfo& doc_info,
+                const std::string& stem,
+                const unsigned& nplot);
+
+    /// \short Paraview output of the mesh to the file
+    /// [directory]/[stem][number].vtu specified by the DocInfo
+    /// (with the suffix _on_proc[rank] if run on multiple processors).
+    /// No output if documentation is disabled in the DocInfo.
+    void output_paraview(Mesh* mesh_pt,
+                         const DocInfo& doc_info,
+                         const std::string& stem,
+                         const unsigned& nplot);
+
+    /// \short Filename [directory]/[stem][number][extension] specified by
+    /// the DocInfo (with the suffix _on_proc[rank], inserted before the
+    /// extension, if run on multiple processors).
+    static std::string doc_filename(const DocInfo& doc_info,
+                                    const std::string& stem,
+                                    const std::string& extension);
+
+    /// \short Block until all pending output has been written
+    void flush();
+
+  private:
+    /// \short Snapshot of the numerical data for binary paraview output
+    /// (see Mesh::get_paraview_binary_data(...))
+    struct ParaviewBinaryData
+    {
+      /// Names of the scalar fields
+      Vector<std::string> Scalar_name;
+
+      /// Values of the scalar fields
+      Vector<float> Point_value;
+
+      /// Coordinates of the output points
+      Vector<float> Point_coord;
+
+      /// Connectivity of the cells
+      Vector<int> Connectivity;
+
+      /// Offsets of the cells in the connectivity
+      Vector<int> Offset;
+
+      /// Types of the cells
+      Vector<unsigned char> Cell_type;
+    };
+
+    /// Output file that's waiting to be written
+    struct PendingOutput
+    {
+      /// Constructor: Initialise to empty text output
+      PendingOutput()
+        : Binary(false), Append(false), Paraview_binary_data_pt(0)
+      {
+      }
+
+      /// Name of the file
+      std::string Filename;
+
+      /// Contents of the file (if already formatted)
+      std::string Contents;
+
+      /// Write in binary mode?
+      bool Binary;
+
+      /// Append to the file?
+      bool Append;
+
+      /// \short Pointer to the paraview data that's to be formatted
+      /// into the file (null if the contents have already been formatted).
+      /// Owned (and deleted) by whoever writes the output.
+      ParaviewBinaryData* Paraview_binary_data_pt;
+    };
+
+    /// \short Write the specified output on the calling thread or add it
+    /// to the queue (blocking if the queue is full). Ownership of the
+    /// output's contents (and paraview data) is taken over.
+    void enqueue(PendingOutput& output);
+
+    /// \short Function executed by the background thread: Write pending
+    /// output until we're shut down
+    void write_pending_output();
+
+    /// \short Write the specified output to disk (formatting its paraview
+    /// data, if any); returns an error message (empty if successful)
+    static std::string write(const PendingOutput& output);
+
+    /// \short Throw an error if the background thread has encountered one
+    /// (must be called with the queue mutex locked)
+    void report_background_error();
+
+    /// Queue of output files that are waiting to be written
+    std::deque<PendingOutput> Pending_output;
+
+    /// Maximum number of pending output files
+    unsigned Max_npending;
+
+    /// Write output on the background thread?
+    bool Background_writing_enabled;
+
+    /// Is the background thread currently writing a file?
+    bool Writing;
+
+    /// Has the background thread been asked to terminate?
+    bool Shutdown;
+
+    /// Error message from the background thread (empty if none)
+    std::string Background_error_message;
+
+    /// Mutex protecting the queue and the associated flags
+    std::mutex Queue_mutex;
+
+    /// Condition variable signalled whenever the queue changes
+    std::condition_variable Queue_changed;
+
+    /// The background thread
+    std::thread Background_thread;
+  };
+
+} // namespace oomph
+
+#endif
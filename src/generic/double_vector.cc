@@ -277,6 +277,7 @@ namespace oomph
         }
 
         // send and receive circularly
+        double t_start = CommunicationStatistics::timer();
         for (int p = 1; p < nproc; p++)
         {
           // next processor to send to
@@ -301,7 +302,17 @@ namespace oomph
                        1,
                        this->distribution_pt()->communicator_pt()->mpi_comm(),
                        &status);
+
+          CommunicationStatistics::record_send(
+            CommunicationStatistics::Vector_redistribution,
+            new_nrow_local_for_proc[dest_p] * sizeof(double));
+          CommunicationStatistics::record_receive(
+            CommunicationStatistics::Vector_redistribution,
+            new_nrow_local_from_proc[source_p] * sizeof(double));
         }
+        CommunicationStatistics::record_wait_time(
+          CommunicationStatistics::Vector_redistribution,
+          CommunicationStatistics::timer() - t_start);
 
         // copy from temp data to Values_pt
         delete[] Values_pt;
@@ -340,6 +351,7 @@ namespace oomph
 
         // gather the local vectors from all processors on all processors
         int my_nrow_local(this->nrow_local());
+        double t_start = CommunicationStatistics::timer();
         MPI_Allgatherv(temp_data,
                        my_nrow_local,
                        MPI_DOUBLE,
@@ -348,6 +360,13 @@ namespace oomph
                        dist_first_row,
                        MPI_DOUBLE,
                        this->distribution_pt()->communicator_pt()->mpi_comm());
+        CommunicationStatistics::record_collective(
+          CommunicationStatistics::Vector_redistribution,
+          my_nrow_local * sizeof(double),
+          (this->nrow() - my_nrow_local) * sizeof(double));
+        CommunicationStatistics::record_wait_time(
+          CommunicationStatistics::Vector_redistribution,
+          CommunicationStatistics::timer() - t_start);
 
         // update the distribution
         this->build_distribution(dist_pt);
@@ -482,6 +501,10 @@ namespace oomph
 
     // Decided to keep this as a loop rather than use std::transform, because
     // this is a very simple loop and should compile to the same code.
+    // (It is also trivially shared among the rank's threads.)
+#ifdef _OPENMP
+#pragma omp parallel for if (ThreadingHelpers::use_threads(nrow_local))
+#endif
     for (unsigned i = 0; i < nrow_local; i++)
     {
       Values_pt[i] += v_values_pt[i];
@@ -527,6 +550,10 @@ namespace oomph
 
     // Decided to keep this as a loop rather than use std::transform, because
     // this is a very simple loop and should compile to the same code.
+    // (It is also trivially shared among the rank's threads.)
+#ifdef _OPENMP
+#pragma omp parallel for if (ThreadingHelpers::use_threads(nrow_local))
+#endif
     for (unsigned i = 0; i < nrow_local; i++)
     {
       Values_pt[i] -= v_values_pt[i];
@@ -551,7 +578,12 @@ namespace oomph
 
     // Decided to keep this as a loop rather than use std::transform, because
     // this is a very simple loop and should compile to the same code.
-    for (unsigned i = 0, ni = this->nrow_local(); i < ni; i++)
+    // (It is also trivially shared among the rank's threads.)
+    unsigned nrow_local = this->nrow_local();
+#ifdef _OPENMP
+#pragma omp parallel for if (ThreadingHelpers::use_threads(nrow_local))
+#endif
+    for (unsigned i = 0; i < nrow_local; i++)
     {
       Values_pt[i] *= d;
     }
@@ -826,6 +858,10 @@ namespace oomph
     unsigned nrow_local = this->nrow_local();
     double n = 0.0;
     const double* vec_values_pt = vec.values_pt();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : n) if ( \
+  ThreadingHelpers::use_threads(nrow_local))
+#endif
     for (unsigned i = 0; i < nrow_local; i++)
     {
       n += Values_pt[i] * vec_values_pt[i];
@@ -870,6 +906,10 @@ namespace oomph
     // compute the local norm
     unsigned nrow_local = this->nrow_local();
     double n = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : n) if ( \
+  ThreadingHelpers::use_threads(nrow_local))
+#endif
     for (unsigned i = 0; i < nrow_local; i++)
     {
       n += Values_pt[i] * Values_pt[i];
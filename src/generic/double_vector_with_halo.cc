@@ -29,7 +29,9 @@ namespace oomph
 {
   //============================================================================
   ///\short Constructor that sets up the required information communicating
-  /// between all processors. Requires two "all to all" communications.
+  /// between all processors. Requires one global reduction and
+  /// point-to-point communication with the processors that hold
+  /// the required entries.
   /// Arguments are the distribution of the DoubleVector and a
   /// Vector of global unknowns required on this processor.
   //===========================================================================
@@ -88,97 +90,94 @@ namespace oomph
       }
 
       // We now need to tell the other processors which of their data are
-      // haloed on this processor
+      // haloed on this processor. Only the processors that actually hold
+      // the data are contacted directly.
 
       // First find out how many processors there are!
       const int n_proc = dist_pt->communicator_pt()->nproc();
+      MPI_Comm comm = dist_pt->communicator_pt()->mpi_comm();
 
-      // Setup storage for number of data to be sent to each processor
-      Vector<int> send_n(n_proc, 0);
-      Vector<int> send_displacement(n_proc, 0);
-      int send_data_count = 0;
-
-      // Iterate over the entries in the map
-      // This will be in rank order because of the ordering of the map
+      // Work out how many processors are going to send their requests to
+      // this one: flag the processors we need data from and sum the flags
+      // (each processor only receives the sum of its own entry)
+      Vector<int> request_flag(n_proc, 0);
       for (std::map<unsigned, Vector<unsigned>>::iterator it =
              to_be_haloed.begin();
            it != to_be_haloed.end();
            ++it)
       {
-        const unsigned rank = it->first;
-        const unsigned size_ = it->second.size();
-        // The displacement is the current number of data
-        send_displacement[rank] = send_data_count;
-        // The number to send is just the size of the array
-        send_n[rank] = static_cast<int>(size_);
-        send_data_count += size_;
+        request_flag[it->first] = 1;
       }
+      int n_incoming_request = 0;
+      MPI_Reduce_scatter_block(
+        &request_flag[0], &n_incoming_request, 1, MPI_INT, MPI_SUM, comm);
 
-      // Now send the number of haloed entries from every processor
-      // to every processor
-
-      // Receive the data directly into the storage for haloed daa
-      Haloed_n.resize(n_proc, 0);
-      MPI_Alltoall(&send_n[0],
-                   1,
-                   MPI_INT,
-                   &Haloed_n[0],
-                   1,
-                   MPI_INT,
-                   dist_pt->communicator_pt()->mpi_comm());
-
-      // Prepare the data to be sent
-      // Always resize to at least one
-      if (send_data_count == 0)
-      {
-        ++send_data_count;
-      }
-      Vector<unsigned> send_data(send_data_count);
-      // Iterate over the entries in the map
-      unsigned count = 0;
+      // Send the (local) equation numbers to be haloed to the processors
+      // that hold them
+      Vector<MPI_Request> send_request;
       for (std::map<unsigned, Vector<unsigned>>::iterator it =
              to_be_haloed.begin();
            it != to_be_haloed.end();
            ++it)
       {
-        // Iterate over the vector
-        for (Vector<unsigned>::iterator it2 = it->second.begin();
-             it2 != it->second.end();
-             ++it2)
-        {
-          send_data[count] = (*it2);
-          ++count;
-        }
+        MPI_Request req;
+        MPI_Isend(&(it->second[0]),
+                  it->second.size(),
+                  MPI_UNSIGNED,
+                  it->first,
+                  Setup_tag,
+                  comm,
+                  &req);
+        send_request.push_back(req);
+      }
+
+      // Receive the requests from the other processors; the map sorts
+      // them into processor order
+      std::map<unsigned, Vector<unsigned>> haloed_here;
+      for (int i = 0; i < n_incoming_request; i++)
+      {
+        MPI_Status status;
+        MPI_Probe(MPI_ANY_SOURCE, Setup_tag, comm, &status);
+        int n_entry = 0;
+        MPI_Get_count(&status, MPI_UNSIGNED, &n_entry);
+        Vector<unsigned>& entries = haloed_here[status.MPI_SOURCE];
+        entries.resize(n_entry);
+        MPI_Recv(&entries[0],
+                 n_entry,
+                 MPI_UNSIGNED,
+                 status.MPI_SOURCE,
+                 Setup_tag,
+                 comm,
+                 &status);
       }
 
-      // Prepare the data to be received,
-      // Again this can go directly into Haloed storage
-      int receive_data_count = 0;
-      Haloed_displacement.resize(n_proc);
+      // Translate into the permanent storage for the haloed entries
+      Haloed_n.resize(n_proc, 0);
+      Haloed_displacement.resize(n_proc, 0);
+      unsigned haloed_count = 0;
       for (int d = 0; d < n_proc; d++)
       {
-        // The displacement is the amount of data received so far
-        Haloed_displacement[d] = receive_data_count;
-        receive_data_count += Haloed_n[d];
+        Haloed_displacement[d] = haloed_count;
+        std::map<unsigned, Vector<unsigned>>::iterator it =
+          haloed_here.find(d);
+        if (it != haloed_here.end())
+        {
+          const int size_ = it->second.size();
+          Haloed_n[d] = size_;
+          Haloed_rank.push_back(d);
+          Haloed_eqns.insert(
+            Haloed_eqns.end(), it->second.begin(), it->second.end());
+          haloed_count += size_;
+        }
       }
 
-      // Now resize the receive buffer
-      // Always make sure that it has size of at least one
-      if (receive_data_count == 0)
+      // Wait for the requests to have been sent
+      const unsigned n_send_request = send_request.size();
+      if (n_send_request > 0)
       {
-        ++receive_data_count;
+        Vector<MPI_Status> send_status(n_send_request);
+        MPI_Waitall(n_send_request, &send_request[0], &send_status[0]);
       }
-      Haloed_eqns.resize(receive_data_count);
-      // Send the data between all the processors
-      MPI_Alltoallv(&send_data[0],
-                    &send_n[0],
-                    &send_displacement[0],
-                    MPI_UNSIGNED,
-                    &Haloed_eqns[0],
-                    &Haloed_n[0],
-                    &Haloed_displacement[0],
-                    MPI_UNSIGNED,
-                    dist_pt->communicator_pt()->mpi_comm());
 
       // Finally, we translate the map of halo entries into the permanent
       // storage
@@ -203,6 +202,7 @@ namespace oomph
           Halo_displacement[d] = receive_haloed_count;
           const int size_ = it->second.size();
           Halo_n[d] = size_;
+          Halo_rank.push_back(d);
           // Resize the equations to be sent
           Halo_eqns.resize(receive_haloed_count + size_);
           for (int i = 0; i < size_; i++)
@@ -263,54 +263,124 @@ namespace oomph
 
 
   //=========================================================================
-  /// Synchronise the halo data within the vector. This requires one
-  ///"all to all" communnication.
+  /// Synchronise the halo data within the vector. This requires
+  /// point-to-point communication with the processors that share
+  /// halo(ed) entries with this one.
   //====================================================================
   void DoubleVectorWithHaloEntries::synchronise()
+  {
+    this->start_synchronise();
+    this->finish_synchronise();
+  }
+
+
+  //=========================================================================
+  /// Start the split-phase synchronisation of the halo data within the
+  /// vector: Pack the haloed entries and post non-blocking sends and
+  /// receives to and from the processors that share halo(ed) entries
+  /// with this one.
+  //====================================================================
+  void DoubleVectorWithHaloEntries::start_synchronise()
   {
 #ifdef OOMPH_HAS_MPI
     // Only need to do anything if the DoubleVector is distributed
     if (this->distributed())
     {
+      // Complete any previous synchronisation first
+      this->finish_synchronise();
+
       // Read out the number of entries to send
       const unsigned n_send = Halo_scheme_pt->Haloed_eqns.size();
-      Vector<double> send_data(n_send);
+      Synchronisation_send_data.resize(n_send);
       // Read out the data values
       for (unsigned i = 0; i < n_send; i++)
       {
-        send_data[i] = (*this)[Halo_scheme_pt->Haloed_eqns[i]];
+        Synchronisation_send_data[i] =
+          (*this)[Halo_scheme_pt->Haloed_eqns[i]];
       }
 
       // Read out the number of entries to receive
       const unsigned n_receive = Halo_scheme_pt->Halo_eqns.size();
-      Vector<double> receive_data(n_receive);
-
-      // Make sure that the send and receive data have size at least one
-      if (n_send == 0)
-      {
-        send_data.resize(1);
-      }
-      if (n_receive == 0)
+      Synchronisation_receive_data.resize(n_receive);
+
+      // Post receives from (and sends to) only those processors
+      // with which we actually share data
+      OomphCommunicator* const comm_pt =
+        this->distribution_pt()->communicator_pt();
+      const unsigned n_halo_rank = Halo_scheme_pt->Halo_rank.size();
+      for (unsigned r = 0; r < n_halo_rank; r++)
       {
-        receive_data.resize(1);
+        const int p = Halo_scheme_pt->Halo_rank[r];
+        MPI_Request req;
+        MPI_Irecv(
+          &Synchronisation_receive_data[Halo_scheme_pt->Halo_displacement[p]],
+          Halo_scheme_pt->Halo_n[p],
+          MPI_DOUBLE,
+          p,
+          Synchronisation_tag,
+          comm_pt->mpi_comm(),
+          &req);
+        Synchronisation_request.push_back(req);
       }
-      // Communicate
-      MPI_Alltoallv(&send_data[0],
-                    &Halo_scheme_pt->Haloed_n[0],
-                    &Halo_scheme_pt->Haloed_displacement[0],
-                    MPI_DOUBLE,
-                    &receive_data[0],
-                    &Halo_scheme_pt->Halo_n[0],
-                    &Halo_scheme_pt->Halo_displacement[0],
-                    MPI_DOUBLE,
-                    this->distribution_pt()->communicator_pt()->mpi_comm());
-
-
-      // Now I need simply to update my local values
-      for (unsigned i = 0; i < n_receive; i++)
+      const unsigned n_haloed_rank = Halo_scheme_pt->Haloed_rank.size();
+      for (unsigned r = 0; r < n_haloed_rank; r++)
       {
-        Halo_value[Halo_scheme_pt->Halo_eqns[i]] = receive_data[i];
+        const int p = Halo_scheme_pt->Haloed_rank[r];
+        MPI_Request req;
+        MPI_Isend(
+          &Synchronisation_send_data[Halo_scheme_pt->Haloed_displacement[p]],
+          Halo_scheme_pt->Haloed_n[p],
+          MPI_DOUBLE,
+          p,
+          Synchronisation_tag,
+          comm_pt->mpi_comm(),
+          &req);
+        Synchronisation_request.push_back(req);
       }
+
+      // Record the traffic
+      CommunicationStatistics::record_send(
+        CommunicationStatistics::Halo_vector_synchronisation,
+        n_send * sizeof(double),
+        n_haloed_rank);
+      CommunicationStatistics::record_receive(
+        CommunicationStatistics::Halo_vector_synchronisation,
+        n_receive * sizeof(double),
+        n_halo_rank);
+    }
+#endif
+  }
+
+
+  //=========================================================================
+  /// Complete the split-phase synchronisation of the halo data: Wait
+  /// for all communication to complete and update the halo values
+  //====================================================================
+  void DoubleVectorWithHaloEntries::finish_synchronise()
+  {
+#ifdef OOMPH_HAS_MPI
+    // Nothing to do if no synchronisation is pending
+    const unsigned n_request = Synchronisation_request.size();
+    if (n_request == 0)
+    {
+      return;
+    }
+
+    // Wait for the communication to complete
+    double t_start = CommunicationStatistics::timer();
+    Vector<MPI_Status> status(n_request);
+    MPI_Waitall(n_request, &Synchronisation_request[0], &status[0]);
+    Synchronisation_request.clear();
+    CommunicationStatistics::record_wait_time(
+      CommunicationStatistics::Halo_vector_synchronisation,
+      CommunicationStatistics::timer() - t_start);
+
+    // Now I need simply to update my local values
+    const unsigned n_receive = Halo_scheme_pt->Halo_eqns.size();
+    for (unsigned i = 0; i < n_receive; i++)
+    {
+      Halo_value[Halo_scheme_pt->Halo_eqns[i]] =
+        Synchronisation_receive_data[i];
     }
 #endif
   }
@@ -318,7 +388,8 @@ namespace oomph
   //=========================================================================
   /// Gather all ther data from multiple processors and sum the result
   /// which will be stored in the master copy and then synchronised to
-  /// all copies. This requires two "all to all" communications
+  /// all copies. This requires two rounds of point-to-point communication
+  /// with the processors that share halo(ed) entries with this one.
   //====================================================================
   void DoubleVectorWithHaloEntries::sum_all_halo_and_haloed_values()
   {
@@ -326,6 +397,9 @@ namespace oomph
     // Only need to do anything if the DoubleVector is distributed
     if (this->distributed())
     {
+      // Make sure that the halo values are not being overwritten
+      this->finish_synchronise();
+
       // Send the Halo entries to the master processor
       const unsigned n_send = Halo_scheme_pt->Halo_eqns.size();
       Vector<double> send_data(n_send);
@@ -339,26 +413,58 @@ namespace oomph
       const unsigned n_receive = Halo_scheme_pt->Haloed_eqns.size();
       Vector<double> receive_data(n_receive);
 
-      // Make sure that the send and receive data have size at least one
-      if (n_send == 0)
+      // Communicate with the processors that share entries with us only
+      // (the halo entries go back to the processors that hold the
+      // corresponding haloed entries)
+      OomphCommunicator* const comm_pt =
+        this->distribution_pt()->communicator_pt();
+      Vector<MPI_Request> request;
+      const unsigned n_haloed_rank = Halo_scheme_pt->Haloed_rank.size();
+      for (unsigned r = 0; r < n_haloed_rank; r++)
       {
-        send_data.resize(1);
+        const int p = Halo_scheme_pt->Haloed_rank[r];
+        MPI_Request req;
+        MPI_Irecv(&receive_data[Halo_scheme_pt->Haloed_displacement[p]],
+                  Halo_scheme_pt->Haloed_n[p],
+                  MPI_DOUBLE,
+                  p,
+                  Synchronisation_tag,
+                  comm_pt->mpi_comm(),
+                  &req);
+        request.push_back(req);
       }
-      if (n_receive == 0)
+      const unsigned n_halo_rank = Halo_scheme_pt->Halo_rank.size();
+      for (unsigned r = 0; r < n_halo_rank; r++)
       {
-        receive_data.resize(1);
+        const int p = Halo_scheme_pt->Halo_rank[r];
+        MPI_Request req;
+        MPI_Isend(&send_data[Halo_scheme_pt->Halo_displacement[p]],
+                  Halo_scheme_pt->Halo_n[p],
+                  MPI_DOUBLE,
+                  p,
+                  Synchronisation_tag,
+                  comm_pt->mpi_comm(),
+                  &req);
+        request.push_back(req);
+      }
+      CommunicationStatistics::record_send(
+        CommunicationStatistics::Halo_vector_synchronisation,
+        n_send * sizeof(double),
+        n_halo_rank);
+      CommunicationStatistics::record_receive(
+        CommunicationStatistics::Halo_vector_synchronisation,
+        n_receive * sizeof(double),
+        n_haloed_rank);
+      const unsigned n_request = request.size();
+      if (n_request > 0)
+      {
+        double t_start = CommunicationStatistics::timer();
+        Vector<MPI_Status> status(n_request);
+        MPI_Waitall(n_request, &request[0], &status[0]);
+        CommunicationStatistics::record_wait_time(
+          CommunicationStatistics::Halo_vector_synchronisation,
+          CommunicationStatistics::timer() - t_start);
       }
-      // Communicate
-      MPI_Alltoallv(&send_data[0],
-                    &Halo_scheme_pt->Halo_n[0],
-                    &Halo_scheme_pt->Halo_displacement[0],
-                    MPI_DOUBLE,
-                    &receive_data[0],
-                    &Halo_scheme_pt->Haloed_n[0],
-                    &Halo_scheme_pt->Haloed_displacement[0],
-                    MPI_DOUBLE,
-                    this->distribution_pt()->communicator_pt()->mpi_comm());
-
 
       // Now I need simply to update and sum my  local values
       for (unsigned i = 0; i < n_receive; i++)
@@ -83,13 +83,29 @@ namespace oomph
     /// receive buffer
     Vector<int> Halo_displacement;
 
+    /// \short The processors to which haloed entries are sent, i.e. the
+    /// ones for which Haloed_n is non-zero (in increasing order)
+    Vector<int> Haloed_rank;
+
+    /// \short The processors from which halo entries are received, i.e.
+    /// the ones for which Halo_n is non-zero (in increasing order)
+    Vector<int> Halo_rank;
+
+#ifdef OOMPH_HAS_MPI
+    /// \short MPI tag used for the messages exchanged during the setup
+    /// of the scheme
+    static const int Setup_tag = 4203;
+#endif
+
 
     /// \short Store the distribution that was used to setup the halo scheme
     LinearAlgebraDistribution* Distribution_pt;
 
   public:
     ///\short Constructor that sets up the required information communicating
-    /// between all processors. Requires two "all to all" communications.
+    /// between all processors. Requires one global reduction and
+    /// point-to-point communication with the processors that hold
+    /// the required entries.
     /// Arguments are the distribution of the DoubleVector and a
     /// Vector of global unknowns required on this processor.
     DoubleVectorHaloScheme(LinearAlgebraDistribution* const& dist_pt,
@@ -155,6 +171,24 @@ namespace oomph
     /// \short Vector of the halo values
     Vector<double> Halo_value;
 
+#ifdef OOMPH_HAS_MPI
+
+    /// \short Send buffer used during a split-phase synchronisation
+    Vector<double> Synchronisation_send_data;
+
+    /// \short Receive buffer used during a split-phase synchronisation
+    Vector<double> Synchronisation_receive_data;
+
+    /// \short Requests for the non-blocking sends and receives of a
+    /// split-phase synchronisation (empty if none is pending)
+    Vector<MPI_Request> Synchronisation_request;
+
+    /// \short MPI tag used for the messages exchanged during the
+    /// synchronisation
+    static const int Synchronisation_tag = 4202;
+
+#endif
+
   public:
     /// \short Constructor for an uninitialized DoubleVectorWithHaloEntries
     DoubleVectorWithHaloEntries() : DoubleVector(), Halo_scheme_pt(0) {}
@@ -315,6 +349,18 @@ namespace oomph
     /// Synchronise the halo data
     void synchronise();
 
+    /// \short Start the split-phase synchronisation of the halo data:
+    /// post non-blocking sends of the haloed values and receives
+    /// for the halo values. The halo values must not be accessed until
+    /// finish_synchronise() has been called but the locally stored
+    /// entries can be used (though not modified) in the meantime.
+    void start_synchronise();
+
+    /// \short Complete the split-phase synchronisation of the halo data
+    /// started by start_synchronise(). Does nothing if no synchronisation
+    /// is pending.
+    void finish_synchronise();
+
     /// Sum all the data, store in the master (haloed) data and then
     /// synchronise
     void sum_all_halo_and_haloed_values();
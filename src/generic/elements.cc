@@ -4284,6 +4284,80 @@ namespace oomph
     FiniteElement::Accept_negative_jacobian = backup;
   }
 
+  //====================================================================
+  /// Get the paraview cell information for this element's
+  /// sub-elements: Connectivity in terms of the element's plot
+  /// points, offsets (end of each sub-element's entries in the
+  /// connectivity array) and vtk cell types. Obtained by parsing the
+  /// output of the element's write_paraview_*(...) functions.
+  //====================================================================
+  void FiniteElement::get_paraview_cell_information(
+    const unsigned& nplot,
+    Vector<int>& connectivity,
+    Vector<int>& offset,
+    Vector<unsigned char>& cell_type) const
+  {
+    // Dummy output stream whose buffer is replaced by a string buffer
+    std::ofstream dummy_file;
+    std::stringbuf connectivity_buffer;
+    std::streambuf* backed_up_buffer_pt =
+      static_cast<std::ostream&>(dummy_file).rdbuf(&connectivity_buffer);
+    dummy_file.clear();
+
+    // Connectivity relative to the element's first plot point
+    unsigned counter = 0;
+    write_paraview_output_offset_information(dummy_file, nplot, counter);
+
+    // Offsets relative to the element's first connectivity entry
+    std::stringbuf offset_buffer;
+    static_cast<std::ostream&>(dummy_file).rdbuf(&offset_buffer);
+    unsigned offset_sum = 0;
+    write_paraview_offsets(dummy_file, nplot, offset_sum);
+
+    // Cell types
+    std::stringbuf type_buffer;
+    static_cast<std::ostream&>(dummy_file).rdbuf(&type_buffer);
+    write_paraview_type(dummy_file, nplot);
+
+    // Reinstate the original buffer
+    static_cast<std::ostream&>(dummy_file).rdbuf(backed_up_buffer_pt);
+
+    // Parse the offsets and types (one per sub-element)
+    unsigned n_sub = nsub_elements_paraview(nplot);
+    offset.resize(n_sub);
+    cell_type.resize(n_sub);
+    std::istringstream offset_input(offset_buffer.str());
+    std::istringstream type_input(type_buffer.str());
+    for (unsigned e = 0; e < n_sub; e++)
+    {
+      unsigned type = 0;
+      offset_input >> offset[e];
+      type_input >> type;
+      cell_type[e] = static_cast<unsigned char>(type);
+    }
+
+    // Parse the connectivity (offset of the last sub-element
+    // is the total number of entries)
+    unsigned n_entry = 0;
+    if (n_sub > 0) n_entry = offset[n_sub - 1];
+    connectivity.resize(n_entry);
+    std::istringstream connectivity_input(connectivity_buffer.str());
+    for (unsigned j = 0; j < n_entry; j++)
+    {
+      connectivity_input >> connectivity[j];
+    }
+
+#ifdef PARANOID
+    if (offset_input.fail() || type_input.fail() || connectivity_input.fail())
+    {
+      throw OomphLibError("Failed to parse the output of the element's\n"
+                          "write_paraview_*(...) functions.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+  }
+
   //====================================================================
   /// Calculate the size of the element (in Eulerian computational
   /// coordinates. Use suitably overloaded compute_physical_size()
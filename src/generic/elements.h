@@ -3025,6 +3025,31 @@ namespace oomph
         OOMPH_EXCEPTION_LOCATION);
     }
 
+    /// \short Return the values of the i-th scalar field at the plot points
+    /// (in the order in which they are written by scalar_value_paraview(...)).
+    /// Used by the binary paraview output. Broken virtual. Needs to be
+    /// implemented for each new specific element type.
+    virtual void get_scalar_values_paraview(const unsigned& i,
+                                            const unsigned& nplot,
+                                            Vector<double>& value) const
+    {
+      throw OomphLibError(
+        "This function hasn't been implemented for this element",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+
+    /// \short Get the paraview cell information for this element's
+    /// sub-elements (as written by write_paraview_output_offset_information(),
+    /// write_paraview_offsets() and write_paraview_type()): Connectivity
+    /// in terms of the element's plot points, offsets (i.e. the
+    /// end of each sub-element's entries in the connectivity array) and
+    /// vtk cell types.
+    void get_paraview_cell_information(const unsigned& nplot,
+                                       Vector<int>& connectivity,
+                                       Vector<int>& offset,
+                                       Vector<unsigned char>& cell_type) const;
+
     /// \short Write values of the i-th scalar field at the plot points. Broken
     /// virtual. Needs to be implemented for each new specific element type.
     virtual void scalar_value_fct_paraview(
@@ -154,6 +154,9 @@ namespace oomph
     const double* r_values = r.values_pt();
     double* z_values = z.values_pt();
     unsigned nrow_local = this->nrow_local();
+#ifdef _OPENMP
+#pragma omp parallel for if (ThreadingHelpers::use_threads(nrow_local))
+#endif
     for (unsigned i = 0; i < nrow_local; i++)
     {
       z_values[i] = Inv_diag[i] * r_values[i];
@@ -308,6 +311,9 @@ namespace oomph
 #endif
 
     z.build(r.distribution_pt(), 0.0);
+#ifdef _OPENMP
+#pragma omp parallel for if (ThreadingHelpers::use_threads(Nrow))
+#endif
     for (unsigned i = 0; i < Nrow; i++)
     {
       z[i] = Inv_lumped_diag_pt[i] * r[i];
@@ -0,0 +1,664 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline member functions for in-situ sampling of solutions at probe
+// points and on boundaries
+
+#include <map>
+
+#include "in_situ_sampler.h"
+#include "mesh_as_geometric_object.h"
+
+
+namespace oomph
+{
+  /// Version of the file format
+  const unsigned InSituSampler::Format_version;
+
+
+  //====================================================================
+  /// Constructor: Pass pointer to the mesh and the maximum search
+  /// radius for the location of the probe points.
+  //====================================================================
+  InSituSampler::InSituSampler(Mesh* mesh_pt, const double& max_search_radius)
+    : Mesh_pt(mesh_pt),
+      Max_search_radius(max_search_radius),
+      Is_setup(false),
+      Nvalue_total(0)
+  {
+  }
+
+
+  //====================================================================
+  /// Destructor: Close the output file
+  //====================================================================
+  InSituSampler::~InSituSampler()
+  {
+    close();
+  }
+
+
+  //====================================================================
+  /// Locate the host elements and local coordinates of all sample
+  /// points and set up the layout of the samples. Must be called on
+  /// all processors.
+  //====================================================================
+  void InSituSampler::setup()
+  {
+    Local_sample_element_pt.clear();
+    Local_sample_s.clear();
+    Local_sample_nvalue.clear();
+    Sample_tag.clear();
+    Sample_coordinate.clear();
+    Sample_nvalue.clear();
+    Nvalue_from_proc.clear();
+    Nvalue_total = 0;
+
+    int n_proc = 1;
+    int my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    OomphCommunicator* comm_pt = Mesh_pt->communicator_pt();
+    if (comm_pt != 0)
+    {
+      n_proc = comm_pt->nproc();
+      my_rank = comm_pt->my_rank();
+    }
+#endif
+
+    // Tags of the sample points evaluated on this processor
+    Vector<int> local_tag;
+
+    // Probe points
+    //-------------
+    unsigned n_probe = Probe_coordinate.size();
+    if (n_probe > 0)
+    {
+      Vector<FiniteElement*> probe_el_pt(n_probe, 0);
+      Vector<Vector<double>> probe_s(n_probe);
+
+      // Lowest rank of the processors that have found the point in a
+      // non-halo element (n_proc if not found)
+      Vector<int> found_on(n_probe, n_proc);
+
+      // Transform mesh into a geometric object (only once!)
+      MeshAsGeomObject mesh_geom_tmp(Mesh_pt);
+      mesh_geom_tmp.sample_point_container_pt()->max_search_radius() =
+        Max_search_radius;
+      for (unsigned i = 0; i < n_probe; i++)
+      {
+        Vector<double> s(Probe_coordinate[i].size(), 0.0);
+        GeomObject* geom_pt = 0;
+        mesh_geom_tmp.locate_zeta(Probe_coordinate[i], geom_pt, s);
+        FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(geom_pt);
+#ifdef OOMPH_HAS_MPI
+        if ((fe_pt != 0) && (fe_pt->is_halo())) fe_pt = 0;
+#endif
+        if (fe_pt != 0)
+        {
+          probe_el_pt[i] = fe_pt;
+          probe_s[i] = s;
+          found_on[i] = my_rank;
+        }
+      }
+
+      // The point is evaluated on the lowest-numbered processor
+      // that has found it
+      Vector<int> owner(found_on);
+#ifdef OOMPH_HAS_MPI
+      if (n_proc > 1)
+      {
+        MPI_Allreduce(&found_on[0],
+                      &owner[0],
+                      n_probe,
+                      MPI_INT,
+                      MPI_MIN,
+                      comm_pt->mpi_comm());
+      }
+#endif
+      for (unsigned i = 0; i < n_probe; i++)
+      {
+        if (owner[i] == n_proc)
+        {
+          std::ostringstream error_stream;
+          error_stream << "Probe point " << i << " at (";
+          unsigned n_dim = Probe_coordinate[i].size();
+          for (unsigned k = 0; k < n_dim; k++)
+          {
+            error_stream << Probe_coordinate[i][k]
+                         << ((k + 1 < n_dim) ? ", " : "");
+          }
+          error_stream << ") can't be located in the mesh.\n";
+          throw OomphLibError(error_stream.str(),
+                              OOMPH_CURRENT_FUNCTION,
+                              OOMPH_EXCEPTION_LOCATION);
+        }
+        if (owner[i] == my_rank)
+        {
+          Local_sample_element_pt.push_back(probe_el_pt[i]);
+          Local_sample_s.push_back(probe_s[i]);
+          local_tag.push_back(i);
+        }
+      }
+    }
+
+    // Boundary nodes
+    //---------------
+    unsigned n_sampled_boundary = Boundary_id.size();
+    for (unsigned ib = 0; ib < n_sampled_boundary; ib++)
+    {
+      unsigned b = Boundary_id[ib];
+#ifdef PARANOID
+      if (b >= Mesh_pt->nboundary())
+      {
+        std::ostringstream error_stream;
+        error_stream << "Boundary " << b << " doesn't exist; the mesh only has "
+                     << Mesh_pt->nboundary() << " boundaries.\n";
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Find a non-halo host element (and the local node number) for each
+      // node on the boundary
+      std::map<Node*, std::pair<FiniteElement*, unsigned>> host;
+      unsigned n_element = Mesh_pt->nelement();
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        FiniteElement* el_pt = Mesh_pt->finite_element_pt(e);
+#ifdef OOMPH_HAS_MPI
+        if (el_pt->is_halo()) continue;
+#endif
+        unsigned n_node = el_pt->nnode();
+        for (unsigned j = 0; j < n_node; j++)
+        {
+          Node* nod_pt = el_pt->node_pt(j);
+          if (nod_pt->is_on_boundary(b) && (host.count(nod_pt) == 0))
+          {
+            host[nod_pt] = std::make_pair(el_pt, j);
+          }
+        }
+      }
+
+      // Sample the non-halo nodes in the order of the boundary lookup
+      // scheme
+      unsigned n_boundary_node = Mesh_pt->nboundary_node(b);
+      for (unsigned j = 0; j < n_boundary_node; j++)
+      {
+        Node* nod_pt = Mesh_pt->boundary_node_pt(b, j);
+#ifdef OOMPH_HAS_MPI
+        if (nod_pt->is_halo()) continue;
+#endif
+        std::map<Node*, std::pair<FiniteElement*, unsigned>>::iterator it =
+          host.find(nod_pt);
+        if (it != host.end())
+        {
+          FiniteElement* el_pt = it->second.first;
+          Vector<double> s(el_pt->dim());
+          el_pt->local_coordinate_of_node(it->second.second, s);
+          Local_sample_element_pt.push_back(el_pt);
+          Local_sample_s.push_back(s);
+          local_tag.push_back(-int(b + 1));
+        }
+      }
+    }
+
+    // Layout: [tag, number of values, spatial dimension, coordinates] for
+    // each sample point evaluated on this processor
+    Vector<double> local_layout;
+    unsigned n_local_sample = Local_sample_element_pt.size();
+    Local_sample_nvalue.resize(n_local_sample);
+    for (unsigned i = 0; i < n_local_sample; i++)
+    {
+      FiniteElement* el_pt = Local_sample_element_pt[i];
+      Vector<double> data;
+      el_pt->point_output_data(Local_sample_s[i], data);
+      if (data.size() == 0)
+      {
+        throw OomphLibError(
+          "Element doesn't provide any output data at the sample point.\n"
+          "Implement FiniteElement::point_output_data(...) for the element.\n",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+      Local_sample_nvalue[i] = data.size();
+      unsigned n_dim = el_pt->nodal_dimension();
+      Vector<double> x(n_dim);
+      el_pt->interpolated_x(Local_sample_s[i], x);
+      local_layout.push_back(double(local_tag[i]));
+      local_layout.push_back(double(Local_sample_nvalue[i]));
+      local_layout.push_back(double(n_dim));
+      for (unsigned k = 0; k < n_dim; k++)
+      {
+        local_layout.push_back(x[k]);
+      }
+    }
+
+    // Gather the layout on processor 0
+    Vector<double> layout(local_layout);
+#ifdef OOMPH_HAS_MPI
+    if (n_proc > 1)
+    {
+      int n_local = local_layout.size();
+      Vector<int> n_layout(n_proc, 0);
+      MPI_Gather(
+        &n_local, 1, MPI_INT, &n_layout[0], 1, MPI_INT, 0, comm_pt->mpi_comm());
+      Vector<int> displacement(n_proc, 0);
+      int n_total = 0;
+      for (int p = 0; p < n_proc; p++)
+      {
+        displacement[p] = n_total;
+        n_total += n_layout[p];
+      }
+      layout.resize(n_total + 1);
+      local_layout.resize(n_local + 1);
+      MPI_Gatherv(&local_layout[0],
+                  n_local,
+                  MPI_DOUBLE,
+                  &layout[0],
+                  &n_layout[0],
+                  &displacement[0],
+                  MPI_DOUBLE,
+                  0,
+                  comm_pt->mpi_comm());
+      layout.resize(n_total);
+
+      // Number of values from each processor
+      if (my_rank == 0)
+      {
+        Nvalue_from_proc.resize(n_proc, 0);
+        for (int p = 0; p < n_proc; p++)
+        {
+          unsigned long index = displacement[p];
+          unsigned long end = displacement[p] + n_layout[p];
+          while (index < end)
+          {
+            Nvalue_from_proc[p] += unsigned(layout[index + 1]);
+            index += 3 + unsigned(layout[index + 2]);
+          }
+        }
+      }
+    }
+#endif
+
+    // Unpack the layout
+    if (my_rank == 0)
+    {
+      unsigned long index = 0;
+      unsigned long n_layout_entry = layout.size();
+      while (index < n_layout_entry)
+      {
+        Sample_tag.push_back(int(layout[index]));
+        Sample_nvalue.push_back(unsigned(layout[index + 1]));
+        Nvalue_total += Sample_nvalue.back();
+        unsigned n_dim = unsigned(layout[index + 2]);
+        index += 3;
+        Vector<double> x(n_dim);
+        for (unsigned k = 0; k < n_dim; k++)
+        {
+          x[k] = layout[index++];
+        }
+        Sample_coordinate.push_back(x);
+      }
+    }
+
+    Is_setup = true;
+  }
+
+
+  //====================================================================
+  /// Evaluate the values at the sample points located on this processor
+  //====================================================================
+  void InSituSampler::get_local_values(Vector<double>& local_values) const
+  {
+    local_values.clear();
+    Vector<double> data;
+    unsigned n_local_sample = Local_sample_element_pt.size();
+    for (unsigned i = 0; i < n_local_sample; i++)
+    {
+      data.clear();
+      Local_sample_element_pt[i]->point_output_data(Local_sample_s[i], data);
+#ifdef PARANOID
+      if (data.size() != Local_sample_nvalue[i])
+      {
+        throw OomphLibError(
+          "Number of values at sample point has changed since setup().\n",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      local_values.insert(local_values.end(), data.begin(), data.end());
+    }
+  }
+
+
+  //====================================================================
+  /// Get the current values at all sample points, flat-packed in the
+  /// order of the sample points. Must be called on all processors; the
+  /// values are only returned on processor 0.
+  //====================================================================
+  void InSituSampler::get_values(Vector<double>& values)
+  {
+    if (!Is_setup) setup();
+
+    Vector<double> local_values;
+    get_local_values(local_values);
+
+#ifdef OOMPH_HAS_MPI
+    OomphCommunicator* comm_pt = Mesh_pt->communicator_pt();
+    if ((comm_pt != 0) && (comm_pt->nproc() > 1))
+    {
+      int n_proc = comm_pt->nproc();
+      Vector<int> displacement(n_proc, 0);
+      if (comm_pt->my_rank() == 0)
+      {
+        for (int p = 1; p < n_proc; p++)
+        {
+          displacement[p] = displacement[p - 1] + Nvalue_from_proc[p - 1];
+        }
+      }
+      else
+      {
+        // Dummy
+        Nvalue_from_proc.resize(n_proc, 0);
+      }
+      int n_local = local_values.size();
+      values.resize(Nvalue_total + 1);
+      local_values.resize(n_local + 1);
+      MPI_Gatherv(&local_values[0],
+                  n_local,
+                  MPI_DOUBLE,
+                  &values[0],
+                  &Nvalue_from_proc[0],
+                  &displacement[0],
+                  MPI_DOUBLE,
+                  0,
+                  comm_pt->mpi_comm());
+      values.resize(Nvalue_total);
+      return;
+    }
+#endif
+
+    values = local_values;
+  }
+
+
+  //====================================================================
+  /// Broadcast the status of an operation performed by processor 0
+  /// to all other processors. Must be called on all processors.
+  //====================================================================
+  void InSituSampler::broadcast_status(int& status) const
+  {
+#ifdef OOMPH_HAS_MPI
+    OomphCommunicator* comm_pt = Mesh_pt->communicator_pt();
+    if ((comm_pt != 0) && (comm_pt->nproc() > 1))
+    {
+      MPI_Bcast(&status, 1, MPI_INT, 0, comm_pt->mpi_comm());
+    }
+#endif
+  }
+
+
+  //====================================================================
+  /// Open the binary time series file and write the header. Must be
+  /// called on all processors; only processor 0 writes, but errors
+  /// are thrown on all processors.
+  //====================================================================
+  void InSituSampler::open(const std::string& filename)
+  {
+    if (!Is_setup) setup();
+
+    close();
+    int my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    if (Mesh_pt->communicator_pt() != 0)
+    {
+      my_rank = Mesh_pt->communicator_pt()->my_rank();
+    }
+#endif
+
+    // Status of the file on processor 0: 0 if ok, 1 if it couldn't be
+    // opened, 2 if the header couldn't be written
+    int status = 0;
+    if (my_rank == 0)
+    {
+      Outfile.open(filename.c_str(), std::ios::binary);
+      if (!Outfile.is_open())
+      {
+        status = 1;
+      }
+      else
+      {
+        write_header();
+        if (Outfile.fail())
+        {
+          status = 2;
+        }
+      }
+    }
+
+    // Everybody throws if processor 0 failed
+    broadcast_status(status);
+    if (status != 0)
+    {
+      std::string error_message = "Couldn't open file " + filename;
+      if (status == 2)
+      {
+        error_message = "Couldn't write header to file " + filename;
+      }
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
+  //====================================================================
+  /// Write the header of the time series file (on processor 0)
+  //====================================================================
+  void InSituSampler::write_header()
+  {
+    const char magic[8] = {'O', 'O', 'M', 'P', 'H', 'S', 'M', 'P'};
+    Outfile.write(magic, 8);
+    unsigned version = Format_version;
+    Outfile.write(reinterpret_cast<const char*>(&version), sizeof(unsigned));
+    unsigned byte_order_marker = 0x01020304;
+    Outfile.write(reinterpret_cast<const char*>(&byte_order_marker),
+                  sizeof(unsigned));
+    unsigned n_sample = Sample_tag.size();
+    Outfile.write(reinterpret_cast<const char*>(&n_sample), sizeof(unsigned));
+    for (unsigned i = 0; i < n_sample; i++)
+    {
+      Outfile.write(reinterpret_cast<const char*>(&Sample_tag[i]), sizeof(int));
+      Outfile.write(reinterpret_cast<const char*>(&Sample_nvalue[i]),
+                    sizeof(unsigned));
+      unsigned n_dim = Sample_coordinate[i].size();
+      Outfile.write(reinterpret_cast<const char*>(&n_dim), sizeof(unsigned));
+      if (n_dim > 0)
+      {
+        Outfile.write(reinterpret_cast<const char*>(&Sample_coordinate[i][0]),
+                      n_dim * sizeof(double));
+      }
+    }
+    Outfile.flush();
+  }
+
+
+  //====================================================================
+  /// Evaluate the values at all sample points and append them (with the
+  /// specified time) to the time series file. Must be called on all
+  /// processors; errors are thrown on all processors.
+  //====================================================================
+  void InSituSampler::sample(const double& time)
+  {
+    Vector<double> values;
+    get_values(values);
+
+    int my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    if (Mesh_pt->communicator_pt() != 0)
+    {
+      my_rank = Mesh_pt->communicator_pt()->my_rank();
+    }
+#endif
+
+    // Status of the output on processor 0: 0 if ok, 1 if the file
+    // hasn't been opened, 2 if the write failed
+    int status = 0;
+    if (my_rank == 0)
+    {
+      if (!Outfile.is_open())
+      {
+        status = 1;
+      }
+      else
+      {
+        Outfile.write(reinterpret_cast<const char*>(&time), sizeof(double));
+        if (!values.empty())
+        {
+          Outfile.write(reinterpret_cast<const char*>(&values[0]),
+                        values.size() * sizeof(double));
+        }
+
+        // Keep the file up to date so the run can be monitored
+        Outfile.flush();
+        if (Outfile.fail())
+        {
+          status = 2;
+        }
+      }
+    }
+
+    // Everybody throws if processor 0 failed
+    broadcast_status(status);
+    if (status == 1)
+    {
+      throw OomphLibError("Time series file hasn't been opened.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    if (status == 2)
+    {
+      throw OomphLibError("Error while writing time series file.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
+  //====================================================================
+  /// Close the time series file
+  //====================================================================
+  void InSituSampler::close()
+  {
+    if (Outfile.is_open())
+    {
+      Outfile.close();
+    }
+  }
+
+
+  //====================================================================
+  /// Read a time series written by an InSituSampler. Incomplete
+  /// records at the end of the file (e.g. if the run is still going) are
+  /// ignored.
+  //====================================================================
+  void InSituSampler::read_time_series(const std::string& filename,
+                                       Vector<int>& tag,
+                                       Vector<Vector<double>>& coordinate,
+                                       Vector<unsigned>& n_value,
+                                       Vector<double>& time,
+                                       Vector<Vector<double>>& values)
+  {
+    std::ifstream infile(filename.c_str(), std::ios::binary);
+    if (!infile.is_open())
+    {
+      std::string error_message = "Couldn't open file " + filename;
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Header
+    char magic[8];
+    infile.read(magic, 8);
+    unsigned version = 0;
+    infile.read(reinterpret_cast<char*>(&version), sizeof(unsigned));
+    unsigned byte_order_marker = 0;
+    infile.read(reinterpret_cast<char*>(&byte_order_marker), sizeof(unsigned));
+    if (infile.fail() || (std::string(magic, 8) != "OOMPHSMP") ||
+        (version > Format_version) || (byte_order_marker != 0x01020304))
+    {
+      std::string error_message =
+        filename + " isn't a time series file that can be read here.\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    unsigned n_sample = 0;
+    infile.read(reinterpret_cast<char*>(&n_sample), sizeof(unsigned));
+    tag.resize(n_sample);
+    coordinate.resize(n_sample);
+    n_value.resize(n_sample);
+    unsigned long n_value_total = 0;
+    for (unsigned i = 0; i < n_sample; i++)
+    {
+      infile.read(reinterpret_cast<char*>(&tag[i]), sizeof(int));
+      infile.read(reinterpret_cast<char*>(&n_value[i]), sizeof(unsigned));
+      unsigned n_dim = 0;
+      infile.read(reinterpret_cast<char*>(&n_dim), sizeof(unsigned));
+      coordinate[i].resize(n_dim);
+      if (n_dim > 0)
+      {
+        infile.read(reinterpret_cast<char*>(&coordinate[i][0]),
+                    n_dim * sizeof(double));
+      }
+      n_value_total += n_value[i];
+    }
+    if (infile.fail())
+    {
+      std::string error_message = "Header of " + filename + " is truncated.\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Records
+    time.clear();
+    values.clear();
+    Vector<double> record_values(n_value_total + 1);
+    while (true)
+    {
+      double t = 0.0;
+      infile.read(reinterpret_cast<char*>(&t), sizeof(double));
+      infile.read(reinterpret_cast<char*>(&record_values[0]),
+                  n_value_total * sizeof(double));
+      if (infile.fail()) break;
+      time.push_back(t);
+      values.push_back(Vector<double>(n_value_total));
+      for (unsigned long j = 0; j < n_value_total; j++)
+      {
+        values.back()[j] = record_values[j];
+      }
+    }
+  }
+
+} // namespace oomph
@@ -0,0 +1,245 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for in-situ sampling of solutions at probe points and on
+// boundaries
+
+// Include guard to prevent multiple inclusions of the header
+#ifndef OOMPH_IN_SITU_SAMPLER_HEADER
+#define OOMPH_IN_SITU_SAMPLER_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+#include <float.h>
+#include <fstream>
+#include <string>
+
+// oomph-lib includes
+#include "Vector.h"
+#include "oomph_utilities.h"
+#include "mesh.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// \short Class for in-situ sampling of the solution during a run,
+  /// e.g. to monitor probe velocities or boundary values without full
+  /// (and huge) mesh output at every timestep. Sample points are
+  /// - probe points (specified by their Eulerian coordinates) and
+  /// - all nodes on specified mesh boundaries.
+  /// The host elements and local coordinates of all sample points are
+  /// determined once, in setup(); subsequent samples are obtained by
+  /// direct interpolation (using the elements' point_output_data(...)
+  /// function, as in the LineVisualiser) and are appended to a compact
+  /// binary time series by sample(...). NOTE: Since the local
+  /// coordinates are fixed, probe points move with the mesh if the
+  /// mesh deforms; call setup() again to relocate them. In a distributed
+  /// problem, each sample point is evaluated by one processor that holds
+  /// the non-halo host element and the values are gathered (and written)
+  /// on processor 0.
+  ///
+  /// File format (all binary, native byte order):
+  /// - Header: "OOMPHSMP", format version, byte order marker and the
+  ///   number of sample points, followed, for each sample point, by its
+  ///   tag (the index of the probe point, or -(b+1) for nodes on
+  ///   boundary b), number of values, spatial dimension and Eulerian
+  ///   coordinates.
+  /// - One record per sample: time, followed by the values at all sample
+  ///   points (in the order listed in the header).
+  //====================================================================
+  class InSituSampler
+  {
+  public:
+    /// \short Constructor: Pass pointer to the mesh. Optional final
+    /// parameter specifies the maximum search radius in bin when locating
+    /// probe points (see LineVisualiser).
+    InSituSampler(Mesh* mesh_pt, const double& max_search_radius = DBL_MAX);
+
+    /// Destructor: Close the output file
+    ~InSituSampler();
+
+    /// Broken copy constructor
+    InSituSampler(const InSituSampler& dummy)
+    {
+      BrokenCopy::broken_copy("InSituSampler");
+    }
+
+    /// Broken assignment operator
+    void operator=(const InSituSampler&)
+    {
+      BrokenCopy::broken_assign("InSituSampler");
+    }
+
+    /// \short Add a probe point, specified by its Eulerian coordinates
+    /// (located when setup() is called)
+    void add_probe(const Vector<double>& x)
+    {
+      Probe_coordinate.push_back(x);
+      Is_setup = false;
+    }
+
+    /// \short Add all nodes on mesh boundary b as sample points (located
+    /// when setup() is called)
+    void add_boundary(const unsigned& b)
+    {
+      Boundary_id.push_back(b);
+      Is_setup = false;
+    }
+
+    /// \short Locate the host elements and local coordinates of all
+    /// sample points and set up the layout of the samples. Must be called
+    /// on all processors; throws an error if a probe point can't be
+    /// located on any processor.
+    void setup();
+
+    /// \short Total number of sample points (only available on
+    /// processor 0 in a distributed problem)
+    unsigned nsample_point() const
+    {
+      return Sample_tag.size();
+    }
+
+    /// \short Total number of values per sample, i.e. summed over all
+    /// sample points (only available on processor 0 in a distributed
+    /// problem)
+    unsigned long nvalue() const
+    {
+      return Nvalue_total;
+    }
+
+    /// \short Tag of the i-th sample point: the index of the probe point or
+    /// -(b+1) for nodes on boundary b (only available on processor 0 in
+    /// a distributed problem)
+    int sample_tag(const unsigned& i) const
+    {
+      return Sample_tag[i];
+    }
+
+    /// \short Eulerian coordinates of the i-th sample point (only
+    /// available on processor 0 in a distributed problem)
+    const Vector<double>& sample_coordinate(const unsigned& i) const
+    {
+      return Sample_coordinate[i];
+    }
+
+    /// \short Get the current values at all sample points, flat-packed in
+    /// the order of the sample points. Must be called on all processors;
+    /// the values are only returned on processor 0.
+    void get_values(Vector<double>& values);
+
+    /// \short Open the binary time series file and write the header
+    /// (calls setup() if required). Must be called on all processors;
+    /// only processor 0 writes, but errors are thrown on all processors.
+    void open(const std::string& filename);
+
+    /// \short Evaluate the values at all sample points and append them
+    /// (with the specified time) to the time series file. Must be called
+    /// on all processors; errors are thrown on all processors.
+    void sample(const double& time);
+
+    /// Close the time series file
+    void close();
+
+    /// \short Read a time series written by an InSituSampler:
+    /// Returns the tags and coordinates of the sample points, the
+    /// number of values at each sample point, the times and the
+    /// (flat-packed) values of each sample.
+    static void read_time_series(const std::string& filename,
+                                 Vector<int>& tag,
+                                 Vector<Vector<double>>& coordinate,
+                                 Vector<unsigned>& n_value,
+                                 Vector<double>& time,
+                                 Vector<Vector<double>>& values);
+
+    /// Version of the file format
+    static const unsigned Format_version = 1;
+
+  private:
+    /// \short Evaluate the values at the sample points located on this
+    /// processor
+    void get_local_values(Vector<double>& local_values) const;
+
+    /// \short Broadcast the status (zero if all went well, an error code
+    /// otherwise) of an operation performed by processor 0 to all other
+    /// processors, so that they can all throw if something went wrong
+    /// (rather than waiting for processor 0 in the next collective
+    /// operation). Must be called on all processors.
+    void broadcast_status(int& status) const;
+
+    /// Write the header of the time series file (on processor 0)
+    void write_header();
+
+    /// Pointer to the mesh
+    Mesh* Mesh_pt;
+
+    /// Maximum search radius when locating the probe points
+    double Max_search_radius;
+
+    /// Coordinates of the probe points
+    Vector<Vector<double>> Probe_coordinate;
+
+    /// Boundaries whose nodes are sampled
+    Vector<unsigned> Boundary_id;
+
+    /// Have the sample points been located?
+    bool Is_setup;
+
+    /// Host elements of the sample points evaluated on this processor
+    Vector<FiniteElement*> Local_sample_element_pt;
+
+    /// \short Local coordinates (in their host elements) of the sample
+    /// points evaluated on this processor
+    Vector<Vector<double>> Local_sample_s;
+
+    /// Number of values at the sample points evaluated on this processor
+    Vector<unsigned> Local_sample_nvalue;
+
+    /// Tags of all sample points (on processor 0)
+    Vector<int> Sample_tag;
+
+    /// Eulerian coordinates of all sample points (on processor 0)
+    Vector<Vector<double>> Sample_coordinate;
+
+    /// Number of values at each sample point (on processor 0)
+    Vector<unsigned> Sample_nvalue;
+
+    /// \short Number of values sent by each processor per sample (on
+    /// processor 0)
+    Vector<int> Nvalue_from_proc;
+
+    /// Total number of values per sample (on processor 0)
+    unsigned long Nvalue_total;
+
+    /// Output file (only opened on processor 0)
+    std::ofstream Outfile;
+  };
+
+} // namespace oomph
+
+#endif
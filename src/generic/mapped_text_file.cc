@@ -0,0 +1,426 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline member functions for fast (memory-mapped) reading of text
+// input files
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define OOMPH_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mapped_text_file.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// Constructor: Map the specified file into memory (or read it in
+  /// one go if this isn't possible).
+  //====================================================================
+  MappedTextFile::MappedTextFile(const std::string& filename)
+    : Filename(filename),
+      Data_pt(0),
+      Size(0),
+      Position(0),
+      Is_mapped(false),
+      Is_open(false),
+      Comments_enabled(true),
+      Comment_character('#'),
+      Buffer("")
+  {
+#ifdef OOMPH_HAS_MMAP
+    int file_descriptor = open(filename.c_str(), O_RDONLY);
+    if (file_descriptor >= 0)
+    {
+      struct stat file_status;
+      if ((fstat(file_descriptor, &file_status) == 0) &&
+          (file_status.st_size > 0))
+      {
+        void* map_pt = mmap(0,
+                            file_status.st_size,
+                            PROT_READ,
+                            MAP_PRIVATE,
+                            file_descriptor,
+                            0);
+        if (map_pt != MAP_FAILED)
+        {
+          // We read the file front to back
+          madvise(map_pt, file_status.st_size, MADV_SEQUENTIAL);
+          Data_pt = static_cast<const char*>(map_pt);
+          Size = file_status.st_size;
+          Is_mapped = true;
+          Is_open = true;
+        }
+      }
+      close(file_descriptor);
+      if (Is_open) return;
+    }
+#endif
+
+    // Fallback: Read the whole file into the buffer
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) return;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    Buffer = contents.str();
+    Data_pt = Buffer.data();
+    Size = Buffer.size();
+    Is_open = true;
+  }
+
+
+  //====================================================================
+  /// Destructor: Unmap the file
+  //====================================================================
+  MappedTextFile::~MappedTextFile()
+  {
+#ifdef OOMPH_HAS_MMAP
+    if (Is_mapped)
+    {
+      munmap(const_cast<char*>(Data_pt), Size);
+    }
+#endif
+  }
+
+
+  //====================================================================
+  /// Skip whitespace and comments (incl. line breaks)
+  //====================================================================
+  void MappedTextFile::skip_whitespace_and_comments()
+  {
+    while (Position < Size)
+    {
+      char c = Data_pt[Position];
+      if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r'))
+      {
+        Position++;
+      }
+      else if (Comments_enabled && (c == Comment_character))
+      {
+        skip_line();
+      }
+      else
+      {
+        return;
+      }
+    }
+  }
+
+
+  //====================================================================
+  /// Throw an error about an unexpected end of file
+  //====================================================================
+  void MappedTextFile::end_of_file_error() const
+  {
+    std::string error_message = "Unexpected end of file " + Filename + "\n";
+    throw OomphLibError(
+      error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+  }
+
+
+  //====================================================================
+  /// Have we reached the end of the file (ignoring trailing whitespace
+  /// and comments)?
+  //====================================================================
+  bool MappedTextFile::at_end()
+  {
+    skip_whitespace_and_comments();
+    return (Position >= Size);
+  }
+
+
+  //====================================================================
+  /// Read the next token as an unsigned integer
+  //====================================================================
+  unsigned MappedTextFile::read_unsigned()
+  {
+    skip_whitespace_and_comments();
+    if (Position >= Size) end_of_file_error();
+    const char* pt = Data_pt + Position;
+    unsigned value = parse_unsigned(pt, end_pt());
+    Position = pt - Data_pt;
+    return value;
+  }
+
+
+  //====================================================================
+  /// Read the next token as a double
+  //====================================================================
+  double MappedTextFile::read_double()
+  {
+    skip_whitespace_and_comments();
+    if (Position >= Size) end_of_file_error();
+    const char* pt = Data_pt + Position;
+    double value = parse_double(pt, end_pt());
+    Position = pt - Data_pt;
+    return value;
+  }
+
+
+  //====================================================================
+  /// Skip the rest of the current line (incl. the end-of-line character)
+  //====================================================================
+  void MappedTextFile::skip_line()
+  {
+    while ((Position < Size) && (Data_pt[Position] != '\n'))
+    {
+      Position++;
+    }
+    if (Position < Size) Position++;
+  }
+
+
+  //====================================================================
+  /// Return the rest of the current line (without the end-of-line
+  /// character) and move to the start of the next line
+  //====================================================================
+  std::string MappedTextFile::read_line()
+  {
+    unsigned long start = Position;
+    while ((Position < Size) && (Data_pt[Position] != '\n'))
+    {
+      Position++;
+    }
+    unsigned long end = Position;
+    if ((end > start) && (Data_pt[end - 1] == '\r')) end--;
+    if (Position < Size) Position++;
+    return std::string(Data_pt + start, end - start);
+  }
+
+
+  //====================================================================
+  /// Locate the next n_record records (non-empty lines that aren't
+  /// comments), return pointers to their first characters and move
+  /// past them.
+  //====================================================================
+  void MappedTextFile::get_record_lines(const unsigned long& n_record,
+                                        Vector<const char*>& record_pt)
+  {
+    record_pt.resize(n_record);
+    for (unsigned long r = 0; r < n_record; r++)
+    {
+      skip_whitespace_and_comments();
+      if (Position >= Size) end_of_file_error();
+      record_pt[r] = Data_pt + Position;
+      skip_line();
+    }
+  }
+
+
+  //====================================================================
+  /// Parse an unsigned integer starting at pt (leading spaces and tabs
+  /// are skipped but not line breaks); on return pt points to the first
+  /// character after the number.
+  //====================================================================
+  unsigned MappedTextFile::parse_unsigned(const char*& pt,
+                                          const char* const& end_pt)
+  {
+    while ((pt < end_pt) && ((*pt == ' ') || (*pt == '\t')))
+    {
+      pt++;
+    }
+    if ((pt < end_pt) && (*pt == '+')) pt++;
+
+    const char* start_pt = pt;
+    unsigned long long value = 0;
+    while ((pt < end_pt) && (*pt >= '0') && (*pt <= '9'))
+    {
+      value = 10 * value + (*pt - '0');
+      pt++;
+    }
+    if ((pt == start_pt) || (value > 0xFFFFFFFFULL))
+    {
+      std::string token(start_pt, std::min(long(end_pt - start_pt), 20L));
+      std::string error_message =
+        "Can't parse unsigned integer at \"" + token + "...\"\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    return unsigned(value);
+  }
+
+
+  //====================================================================
+  /// Parse a double starting at pt (leading spaces and tabs are
+  /// skipped but not line breaks); on return pt points to the first
+  /// character after the number. If the decimal mantissa has at most
+  /// 15 significant digits and the decimal exponent is at most 22 in
+  /// magnitude, both are represented exactly as doubles and a single
+  /// multiplication/division gives the correctly rounded result.
+  /// All other numbers (and "inf", "nan", etc.) are passed to strtod.
+  //====================================================================
+  double MappedTextFile::parse_double(const char*& pt,
+                                      const char* const& end_pt)
+  {
+    // Exact powers of ten
+    static const double power_of_ten[23] = {
+      1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+      1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+      1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+
+    while ((pt < end_pt) && ((*pt == ' ') || (*pt == '\t')))
+    {
+      pt++;
+    }
+    const char* start_pt = pt;
+
+    // Sign
+    bool negative = false;
+    if ((pt < end_pt) && ((*pt == '-') || (*pt == '+')))
+    {
+      negative = (*pt == '-');
+      pt++;
+    }
+
+    // Mantissa (significant digits only) and decimal exponent
+    unsigned long long mantissa = 0;
+    unsigned n_significant_digit = 0;
+    unsigned n_digit = 0;
+    int exponent = 0;
+    bool too_many_digits = false;
+    while ((pt < end_pt) && (*pt >= '0') && (*pt <= '9'))
+    {
+      if ((mantissa > 0) || (*pt != '0'))
+      {
+        if (n_significant_digit < 15)
+        {
+          mantissa = 10 * mantissa + (*pt - '0');
+          n_significant_digit++;
+        }
+        else
+        {
+          if (*pt != '0') too_many_digits = true;
+          exponent++;
+        }
+      }
+      n_digit++;
+      pt++;
+    }
+    if ((pt < end_pt) && (*pt == '.'))
+    {
+      pt++;
+      while ((pt < end_pt) && (*pt >= '0') && (*pt <= '9'))
+      {
+        if ((mantissa > 0) || (*pt != '0'))
+        {
+          if (n_significant_digit < 15)
+          {
+            mantissa = 10 * mantissa + (*pt - '0');
+            n_significant_digit++;
+            exponent--;
+          }
+          else if (*pt != '0')
+          {
+            too_many_digits = true;
+          }
+        }
+        else
+        {
+          exponent--;
+        }
+        n_digit++;
+        pt++;
+      }
+    }
+
+    // Exponent
+    bool valid = (n_digit > 0);
+    if (valid && (pt < end_pt) && ((*pt == 'e') || (*pt == 'E')))
+    {
+      const char* exponent_start_pt = pt;
+      pt++;
+      bool negative_exponent = false;
+      if ((pt < end_pt) && ((*pt == '-') || (*pt == '+')))
+      {
+        negative_exponent = (*pt == '-');
+        pt++;
+      }
+      if ((pt < end_pt) && (*pt >= '0') && (*pt <= '9'))
+      {
+        int explicit_exponent = 0;
+        while ((pt < end_pt) && (*pt >= '0') && (*pt <= '9'))
+        {
+          if (explicit_exponent < 10000)
+          {
+            explicit_exponent = 10 * explicit_exponent + (*pt - '0');
+          }
+          pt++;
+        }
+        if (negative_exponent) explicit_exponent = -explicit_exponent;
+        exponent += explicit_exponent;
+      }
+      else
+      {
+        // Not an exponent after all
+        pt = exponent_start_pt;
+      }
+    }
+
+    // Fast path
+    if (valid && !too_many_digits && (exponent >= -22) && (exponent <= 22))
+    {
+      double value = double(mantissa);
+      if (exponent >= 0)
+      {
+        value *= power_of_ten[exponent];
+      }
+      else
+      {
+        value /= power_of_ten[-exponent];
+      }
+      return (negative ? -value : value);
+    }
+
+    // Slow path: Copy the token and use strtod
+    pt = start_pt;
+    while ((pt < end_pt) && (*pt != ' ') && (*pt != '\t') && (*pt != '\n') &&
+           (*pt != '\r'))
+    {
+      pt++;
+    }
+    std::string token(start_pt, pt - start_pt);
+    char* token_end_pt = 0;
+    double value = std::strtod(token.c_str(), &token_end_pt);
+    if ((token.empty()) || (token_end_pt == token.c_str()))
+    {
+      std::string error_message =
+        "Can't parse double at \"" + token.substr(0, 20) + "\"\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    pt = start_pt + (token_end_pt - token.c_str());
+    return value;
+  }
+
+} // namespace oomph
@@ -0,0 +1,192 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for fast (memory-mapped) reading of text input files
+
+// Include guard to prevent multiple inclusions of the header
+#ifndef OOMPH_MAPPED_TEXT_FILE_HEADER
+#define OOMPH_MAPPED_TEXT_FILE_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+#include <string>
+
+// oomph-lib includes
+#include "Vector.h"
+#include "oomph_utilities.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// \short Class for fast reading of (large) text input files such as
+  /// the node and element files generated by tetgen and triangle. The
+  /// file is mapped into memory (or, on systems without mmap, read in
+  /// one go) and numbers are parsed by hand, which is much faster than
+  /// reading them token by token with std::ifstream::operator>>.
+  /// Everything from the comment character (default '#') to the end of
+  /// the line is ignored by the sequential read functions.
+  ///
+  /// Sections of the file that consist of a known number of records
+  /// (one per line) can be parsed in parallel: get_record_lines(...)
+  /// locates the start of each record and the records can then be
+  /// parsed independently with the static functions parse_unsigned(...)
+  /// and parse_double(...), e.g. in an OpenMP loop.
+  //====================================================================
+  class MappedTextFile
+  {
+  public:
+    /// \short Constructor: Map the specified file into memory. Check
+    /// is_open() to see if this was successful.
+    MappedTextFile(const std::string& filename);
+
+    /// Destructor: Unmap the file
+    ~MappedTextFile();
+
+    /// Broken copy constructor
+    MappedTextFile(const MappedTextFile& dummy)
+    {
+      BrokenCopy::broken_copy("MappedTextFile");
+    }
+
+    /// Broken assignment operator
+    void operator=(const MappedTextFile&)
+    {
+      BrokenCopy::broken_assign("MappedTextFile");
+    }
+
+    /// Has the file been opened (and mapped) successfully?
+    bool is_open() const
+    {
+      return Is_open;
+    }
+
+    /// Name of the file
+    const std::string& filename() const
+    {
+      return Filename;
+    }
+
+    /// \short Set the comment character (the remainder of any line
+    /// that contains it is ignored)
+    void set_comment_character(const char& comment_character)
+    {
+      Comment_character = comment_character;
+      Comments_enabled = true;
+    }
+
+    /// Don't treat any character as the start of a comment
+    void disable_comments()
+    {
+      Comments_enabled = false;
+    }
+
+    /// \short Have we reached the end of the file (ignoring trailing
+    /// whitespace and comments)?
+    bool at_end();
+
+    /// Read the next token as an unsigned integer
+    unsigned read_unsigned();
+
+    /// Read the next token as a double
+    double read_double();
+
+    /// \short Skip the rest of the current line (incl. the end-of-line
+    /// character)
+    void skip_line();
+
+    /// \short Return the rest of the current line (without the end-of-line
+    /// character) and move to the start of the next line
+    std::string read_line();
+
+    /// \short Locate the next n_record records (non-empty lines that
+    /// aren't comments), return pointers to their first characters and
+    /// move past them.
+    void get_record_lines(const unsigned long& n_record,
+                          Vector<const char*>& record_pt);
+
+    /// \short Pointer to the end of the file contents (to be passed to the
+    /// static parse functions)
+    const char* end_pt() const
+    {
+      return Data_pt + Size;
+    }
+
+    /// \short Parse an unsigned integer starting at pt (leading spaces and
+    /// tabs are skipped but not line breaks); on return pt points to the
+    /// first character after the number. Throws an error if there is no
+    /// valid number.
+    static unsigned parse_unsigned(const char*& pt, const char* const& end_pt);
+
+    /// \short Parse a double starting at pt (leading spaces and tabs are
+    /// skipped but not line breaks); on return pt points to the first
+    /// character after the number. Numbers with at most 15 significant
+    /// digits and moderate exponents are converted exactly by hand;
+    /// all others are passed to strtod. Throws an error if there is no
+    /// valid number.
+    static double parse_double(const char*& pt, const char* const& end_pt);
+
+  private:
+    /// Skip whitespace and comments (incl. line breaks)
+    void skip_whitespace_and_comments();
+
+    /// \short Throw an error about an unexpected end of file
+    void end_of_file_error() const;
+
+    /// Name of the file
+    std::string Filename;
+
+    /// Pointer to the start of the file contents
+    const char* Data_pt;
+
+    /// Number of bytes in the file
+    unsigned long Size;
+
+    /// Current position (offset from Data_pt)
+    unsigned long Position;
+
+    /// \short Was the file mapped into memory (rather than read into
+    /// Buffer)?
+    bool Is_mapped;
+
+    /// Has the file been opened successfully?
+    bool Is_open;
+
+    /// Are comments enabled?
+    bool Comments_enabled;
+
+    /// Comment character
+    char Comment_character;
+
+    /// Storage for the file contents if it couldn't be mapped
+    std::string Buffer;
+  };
+
+} // namespace oomph
+
+#endif
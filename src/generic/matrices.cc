@@ -1863,6 +1863,12 @@ namespace oomph
       const double* value = CR_matrix.value();
       double* soln_pt = soln.values_pt();
       const double* x_pt = x.values_pt();
+
+      // Rows are independent so share them among the rank's threads
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if ( \
+  ThreadingHelpers::use_threads(n))
+#endif
       for (unsigned long i = 0; i < n; i++)
       {
         soln_pt[i] = 0.0;
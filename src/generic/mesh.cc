@@ -57,6 +57,44 @@ namespace oomph
   bool Mesh::Suppress_warning_about_empty_mesh_level_time_stepper_function =
     false;
 
+
+  //=======================================================================
+  /// \short Static boolean flag to control whether meshes may defer the
+  /// setup of the boundary lookup schemes until they're first accessed
+  //=======================================================================
+  bool Mesh::Setup_boundary_element_info_on_demand = true;
+
+
+  //=======================================================================
+  /// Set up the lookup schemes for elements that are adjacent to the
+  /// boundaries now if their setup has been deferred. The flag is
+  /// reset first so we only try once, even if the mesh doesn't
+  /// implement setup_boundary_element_info().
+  //=======================================================================
+  void Mesh::setup_deferred_boundary_element_info() const
+  {
+    if (Boundary_element_info_setup_is_deferred)
+    {
+      // Only one thread does the setup; any others that access the
+      // lookup schemes at the same time wait here until it's complete
+#ifdef _OPENMP
+#pragma omp critical(oomph_deferred_boundary_element_info_setup)
+#endif
+      {
+        // Check again: Another thread may have done the setup while
+        // we were waiting
+        if (Boundary_element_info_setup_is_deferred)
+        {
+          Mesh* mesh_pt = const_cast<Mesh*>(this);
+          mesh_pt->setup_boundary_element_info();
+
+          // Only clear the flag once the lookup schemes are complete
+          mesh_pt->Boundary_element_info_setup_is_deferred = false;
+        }
+      }
+    }
+  }
+
   //=======================================================================
   /// Merge meshes.
   /// Note: This simply merges the meshes' elements and nodes (ignoring
@@ -66,6 +104,7 @@ namespace oomph
   {
     // No boundary lookup scheme is set up for the combined mesh
     Lookup_for_elements_next_boundary_is_setup = false;
+    Boundary_element_info_setup_is_deferred = false;
 
     // Number of submeshes
     unsigned nsub_mesh = sub_mesh_pt.size();
@@ -1063,6 +1102,9 @@ namespace oomph
   //========================================================
   void Mesh::output_boundaries(std::ostream& outfile)
   {
+    // Format doubles with the fast num_put facet
+    NumericOutput::FastFormattingGuard fast_formatting_guard(outfile);
+
     // Loop over the boundaries
     unsigned num_bound = nboundary();
     for (unsigned long ibound = 0; ibound < num_bound; ibound++)
@@ -1479,6 +1521,973 @@ namespace oomph
              << "</VTKFile>";
   }
 
+  //========================================================
+  /// Get the data for binary paraview output: Names of the
+  /// scalar fields, (Float32) values of the scalar fields (one
+  /// block of values at all output points per field) and
+  /// coordinates (padded to three components) of the output
+  /// points, and the cell information (connectivity, offsets
+  /// and cell types).
+  ///
+  /// Breaks up each element into sub-elements for plotting
+  /// purposes, as in output_paraview(...). If
+  /// merge_nodal_plot_points is true and all plot points
+  /// coincide with the elements' nodes, the plot points at
+  /// shared nodes are only output once (provided the output
+  /// fields are continuous there; otherwise we revert to
+  /// outputting each element's plot points separately).
+  //========================================================
+  void Mesh::get_paraview_binary_data(
+    const unsigned& nplot,
+    const bool& merge_nodal_plot_points,
+    Vector<std::string>& scalar_name,
+    Vector<float>& point_value,
+    Vector<float>& point_coord,
+    Vector<int>& connectivity,
+    Vector<int>& offset,
+    Vector<unsigned char>& cell_type) const
+  {
+    // Collect the elements to be plotted
+    unsigned long n_element = this->Element_pt.size();
+    Vector<FiniteElement*> plot_el_pt;
+    plot_el_pt.reserve(n_element);
+    for (unsigned long e = 0; e < n_element; e++)
+    {
+      // Cast to FiniteElement and (in paranoid mode) check
+      // if cast has failed.
+      FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(Element_pt[e]);
+
+#ifdef PARANOID
+      if (fe_pt == 0)
+      {
+        std::stringstream error_stream;
+        error_stream << "Recast for element " << e << " failed" << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+#ifdef OOMPH_HAS_MPI
+      // Skip halo elements unless they're to be output
+      if ((!Output_halo_elements) && fe_pt->is_halo())
+      {
+        continue;
+      }
+#endif
+      plot_el_pt.push_back(fe_pt);
+    }
+    unsigned long n_plot_element = plot_el_pt.size();
+
+    // Number of scalar fields (obtained from first element)
+    unsigned n_scalar = 0;
+    if (n_plot_element > 0)
+    {
+      n_scalar = plot_el_pt[0]->nscalar_paraview();
+    }
+
+    // Determine the number of plot points and sub-elements and
+    // get the cell information for each type of element (only once)
+    Vector<unsigned long> first_plot_point(n_plot_element + 1, 0);
+    Vector<unsigned> element_type(n_plot_element);
+    std::map<std::string, unsigned> type_index;
+    Vector<Vector<int>> type_connectivity;
+    Vector<Vector<int>> type_offset;
+    Vector<Vector<unsigned char>> type_cell_type;
+    unsigned long n_cell = 0;
+    unsigned long n_connectivity = 0;
+    for (unsigned long e = 0; e < n_plot_element; e++)
+    {
+      FiniteElement* fe_pt = plot_el_pt[e];
+
+#ifdef PARANOID
+      // Check if all elements have the same number of scalars,
+      // if they don't, paraview will break
+      if (fe_pt->nscalar_paraview() != n_scalar)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Element " << e << " has different number of degrees of freedom\n"
+          << "than from previous elements, Paraview cannot handle this.\n"
+          << "We suggest that the problem is broken up into submeshes instead."
+          << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      first_plot_point[e + 1] =
+        first_plot_point[e] + fe_pt->nplot_points_paraview(nplot);
+
+      std::string type_name = typeid(*fe_pt).name();
+      std::map<std::string, unsigned>::iterator it = type_index.find(type_name);
+      if (it == type_index.end())
+      {
+        unsigned t = type_connectivity.size();
+        type_index[type_name] = t;
+        type_connectivity.resize(t + 1);
+        type_offset.resize(t + 1);
+        type_cell_type.resize(t + 1);
+        fe_pt->get_paraview_cell_information(
+          nplot, type_connectivity[t], type_offset[t], type_cell_type[t]);
+        element_type[e] = t;
+      }
+      else
+      {
+        element_type[e] = it->second;
+      }
+      n_cell += type_offset[element_type[e]].size();
+      n_connectivity += type_connectivity[element_type[e]].size();
+    }
+    unsigned long n_plot_point = first_plot_point[n_plot_element];
+
+#ifdef PARANOID
+    if (n_connectivity > INT_MAX)
+    {
+      throw OomphLibError("Too many plot points for Int32 connectivity.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Coordinates (padded to three components) and values of the
+    // scalar fields at all plot points
+    Vector<double> coord(3 * n_plot_point, 0.0);
+    Vector<double> value(n_scalar * n_plot_point);
+    Vector<double> s;
+    Vector<double> x;
+    Vector<double> el_value;
+    for (unsigned long e = 0; e < n_plot_element; e++)
+    {
+      FiniteElement* fe_pt = plot_el_pt[e];
+      unsigned n_dim = fe_pt->nodal_dimension();
+      if (n_dim > 3)
+      {
+        throw OomphLibError(
+          "Printing PlotPoint to .vtu failed; it has >3 dimensions.",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+      s.resize(fe_pt->dim());
+      x.resize(n_dim);
+      unsigned long first = first_plot_point[e];
+      unsigned n_point = first_plot_point[e + 1] - first;
+      for (unsigned j = 0; j < n_point; j++)
+      {
+        fe_pt->get_s_plot(j, nplot, s);
+        fe_pt->interpolated_x(s, x);
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          coord[3 * (first + j) + i] = x[i];
+        }
+      }
+      for (unsigned i = 0; i < n_scalar; i++)
+      {
+        fe_pt->get_scalar_values_paraview(i, nplot, el_value);
+        for (unsigned j = 0; j < n_point; j++)
+        {
+          value[i * n_plot_point + first + j] = el_value[j];
+        }
+      }
+    }
+
+    // Index of each plot point in the output (identity unless merged)
+    Vector<unsigned long> point_index(n_plot_point);
+    unsigned long n_output_point = n_plot_point;
+    bool merged = false;
+    if (merge_nodal_plot_points)
+    {
+      // Plot point that represents each output point
+      Vector<unsigned long> representative;
+      representative.reserve(n_plot_point);
+      std::map<Node*, unsigned long> node_point_index;
+      merged = true;
+      for (unsigned long e = 0; merged && (e < n_plot_element); e++)
+      {
+        FiniteElement* fe_pt = plot_el_pt[e];
+        unsigned long first = first_plot_point[e];
+        unsigned n_point = first_plot_point[e + 1] - first;
+        unsigned n_node = fe_pt->nnode();
+        if ((fe_pt->nnode_1d() != nplot) || (n_point != n_node))
+        {
+          merged = false;
+          break;
+        }
+
+        // Tolerance for the identification of plot points with nodes:
+        // Small fraction of the element's extent
+        unsigned n_dim = fe_pt->nodal_dimension();
+        double extent = 0.0;
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          double x_min = DBL_MAX;
+          double x_max = -DBL_MAX;
+          for (unsigned j = 0; j < n_point; j++)
+          {
+            x_min = std::min(x_min, coord[3 * (first + j) + i]);
+            x_max = std::max(x_max, coord[3 * (first + j) + i]);
+          }
+          extent = std::max(extent, x_max - x_min);
+        }
+        double tol = 1.0e-8 * extent;
+
+        for (unsigned j = 0; merged && (j < n_point); j++)
+        {
+          // Find the node that coincides with the plot point
+          unsigned long p = first + j;
+          Node* nod_pt = 0;
+          for (unsigned n = 0; n < n_node; n++)
+          {
+            Node* candidate_pt = fe_pt->node_pt(n);
+            double dist = 0.0;
+            for (unsigned i = 0; i < n_dim; i++)
+            {
+              double diff = candidate_pt->position(i) - coord[3 * p + i];
+              dist = std::max(dist, fabs(diff));
+            }
+            if (dist <= tol)
+            {
+              nod_pt = candidate_pt;
+              break;
+            }
+          }
+          if (nod_pt == 0)
+          {
+            merged = false;
+            break;
+          }
+
+          std::map<Node*, unsigned long>::iterator it =
+            node_point_index.find(nod_pt);
+          if (it == node_point_index.end())
+          {
+            point_index[p] = representative.size();
+            node_point_index[nod_pt] = point_index[p];
+            representative.push_back(p);
+          }
+          else
+          {
+            // Shared node: The fields have to be continuous
+            point_index[p] = it->second;
+            unsigned long q = representative[it->second];
+            for (unsigned i = 0; i < n_scalar; i++)
+            {
+              double v_p = value[i * n_plot_point + p];
+              double v_q = value[i * n_plot_point + q];
+              if (fabs(v_p - v_q) >
+                  1.0e-8 * (1.0 + std::max(fabs(v_p), fabs(v_q))))
+              {
+                merged = false;
+                break;
+              }
+            }
+          }
+        }
+      }
+
+      if (merged)
+      {
+        n_output_point = representative.size();
+      }
+    }
+
+    // No merging: Output all plot points
+    if (!merged)
+    {
+      for (unsigned long p = 0; p < n_plot_point; p++)
+      {
+        point_index[p] = p;
+      }
+    }
+
+    // Assemble the cell information
+    connectivity.resize(n_connectivity);
+    offset.resize(n_cell);
+    cell_type.resize(n_cell);
+    unsigned long connectivity_count = 0;
+    unsigned long cell_count = 0;
+    for (unsigned long e = 0; e < n_plot_element; e++)
+    {
+      unsigned t = element_type[e];
+      unsigned long first = first_plot_point[e];
+      unsigned n_sub = type_offset[t].size();
+      for (unsigned c = 0; c < n_sub; c++)
+      {
+        offset[cell_count] = connectivity_count + type_offset[t][c];
+        cell_type[cell_count] = type_cell_type[t][c];
+        cell_count++;
+      }
+      unsigned n_entry = type_connectivity[t].size();
+      for (unsigned k = 0; k < n_entry; k++)
+      {
+        connectivity[connectivity_count] =
+          point_index[first + type_connectivity[t][k]];
+        connectivity_count++;
+      }
+    }
+
+    // Names of the scalar fields
+    scalar_name.resize(n_scalar);
+    for (unsigned i = 0; i < n_scalar; i++)
+    {
+      scalar_name[i] = plot_el_pt[0]->scalar_name_paraview(i);
+    }
+
+    // Values of the scalar fields
+    point_value.resize(n_scalar * n_output_point);
+    for (unsigned i = 0; i < n_scalar; i++)
+    {
+      for (unsigned long p = 0; p < n_plot_point; p++)
+      {
+        point_value[i * n_output_point + point_index[p]] =
+          float(value[i * n_plot_point + p]);
+      }
+    }
+
+    // Coordinates
+    point_coord.resize(3 * n_output_point);
+    for (unsigned long p = 0; p < n_plot_point; p++)
+    {
+      for (unsigned i = 0; i < 3; i++)
+      {
+        point_coord[3 * point_index[p] + i] = float(coord[3 * p + i]);
+      }
+    }
+  }
+
+
+  //========================================================
+  /// Output in binary paraview format (vtu file with raw
+  /// appended data) into specified file which must have been
+  /// opened in binary mode. See get_paraview_binary_data(...)
+  /// for the merging of nodal plot points.
+  //========================================================
+  void Mesh::output_paraview_binary(
+    std::ofstream& file_out,
+    const unsigned& nplot,
+    const bool& merge_nodal_plot_points) const
+  {
+    Vector<std::string> scalar_name;
+    Vector<float> point_value;
+    Vector<float> point_coord;
+    Vector<int> connectivity;
+    Vector<int> offset;
+    Vector<unsigned char> cell_type;
+    get_paraview_binary_data(nplot,
+                             merge_nodal_plot_points,
+                             scalar_name,
+                             point_value,
+                             point_coord,
+                             connectivity,
+                             offset,
+                             cell_type);
+    ParaviewHelper::write_binary_vtu_file(file_out,
+                                          scalar_name,
+                                          point_value,
+                                          point_coord,
+                                          connectivity,
+                                          offset,
+                                          cell_type);
+  }
+
+
+  //========================================================
+  /// Output in binary paraview format for distributed meshes:
+  /// Each processor writes its own elements to
+  /// [file_stem]_on_proc[rank].vtu and the root processor
+  /// writes the master file [file_stem].pvtu. If the mesh is
+  /// not distributed we simply write [file_stem].vtu.
+  //========================================================
+  void Mesh::output_paraview_binary(
+    const std::string& file_stem,
+    const unsigned& nplot,
+    const bool& merge_nodal_plot_points) const
+  {
+#ifdef OOMPH_HAS_MPI
+    if (is_mesh_distributed())
+    {
+      OomphCommunicator* comm_pt = communicator_pt();
+      int my_rank = comm_pt->my_rank();
+      int n_proc = comm_pt->nproc();
+
+      // Write this processor's piece
+      std::ostringstream piece_filename;
+      piece_filename << file_stem << "_on_proc" << my_rank << ".vtu";
+      std::ofstream piece_file(piece_filename.str().c_str(), std::ios::binary);
+      output_paraview_binary(piece_file, nplot, merge_nodal_plot_points);
+      piece_file.close();
+
+      // The names of the scalar fields
+      Vector<std::string> scalar_name;
+      get_distributed_paraview_scalar_names(scalar_name);
+
+      // Root writes the master file. The pieces are referenced
+      // relative to the location of the master file.
+      if (my_rank == 0)
+      {
+        std::string local_stem = file_stem;
+        std::string::size_type slash_pos = file_stem.find_last_of('/');
+        if (slash_pos != std::string::npos)
+        {
+          local_stem = file_stem.substr(slash_pos + 1);
+        }
+        Vector<std::string> piece(n_proc);
+        for (int p = 0; p < n_proc; p++)
+        {
+          std::ostringstream filename;
+          filename << local_stem << "_on_proc" << p << ".vtu";
+          piece[p] = filename.str();
+        }
+        std::string pvtu_filename = file_stem + ".pvtu";
+        std::ofstream pvtu_file(pvtu_filename.c_str());
+        ParaviewHelper::write_pvtu_file(pvtu_file, piece, scalar_name);
+        pvtu_file.close();
+      }
+      return;
+    }
+#endif
+
+    // Not distributed: Write a single vtu file
+    std::string filename = file_stem + ".vtu";
+    std::ofstream file_out(filename.c_str(), std::ios::binary);
+    output_paraview_binary(file_out, nplot, merge_nodal_plot_points);
+    file_out.close();
+  }
+
+
+#ifdef OOMPH_HAS_MPI
+  //========================================================
+  /// Get the names of the scalar fields for paraview output
+  /// of a distributed mesh on all processors. They are provided
+  /// by the first processor that has any elements (the vector
+  /// is returned empty if there are no elements at all).
+  //========================================================
+  void Mesh::get_distributed_paraview_scalar_names(
+    Vector<std::string>& scalar_name) const
+  {
+    scalar_name.clear();
+
+    OomphCommunicator* comm_pt = communicator_pt();
+    int my_rank = comm_pt->my_rank();
+    int n_proc = comm_pt->nproc();
+
+    int my_rank_if_not_empty = n_proc;
+    if (nelement() > 0)
+    {
+      my_rank_if_not_empty = my_rank;
+    }
+    int source_rank = n_proc;
+    MPI_Allreduce(&my_rank_if_not_empty,
+                  &source_rank,
+                  1,
+                  MPI_INT,
+                  MPI_MIN,
+                  comm_pt->mpi_comm());
+    if (source_rank < n_proc)
+    {
+      // Broadcast the names as a single, newline-separated string
+      std::string joined_names;
+      if (my_rank == source_rank)
+      {
+        FiniteElement* fe_pt = finite_element_pt(0);
+        unsigned n_scalar = fe_pt->nscalar_paraview();
+        for (unsigned i = 0; i < n_scalar; i++)
+        {
+          joined_names += fe_pt->scalar_name_paraview(i) + "\n";
+        }
+      }
+      int n_char = joined_names.size();
+      MPI_Bcast(&n_char, 1, MPI_INT, source_rank, comm_pt->mpi_comm());
+      Vector<char> buffer(n_char + 1, '\0');
+      for (int c = 0; c < n_char; c++)
+      {
+        buffer[c] = joined_names[c];
+      }
+      MPI_Bcast(
+        &buffer[0], n_char + 1, MPI_CHAR, source_rank, comm_pt->mpi_comm());
+
+      std::string all_names = &buffer[0];
+      std::istringstream names_stream(all_names);
+      std::string name;
+      while (std::getline(names_stream, name))
+      {
+        scalar_name.push_back(name);
+      }
+    }
+  }
+#endif
+
+
+  //========================================================
+  /// Aggregated binary paraview output for distributed meshes:
+  /// The processors are split into n_aggregator contiguous
+  /// groups. The first processor in each group gathers the
+  /// data of the group's processors and writes it as a single
+  /// piece, [file_stem]_aggregate[g].vtu; the root processor
+  /// writes the master file [file_stem].pvtu. With a single
+  /// group we write [file_stem].vtu directly. If the mesh is
+  /// not distributed we simply write [file_stem].vtu.
+  //========================================================
+  void Mesh::output_paraview_binary_aggregated(
+    const std::string& file_stem,
+    const unsigned& nplot,
+    const unsigned& n_aggregator,
+    const bool& merge_nodal_plot_points) const
+  {
+#ifdef OOMPH_HAS_MPI
+    if (is_mesh_distributed())
+    {
+      OomphCommunicator* comm_pt = communicator_pt();
+      int my_rank = comm_pt->my_rank();
+      int n_proc = comm_pt->nproc();
+
+      // Number of groups (one aggregator each) and the group
+      // this processor belongs to
+      int n_group = n_aggregator;
+      if (n_group < 1)
+      {
+        n_group = 1;
+      }
+      if (n_group > n_proc)
+      {
+        n_group = n_proc;
+      }
+      int my_group = int((long(my_rank) * long(n_group)) / long(n_proc));
+
+      // Get the data for this processor's (non-halo) elements
+      Vector<std::string> local_scalar_name;
+      Vector<float> point_value;
+      Vector<float> point_coord;
+      Vector<int> connectivity;
+      Vector<int> offset;
+      Vector<unsigned char> cell_type;
+      get_paraview_binary_data(nplot,
+                               merge_nodal_plot_points,
+                               local_scalar_name,
+                               point_value,
+                               point_coord,
+                               connectivity,
+                               offset,
+                               cell_type);
+
+      // The names of the scalar fields (processors without elements
+      // don't know them)
+      Vector<std::string> scalar_name;
+      get_distributed_paraview_scalar_names(scalar_name);
+      unsigned n_scalar = scalar_name.size();
+      int n_point = point_coord.size() / 3;
+
+#ifdef PARANOID
+      // Check on all processors (and throw on all of them, so that
+      // nobody waits in the collectives below)
+      int inconsistent = (point_value.size() != unsigned(n_point) * n_scalar);
+      int any_inconsistent = 0;
+      MPI_Allreduce(&inconsistent,
+                    &any_inconsistent,
+                    1,
+                    MPI_INT,
+                    MPI_MAX,
+                    comm_pt->mpi_comm());
+      if (any_inconsistent)
+      {
+        std::ostringstream error_stream;
+        if (inconsistent)
+        {
+          error_stream << "Processor " << my_rank << " has "
+                       << point_value.size() << " scalar values for "
+                       << n_point << " points but there are " << n_scalar
+                       << " scalar fields.\n";
+        }
+        else
+        {
+          error_stream << "Inconsistent paraview data on another processor.\n";
+        }
+        error_stream << "Are the paraview output functions of the elements"
+                     << " consistent?\n";
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Communicator for the group; its first processor is the aggregator
+      MPI_Comm group_comm;
+      MPI_Comm_split(comm_pt->mpi_comm(), my_group, my_rank, &group_comm);
+      int group_rank = 0;
+      int group_size = 0;
+      MPI_Comm_rank(group_comm, &group_rank);
+      MPI_Comm_size(group_comm, &group_size);
+
+      // Gather the number of points, connectivity entries and cells
+      int local_size[3];
+      local_size[0] = n_point;
+      local_size[1] = connectivity.size();
+      local_size[2] = cell_type.size();
+      Vector<int> all_size(3 * group_size, 0);
+      MPI_Gather(
+        local_size, 3, MPI_INT, &all_size[0], 3, MPI_INT, 0, group_comm);
+
+      // Counts and displacements on the aggregator
+      Vector<int> point_count(group_size, 0);
+      Vector<int> point_displ(group_size, 0);
+      Vector<int> coord_count(group_size, 0);
+      Vector<int> coord_displ(group_size, 0);
+      Vector<int> conn_count(group_size, 0);
+      Vector<int> conn_displ(group_size, 0);
+      Vector<int> cell_count(group_size, 0);
+      Vector<int> cell_displ(group_size, 0);
+      int total_point = 0;
+      int total_conn = 0;
+      int total_cell = 0;
+      unsigned long sum_point = 0;
+      unsigned long sum_conn = 0;
+      unsigned long sum_cell = 0;
+      int too_large = 0;
+      if (group_rank == 0)
+      {
+        for (int p = 0; p < group_size; p++)
+        {
+          point_count[p] = all_size[3 * p];
+          conn_count[p] = all_size[3 * p + 1];
+          cell_count[p] = all_size[3 * p + 2];
+          sum_point += point_count[p];
+          sum_conn += conn_count[p];
+          sum_cell += cell_count[p];
+        }
+
+        // Gatherv (and vtu offsets) are limited to int
+        too_large = (3 * sum_point > INT_MAX) ||
+                    (n_scalar * sum_point > INT_MAX) ||
+                    (sum_conn > INT_MAX) || (sum_cell > INT_MAX);
+      }
+
+      // Tell the whole group if the aggregator can't cope, so that
+      // everybody throws rather than waiting in MPI_Gatherv
+      MPI_Bcast(&too_large, 1, MPI_INT, 0, group_comm);
+      if (too_large)
+      {
+        MPI_Comm_free(&group_comm);
+        std::ostringstream error_stream;
+        error_stream << "Aggregated paraview output of group " << my_group
+                     << " is too large";
+        if (group_rank == 0)
+        {
+          error_stream << " (" << sum_point << " points, " << sum_cell
+                       << " cells)";
+        }
+        error_stream << ".\nIncrease the number of aggregators.\n";
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+
+      if (group_rank == 0)
+      {
+        for (int p = 0; p < group_size; p++)
+        {
+          point_displ[p] = total_point;
+          conn_displ[p] = total_conn;
+          cell_displ[p] = total_cell;
+          coord_count[p] = 3 * point_count[p];
+          coord_displ[p] = 3 * point_displ[p];
+          total_point += point_count[p];
+          total_conn += conn_count[p];
+          total_cell += cell_count[p];
+        }
+      }
+
+      // Gather the data (with one dummy entry so that we can take the
+      // address of the first entry even if the arrays are empty)
+      Vector<float> all_value(n_scalar * total_point + 1, 0.0);
+      Vector<float> all_coord(3 * total_point + 1, 0.0);
+      Vector<int> all_connectivity(total_conn + 1, 0);
+      Vector<int> all_offset(total_cell + 1, 0);
+      Vector<unsigned char> all_cell_type(total_cell + 1, 0);
+      point_value.push_back(0.0);
+      point_coord.push_back(0.0);
+      connectivity.push_back(0);
+      offset.push_back(0);
+      cell_type.push_back(0);
+      MPI_Gatherv(&point_coord[0],
+                  3 * n_point,
+                  MPI_FLOAT,
+                  &all_coord[0],
+                  &coord_count[0],
+                  &coord_displ[0],
+                  MPI_FLOAT,
+                  0,
+                  group_comm);
+      for (unsigned s = 0; s < n_scalar; s++)
+      {
+        // Each scalar field is stored as a separate block
+        MPI_Gatherv(&point_value[s * n_point],
+                    n_point,
+                    MPI_FLOAT,
+                    &all_value[s * total_point],
+                    &point_count[0],
+                    &point_displ[0],
+                    MPI_FLOAT,
+                    0,
+                    group_comm);
+      }
+      MPI_Gatherv(&connectivity[0],
+                  local_size[1],
+                  MPI_INT,
+                  &all_connectivity[0],
+                  &conn_count[0],
+                  &conn_displ[0],
+                  MPI_INT,
+                  0,
+                  group_comm);
+      MPI_Gatherv(&offset[0],
+                  local_size[2],
+                  MPI_INT,
+                  &all_offset[0],
+                  &cell_count[0],
+                  &cell_displ[0],
+                  MPI_INT,
+                  0,
+                  group_comm);
+      MPI_Gatherv(&cell_type[0],
+                  local_size[2],
+                  MPI_UNSIGNED_CHAR,
+                  &all_cell_type[0],
+                  &cell_count[0],
+                  &cell_displ[0],
+                  MPI_UNSIGNED_CHAR,
+                  0,
+                  group_comm);
+      MPI_Comm_free(&group_comm);
+
+      // Aggregator: Renumber the points and connectivity offsets of the
+      // pieces and write the group's data
+      if (group_rank == 0)
+      {
+        for (int p = 0; p < group_size; p++)
+        {
+          int conn_end = conn_displ[p] + conn_count[p];
+          for (int i = conn_displ[p]; i < conn_end; i++)
+          {
+            all_connectivity[i] += point_displ[p];
+          }
+          int cell_end = cell_displ[p] + cell_count[p];
+          for (int i = cell_displ[p]; i < cell_end; i++)
+          {
+            all_offset[i] += conn_displ[p];
+          }
+        }
+
+        // Remove the dummy entries
+        all_value.pop_back();
+        all_coord.pop_back();
+        all_connectivity.pop_back();
+        all_offset.pop_back();
+        all_cell_type.pop_back();
+
+        std::ostringstream filename;
+        if (n_group == 1)
+        {
+          filename << file_stem << ".vtu";
+        }
+        else
+        {
+          filename << file_stem << "_aggregate" << my_group << ".vtu";
+        }
+        std::ofstream file_out(filename.str().c_str(), std::ios::binary);
+        ParaviewHelper::write_binary_vtu_file(file_out,
+                                              scalar_name,
+                                              all_value,
+                                              all_coord,
+                                              all_connectivity,
+                                              all_offset,
+                                              all_cell_type);
+        file_out.close();
+      }
+
+      // Root writes the master file if there's more than one piece.
+      // The pieces are referenced relative to the location of the
+      // master file.
+      if ((n_group > 1) && (my_rank == 0))
+      {
+        std::string local_stem = file_stem;
+        std::string::size_type slash_pos = file_stem.find_last_of('/');
+        if (slash_pos != std::string::npos)
+        {
+          local_stem = file_stem.substr(slash_pos + 1);
+        }
+        Vector<std::string> piece(n_group);
+        for (int g = 0; g < n_group; g++)
+        {
+          std::ostringstream filename;
+          filename << local_stem << "_aggregate" << g << ".vtu";
+          piece[g] = filename.str();
+        }
+        std::string pvtu_filename = file_stem + ".pvtu";
+        std::ofstream pvtu_file(pvtu_filename.c_str());
+        ParaviewHelper::write_pvtu_file(pvtu_file, piece, scalar_name);
+        pvtu_file.close();
+      }
+      return;
+    }
+#endif
+
+    // Not distributed: Write a single vtu file (the number of
+    // aggregators is irrelevant)
+    (void)n_aggregator;
+    output_paraview_binary(file_stem, nplot, merge_nodal_plot_points);
+  }
+
+
+  //========================================================
+  /// Aggregated (tecplot) output for distributed meshes: Each
+  /// processor formats the output of its elements in memory;
+  /// the pieces are then written collectively into a single
+  /// file with MPI-IO. The file starts with an index
+  /// (tecplot comment lines) that lists the byte offset and
+  /// size of each processor's piece. If n_aggregator is
+  /// non-zero it is passed to MPI-IO as the number of
+  /// aggregators (hint "cb_nodes") that perform the actual
+  /// file access. If the mesh is not distributed we simply
+  /// call output(...).
+  //========================================================
+  void Mesh::output_aggregated(const std::string& filename,
+                               const unsigned& n_plot,
+                               const unsigned& n_aggregator)
+  {
+#ifdef OOMPH_HAS_MPI
+    if (is_mesh_distributed())
+    {
+      OomphCommunicator* comm_pt = communicator_pt();
+      int my_rank = comm_pt->my_rank();
+      int n_proc = comm_pt->nproc();
+
+      // Format this processor's output
+      std::ostringstream local_stream;
+      output(local_stream, n_plot);
+      std::string local_output = local_stream.str();
+
+      // Everybody needs the sizes of all pieces to work out the offsets
+      unsigned long local_size = local_output.size();
+      Vector<unsigned long> piece_size(n_proc, 0);
+      MPI_Allgather(&local_size,
+                    1,
+                    MPI_UNSIGNED_LONG,
+                    &piece_size[0],
+                    1,
+                    MPI_UNSIGNED_LONG,
+                    comm_pt->mpi_comm());
+
+      // Build the index. Its entries have a fixed width so its size
+      // doesn't depend on the offsets: Build it once to get the size
+      // and again with the actual offsets.
+      std::string header;
+      unsigned long header_size = 0;
+      Vector<unsigned long> piece_offset(n_proc, 0);
+      for (unsigned pass = 0; pass < 2; pass++)
+      {
+        unsigned long current_offset = header_size;
+        for (int p = 0; p < n_proc; p++)
+        {
+          piece_offset[p] = current_offset;
+          current_offset += piece_size[p];
+        }
+        std::ostringstream header_stream;
+        header_stream << "# oomph-lib aggregated output: " << std::setw(10)
+                      << n_proc << " pieces\n";
+        for (int p = 0; p < n_proc; p++)
+        {
+          header_stream << "# piece " << std::setw(10) << p << " offset "
+                        << std::setw(20) << piece_offset[p] << " size "
+                        << std::setw(20) << piece_size[p] << "\n";
+        }
+        header = header_stream.str();
+        header_size = header.size();
+      }
+
+      // Root writes the index in front of its piece
+      std::string my_data;
+      MPI_Offset my_offset = piece_offset[my_rank];
+      if (my_rank == 0)
+      {
+        my_data = header + local_output;
+        my_offset = 0;
+      }
+      else
+      {
+        my_data.swap(local_output);
+      }
+
+      // Hint for the number of aggregators
+      MPI_Info info;
+      MPI_Info_create(&info);
+      if (n_aggregator > 0)
+      {
+        std::ostringstream n_aggregator_string;
+        n_aggregator_string << n_aggregator;
+        MPI_Info_set(info,
+                     const_cast<char*>("cb_nodes"),
+                     const_cast<char*>(n_aggregator_string.str().c_str()));
+      }
+
+      MPI_File file_handle;
+      int open_status = MPI_File_open(comm_pt->mpi_comm(),
+                                      const_cast<char*>(filename.c_str()),
+                                      MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                      info,
+                                      &file_handle);
+      MPI_Info_free(&info);
+      if (open_status != MPI_SUCCESS)
+      {
+        std::ostringstream error_stream;
+        error_stream << "Couldn't open " << filename
+                     << " for aggregated output.\n";
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Truncate any previous contents
+      MPI_File_set_size(file_handle, 0);
+
+      // Write in chunks whose size fits into an int. The write is
+      // collective so everybody has to make the same number of calls.
+      unsigned long chunk_size = 1ul << 30;
+      unsigned long my_data_size = my_data.size();
+      int my_n_chunk = (my_data_size + chunk_size - 1) / chunk_size;
+      int n_chunk = 0;
+      MPI_Allreduce(
+        &my_n_chunk, &n_chunk, 1, MPI_INT, MPI_MAX, comm_pt->mpi_comm());
+      char dummy = 0;
+      for (int c = 0; c < n_chunk; c++)
+      {
+        unsigned long start = c * chunk_size;
+        int count = 0;
+        char* data_pt = &dummy;
+        if (start < my_data_size)
+        {
+          count = std::min(chunk_size, my_data_size - start);
+          data_pt = &my_data[start];
+        }
+        MPI_Status status;
+        MPI_File_write_at_all(file_handle,
+                              my_offset + MPI_Offset(start),
+                              data_pt,
+                              count,
+                              MPI_CHAR,
+                              &status);
+      }
+      MPI_File_close(&file_handle);
+      return;
+    }
+#endif
+
+    // Not distributed: Plain output (the number of aggregators is
+    // irrelevant)
+    (void)n_aggregator;
+    std::ofstream outfile(filename.c_str());
+    output(outfile, n_plot);
+    outfile.close();
+  }
+
 
   //========================================================
   /// Output in paraview format into specified file.
@@ -2026,6 +3035,9 @@ namespace oomph
   //========================================================
   void Mesh::output(std::ostream& outfile)
   {
+    // Format doubles with the fast num_put facet
+    NumericOutput::FastFormattingGuard fast_formatting_guard(outfile);
+
     // Loop over the elements and call their output functions
     // Assign Element_pt_range
     unsigned long Element_pt_range = Element_pt.size();
@@ -2068,6 +3080,9 @@ namespace oomph
   //========================================================
   void Mesh::output(std::ostream& outfile, const unsigned& n_plot)
   {
+    // Format doubles with the fast num_put facet
+    NumericOutput::FastFormattingGuard fast_formatting_guard(outfile);
+
     // Loop over the elements and call their output functions
     // Assign Element_pt_range
     unsigned long Element_pt_range = Element_pt.size();
@@ -2200,6 +3215,9 @@ namespace oomph
                         const unsigned& n_plot,
                         FiniteElement::SteadyExactSolutionFctPt exact_soln_pt)
   {
+    // Format doubles with the fast num_put facet
+    NumericOutput::FastFormattingGuard fast_formatting_guard(outfile);
+
     // Loop over the elements and call their output functions
     // Assign Element_pt_range
     unsigned long Element_pt_range = Element_pt.size();
@@ -2245,6 +3263,9 @@ namespace oomph
                         const double& time,
                         FiniteElement::UnsteadyExactSolutionFctPt exact_soln_pt)
   {
+    // Format doubles with the fast num_put facet
+    NumericOutput::FastFormattingGuard fast_formatting_guard(outfile);
+
     // Loop over the elements and call their output functions
     // Assign Element_pt_range
     unsigned long Element_pt_range = Element_pt.size();
@@ -5610,6 +6631,222 @@ namespace oomph
   }
 
 
+  //========================================================================
+  /// Setup the halo/haloed lookup schemes for a mesh that has been
+  /// built "locally", i.e. that only contains the elements it's in
+  /// charge of plus the halo layer (all other elements that share a node
+  /// with them). global_element_number[e] and element_domain[e] specify
+  /// the number of the e-th element in the (never assembled) global mesh
+  /// and the processor in charge of it. The root haloed elements are
+  /// identified by point-to-point exchanges with the neighbouring
+  /// processors only.
+  //========================================================================
+  void Mesh::distribute_locally_built_mesh(
+    OomphCommunicator* comm_pt,
+    const Vector<unsigned long>& global_element_number,
+    const Vector<unsigned>& element_domain,
+    DocInfo& doc_info,
+    const bool& report_stats)
+  {
+    // Store communicator
+    Comm_pt = comm_pt;
+
+    // Storage for number of processors and current processor
+    int n_proc = comm_pt->nproc();
+    int my_rank = comm_pt->my_rank();
+
+    // Number of (locally built) elements
+    unsigned nelem = this->nelement();
+
+#ifdef PARANOID
+    if ((global_element_number.size() != nelem) ||
+        (element_domain.size() != nelem))
+    {
+      std::ostringstream error_message;
+      error_message << "Mesh has " << nelem << " elements but "
+                    << global_element_number.size()
+                    << " global element numbers and " << element_domain.size()
+                    << " element domains were specified.\n";
+      throw OomphLibError(
+        error_message.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    for (unsigned e = 0; e < nelem; e++)
+    {
+      if (element_domain[e] >= unsigned(n_proc))
+      {
+        std::ostringstream error_message;
+        error_message << "Element " << e << " is assigned to domain "
+                      << element_domain[e] << " but there are only " << n_proc
+                      << " processors.\n";
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+#endif
+
+    // Wipe any existing halo(ed) element schemes
+    Root_halo_element_pt.clear();
+    Root_haloed_element_pt.clear();
+
+    // Sort the elements by global element number: the ones this
+    // processor is in charge of (to find the root haloed elements below)
+    // and the halo elements, sorted by the processor in charge of them
+    // (so that the root halo elements are stored in the same order
+    // as their haloed counterparts)
+    Vector<std::pair<unsigned long, unsigned>> my_element;
+    std::map<unsigned, Vector<std::pair<unsigned long, unsigned>>>
+      halo_element;
+    for (unsigned e = 0; e < nelem; e++)
+    {
+      std::pair<unsigned long, unsigned> entry(global_element_number[e], e);
+      if (element_domain[e] == unsigned(my_rank))
+      {
+        my_element.push_back(entry);
+      }
+      else
+      {
+        halo_element[element_domain[e]].push_back(entry);
+      }
+    }
+    std::sort(my_element.begin(), my_element.end());
+
+    // Add the root halo elements and tell the processors in charge of
+    // them which ones we hold
+    Vector<Vector<unsigned long>> send_data;
+    Vector<MPI_Request> send_request;
+    send_data.reserve(halo_element.size());
+    send_request.reserve(halo_element.size());
+    Vector<int> n_message_to_proc(n_proc, 0);
+    for (std::map<unsigned, Vector<std::pair<unsigned long, unsigned>>>::
+           iterator it = halo_element.begin();
+         it != halo_element.end();
+         it++)
+    {
+      unsigned d = it->first;
+      std::sort(it->second.begin(), it->second.end());
+      send_data.push_back(Vector<unsigned long>());
+      unsigned n = it->second.size();
+      send_data.back().reserve(n);
+      for (unsigned i = 0; i < n; i++)
+      {
+        GeneralisedElement* el_pt = this->element_pt(it->second[i].second);
+        this->add_root_halo_element_pt(d, el_pt);
+        send_data.back().push_back(it->second[i].first);
+      }
+      n_message_to_proc[d] = 1;
+    }
+
+    // How many processors hold halo copies of our elements?
+    int n_message = 0;
+    MPI_Reduce_scatter_block(&n_message_to_proc[0],
+                             &n_message,
+                             1,
+                             MPI_INT,
+                             MPI_SUM,
+                             comm_pt->mpi_comm());
+
+    // Send the global numbers of the halo elements
+    unsigned count = 0;
+    for (std::map<unsigned, Vector<std::pair<unsigned long, unsigned>>>::
+           iterator it = halo_element.begin();
+         it != halo_element.end();
+         it++)
+    {
+      send_request.push_back(MPI_Request());
+      MPI_Isend(&send_data[count][0],
+                send_data[count].size(),
+                MPI_UNSIGNED_LONG,
+                it->first,
+                Locally_built_mesh_tag,
+                comm_pt->mpi_comm(),
+                &send_request.back());
+      count++;
+    }
+
+    // Receive the global numbers of our elements that are halo
+    // elements elsewhere; they become root haloed elements
+    for (int i = 0; i < n_message; i++)
+    {
+      MPI_Status status;
+      MPI_Probe(MPI_ANY_SOURCE,
+                Locally_built_mesh_tag,
+                comm_pt->mpi_comm(),
+                &status);
+      int n_received = 0;
+      MPI_Get_count(&status, MPI_UNSIGNED_LONG, &n_received);
+      Vector<unsigned long> received(n_received);
+      MPI_Recv(&received[0],
+               n_received,
+               MPI_UNSIGNED_LONG,
+               status.MPI_SOURCE,
+               Locally_built_mesh_tag,
+               comm_pt->mpi_comm(),
+               MPI_STATUS_IGNORE);
+
+      for (int j = 0; j < n_received; j++)
+      {
+        Vector<std::pair<unsigned long, unsigned>>::iterator it =
+          std::lower_bound(my_element.begin(),
+                           my_element.end(),
+                           std::make_pair(received[j], 0u));
+        if ((it == my_element.end()) || (it->first != received[j]))
+        {
+          std::ostringstream error_message;
+          error_message << "Processor " << status.MPI_SOURCE
+                        << " holds a halo copy of global element "
+                        << received[j] << " which should be in the charge"
+                        << " of processor " << my_rank
+                        << ", but it hasn't been built here.\n";
+          throw OomphLibError(error_message.str(),
+                              OOMPH_CURRENT_FUNCTION,
+                              OOMPH_EXCEPTION_LOCATION);
+        }
+        GeneralisedElement* el_pt = this->element_pt(it->second);
+        this->add_root_haloed_element_pt(status.MPI_SOURCE, el_pt);
+      }
+    }
+    if (!send_request.empty())
+    {
+      MPI_Waitall(
+        send_request.size(), &send_request[0], MPI_STATUSES_IGNORE);
+    }
+
+    // Doc stats
+    if (report_stats)
+    {
+      oomph_info << "Processor " << my_rank << " holds " << this->nelement()
+                 << " elements of which " << this->nroot_halo_element()
+                 << " are root halo elements \n while "
+                 << this->nroot_haloed_element() << " are root haloed elements"
+                 << std::endl;
+    }
+
+    // Setup boundary element info
+    this->setup_boundary_element_info();
+
+    // Re-setup tree forest. (Call this every time even if
+    // a (distributed) mesh has no elements on this processor.
+    // We still need to participate in communication.)
+    TreeBasedRefineableMeshBase* ref_mesh_pt =
+      dynamic_cast<TreeBasedRefineableMeshBase*>(this);
+    if (ref_mesh_pt != 0)
+    {
+      ref_mesh_pt->setup_tree_forest();
+    }
+
+    // Classify nodes
+    classify_halo_and_haloed_nodes(doc_info, report_stats);
+
+    // Doc?
+    //-----
+    if (doc_info.is_doc_enabled())
+    {
+      doc_mesh_distribution(doc_info);
+    }
+  }
+
+
   //========================================================================
   /// (Irreversibly) prune halo(ed) elements and nodes, usually
   /// after another round of refinement, to get rid of
@@ -6852,7 +8089,8 @@ namespace oomph
 
 
     // Doc elements next to boundaries scheme
-    // if set up
+    // if set up (or deferred)
+    this->setup_deferred_boundary_element_info();
     if (Lookup_for_elements_next_boundary_is_setup)
     {
       // How many finite elements are adjacent to boundary b?
@@ -9641,6 +10879,187 @@ namespace oomph
       pvd_file << "</Collection>" << std::endl << "</VTKFile>";
     }
 
+    /// \short Write the pvtu master file for a distributed vtu output,
+    /// referencing the pieces (one vtu file per processor) in
+    /// piece_filename.
+    void write_pvtu_file(std::ofstream& pvtu_file,
+                         const Vector<std::string>& piece_filename,
+                         const Vector<std::string>& scalar_name)
+    {
+      pvtu_file << "<?xml version=\"1.0\"?>\n"
+                << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" "
+                << "byte_order=\""
+                << (is_little_endian() ? "LittleEndian" : "BigEndian")
+                << "\" header_type=\"UInt64\">\n"
+                << "<PUnstructuredGrid GhostLevel=\"0\">\n";
+
+      // Point data
+      unsigned n_scalar = scalar_name.size();
+      if (n_scalar > 0)
+      {
+        pvtu_file << "<PPointData Scalars=\"" << scalar_name[0] << "\">\n";
+        for (unsigned i = 0; i < n_scalar; i++)
+        {
+          pvtu_file << "<PDataArray type=\"Float32\" Name=\"" << scalar_name[i]
+                    << "\"/>\n";
+        }
+        pvtu_file << "</PPointData>\n";
+      }
+
+      // Points
+      pvtu_file << "<PPoints>\n"
+                << "<PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n"
+                << "</PPoints>\n";
+
+      // The pieces
+      unsigned n_piece = piece_filename.size();
+      for (unsigned p = 0; p < n_piece; p++)
+      {
+        pvtu_file << "<Piece Source=\"" << piece_filename[p] << "\"/>\n";
+      }
+
+      pvtu_file << "</PUnstructuredGrid>\n"
+                << "</VTKFile>";
+    }
+
+    /// \short Write a block of raw binary data (preceded by its size in
+    /// bytes, as a 64 bit unsigned integer) to the appended data section
+    /// of a vtu file
+    void write_appended_data_block(std::ofstream& file_out,
+                                   const void* data_pt,
+                                   const unsigned long& n_byte)
+    {
+      unsigned long long block_size = n_byte;
+      file_out.write(reinterpret_cast<const char*>(&block_size),
+                     sizeof(block_size));
+      if (n_byte > 0)
+      {
+        file_out.write(reinterpret_cast<const char*>(data_pt), n_byte);
+      }
+    }
+
+    /// \short Write a binary vtu file (with raw appended data) for the
+    /// specified data: Names and (Float32) values of the scalar fields
+    /// (one block of values at all points per field), coordinates (three
+    /// per point) and the cell information. The file must have been
+    /// opened in binary mode.
+    void write_binary_vtu_file(
+      std::ofstream& file_out,
+      const Vector<std::string>& scalar_name,
+      const Vector<float>& point_value,
+      const Vector<float>& point_coord,
+      const Vector<int>& connectivity,
+      const Vector<int>& offset,
+      const Vector<unsigned char>& cell_type)
+    {
+      unsigned n_scalar = scalar_name.size();
+      unsigned long n_output_point = point_coord.size() / 3;
+      unsigned long n_cell = offset.size();
+      unsigned long n_connectivity = connectivity.size();
+
+      // File Declaration
+      //------------------
+
+      // Byte offsets of the data blocks in the appended data section
+      // (each block is preceded by its size as a 64 bit unsigned integer)
+      unsigned long appended_offset = 0;
+      unsigned long header_size = 8;
+
+      file_out << "<?xml version=\"1.0\"?>\n"
+               << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+               << "byte_order=\""
+               << (is_little_endian() ? "LittleEndian" :
+                                                        "BigEndian")
+               << "\" header_type=\"UInt64\">\n"
+               << "<UnstructuredGrid>\n"
+               << "<Piece NumberOfPoints=\"" << n_output_point
+               << "\" NumberOfCells=\"" << n_cell << "\">\n";
+
+      // Point Data
+      //-----------
+      if (n_scalar > 0)
+      {
+        file_out << "<PointData Scalars=\"" << scalar_name[0] << "\">\n";
+        for (unsigned i = 0; i < n_scalar; i++)
+        {
+          file_out << "<DataArray type=\"Float32\" "
+                   << "Name=\"" << scalar_name[i]
+                   << "\" format=\"appended\" offset=\"" << appended_offset
+                   << "\"/>\n";
+          appended_offset += header_size + sizeof(float) * n_output_point;
+        }
+        file_out << "</PointData>\n";
+      }
+
+      // Geometric Points
+      //------------------
+      file_out << "<Points>\n"
+               << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+               << "format=\"appended\" offset=\"" << appended_offset
+               << "\"/>\n"
+               << "</Points>\n";
+      appended_offset += header_size + 3 * sizeof(float) * n_output_point;
+
+      // Cells
+      //-------
+      file_out << "<Cells>\n"
+               << "<DataArray type=\"Int32\" Name=\"connectivity\" "
+               << "format=\"appended\" offset=\"" << appended_offset
+               << "\"/>\n";
+      appended_offset += header_size + sizeof(int) * n_connectivity;
+      file_out << "<DataArray type=\"Int32\" Name=\"offsets\" "
+               << "format=\"appended\" offset=\"" << appended_offset
+               << "\"/>\n";
+      appended_offset += header_size + sizeof(int) * n_cell;
+      file_out << "<DataArray type=\"UInt8\" Name=\"types\" "
+               << "format=\"appended\" offset=\"" << appended_offset
+               << "\"/>\n"
+               << "</Cells>\n"
+               << "</Piece>\n"
+               << "</UnstructuredGrid>\n"
+               << "<AppendedData encoding=\"raw\">\n_";
+
+
+      // Appended data
+      //--------------
+
+      // Scalar fields
+      for (unsigned i = 0; i < n_scalar; i++)
+      {
+        write_appended_data_block(
+          file_out,
+          n_output_point > 0 ? &point_value[i * n_output_point] : 0,
+          sizeof(float) * n_output_point);
+      }
+
+      // Coordinates
+      write_appended_data_block(file_out,
+                                n_output_point > 0 ? &point_coord[0] : 0,
+                                3 * sizeof(float) * n_output_point);
+
+      // Cells
+      write_appended_data_block(
+        file_out,
+        n_connectivity > 0 ? &connectivity[0] : 0,
+        sizeof(int) * n_connectivity);
+      write_appended_data_block(
+        file_out, n_cell > 0 ? &offset[0] : 0, sizeof(int) * n_cell);
+      write_appended_data_block(
+        file_out, n_cell > 0 ? &cell_type[0] : 0, n_cell);
+
+      // File Closure
+      //-------------
+      file_out << "\n</AppendedData>\n"
+               << "</VTKFile>";
+    }
+
+    /// Is this machine little endian?
+    bool is_little_endian()
+    {
+      unsigned short one = 1;
+      return *reinterpret_cast<unsigned char*>(&one) == 1;
+    }
+
   } // namespace ParaviewHelper
 
   ////////////////////////////////////////////////////////////////
@@ -51,6 +51,7 @@
 #include "generalised_timesteppers.h"
 #include "matrices.h"
 #include "refineable_elements.h"
+#include "numeric_output.h"
 
 namespace oomph
 {
@@ -94,6 +95,41 @@ namespace oomph
     /// the face that lies along that boundary
     Vector<Vector<int>> Face_index_at_boundary;
 
+    /// \short Flag to indicate that the setup of the lookup schemes for
+    /// elements that are adjacent to the boundaries has been deferred
+    /// until they're first accessed (see
+    /// defer_boundary_element_info_setup())
+    bool Boundary_element_info_setup_is_deferred;
+
+    /// \short Request the setup of the lookup schemes for elements that are
+    /// adjacent to the boundaries: If Setup_boundary_element_info_on_demand
+    /// is true, the setup is deferred until the schemes are first accessed
+    /// via boundary_element_pt(...), nboundary_element(...) or
+    /// face_index_at_boundary(...) (so meshes whose boundary elements are
+    /// never used don't pay for it); otherwise setup_boundary_element_info()
+    /// is called straightaway. Only use this if the mesh accesses
+    /// Boundary_element_pt and Face_index_at_boundary through these
+    /// functions. Note: This is only used by the structured meshes.
+    /// The unstructured meshes (TetgenMesh, TriangleMesh, XdaTetMesh,
+    /// GmshTetMesh, ...) fill the lookup schemes while the elements are
+    /// built from the mesh generator's output and need them straightaway
+    /// to set up the boundary coordinates (which are stored at the
+    /// nodes and accessed directly rather than via the mesh), so their
+    /// setup remains eager.
+    void defer_boundary_element_info_setup()
+    {
+      if (Setup_boundary_element_info_on_demand)
+      {
+        Lookup_for_elements_next_boundary_is_setup = false;
+        Boundary_element_info_setup_is_deferred = true;
+      }
+      else
+      {
+        Boundary_element_info_setup_is_deferred = false;
+        setup_boundary_element_info();
+      }
+    }
+
 #ifdef OOMPH_HAS_MPI
 
     /// Map of vectors holding the pointers to the root halo elements
@@ -146,6 +182,10 @@ namespace oomph
     /// Setup shared node scheme
     void setup_shared_node_scheme();
 
+    /// \short MPI tag used when setting up the halo schemes of a locally
+    /// built mesh
+    static const int Locally_built_mesh_tag = 4204;
+
 #endif
 
     /// \short Assign the global equation numbers in the Data stored at the
@@ -232,11 +272,18 @@ namespace oomph
     /// timestepper function
     static bool Suppress_warning_about_empty_mesh_level_time_stepper_function;
 
+    /// \short Boolean to control whether meshes may defer the setup of the
+    /// lookup schemes for elements that are adjacent to the boundaries
+    /// until they're first accessed (default: true). Only affects the
+    /// structured meshes; see defer_boundary_element_info_setup().
+    static bool Setup_boundary_element_info_on_demand;
+
     /// \short Default constructor
     Mesh()
     {
       // Lookup scheme hasn't been setup yet
       Lookup_for_elements_next_boundary_is_setup = false;
+      Boundary_element_info_setup_is_deferred = false;
 #ifdef OOMPH_HAS_MPI
       // Set defaults for distributed meshes
 
@@ -280,6 +327,23 @@ namespace oomph
     /// Mesh classes)
     virtual void setup_boundary_element_info(std::ostream& outfile) {}
 
+    /// \short Set up the lookup schemes for elements that are adjacent to
+    /// the boundaries now if their setup has been deferred (see
+    /// defer_boundary_element_info_setup()). Called automatically when the
+    /// schemes are first accessed. Thread-safety: Concurrent calls are
+    /// serialised by an OpenMP critical section, so the setup is only
+    /// done once, and the flag that marks the setup as deferred is only
+    /// cleared once the schemes are complete. However, the check of that
+    /// flag in boundary_element_pt(...), nboundary_element(...) and
+    /// face_index_at_boundary(...) isn't synchronised, so code that
+    /// accesses the schemes from multiple threads should call this
+    /// function first (before the threaded region). The library's own
+    /// threaded regions (the threaded assembly and the threaded
+    /// locate_zeta(...) in the sample point containers and the
+    /// multi-domain setup) only work with the elements and never access
+    /// the schemes.
+    void setup_deferred_boundary_element_info() const;
+
     /// Virtual function to perform the reset boundary elements info rutines
     virtual void reset_boundary_element_info(
       Vector<unsigned>& ntmp_boundary_elements,
@@ -847,6 +911,12 @@ namespace oomph
     FiniteElement* boundary_element_pt(const unsigned& b,
                                        const unsigned& e) const
     {
+      // Set up the lookup scheme now if its setup has been deferred
+      if ((!Lookup_for_elements_next_boundary_is_setup) &&
+          Boundary_element_info_setup_is_deferred)
+      {
+        setup_deferred_boundary_element_info();
+      }
 #ifdef PARANOID
       if (!Lookup_for_elements_next_boundary_is_setup)
       {
@@ -884,6 +954,12 @@ namespace oomph
     /// Return number of finite elements that are adjacent to boundary b
     unsigned nboundary_element(const unsigned& b) const
     {
+      // Set up the lookup scheme now if its setup has been deferred
+      if ((!Lookup_for_elements_next_boundary_is_setup) &&
+          Boundary_element_info_setup_is_deferred)
+      {
+        setup_deferred_boundary_element_info();
+      }
 #ifdef PARANOID
       if (!Lookup_for_elements_next_boundary_is_setup)
       {
@@ -902,6 +978,12 @@ namespace oomph
     /// with input required during the generation of FaceElements.
     int face_index_at_boundary(const unsigned& b, const unsigned& e) const
     {
+      // Set up the lookup scheme now if its setup has been deferred
+      if ((!Lookup_for_elements_next_boundary_is_setup) &&
+          Boundary_element_info_setup_is_deferred)
+      {
+        setup_deferred_boundary_element_info();
+      }
 #ifdef PARANOID
       if (!Lookup_for_elements_next_boundary_is_setup)
       {
@@ -945,6 +1027,74 @@ namespace oomph
     /// elements are inconsistent).
     void output_paraview(std::ofstream& file_out, const unsigned& nplot) const;
 
+    /// \short Output in binary paraview format (vtu file with raw
+    /// appended data) into specified file which must have been opened
+    /// in binary mode. Same assumptions as for output_paraview(...).
+    /// If merge_nodal_plot_points is true and the plot points coincide
+    /// with the elements' nodes (i.e. nplot equals the number of nodes
+    /// along the element edges) plot points at shared nodes are only
+    /// written once. Merging is abandoned (and each element's plot
+    /// points written separately) if any element's plot points don't
+    /// coincide with its nodes or if the output fields are discontinuous
+    /// across element boundaries. Halo elements are not output
+    /// (unless enabled with enable_output_of_halo_elements()).
+    void output_paraview_binary(
+      std::ofstream& file_out,
+      const unsigned& nplot,
+      const bool& merge_nodal_plot_points = true) const;
+
+    /// \short Output in binary paraview format for distributed meshes:
+    /// Each processor writes its own (non-halo) elements to
+    /// [file_stem]_on_proc[rank].vtu (via output_paraview_binary(...)) and
+    /// the root processor writes the master file [file_stem].pvtu
+    /// that references the pieces. Equivalent to
+    /// output_paraview_binary(...) writing to [file_stem].vtu if the mesh
+    /// is not distributed.
+    void output_paraview_binary(
+      const std::string& file_stem,
+      const unsigned& nplot,
+      const bool& merge_nodal_plot_points = true) const;
+
+  private:
+#ifdef OOMPH_HAS_MPI
+    /// \short Helper function: Get the names of the scalar fields for
+    /// paraview output of a distributed mesh on all processors (they're
+    /// provided by the first processor that has any elements).
+    void get_distributed_paraview_scalar_names(
+      Vector<std::string>& scalar_name) const;
+#endif
+
+  public:
+    /// \short Aggregated binary paraview output for distributed meshes,
+    /// avoiding one file per processor: The processors are split into
+    /// n_aggregator contiguous groups; the data (see
+    /// get_paraview_binary_data(...)) of all processors in a group is
+    /// gathered on the group's first processor which writes it to
+    /// [file_stem]_aggregate[g].vtu; the root processor writes the master
+    /// file [file_stem].pvtu. If there's only one group (or the mesh is
+    /// not distributed) everything goes into a single file,
+    /// [file_stem].vtu.
+    void output_paraview_binary_aggregated(
+      const std::string& file_stem,
+      const unsigned& nplot,
+      const unsigned& n_aggregator = 1,
+      const bool& merge_nodal_plot_points = true) const;
+
+    /// \short Get the data for binary paraview output of the (non-halo)
+    /// elements: Names of the scalar fields, (Float32) values of the
+    /// scalar fields (one block of values at all output points per field),
+    /// coordinates (padded to three components) of the output points,
+    /// and the cell information (connectivity, offsets and cell types).
+    /// See output_paraview_binary(...) for the merging of plot points.
+    void get_paraview_binary_data(const unsigned& nplot,
+                                  const bool& merge_nodal_plot_points,
+                                  Vector<std::string>& scalar_name,
+                                  Vector<float>& point_value,
+                                  Vector<float>& point_coord,
+                                  Vector<int>& connectivity,
+                                  Vector<int>& offset,
+                                  Vector<unsigned char>& cell_type) const;
+
     /// \short Output in paraview format into specified file. Breaks up each
     /// element into sub-elements for plotting purposes. We assume
     /// that all elements are of the same type (fct will break
@@ -972,6 +1122,18 @@ namespace oomph
     /// Output at f(n_plot) points in each element
     void output(std::ostream& outfile, const unsigned& n_plot);
 
+    /// \short Aggregated (tecplot) output for distributed meshes: The
+    /// output of all processors' (non-halo) elements is written
+    /// collectively (with MPI-IO) into a single file, preceded by
+    /// an index (comment lines with the byte offset and size of each
+    /// processor's output). If n_aggregator is non-zero it is passed to
+    /// MPI-IO as the number of aggregators for the collective write
+    /// (hint "cb_nodes"). Equivalent to output(filename, n_plot) if the
+    /// mesh is not distributed.
+    void output_aggregated(const std::string& filename,
+                           const unsigned& n_plot,
+                           const unsigned& n_aggregator = 0);
+
     /// Output for all elements (C-style output)
     void output(FILE* file_pt);
 
@@ -981,8 +1143,7 @@ namespace oomph
     /// Output for all elements
     void output(const std::string& output_filename)
     {
-      std::ofstream outfile;
-      outfile.open(output_filename.c_str());
+      NumericOutput::BufferedOfstream outfile(output_filename);
       output(outfile);
       outfile.close();
     }
@@ -990,8 +1151,7 @@ namespace oomph
     /// Output at f(n_plot) points in each element
     void output(const std::string& output_filename, const unsigned& n_plot)
     {
-      std::ofstream outfile;
-      outfile.open(output_filename.c_str());
+      NumericOutput::BufferedOfstream outfile(output_filename);
       output(outfile, n_plot);
       outfile.close();
     }
@@ -1015,8 +1175,7 @@ namespace oomph
     /// Specify filename
     void output_boundaries(const std::string& output_filename)
     {
-      std::ofstream outfile;
-      outfile.open(output_filename.c_str());
+      NumericOutput::BufferedOfstream outfile(output_filename);
       output_boundaries(outfile);
       outfile.close();
     }
@@ -1665,6 +1824,24 @@ namespace oomph
                         overrule_keep_as_halo_element_status);
     }
 
+    /// \short Setup the halo/haloed lookup schemes for a mesh that has
+    /// been built "locally", i.e. that only contains the elements
+    /// required on this processor: the ones it's in charge of plus
+    /// the halo layer (all other elements that share a node with them).
+    /// global_element_number[e] and element_domain[e] specify the
+    /// number of the e-th element in the (never assembled) global mesh
+    /// and the processor in charge of it. Elements that are built on
+    /// different processors must be identical, i.e. have the same nodes
+    /// in the same order. Only neighbouring processors communicate, so
+    /// the memory usage scales with the size of the local mesh rather
+    /// than the global one.
+    void distribute_locally_built_mesh(
+      OomphCommunicator* comm_pt,
+      const Vector<unsigned long>& global_element_number,
+      const Vector<unsigned>& element_domain,
+      DocInfo& doc_info,
+      const bool& report_stats = false);
+
     /// \short (Irreversibly) prune halo(ed) elements and nodes, usually
     /// after another round of refinement, to get rid of
     /// excessively wide halo layers. Note that the current
@@ -2917,6 +3094,37 @@ namespace oomph
     /// Write the pvd file footer
     extern void write_pvd_footer(std::ofstream& pvd_file);
 
+    /// \short Write the pvtu master file for a distributed vtu output,
+    /// referencing the pieces (one vtu file per processor) in
+    /// piece_filename. The pieces contain the specified (Float32) scalar
+    /// fields and (Float32) point coordinates.
+    extern void write_pvtu_file(std::ofstream& pvtu_file,
+                                const Vector<std::string>& piece_filename,
+                                const Vector<std::string>& scalar_name);
+
+    /// \short Write a block of raw binary data (preceded by its size in
+    /// bytes, as a 64 bit unsigned integer) to the appended data section
+    /// of a vtu file
+    extern void write_appended_data_block(std::ofstream& file_out,
+                                          const void* data_pt,
+                                          const unsigned long& n_byte);
+
+    /// \short Write a binary vtu file (with raw appended data) for the
+    /// specified data: Names and (Float32) values of the scalar fields
+    /// (one block of values at all points per field), coordinates (three
+    /// per point) and the cell information. The file must have been
+    /// opened in binary mode.
+    extern void write_binary_vtu_file(std::ofstream& file_out,
+                                      const Vector<std::string>& scalar_name,
+                                      const Vector<float>& point_value,
+                                      const Vector<float>& point_coord,
+                                      const Vector<int>& connectivity,
+                                      const Vector<int>& offset,
+                                      const Vector<unsigned char>& cell_type);
+
+    /// Is this machine little endian?
+    extern bool is_little_endian();
+
   } // namespace ParaviewHelper
 
   ////////////////////////////////////////////////////////////////
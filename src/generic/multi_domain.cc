@@ -36,6 +36,311 @@
 
 namespace oomph
 {
+#ifdef OOMPH_HAS_MPI
+
+  //======================================================================
+  /// Build the tree for the boxes stored in flat_packed_box: The min.
+  /// and max. i-th coordinate of box b are stored in
+  /// flat_packed_box[2*(b*dim+i)] and flat_packed_box[2*(b*dim+i)+1],
+  /// respectively. Empty boxes (min. > max.) are ignored.
+  //======================================================================
+  void BoundingBoxTree::build(const Vector<double>& flat_packed_box,
+                              const unsigned& dim)
+  {
+    Dim = dim;
+    Node_box.clear();
+    First_son.clear();
+    Leaf_box_number.clear();
+
+    // Collect the non-empty boxes
+    Vector<unsigned> box_number;
+    unsigned n_box = flat_packed_box.size() / (2 * Dim);
+    for (unsigned b = 0; b < n_box; b++)
+    {
+      if (flat_packed_box[2 * b * Dim] <= flat_packed_box[2 * b * Dim + 1])
+      {
+        box_number.push_back(b);
+      }
+    }
+    unsigned n_leaf = box_number.size();
+    if (n_leaf == 0)
+    {
+      return;
+    }
+
+    // A binary tree with n_leaf leaves has 2*n_leaf-1 nodes
+    unsigned n_tree_node = 2 * n_leaf - 1;
+    Node_box.resize(2 * Dim * n_tree_node);
+    First_son.resize(n_tree_node, -1);
+    Leaf_box_number.resize(n_tree_node, 0);
+
+    // Build it recursively, starting from the root
+    n_tree_node = 1;
+    build_subtree(0, flat_packed_box, box_number, 0, n_leaf, n_tree_node);
+  }
+
+
+  //======================================================================
+  /// Helper function to build the subtree (rooted at the tree node
+  /// tree_node) that contains the boxes box_number[first],...,
+  /// box_number[last-1]: The boxes are split in two halves according
+  /// to the position of their centres in the direction in which the
+  /// centres are spread most widely.
+  //======================================================================
+  void BoundingBoxTree::build_subtree(const unsigned& tree_node,
+                                      const Vector<double>& flat_packed_box,
+                                      Vector<unsigned>& box_number,
+                                      const unsigned& first,
+                                      const unsigned& last,
+                                      unsigned& n_tree_node)
+  {
+    // Box enclosing all the boxes in the subtree and the range of
+    // their centres
+    double* node_box_pt = &Node_box[2 * Dim * tree_node];
+    Vector<double> centre_min(Dim, DBL_MAX);
+    Vector<double> centre_max(Dim, -DBL_MAX);
+    for (unsigned i = 0; i < Dim; i++)
+    {
+      node_box_pt[2 * i] = DBL_MAX;
+      node_box_pt[2 * i + 1] = -DBL_MAX;
+    }
+    for (unsigned j = first; j < last; j++)
+    {
+      const double* box_pt = &flat_packed_box[2 * Dim * box_number[j]];
+      for (unsigned i = 0; i < Dim; i++)
+      {
+        node_box_pt[2 * i] = std::min(node_box_pt[2 * i], box_pt[2 * i]);
+        node_box_pt[2 * i + 1] =
+          std::max(node_box_pt[2 * i + 1], box_pt[2 * i + 1]);
+        double centre = 0.5 * (box_pt[2 * i] + box_pt[2 * i + 1]);
+        centre_min[i] = std::min(centre_min[i], centre);
+        centre_max[i] = std::max(centre_max[i], centre);
+      }
+    }
+
+    // Leaf?
+    if (last - first == 1)
+    {
+      Leaf_box_number[tree_node] = box_number[first];
+      return;
+    }
+
+    // Split direction
+    unsigned split_dir = 0;
+    for (unsigned i = 1; i < Dim; i++)
+    {
+      if (centre_max[i] - centre_min[i] >
+          centre_max[split_dir] - centre_min[split_dir])
+      {
+        split_dir = i;
+      }
+    }
+
+    // Move the boxes whose centres are in the lower half (in the
+    // split direction) to the front
+    unsigned middle = (first + last) / 2;
+    unsigned dim = Dim;
+    std::nth_element(box_number.begin() + first,
+                     box_number.begin() + middle,
+                     box_number.begin() + last,
+                     [&](const unsigned& box1, const unsigned& box2) {
+                       unsigned i1 = 2 * (box1 * dim + split_dir);
+                       unsigned i2 = 2 * (box2 * dim + split_dir);
+                       return flat_packed_box[i1] + flat_packed_box[i1 + 1] <
+                              flat_packed_box[i2] + flat_packed_box[i2 + 1];
+                     });
+
+    // Build the two subtrees
+    unsigned first_son = n_tree_node;
+    n_tree_node += 2;
+    First_son[tree_node] = first_son;
+    build_subtree(
+      first_son, flat_packed_box, box_number, first, middle, n_tree_node);
+    build_subtree(
+      first_son + 1, flat_packed_box, box_number, middle, last, n_tree_node);
+  }
+
+
+  //======================================================================
+  /// Get the numbers of the boxes that contain the point zeta (in no
+  /// particular order)
+  //======================================================================
+  void BoundingBoxTree::boxes_containing(const Vector<double>& zeta,
+                                         Vector<unsigned>& box_number) const
+  {
+    box_number.clear();
+    if (First_son.size() == 0)
+    {
+      return;
+    }
+
+    // Descend into the subtrees whose boxes contain the point
+    Vector<unsigned> tree_node_stack(1, 0);
+    while (!tree_node_stack.empty())
+    {
+      unsigned tree_node = tree_node_stack.back();
+      tree_node_stack.pop_back();
+
+      const double* node_box_pt = &Node_box[2 * Dim * tree_node];
+      bool inside = true;
+      for (unsigned i = 0; i < Dim; i++)
+      {
+        if ((zeta[i] < node_box_pt[2 * i]) ||
+            (zeta[i] > node_box_pt[2 * i + 1]))
+        {
+          inside = false;
+          break;
+        }
+      }
+      if (inside)
+      {
+        if (First_son[tree_node] < 0)
+        {
+          box_number.push_back(Leaf_box_number[tree_node]);
+        }
+        else
+        {
+          tree_node_stack.push_back(First_son[tree_node]);
+          tree_node_stack.push_back(First_son[tree_node] + 1);
+        }
+      }
+    }
+  }
+
+#endif
+
+
+  //======================================================================
+  /// Update the lookup scheme for the elements in (and the external halo
+  /// elements of) external_mesh_pt. This only compares the elements with
+  /// the ones that were there during the previous call; the scheme is
+  /// only rebuilt if they've changed.
+  //======================================================================
+  void ExternalElementLookup::update(Mesh* const& external_mesh_pt)
+  {
+    // How many elements are there?
+    unsigned n_element = external_mesh_pt->nelement();
+    unsigned n_total = n_element;
+#ifdef OOMPH_HAS_MPI
+    int n_proc = 0;
+    if (external_mesh_pt->is_mesh_distributed())
+    {
+      n_proc = external_mesh_pt->communicator_pt()->nproc();
+      for (int p = 0; p < n_proc; p++)
+      {
+        n_total += external_mesh_pt->nexternal_halo_element(p);
+      }
+    }
+#endif
+
+    // Are they the same as before?
+    bool unchanged = (n_total == Element_pt.size());
+    for (unsigned e = 0; (e < n_element) && unchanged; e++)
+    {
+      unchanged = (external_mesh_pt->finite_element_pt(e) == Element_pt[e]);
+    }
+#ifdef OOMPH_HAS_MPI
+    unsigned count = n_element;
+    for (int p = 0; (p < n_proc) && unchanged; p++)
+    {
+      unsigned n_ext_halo = external_mesh_pt->nexternal_halo_element(p);
+      for (unsigned e = 0; (e < n_ext_halo) && unchanged; e++)
+      {
+        unchanged = (dynamic_cast<FiniteElement*>(
+                       external_mesh_pt->external_halo_element_pt(p, e)) ==
+                     Element_pt[count]);
+        count++;
+      }
+    }
+#endif
+    if (unchanged)
+    {
+      return;
+    }
+
+    // Rebuild
+    Element_pt.resize(n_total);
+    Element_number.clear();
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      Element_pt[e] = external_mesh_pt->finite_element_pt(e);
+      Element_number[Element_pt[e]] = e;
+    }
+#ifdef OOMPH_HAS_MPI
+    count = n_element;
+    for (int p = 0; p < n_proc; p++)
+    {
+      unsigned n_ext_halo = external_mesh_pt->nexternal_halo_element(p);
+      for (unsigned e = 0; e < n_ext_halo; e++)
+      {
+        Element_pt[count] = dynamic_cast<FiniteElement*>(
+          external_mesh_pt->external_halo_element_pt(p, e));
+        Element_number[Element_pt[count]] = count;
+        count++;
+      }
+    }
+#endif
+    Neighbours_are_set_up = false;
+    First_neighbour.clear();
+    Neighbour.clear();
+  }
+
+
+  //======================================================================
+  /// Set up the lookup scheme for the elements that share nodes with
+  /// the elements (unless it's already set up)
+  //======================================================================
+  void ExternalElementLookup::setup_neighbours()
+  {
+    if (Neighbours_are_set_up)
+    {
+      return;
+    }
+
+    // Elements adjacent to each node
+    std::map<Node*, Vector<unsigned>> element_adjacent_to_node;
+    unsigned n_element = Element_pt.size();
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      unsigned n_node = Element_pt[e]->nnode();
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        element_adjacent_to_node[Element_pt[e]->node_pt(j)].push_back(e);
+      }
+    }
+
+    // Combine them into the (distinct) neighbours of each element
+    First_neighbour.resize(n_element + 1);
+    Neighbour.clear();
+    Vector<unsigned> neighbour;
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      First_neighbour[e] = Neighbour.size();
+      neighbour.resize(0);
+      unsigned n_node = Element_pt[e]->nnode();
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        Vector<unsigned>& adjacent_element =
+          element_adjacent_to_node[Element_pt[e]->node_pt(j)];
+        unsigned n_adjacent = adjacent_element.size();
+        for (unsigned a = 0; a < n_adjacent; a++)
+        {
+          if (adjacent_element[a] != e)
+          {
+            neighbour.push_back(adjacent_element[a]);
+          }
+        }
+      }
+      std::sort(neighbour.begin(), neighbour.end());
+      neighbour.erase(std::unique(neighbour.begin(), neighbour.end()),
+                      neighbour.end());
+      Neighbour.insert(Neighbour.end(), neighbour.begin(), neighbour.end());
+    }
+    First_neighbour[n_element] = Neighbour.size();
+    Neighbours_are_set_up = true;
+  }
+
+
   //======================================================================
   // Namespace for "global" multi-domain functions
   //======================================================================
@@ -165,11 +470,451 @@ namespace oomph
     ///        setup_multi_domain_interaction() routines
     bool Doc_full_stats = false;
 
+    /// \short Boolean to indicate that the zeta coordinates are to be
+    /// located in batches (along a space-filling curve, using the rank's
+    /// thread pool, and sending the points that can't be found locally
+    /// directly to the processors whose bounding boxes contain them).
+    /// Default: false.
+    bool Use_batched_locate_zeta = false;
+
+    /// \short Number of points in the blocks that are located in one go
+    /// (by one thread) when Use_batched_locate_zeta is true
+    unsigned Nzeta_per_block_in_batched_locate_zeta = 256;
+
+    /// \short Tolerance (relative to their size) by which the bounding
+    /// boxes of the external meshes are inflated when
+    /// Use_batched_locate_zeta is true
+    double Tolerance_for_bounding_box_in_batched_locate_zeta = 1.0e-2;
+
+    /// \short Boolean to indicate that the external elements are to be
+    /// updated incrementally, starting from the ones located during the
+    /// previous setup of the interaction. Default: false.
+    bool Use_incremental_locate_zeta = false;
+
+    /// \short Number of layers of neighbouring elements searched by the
+    /// incremental update before resorting to the full search
+    unsigned Nneighbour_layer_in_incremental_locate_zeta = 2;
+
+    /// \short Previously located external elements (only used if
+    /// Use_incremental_locate_zeta is true)
+    Vector<Vector<FiniteElement*>> Previous_external_element_pt;
+
+    /// \short Local coordinates within the previously located external
+    /// elements
+    Vector<Vector<Vector<double>>> Previous_external_element_local_coord;
+
+    /// \short Lookup schemes for the elements in the external meshes
+    /// used by the incremental update (one for each external mesh). They
+    /// are kept from one setup of the interaction to the next.
+    std::map<Mesh*, ExternalElementLookup> External_element_lookup;
+
+#ifdef OOMPH_HAS_MPI
+
+    /// \short Bounding boxes of the (non-halo elements in the) external
+    /// meshes on all processors (only set up when Use_batched_locate_zeta
+    /// is true)
+    Vector<Vector<double>> Bounding_box_of_external_mesh;
+
+    /// \short Trees of the boxes in Bounding_box_of_external_mesh, used
+    /// to find the processors on which the points that can't be located
+    /// locally may be located
+    Vector<BoundingBoxTree> Bounding_box_tree_of_external_mesh;
+
+    /// \short MPI tags used when the missing zetas are sent directly to
+    /// the processors that may contain them. (The zetas themselves are
+    /// sent with Missing_zeta_tag and Missing_zeta_tag+1 in alternate
+    /// rounds of the exchange.)
+    const int Missing_zeta_tag = 4210;
+    const int Located_info_unsigned_tag = 4212;
+    const int Located_info_double_tag = 4213;
+
+#endif
+
 #ifdef OOMPH_HAS_MPI
 
     // Functions for location method in multi-domain problems
 
 
+    //========================================================================
+    /// Set up Bounding_box_of_external_mesh for the external meshes
+    /// represented by the mesh_geom_obj_pt: Each processor computes the
+    /// bounding box of its non-halo elements (in the coordinates used by
+    /// the sample point containers) and the boxes are then gathered on
+    /// all processors.
+    //========================================================================
+    void setup_bounding_boxes_of_external_meshes(
+      Problem* problem_pt, Vector<MeshAsGeomObject*>& mesh_geom_obj_pt)
+    {
+      OomphCommunicator* comm_pt = problem_pt->communicator_pt();
+      int n_proc = comm_pt->nproc();
+
+      unsigned n_mesh = mesh_geom_obj_pt.size();
+      Bounding_box_of_external_mesh.resize(n_mesh);
+      Bounding_box_tree_of_external_mesh.resize(n_mesh);
+      for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
+      {
+        SamplePointContainer* container_pt =
+          mesh_geom_obj_pt[i_mesh]->sample_point_container_pt();
+        bool use_eulerian_coordinates =
+          container_pt->use_eulerian_coordinates_during_setup();
+
+        // Local bounding box (empty if there are no non-halo elements)
+        Vector<double> local_box(2 * Dim);
+        for (unsigned i = 0; i < Dim; i++)
+        {
+          local_box[2 * i] = DBL_MAX;
+          local_box[2 * i + 1] = -DBL_MAX;
+        }
+
+        // Sample the elements at their vertices and midpoints
+        Vector<double> s(Dim);
+        Vector<double> zeta(Dim);
+        unsigned n_plot = 3;
+        unsigned n_element = mesh_geom_obj_pt[i_mesh]->nelement();
+        for (unsigned e = 0; e < n_element; e++)
+        {
+          FiniteElement* el_pt = mesh_geom_obj_pt[i_mesh]->finite_element_pt(e);
+          if (!el_pt->is_halo())
+          {
+            unsigned n_plot_points = el_pt->nplot_points(n_plot);
+            for (unsigned iplot = 0; iplot < n_plot_points; iplot++)
+            {
+              el_pt->get_s_plot(iplot, n_plot, s);
+              if (use_eulerian_coordinates)
+              {
+                el_pt->interpolated_x(s, zeta);
+              }
+              else
+              {
+                el_pt->interpolated_zeta(s, zeta);
+              }
+              for (unsigned i = 0; i < Dim; i++)
+              {
+                local_box[2 * i] = std::min(local_box[2 * i], zeta[i]);
+                local_box[2 * i + 1] = std::max(local_box[2 * i + 1], zeta[i]);
+              }
+            }
+          }
+        }
+
+        // Inflate it (elements may be curved)
+        if (local_box[0] <= local_box[1])
+        {
+          double max_size = 0.0;
+          for (unsigned i = 0; i < Dim; i++)
+          {
+            max_size =
+              std::max(max_size, local_box[2 * i + 1] - local_box[2 * i]);
+          }
+          double inflation =
+            Tolerance_for_bounding_box_in_batched_locate_zeta * max_size;
+          for (unsigned i = 0; i < Dim; i++)
+          {
+            local_box[2 * i] -= inflation;
+            local_box[2 * i + 1] += inflation;
+          }
+        }
+
+        // Gather the boxes from all processors
+        Bounding_box_of_external_mesh[i_mesh].resize(2 * Dim * n_proc);
+        double t_start = CommunicationStatistics::timer();
+        MPI_Allgather(&local_box[0],
+                      2 * Dim,
+                      MPI_DOUBLE,
+                      &Bounding_box_of_external_mesh[i_mesh][0],
+                      2 * Dim,
+                      MPI_DOUBLE,
+                      comm_pt->mpi_comm());
+        CommunicationStatistics::record_collective(
+          CommunicationStatistics::Multi_domain_interaction,
+          2 * Dim * sizeof(double),
+          2 * Dim * n_proc * sizeof(double));
+        CommunicationStatistics::record_wait_time(
+          CommunicationStatistics::Multi_domain_interaction,
+          CommunicationStatistics::timer() - t_start);
+
+        // ...and sort them into a tree
+        Bounding_box_tree_of_external_mesh[i_mesh].build(
+          Bounding_box_of_external_mesh[i_mesh], Dim);
+      }
+    }
+
+
+    //========================================================================
+    /// Does the bounding box of the i_mesh-th external mesh on
+    /// processor proc contain the point zeta?
+    //========================================================================
+    bool bounding_box_contains_zeta(const unsigned& i_mesh,
+                                    const unsigned& proc,
+                                    const Vector<double>& zeta)
+    {
+      const double* box_pt = &Bounding_box_of_external_mesh[i_mesh][0];
+      unsigned offset = 2 * proc * Dim;
+      for (unsigned i = 0; i < Dim; i++)
+      {
+        if ((zeta[i] < box_pt[offset + 2 * i]) ||
+            (zeta[i] > box_pt[offset + 2 * i + 1]))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+
+    //========================================================================
+    /// Send the (padded, flat-packed) zetas in zetas_for_proc[p] to
+    /// processor p and receive the zetas sent to this processor from
+    /// elsewhere in received_zetas[p]. The receiving processors don't
+    /// know where the zetas come from, so we use the "non-blocking
+    /// consensus" algorithm: The zetas are sent with synchronous sends
+    /// and everything that arrives is received until all processors
+    /// have entered a non-blocking barrier, which they do once their
+    /// own sends have completed (i.e. have been received). round is
+    /// the number of the round of the exchange in the current search;
+    /// it's used to keep the messages from consecutive rounds apart.
+    //========================================================================
+    void send_missing_zetas_to_owning_processors(
+      Problem* problem_pt,
+      std::map<int, Vector<double>>& zetas_for_proc,
+      std::map<int, Vector<double>>& received_zetas,
+      const unsigned& round)
+    {
+      OomphCommunicator* comm_pt = problem_pt->communicator_pt();
+      int tag = Missing_zeta_tag + int(round % 2);
+      received_zetas.clear();
+
+      // Start the synchronous sends
+      unsigned n_send = zetas_for_proc.size();
+      Vector<MPI_Request> send_request(n_send);
+      unsigned count = 0;
+      for (std::map<int, Vector<double>>::iterator it = zetas_for_proc.begin();
+           it != zetas_for_proc.end();
+           it++)
+      {
+        MPI_Issend(&(it->second[0]),
+                   it->second.size(),
+                   MPI_DOUBLE,
+                   it->first,
+                   tag,
+                   comm_pt->mpi_comm(),
+                   &send_request[count]);
+        CommunicationStatistics::record_send(
+          CommunicationStatistics::Multi_domain_interaction,
+          it->second.size() * sizeof(double));
+        count++;
+      }
+
+      // Receive whatever arrives until everybody's done. The time spent
+      // in this loop is the wait time of the exchange.
+      double t_start = CommunicationStatistics::timer();
+      bool entered_barrier = false;
+      MPI_Request barrier_request;
+      while (true)
+      {
+        int message_waiting = 0;
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE,
+                   tag,
+                   comm_pt->mpi_comm(),
+                   &message_waiting,
+                   &status);
+        if (message_waiting)
+        {
+          int n_received = 0;
+          MPI_Get_count(&status, MPI_DOUBLE, &n_received);
+          Vector<double>& zetas = received_zetas[status.MPI_SOURCE];
+          zetas.resize(n_received);
+          MPI_Recv(&zetas[0],
+                   n_received,
+                   MPI_DOUBLE,
+                   status.MPI_SOURCE,
+                   tag,
+                   comm_pt->mpi_comm(),
+                   MPI_STATUS_IGNORE);
+          CommunicationStatistics::record_receive(
+            CommunicationStatistics::Multi_domain_interaction,
+            n_received * sizeof(double));
+        }
+
+        if (entered_barrier)
+        {
+          // Everybody's sends have been received once the barrier
+          // has completed
+          int barrier_done = 0;
+          MPI_Test(&barrier_request, &barrier_done, MPI_STATUS_IGNORE);
+          if (barrier_done)
+          {
+            CommunicationStatistics::record_wait_time(
+              CommunicationStatistics::Multi_domain_interaction,
+              CommunicationStatistics::timer() - t_start);
+            break;
+          }
+        }
+        else
+        {
+          // Enter the barrier once our own sends have been received
+          int sends_done = 1;
+          if (n_send != 0)
+          {
+            MPI_Testall(
+              n_send, &send_request[0], &sends_done, MPI_STATUSES_IGNORE);
+          }
+          if (sends_done)
+          {
+            MPI_Ibarrier(comm_pt->mpi_comm(), &barrier_request);
+            entered_barrier = true;
+          }
+        }
+      }
+    }
+
+
+    //========================================================================
+    /// Send the information about the external elements located by
+    /// locate_zeta_for_missing_coordinates(...) back to the processor
+    /// orig_proc that asked for them: unsigned_buffer contains the number
+    /// of zeta tuples, their Located_element_status and the
+    /// Flat_packed_unsigneds; double_buffer contains the number of
+    /// Flat_packed_doubles, the Flat_packed_doubles and the
+    /// Flat_packed_located_coordinates. The buffers must remain untouched
+    /// until the two requests added to send_request have completed.
+    //========================================================================
+    void send_located_info_to_processor(Problem* problem_pt,
+                                        const int& orig_proc,
+                                        Vector<unsigned>& unsigned_buffer,
+                                        Vector<double>& double_buffer,
+                                        Vector<MPI_Request>& send_request)
+    {
+      OomphCommunicator* comm_pt = problem_pt->communicator_pt();
+
+      unsigned n_status = Located_element_status.size();
+      unsigned n_unsigned = Flat_packed_unsigneds.size();
+      unsigned_buffer.resize(1 + n_status + n_unsigned);
+      unsigned_buffer[0] = n_status;
+      for (unsigned i = 0; i < n_status; i++)
+      {
+        unsigned_buffer[1 + i] = Located_element_status[i];
+      }
+      for (unsigned i = 0; i < n_unsigned; i++)
+      {
+        unsigned_buffer[1 + n_status + i] = Flat_packed_unsigneds[i];
+      }
+
+      unsigned n_double = Flat_packed_doubles.size();
+      unsigned n_coord = Flat_packed_located_coordinates.size();
+      double_buffer.resize(1 + n_double + n_coord);
+      double_buffer[0] = double(n_double);
+      for (unsigned i = 0; i < n_double; i++)
+      {
+        double_buffer[1 + i] = Flat_packed_doubles[i];
+      }
+      for (unsigned i = 0; i < n_coord; i++)
+      {
+        double_buffer[1 + n_double + i] = Flat_packed_located_coordinates[i];
+      }
+
+      MPI_Request request;
+      MPI_Isend(&unsigned_buffer[0],
+                unsigned_buffer.size(),
+                MPI_UNSIGNED,
+                orig_proc,
+                Located_info_unsigned_tag,
+                comm_pt->mpi_comm(),
+                &request);
+      send_request.push_back(request);
+      MPI_Isend(&double_buffer[0],
+                double_buffer.size(),
+                MPI_DOUBLE,
+                orig_proc,
+                Located_info_double_tag,
+                comm_pt->mpi_comm(),
+                &request);
+      send_request.push_back(request);
+      CommunicationStatistics::record_send(
+        CommunicationStatistics::Multi_domain_interaction,
+        unsigned_buffer.size() * sizeof(unsigned) +
+          double_buffer.size() * sizeof(double),
+        2);
+    }
+
+
+    //========================================================================
+    /// Receive the information sent by send_located_info_to_processor(...)
+    /// on processor owning_proc and unpack it into Located_element_status,
+    /// Flat_packed_unsigneds, Flat_packed_doubles and
+    /// Flat_packed_located_coordinates.
+    //========================================================================
+    void receive_located_info_from_processor(Problem* problem_pt,
+                                             const int& owning_proc)
+    {
+      OomphCommunicator* comm_pt = problem_pt->communicator_pt();
+      MPI_Status status;
+      double t_start = CommunicationStatistics::timer();
+
+      // Unsigned data
+      int n_received = 0;
+      MPI_Probe(owning_proc,
+                Located_info_unsigned_tag,
+                comm_pt->mpi_comm(),
+                &status);
+      MPI_Get_count(&status, MPI_UNSIGNED, &n_received);
+      Vector<unsigned> unsigned_buffer(n_received);
+      MPI_Recv(&unsigned_buffer[0],
+               n_received,
+               MPI_UNSIGNED,
+               owning_proc,
+               Located_info_unsigned_tag,
+               comm_pt->mpi_comm(),
+               MPI_STATUS_IGNORE);
+      unsigned n_status = unsigned_buffer[0];
+      unsigned n_unsigned = n_received - 1 - n_status;
+      Located_element_status.resize(n_status);
+      for (unsigned i = 0; i < n_status; i++)
+      {
+        Located_element_status[i] = unsigned_buffer[1 + i];
+      }
+      Flat_packed_unsigneds.resize(n_unsigned);
+      for (unsigned i = 0; i < n_unsigned; i++)
+      {
+        Flat_packed_unsigneds[i] = unsigned_buffer[1 + n_status + i];
+      }
+
+      // Double data
+      MPI_Probe(
+        owning_proc, Located_info_double_tag, comm_pt->mpi_comm(), &status);
+      MPI_Get_count(&status, MPI_DOUBLE, &n_received);
+      Vector<double> double_buffer(n_received);
+      MPI_Recv(&double_buffer[0],
+               n_received,
+               MPI_DOUBLE,
+               owning_proc,
+               Located_info_double_tag,
+               comm_pt->mpi_comm(),
+               MPI_STATUS_IGNORE);
+      CommunicationStatistics::record_receive(
+        CommunicationStatistics::Multi_domain_interaction,
+        unsigned_buffer.size() * sizeof(unsigned) +
+          double_buffer.size() * sizeof(double),
+        2);
+      CommunicationStatistics::record_wait_time(
+        CommunicationStatistics::Multi_domain_interaction,
+        CommunicationStatistics::timer() - t_start);
+      unsigned n_double = unsigned(double_buffer[0]);
+      unsigned n_coord = n_received - 1 - n_double;
+      Flat_packed_doubles.resize(n_double);
+      for (unsigned i = 0; i < n_double; i++)
+      {
+        Flat_packed_doubles[i] = double_buffer[1 + i];
+      }
+      Flat_packed_located_coordinates.resize(n_coord);
+      for (unsigned i = 0; i < n_coord; i++)
+      {
+        Flat_packed_located_coordinates[i] = double_buffer[1 + n_double + i];
+      }
+    }
+
+
     //========================================================================
     /// Send the zeta coordinates from the current process to
     /// the next process; receive from the previous process
@@ -197,6 +942,9 @@ namespace oomph
         recv_from_proc = n_proc - 1;
       }
 
+      // The exchange is blocking, so all of it counts as wait time
+      double t_start = CommunicationStatistics::timer();
+
       // Send the number  of flat-packed zetas that we couldn't find
       // locally to the next processor
       int n_missing_local_zetas = Flat_packed_zetas_not_found_locally.size();
@@ -253,6 +1001,18 @@ namespace oomph
         Received_flat_packed_zetas_to_be_found.resize(0);
       }
 
+      CommunicationStatistics::record_send(
+        CommunicationStatistics::Multi_domain_interaction,
+        sizeof(int) + n_missing_local_zetas * sizeof(double),
+        1 + unsigned(n_missing_local_zetas != 0));
+      CommunicationStatistics::record_receive(
+        CommunicationStatistics::Multi_domain_interaction,
+        sizeof(int) + count_zetas * sizeof(double),
+        1 + unsigned(count_zetas != 0));
+      CommunicationStatistics::record_wait_time(
+        CommunicationStatistics::Multi_domain_interaction,
+        CommunicationStatistics::timer() - t_start);
+
       // Now we should have the Zeta arrays set up correctly
       // for the next round of locations
     }
@@ -293,6 +1053,9 @@ namespace oomph
         orig_recv_proc = orig_recv_proc - n_proc;
       }
 
+      // The exchange is blocking, so all of it counts as wait time
+      double t_start = CommunicationStatistics::timer();
+
       // Send the double values associated with external halos
       //------------------------------------------------------
       unsigned send_count_double_values = Flat_packed_doubles.size();
@@ -519,6 +1282,32 @@ namespace oomph
         MPI_Wait(&request, MPI_STATUS_IGNORE);
       }
 
+      // Record the traffic: four counts plus the non-empty arrays in
+      // either direction
+      CommunicationStatistics::record_send(
+        CommunicationStatistics::Multi_domain_interaction,
+        4 * sizeof(unsigned) + send_count_double_values * sizeof(double) +
+          send_count_unsigned_values * sizeof(unsigned) +
+          send_count * (sizeof(unsigned) + sizeof(int)) +
+          send_count_located_coord * sizeof(double),
+        4 + unsigned(send_count_double_values != 0) +
+          unsigned(send_count_unsigned_values != 0) +
+          2 * unsigned(send_count != 0) +
+          unsigned(send_count_located_coord != 0));
+      CommunicationStatistics::record_receive(
+        CommunicationStatistics::Multi_domain_interaction,
+        4 * sizeof(unsigned) + receive_count_double_values * sizeof(double) +
+          receive_count_unsigned_values * sizeof(unsigned) +
+          receive_count * (sizeof(unsigned) + sizeof(int)) +
+          receive_count_located_coord * sizeof(double),
+        4 + unsigned(receive_count_double_values != 0) +
+          unsigned(receive_count_unsigned_values != 0) +
+          2 * unsigned(receive_count != 0) +
+          unsigned(receive_count_located_coord != 0));
+      CommunicationStatistics::record_wait_time(
+        CommunicationStatistics::Multi_domain_interaction,
+        CommunicationStatistics::timer() - t_start);
+
       // Copy across into original containers -- these can now
       //------------------------------------------------------
       // be processed by create_external_halo_elements() to generate
@@ -1905,7 +2694,14 @@ namespace oomph
         Vector<double> ss(Dim);
         if (!reached_end_of_mesh)
         {
-          mesh_geom_obj_pt[i_mesh]->locate_zeta(x_global, sub_geom_obj_pt, ss);
+          // Don't bother searching if the point can't be in the part of
+          // the external mesh that's held here
+          if (Bounding_box_of_external_mesh.size() == 0 ||
+              bounding_box_contains_zeta(i_mesh, my_rank, x_global))
+          {
+            mesh_geom_obj_pt[i_mesh]->locate_zeta(
+              x_global, sub_geom_obj_pt, ss);
+          }
 
           // Did the locate method work?
           if (sub_geom_obj_pt != 0)
@@ -2156,6 +2952,14 @@ namespace oomph
       Vector<MeshAsGeomObject*>& mesh_geom_obj_pt,
       const unsigned& interaction_index)
     {
+      // Locate the points in batches?
+      if (Use_batched_locate_zeta)
+      {
+        batched_locate_zeta_for_local_coordinates(
+          mesh_pt, external_mesh_pt, mesh_geom_obj_pt, interaction_index);
+        return;
+      }
+
       // Flush storage for zetas not found locally
       Flat_packed_zetas_not_found_locally.resize(0);
 
@@ -2237,93 +3041,501 @@ namespace oomph
                 mesh_geom_obj_pt[i_mesh]->locate_zeta(
                   x_global, sub_geom_obj_pt, s_ext);
 
-                // Has the required element been located?
-                if (sub_geom_obj_pt != 0)
-                {
-                  // The required element has been located
-                  // The located coordinates have the same dimension as the bulk
-                  GeneralisedElement* source_el_pt;
-                  Vector<double> s_source(el_dim);
+                // Deal with the outcome
+                record_outcome_of_local_locate_zeta(el_pt,
+                                                    e_count,
+                                                    ipt,
+                                                    x_global,
+                                                    sub_geom_obj_pt,
+                                                    s_ext,
+                                                    interaction_index);
+              }
+            } // end loop over integration points
+          } // end for halo
 
-                  // Is the bulk element the actual external element?
-                  if (!Use_bulk_element_as_external)
-                  {
-                    // Use the object directly (it must be a finite element)
-                    source_el_pt =
-                      dynamic_cast<FiniteElement*>(sub_geom_obj_pt);
-                    s_source = s_ext;
-                  }
-                  else
-                  {
-                    // Cast to a FaceElement and use the bulk element
-                    FaceElement* face_el_pt =
-                      dynamic_cast<FaceElement*>(sub_geom_obj_pt);
-                    source_el_pt = face_el_pt->bulk_element_pt();
-
-                    // Need to resize the located coordinates to have the same
-                    // dimension as the bulk element
-                    s_source.resize(
-                      dynamic_cast<FiniteElement*>(source_el_pt)->dim());
-
-                    // Translate the returned local coords into the bulk element
-                    face_el_pt->get_local_coordinate_in_bulk(s_ext, s_source);
-                  }
+          // Bump up counter for all elements
+          e_count++;
 
-                  // Check if it's a halo; if it is then the non-halo equivalent
-                  // needs to be located from another processor (unless we
-                  // accept halo elements as external elements)
-#ifdef OOMPH_HAS_MPI
-                  if (Allow_use_of_halo_elements_as_external_elements ||
-                      (!source_el_pt->is_halo()))
-#endif
-                  {
-                    // Need to cast to a FiniteElement
-                    FiniteElement* source_finite_el_pt =
-                      dynamic_cast<FiniteElement*>(source_el_pt);
-
-                    // Set the external element pointer and local coordinates
-                    el_pt->external_element_pt(interaction_index, ipt) =
-                      source_finite_el_pt;
-                    el_pt->external_element_local_coord(interaction_index,
-                                                        ipt) = s_source;
-
-                    // Set the lookup array to 1/true
-                    External_element_located[e_count][ipt] = 1;
-                  }
-#ifdef OOMPH_HAS_MPI
-                  // located element is halo and we're not accepting haloes
-                  // obviously only makes sense in mpi mode...
-                  else
+        } // end loop over local elements
+
+        // Mark end of mesh data in flat packed array
+        for (unsigned i = 0; i < Dim; i++)
+        {
+          Flat_packed_zetas_not_found_locally.push_back(DBL_MAX);
+        }
+
+      } // end of loop over meshes
+    }
+
+
+    //=====================================================================
+    /// Incremental version of locate_zeta_for_local_coordinates(...),
+    /// used if Use_incremental_locate_zeta is true: Try to locate the
+    /// zeta coordinates of the integration points in the external
+    /// elements in which they were located previously (using the
+    /// previous local coordinates as the initial guess), or in the
+    /// Nneighbour_layer_in_incremental_locate_zeta layers of elements
+    /// surrounding them. The external elements include the external
+    /// halo elements of the external mesh that were created during
+    /// previous setups. Previous external elements that no longer exist
+    /// (e.g. because the external mesh has been adapted) are ignored.
+    /// Points that can't be found that way are left for the full search;
+    /// we return their number.
+    //=====================================================================
+    unsigned incremental_locate_zeta_for_local_coordinates(
+      const Vector<Mesh*>& mesh_pt,
+      Mesh* const& external_mesh_pt,
+      const unsigned& interaction_index)
+    {
+      // Number of points that haven't been found
+      unsigned n_not_found = 0;
+
+      // The previous external elements are bulk elements that aren't
+      // represented by the lookup scheme
+      if (Use_bulk_element_as_external)
+      {
+        unsigned n = External_element_located.size();
+        for (unsigned e = 0; e < n; e++)
+        {
+          n_not_found += External_element_located[e].size();
+        }
+        return n_not_found;
+      }
+
+      // Lookup scheme for the elements that can act as external elements
+      // (kept from the previous setup if the external mesh hasn't changed)
+      ExternalElementLookup& lookup = External_element_lookup[external_mesh_pt];
+      lookup.update(external_mesh_pt);
+      unsigned n_mesh_element = external_mesh_pt->nelement();
+
+      // Element counter
+      unsigned e_count = 0;
+
+      Vector<double> s_local(Dim);
+      Vector<double> x_global(Dim);
+      unsigned n_mesh = mesh_pt.size();
+      for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
+      {
+        unsigned n_element = mesh_pt[i_mesh]->nelement();
+        for (unsigned e = 0; e < n_element; e++)
+        {
+          ElementWithExternalElement* el_pt =
+            dynamic_cast<ElementWithExternalElement*>(
+              mesh_pt[i_mesh]->element_pt(e));
+
+          unsigned n_intpt = External_element_located[e_count].size();
+          for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+          {
+            // Was an (existing) external element found previously?
+            int e_previous = lookup.element_number(
+              Previous_external_element_pt[e_count][ipt]);
+            if (e_previous < 0)
+            {
+              n_not_found++;
+              continue;
+            }
+
+            // Get the zeta coordinates of the integration point
+            for (unsigned i = 0; i < Dim; i++)
+            {
+              s_local[i] = el_pt->integral_pt()->knot(ipt, i);
+            }
+            el_pt->interpolated_zeta(s_local, x_global);
+
+            // Is it still in the same element?
+            GeomObject* sub_geom_obj_pt = 0;
+            unsigned e_found = e_previous;
+            Vector<double> s_ext(
+              Previous_external_element_local_coord[e_count][ipt]);
+            bool use_coordinate_as_initial_guess = (s_ext.size() == Dim);
+            if (!use_coordinate_as_initial_guess)
+            {
+              s_ext.resize(Dim);
+            }
+            lookup.element_pt(e_previous)
+              ->locate_zeta(x_global,
+                            sub_geom_obj_pt,
+                            s_ext,
+                            use_coordinate_as_initial_guess);
+
+            // Walk through the surrounding layers of elements
+            if ((sub_geom_obj_pt == 0) &&
+                (Nneighbour_layer_in_incremental_locate_zeta > 0))
+            {
+              lookup.setup_neighbours();
+              std::set<unsigned> visited;
+              visited.insert(e_previous);
+              Vector<unsigned> current_layer(1, e_previous);
+              for (unsigned layer = 0;
+                   (layer < Nneighbour_layer_in_incremental_locate_zeta) &&
+                   (sub_geom_obj_pt == 0);
+                   layer++)
+              {
+                Vector<unsigned> next_layer;
+                unsigned n_current = current_layer.size();
+                for (unsigned k = 0; (k < n_current) && (sub_geom_obj_pt == 0);
+                     k++)
+                {
+                  unsigned n_neighbour = lookup.nneighbour(current_layer[k]);
+                  for (unsigned a = 0;
+                       (a < n_neighbour) && (sub_geom_obj_pt == 0);
+                       a++)
                   {
-                    // Add required information to arrays
-                    for (unsigned i = 0; i < el_dim; i++)
+                    unsigned e_ext = lookup.neighbour(current_layer[k], a);
+                    if (visited.insert(e_ext).second)
                     {
-                      Flat_packed_zetas_not_found_locally.push_back(
-                        x_global[i]);
+                      next_layer.push_back(e_ext);
+                      lookup.element_pt(e_ext)->locate_zeta(
+                        x_global, sub_geom_obj_pt, s_ext);
+                      e_found = e_ext;
                     }
                   }
+                }
+                current_layer = next_layer;
+              }
+            }
+
+            // Found it? The external halo elements (created during
+            // previous setups) can be used directly; other halo elements
+            // only if that's allowed -- the full search deals with the
+            // rest
+            bool located = false;
+            if (sub_geom_obj_pt != 0)
+            {
+              if (e_found >= n_mesh_element)
+              {
+                el_pt->external_element_pt(interaction_index, ipt) =
+                  lookup.element_pt(e_found);
+                el_pt->external_element_local_coord(interaction_index, ipt) =
+                  s_ext;
+                External_element_located[e_count][ipt] = 1;
+                located = true;
+              }
+              else
+              {
+                located = true;
+#ifdef OOMPH_HAS_MPI
+                located = Allow_use_of_halo_elements_as_external_elements ||
+                          (!lookup.element_pt(e_found)->is_halo());
 #endif
+                if (located)
+                {
+                  record_outcome_of_local_locate_zeta(el_pt,
+                                                      e_count,
+                                                      ipt,
+                                                      x_global,
+                                                      sub_geom_obj_pt,
+                                                      s_ext,
+                                                      interaction_index);
                 }
-                else
+              }
+            }
+            if (!located)
+            {
+              n_not_found++;
+            }
+          }
+
+          // Bump up counter for all elements
+          e_count++;
+        }
+      }
+
+      return n_not_found;
+    }
+
+
+    //=====================================================================
+    /// Helper function for locate_zeta_for_local_coordinates(...):
+    /// Record the outcome of the search for the external element for the
+    /// ipt-th integration point (at zeta coordinate x_global) of element
+    /// el_pt, the e_count-th element in the flat-packed enumeration of
+    /// the elements in the meshes. sub_geom_obj_pt and s_ext are the
+    /// sub-object and the local coordinates within it, as returned by
+    /// locate_zeta(...).
+    //=====================================================================
+    void record_outcome_of_local_locate_zeta(
+      ElementWithExternalElement* const& el_pt,
+      const unsigned& e_count,
+      const unsigned& ipt,
+      const Vector<double>& x_global,
+      GeomObject* const& sub_geom_obj_pt,
+      const Vector<double>& s_ext,
+      const unsigned& interaction_index)
+    {
+      unsigned el_dim = el_pt->dim();
+
+      // Has the required element been located?
+      if (sub_geom_obj_pt != 0)
+      {
+        // The required element has been located
+        // The located coordinates have the same dimension as the bulk
+        GeneralisedElement* source_el_pt;
+        Vector<double> s_source(el_dim);
+
+        // Is the bulk element the actual external element?
+        if (!Use_bulk_element_as_external)
+        {
+          // Use the object directly (it must be a finite element)
+          source_el_pt = dynamic_cast<FiniteElement*>(sub_geom_obj_pt);
+          s_source = s_ext;
+        }
+        else
+        {
+          // Cast to a FaceElement and use the bulk element
+          FaceElement* face_el_pt = dynamic_cast<FaceElement*>(sub_geom_obj_pt);
+          source_el_pt = face_el_pt->bulk_element_pt();
+
+          // Need to resize the located coordinates to have the same
+          // dimension as the bulk element
+          s_source.resize(dynamic_cast<FiniteElement*>(source_el_pt)->dim());
+
+          // Translate the returned local coords into the bulk element
+          face_el_pt->get_local_coordinate_in_bulk(s_ext, s_source);
+        }
+
+        // Check if it's a halo; if it is then the non-halo equivalent
+        // needs to be located from another processor (unless we
+        // accept halo elements as external elements)
+#ifdef OOMPH_HAS_MPI
+        if (Allow_use_of_halo_elements_as_external_elements ||
+            (!source_el_pt->is_halo()))
+#endif
+        {
+          // Need to cast to a FiniteElement
+          FiniteElement* source_finite_el_pt =
+            dynamic_cast<FiniteElement*>(source_el_pt);
+
+          // Set the external element pointer and local coordinates
+          el_pt->external_element_pt(interaction_index, ipt) =
+            source_finite_el_pt;
+          el_pt->external_element_local_coord(interaction_index, ipt) =
+            s_source;
+
+          // Set the lookup array to 1/true
+          External_element_located[e_count][ipt] = 1;
+        }
+#ifdef OOMPH_HAS_MPI
+        // located element is halo and we're not accepting haloes
+        // obviously only makes sense in mpi mode...
+        else
+        {
+          // Add required information to arrays
+          for (unsigned i = 0; i < el_dim; i++)
+          {
+            Flat_packed_zetas_not_found_locally.push_back(x_global[i]);
+          }
+        }
+#endif
+      }
+      else
+      {
+        // Search has failed then add the required information to the
+        // arrays which need to be sent to the other processors so
+        // that they can perform the locate_zeta
+
+        // Add this global coordinate to the LOCAL zeta array
+        for (unsigned i = 0; i < el_dim; i++)
+        {
+          Flat_packed_zetas_not_found_locally.push_back(x_global[i]);
+        }
+      }
+    }
+
+
+    //=====================================================================
+    /// Batched version of locate_zeta_for_local_coordinates(...), used
+    /// if Use_batched_locate_zeta is true: The zeta coordinates of all
+    /// integration points that still have to be located are computed
+    /// first. The points are then located in the order in which they
+    /// appear along a space-filling curve (so that successive searches
+    /// visit the same bins and elements), in blocks that are distributed
+    /// over the rank's threads. Finally, the outcomes are recorded in the
+    /// original order (which is relied upon by the parallel search).
+    //=====================================================================
+    void batched_locate_zeta_for_local_coordinates(
+      const Vector<Mesh*>& mesh_pt,
+      Mesh* const& external_mesh_pt,
+      Vector<MeshAsGeomObject*>& mesh_geom_obj_pt,
+      const unsigned& interaction_index)
+    {
+      // Flush storage for zetas not found locally
+      Flat_packed_zetas_not_found_locally.resize(0);
+
+      // Number of meshes
+      unsigned n_mesh = mesh_pt.size();
+
+#ifdef PARANOID
+      if (mesh_geom_obj_pt.size() != n_mesh)
+      {
+        std::ostringstream error_stream;
+        error_stream << "Sizes of mesh_geom_obj_pt [ "
+                     << mesh_geom_obj_pt.size() << " ] and "
+                     << "mesh_pt [ " << n_mesh << " ] don't match.\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Element counter
+      unsigned e_count = 0;
+
+      // Loop over meshes
+      for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
+      {
+        // Collect the integration points that have yet to be located:
+        // the element, its number in the flat-packed enumeration, the
+        // integration point and (flat-packed) its zeta coordinates
+        Vector<ElementWithExternalElement*> query_el_pt;
+        Vector<unsigned> query_e_count;
+        Vector<unsigned> query_ipt;
+        Vector<double> query_zeta;
+
+        // Loop over this processor's elements
+        unsigned n_element = mesh_pt[i_mesh]->nelement();
+        for (unsigned e = 0; e < n_element; e++)
+        {
+          ElementWithExternalElement* el_pt =
+            dynamic_cast<ElementWithExternalElement*>(
+              mesh_pt[i_mesh]->element_pt(e));
+#ifdef OOMPH_HAS_MPI
+          // Only visit non-halo elements
+          if (!el_pt->is_halo())
+#endif
+          {
+            unsigned n_intpt = el_pt->integral_pt()->nweight();
+            unsigned el_dim = el_pt->dim();
+
+#ifdef PARANOID
+            if (el_dim != Dim)
+            {
+              std::ostringstream error_stream;
+              error_stream << "Dimension of element " << el_dim
+                           << " is not consitent with dimension assumed \n"
+                           << " in multidomain namespace, " << Dim << std::endl;
+              throw OomphLibError(error_stream.str(),
+                                  OOMPH_CURRENT_FUNCTION,
+                                  OOMPH_EXCEPTION_LOCATION);
+            }
+#endif
+
+            Vector<double> s_local(el_dim);
+            Vector<double> x_global(el_dim);
+            for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+            {
+              if (External_element_located[e_count][ipt] == 0)
+              {
+                for (unsigned i = 0; i < el_dim; i++)
                 {
-                  // Search has failed then add the required information to the
-                  // arrays which need to be sent to the other processors so
-                  // that they can perform the locate_zeta
+                  s_local[i] = el_pt->integral_pt()->knot(ipt, i);
+                }
+                el_pt->interpolated_zeta(s_local, x_global);
 
-                  // Add this global coordinate to the LOCAL zeta array
-                  for (unsigned i = 0; i < el_dim; i++)
-                  {
-                    Flat_packed_zetas_not_found_locally.push_back(x_global[i]);
-                  }
+                query_el_pt.push_back(el_pt);
+                query_e_count.push_back(e_count);
+                query_ipt.push_back(ipt);
+                for (unsigned i = 0; i < el_dim; i++)
+                {
+                  query_zeta.push_back(x_global[i]);
                 }
               }
-            } // end loop over integration points
-          } // end for halo
+            }
+          }
 
           // Bump up counter for all elements
           e_count++;
+        }
 
-        } // end loop over local elements
+        // Order in which the points are located
+        Vector<unsigned> order;
+        sort_along_space_filling_curve(query_zeta, order);
+
+        // Storage for the outcome of the searches
+        unsigned n_query = query_ipt.size();
+        Vector<GeomObject*> located_geom_obj_pt(n_query, 0);
+        Vector<Vector<double>> located_s(n_query);
+
+        // Locate the points block by block
+        unsigned n_per_block =
+          std::max(Nzeta_per_block_in_batched_locate_zeta, unsigned(1));
+        long n_block = (n_query + n_per_block - 1) / n_per_block;
+        bool use_threads = ThreadingHelpers::use_threads(n_query);
+        if (use_threads)
+        {
+          // Each thread needs its own counter of the sample points visited
+          mesh_geom_obj_pt[i_mesh]
+            ->sample_point_container_pt()
+            ->setup_counters_for_threaded_locate_zeta(
+              ThreadingHelpers::nthread());
+        }
+
+        // Exceptions must not escape from the parallel region so record
+        // the first one and rethrow it afterwards
+        bool exception_thrown = false;
+        std::string exception_message;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (use_threads)
+#endif
+        for (long b = 0; b < n_block; b++)
+        {
+          try
+          {
+            Vector<double> x_global(Dim);
+            unsigned k_end = std::min(unsigned(b + 1) * n_per_block, n_query);
+            for (unsigned k = unsigned(b) * n_per_block; k < k_end; k++)
+            {
+              unsigned q = order[k];
+              for (unsigned i = 0; i < Dim; i++)
+              {
+                x_global[i] = query_zeta[q * Dim + i];
+              }
+              located_s[q].resize(Dim);
+              mesh_geom_obj_pt[i_mesh]->locate_zeta(
+                x_global, located_geom_obj_pt[q], located_s[q]);
+            }
+          }
+          catch (std::exception& error)
+          {
+#ifdef _OPENMP
+#pragma omp critical(batched_locate_zeta_exception)
+#endif
+            {
+              if (!exception_thrown)
+              {
+                exception_thrown = true;
+                exception_message = error.what();
+              }
+            }
+          }
+        }
+
+        if (exception_thrown)
+        {
+          std::ostringstream error_stream;
+          error_stream << "Exception thrown during batched locate_zeta:\n"
+                       << exception_message;
+          throw OomphLibError(error_stream.str(),
+                              OOMPH_CURRENT_FUNCTION,
+                              OOMPH_EXCEPTION_LOCATION);
+        }
+
+        // Record the outcomes in the original order
+        Vector<double> x_global(Dim);
+        for (unsigned q = 0; q < n_query; q++)
+        {
+          for (unsigned i = 0; i < Dim; i++)
+          {
+            x_global[i] = query_zeta[q * Dim + i];
+          }
+          record_outcome_of_local_locate_zeta(query_el_pt[q],
+                                              query_e_count[q],
+                                              query_ipt[q],
+                                              x_global,
+                                              located_geom_obj_pt[q],
+                                              located_s[q],
+                                              interaction_index);
+        }
 
         // Mark end of mesh data in flat packed array
         for (unsigned i = 0; i < Dim; i++)
@@ -2335,6 +3547,73 @@ namespace oomph
     }
 
 
+    //=====================================================================
+    /// Sort the points whose coordinates are stored in flat-packed form
+    /// (in groups of Dim) in flat_packed_zeta along a space-filling
+    /// (Morton) curve. On return, order[k] is the index of the k-th point
+    /// along the curve.
+    //=====================================================================
+    void sort_along_space_filling_curve(const Vector<double>& flat_packed_zeta,
+                                        Vector<unsigned>& order)
+    {
+      unsigned n_point = (Dim == 0) ? 0 : flat_packed_zeta.size() / Dim;
+      order.resize(n_point);
+      if (n_point == 0)
+      {
+        return;
+      }
+
+      // Bounding box of the points
+      Vector<double> zeta_min(Dim, DBL_MAX);
+      Vector<double> zeta_max(Dim, -DBL_MAX);
+      for (unsigned j = 0; j < n_point; j++)
+      {
+        for (unsigned i = 0; i < Dim; i++)
+        {
+          zeta_min[i] = std::min(zeta_min[i], flat_packed_zeta[j * Dim + i]);
+          zeta_max[i] = std::max(zeta_max[i], flat_packed_zeta[j * Dim + i]);
+        }
+      }
+
+      // Number of bits per coordinate in the (64 bit) keys
+      unsigned n_bit = std::min(unsigned(63 / Dim), unsigned(21));
+      double n_cell = double((1UL << n_bit) - 1);
+
+      // Compute the keys by interleaving the bits of the scaled coordinates
+      std::vector<std::pair<unsigned long long, unsigned>> key(n_point);
+      Vector<unsigned long long> scaled_zeta(Dim);
+      for (unsigned j = 0; j < n_point; j++)
+      {
+        for (unsigned i = 0; i < Dim; i++)
+        {
+          double range = zeta_max[i] - zeta_min[i];
+          scaled_zeta[i] = 0;
+          if (range > 0.0)
+          {
+            scaled_zeta[i] = (unsigned long long)(
+              (flat_packed_zeta[j * Dim + i] - zeta_min[i]) / range * n_cell);
+          }
+        }
+        unsigned long long morton_key = 0;
+        for (unsigned b = 0; b < n_bit; b++)
+        {
+          for (unsigned i = 0; i < Dim; i++)
+          {
+            morton_key |= ((scaled_zeta[i] >> b) & 1ULL) << (b * Dim + i);
+          }
+        }
+        key[j] = std::make_pair(morton_key, j);
+      }
+
+      // Sort
+      std::sort(key.begin(), key.end());
+      for (unsigned j = 0; j < n_point; j++)
+      {
+        order[j] = key[j].second;
+      }
+    }
+
+
     //=====================================================================
     /// Helper function that computes the dimension of the elements within
     /// each of the specified meshes (and checks they are the same).
@@ -2420,6 +3699,12 @@ namespace oomph
       Flat_packed_doubles.clear();
       Flat_packed_unsigneds.clear();
       External_element_located.clear();
+      Previous_external_element_pt.clear();
+      Previous_external_element_local_coord.clear();
+#ifdef OOMPH_HAS_MPI
+      Bounding_box_of_external_mesh.clear();
+      Bounding_box_tree_of_external_mesh.clear();
+#endif
     }
 
     /// Vector of zeta coordinates that we're currently trying to locate;
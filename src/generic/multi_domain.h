@@ -55,6 +55,146 @@
 
 namespace oomph
 {
+#ifdef OOMPH_HAS_MPI
+
+  //======================================================================
+  /// \short Bounding volume hierarchy for a set of axis-aligned boxes
+  /// (the bounding boxes of the external meshes on the various
+  /// processors): Each leaf holds one box; each internal node holds the
+  /// box enclosing the boxes in its two subtrees. Used to find the
+  /// boxes that contain a given point without having to check them all.
+  //======================================================================
+  class BoundingBoxTree
+  {
+  public:
+    /// Constructor: Empty tree
+    BoundingBoxTree() : Dim(0) {}
+
+    /// \short Build the tree for the boxes stored in flat_packed_box:
+    /// The min. and max. i-th coordinate of box b are stored in
+    /// flat_packed_box[2*(b*dim+i)] and flat_packed_box[2*(b*dim+i)+1],
+    /// respectively. Empty boxes (min. > max.) are ignored.
+    void build(const Vector<double>& flat_packed_box, const unsigned& dim);
+
+    /// \short Get the numbers of the boxes that contain the point zeta
+    /// (in no particular order)
+    void boxes_containing(const Vector<double>& zeta,
+                          Vector<unsigned>& box_number) const;
+
+  private:
+    /// \short Helper function to build the subtree (rooted at the
+    /// tree node tree_node) that contains the boxes
+    /// box_number[first],...,box_number[last-1]. n_tree_node is the
+    /// number of tree nodes that have been used so far.
+    void build_subtree(const unsigned& tree_node,
+                       const Vector<double>& flat_packed_box,
+                       Vector<unsigned>& box_number,
+                       const unsigned& first,
+                       const unsigned& last,
+                       unsigned& n_tree_node);
+
+    /// Spatial dimension of the boxes
+    unsigned Dim;
+
+    /// \short Boxes associated with the tree nodes (2*Dim entries per
+    /// tree node, stored as the boxes in build(...))
+    Vector<double> Node_box;
+
+    /// \short Index of the first son of each tree node (the second son
+    /// is stored immediately after it); -1 for leaves
+    Vector<int> First_son;
+
+    /// Number of the box stored in each leaf
+    Vector<unsigned> Leaf_box_number;
+  };
+
+#endif
+
+  //======================================================================
+  /// \short Lookup scheme for the elements that can act as external
+  /// elements in the incremental update of multi-domain interactions
+  /// (see Multi_domain_functions::Use_incremental_locate_zeta): The
+  /// (finite) elements in an external mesh, followed by its external
+  /// halo elements, are numbered consecutively. The scheme provides the
+  /// number of a given element and (set up on demand) the elements that
+  /// share nodes with it. It is kept from one setup of the interaction
+  /// to the next and only rebuilt if the elements have changed.
+  //======================================================================
+  class ExternalElementLookup
+  {
+  public:
+    /// Constructor: Empty lookup scheme
+    ExternalElementLookup() : Neighbours_are_set_up(false) {}
+
+    /// \short Update the lookup scheme for the elements in (and the
+    /// external halo elements of) external_mesh_pt. This only compares
+    /// the elements with the ones that were there during the previous
+    /// call; the scheme is only rebuilt if they've changed.
+    void update(Mesh* const& external_mesh_pt);
+
+    /// Number of elements
+    unsigned nelement() const
+    {
+      return Element_pt.size();
+    }
+
+    /// e-th element
+    FiniteElement* element_pt(const unsigned& e) const
+    {
+      return Element_pt[e];
+    }
+
+    /// \short Number of the element el_pt; -1 if it's not one of the
+    /// elements (any more)
+    int element_number(FiniteElement* const& el_pt) const
+    {
+      std::map<FiniteElement*, unsigned>::const_iterator it =
+        Element_number.find(el_pt);
+      if (it == Element_number.end())
+      {
+        return -1;
+      }
+      return (*it).second;
+    }
+
+    /// \short Set up the lookup scheme for the elements that share nodes
+    /// with the elements (unless it's already set up)
+    void setup_neighbours();
+
+    /// \short Number of elements that share nodes with the e-th element
+    /// (setup_neighbours() must have been called)
+    unsigned nneighbour(const unsigned& e) const
+    {
+      return First_neighbour[e + 1] - First_neighbour[e];
+    }
+
+    /// \short Number of the i-th element that shares nodes with the e-th
+    /// element (setup_neighbours() must have been called)
+    unsigned neighbour(const unsigned& e, const unsigned& i) const
+    {
+      return Neighbour[First_neighbour[e] + i];
+    }
+
+  private:
+    /// The elements
+    Vector<FiniteElement*> Element_pt;
+
+    /// Map from the elements to their numbers
+    std::map<FiniteElement*, unsigned> Element_number;
+
+    /// Has the lookup scheme for the neighbours been set up?
+    bool Neighbours_are_set_up;
+
+    /// \short The numbers of the elements that share nodes with the e-th
+    /// element are stored in Neighbour[First_neighbour[e]],...,
+    /// Neighbour[First_neighbour[e+1]-1]
+    Vector<unsigned> First_neighbour;
+
+    /// Numbers of the neighbouring elements (see First_neighbour)
+    Vector<unsigned> Neighbour;
+  };
+
+
   //======================================================================
   // Namespace for global multi-domain functions
   //======================================================================
@@ -185,6 +325,78 @@ namespace oomph
     /// setup_bulk_elements_adjacent_to_face_mesh(...)
     extern std::ofstream Doc_boundary_coordinate_file;
 
+    /// \short Boolean to indicate that the zeta coordinates are to be
+    /// located in batches: The points are sorted along a space-filling
+    /// (Morton) curve and located block by block, using the rank's
+    /// thread pool (see ThreadingHelpers). In distributed problems the
+    /// points that can't be found locally are sent directly to the
+    /// processors whose bounding boxes (of their parts of the external
+    /// meshes) contain them, rather than being passed around the ring
+    /// of processors. Default: false.
+    extern bool Use_batched_locate_zeta;
+
+    /// \short Number of points in the blocks that are located in one go
+    /// (by one thread) when Use_batched_locate_zeta is true
+    extern unsigned Nzeta_per_block_in_batched_locate_zeta;
+
+    /// \short Tolerance (relative to their size) by which the bounding
+    /// boxes of the external meshes are inflated when
+    /// Use_batched_locate_zeta is true
+    extern double Tolerance_for_bounding_box_in_batched_locate_zeta;
+
+    /// \short Boolean to indicate that the external elements are to be
+    /// updated incrementally: The search for the external element
+    /// associated with an integration point starts from the external
+    /// element (and local coordinate) found during the previous setup of
+    /// the interaction and walks to its neighbours (elements that
+    /// share nodes with it) if the point has left it. The full search
+    /// (and the bin structure it requires) is only used if there are
+    /// points that can't be found that way. Previously created external
+    /// halo elements are re-used, so setup_multi_domain_interactions(...)
+    /// no longer deletes the existing external halo(ed) storage;
+    /// call Mesh::delete_all_external_storage() to get rid of external
+    /// halo elements that are no longer required. Ignored if
+    /// Use_bulk_element_as_external is true. Default: false.
+    extern bool Use_incremental_locate_zeta;
+
+    /// \short Number of layers of neighbouring elements searched by the
+    /// incremental update before resorting to the full search
+    extern unsigned Nneighbour_layer_in_incremental_locate_zeta;
+
+    /// \short Previously located external elements:
+    /// Previous_external_element_pt[e][ipt] is the external element that
+    /// was associated with the ipt-th integration point of the e-th
+    /// element (in the flat-packed enumeration of the elements in the
+    /// meshes) when the interaction was last set up. Only used if
+    /// Use_incremental_locate_zeta is true.
+    extern Vector<Vector<FiniteElement*>> Previous_external_element_pt;
+
+    /// \short Local coordinates within the previously located external
+    /// elements (see Previous_external_element_pt)
+    extern Vector<Vector<Vector<double>>> Previous_external_element_local_coord;
+
+    /// \short Lookup schemes for the elements in the external meshes
+    /// used by the incremental update (one for each external mesh). They
+    /// are kept from one setup of the interaction to the next.
+    extern std::map<Mesh*, ExternalElementLookup> External_element_lookup;
+
+#ifdef OOMPH_HAS_MPI
+
+    /// \short Bounding boxes of the (non-halo elements in the) external
+    /// meshes on all processors (only set up when Use_batched_locate_zeta
+    /// is true): The min. and max. i-th coordinate on processor p in
+    /// the i_mesh-th external mesh are stored in
+    /// Bounding_box_of_external_mesh[i_mesh][2*(p*Dim+i)] and
+    /// Bounding_box_of_external_mesh[i_mesh][2*(p*Dim+i)+1], respectively.
+    extern Vector<Vector<double>> Bounding_box_of_external_mesh;
+
+    /// \short Trees of the boxes in Bounding_box_of_external_mesh, used
+    /// to find the processors on which the points that can't be located
+    /// locally may be located
+    extern Vector<BoundingBoxTree> Bounding_box_tree_of_external_mesh;
+
+#endif
+
 
     // Functions for multi-domain method
 
@@ -354,8 +566,115 @@ namespace oomph
       const unsigned& interaction_index);
 
 
+    /// \short Batched version of locate_zeta_for_local_coordinates(...),
+    /// used if Use_batched_locate_zeta is true: the points are located
+    /// along a space-filling curve, in blocks that are distributed over
+    /// the rank's threads.
+    void batched_locate_zeta_for_local_coordinates(
+      const Vector<Mesh*>& mesh_pt,
+      Mesh* const& external_mesh_pt,
+      Vector<MeshAsGeomObject*>& mesh_geom_obj_pt,
+      const unsigned& interaction_index);
+
+    /// \short Incremental version of locate_zeta_for_local_coordinates(...),
+    /// used if Use_incremental_locate_zeta is true: Try to locate the
+    /// zeta coordinates of the integration points in (or near) the
+    /// external elements in which they were located previously. Points
+    /// that can't be found that way are left for the full search.
+    /// Returns the number of such points.
+    unsigned incremental_locate_zeta_for_local_coordinates(
+      const Vector<Mesh*>& mesh_pt,
+      Mesh* const& external_mesh_pt,
+      const unsigned& interaction_index);
+
+    /// \short Helper function for locate_zeta_for_local_coordinates(...):
+    /// Record the outcome of the search for the external element for the
+    /// ipt-th integration point (at zeta coordinate x_global) of element
+    /// el_pt, the e_count-th element in the flat-packed enumeration of
+    /// the elements in the meshes. sub_geom_obj_pt and s_ext are the
+    /// sub-object and the local coordinates within it, as returned by
+    /// locate_zeta(...).
+    void record_outcome_of_local_locate_zeta(
+      ElementWithExternalElement* const& el_pt,
+      const unsigned& e_count,
+      const unsigned& ipt,
+      const Vector<double>& x_global,
+      GeomObject* const& sub_geom_obj_pt,
+      const Vector<double>& s_ext,
+      const unsigned& interaction_index);
+
+    /// \short Sort the points whose coordinates are stored in flat-packed
+    /// form (in groups of Dim) in flat_packed_zeta along a space-filling
+    /// (Morton) curve. On return, order[k] is the index of the k-th point
+    /// along the curve.
+    void sort_along_space_filling_curve(const Vector<double>& flat_packed_zeta,
+                                        Vector<unsigned>& order);
+
+
 #ifdef OOMPH_HAS_MPI
 
+    /// \short Helper function to set up Bounding_box_of_external_mesh
+    /// for the external meshes represented by the mesh_geom_obj_pt.
+    void setup_bounding_boxes_of_external_meshes(
+      Problem* problem_pt, Vector<MeshAsGeomObject*>& mesh_geom_obj_pt);
+
+    /// \short Does the bounding box of the i_mesh-th external mesh on
+    /// processor proc contain the point zeta?
+    bool bounding_box_contains_zeta(const unsigned& i_mesh,
+                                    const unsigned& proc,
+                                    const Vector<double>& zeta);
+
+    /// \short Locate the zeta coordinates that couldn't be found locally
+    /// (stored in Flat_packed_zetas_not_found_locally) by sending them
+    /// directly to the processors whose bounding boxes contain them
+    /// (found from Bounding_box_tree_of_external_mesh), rather than
+    /// passing them around the ring of processors. The candidate
+    /// processors are tried one after the other (in the order in which
+    /// the ring-like search would visit them), so a point ends up
+    /// associated with the same external element as in the ring-like
+    /// search. On return Flat_packed_zetas_not_found_locally contains
+    /// the zetas that couldn't be found anywhere.
+    template<class EXT_ELEMENT>
+    void locate_missing_zetas_on_owning_processors(
+      const Vector<Mesh*>& mesh_pt,
+      Mesh* const& external_mesh_pt,
+      Problem* problem_pt,
+      Vector<MeshAsGeomObject*>& mesh_geom_obj_pt,
+      const unsigned& interaction_index);
+
+    /// \short Send the (padded, flat-packed) zetas in zetas_for_proc[p]
+    /// to processor p and receive the zetas sent to this processor from
+    /// elsewhere in received_zetas[p]. The receiving processors don't know
+    /// where the zetas come from, so this uses the "non-blocking
+    /// consensus" algorithm (synchronous sends followed by a
+    /// non-blocking barrier) rather than an all-to-all exchange of
+    /// counts. round is the number of the round of the exchange in the
+    /// current search; it's used to keep the messages from consecutive
+    /// rounds apart.
+    void send_missing_zetas_to_owning_processors(
+      Problem* problem_pt,
+      std::map<int, Vector<double>>& zetas_for_proc,
+      std::map<int, Vector<double>>& received_zetas,
+      const unsigned& round);
+
+    /// \short Send the information about the external elements located
+    /// by locate_zeta_for_missing_coordinates(...) back to the processor
+    /// orig_proc that asked for them. The information is packed into
+    /// unsigned_buffer and double_buffer which must remain untouched
+    /// until the two requests returned in send_request have completed.
+    void send_located_info_to_processor(Problem* problem_pt,
+                                        const int& orig_proc,
+                                        Vector<unsigned>& unsigned_buffer,
+                                        Vector<double>& double_buffer,
+                                        Vector<MPI_Request>& send_request);
+
+    /// \short Receive the information sent by
+    /// send_located_info_to_processor(...) on processor owning_proc and
+    /// unpack it into Located_element_status, Flat_packed_unsigneds,
+    /// Flat_packed_doubles and Flat_packed_located_coordinates.
+    void receive_located_info_from_processor(Problem* problem_pt,
+                                             const int& owning_proc);
+
     /// \short Helper function to send any "missing" zeta coordinates to
     /// the next process and receive any coordinates from previous process
     void send_and_receive_missing_zetas(Problem* problem_pt);
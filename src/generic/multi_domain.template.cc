@@ -249,8 +249,12 @@ namespace oomph
     const unsigned& second_interaction)
   {
     // Delete all the current external halo(ed) element and node storage
-    first_mesh_pt->delete_all_external_storage();
-    second_mesh_pt->delete_all_external_storage();
+    // (unless it's re-used by the incremental update)
+    if (!Use_incremental_locate_zeta)
+    {
+      first_mesh_pt->delete_all_external_storage();
+      second_mesh_pt->delete_all_external_storage();
+    }
 
     // Call setup_multi_domain_interaction in both directions
     setup_multi_domain_interaction<ELEMENT_1>(
@@ -624,78 +628,12 @@ namespace oomph
     unsigned n_zeta_not_found = 0;
 
     // Geometric objects used to represent the external (face) meshes
+    // (only created if the full search is required)
     Vector<MeshAsGeomObject*> mesh_geom_obj_pt(n_mesh, 0);
 
-#ifdef PARANOID
-
-    // Initialise lagrangian dimension of element (test only)
-    unsigned el_dim_lag = 0;
-
-#endif
-
-    // Create mesh as geom objects for all meshes
-    for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
-    {
-      // Are bulk elements used as external elements?
-      if (!Use_bulk_element_as_external)
-      {
-        // Fix this when required
-        if (n_mesh != 1)
-        {
-          std::ostringstream error_stream;
-          error_stream
-            << "Sorry I currently can't deal with non-bulk external elements\n"
-            << "in multi-domain setup for multiple meshes.\n"
-            << "The functionality should be easy to implement now that you\n"
-            << "have a test case. If you're not willinig to do this, call\n"
-            << "the multi-domain setup mesh-by-mesh instead (though this can\n"
-            << "be costly in parallel because of global comms. \n";
-          throw OomphLibError(error_stream.str(),
-                              OOMPH_CURRENT_FUNCTION,
-                              OOMPH_EXCEPTION_LOCATION);
-        }
-
-        // Set the geometric object from the external mesh
-        mesh_geom_obj_pt[0] = new MeshAsGeomObject(external_mesh_pt);
-      }
-      else
-      {
-        // Set the geometric object from the external face mesh argument
-        mesh_geom_obj_pt[i_mesh] =
-          new MeshAsGeomObject(external_face_mesh_pt[i_mesh]);
-      }
-
-#ifdef PARANOID
-      unsigned old_el_dim_lag = el_dim_lag;
-
-      // Set lagrangian dimension of element
-      el_dim_lag = mesh_geom_obj_pt[i_mesh]->nlagrangian();
-
-      // Check consistency
-      if (i_mesh > 0)
-      {
-        if (el_dim_lag != old_el_dim_lag)
-        {
-          std::ostringstream error_stream;
-          error_stream << "Lagrangian dimensions of elements don't match \n "
-                       << "between meshes: " << el_dim_lag << " "
-                       << old_el_dim_lag << "\n";
-          throw OomphLibError(error_stream.str(),
-                              OOMPH_CURRENT_FUNCTION,
-                              OOMPH_EXCEPTION_LOCATION);
-        }
-      }
-#endif
-
-
-    } // end of loop over meshes
-
     double t_setup_lookups = 0.0;
     if (Doc_timings)
     {
-      t_set = TimingHelpers::timer();
-      oomph_info << "CPU for creation of MeshAsGeomObjects and bin structure: "
-                 << t_set - t_start << std::endl;
       t_setup_lookups = TimingHelpers::timer();
     }
 
@@ -712,6 +650,14 @@ namespace oomph
     }
     External_element_located.resize(e_count);
 
+    // Storage for the previously located external elements and local
+    // coordinates (used as starting points for the search)
+    if (Use_incremental_locate_zeta)
+    {
+      Previous_external_element_pt.resize(e_count);
+      Previous_external_element_local_coord.resize(e_count);
+    }
+
     // Reset counter for elements in flat packed storage
     e_count = 0;
 
@@ -740,8 +686,22 @@ namespace oomph
           // points within the element has changed.
           el_pt->initialise_external_element_storage();
 
-          // Clear any previous allocation
+          // Keep the previous allocation for the incremental update
           unsigned n_intpt = el_pt->integral_pt()->nweight();
+          if (Use_incremental_locate_zeta)
+          {
+            Previous_external_element_pt[e_count].resize(n_intpt);
+            Previous_external_element_local_coord[e_count].resize(n_intpt);
+            for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+            {
+              Previous_external_element_pt[e_count][ipt] =
+                el_pt->external_element_pt(interaction_index, ipt);
+              Previous_external_element_local_coord[e_count][ipt] =
+                el_pt->external_element_local_coord(interaction_index, ipt);
+            }
+          }
+
+          // Clear any previous allocation
           for (unsigned ipt = 0; ipt < n_intpt; ipt++)
           {
             el_pt->external_element_pt(interaction_index, ipt) = 0;
@@ -767,123 +727,275 @@ namespace oomph
         << t - t_setup_lookups << std::endl;
     }
 
+    // Start from the previously located external elements and only
+    // use the (spiraling, parallel) search below for the points that
+    // can't be found in their vicinity -- if there are any
+    bool full_search_required = true;
+    if (Use_incremental_locate_zeta)
+    {
+      double t_incremental_start = 0.0;
+      if (Doc_timings)
+      {
+        t_incremental_start = TimingHelpers::timer();
+      }
+
+      unsigned n_not_found = incremental_locate_zeta_for_local_coordinates(
+        mesh_pt, external_mesh_pt, interaction_index);
+
+#ifdef OOMPH_HAS_MPI
+      // The full search involves communication, so everybody needs to
+      // take part if anybody needs it
+      if (n_proc > 1)
+      {
+        unsigned local_n_not_found = n_not_found;
+        MPI_Allreduce(&local_n_not_found,
+                      &n_not_found,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      problem_pt->communicator_pt()->mpi_comm());
+      }
+#endif
+      full_search_required = (n_not_found != 0);
+
+      if (Doc_timings)
+      {
+        oomph_info << "CPU for incremental location of zeta coordinates: "
+                   << TimingHelpers::timer() - t_incremental_start
+                   << std::endl
+                   << "Number of points left for the full search: "
+                   << n_not_found << std::endl;
+      }
+    }
+
+    // Create the geometric objects (and their bin structures) for the
+    // full search
+    if (full_search_required)
+    {
+      double t_geom_obj_start = 0.0;
+      if (Doc_timings)
+      {
+        t_geom_obj_start = TimingHelpers::timer();
+      }
+
+#ifdef PARANOID
+
+      // Initialise lagrangian dimension of element (test only)
+      unsigned el_dim_lag = 0;
+
+#endif
+
+      // Create mesh as geom objects for all meshes
+      for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
+      {
+        // Are bulk elements used as external elements?
+        if (!Use_bulk_element_as_external)
+        {
+          // Fix this when required
+          if (n_mesh != 1)
+          {
+            std::ostringstream error_stream;
+            error_stream
+              << "Sorry I currently can't deal with non-bulk external "
+                 "elements\n"
+              << "in multi-domain setup for multiple meshes.\n"
+              << "The functionality should be easy to implement now that "
+                 "you\n"
+              << "have a test case. If you're not willinig to do this, call\n"
+              << "the multi-domain setup mesh-by-mesh instead (though this "
+                 "can\n"
+              << "be costly in parallel because of global comms. \n";
+            throw OomphLibError(error_stream.str(),
+                                OOMPH_CURRENT_FUNCTION,
+                                OOMPH_EXCEPTION_LOCATION);
+          }
+
+          // Set the geometric object from the external mesh
+          mesh_geom_obj_pt[0] = new MeshAsGeomObject(external_mesh_pt);
+        }
+        else
+        {
+          // Set the geometric object from the external face mesh argument
+          mesh_geom_obj_pt[i_mesh] =
+            new MeshAsGeomObject(external_face_mesh_pt[i_mesh]);
+        }
+
+#ifdef PARANOID
+        unsigned old_el_dim_lag = el_dim_lag;
+
+        // Set lagrangian dimension of element
+        el_dim_lag = mesh_geom_obj_pt[i_mesh]->nlagrangian();
+
+        // Check consistency
+        if (i_mesh > 0)
+        {
+          if (el_dim_lag != old_el_dim_lag)
+          {
+            std::ostringstream error_stream;
+            error_stream << "Lagrangian dimensions of elements don't match \n "
+                         << "between meshes: " << el_dim_lag << " "
+                         << old_el_dim_lag << "\n";
+            throw OomphLibError(error_stream.str(),
+                                OOMPH_CURRENT_FUNCTION,
+                                OOMPH_EXCEPTION_LOCATION);
+          }
+        }
+#endif
+
+
+      } // end of loop over meshes
+
+#ifdef OOMPH_HAS_MPI
+      // Gather the bounding boxes of the external meshes on all processors
+      // so the parallel search can be restricted to the processors that
+      // may contain the points
+      if (Use_batched_locate_zeta && (n_proc > 1) &&
+          problem_pt->problem_has_been_distributed())
+      {
+        setup_bounding_boxes_of_external_meshes(problem_pt, mesh_geom_obj_pt);
+      }
+      else
+      {
+        Bounding_box_of_external_mesh.clear();
+        Bounding_box_tree_of_external_mesh.clear();
+      }
+#endif
+
+      if (Doc_timings)
+      {
+        t_set = TimingHelpers::timer();
+        oomph_info
+          << "CPU for creation of MeshAsGeomObjects and bin structure: "
+          << t_set - t_geom_obj_start << std::endl;
+      }
+    }
+
+
     // Initialise maximum spiral level within the cartesian bin structure
     // Used to terminate spiraling for non-refineable bin
     unsigned n_max_level = 0;
 
 #ifdef OOMPH_HAS_MPI
-    unsigned max_level_reached = 1;
+    unsigned max_level_reached = 0;
+    if (full_search_required)
+    {
+      max_level_reached = 1;
+    }
 #endif
 
     // Max. number of sample points -- used to decide on termination of
     // "spiraling"
     unsigned max_n_sample_points_of_sample_point_containers = 0;
 
-    // Loop over all meshes
-    for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
+    // Initialise the search in the sample point containers
+    if (full_search_required)
     {
-      if (mesh_geom_obj_pt[i_mesh]->sample_point_container_version() ==
-          UseRefineableBinArray)
+      // Loop over all meshes
+      for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
       {
-        RefineableBinArray* bin_array_pt = dynamic_cast<RefineableBinArray*>(
-          mesh_geom_obj_pt[i_mesh]->sample_point_container_pt());
+        if (mesh_geom_obj_pt[i_mesh]->sample_point_container_version() ==
+            UseRefineableBinArray)
+        {
+          RefineableBinArray* bin_array_pt = dynamic_cast<RefineableBinArray*>(
+            mesh_geom_obj_pt[i_mesh]->sample_point_container_pt());
 
-        bin_array_pt
-          ->last_sample_point_to_actually_lookup_during_locate_zeta() =
           bin_array_pt
-            ->initial_last_sample_point_to_actually_lookup_during_locate_zeta();
-        bin_array_pt
-          ->first_sample_point_to_actually_lookup_during_locate_zeta() = 0;
+            ->last_sample_point_to_actually_lookup_during_locate_zeta() =
+            bin_array_pt
+              ->initial_last_sample_point_to_actually_lookup_during_locate_zeta();
+          bin_array_pt
+            ->first_sample_point_to_actually_lookup_during_locate_zeta() = 0;
 
-        unsigned nsp =
-          bin_array_pt->total_number_of_sample_points_computed_recursively();
-        if (nsp > max_n_sample_points_of_sample_point_containers)
-        {
-          max_n_sample_points_of_sample_point_containers = nsp;
-        }
+          unsigned nsp =
+            bin_array_pt->total_number_of_sample_points_computed_recursively();
+          if (nsp > max_n_sample_points_of_sample_point_containers)
+          {
+            max_n_sample_points_of_sample_point_containers = nsp;
+          }
 
 
 #ifdef OOMPH_HAS_MPI
-        // If the mesh has been distributed we want the max. number
-        // of sample points across all processors
-        if (problem_pt->communicator_pt()->nproc() > 1)
-        {
-          unsigned local_max_n_sample_points_of_sample_point_containers =
-            max_n_sample_points_of_sample_point_containers;
+          // If the mesh has been distributed we want the max. number
+          // of sample points across all processors
+          if (problem_pt->communicator_pt()->nproc() > 1)
+          {
+            unsigned local_max_n_sample_points_of_sample_point_containers =
+              max_n_sample_points_of_sample_point_containers;
 
-          // Get  maximum over all processors
-          MPI_Allreduce(&local_max_n_sample_points_of_sample_point_containers,
-                        &max_n_sample_points_of_sample_point_containers,
-                        1,
-                        MPI_UNSIGNED,
-                        MPI_MAX,
-                        problem_pt->communicator_pt()->mpi_comm());
-        }
+            // Get  maximum over all processors
+            MPI_Allreduce(&local_max_n_sample_points_of_sample_point_containers,
+                          &max_n_sample_points_of_sample_point_containers,
+                          1,
+                          MPI_UNSIGNED,
+                          MPI_MAX,
+                          problem_pt->communicator_pt()->mpi_comm());
+          }
 #endif
-      }
-      else if (mesh_geom_obj_pt[i_mesh]->sample_point_container_version() ==
-               UseNonRefineableBinArray)
-      {
-        NonRefineableBinArray* bin_array_pt =
-          dynamic_cast<NonRefineableBinArray*>(
-            mesh_geom_obj_pt[i_mesh]->sample_point_container_pt());
+        }
+        else if (mesh_geom_obj_pt[i_mesh]->sample_point_container_version() ==
+                 UseNonRefineableBinArray)
+        {
+          NonRefineableBinArray* bin_array_pt =
+            dynamic_cast<NonRefineableBinArray*>(
+              mesh_geom_obj_pt[i_mesh]->sample_point_container_pt());
 
-        // Initialise spiral levels
-        bin_array_pt->current_min_spiral_level() = 0;
-        bin_array_pt->current_max_spiral_level() =
-          bin_array_pt->n_spiral_chunk() - 1;
+          // Initialise spiral levels
+          bin_array_pt->current_min_spiral_level() = 0;
+          bin_array_pt->current_max_spiral_level() =
+            bin_array_pt->n_spiral_chunk() - 1;
 
-        // Find maximum spiral level within the cartesian bin structure
-        n_max_level = bin_array_pt->max_bin_dimension();
+          // Find maximum spiral level within the cartesian bin structure
+          n_max_level = bin_array_pt->max_bin_dimension();
 
-        // Limit it
-        if (bin_array_pt->current_max_spiral_level() > n_max_level)
-        {
-          bin_array_pt->current_max_spiral_level() = n_max_level - 1;
+          // Limit it
+          if (bin_array_pt->current_max_spiral_level() > n_max_level)
+          {
+            bin_array_pt->current_max_spiral_level() = n_max_level - 1;
+          }
         }
-      }
 #ifdef OOMPH_HAS_CGAL
-      // CGAL
-      else if (mesh_geom_obj_pt[i_mesh]->sample_point_container_version() ==
-               UseCGALSamplePointContainer)
-      {
-        CGALSamplePointContainer* bin_array_pt =
-          dynamic_cast<CGALSamplePointContainer*>(
-            mesh_geom_obj_pt[i_mesh]->sample_point_container_pt());
-        bin_array_pt
-          ->last_sample_point_to_actually_lookup_during_locate_zeta() =
+        // CGAL
+        else if (mesh_geom_obj_pt[i_mesh]->sample_point_container_version() ==
+                 UseCGALSamplePointContainer)
+        {
+          CGALSamplePointContainer* bin_array_pt =
+            dynamic_cast<CGALSamplePointContainer*>(
+              mesh_geom_obj_pt[i_mesh]->sample_point_container_pt());
+          bin_array_pt
+            ->last_sample_point_to_actually_lookup_during_locate_zeta() =
+            bin_array_pt
+              ->initial_last_sample_point_to_actually_lookup_during_locate_zeta();
           bin_array_pt
-            ->initial_last_sample_point_to_actually_lookup_during_locate_zeta();
-        bin_array_pt
-          ->first_sample_point_to_actually_lookup_during_locate_zeta() = 0;
+            ->first_sample_point_to_actually_lookup_during_locate_zeta() = 0;
 
-        unsigned nsp =
-          bin_array_pt->total_number_of_sample_points_computed_recursively();
-        if (nsp > max_n_sample_points_of_sample_point_containers)
-        {
-          max_n_sample_points_of_sample_point_containers = nsp;
-        }
+          unsigned nsp =
+            bin_array_pt->total_number_of_sample_points_computed_recursively();
+          if (nsp > max_n_sample_points_of_sample_point_containers)
+          {
+            max_n_sample_points_of_sample_point_containers = nsp;
+          }
 
 
 #ifdef OOMPH_HAS_MPI
-        // If the mesh has been distributed we want the max. number
-        // of sample points across all processors
-        if (problem_pt->communicator_pt()->nproc() > 1)
-        {
-          unsigned local_max_n_sample_points_of_sample_point_containers =
-            max_n_sample_points_of_sample_point_containers;
+          // If the mesh has been distributed we want the max. number
+          // of sample points across all processors
+          if (problem_pt->communicator_pt()->nproc() > 1)
+          {
+            unsigned local_max_n_sample_points_of_sample_point_containers =
+              max_n_sample_points_of_sample_point_containers;
 
-          // Get  maximum over all processors
-          MPI_Allreduce(&local_max_n_sample_points_of_sample_point_containers,
-                        &max_n_sample_points_of_sample_point_containers,
-                        1,
-                        MPI_UNSIGNED,
-                        MPI_MAX,
-                        problem_pt->communicator_pt()->mpi_comm());
-        }
+            // Get  maximum over all processors
+            MPI_Allreduce(&local_max_n_sample_points_of_sample_point_containers,
+                          &max_n_sample_points_of_sample_point_containers,
+                          1,
+                          MPI_UNSIGNED,
+                          MPI_MAX,
+                          problem_pt->communicator_pt()->mpi_comm());
+          }
 #endif
-      }
+        }
 #endif // cgal
+      }
     }
 
 
@@ -895,7 +1007,7 @@ namespace oomph
     // Note: All meshes go through their spirals simultaneously;
     // read out spiral level from first one
     unsigned i_level = 0;
-    bool has_not_reached_max_level_of_search = true;
+    bool has_not_reached_max_level_of_search = full_search_required;
     while (has_not_reached_max_level_of_search)
     {
       // Record time at start of spiral loop
@@ -994,13 +1106,43 @@ namespace oomph
         double t_create_halo_max = -DBL_MAX;
         double t_create_halo_tot = 0.0;
 
+        // If we know the bounding boxes of the external meshes on all
+        // processors, send the missing zetas straight to the processors
+        // that may contain them; no need for the ring communication
+        int max_iproc = n_proc - 1;
+        if (Bounding_box_of_external_mesh.size() != 0)
+        {
+          double t_direct_start = 0.0;
+          if (Doc_timings)
+          {
+            t_direct_start = TimingHelpers::timer();
+          }
+
+          locate_missing_zetas_on_owning_processors<EXT_ELEMENT>(
+            mesh_pt,
+            external_mesh_pt,
+            problem_pt,
+            mesh_geom_obj_pt,
+            interaction_index);
+          max_iproc = 0;
+
+          if (Doc_timings)
+          {
+            oomph_info << "CPU for location of missing zeta coordinates on "
+                       << "the processors that may contain them [spiral "
+                       << "level " << i_level
+                       << "]: " << TimingHelpers::timer() - t_direct_start
+                       << std::endl;
+          }
+        }
+
         // Start ring communication: Loop (number of processes - 1)
         // starting from 1. The variable iproc represents the "distance" from
         // the current process to the process for which it is attempting
         // to locate an element for the current set of not-yet-located
         // zeta coordinates
         unsigned ring_count = 0;
-        for (int iproc = 1; iproc < n_proc; iproc++)
+        for (int iproc = 1; iproc <= max_iproc; iproc++)
         {
           // Record time at start of loop
           if (Doc_timings)
@@ -1079,12 +1221,20 @@ namespace oomph
           if (problem_pt->communicator_pt()->nproc() > 1)
           {
             unsigned count_local_zetas = n_zeta_not_found;
+            double t_start = CommunicationStatistics::timer();
             MPI_Allreduce(&count_local_zetas,
                           &n_zeta_not_found,
                           1,
                           MPI_UNSIGNED,
                           MPI_SUM,
                           problem_pt->communicator_pt()->mpi_comm());
+            CommunicationStatistics::record_collective(
+              CommunicationStatistics::Multi_domain_interaction,
+              sizeof(unsigned),
+              sizeof(unsigned));
+            CommunicationStatistics::record_wait_time(
+              CommunicationStatistics::Multi_domain_interaction,
+              CommunicationStatistics::timer() - t_start);
           }
 #endif
 
@@ -1104,7 +1254,7 @@ namespace oomph
 
 
         // Doc timings
-        if (Doc_timings)
+        if (Doc_timings && (max_iproc > 0))
         {
           oomph_info << "Ring-based search continued until iteration "
                      << ring_count << " out of a maximum of "
@@ -1916,6 +2066,272 @@ namespace oomph
   }
 
 
+  //=====================================================================
+  /// Locate the zeta coordinates that couldn't be found locally (stored
+  /// in Flat_packed_zetas_not_found_locally) by sending them directly to
+  /// the processors whose bounding boxes contain them. The candidate
+  /// processors are tried one after the other, in the order in which
+  /// the ring-like search would visit them: In each round every
+  /// processor sends each of its still missing zetas to its next
+  /// candidate, which tries to locate it and sends the outcome back.
+  /// The rounds continue until no processor has any candidates left
+  /// for its missing zetas.
+  /// On return Flat_packed_zetas_not_found_locally contains the zetas
+  /// that couldn't be found anywhere.
+  //=====================================================================
+  template<class EXT_ELEMENT>
+  void Multi_domain_functions::locate_missing_zetas_on_owning_processors(
+    const Vector<Mesh*>& mesh_pt,
+    Mesh* const& external_mesh_pt,
+    Problem* problem_pt,
+    Vector<MeshAsGeomObject*>& mesh_geom_obj_pt,
+    const unsigned& interaction_index)
+  {
+    OomphCommunicator* comm_pt = problem_pt->communicator_pt();
+    int n_proc = comm_pt->nproc();
+    int my_rank = comm_pt->my_rank();
+    unsigned n_mesh = mesh_pt.size();
+
+    // The zeta tuples that haven't been located locally (including the
+    // padding at the end of each mesh), enumerated as in
+    // create_external_halo_elements(...)
+    Vector<double> missing_zeta(Flat_packed_zetas_not_found_locally);
+    unsigned n_tuple = missing_zeta.size() / Dim;
+
+    // Find the mesh associated with each tuple (n_mesh for the padding)
+    // and the other processors whose bounding boxes contain it (in the
+    // order in which the ring-like search would visit them)
+    Vector<unsigned> mesh_of_tuple(n_tuple);
+    Vector<Vector<int>> candidate_proc(n_tuple);
+    unsigned i_mesh = 0;
+    Vector<double> zeta(Dim);
+    Vector<unsigned> box_number;
+    Vector<int> distance;
+    for (unsigned t = 0; t < n_tuple; t++)
+    {
+      for (unsigned i = 0; i < Dim; i++)
+      {
+        zeta[i] = missing_zeta[t * Dim + i];
+      }
+
+      // Padding indicates the end of the current mesh
+      if (zeta[0] == DBL_MAX)
+      {
+        mesh_of_tuple[t] = n_mesh;
+        i_mesh++;
+        continue;
+      }
+      mesh_of_tuple[t] = i_mesh;
+
+      Bounding_box_tree_of_external_mesh[i_mesh].boxes_containing(zeta,
+                                                                  box_number);
+      distance.resize(0);
+      unsigned n_box = box_number.size();
+      for (unsigned b = 0; b < n_box; b++)
+      {
+        int d = (int(box_number[b]) - my_rank + n_proc) % n_proc;
+        if (d != 0)
+        {
+          distance.push_back(d);
+        }
+      }
+      std::sort(distance.begin(), distance.end());
+      unsigned n_candidate = distance.size();
+      candidate_proc[t].resize(n_candidate);
+      for (unsigned c = 0; c < n_candidate; c++)
+      {
+        candidate_proc[t][c] = (my_rank + distance[c]) % n_proc;
+      }
+    }
+
+    // Has the tuple been located yet?
+    Vector<unsigned> located(n_tuple, 0);
+
+    unsigned round = 0;
+    while (true)
+    {
+      // Which of the tuples are sent to which processor in this round?
+      std::map<int, Vector<unsigned>> tuples_for_proc;
+      for (unsigned t = 0; t < n_tuple; t++)
+      {
+        if ((mesh_of_tuple[t] < n_mesh) && (located[t] == 0) &&
+            (round < candidate_proc[t].size()))
+        {
+          tuples_for_proc[candidate_proc[t][round]].push_back(t);
+        }
+      }
+
+      // We're done once no processor has any tuples left to send
+      int local_tuples_to_send = !tuples_for_proc.empty();
+      int tuples_to_send = 0;
+      double t_start = CommunicationStatistics::timer();
+      MPI_Allreduce(&local_tuples_to_send,
+                    &tuples_to_send,
+                    1,
+                    MPI_INT,
+                    MPI_MAX,
+                    comm_pt->mpi_comm());
+      CommunicationStatistics::record_collective(
+        CommunicationStatistics::Multi_domain_interaction,
+        sizeof(int),
+        sizeof(int));
+      CommunicationStatistics::record_wait_time(
+        CommunicationStatistics::Multi_domain_interaction,
+        CommunicationStatistics::timer() - t_start);
+      if (tuples_to_send == 0)
+      {
+        break;
+      }
+
+      // Flat-pack their zetas, padded as Flat_packed_zetas_not_found_locally
+      std::map<int, Vector<double>> zetas_for_proc;
+      for (std::map<int, Vector<unsigned>>::iterator it =
+             tuples_for_proc.begin();
+           it != tuples_for_proc.end();
+           it++)
+      {
+        Vector<double>& zetas = zetas_for_proc[it->first];
+        unsigned current_mesh = 0;
+        unsigned n_tuple_for_proc = it->second.size();
+        for (unsigned k = 0; k < n_tuple_for_proc; k++)
+        {
+          unsigned t = it->second[k];
+          while (mesh_of_tuple[t] > current_mesh)
+          {
+            zetas.insert(zetas.end(), Dim, DBL_MAX);
+            current_mesh++;
+          }
+          for (unsigned i = 0; i < Dim; i++)
+          {
+            zetas.push_back(missing_zeta[t * Dim + i]);
+          }
+        }
+        while (current_mesh < n_mesh)
+        {
+          zetas.insert(zetas.end(), Dim, DBL_MAX);
+          current_mesh++;
+        }
+      }
+
+      // Send them off and receive the ones other processors are
+      // looking for
+      std::map<int, Vector<double>> received_zetas;
+      send_missing_zetas_to_owning_processors(
+        problem_pt, zetas_for_proc, received_zetas, round);
+
+      // Try to locate the received zetas here and send the outcome back
+      std::map<int, Vector<unsigned>> unsigned_buffer;
+      std::map<int, Vector<double>> double_buffer;
+      Vector<MPI_Request> send_request;
+      for (std::map<int, Vector<double>>::iterator it = received_zetas.begin();
+           it != received_zetas.end();
+           it++)
+      {
+        int orig_proc = it->first;
+        Received_flat_packed_zetas_to_be_found = it->second;
+        Located_element_status.clear();
+        Proc_id_plus_one_of_external_element.clear();
+
+        // "Distance" (in the ring-like search) from the processor that
+        // sent the zetas
+        int iproc = (my_rank - orig_proc + n_proc) % n_proc;
+        locate_zeta_for_missing_coordinates(
+          iproc, external_mesh_pt, problem_pt, mesh_geom_obj_pt);
+        send_located_info_to_processor(problem_pt,
+                                       orig_proc,
+                                       unsigned_buffer[orig_proc],
+                                       double_buffer[orig_proc],
+                                       send_request);
+      }
+
+      // Receive the outcome of the search on the processors to which we
+      // sent our zetas (one processor at a time, so the external halo
+      // elements are created in the same order as the external haloed
+      // elements there)
+      for (std::map<int, Vector<unsigned>>::iterator it =
+             tuples_for_proc.begin();
+           it != tuples_for_proc.end();
+           it++)
+      {
+        int owning_proc = it->first;
+        receive_located_info_from_processor(problem_pt, owning_proc);
+        Vector<unsigned> status_from_proc(Located_element_status);
+
+        // Translate to the enumeration of the tuples that haven't been
+        // located yet, as used in create_external_halo_elements(...)
+        Vector<unsigned> index_of_tuple(n_tuple);
+        unsigned n_unlocated = 0;
+        for (unsigned t = 0; t < n_tuple; t++)
+        {
+          index_of_tuple[t] = n_unlocated;
+          if (located[t] == 0)
+          {
+            n_unlocated++;
+          }
+        }
+        Proc_id_plus_one_of_external_element.assign(n_unlocated, 0);
+        Located_element_status.assign(n_unlocated, Not_found);
+
+        Vector<unsigned> newly_located;
+        unsigned current_mesh = 0;
+        unsigned count = 0;
+        unsigned n_tuple_for_proc = it->second.size();
+        for (unsigned k = 0; k < n_tuple_for_proc; k++)
+        {
+          // Skip the padding
+          unsigned t = it->second[k];
+          while (mesh_of_tuple[t] > current_mesh)
+          {
+            count++;
+            current_mesh++;
+          }
+          if (status_from_proc[count] != Not_found)
+          {
+            Located_element_status[index_of_tuple[t]] =
+              status_from_proc[count];
+            Proc_id_plus_one_of_external_element[index_of_tuple[t]] =
+              owning_proc + 1;
+            newly_located.push_back(t);
+          }
+          count++;
+        }
+
+        int iproc = (owning_proc - my_rank + n_proc) % n_proc;
+        create_external_halo_elements<EXT_ELEMENT>(
+          iproc, mesh_pt, external_mesh_pt, problem_pt, interaction_index);
+
+        unsigned n_newly_located = newly_located.size();
+        for (unsigned k = 0; k < n_newly_located; k++)
+        {
+          located[newly_located[k]] = 1;
+        }
+      }
+
+      // Wait for the outcome of our searches to have been sent
+      unsigned n_send = send_request.size();
+      if (n_send != 0)
+      {
+        MPI_Waitall(n_send, &send_request[0], MPI_STATUSES_IGNORE);
+      }
+      round++;
+    }
+
+    // Keep the zetas that haven't been found anywhere (and the padding)
+    Flat_packed_zetas_not_found_locally.resize(0);
+    for (unsigned t = 0; t < n_tuple; t++)
+    {
+      if (located[t] == 0)
+      {
+        for (unsigned i = 0; i < Dim; i++)
+        {
+          Flat_packed_zetas_not_found_locally.push_back(
+            missing_zeta[t * Dim + i]);
+        }
+      }
+    }
+  }
+
+
   //============start of add_external_halo_node_to_storage===============
   /// Helper function to add external halo nodes, including any masters,
   /// based on information received from the haloed process
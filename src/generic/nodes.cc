@@ -193,7 +193,7 @@ namespace oomph
     }
 
     // Delete the double storage arrays at once (they were allocated at once)
-    delete[] Value[0];
+    OutOfCoreStorage::deallocate(Value[0]);
     // Delete the pointers to the arrays.
     delete[] Value;
     delete[] Eqn_number;
@@ -325,7 +325,8 @@ namespace oomph
       Value = new double*[initial_n_value];
 
       // Allocate all the data values in one big array for data locality.
-      double* values = new double[initial_n_value * n_tstorage];
+      double* values =
+        OutOfCoreStorage::allocate(initial_n_value * n_tstorage, n_tstorage);
 
       // Set the pointers to the data values and equation numbers
       for (unsigned i = 0; i < initial_n_value; i++)
@@ -439,7 +440,8 @@ namespace oomph
       const unsigned n_tstorage = time_stepper_pt->ntstorage();
 
       // Allocate all the data values in one big array for data locality.
-      double* values = new double[n_value * n_tstorage];
+      double* values =
+        OutOfCoreStorage::allocate(n_value * n_tstorage, n_tstorage);
 
       // Copy the old "preserved" values into the new storage scheme
       // Make sure that we limit the values to the level of storage
@@ -456,7 +458,7 @@ namespace oomph
       }
 
       // Now delete the old value storage
-      delete[] Value[0];
+      OutOfCoreStorage::deallocate(Value[0]);
 
       // Reset the pointers to the new data values
       for (unsigned i = 0; i < n_value; i++)
@@ -1033,7 +1035,8 @@ namespace oomph
     long* eqn_number_new = new long[n_value_new];
 
     // Create new array of values that is contiguous in memory
-    double* values = new double[n_value_new * t_storage];
+    double* values =
+      OutOfCoreStorage::allocate(n_value_new * t_storage, t_storage);
 
     // Copy the old values over into the new storage scheme
     for (unsigned i = 0; i < n_value_old; i++)
@@ -1069,7 +1072,7 @@ namespace oomph
     Nvalue = n_value_new;
 
     // Now delete the old storage and set the new pointers
-    if (n_value_old != 0) delete[] Value[0];
+    if (n_value_old != 0) OutOfCoreStorage::deallocate(Value[0]);
     delete[] Value;
     Value = value_new_pt;
     delete[] Eqn_number;
@@ -1672,7 +1675,8 @@ namespace oomph
       X_position = new double*[n_storage];
 
       // Allocate the positions in one big array
-      double* x_positions = new double[n_storage * n_tstorage];
+      double* x_positions =
+        OutOfCoreStorage::allocate(n_storage * n_tstorage, n_tstorage);
 
       // Set the pointers to the contiguous memory
       for (unsigned j = 0; j < n_storage; j++)
@@ -1737,7 +1741,7 @@ namespace oomph
 
     // If we're still here we must free our own memory which was allocated
     // in one block
-    delete[] X_position[0];
+    OutOfCoreStorage::deallocate(X_position[0]);
 
     // Now delete the pointer
     delete[] X_position;
@@ -1776,7 +1780,8 @@ namespace oomph
     const unsigned n_tstorage = Position_time_stepper_pt->ntstorage();
 
     // Allocate all position data in one big array
-    double* x_positions = new double[n_storage * n_tstorage];
+    double* x_positions =
+      OutOfCoreStorage::allocate(n_storage * n_tstorage, n_tstorage);
 
     // If we have reduced the storage, reduce the size of preserved storage
     // to that of the new storage
@@ -1795,7 +1800,7 @@ namespace oomph
     }
 
     // Now delete the old position storage, which was allocated in one block
-    delete[] X_position[0];
+    OutOfCoreStorage::deallocate(X_position[0]);
 
     // Set the pointers to the contiguous memory
     for (unsigned j = 0; j < n_storage; j++)
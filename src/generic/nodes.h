@@ -49,6 +49,7 @@
 #include "Vector.h"
 #include "matrices.h"
 #include "oomph_utilities.h"
+#include "out_of_core_storage.h"
 
 namespace oomph
 {
@@ -2393,7 +2394,8 @@ namespace oomph
       this->Value = new double*[n_value];
 
       // Allocate all data values in one big array
-      double* values = new double[n_value * n_tstorage];
+      double* values =
+        OutOfCoreStorage::allocate(n_value * n_tstorage, n_tstorage);
 
       // Set the pointers to the data values and equation numbers
       for (unsigned i = 0; i < n_value; ++i)
@@ -0,0 +1,356 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline functions for fast formatting of numerical output
+
+#include <cmath>
+
+#include "numeric_output.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// Namespace for fast formatting of numerical output
+  //====================================================================
+  namespace NumericOutput
+  {
+    /// \short Use the fast formatting of doubles in Mesh::output(...)
+    /// etc.? Default: true
+    bool Use_fast_formatting = true;
+
+    /// \short Size (in bytes) of the buffer of a BufferedOfstream.
+    /// Default: 1MB
+    unsigned Output_buffer_size = 1048576;
+
+    /// \short Powers of ten that are exactly representable as doubles
+    const double Power_of_ten[23] = {
+      1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+      1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+      1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+
+    /// \short Helper function: Scale the (positive) double x by
+    /// 10^shift, using a single (correctly rounded) multiplication or
+    /// division. Returns false if 10^|shift| isn't exactly representable.
+    bool scale_by_power_of_ten(const double& x,
+                               const int& shift,
+                               double& scaled)
+    {
+      if (shift > 22 || shift < -22)
+      {
+        return false;
+      }
+      if (shift >= 0)
+      {
+        scaled = x * Power_of_ten[shift];
+      }
+      else
+      {
+        scaled = x / Power_of_ten[-shift];
+      }
+      return true;
+    }
+
+
+    //==================================================================
+    /// Format the double x in the way printf(...) does with
+    /// "%.[precision]g". We determine the decimal exponent e of x and
+    /// the integer m formed by its leading "precision" significant
+    /// digits (rounded to nearest) by scaling x with an exactly
+    /// representable power of ten. The scaling introduces a single
+    /// rounding error, so m is correct unless the scaled value is
+    /// within that error of a rounding boundary; in that case (and
+    /// for other cases we can't handle exactly) we return false.
+    //==================================================================
+    bool format_double(const double& x,
+                       const int& precision,
+                       char* buffer,
+                       unsigned& n_char)
+    {
+      n_char = 0;
+
+      // Infs and NaNs are left to the caller
+      if ((x != x) || (x - x != 0.0))
+      {
+        return false;
+      }
+
+      // Number of significant digits (printf uses one if zero is given)
+      int n_digit = precision;
+      if (n_digit == 0)
+      {
+        n_digit = 1;
+      }
+      if ((n_digit < 0) || (n_digit > 15))
+      {
+        return false;
+      }
+
+      // Sign
+      double abs_x = x;
+      if (std::signbit(x))
+      {
+        buffer[n_char++] = '-';
+        abs_x = -x;
+      }
+
+      // Zero
+      if (abs_x == 0.0)
+      {
+        buffer[n_char++] = '0';
+        return true;
+      }
+
+      // Estimate of the decimal exponent; correct it if required
+      int exponent = int(std::floor(std::log10(abs_x)));
+      double scaled = 0.0;
+      if (!scale_by_power_of_ten(abs_x, n_digit - 1 - exponent, scaled))
+      {
+        return false;
+      }
+      if (scaled < Power_of_ten[n_digit - 1])
+      {
+        exponent--;
+        if (!scale_by_power_of_ten(abs_x, n_digit - 1 - exponent, scaled))
+        {
+          return false;
+        }
+      }
+      else if (scaled >= Power_of_ten[n_digit])
+      {
+        exponent++;
+        if (!scale_by_power_of_ten(abs_x, n_digit - 1 - exponent, scaled))
+        {
+          return false;
+        }
+      }
+
+      // Round to nearest, unless we're too close to a tie to be sure
+      // which way the exact value rounds
+      double floor_scaled = std::floor(scaled);
+      double fraction = scaled - floor_scaled;
+      if (std::fabs(fraction - 0.5) <= 4.5e-16 * scaled)
+      {
+        return false;
+      }
+      unsigned long long mantissa = (unsigned long long)(floor_scaled);
+      if (fraction > 0.5)
+      {
+        mantissa++;
+      }
+
+      // Rounding up may have produced an extra digit
+      if (double(mantissa) >= Power_of_ten[n_digit])
+      {
+        mantissa /= 10;
+        exponent++;
+      }
+
+      // Extract the digits
+      char digit[16];
+      for (int i = n_digit - 1; i >= 0; i--)
+      {
+        digit[i] = char('0' + mantissa % 10);
+        mantissa /= 10;
+      }
+
+      // Trailing zeros are not shown
+      int n_significant = n_digit;
+      while ((n_significant > 1) && (digit[n_significant - 1] == '0'))
+      {
+        n_significant--;
+      }
+
+      // Fixed notation
+      if ((exponent >= -4) && (exponent < n_digit))
+      {
+        if (exponent >= 0)
+        {
+          for (int i = 0; i <= exponent; i++)
+          {
+            buffer[n_char++] = digit[i];
+          }
+          if (n_significant > exponent + 1)
+          {
+            buffer[n_char++] = '.';
+            for (int i = exponent + 1; i < n_significant; i++)
+            {
+              buffer[n_char++] = digit[i];
+            }
+          }
+        }
+        else
+        {
+          buffer[n_char++] = '0';
+          buffer[n_char++] = '.';
+          for (int i = 0; i < -exponent - 1; i++)
+          {
+            buffer[n_char++] = '0';
+          }
+          for (int i = 0; i < n_significant; i++)
+          {
+            buffer[n_char++] = digit[i];
+          }
+        }
+      }
+      // Scientific notation
+      else
+      {
+        buffer[n_char++] = digit[0];
+        if (n_significant > 1)
+        {
+          buffer[n_char++] = '.';
+          for (int i = 1; i < n_significant; i++)
+          {
+            buffer[n_char++] = digit[i];
+          }
+        }
+        buffer[n_char++] = 'e';
+        if (exponent < 0)
+        {
+          buffer[n_char++] = '-';
+          exponent = -exponent;
+        }
+        else
+        {
+          buffer[n_char++] = '+';
+        }
+        if (exponent >= 100)
+        {
+          buffer[n_char++] = char('0' + exponent / 100);
+        }
+        buffer[n_char++] = char('0' + (exponent / 10) % 10);
+        buffer[n_char++] = char('0' + exponent % 10);
+      }
+      return true;
+    }
+
+
+    //==================================================================
+    /// Format a double: Use format_double(...) if the stream's flags
+    /// select the default format, otherwise (or if format_double(...)
+    /// can't handle the value) use std::num_put.
+    //==================================================================
+    FastNumPut::iter_type FastNumPut::do_put(iter_type out,
+                                             std::ios_base& str,
+                                             char_type fill,
+                                             double v) const
+    {
+      std::ios_base::fmtflags special_flags =
+        std::ios_base::floatfield | std::ios_base::showpos |
+        std::ios_base::showpoint | std::ios_base::uppercase;
+      if (((str.flags() & special_flags) == 0) && (str.width() <= 0))
+      {
+        char buffer[32];
+        unsigned n_char = 0;
+        if (format_double(v, int(str.precision()), buffer, n_char))
+        {
+          for (unsigned i = 0; i < n_char; i++)
+          {
+            *out = buffer[i];
+            ++out;
+          }
+          return out;
+        }
+      }
+      return std::num_put<char>::do_put(out, str, fill, v);
+    }
+
+
+    //==================================================================
+    /// Constructor: Imbue the stream with the fast num_put facet
+    /// (unless disabled, already done, or the stream's locale
+    /// formats numbers differently)
+    //==================================================================
+    FastFormattingGuard::FastFormattingGuard(std::ostream& stream)
+      : Stream(stream), Original_locale(stream.getloc()), Locale_changed(false)
+    {
+      if (!Use_fast_formatting)
+      {
+        return;
+      }
+
+      // Already fast?
+      const std::num_put<char>& num_put =
+        std::use_facet<std::num_put<char>>(Original_locale);
+      if (dynamic_cast<const FastNumPut*>(&num_put) != 0)
+      {
+        return;
+      }
+
+      // Only use the fast formatting if the locale doesn't change the
+      // decimal point or group digits
+      const std::numpunct<char>& numpunct =
+        std::use_facet<std::numpunct<char>>(Original_locale);
+      if ((numpunct.decimal_point() != '.') || (!numpunct.grouping().empty()))
+      {
+        return;
+      }
+
+      // The locale takes ownership of the facet
+      Stream.imbue(std::locale(Original_locale, new FastNumPut));
+      Locale_changed = true;
+    }
+
+
+    //==================================================================
+    /// Destructor: Restore the stream's original locale
+    //==================================================================
+    FastFormattingGuard::~FastFormattingGuard()
+    {
+      if (Locale_changed)
+      {
+        Stream.imbue(Original_locale);
+      }
+    }
+
+
+    //==================================================================
+    /// Constructor: Set up the buffer and open the specified file
+    //==================================================================
+    BufferedOfstream::BufferedOfstream(const std::string& filename)
+      : std::ofstream(), Buffer(Output_buffer_size)
+    {
+      // The buffer has to be set before the file is opened
+      if (Output_buffer_size > 0)
+      {
+        rdbuf()->pubsetbuf(&Buffer[0], Output_buffer_size);
+      }
+      open(filename.c_str());
+    }
+
+
+    //==================================================================
+    /// Destructor: Close the file (flushing the buffer before it's
+    /// deleted)
+    //==================================================================
+    BufferedOfstream::~BufferedOfstream()
+    {
+      close();
+    }
+
+  } // namespace NumericOutput
+
+} // namespace oomph
@@ -0,0 +1,178 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for fast formatting of numerical (tecplot-style) output
+
+// Include guard to prevent multiple inclusions of the header
+#ifndef OOMPH_NUMERIC_OUTPUT_HEADER
+#define OOMPH_NUMERIC_OUTPUT_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+#include <fstream>
+#include <locale>
+#include <string>
+
+// oomph-lib includes
+#include "Vector.h"
+#include "oomph_utilities.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// Namespace for fast formatting of numerical output. The elements'
+  /// output(...) functions write their data with the stream operator
+  /// so the formatting of doubles dominates the cost of writing
+  /// tecplot-style output. We speed this up centrally by temporarily
+  /// imbuing the output stream with a locale whose num_put facet
+  /// formats doubles directly (see FastNumPut), and by giving output
+  /// files a large buffer (see BufferedOfstream).
+  //====================================================================
+  namespace NumericOutput
+  {
+    /// \short Use the fast formatting of doubles in Mesh::output(...)
+    /// etc.? Default: true
+    extern bool Use_fast_formatting;
+
+    /// \short Size (in bytes) of the buffer of a BufferedOfstream.
+    /// Default: 1MB
+    extern unsigned Output_buffer_size;
+
+    /// \short Format the double x in the way printf(...) does with
+    /// "%.[precision]g" (which is also the default format of the
+    /// stream operator), writing the characters into buffer (which must
+    /// provide at least 32 chars). The number of characters written is
+    /// returned in n_char. Returns false (and leaves the formatting to
+    /// the caller) if x can't be formatted exactly by the fast
+    /// algorithm, i.e. for infs and NaNs, precisions greater than 15,
+    /// very large or small magnitudes and values that are
+    /// (numerically) halfway between two possible outputs.
+    extern bool format_double(const double& x,
+                              const int& precision,
+                              char* buffer,
+                              unsigned& n_char);
+
+    //==================================================================
+    /// \short num_put facet that formats doubles with format_double(...)
+    /// if the stream's flags select the default format (no fixed/
+    /// scientific format, showpos, showpoint, uppercase or field
+    /// width). Everything else is left to std::num_put.
+    //==================================================================
+    class FastNumPut : public std::num_put<char>
+    {
+    public:
+      /// Constructor
+      FastNumPut() : std::num_put<char>() {}
+
+    protected:
+      /// Format a double
+      iter_type do_put(iter_type out,
+                       std::ios_base& str,
+                       char_type fill,
+                       double v) const;
+    };
+
+
+    //==================================================================
+    /// \short Imbue a stream with the FastNumPut facet for the lifetime
+    /// of this object; the stream's original locale is restored by the
+    /// destructor. Does nothing if Use_fast_formatting is false, if
+    /// the stream already uses a FastNumPut facet, or if its locale
+    /// doesn't use a plain '.' as the decimal point.
+    //==================================================================
+    class FastFormattingGuard
+    {
+    public:
+      /// Constructor: Imbue the stream with the fast num_put facet
+      FastFormattingGuard(std::ostream& stream);
+
+      /// Broken copy constructor
+      FastFormattingGuard(const FastFormattingGuard& dummy)
+        : Stream(dummy.Stream)
+      {
+        BrokenCopy::broken_copy("FastFormattingGuard");
+      }
+
+      /// Broken assignment operator
+      void operator=(const FastFormattingGuard&)
+      {
+        BrokenCopy::broken_assign("FastFormattingGuard");
+      }
+
+      /// Destructor: Restore the stream's original locale
+      ~FastFormattingGuard();
+
+    private:
+      /// The stream
+      std::ostream& Stream;
+
+      /// The stream's original locale
+      std::locale Original_locale;
+
+      /// Did we change the stream's locale?
+      bool Locale_changed;
+    };
+
+
+    //==================================================================
+    /// \short Output file stream with a large buffer (of size
+    /// Output_buffer_size) to reduce the number of write calls.
+    //==================================================================
+    class BufferedOfstream : public std::ofstream
+    {
+    public:
+      /// Constructor: Open the specified file
+      BufferedOfstream(const std::string& filename);
+
+      /// Broken copy constructor
+      BufferedOfstream(const BufferedOfstream& dummy)
+      {
+        BrokenCopy::broken_copy("BufferedOfstream");
+      }
+
+      /// Broken assignment operator
+      void operator=(const BufferedOfstream&)
+      {
+        BrokenCopy::broken_assign("BufferedOfstream");
+      }
+
+      /// \short Destructor: Close the file (flushing the buffer before
+      /// it's deleted)
+      ~BufferedOfstream();
+
+    private:
+      /// The buffer
+      Vector<char> Buffer;
+    };
+
+  } // namespace NumericOutput
+
+} // namespace oomph
+
+#endif
@@ -29,12 +29,17 @@
 
 #include <algorithm>
 #include <limits.h>
+#include <float.h>
 #include <cstring>
 
 #ifdef OOMPH_HAS_UNISTDH
 #include <unistd.h> // for getpid()
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "oomph_utilities.h"
 #include "Vector.h"
 #include "matrices.h"
@@ -985,8 +990,17 @@ namespace oomph
                          const bool& make_duplicate_of_mpi_comm_world)
   {
 #ifdef OOMPH_HAS_MPI
-    // call mpi int
+    // call mpi init
+#ifdef _OPENMP
+    // Each rank may use a pool of threads (see ThreadingHelpers) but
+    // MPI is only ever called from the master thread, so we need (at
+    // least) MPI_THREAD_FUNNELED
+    MPI_Init_thread(
+      &argc, &argv, MPI_THREAD_FUNNELED, &MPI_thread_support_level);
+#else
     MPI_Init(&argc, &argv);
+    MPI_thread_support_level = MPI_THREAD_SINGLE;
+#endif
 
 
     // By default, create the oomph-lib communicator using MPI_Comm_dup so that
@@ -1019,6 +1033,19 @@ namespace oomph
     // by its rank
     oomph_mpi_output.communicator_pt() = Communicator_pt;
     oomph_info.output_modifier_pt() = &oomph_mpi_output;
+
+#ifdef _OPENMP
+    // If the MPI library can't cope with threads, each rank has to make
+    // do with a single one
+    if (MPI_thread_support_level < MPI_THREAD_FUNNELED)
+    {
+      OomphLibWarning("MPI library does not provide MPI_THREAD_FUNNELED;\n"
+                      "using a single thread on each rank.",
+                      OOMPH_CURRENT_FUNCTION,
+                      OOMPH_EXCEPTION_LOCATION);
+      ThreadingHelpers::set_nthread(1);
+    }
+#endif
 #else
     // create a serial communicator
     Communicator_pt = new OomphCommunicator;
@@ -1088,6 +1115,9 @@ namespace oomph
 
   bool MPI_Helpers::MPI_has_been_initialised = false;
   OomphCommunicator* MPI_Helpers::Communicator_pt = 0;
+#ifdef OOMPH_HAS_MPI
+  int MPI_Helpers::MPI_thread_support_level = MPI_THREAD_SINGLE;
+#endif
 
 
   //====================================================================
@@ -1309,6 +1339,63 @@ namespace oomph
   } // end of namespace TimingHelpers
 
 
+  //=============================================================================
+  /// Helpers for the hybrid MPI+threads execution model
+  //=============================================================================
+  namespace ThreadingHelpers
+  {
+    /// \short Threaded loops are only worth it if they have at least
+    /// this many iterations; shorter loops are executed serially.
+    unsigned long Min_loop_length_for_threading = 1000;
+
+    /// Set the number of threads used by each MPI rank
+    void set_nthread(const unsigned& n_thread)
+    {
+#ifdef PARANOID
+      if (n_thread == 0)
+      {
+        throw OomphLibError("Number of threads must be positive",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+#ifdef _OPENMP
+      omp_set_num_threads(n_thread);
+#else
+      if (n_thread > 1)
+      {
+        OomphLibWarning("Library was built without OpenMP support; "
+                        "ignoring request for more than one thread.",
+                        OOMPH_CURRENT_FUNCTION,
+                        OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+    }
+
+    /// Number of threads used by each MPI rank
+    unsigned nthread()
+    {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    /// \short Id of the calling thread within the rank's thread pool
+    /// (zero if called outside a parallel region)
+    unsigned thread_id()
+    {
+#ifdef _OPENMP
+      return omp_get_thread_num();
+#else
+      return 0;
+#endif
+    }
+
+  } // end of namespace ThreadingHelpers
+
+
   ////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////
@@ -1651,4 +1738,366 @@ namespace oomph
   } // end of namespace MemoryUsage
 
 
+  ////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////
+
+
+  //===============================================================
+  /// Namespace for the runtime instrumentation of the communication
+  /// in distributed problems
+  //===============================================================
+  namespace CommunicationStatistics
+  {
+    /// Boolean to switch on the collection of the communication statistics
+    bool Collect_communication_statistics = false;
+
+    /// \short Boolean to indicate that doc_statistics(...) is to
+    /// document the statistics for each processor
+    bool Doc_statistics_for_each_processor = false;
+
+    /// \short String containing the name of the file to which
+    /// doc_statistics(const std::string&) appends the statistics
+    std::string Statistics_filename = "communication_statistics.dat";
+
+    /// Number of bytes sent in each phase
+    Vector<unsigned long> Nbyte_sent(Ncommunication_phase, 0);
+
+    /// Number of bytes received in each phase
+    Vector<unsigned long> Nbyte_received(Ncommunication_phase, 0);
+
+    /// Number of point-to-point messages sent in each phase
+    Vector<unsigned long> Nmessage_sent(Ncommunication_phase, 0);
+
+    /// Number of point-to-point messages received in each phase
+    Vector<unsigned long> Nmessage_received(Ncommunication_phase, 0);
+
+    /// Number of collective operations in each phase
+    Vector<unsigned long> Ncollective(Ncommunication_phase, 0);
+
+    /// Time spent waiting for the communication in each phase
+    Vector<double> Wait_time(Ncommunication_phase, 0.0);
+
+    /// Record messages sent by this processor
+    void record_send(const unsigned& phase,
+                     const unsigned long& n_byte,
+                     const unsigned& n_message)
+    {
+      if (Collect_communication_statistics)
+      {
+        Nbyte_sent[phase] += n_byte;
+        Nmessage_sent[phase] += n_message;
+      }
+    }
+
+    /// Record messages received by this processor
+    void record_receive(const unsigned& phase,
+                        const unsigned long& n_byte,
+                        const unsigned& n_message)
+    {
+      if (Collect_communication_statistics)
+      {
+        Nbyte_received[phase] += n_byte;
+        Nmessage_received[phase] += n_message;
+      }
+    }
+
+    /// Record a collective operation
+    void record_collective(const unsigned& phase,
+                           const unsigned long& n_byte_sent,
+                           const unsigned long& n_byte_received)
+    {
+      if (Collect_communication_statistics)
+      {
+        Nbyte_sent[phase] += n_byte_sent;
+        Nbyte_received[phase] += n_byte_received;
+        Ncollective[phase]++;
+      }
+    }
+
+    /// Record time spent waiting for the communication
+    void record_wait_time(const unsigned& phase, const double& t_wait)
+    {
+      if (Collect_communication_statistics)
+      {
+        Wait_time[phase] += t_wait;
+      }
+    }
+
+    /// Name of the specified phase
+    std::string phase_name(const unsigned& phase)
+    {
+      switch (phase)
+      {
+        case Halo_synchronisation:
+          return "halo_synchronisation";
+        case External_halo_synchronisation:
+          return "external_halo_synchronisation";
+        case Vector_redistribution:
+          return "vector_redistribution";
+        case Load_balancing:
+          return "load_balancing";
+        case Halo_vector_synchronisation:
+          return "halo_vector_synchronisation";
+        case Equation_number_synchronisation:
+          return "equation_number_synchronisation";
+        case Multi_domain_interaction:
+          return "multi_domain_interaction";
+        default:
+          std::ostringstream error_stream;
+          error_stream << "Unknown communication phase " << phase << std::endl;
+          throw OomphLibError(error_stream.str(),
+                              OOMPH_CURRENT_FUNCTION,
+                              OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+
+    /// Number of bytes sent in the specified phase
+    unsigned long nbyte_sent(const unsigned& phase)
+    {
+      return Nbyte_sent[phase];
+    }
+
+    /// Number of bytes received in the specified phase
+    unsigned long nbyte_received(const unsigned& phase)
+    {
+      return Nbyte_received[phase];
+    }
+
+    /// Number of point-to-point messages sent in the specified phase
+    unsigned long nmessage_sent(const unsigned& phase)
+    {
+      return Nmessage_sent[phase];
+    }
+
+    /// Number of point-to-point messages received in the specified phase
+    unsigned long nmessage_received(const unsigned& phase)
+    {
+      return Nmessage_received[phase];
+    }
+
+    /// Number of collective operations in the specified phase
+    unsigned long ncollective(const unsigned& phase)
+    {
+      return Ncollective[phase];
+    }
+
+    /// Time spent waiting for the communication in the specified phase
+    double wait_time(const unsigned& phase)
+    {
+      return Wait_time[phase];
+    }
+
+    /// Reset all statistics
+    void reset()
+    {
+      for (unsigned i = 0; i < Ncommunication_phase; i++)
+      {
+        Nbyte_sent[i] = 0;
+        Nbyte_received[i] = 0;
+        Nmessage_sent[i] = 0;
+        Nmessage_received[i] = 0;
+        Ncollective[i] = 0;
+        Wait_time[i] = 0.0;
+      }
+    }
+
+    //===============================================================
+    /// Doc the statistics accumulated since the last reset, prepended
+    /// by string. Must be called on all processors in distributed runs.
+    //===============================================================
+    void doc_statistics(std::ostream& outfile,
+                        const std::string& prefix_string,
+                        const bool& reset_statistics)
+    {
+      // Number of quantities per phase
+      const unsigned n_quantity = 6;
+      const char* quantity_name[] = {"bytes_sent",
+                                     "bytes_received",
+                                     "messages_sent",
+                                     "messages_received",
+                                     "collectives",
+                                     "wait_time"};
+
+      // My statistics (flat packed)
+      Vector<double> my_data(n_quantity * Ncommunication_phase);
+      for (unsigned i = 0; i < Ncommunication_phase; i++)
+      {
+        my_data[n_quantity * i] = double(Nbyte_sent[i]);
+        my_data[n_quantity * i + 1] = double(Nbyte_received[i]);
+        my_data[n_quantity * i + 2] = double(Nmessage_sent[i]);
+        my_data[n_quantity * i + 3] = double(Nmessage_received[i]);
+        my_data[n_quantity * i + 4] = double(Ncollective[i]);
+        my_data[n_quantity * i + 5] = Wait_time[i];
+      }
+
+      // Gather everybody's statistics on the root
+      int n_proc = 1;
+      int my_rank = 0;
+      Vector<double> all_data(my_data);
+#ifdef OOMPH_HAS_MPI
+      if (MPI_Helpers::mpi_has_been_initialised())
+      {
+        n_proc = MPI_Helpers::communicator_pt()->nproc();
+        my_rank = MPI_Helpers::communicator_pt()->my_rank();
+        if (n_proc > 1)
+        {
+          int n_data = my_data.size();
+          all_data.resize(n_data * n_proc);
+          MPI_Gather(&my_data[0],
+                     n_data,
+                     MPI_DOUBLE,
+                     &all_data[0],
+                     n_data,
+                     MPI_DOUBLE,
+                     0,
+                     MPI_Helpers::communicator_pt()->mpi_comm());
+        }
+      }
+#endif
+
+      if (my_rank == 0)
+      {
+        for (unsigned i = 0; i < Ncommunication_phase; i++)
+        {
+          outfile << prefix_string << " " << phase_name(i) << ":";
+          for (unsigned q = 0; q < n_quantity; q++)
+          {
+            double min = DBL_MAX;
+            double max = -DBL_MAX;
+            double sum = 0.0;
+            for (int p = 0; p < n_proc; p++)
+            {
+              double value =
+                all_data[n_quantity * (p * Ncommunication_phase + i) + q];
+              min = std::min(min, value);
+              max = std::max(max, value);
+              sum += value;
+            }
+            double average = sum / double(n_proc);
+            outfile << " " << quantity_name[q] << " [min/avg/max]: " << min
+                    << " " << average << " " << max;
+
+            // Imbalance of the wait times
+            if (q == n_quantity - 1)
+            {
+              double imbalance = 1.0;
+              if (average > 0.0)
+              {
+                imbalance = max / average;
+              }
+              outfile << " wait_time_imbalance: " << imbalance;
+            }
+          }
+          outfile << std::endl;
+
+          // Doc individual processors
+          if (Doc_statistics_for_each_processor)
+          {
+            for (int p = 0; p < n_proc; p++)
+            {
+              outfile << prefix_string << " " << phase_name(i)
+                      << " processor " << p << ":";
+              for (unsigned q = 0; q < n_quantity; q++)
+              {
+                outfile
+                  << " " << quantity_name[q] << ": "
+                  << all_data[n_quantity * (p * Ncommunication_phase + i) + q];
+              }
+              outfile << std::endl;
+            }
+          }
+        }
+      }
+
+      if (reset_statistics)
+      {
+        reset();
+      }
+    }
+
+    //===============================================================
+    /// Doc the statistics by appending them to the file whose name is
+    /// specified by Statistics_filename. Must be called on all
+    /// processors in distributed runs.
+    //===============================================================
+    void doc_statistics(const std::string& prefix_string,
+                        const bool& reset_statistics)
+    {
+      std::ofstream outfile;
+      bool is_root = true;
+#ifdef OOMPH_HAS_MPI
+      if (MPI_Helpers::mpi_has_been_initialised())
+      {
+        is_root = (MPI_Helpers::communicator_pt()->my_rank() == 0);
+      }
+#endif
+      if (is_root)
+      {
+        outfile.open(Statistics_filename.c_str(), std::ios_base::app);
+      }
+      doc_statistics(outfile, prefix_string, reset_statistics);
+      if (is_root)
+      {
+        outfile.close();
+      }
+    }
+
+    //===============================================================
+    /// Empty the file whose name is specified by Statistics_filename
+    //===============================================================
+    void empty_statistics_file()
+    {
+      bool is_root = true;
+#ifdef OOMPH_HAS_MPI
+      if (MPI_Helpers::mpi_has_been_initialised())
+      {
+        is_root = (MPI_Helpers::communicator_pt()->my_rank() == 0);
+      }
+#endif
+      if (is_root)
+      {
+        std::ofstream outfile;
+        outfile.open(Statistics_filename.c_str());
+        outfile.close();
+      }
+    }
+
+  } // end of namespace CommunicationStatistics
+
+
+  ////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////
+
+
+  //===============================================================
+  /// Namespace for (64 bit FNV-1a) checksums used to validate
+  /// binary data, e.g. in restart files
+  //===============================================================
+  namespace Checksum
+  {
+    /// Initial value of the checksum (FNV offset basis)
+    const unsigned long long Initial_value = 14695981039346656037ULL;
+
+    /// \short Update the checksum with n_byte bytes of data, starting
+    /// at data_pt
+    void update(unsigned long long& checksum,
+                const void* data_pt,
+                const unsigned long& n_byte)
+    {
+      // FNV prime
+      const unsigned long long prime = 1099511628211ULL;
+      const unsigned char* byte_pt =
+        reinterpret_cast<const unsigned char*>(data_pt);
+      for (unsigned long i = 0; i < n_byte; i++)
+      {
+        checksum ^= byte_pt[i];
+        checksum *= prime;
+      }
+    }
+
+  } // end of namespace Checksum
+
+
 } // namespace oomph
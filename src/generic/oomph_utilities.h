@@ -853,6 +853,15 @@ namespace oomph
       return MPI_has_been_initialised;
     }
 
+#ifdef OOMPH_HAS_MPI
+    /// \short Level of thread support provided by the MPI library (as
+    /// returned by MPI_Init_thread(...) in init(...))
+    static int mpi_thread_support_level()
+    {
+      return MPI_thread_support_level;
+    }
+#endif
+
   private:
     /// \short private default constructor definition (to prevent instances of
     /// the class being instantiated)
@@ -867,6 +876,11 @@ namespace oomph
 
     /// the global communicator
     static OomphCommunicator* Communicator_pt;
+
+#ifdef OOMPH_HAS_MPI
+    /// Level of thread support provided by the MPI library
+    static int MPI_thread_support_level;
+#endif
   };
 
 
@@ -955,6 +969,46 @@ namespace oomph
   } // end of namespace TimingHelpers
 
 
+  //=============================================================================
+  /// \short Helpers for the hybrid MPI+threads execution model: each
+  /// MPI rank may use a pool of (OpenMP) threads in the compute
+  /// kernels (element assembly, sparse matrix-vector products, vector
+  /// operations and simple preconditioners). Halo structures etc. remain
+  /// per rank. If the library is built without OpenMP support all
+  /// functions are no-ops and the number of threads is always one.
+  //=============================================================================
+  namespace ThreadingHelpers
+  {
+    /// \short Set the number of threads used by each MPI rank. Default
+    /// is the number provided by the OpenMP runtime (i.e. controlled by
+    /// OMP_NUM_THREADS).
+    void set_nthread(const unsigned& n_thread);
+
+    /// Number of threads used by each MPI rank
+    unsigned nthread();
+
+    /// \short Id of the calling thread within the rank's thread pool
+    /// (zero if called outside a parallel region)
+    unsigned thread_id();
+
+    /// \short Threaded loops are only worth it if they have at least
+    /// this many iterations; shorter loops are executed serially.
+    extern unsigned long Min_loop_length_for_threading;
+
+    /// \short Should a loop of the specified length be executed with
+    /// multiple threads?
+    inline bool use_threads(const unsigned long& n)
+    {
+#ifdef _OPENMP
+      return (n >= Min_loop_length_for_threading) && (nthread() > 1);
+#else
+      return false;
+#endif
+    }
+
+  } // end of namespace ThreadingHelpers
+
+
   ////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////
@@ -1085,6 +1139,167 @@ namespace oomph
   } // end of namespace MemoryUsage
 
 
+  ////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////
+
+
+  //===============================================================
+  /// \short Namespace for the runtime instrumentation of the
+  /// communication in distributed problems: the number of bytes and
+  /// messages sent and received by this processor, the number of
+  /// collective operations and the time spent waiting for the
+  /// communication to complete, accumulated separately for each of the
+  /// communication phases listed in Communication_phase. Collection is
+  /// switched off by default (when all functions that record data return
+  /// immediately). Typical use: Set Collect_communication_statistics to
+  /// true and call doc_statistics(...) (on all processors) after each
+  /// timestep.
+  //===============================================================
+  namespace CommunicationStatistics
+  {
+    /// Enumeration of the instrumented communication phases
+    enum Communication_phase
+    {
+      Halo_synchronisation,
+      External_halo_synchronisation,
+      Vector_redistribution,
+      Load_balancing,
+      Halo_vector_synchronisation,
+      Equation_number_synchronisation,
+      Multi_domain_interaction,
+      Ncommunication_phase
+    };
+
+    /// \short Boolean to switch on the collection of the communication
+    /// statistics. Default: false.
+    extern bool Collect_communication_statistics;
+
+    /// \short Boolean to indicate that doc_statistics(...) is to
+    /// document the statistics for each processor, rather than just their
+    /// min/average/max over all processors. Default: false.
+    extern bool Doc_statistics_for_each_processor;
+
+    /// \short String containing the name of the file to which
+    /// doc_statistics(const std::string&) appends the statistics
+    extern std::string Statistics_filename;
+
+    /// \short Record n_message (point-to-point) messages, containing a
+    /// total of n_byte bytes, sent by this processor in the specified phase
+    void record_send(const unsigned& phase,
+                     const unsigned long& n_byte,
+                     const unsigned& n_message = 1);
+
+    /// \short Record n_message (point-to-point) messages, containing a
+    /// total of n_byte bytes, received by this processor in the specified
+    /// phase
+    void record_receive(const unsigned& phase,
+                        const unsigned long& n_byte,
+                        const unsigned& n_message = 1);
+
+    /// \short Record a collective operation in the specified phase in
+    /// which this processor contributed n_byte_sent bytes and received
+    /// n_byte_received bytes
+    void record_collective(const unsigned& phase,
+                           const unsigned long& n_byte_sent,
+                           const unsigned long& n_byte_received);
+
+    /// \short Record time spent waiting for the communication (in
+    /// MPI_Waitall, collectives or other blocking calls) in the specified
+    /// phase
+    void record_wait_time(const unsigned& phase, const double& t_wait);
+
+    /// \short Current time (as returned by TimingHelpers::timer()) if the
+    /// statistics are being collected; zero otherwise (so timing the
+    /// communication costs nothing unless it's required)
+    inline double timer()
+    {
+      if (Collect_communication_statistics)
+      {
+        return TimingHelpers::timer();
+      }
+      return 0.0;
+    }
+
+    /// Name of the specified phase
+    std::string phase_name(const unsigned& phase);
+
+    /// \short Number of bytes sent by this processor in the specified
+    /// phase (in point-to-point messages and collectives)
+    unsigned long nbyte_sent(const unsigned& phase);
+
+    /// \short Number of bytes received by this processor in the specified
+    /// phase (in point-to-point messages and collectives)
+    unsigned long nbyte_received(const unsigned& phase);
+
+    /// \short Number of point-to-point messages sent by this processor in
+    /// the specified phase
+    unsigned long nmessage_sent(const unsigned& phase);
+
+    /// \short Number of point-to-point messages received by this processor
+    /// in the specified phase
+    unsigned long nmessage_received(const unsigned& phase);
+
+    /// \short Number of collective operations this processor participated
+    /// in during the specified phase
+    unsigned long ncollective(const unsigned& phase);
+
+    /// \short Time this processor spent waiting for the communication in
+    /// the specified phase
+    double wait_time(const unsigned& phase);
+
+    /// Reset all statistics
+    void reset();
+
+    /// \short Doc the statistics accumulated since the last reset,
+    /// prepended by string (which allows identification of the timestep,
+    /// say): For each phase, we document the min/average/max of the
+    /// quantities over all processors (and their values on each processor
+    /// if Doc_statistics_for_each_processor is true). The ratio of max.
+    /// to average wait time provides a measure of the imbalance. Must be
+    /// called on all processors (of oomph-lib's global communicator)
+    /// in distributed runs; output is only written on the root processor.
+    /// The statistics are reset afterwards unless reset_statistics is
+    /// false.
+    void doc_statistics(std::ostream& outfile,
+                        const std::string& prefix_string = "",
+                        const bool& reset_statistics = true);
+
+    /// \short Doc the statistics (as in the previous version) by appending
+    /// them to the file whose name is specified by Statistics_filename
+    void doc_statistics(const std::string& prefix_string = "",
+                        const bool& reset_statistics = true);
+
+    /// \short Function to empty the file whose name is specified by
+    /// Statistics_filename (on the root processor)
+    void empty_statistics_file();
+
+  } // end of namespace CommunicationStatistics
+
+
+  ////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////
+
+
+  //===============================================================
+  /// \short Namespace for (64 bit FNV-1a) checksums used to validate
+  /// binary data, e.g. in restart files
+  //===============================================================
+  namespace Checksum
+  {
+    /// Initial value of the checksum (FNV offset basis)
+    extern const unsigned long long Initial_value;
+
+    /// \short Update the checksum with n_byte bytes of data, starting
+    /// at data_pt
+    extern void update(unsigned long long& checksum,
+                       const void* data_pt,
+                       const unsigned long& n_byte);
+
+  } // end of namespace Checksum
+
+
   ////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////
@@ -0,0 +1,360 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline functions for memory-mapped (out-of-core) storage of the
+// values of Data with many time levels
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define OOMPH_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Vector.h"
+#include "oomph_utilities.h"
+#include "out_of_core_storage.h"
+
+
+namespace oomph
+{
+  //====================================================================
+  /// Namespace for the out-of-core storage of the values of Data with
+  /// many time levels. Blocks are carved sequentially out of memory
+  /// mapped files ("chunks"); each block is preceded by a double that
+  /// stores its length so deallocate(...) can put it onto the free list
+  /// for blocks of that length. (Data objects only come in a few
+  /// different sizes, so the free blocks are reused quickly.) None of
+  /// this is protected by locks.
+  //====================================================================
+  namespace OutOfCoreStorage
+  {
+    /// \short Size (in bytes) of the memory mapped files that
+    /// blocks are allocated from. Default: 256MB
+    unsigned long Chunk_size = 268435456;
+
+    /// \short Boolean to indicate that the out-of-core storage is to
+    /// be released from the resident memory after the assembly of the
+    /// sparse Jacobian (i.e. during the linear solve). Default: true.
+    bool Release_resident_memory_after_assembly = true;
+
+    /// Is the out-of-core storage enabled?
+    bool Enabled = false;
+
+    /// Directory for the memory mapped files
+    std::string Directory = ".";
+
+    /// Minimum number of time levels for out-of-core storage
+    unsigned Min_ntstorage = 4;
+
+    /// Start of the memory mapped chunks
+    Vector<char*> Chunk_start;
+
+    /// Sizes (in bytes) of the memory mapped chunks
+    Vector<unsigned long> Chunk_nbyte;
+
+    /// Number of bytes used in the most recent chunk
+    unsigned long Nbyte_used_in_last_chunk = 0;
+
+    /// Number of blocks that are currently allocated out-of-core
+    unsigned long Nlive_block = 0;
+
+    /// Free blocks, accessed by their length
+    std::map<unsigned long, Vector<double*>> Free_block;
+
+    /// \short Has the storage been dropped from the resident memory by
+    /// release_resident_memory() since the last prefetch?
+    bool Resident_memory_has_been_released = false;
+
+
+    //==================================================================
+    /// Enable the out-of-core storage
+    //==================================================================
+    void enable(const std::string& directory, const unsigned& min_ntstorage)
+    {
+#ifdef OOMPH_HAS_MMAP
+      Directory = directory;
+      Min_ntstorage = min_ntstorage;
+      Enabled = true;
+#else
+      OomphLibWarning("Out-of-core storage requires mmap which isn't "
+                      "available on this system.\n"
+                      "The values will be stored on the heap.\n",
+                      OOMPH_CURRENT_FUNCTION,
+                      OOMPH_EXCEPTION_LOCATION);
+#endif
+    }
+
+
+#ifdef OOMPH_HAS_MMAP
+    //==================================================================
+    /// Helper function: Unmap all chunks (once they're no longer used)
+    //==================================================================
+    void unmap_chunks()
+    {
+      unsigned n_chunk = Chunk_start.size();
+      for (unsigned c = 0; c < n_chunk; c++)
+      {
+        munmap(Chunk_start[c], Chunk_nbyte[c]);
+      }
+      Chunk_start.clear();
+      Chunk_nbyte.clear();
+      Nbyte_used_in_last_chunk = 0;
+      Free_block.clear();
+      Resident_memory_has_been_released = false;
+    }
+
+
+    //==================================================================
+    /// Helper function: Map a new chunk of (at least) the specified
+    /// size. The file is deleted straightaway; its storage is freed when
+    /// it's unmapped. Returns false if this fails (e.g. because the
+    /// directory doesn't exist or the disk is full).
+    //==================================================================
+    bool add_chunk(const unsigned long& min_nbyte)
+    {
+      // Round up to a multiple of the page size
+      unsigned long page_size = sysconf(_SC_PAGESIZE);
+      unsigned long nbyte = std::max(Chunk_size, min_nbyte);
+      nbyte = ((nbyte + page_size - 1) / page_size) * page_size;
+
+      std::string filename_template =
+        Directory + "/oomph_out_of_core_storage_XXXXXX";
+      unsigned n_char = filename_template.size();
+      Vector<char> filename(n_char + 1, '\0');
+      for (unsigned i = 0; i < n_char; i++)
+      {
+        filename[i] = filename_template[i];
+      }
+      int file_descriptor = mkstemp(&filename[0]);
+      if (file_descriptor < 0)
+      {
+        return false;
+      }
+      unlink(&filename[0]);
+
+      // Reserve the disk space now: We'd get a SIGBUS when writing to
+      // the mapped memory if we ran out of disk space later
+      bool success = (ftruncate(file_descriptor, nbyte) == 0);
+#ifdef __linux__
+      success = success && (posix_fallocate(file_descriptor, 0, nbyte) == 0);
+#endif
+      void* map_pt = MAP_FAILED;
+      if (success)
+      {
+        map_pt = mmap(0,
+                      nbyte,
+                      PROT_READ | PROT_WRITE,
+                      MAP_SHARED,
+                      file_descriptor,
+                      0);
+      }
+      close(file_descriptor);
+      if (map_pt == MAP_FAILED)
+      {
+        return false;
+      }
+
+      Chunk_start.push_back(static_cast<char*>(map_pt));
+      Chunk_nbyte.push_back(nbyte);
+      Nbyte_used_in_last_chunk = 0;
+      return true;
+    }
+#endif
+
+
+    //==================================================================
+    /// Disable the out-of-core storage for subsequent allocations
+    //==================================================================
+    void disable()
+    {
+      Enabled = false;
+#ifdef OOMPH_HAS_MMAP
+      if (Nlive_block == 0)
+      {
+        unmap_chunks();
+      }
+#endif
+    }
+
+
+    //==================================================================
+    /// Is the out-of-core storage enabled?
+    //==================================================================
+    bool is_enabled()
+    {
+      return Enabled;
+    }
+
+
+    //==================================================================
+    /// Allocate an array of n_double doubles, out-of-core if enabled
+    /// and if there are enough time levels; on the heap otherwise.
+    //==================================================================
+    double* allocate(const unsigned long& n_double, const unsigned& n_tstorage)
+    {
+#ifdef OOMPH_HAS_MMAP
+      if (Enabled && (n_tstorage >= Min_ntstorage) && (n_double > 0))
+      {
+        // Recycle a free block of the same length if possible
+        std::map<unsigned long, Vector<double*>>::iterator it =
+          Free_block.find(n_double);
+        if ((it != Free_block.end()) && (!it->second.empty()))
+        {
+          double* block_pt = it->second.back();
+          it->second.pop_back();
+          Nlive_block++;
+          return block_pt;
+        }
+
+        // Carve a new block (preceded by its length) out of the
+        // most recent chunk; map a new one if it's full
+        unsigned long nbyte = (n_double + 1) * sizeof(double);
+        bool have_space = (!Chunk_start.empty()) &&
+                          (Nbyte_used_in_last_chunk + nbyte <=
+                           Chunk_nbyte[Chunk_start.size() - 1]);
+        if (!have_space)
+        {
+          have_space = add_chunk(nbyte);
+          if (!have_space)
+          {
+            std::ostringstream warning_stream;
+            warning_stream << "Couldn't create a memory mapped file in "
+                           << Directory << ".\n"
+                           << "Disabling the out-of-core storage; the values"
+                           << " will be stored on the heap.\n";
+            OomphLibWarning(warning_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+            Enabled = false;
+          }
+        }
+        if (have_space)
+        {
+          double* header_pt = reinterpret_cast<double*>(
+            Chunk_start[Chunk_start.size() - 1] + Nbyte_used_in_last_chunk);
+          Nbyte_used_in_last_chunk += nbyte;
+          header_pt[0] = double(n_double);
+          Nlive_block++;
+          return header_pt + 1;
+        }
+      }
+#endif
+
+      // Heap storage
+      return new double[n_double];
+    }
+
+
+    //==================================================================
+    /// Free an array allocated by allocate(...)
+    //==================================================================
+    void deallocate(double* const& block_pt)
+    {
+      if (block_pt == 0)
+      {
+        return;
+      }
+
+#ifdef OOMPH_HAS_MMAP
+      // Is the block in one of the chunks?
+      char* char_pt = reinterpret_cast<char*>(block_pt);
+      unsigned n_chunk = Chunk_start.size();
+      for (unsigned c = 0; c < n_chunk; c++)
+      {
+        if ((char_pt >= Chunk_start[c]) &&
+            (char_pt < Chunk_start[c] + Chunk_nbyte[c]))
+        {
+          // Put it onto the free list for blocks of its length
+          unsigned long n_double = (unsigned long)(block_pt[-1]);
+          Free_block[n_double].push_back(block_pt);
+          Nlive_block--;
+
+          // Unmap the chunks if they're no longer required
+          if ((Nlive_block == 0) && (!Enabled))
+          {
+            unmap_chunks();
+          }
+          return;
+        }
+      }
+#endif
+
+      // Heap storage
+      delete[] block_pt;
+    }
+
+
+    //==================================================================
+    /// Advise the operating system that the out-of-core storage will
+    /// be accessed shortly (only needed following an explicit release
+    /// of the resident memory)
+    //==================================================================
+    void prefetch()
+    {
+#ifdef OOMPH_HAS_MMAP
+      if (!Resident_memory_has_been_released)
+      {
+        return;
+      }
+      Resident_memory_has_been_released = false;
+
+      unsigned n_chunk = Chunk_start.size();
+      for (unsigned c = 0; c < n_chunk; c++)
+      {
+        madvise(Chunk_start[c], Chunk_nbyte[c], MADV_WILLNEED);
+      }
+#endif
+    }
+
+
+    //==================================================================
+    /// Drop the out-of-core storage from the resident memory. The
+    /// mappings are shared, so modified pages are retained in the
+    /// files (and the page cache) rather than discarded.
+    //==================================================================
+    void release_resident_memory()
+    {
+#ifdef OOMPH_HAS_MMAP
+      unsigned n_chunk = Chunk_start.size();
+      for (unsigned c = 0; c < n_chunk; c++)
+      {
+        // Start writing back the modified pages so the operating
+        // system can evict them cheaply
+        msync(Chunk_start[c], Chunk_nbyte[c], MS_ASYNC);
+        madvise(Chunk_start[c], Chunk_nbyte[c], MADV_DONTNEED);
+      }
+      Resident_memory_has_been_released = (n_chunk != 0);
+#endif
+    }
+
+  } // namespace OutOfCoreStorage
+
+} // namespace oomph
@@ -0,0 +1,140 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for memory-mapped (out-of-core) storage of the values of
+// Data with many time levels
+
+// Include guard to prevent multiple inclusions of the header
+#ifndef OOMPH_OUT_OF_CORE_STORAGE_HEADER
+#define OOMPH_OUT_OF_CORE_STORAGE_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+#include <string>
+
+
+namespace oomph
+{
+  //====================================================================
+  /// \short Namespace for the out-of-core storage of the values (and
+  /// positions) of Data (and Nodes) with many time levels, as required
+  /// by multi-step timesteppers such as BDF<4> or Newmark. Once enabled,
+  /// the value arrays of any Data whose timestepper stores at least
+  /// min_ntstorage time levels are allocated in memory mapped files in
+  /// the specified directory (ideally on a fast local disk) rather than
+  /// on the heap.
+  ///
+  /// NOTE: Data stores all time levels of a value contiguously, so
+  /// the entire value array -- including the current values that are
+  /// accessed during every assembly -- is stored in the files, not just
+  /// the history values. The storage therefore doesn't reduce the
+  /// memory footprint by itself; the pages have to be dropped from the
+  /// resident memory when the Data isn't being accessed. This is done
+  /// automatically during the linear solves, which is usually when the
+  /// memory is needed most (for the matrix and its factorisation): The
+  /// storage is released once the sparse Jacobian has been assembled by
+  /// Problem::get_jacobian(...), and prefetch()-ed after the linear solve
+  /// in Problem::newton_solve(). (This can be switched off with
+  /// Release_resident_memory_after_assembly, e.g. if the linear solves
+  /// need little memory, because every release writes the modified pages
+  /// back to the files.) release_resident_memory() may also be called
+  /// explicitly in other phases of the computation that don't touch the
+  /// Data; following a release, the pages are read back in when they're
+  /// next accessed, or in bulk by the next prefetch() (called by
+  /// Problem::shift_time_values()).
+  ///
+  /// Notes:
+  /// - The option has to be enabled before the meshes are built. Data
+  ///   that was allocated before remains on the heap.
+  /// - The files are deleted as soon as they're mapped, so no clean-up
+  ///   is required if the code terminates prematurely.
+  /// - All functions in this namespace modify global state (the chunks
+  ///   and the free lists) without locking, so they're not thread-safe.
+  ///   Data must not be created, resized or deleted concurrently
+  ///   while the out-of-core storage is in use.
+  /// - Only available on systems that support mmap; enable() issues a
+  ///   warning and does nothing otherwise.
+  //====================================================================
+  namespace OutOfCoreStorage
+  {
+    /// \short Size (in bytes) of the memory mapped files that
+    /// blocks are allocated from. Default: 256MB
+    extern unsigned long Chunk_size;
+
+    /// \short Boolean to indicate that the out-of-core storage is to
+    /// be released from the resident memory after the assembly of the
+    /// sparse Jacobian (i.e. during the linear solve). Default: true.
+    extern bool Release_resident_memory_after_assembly;
+
+    /// \short Enable the out-of-core storage: The value arrays of
+    /// subsequently created (or resized) Data whose timestepper stores
+    /// at least min_ntstorage time levels are allocated in memory mapped
+    /// files in the specified directory.
+    extern void enable(const std::string& directory,
+                       const unsigned& min_ntstorage = 4);
+
+    /// \short Disable the out-of-core storage for subsequent allocations.
+    /// Existing blocks remain valid; the files are unmapped once all of
+    /// them have been deallocated.
+    extern void disable();
+
+    /// Is the out-of-core storage enabled?
+    extern bool is_enabled();
+
+    /// \short Allocate an array of n_double doubles for the values of a
+    /// Data object whose timestepper stores n_tstorage time levels.
+    /// Allocated in a memory mapped file if the out-of-core storage is
+    /// enabled and n_tstorage is large enough; on the heap (with
+    /// new[]) otherwise. Must be freed with deallocate(...). Not
+    /// thread-safe: Takes blocks from the global free lists/chunks.
+    extern double* allocate(const unsigned long& n_double,
+                            const unsigned& n_tstorage);
+
+    /// \short Free an array allocated by allocate(...). Arrays that
+    /// weren't allocated out-of-core are deleted with delete[]. Not
+    /// thread-safe: Returns blocks to the global free lists (and may
+    /// unmap the chunks).
+    extern void deallocate(double* const& block_pt);
+
+    /// \short Advise the operating system that the out-of-core storage
+    /// will be accessed shortly so it can read the pages back in bulk.
+    /// Does nothing unless release_resident_memory() has been called
+    /// since the last prefetch (the pages are still resident otherwise).
+    extern void prefetch();
+
+    /// \short Drop the out-of-core storage (i.e. all time levels of the
+    /// Data stored in it) from the resident memory. The values are
+    /// retained: Modified pages are written back to the files and read
+    /// in again when they're next accessed (or by prefetch()).
+    extern void release_resident_memory();
+
+  } // namespace OutOfCoreStorage
+
+} // namespace oomph
+
+#endif
@@ -514,13 +514,17 @@ namespace oomph
   /// flag is set to true (it defaults to false) each processor
   /// assigns a dumb-but-repeatable equidistribution of its non-halo
   /// elements over the domains and outputs the input that would have
-  /// gone into METIS in the file metis_input_for_validation.dat
+  /// gone into METIS in the file metis_input_for_validation.dat.
+  /// The final argument specifies the repartitioning strategy (see
+  /// the enumeration METIS::Repartitioning_method); it is ignored if
+  /// METIS is bypassed.
   //==================================================================
   void METIS::partition_distributed_mesh(
     Problem* problem_pt,
     const unsigned& objective,
     Vector<unsigned>& element_domain_on_this_proc,
-    const bool& bypass_metis)
+    const bool& bypass_metis,
+    const unsigned& repartitioning_method)
   {
     // Start timer
     clock_t cpu_start = clock();
@@ -538,9 +542,10 @@ namespace oomph
     // Total number of elements (halo and nonhalo) on this proc
     unsigned n_elem = mesh_pt->nelement();
 
-    // Get elemental assembly times
+    // Get elemental assembly times (incl. the elements' share of the
+    // time spent in the linear solver)
     Vector<double> elemental_assembly_time =
-      problem_pt->elemental_assembly_time();
+      problem_pt->elemental_load_balancing_cost();
 
 #ifdef PARANOID
     unsigned n = elemental_assembly_time.size();
@@ -1069,7 +1074,8 @@ namespace oomph
       // elements associated with root
       if (can_load_balance_on_assembly_times)
       {
-        oomph_info << "Basing distribution on assembly times of elements\n";
+        oomph_info << "Basing distribution on measured costs (assembly "
+                   << "and linear solver times) of elements\n";
 
         // Normalise
         double min_time = *(
@@ -1116,6 +1122,52 @@ namespace oomph
         }
       }
 
+      // Current domains of the root elements (concatenated in
+      // processor-by-processor order) and their weights
+      Vector<unsigned> current_root_element_domain(
+        total_number_of_root_elements);
+      Vector<int> root_element_weight(total_number_of_root_elements);
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        unsigned n_root = number_of_root_elements_on_each_proc[p];
+        for (unsigned e = 0; e < n_root; e++)
+        {
+          current_root_element_domain[start_index[p] + e] = p;
+        }
+      }
+      for (unsigned e = 0; e < total_number_of_root_elements; e++)
+      {
+        root_element_weight[e] = vwgt[e];
+      }
+
+      // Try to diffuse the current partition first
+      bool partition_has_been_diffused = false;
+      if ((!bypass_metis) &&
+          (repartitioning_method == Diffusive_repartitioning))
+      {
+        Vector<unsigned> diffused_root_element_domain;
+        partition_has_been_diffused =
+          diffuse_partition(ndomain,
+                            xadj,
+                            adjacency_vector,
+                            root_element_weight,
+                            current_root_element_domain,
+                            diffused_root_element_domain);
+        if (partition_has_been_diffused)
+        {
+          oomph_info << "Re-partitioned by diffusion of current partition\n";
+          for (unsigned e = 0; e < total_number_of_root_elements; e++)
+          {
+            part[e] = diffused_root_element_domain[e];
+          }
+        }
+        else
+        {
+          oomph_info << "Diffusion of current partition did not achieve "
+                     << "adequate balance; re-partitioning from scratch\n";
+        }
+      }
+
       // Bypass METIS (usually for validation)
       if (bypass_metis)
       {
@@ -1152,7 +1204,7 @@ namespace oomph
         outfile.close();
       }
       // Actually use METIS (good but not always repeatable!)
-      else
+      else if (!partition_has_been_diffused)
       {
         if (objective == 0)
         {
@@ -1185,14 +1237,42 @@ namespace oomph
                                edgecut,
                                part);
         }
+
+        // Relabel the new domains to minimise the migration
+        if (repartitioning_method != Scratch_repartitioning)
+        {
+          Vector<unsigned> new_root_element_domain(
+            total_number_of_root_elements);
+          for (unsigned e = 0; e < total_number_of_root_elements; e++)
+          {
+            new_root_element_domain[e] = part[e];
+          }
+          remap_partition(ndomain,
+                          current_root_element_domain,
+                          root_element_weight,
+                          new_root_element_domain);
+          for (unsigned e = 0; e < total_number_of_root_elements; e++)
+          {
+            part[e] = new_root_element_domain[e];
+          }
+        }
       }
 
       // Copy across
       Vector<unsigned> total_weight_on_proc(n_proc, 0);
+      unsigned n_migrated_root_element = 0;
+      double total_weight = 0.0;
+      double migrated_weight = 0.0;
       for (unsigned e = 0; e < total_number_of_root_elements; e++)
       {
         root_element_domain[e] = part[e];
         total_weight_on_proc[part[e]] += vwgt[e];
+        total_weight += double(vwgt[e]);
+        if (root_element_domain[e] != current_root_element_domain[e])
+        {
+          n_migrated_root_element++;
+          migrated_weight += double(vwgt[e]);
+        }
       }
 
       // Document success of partitioning
@@ -1201,6 +1281,18 @@ namespace oomph
         oomph_info << "Total weight on proc " << j << " is "
                    << total_weight_on_proc[j] << std::endl;
       }
+      oomph_info << "Number of root elements to be migrated: "
+                 << n_migrated_root_element << " of "
+                 << total_number_of_root_elements << " [";
+      if (total_weight > 0.0)
+      {
+        oomph_info << 100.0 * migrated_weight / total_weight;
+      }
+      else
+      {
+        oomph_info << 0.0;
+      }
+      oomph_info << "% of total weight]" << std::endl;
 
       // Doc
       double cpu1 = double(cpu_end - cpu_start) / CLOCKS_PER_SEC;
@@ -1301,6 +1393,428 @@ namespace oomph
   }
 
 
+  //==================================================================
+  /// Relabel the domains in a new partition, new_domain, (as produced
+  /// by partitioning from scratch) such that the total weight of the
+  /// vertices that remain in their current domain, current_domain, is
+  /// maximised. Greedy assignment in order of decreasing overlap
+  /// between new and current domains.
+  //==================================================================
+  void METIS::remap_partition(const unsigned& ndomain,
+                              const Vector<unsigned>& current_domain,
+                              const Vector<int>& weight,
+                              Vector<unsigned>& new_domain)
+  {
+    // Overlap (total weight) between new and current domains, stored
+    // sparsely: overlap[std::make_pair(new,current)]
+    std::map<std::pair<unsigned, unsigned>, double> overlap;
+    unsigned n_vertex = new_domain.size();
+    for (unsigned e = 0; e < n_vertex; e++)
+    {
+      overlap[std::make_pair(new_domain[e], current_domain[e])] +=
+        double(weight[e]);
+    }
+
+    // Sort the pairings by decreasing overlap
+    std::vector<std::pair<double, std::pair<unsigned, unsigned>>> pairing;
+    pairing.reserve(overlap.size());
+    for (std::map<std::pair<unsigned, unsigned>, double>::iterator it =
+           overlap.begin();
+         it != overlap.end();
+         it++)
+    {
+      pairing.push_back(std::make_pair(-(*it).second, (*it).first));
+    }
+    std::sort(pairing.begin(), pairing.end());
+
+    // Greedy assignment of the new domains' labels
+    Vector<int> label(ndomain, -1);
+    std::vector<bool> label_is_taken(ndomain, false);
+    unsigned n_pairing = pairing.size();
+    for (unsigned i = 0; i < n_pairing; i++)
+    {
+      unsigned new_d = pairing[i].second.first;
+      unsigned current_d = pairing[i].second.second;
+      if ((label[new_d] == -1) && (!label_is_taken[current_d]))
+      {
+        label[new_d] = current_d;
+        label_is_taken[current_d] = true;
+      }
+    }
+
+    // Domains without overlap get the remaining labels
+    unsigned next_label = 0;
+    for (unsigned d = 0; d < ndomain; d++)
+    {
+      if (label[d] == -1)
+      {
+        while (label_is_taken[next_label])
+        {
+          next_label++;
+        }
+        label[d] = next_label;
+        label_is_taken[next_label] = true;
+      }
+    }
+
+    // Relabel
+    for (unsigned e = 0; e < n_vertex; e++)
+    {
+      new_domain[e] = label[new_domain[e]];
+    }
+  }
+
+
+  //==================================================================
+  /// Diffusive re-partitioning of the graph specified in METIS' CSR
+  /// format (xadj, adjacency): Starting from the current partition,
+  /// vertices on the boundaries of overloaded domains are moved to the
+  /// least loaded adjacent domain until the max. weight on any domain
+  /// exceeds the average by no more than the specified fraction,
+  /// tolerance. Returns false (and a possibly partially balanced
+  /// partition) if this could not be achieved within max_pass sweeps.
+  //==================================================================
+  bool METIS::diffuse_partition(const unsigned& ndomain,
+                                const int* xadj,
+                                const Vector<int>& adjacency,
+                                const Vector<int>& weight,
+                                const Vector<unsigned>& current_domain,
+                                Vector<unsigned>& new_domain,
+                                const double& tolerance,
+                                const unsigned& max_pass)
+  {
+    // Start from the current partition
+    unsigned n_vertex = current_domain.size();
+    new_domain = current_domain;
+
+    // Weight on each domain
+    Vector<double> load(ndomain, 0.0);
+    double total_load = 0.0;
+    for (unsigned e = 0; e < n_vertex; e++)
+    {
+      load[new_domain[e]] += double(weight[e]);
+      total_load += double(weight[e]);
+    }
+
+    // Max. tolerable weight on any domain
+    double max_load = (1.0 + tolerance) * total_load / double(ndomain);
+
+    for (unsigned pass = 0; pass < max_pass; pass++)
+    {
+      // Are we done?
+      if (*std::max_element(load.begin(), load.end()) <= max_load)
+      {
+        return true;
+      }
+
+      // Sweep over the vertices on the boundaries of overloaded domains
+      bool have_moved_vertex = false;
+      for (unsigned e = 0; e < n_vertex; e++)
+      {
+        unsigned d = new_domain[e];
+        if (load[d] <= max_load)
+        {
+          continue;
+        }
+
+        // Find least loaded adjacent domain
+        int target_d = -1;
+        for (int j = xadj[e]; j < xadj[e + 1]; j++)
+        {
+          unsigned adjacent_d = new_domain[adjacency[j]];
+          if ((adjacent_d != d) &&
+              ((target_d == -1) || (load[adjacent_d] < load[target_d])))
+          {
+            target_d = adjacent_d;
+          }
+        }
+
+        // Only move the vertex if this reduces the imbalance between
+        // the two domains
+        if ((target_d != -1) &&
+            (load[target_d] + double(weight[e]) < load[d]))
+        {
+          load[d] -= double(weight[e]);
+          load[target_d] += double(weight[e]);
+          new_domain[e] = target_d;
+          have_moved_vertex = true;
+        }
+      }
+
+      // No further progress possible
+      if (!have_moved_vertex)
+      {
+        break;
+      }
+    }
+
+    return (*std::max_element(load.begin(), load.end()) <= max_load);
+  }
+
+
+  //==================================================================
+  /// Helper for sparse personalised all-to-all communication:
+  /// send_data[p] is sent to processor p (nothing is sent if it is
+  /// empty). On return, received_data[p] contains the data received
+  /// from processor p. The receivers don't know where (or if) data
+  /// will come from, so we use the "non-blocking consensus" algorithm:
+  /// The data is sent with synchronous sends and everything that
+  /// arrives is received until all processors have entered a
+  /// non-blocking barrier, which they do once their own sends have
+  /// completed (i.e. have been received).
+  //==================================================================
+  void METIS::sparse_all_to_all(OomphCommunicator* comm_pt,
+                                const Vector<Vector<unsigned long>>& send_data,
+                                Vector<Vector<unsigned long>>& received_data)
+  {
+    unsigned n_proc = comm_pt->nproc();
+
+    // Alternate the tags between consecutive exchanges: a processor
+    // may already start the next exchange while another one is still
+    // probing for messages in this one. (All processors call this
+    // function in the same order so the counter is the same everywhere.)
+    static unsigned exchange_count = 0;
+    int tag = Sparse_all_to_all_tag + int(exchange_count % 2);
+    exchange_count++;
+
+    received_data.clear();
+    received_data.resize(n_proc);
+
+    // Start the synchronous sends of the non-empty messages
+    Vector<MPI_Request> send_request;
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      if (!send_data[p].empty())
+      {
+        send_request.push_back(MPI_Request());
+        MPI_Issend(const_cast<unsigned long*>(&send_data[p][0]),
+                   send_data[p].size(),
+                   MPI_UNSIGNED_LONG,
+                   p,
+                   tag,
+                   comm_pt->mpi_comm(),
+                   &send_request.back());
+      }
+    }
+    unsigned n_send = send_request.size();
+
+    // Receive whatever arrives until everybody's done
+    bool entered_barrier = false;
+    MPI_Request barrier_request;
+    while (true)
+    {
+      int message_waiting = 0;
+      MPI_Status status;
+      MPI_Iprobe(
+        MPI_ANY_SOURCE, tag, comm_pt->mpi_comm(), &message_waiting, &status);
+      if (message_waiting)
+      {
+        int n_received = 0;
+        MPI_Get_count(&status, MPI_UNSIGNED_LONG, &n_received);
+        Vector<unsigned long>& data = received_data[status.MPI_SOURCE];
+        data.resize(n_received);
+        MPI_Recv(&data[0],
+                 n_received,
+                 MPI_UNSIGNED_LONG,
+                 status.MPI_SOURCE,
+                 tag,
+                 comm_pt->mpi_comm(),
+                 MPI_STATUS_IGNORE);
+      }
+
+      if (entered_barrier)
+      {
+        // Everybody's sends have been received once the barrier
+        // has completed
+        int barrier_done = 0;
+        MPI_Test(&barrier_request, &barrier_done, MPI_STATUS_IGNORE);
+        if (barrier_done)
+        {
+          break;
+        }
+      }
+      else
+      {
+        // Enter the barrier once our own sends have been received
+        int sends_done = 1;
+        if (n_send != 0)
+        {
+          MPI_Testall(
+            n_send, &send_request[0], &sends_done, MPI_STATUSES_IGNORE);
+        }
+        if (sends_done)
+        {
+          MPI_Ibarrier(comm_pt->mpi_comm(), &barrier_request);
+          entered_barrier = true;
+        }
+      }
+    }
+  }
+
+
+  //==================================================================
+  /// Helper for the memory-scalable distribution of a mesh that is
+  /// never built in its entirety. Given a block of the global
+  /// element-to-node connectivity and the domains of the elements in
+  /// that block, determine the global numbers (and domains) of the
+  /// elements that must be built on this processor: the elements in its
+  /// domain, followed by the halo layer. Node n is looked after by
+  /// processor n%nproc which finds the domains that share it.
+  //==================================================================
+  void METIS::get_elements_for_locally_built_mesh(
+    OomphCommunicator* comm_pt,
+    const unsigned long& first_block_element,
+    const Vector<Vector<unsigned long>>& block_element_node,
+    const Vector<unsigned>& block_element_domain,
+    Vector<unsigned long>& global_element_number,
+    Vector<unsigned>& element_domain)
+  {
+    unsigned n_proc = comm_pt->nproc();
+
+    // Number of elements in this processor's block
+    unsigned long n_block_element = block_element_node.size();
+
+#ifdef PARANOID
+    if (block_element_domain.size() != n_block_element)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Connectivity was specified for " << n_block_element
+                   << " elements, but block_element_domain has "
+                   << block_element_domain.size() << " entries.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Send the elements to the processors in charge of them and
+    // (node, element, domain) triplets to the processors
+    // looking after the nodes
+    Vector<Vector<unsigned long>> my_element_send(n_proc);
+    Vector<Vector<unsigned long>> node_send(n_proc);
+    for (unsigned long e = 0; e < n_block_element; e++)
+    {
+      unsigned long global_e = first_block_element + e;
+      unsigned d = block_element_domain[e];
+#ifdef PARANOID
+      if (d >= n_proc)
+      {
+        std::ostringstream error_stream;
+        error_stream << "Global element " << global_e
+                     << " is assigned to domain " << d << " but there are "
+                     << "only " << n_proc << " processors.\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      my_element_send[d].push_back(global_e);
+      unsigned n_node = block_element_node[e].size();
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        unsigned long global_n = block_element_node[e][j];
+        Vector<unsigned long>& data = node_send[global_n % n_proc];
+        data.push_back(global_n);
+        data.push_back(global_e);
+        data.push_back(d);
+      }
+    }
+    Vector<Vector<unsigned long>> my_element_received;
+    sparse_all_to_all(comm_pt, my_element_send, my_element_received);
+    my_element_send.clear();
+    Vector<Vector<unsigned long>> node_received;
+    sparse_all_to_all(comm_pt, node_send, node_received);
+    node_send.clear();
+
+    // For each of the nodes we look after: Which elements (and domains)
+    // share it?
+    std::map<unsigned long, Vector<std::pair<unsigned long, unsigned>>>
+      node_element;
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      unsigned long n_data = node_received[p].size();
+      for (unsigned long i = 0; i < n_data; i += 3)
+      {
+        node_element[node_received[p][i]].push_back(std::make_pair(
+          node_received[p][i + 1], unsigned(node_received[p][i + 2])));
+      }
+      node_received[p].clear();
+    }
+
+    // An element is a halo element in all other domains that share
+    // one of its nodes: Send (element, domain) pairs to those
+    Vector<Vector<unsigned long>> halo_send(n_proc);
+    for (std::map<unsigned long,
+                  Vector<std::pair<unsigned long, unsigned>>>::iterator it =
+           node_element.begin();
+         it != node_element.end();
+         it++)
+    {
+      Vector<std::pair<unsigned long, unsigned>>& el = it->second;
+      unsigned n_el = el.size();
+
+      // Domains that share this node
+      std::set<unsigned> node_domain;
+      for (unsigned i = 0; i < n_el; i++)
+      {
+        node_domain.insert(el[i].second);
+      }
+      if (node_domain.size() == 1) continue;
+
+      for (std::set<unsigned>::iterator it_d = node_domain.begin();
+           it_d != node_domain.end();
+           it_d++)
+      {
+        for (unsigned i = 0; i < n_el; i++)
+        {
+          if (el[i].second != *it_d)
+          {
+            halo_send[*it_d].push_back(el[i].first);
+            halo_send[*it_d].push_back(el[i].second);
+          }
+        }
+      }
+    }
+    node_element.clear();
+    Vector<Vector<unsigned long>> halo_received;
+    sparse_all_to_all(comm_pt, halo_send, halo_received);
+    halo_send.clear();
+
+    // Assemble the elements in our domain...
+    Vector<unsigned long> my_element;
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      my_element.insert(my_element.end(),
+                        my_element_received[p].begin(),
+                        my_element_received[p].end());
+    }
+    std::sort(my_element.begin(), my_element.end());
+
+    // ...and the (unique) halo elements
+    std::map<unsigned long, unsigned> halo_element;
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      unsigned long n_data = halo_received[p].size();
+      for (unsigned long i = 0; i < n_data; i += 2)
+      {
+        halo_element[halo_received[p][i]] = halo_received[p][i + 1];
+      }
+    }
+
+    unsigned my_rank = comm_pt->my_rank();
+    unsigned long n_my_element = my_element.size();
+    global_element_number = my_element;
+    element_domain.assign(n_my_element, my_rank);
+    global_element_number.reserve(n_my_element + halo_element.size());
+    element_domain.reserve(n_my_element + halo_element.size());
+    for (std::map<unsigned long, unsigned>::iterator it = halo_element.begin();
+         it != halo_element.end();
+         it++)
+    {
+      global_element_number.push_back(it->first);
+      element_domain.push_back(it->second);
+    }
+  }
+
+
 #endif
 
 } // namespace oomph
@@ -141,6 +141,56 @@ namespace oomph
 #ifdef OOMPH_HAS_MPI
 
 
+    /// \short Enumeration for the strategies used to re-partition an
+    /// already-distributed mesh (see partition_distributed_mesh(...)):
+    /// - Scratch_repartitioning: Partition from scratch; the new domains
+    ///   bear no relation to the current ones, so (almost) all
+    ///   elements tend to migrate.
+    /// - Scratch_remap_repartitioning: Partition from scratch but relabel
+    ///   the new domains such that their overlap with the current ones
+    ///   is maximised.
+    /// - Diffusive_repartitioning: Start from the current distribution
+    ///   and diffuse root elements from overloaded domains to adjacent
+    ///   less loaded ones. Falls back to Scratch_remap_repartitioning if
+    ///   this does not achieve an adequate balance.
+    /// .
+    /// The last two minimise the volume of data that has to be migrated
+    /// during load balancing.
+    enum Repartitioning_method
+    {
+      Scratch_repartitioning,
+      Scratch_remap_repartitioning,
+      Diffusive_repartitioning
+    };
+
+    /// \short Relabel the domains in a new partition, new_domain, (as
+    /// produced by partitioning from scratch) such that the total weight
+    /// of the vertices that remain in their current domain,
+    /// current_domain, is maximised. Greedy assignment in order of
+    /// decreasing overlap between new and current domains.
+    extern void remap_partition(const unsigned& ndomain,
+                                const Vector<unsigned>& current_domain,
+                                const Vector<int>& weight,
+                                Vector<unsigned>& new_domain);
+
+    /// \short Diffusive re-partitioning of the graph specified in
+    /// METIS' CSR format (xadj, adjacency): Starting from the current
+    /// partition, vertices on the boundaries of overloaded domains are
+    /// moved to the least loaded adjacent domain until the max. weight
+    /// on any domain exceeds the average by no more than the specified
+    /// fraction, tolerance. Returns false (and a possibly partially
+    /// balanced partition) if this could not be achieved within
+    /// max_pass sweeps.
+    extern bool diffuse_partition(const unsigned& ndomain,
+                                  const int* xadj,
+                                  const Vector<int>& adjacency,
+                                  const Vector<int>& weight,
+                                  const Vector<unsigned>& current_domain,
+                                  Vector<unsigned>& new_domain,
+                                  const double& tolerance = 0.05,
+                                  const unsigned& max_pass = 20);
+
+
     /// \short Use METIS to assign each element in an already-distributed mesh
     /// to a domain. On return, element_domain_on_this_proc[e] contains the
     /// number of the domain [0,1,...,ndomain-1] to which non-halo element e on
@@ -162,12 +212,57 @@ namespace oomph
     /// flag is set to true (it defaults to false) each processor
     /// assigns a dumb-but-repeatable equidistribution of its non-halo
     /// elements over the domains and outputs the input that would have
-    /// gone into METIS in the file metis_input_for_validation.dat
+    /// gone into METIS in the file metis_input_for_validation.dat.
+    /// The final argument specifies the repartitioning strategy (see
+    /// the enumeration Repartitioning_method); it is ignored if METIS
+    /// is bypassed.
     extern void partition_distributed_mesh(
       Problem* problem_pt,
       const unsigned& objective,
       Vector<unsigned>& element_domain_on_this_proc,
-      const bool& bypass_metis = false);
+      const bool& bypass_metis = false,
+      const unsigned& repartitioning_method = Scratch_repartitioning);
+
+    /// \short MPI tags used by sparse_all_to_all(...). Consecutive
+    /// exchanges alternate between Sparse_all_to_all_tag and
+    /// Sparse_all_to_all_tag+1 so their messages can't get mixed up.
+    const int Sparse_all_to_all_tag = 4214;
+
+    /// \short Helper for sparse personalised all-to-all communication:
+    /// send_data[p] is sent to processor p (nothing is sent if it is
+    /// empty). On return, received_data[p] contains the data received
+    /// from processor p (and is empty if nothing was received from it).
+    /// The receivers are found by "non-blocking consensus" so no global
+    /// exchange of the message sizes is required. Must be called by all
+    /// processors.
+    extern void sparse_all_to_all(
+      OomphCommunicator* comm_pt,
+      const Vector<Vector<unsigned long>>& send_data,
+      Vector<Vector<unsigned long>>& received_data);
+
+    /// \short Helper for the memory-scalable distribution of a mesh
+    /// that is never built in its entirety (see
+    /// Problem::distribute_locally_built_problem(...)). Each processor
+    /// provides a block of the global element-to-node connectivity,
+    /// e.g. read from a file: block_element_node[e] contains the global
+    /// node numbers of global element first_block_element+e, and
+    /// block_element_domain[e] the domain to which it has been assigned
+    /// by a (parallel) partitioner. On return, global_element_number
+    /// contains the global numbers of the elements that must be built
+    /// on this processor: the elements in its domain (in ascending
+    /// order), followed by its halo layer, i.e. all other elements that
+    /// share a node with them (also in ascending order). element_domain
+    /// contains the corresponding domains. The halo layers are
+    /// determined by exchanges of data via processors that are in
+    /// charge of (blocks of) the nodes, so no processor ever holds
+    /// information about the entire mesh.
+    extern void get_elements_for_locally_built_mesh(
+      OomphCommunicator* comm_pt,
+      const unsigned long& first_block_element,
+      const Vector<Vector<unsigned long>>& block_element_node,
+      const Vector<unsigned>& block_element_domain,
+      Vector<unsigned long>& global_element_number,
+      Vector<unsigned>& element_domain);
 
 #endif
 
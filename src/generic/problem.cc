@@ -31,6 +31,7 @@
 #include <list>
 #include <algorithm>
 #include <string>
+#include <cstring>
 
 #include "oomph_utilities.h"
 #include "problem.h"
@@ -81,6 +82,20 @@ namespace oomph
       Doc_imbalance_in_parallel_assembly(false),
       Use_default_partition_in_load_balance(false),
       Must_recompute_load_balance_for_assembly(true),
+      Nlocally_built_base_mesh_element(0),
+      Overlap_dof_synchronisation_with_assembly(false),
+      Newton_step_actions_only_use_local_values(false),
+      Dof_synchronisation_is_pending(false),
+      Pending_synchronisation_of_halos(false),
+      Pending_synchronisation_of_external_halos(false),
+      Automatic_load_balancing(false),
+      Max_imbalance_for_automatic_load_balancing(20.0),
+      Doc_imbalance_after_automatic_load_balancing(false),
+      Linear_solver_time_for_load_balancing(0.0),
+      Nlinear_solve_for_load_balancing(0),
+      Repartitioning_method_for_load_balancing(METIS::Scratch_repartitioning),
+      Max_message_size_for_load_balancing(65536),
+      Max_n_message_in_flight_for_load_balancing(8),
       Halo_scheme_pt(0),
 #endif
       Relaxation_factor(1.0),
@@ -98,6 +113,8 @@ namespace oomph
       Sparse_assemble_with_arrays_initial_allocation(400),
       Sparse_assemble_with_arrays_allocation_increment(150),
       Numerical_zero_for_sparse_assembly(0.0),
+      Use_threaded_assembly(false),
+      Threaded_assembly_chunk_size(256),
       FD_step_used_in_get_hessian_vector_products(1.0e-8),
       Mass_matrix_reuse_is_enabled(false),
       Mass_matrix_has_been_computed(false),
@@ -197,6 +214,12 @@ namespace oomph
 
     delete Default_eigen_solver_pt;
     delete Default_assembly_handler_pt;
+#ifdef OOMPH_HAS_MPI
+    // Delete the communication plans (after any pending communication
+    // has completed)
+    invalidate_dof_synchronisation_plans();
+#endif
+
     delete Communicator_pt;
     delete Dof_distribution_pt;
 
@@ -798,10 +821,7 @@ namespace oomph
         unsigned n_del = deleted_element_pt.size();
         for (unsigned e = 0; e < n_del; e++)
         {
-          GeneralisedElement* el_pt = deleted_element_pt[e];
-          unsigned old_el_number = Base_mesh_element_number_plus_one[el_pt] - 1;
-          Base_mesh_element_number_plus_one[el_pt] = 0;
-          Base_mesh_element_pt[old_el_number] = 0;
+          null_base_mesh_element(deleted_element_pt[e]);
         }
 
         if (Doc_time_in_distribute)
@@ -869,6 +889,326 @@ namespace oomph
     return return_element_domain;
   }
 
+  //==================================================================
+  /// Memory-scalable alternative to distribute(...) for problems whose
+  /// (sub)meshes were built "locally" on each processor, i.e. they only
+  /// contain the elements the processor is in charge of plus the halo
+  /// layer. global_element_number[e] and element_domain[e] specify the
+  /// number of the e-th element of the Problem's (global) mesh in the
+  /// never-assembled global mesh and the processor in charge of it.
+  //==================================================================
+  void Problem::distribute_locally_built_problem(
+    const Vector<unsigned long>& global_element_number,
+    const Vector<unsigned>& element_domain,
+    const bool& report_stats)
+  {
+    // Nothing to be done on a single processor: the local mesh is
+    // the global one
+    if (this->communicator_pt()->nproc() == 1)
+    {
+      return;
+    }
+
+    // Is there any global data?  If so, distributing the problem won't work
+    if (nglobal_data() > 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << "You have tried to distribute a problem\n"
+                   << "and there is some global data.\n"
+                   << "This is not likely to work...\n"
+                   << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+#ifdef PARANOID
+    if ((global_element_number.size() != mesh_pt()->nelement()) ||
+        (element_domain.size() != mesh_pt()->nelement()))
+    {
+      std::ostringstream error_stream;
+      error_stream << "Problem's mesh has " << mesh_pt()->nelement()
+                   << " elements but " << global_element_number.size()
+                   << " global element numbers and " << element_domain.size()
+                   << " element domains were specified.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    double t_start = 0.0;
+    if (Doc_time_in_distribute)
+    {
+      t_start = TimingHelpers::timer();
+    }
+
+    // Dummy doc info
+    DocInfo doc_info;
+    doc_info.disable_doc();
+
+    // Set the global mesh as being distributed
+    mesh_pt()->set_communicator_pt(this->communicator_pt());
+
+    // Setup the halo lookup schemes of the (sub)meshes
+    unsigned n_mesh = nsub_mesh();
+    if (n_mesh == 0)
+    {
+      mesh_pt()->distribute_locally_built_mesh(this->communicator_pt(),
+                                               global_element_number,
+                                               element_domain,
+                                               doc_info,
+                                               report_stats);
+    }
+    else
+    {
+      unsigned count = 0;
+      for (unsigned i_mesh = 0; i_mesh < n_mesh; i_mesh++)
+      {
+        unsigned nsub_elem = mesh_pt(i_mesh)->nelement();
+        Vector<unsigned long> submesh_global_element_number(nsub_elem);
+        Vector<unsigned> submesh_element_domain(nsub_elem);
+        for (unsigned e = 0; e < nsub_elem; e++)
+        {
+          submesh_global_element_number[e] = global_element_number[count];
+          submesh_element_domain[e] = element_domain[count];
+          count++;
+        }
+
+        if (report_stats)
+        {
+          oomph_info << "Distributing submesh " << i_mesh << std::endl
+                     << "--------------------" << std::endl;
+        }
+        doc_info.number() = i_mesh;
+        mesh_pt(i_mesh)->distribute_locally_built_mesh(
+          this->communicator_pt(),
+          submesh_global_element_number,
+          submesh_element_domain,
+          doc_info,
+          report_stats);
+      }
+
+      // Rebuild the global mesh
+      rebuild_global_mesh();
+    }
+
+    // Setup the map between "root" element and number in the global
+    // mesh (used in the load_balance() routines). Only the locally
+    // built elements are known, so use the sparse lookup scheme;
+    // the dense one would require storage for all global elements.
+    unsigned long n_local_element = global_element_number.size();
+    unsigned long n_global_element = 0;
+    for (unsigned long e = 0; e < n_local_element; e++)
+    {
+      n_global_element =
+        std::max(n_global_element, global_element_number[e] + 1);
+    }
+    MPI_Allreduce(&n_global_element,
+                  &Nlocally_built_base_mesh_element,
+                  1,
+                  MPI_UNSIGNED_LONG,
+                  MPI_MAX,
+                  this->communicator_pt()->mpi_comm());
+    Base_mesh_element_pt.clear();
+    Base_mesh_element_number_plus_one.clear();
+    Locally_built_base_mesh_element_pt.clear();
+    for (unsigned long e = 0; e < n_local_element; e++)
+    {
+      GeneralisedElement* el_pt = mesh_pt()->element_pt(e);
+      Base_mesh_element_number_plus_one[el_pt] = global_element_number[e] + 1;
+      Locally_built_base_mesh_element_pt[global_element_number[e]] = el_pt;
+    }
+
+    if (Doc_time_in_distribute)
+    {
+      oomph_info << "Time for setup of locally built distributed mesh: "
+                 << TimingHelpers::timer() - t_start << std::endl;
+      t_start = TimingHelpers::timer();
+    }
+
+    // Now the problem has been distributed
+    Problem_has_been_distributed = true;
+
+    // Assign the equation numbers (incl synchronisation if reqd)
+    unsigned n_dof = assign_eqn_numbers();
+    oomph_info << "Number of equations: " << n_dof << std::endl;
+
+    if (Doc_time_in_distribute)
+    {
+      oomph_info << "Time for assigning eqn numbers (in distribute): "
+                 << TimingHelpers::timer() - t_start << std::endl;
+    }
+
+    // Force re-analysis of time spent on assembly each
+    // elemental Jacobian
+    Must_recompute_load_balance_for_assembly = true;
+    Elemental_assembly_time.clear();
+  }
+
+
+  //==================================================================
+  /// Return vector of the most-recent measured costs of the elements
+  /// (used for load balancing): their assembly time plus their share
+  /// of the time spent in the linear solver on this processor
+  /// (distributed over the non-halo elements in proportion to their
+  /// number of dofs). Zero sized if no Jacobian has been computed since
+  /// last re-assignment of equation numbers.
+  //==================================================================
+  Vector<double> Problem::elemental_load_balancing_cost()
+  {
+    const unsigned n_element = mesh_pt()->nelement();
+    if (Elemental_assembly_time.size() != n_element)
+    {
+      return Vector<double>();
+    }
+
+    // Start with the assembly times
+    Vector<double> cost(Elemental_assembly_time);
+
+    // Add the share of the (average) linear solver time
+    if (Nlinear_solve_for_load_balancing > 0)
+    {
+      unsigned long n_dof_total = 0;
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        GeneralisedElement* el_pt = mesh_pt()->element_pt(e);
+        if (!el_pt->is_halo())
+        {
+          n_dof_total += el_pt->ndof();
+        }
+      }
+      if (n_dof_total > 0)
+      {
+        double solver_time_per_dof = Linear_solver_time_for_load_balancing /
+                                     double(Nlinear_solve_for_load_balancing) /
+                                     double(n_dof_total);
+        for (unsigned e = 0; e < n_element; e++)
+        {
+          GeneralisedElement* el_pt = mesh_pt()->element_pt(e);
+          if (!el_pt->is_halo())
+          {
+            cost[e] += solver_time_per_dof * double(el_pt->ndof());
+          }
+        }
+      }
+    }
+
+    return cost;
+  }
+
+  //==================================================================
+  /// Imbalance (in percent, defined as (max-min)/average) of the measured
+  /// costs of the non-halo elements on the various processors.
+  /// Negative if the costs have not been measured on all processors.
+  //==================================================================
+  double Problem::load_imbalance()
+  {
+    // Total cost of the non-halo elements on this processor
+    Vector<double> cost = elemental_load_balancing_cost();
+    const unsigned n_element = mesh_pt()->nelement();
+    int have_cost = (cost.size() == n_element) ? 1 : 0;
+    double t_local = 0.0;
+    if (have_cost)
+    {
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        if (!mesh_pt()->element_pt(e)->is_halo())
+        {
+          t_local += cost[e];
+        }
+      }
+    }
+
+    // Have the costs been measured everywhere?
+    int everybody_has_cost = 0;
+    MPI_Allreduce(&have_cost,
+                  &everybody_has_cost,
+                  1,
+                  MPI_INT,
+                  MPI_MIN,
+                  this->communicator_pt()->mpi_comm());
+    if (everybody_has_cost == 0)
+    {
+      return -1.0;
+    }
+
+    double t_max = 0.0;
+    double t_min = 0.0;
+    double t_sum = 0.0;
+    MPI_Allreduce(&t_local,
+                  &t_max,
+                  1,
+                  MPI_DOUBLE,
+                  MPI_MAX,
+                  this->communicator_pt()->mpi_comm());
+    MPI_Allreduce(&t_local,
+                  &t_min,
+                  1,
+                  MPI_DOUBLE,
+                  MPI_MIN,
+                  this->communicator_pt()->mpi_comm());
+    MPI_Allreduce(&t_local,
+                  &t_sum,
+                  1,
+                  MPI_DOUBLE,
+                  MPI_SUM,
+                  this->communicator_pt()->mpi_comm());
+    if (t_sum <= 0.0)
+    {
+      return 0.0;
+    }
+    unsigned n_proc = this->communicator_pt()->nproc();
+    return (t_max - t_min) / (t_sum / double(n_proc)) * 100.0;
+  }
+
+  //==================================================================
+  /// Load balance the problem if the measured load imbalance exceeds
+  /// the threshold specified in enable_automatic_load_balancing(...);
+  /// doc the imbalance before and (once it has been measured) after
+  /// the load balancing. Returns true if the problem was load balanced.
+  //==================================================================
+  bool Problem::load_balance_if_imbalanced(const bool& report_stats)
+  {
+    if ((!Problem_has_been_distributed) ||
+        (this->communicator_pt()->nproc() == 1))
+    {
+      return false;
+    }
+
+    double imbalance = load_imbalance();
+
+    // Nothing measured yet (e.g. since the last load balancing)
+    if (imbalance < 0.0)
+    {
+      return false;
+    }
+
+    // Doc the imbalance resulting from the previous load balancing
+    if (Doc_imbalance_after_automatic_load_balancing)
+    {
+      oomph_info << "Load imbalance after load balancing: " << imbalance
+                 << "%" << std::endl;
+      Doc_imbalance_after_automatic_load_balancing = false;
+    }
+
+    if (imbalance <= Max_imbalance_for_automatic_load_balancing)
+    {
+      return false;
+    }
+
+    oomph_info << "Load imbalance " << imbalance << "% exceeds "
+               << Max_imbalance_for_automatic_load_balancing
+               << "%; load balancing." << std::endl;
+
+    // Re-distribute (the partitioning uses the measured costs as weights)
+    load_balance(report_stats);
+
+    // The imbalance after the load balancing can only be assessed once
+    // the costs have been measured again
+    Doc_imbalance_after_automatic_load_balancing = true;
+    return true;
+  }
+
+
   //==================================================================
   /// Partition the global mesh, return vector specifying the processor
   /// number for each element. Virtual so that it can be overloaded by
@@ -1101,14 +1441,14 @@ namespace oomph
         }
 
         // Associate all elements with root in current Base mesh
-        unsigned nel = Base_mesh_element_pt.size();
+        unsigned nel = nbase_mesh_element();
         std::map<GeneralisedElement*, unsigned>
           old_base_element_number_plus_one;
         std::vector<bool> old_root_is_halo_or_non_existent(nel, true);
         for (unsigned e = 0; e < nel; e++)
         {
           // Get the base element
-          GeneralisedElement* base_el_pt = Base_mesh_element_pt[e];
+          GeneralisedElement* base_el_pt = base_mesh_element_pt(e);
 
           // Does it exist locally?
           if (base_el_pt != 0)
@@ -1372,7 +1712,9 @@ namespace oomph
 #endif
         }
 
-        // Reset base_mesh information
+        // Reset base_mesh information (the pruned mesh uses the dense
+        // lookup scheme, even if it was built locally)
+        clear_locally_built_base_mesh_element_pt();
         Base_mesh_element_pt.clear();
         Base_mesh_element_pt.resize(nel_base_new, 0);
         Base_mesh_element_number_plus_one.clear();
@@ -2026,13 +2368,18 @@ namespace oomph
     // Storage for number of processors
     int n_proc = this->communicator_pt()->nproc();
 
+    // The halo(ed) Data may have changed so the communication plans
+    // for the synchronisation of the dofs have to be re-built
+    invalidate_dof_synchronisation_plans();
 
     if (n_proc > 1)
     {
       // Force re-analysis of time spent on assembly each
-      // elemental Jacobian
+      // elemental Jacobian (and in the linear solver)
       Must_recompute_load_balance_for_assembly = true;
       Elemental_assembly_time.clear();
+      Linear_solver_time_for_load_balancing = 0.0;
+      Nlinear_solve_for_load_balancing = 0;
     }
     else
     {
@@ -4175,6 +4522,14 @@ namespace oomph
 
     // clean up dist_pt and residuals_vector pt
     delete dist_pt;
+
+    // The Data isn't accessed again until the linear solve is complete,
+    // so drop its out-of-core storage from the resident memory to make
+    // space for the solver (no-op if there's no out-of-core storage)
+    if (OutOfCoreStorage::Release_resident_memory_after_assembly)
+    {
+      OutOfCoreStorage::release_resident_memory();
+    }
   }
 
   //=============================================================================
@@ -4292,6 +4647,14 @@ namespace oomph
 
     // clean up
     delete dist_pt;
+
+    // The Data isn't accessed again until the linear solve is complete,
+    // so drop its out-of-core storage from the resident memory to make
+    // space for the solver (no-op if there's no out-of-core storage)
+    if (OutOfCoreStorage::Release_resident_memory_after_assembly)
+    {
+      OutOfCoreStorage::release_resident_memory();
+    }
   }
 
 
@@ -5326,6 +5689,102 @@ namespace oomph
   }
 
 
+  //=====================================================================
+  /// Helper function for threaded assembly: Compute the contributions
+  /// of the (non-halo) elements whose numbers are stored in
+  /// element_number, using the rank's thread pool. The contributions of
+  /// the k-th element are returned in el_residuals[k] and el_jacobian[k]
+  /// (which must have been sized appropriately); if doc_time is true the
+  /// time taken to compute them is returned in el_assembly_time[k].
+  //=====================================================================
+  void Problem::get_element_contributions_with_threads(
+    AssemblyHandler* const& assembly_handler_pt,
+    const Vector<unsigned long>& element_number,
+    Vector<Vector<Vector<double>>>& el_residuals,
+    Vector<Vector<DenseMatrix<double>>>& el_jacobian,
+    const bool& doc_time,
+    Vector<double>& el_assembly_time)
+  {
+    // Number of elements in this chunk
+    const long n_chunk = element_number.size();
+
+    // Exceptions must not escape from the parallel region so record
+    // the first one and rethrow it afterwards
+    bool exception_thrown = false;
+    std::string exception_message;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 4)
+#endif
+    for (long k = 0; k < n_chunk; k++)
+    {
+      try
+      {
+        double t_start = 0.0;
+        if (doc_time)
+        {
+          t_start = TimingHelpers::timer();
+        }
+
+        // Get the pointer to the element
+        GeneralisedElement* elem_pt = mesh_pt()->element_pt(element_number[k]);
+
+#ifdef OOMPH_HAS_MPI
+        // Ignore halo elements
+        if (!elem_pt->is_halo())
+#endif
+        {
+          // Find number of degrees of freedom in the element
+          const unsigned nvar = assembly_handler_pt->ndof(elem_pt);
+
+          // Resize the storage for elemental jacobian and residuals
+          const unsigned n_vector = el_residuals[k].size();
+          for (unsigned v = 0; v < n_vector; v++)
+          {
+            el_residuals[k][v].resize(nvar);
+          }
+          const unsigned n_matrix = el_jacobian[k].size();
+          for (unsigned m = 0; m < n_matrix; m++)
+          {
+            el_jacobian[k][m].resize(nvar);
+          }
+
+          // Now get the residuals and jacobian for the element
+          assembly_handler_pt->get_all_vectors_and_matrices(
+            elem_pt, el_residuals[k], el_jacobian[k]);
+        }
+
+        if (doc_time)
+        {
+          el_assembly_time[k] = TimingHelpers::timer() - t_start;
+        }
+      }
+      catch (std::exception& error)
+      {
+#ifdef _OPENMP
+#pragma omp critical(threaded_assembly_exception)
+#endif
+        {
+          if (!exception_thrown)
+          {
+            exception_thrown = true;
+            exception_message = error.what();
+          }
+        }
+      }
+    }
+
+    if (exception_thrown)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Exception thrown during threaded assembly:\n"
+                   << exception_message << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
   //=====================================================================
   /// This is a (private) helper function that is used to assemble system
   /// matrices in compressed row or column format
@@ -5464,13 +5923,60 @@ namespace oomph
       // Allocate local storage for the element's contribution to the
       // residuals vectors and system matrices of the size of the maximum
       // number of dofs in any element
-      // This means that the storage is only allocated (and deleted) once
-      Vector<Vector<double>> el_residuals(n_vector);
-      Vector<DenseMatrix<double>> el_jacobian(n_matrix);
+      // This means that the storage is only allocated (and deleted) once.
+      // During threaded assembly we store the contributions of a whole
+      // chunk of elements, computed by the rank's thread pool, and only
+      // insert them into the vector storage scheme afterwards.
+      const bool use_threads =
+        Use_threaded_assembly && (ThreadingHelpers::nthread() > 1);
+      unsigned long n_chunk_max = 1;
+      if (use_threads)
+      {
+        n_chunk_max = std::max(Threaded_assembly_chunk_size, 1u);
+      }
+      Vector<Vector<Vector<double>>> chunk_residuals(
+        n_chunk_max, Vector<Vector<double>>(n_vector));
+      Vector<Vector<DenseMatrix<double>>> chunk_jacobian(
+        n_chunk_max, Vector<DenseMatrix<double>>(n_matrix));
+      Vector<double> chunk_assembly_time(n_chunk_max, 0.0);
+      Vector<unsigned long> chunk_element_number;
+      unsigned long chunk_start = el_lo;
+
+      // Record the assembly time for the elements?
+      bool doc_assembly_time = false;
+#ifdef OOMPH_HAS_MPI
+      doc_assembly_time =
+        (!doing_residuals) && Must_recompute_load_balance_for_assembly;
+#endif
 
       // Loop over the elements
       for (unsigned long e = el_lo; e <= el_hi; e++)
       {
+        // Compute the contributions of the next chunk of elements
+        if (use_threads && ((e - el_lo) % n_chunk_max == 0))
+        {
+          chunk_start = e;
+          const unsigned long chunk_end = std::min(e + n_chunk_max, el_hi + 1);
+          chunk_element_number.resize(chunk_end - chunk_start);
+          for (unsigned long k = 0; k < chunk_end - chunk_start; k++)
+          {
+            chunk_element_number[k] = chunk_start + k;
+          }
+          get_element_contributions_with_threads(assembly_handler_pt,
+                                                 chunk_element_number,
+                                                 chunk_residuals,
+                                                 chunk_jacobian,
+                                                 doc_assembly_time,
+                                                 chunk_assembly_time);
+        }
+
+        // Position of the element's contributions in the chunk storage
+        unsigned long i_chunk = 0;
+        if (use_threads)
+        {
+          i_chunk = e - chunk_start;
+        }
+
 #ifdef OOMPH_HAS_MPI
         // Time it?
         if ((!doing_residuals) && Must_recompute_load_balance_for_assembly)
@@ -5491,20 +5997,29 @@ namespace oomph
           // Find number of degrees of freedom in the element
           const unsigned nvar = assembly_handler_pt->ndof(elem_pt);
 
-          // Resize the storage for elemental jacobian and residuals
-          for (unsigned v = 0; v < n_vector; v++)
-          {
-            el_residuals[v].resize(nvar);
-          }
-          for (unsigned m = 0; m < n_matrix; m++)
+          // Storage for the element's contributions
+          Vector<Vector<double>>& el_residuals = chunk_residuals[i_chunk];
+          Vector<DenseMatrix<double>>& el_jacobian = chunk_jacobian[i_chunk];
+
+          // Compute them now unless this has already been done by
+          // the thread pool
+          if (!use_threads)
           {
-            el_jacobian[m].resize(nvar);
+            // Resize the storage for elemental jacobian and residuals
+            for (unsigned v = 0; v < n_vector; v++)
+            {
+              el_residuals[v].resize(nvar);
+            }
+            for (unsigned m = 0; m < n_matrix; m++)
+            {
+              el_jacobian[m].resize(nvar);
+            }
+
+            // Now get the residuals and jacobian for the element
+            assembly_handler_pt->get_all_vectors_and_matrices(
+              elem_pt, el_residuals, el_jacobian);
           }
 
-          // Now get the residuals and jacobian for the element
-          assembly_handler_pt->get_all_vectors_and_matrices(
-            elem_pt, el_residuals, el_jacobian);
-
           //---------------Insert the values into the vectors--------------
 
           // Loop over the first index of local variables
@@ -5595,6 +6110,10 @@ namespace oomph
         {
           Elemental_assembly_time[e] =
             TimingHelpers::timer() - t_assemble_start;
+          if (use_threads)
+          {
+            Elemental_assembly_time[e] += chunk_assembly_time[i_chunk];
+          }
         }
 #endif
 
@@ -6736,13 +7255,93 @@ namespace oomph
       // Allocate local storage for the element's contribution to the
       // residuals vectors and system matrices of the size of the maximum
       // number of dofs in any element
-      // This means that the storage will only be allocated (and deleted) once
-      Vector<Vector<double>> el_residuals(n_vector);
-      Vector<DenseMatrix<double>> el_jacobian(n_matrix);
+      // This means that the storage will only be allocated (and deleted) once.
+      // During threaded assembly we store the contributions of a whole
+      // chunk of elements, computed by the rank's thread pool, and only
+      // insert them into the array storage scheme afterwards.
+      const bool use_threads =
+        Use_threaded_assembly && (ThreadingHelpers::nthread() > 1);
+      unsigned long n_chunk_max = 1;
+      if (use_threads)
+      {
+        n_chunk_max = std::max(Threaded_assembly_chunk_size, 1u);
+      }
+      Vector<Vector<Vector<double>>> chunk_residuals(
+        n_chunk_max, Vector<Vector<double>>(n_vector));
+      Vector<Vector<DenseMatrix<double>>> chunk_jacobian(
+        n_chunk_max, Vector<DenseMatrix<double>>(n_matrix));
+      Vector<double> chunk_assembly_time(n_chunk_max, 0.0);
+      Vector<unsigned long> chunk_element_number;
+      unsigned long chunk_start = el_lo;
+      unsigned long chunk_end = el_lo;
+      const bool doc_assembly_time =
+        (!doing_residuals) && Must_recompute_load_balance_for_assembly;
+
+      // If the synchronisation of the dofs is still in progress, assemble
+      // the elements whose dofs are all stored on this processor first
+      // and only wait for the halo values before dealing with the rest
+      const bool overlap_with_synchronisation = Dof_synchronisation_is_pending;
+      Vector<unsigned long> element_order;
+      unsigned long n_interior_element = el_hi_plus_one - el_lo;
+      if (overlap_with_synchronisation)
+      {
+        get_element_order_for_overlapped_assembly(assembly_handler_pt,
+                                                  el_lo,
+                                                  el_hi_plus_one,
+                                                  element_order,
+                                                  n_interior_element);
+      }
 
       // Loop over the elements
-      for (unsigned long e = el_lo; e < el_hi_plus_one; e++)
+      for (unsigned long i_el = el_lo; i_el < el_hi_plus_one; i_el++)
       {
+        // Element number
+        unsigned long e = i_el;
+        if (overlap_with_synchronisation)
+        {
+          // Have we done all interior elements? Then we need the halo values
+          if (i_el - el_lo == n_interior_element)
+          {
+            finish_synchronise_dofs();
+          }
+          e = element_order[i_el - el_lo];
+        }
+
+        // Compute the contributions of the next chunk of elements (not
+        // straddling the interior ones and those that need halo values)
+        if (use_threads && (i_el == chunk_end))
+        {
+          chunk_start = i_el;
+          chunk_end = std::min(i_el + n_chunk_max, el_hi_plus_one);
+          if (overlap_with_synchronisation &&
+              (i_el - el_lo < n_interior_element))
+          {
+            chunk_end = std::min(chunk_end, el_lo + n_interior_element);
+          }
+          chunk_element_number.resize(chunk_end - chunk_start);
+          for (unsigned long k = 0; k < chunk_end - chunk_start; k++)
+          {
+            chunk_element_number[k] = chunk_start + k;
+            if (overlap_with_synchronisation)
+            {
+              chunk_element_number[k] = element_order[chunk_start + k - el_lo];
+            }
+          }
+          get_element_contributions_with_threads(assembly_handler_pt,
+                                                 chunk_element_number,
+                                                 chunk_residuals,
+                                                 chunk_jacobian,
+                                                 doc_assembly_time,
+                                                 chunk_assembly_time);
+        }
+
+        // Position of the element's contributions in the chunk storage
+        unsigned long i_chunk = 0;
+        if (use_threads)
+        {
+          i_chunk = i_el - chunk_start;
+        }
+
         // Time it?
         if ((!doing_residuals) && Must_recompute_load_balance_for_assembly)
         {
@@ -6758,19 +7357,28 @@ namespace oomph
           // Find number of degrees of freedom in the element
           const unsigned nvar = assembly_handler_pt->ndof(elem_pt);
 
-          // Resize the storage for elemental jacobian and residuals
-          for (unsigned v = 0; v < n_vector; v++)
-          {
-            el_residuals[v].resize(nvar);
-          }
-          for (unsigned m = 0; m < n_matrix; m++)
+          // Storage for the element's contributions
+          Vector<Vector<double>>& el_residuals = chunk_residuals[i_chunk];
+          Vector<DenseMatrix<double>>& el_jacobian = chunk_jacobian[i_chunk];
+
+          // Compute them now unless this has already been done by
+          // the thread pool
+          if (!use_threads)
           {
-            el_jacobian[m].resize(nvar);
-          }
+            // Resize the storage for elemental jacobian and residuals
+            for (unsigned v = 0; v < n_vector; v++)
+            {
+              el_residuals[v].resize(nvar);
+            }
+            for (unsigned m = 0; m < n_matrix; m++)
+            {
+              el_jacobian[m].resize(nvar);
+            }
 
-          // Now get the residuals and jacobian for the element
-          assembly_handler_pt->get_all_vectors_and_matrices(
-            elem_pt, el_residuals, el_jacobian);
+            // Now get the residuals and jacobian for the element
+            assembly_handler_pt->get_all_vectors_and_matrices(
+              elem_pt, el_residuals, el_jacobian);
+          }
 
           //---------------Insert the values into the vectors--------------
 
@@ -6962,8 +7570,16 @@ namespace oomph
         {
           Elemental_assembly_time[e] =
             TimingHelpers::timer() - t_assemble_start;
+          if (use_threads)
+          {
+            Elemental_assembly_time[e] += chunk_assembly_time[i_chunk];
+          }
         }
       } // End of loop over the elements
+
+      // Make sure the synchronisation is complete even if there
+      // weren't any elements that involve halo dofs
+      finish_synchronise_dofs();
     } // End of vector assembly
 
 
@@ -8982,6 +9598,16 @@ namespace oomph
       double t_solver_end = TimingHelpers::timer();
       total_linear_solver_time += t_solver_end - t_solver_start;
 
+      // Read the out-of-core storage back in (if it was released
+      // during the linear solve) before the dofs are updated
+      OutOfCoreStorage::prefetch();
+
+#ifdef OOMPH_HAS_MPI
+      // Record the time for the load balancing
+      Linear_solver_time_for_load_balancing += t_solver_end - t_solver_start;
+      Nlinear_solve_for_load_balancing++;
+#endif
+
       if (!Shut_up_in_newton_solve)
       {
         oomph_info << std::endl;
@@ -9030,8 +9656,25 @@ namespace oomph
         }
       }
 #ifdef OOMPH_HAS_MPI
-      // Synchronise the solution on different processors (on each submesh)
-      this->synchronise_all_dofs();
+      // Synchronise the solution on different processors (on each submesh).
+      // If requested, only start the synchronisation; it's completed
+      // during the assembly of the residuals for the convergence check.
+      if (Overlap_dof_synchronisation_with_assembly && Problem_is_nonlinear &&
+          Problem_has_been_distributed)
+      {
+        this->start_synchronise_all_dofs();
+      }
+      else
+      {
+        this->synchronise_all_dofs();
+      }
+
+      // Unless we've been told that the user-defined actions don't need
+      // them, make sure the halo values are up to date before calling them
+      if (!Newton_step_actions_only_use_local_values)
+      {
+        this->finish_synchronise_dofs();
+      }
 #endif
 
       // Do any updates that are required
@@ -10961,6 +11604,14 @@ namespace oomph
   void Problem::unsteady_newton_solve(const double& dt,
                                       const bool& shift_values)
   {
+#ifdef OOMPH_HAS_MPI
+    // Re-distribute the elements if the load has become too imbalanced
+    if (Automatic_load_balancing && Problem_has_been_distributed)
+    {
+      load_balance_if_imbalanced();
+    }
+#endif
+
     // Shift the time values and the dts, according to the control flag
     if (shift_values)
     {
@@ -11631,6 +12282,11 @@ namespace oomph
     // Move the values of dt in the Time object
     Time_pt->shift_dt();
 
+    // If the out-of-core storage has been released from the resident
+    // memory, read it back in bulk (rather than page by page) before
+    // the values are accessed
+    OutOfCoreStorage::prefetch();
+
     // Only shift time values in the "master" mesh, otherwise things will
     // get shifted twice in complex problems
     Mesh_pt->shift_time_values();
@@ -12075,12 +12731,12 @@ namespace oomph
     const int my_rank = this->communicator_pt()->my_rank();
 
     // Record destination of all base elements
-    unsigned n = Base_mesh_element_pt.size();
+    unsigned n = nbase_mesh_element();
     Vector<int> local_base_element_processor(n, -1);
     Vector<int> base_element_processor(n, -1);
     for (unsigned e = 0; e < n; e++)
     {
-      GeneralisedElement* el_pt = Base_mesh_element_pt[e];
+      GeneralisedElement* el_pt = base_mesh_element_pt(e);
       if (el_pt != 0)
       {
         if (!el_pt->is_halo())
@@ -12535,7 +13191,7 @@ namespace oomph
 
     // Get number of base elements as recorded
     unsigned n_base_element_read_in = atoi(input_string.c_str());
-    unsigned nbase = Base_mesh_element_pt.size();
+    unsigned nbase = nbase_mesh_element();
     if (restart_file_is_open)
     {
       if (n_base_element_read_in != nbase)
@@ -13219,123 +13875,2470 @@ namespace oomph
     }
   }
 
-  //===================================================================
-  /// Set all timesteps to the same value, dt, and assign
-  /// weights for all timesteppers in the problem.
-  //===================================================================
-  void Problem::initialise_dt(const double& dt)
+  //=========================================================================
+  /// Helper function for binary restarts: Get the layout of all restart
+  /// data and pointers to all doubles to be dumped/read, in the same
+  /// order as the layout: For each (sub)mesh the number of nodes, then for
+  /// each node (in the standard ordering used by Mesh::dump(...)) the
+  /// number of Lagrangian coordinates (zero for non-SolidNodes), the number
+  /// of positional values and positional history values, the number of
+  /// values and history values; then for each element the number of
+  /// internal Data and, for each of them, the number of values and
+  /// history values. Finally the number of global Data and their number
+  /// of values and history values.
+  //=========================================================================
+  void Problem::get_binary_restart_data(
+    Vector<unsigned>& layout, Vector<double*>& restart_value_pt) const
   {
-    // Initialise the timesteps in the Problem's time object
-    Time_pt->initialise_dt(dt);
+    layout.clear();
+    restart_value_pt.clear();
 
-    // Find out how many timesteppers there are
-    unsigned n_time_steppers = ntime_stepper();
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    layout.push_back(n_mesh);
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      Mesh* m_pt = mesh_pt(m);
 
-    // Loop over them all and set the weights
-    for (unsigned i = 0; i < n_time_steppers; i++)
+      // Standard ordering of the nodes (as in Mesh::dump(...))
+      Vector<Node*> reordering;
+      m_pt->get_node_reordering(reordering);
+      unsigned n_node = reordering.size();
+      layout.push_back(n_node);
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        Node* nod_pt = reordering[j];
+
+        // Lagrangian coordinates
+        SolidNode* solid_nod_pt = dynamic_cast<SolidNode*>(nod_pt);
+        if (solid_nod_pt != 0)
+        {
+          unsigned n_lagrangian = solid_nod_pt->nlagrangian();
+          unsigned n_lagrangian_type = solid_nod_pt->nlagrangian_type();
+          layout.push_back(n_lagrangian * n_lagrangian_type);
+          for (unsigned i = 0; i < n_lagrangian; i++)
+          {
+            for (unsigned k = 0; k < n_lagrangian_type; k++)
+            {
+              restart_value_pt.push_back(&solid_nod_pt->xi_gen(k, i));
+            }
+          }
+        }
+        else
+        {
+          layout.push_back(0);
+        }
+
+        // Positions
+        unsigned n_dim = nod_pt->ndim();
+        unsigned n_position_type = nod_pt->nposition_type();
+        unsigned n_position_time =
+          nod_pt->position_time_stepper_pt()->ntstorage();
+        layout.push_back(n_dim * n_position_type);
+        layout.push_back(n_position_time);
+        for (unsigned t = 0; t < n_position_time; t++)
+        {
+          for (unsigned i = 0; i < n_dim; i++)
+          {
+            for (unsigned k = 0; k < n_position_type; k++)
+            {
+              restart_value_pt.push_back(&nod_pt->x_gen(t, k, i));
+            }
+          }
+        }
+
+        // Values
+        unsigned n_value = nod_pt->nvalue();
+        unsigned n_time = nod_pt->ntstorage();
+        layout.push_back(n_value);
+        layout.push_back(n_time);
+        for (unsigned t = 0; t < n_time; t++)
+        {
+          for (unsigned i = 0; i < n_value; i++)
+          {
+            restart_value_pt.push_back(nod_pt->value_pt(t, i));
+          }
+        }
+      }
+
+      // Internal data
+      unsigned n_element = m_pt->nelement();
+      layout.push_back(n_element);
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        GeneralisedElement* el_pt = m_pt->element_pt(e);
+        unsigned n_internal = el_pt->ninternal_data();
+        layout.push_back(n_internal);
+        for (unsigned l = 0; l < n_internal; l++)
+        {
+          Data* data_pt = el_pt->internal_data_pt(l);
+          unsigned n_value = data_pt->nvalue();
+          unsigned n_time = data_pt->ntstorage();
+          layout.push_back(n_value);
+          layout.push_back(n_time);
+          for (unsigned t = 0; t < n_time; t++)
+          {
+            for (unsigned i = 0; i < n_value; i++)
+            {
+              restart_value_pt.push_back(data_pt->value_pt(t, i));
+            }
+          }
+        }
+      }
+    }
+
+    // Global data
+    unsigned n_global = Global_data_pt.size();
+    layout.push_back(n_global);
+    for (unsigned g = 0; g < n_global; g++)
     {
-      time_stepper_pt(i)->set_weights();
-      if (time_stepper_pt(i)->adaptive_flag())
+      Data* data_pt = Global_data_pt[g];
+      unsigned n_value = data_pt->nvalue();
+      unsigned n_time = data_pt->ntstorage();
+      layout.push_back(n_value);
+      layout.push_back(n_time);
+      for (unsigned t = 0; t < n_time; t++)
       {
-        time_stepper_pt(i)->set_error_weights();
+        for (unsigned i = 0; i < n_value; i++)
+        {
+          restart_value_pt.push_back(data_pt->value_pt(t, i));
+        }
       }
     }
   }
 
+
   //=========================================================================
-  /// Set the value of the timesteps to be equal to the values passed in
-  /// a vector and assign weights for all timesteppers in the problem
-  //========================================================================
-  void Problem::initialise_dt(const Vector<double>& dt)
+  /// Helper function for binary restarts: Get the numbers of the base
+  /// elements this processor is in charge of (empty if the Problem isn't
+  /// distributed) and the flat-packed refinement patterns of the
+  /// tree-based refineable (sub)meshes (zero levels for other meshes).
+  //=========================================================================
+  void Problem::get_binary_restart_structure(
+    Vector<unsigned>& non_halo_base_element,
+    Vector<unsigned>& flat_packed_refinement_pattern) const
   {
-    // Initialise the timesteps in the Problem's time object
-    Time_pt->initialise_dt(dt);
-
-    // Find out how many timesteppers there are
-    unsigned n_time_steppers = ntime_stepper();
+    non_halo_base_element.clear();
+#ifdef OOMPH_HAS_MPI
+    if (Problem_has_been_distributed)
+    {
+      for (std::map<GeneralisedElement*, unsigned>::const_iterator it =
+             Base_mesh_element_number_plus_one.begin();
+           it != Base_mesh_element_number_plus_one.end();
+           it++)
+      {
+        // Zero indicates elements that have been pruned
+        if ((it->second > 0) && (!it->first->is_halo()))
+        {
+          non_halo_base_element.push_back(it->second - 1);
+        }
+      }
+      std::sort(non_halo_base_element.begin(), non_halo_base_element.end());
+    }
+#endif
 
-    // Loop over them all and set the weights
-    for (unsigned i = 0; i < n_time_steppers; i++)
+    flat_packed_refinement_pattern.clear();
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    flat_packed_refinement_pattern.push_back(n_mesh);
+    for (unsigned m = 0; m < n_mesh; m++)
     {
-      time_stepper_pt(i)->set_weights();
-      if (time_stepper_pt(i)->adaptive_flag())
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(mesh_pt(m));
+      Vector<Vector<unsigned>> to_be_refined;
+      if ((tree_mesh_pt != 0) && (tree_mesh_pt->forest_pt() != 0))
       {
-        time_stepper_pt(i)->set_error_weights();
+        tree_mesh_pt->get_refinement_pattern(to_be_refined);
+      }
+      unsigned n_level = to_be_refined.size();
+      flat_packed_refinement_pattern.push_back(n_level);
+      for (unsigned l = 0; l < n_level; l++)
+      {
+        unsigned n_refined = to_be_refined[l].size();
+        flat_packed_refinement_pattern.push_back(n_refined);
+        for (unsigned j = 0; j < n_refined; j++)
+        {
+          flat_packed_refinement_pattern.push_back(to_be_refined[l][j]);
+        }
       }
     }
   }
 
-  //========================================================
-  /// Self-test: Check meshes and global data. Return 0 for OK
-  //========================================================
-  unsigned Problem::self_test()
+
+#ifdef OOMPH_HAS_MPI
+  //=========================================================================
+  /// Helper function for binary restarts: Load balance the (distributed)
+  /// Problem such that each processor is in charge of the base elements
+  /// listed in non_halo_base_element. Nobody knows where the base
+  /// elements are now, so processor b%nproc acts as the "directory" for
+  /// base element b: It's told which processor has to be in charge of
+  /// it and passes this on to the processor that's currently in charge
+  /// of it.
+  //=========================================================================
+  void Problem::load_balance_as_in_binary_restart(
+    const Vector<unsigned>& non_halo_base_element)
   {
-    // Initialise
-    bool passed = true;
+    OomphCommunicator* comm_pt = this->communicator_pt();
+    unsigned n_proc = comm_pt->nproc();
+    unsigned my_rank = comm_pt->my_rank();
 
-    // Are there any submeshes?
-    unsigned Nmesh = nsub_mesh();
+    // Tell the directories which base elements we have to be in charge of
+    Vector<Vector<unsigned long>> send_data(n_proc);
+    unsigned n_recorded = non_halo_base_element.size();
+    for (unsigned j = 0; j < n_recorded; j++)
+    {
+      unsigned e_base = non_halo_base_element[j];
+      send_data[e_base % n_proc].push_back(e_base);
+    }
+    Vector<Vector<unsigned long>> received_data;
+    METIS::sparse_all_to_all(comm_pt, send_data, received_data);
+    std::map<unsigned long, unsigned> target_domain_for_base_element;
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      unsigned n_received = received_data[p].size();
+      for (unsigned j = 0; j < n_received; j++)
+      {
+        target_domain_for_base_element[received_data[p][j]] = p;
+      }
+    }
 
-    // Just one mesh: Check it
-    if (Nmesh == 0)
+    // Get the base element numbers of the local non-halo elements (in the
+    // order in which they're encountered in the global mesh). Elements
+    // in refineable meshes move with their root; FaceElements move with
+    // their bulk elements.
+    std::string error_message;
+    Vector<unsigned> local_base_element;
+    unsigned n_element = mesh_pt()->nelement();
+    for (unsigned e = 0; e < n_element; e++)
     {
-      if (mesh_pt()->self_test() != 0)
+      GeneralisedElement* el_pt = mesh_pt()->element_pt(e);
+      if (el_pt->is_halo()) continue;
+
+      FaceElement* face_el_pt = dynamic_cast<FaceElement*>(el_pt);
+      if ((face_el_pt != 0) &&
+          (Base_mesh_element_number_plus_one[el_pt] == 0))
       {
-        passed = false;
-        oomph_info
-          << "\n ERROR: Failed Mesh::self_test() for single mesh in problem"
-          << std::endl;
+        el_pt = face_el_pt->bulk_element_pt();
+      }
+      RefineableElement* ref_el_pt = dynamic_cast<RefineableElement*>(el_pt);
+      if (ref_el_pt != 0)
+      {
+        el_pt = ref_el_pt->root_element_pt();
+      }
+
+      unsigned el_number_in_base_mesh_plus_one =
+        Base_mesh_element_number_plus_one[el_pt];
+      if (el_number_in_base_mesh_plus_one == 0)
+      {
+        error_message = "Non-halo element isn't associated with a base "
+                        "element so the Problem\ncan't be redistributed "
+                        "as in the binary restart file.\n";
+        break;
       }
+      local_base_element.push_back(el_number_in_base_mesh_plus_one - 1);
     }
-    // Loop over all submeshes and check them
-    else
+    checkpoint_collective_error_check(error_message);
+
+    // Ask the directories where they have to go...
+    for (unsigned p = 0; p < n_proc; p++)
     {
-      for (unsigned imesh = 0; imesh < Nmesh; imesh++)
+      send_data[p].clear();
+    }
+    unsigned n_local = local_base_element.size();
+    for (unsigned j = 0; j < n_local; j++)
+    {
+      unsigned e_base = local_base_element[j];
+      send_data[e_base % n_proc].push_back(e_base);
+    }
+    METIS::sparse_all_to_all(comm_pt, send_data, received_data);
+
+    // ...and reply in the order of the requests (n_proc indicates
+    // base elements that nobody has to be in charge of)
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      send_data[p].clear();
+      unsigned n_received = received_data[p].size();
+      for (unsigned j = 0; j < n_received; j++)
       {
-        if (mesh_pt(imesh)->self_test() != 0)
+        std::map<unsigned long, unsigned>::iterator it =
+          target_domain_for_base_element.find(received_data[p][j]);
+        if (it == target_domain_for_base_element.end())
         {
-          passed = false;
-          oomph_info << "\n ERROR: Failed Mesh::self_test() for mesh imesh"
-                     << imesh << std::endl;
+          send_data[p].push_back(n_proc);
+        }
+        else
+        {
+          send_data[p].push_back(it->second);
         }
       }
     }
+    Vector<Vector<unsigned long>> target_domain_received;
+    METIS::sparse_all_to_all(comm_pt, send_data, target_domain_received);
 
-
-    // Check global data
-    unsigned Nglobal = Global_data_pt.size();
-    for (unsigned iglobal = 0; iglobal < Nglobal; iglobal++)
+    // Target domains for the local non-halo elements
+    Vector<unsigned> target_domain_for_local_non_halo_element(n_local);
+    Vector<unsigned> count(n_proc, 0);
+    unsigned local_load_balance_required_flag = 0;
+    for (unsigned j = 0; j < n_local; j++)
     {
-      if (Global_data_pt[iglobal]->self_test() != 0)
+      unsigned p = local_base_element[j] % n_proc;
+      unsigned target_domain = target_domain_received[p][count[p]];
+      count[p]++;
+      if (target_domain == n_proc)
       {
-        passed = false;
-        oomph_info
-          << "\n ERROR: Failed Data::self_test() for global data iglobal"
-          << iglobal << std::endl;
+        std::ostringstream error_stream;
+        error_stream << "No processor was in charge of base element "
+                     << local_base_element[j]
+                     << " when the binary\nrestart file was written.\n";
+        error_message = error_stream.str();
+        break;
+      }
+      target_domain_for_local_non_halo_element[j] = target_domain;
+      if (target_domain != my_rank)
+      {
+        local_load_balance_required_flag = 1;
       }
     }
+    checkpoint_collective_error_check(error_message);
 
-
-#ifdef OOMPH_HAS_MPI
-
-    if (Problem_has_been_distributed)
+    // Do we need to load balance?
+    unsigned load_balance_required_flag = 0;
+    MPI_Allreduce(&local_load_balance_required_flag,
+                  &load_balance_required_flag,
+                  1,
+                  MPI_UNSIGNED,
+                  MPI_MAX,
+                  comm_pt->mpi_comm());
+    if (load_balance_required_flag == 1)
     {
-      // Note: This throws an error if it fails so no return is required.
-      DocInfo tmp_doc_info;
-      tmp_doc_info.disable_doc();
-      check_halo_schemes(tmp_doc_info);
+      oomph_info << "Load balancing as in binary restart file\n";
+      DocInfo doc_info;
+      doc_info.disable_doc();
+      bool report_stats = false;
+      load_balance(
+        doc_info, report_stats, target_domain_for_local_non_halo_element);
     }
+  }
+#endif
 
+
+  //=========================================================================
+  /// Dump time, timesteps and all Data values (incl. history values),
+  /// nodal positions and Lagrangian coordinates to a versioned,
+  /// checksummed binary restart file. The data is gathered into
+  /// contiguous arrays and written in bulk. File format:
+  /// - Header: "OOMPHRST", format version, byte order marker,
+  ///   number of processors and rank of the writing processor.
+  /// - Unsteady flag, time, number of timesteps and the timesteps.
+  /// - Distributed flag, number of base elements in the global mesh,
+  ///   number and entries of the base elements the processor is in
+  ///   charge of, length and entries of the flat-packed refinement
+  ///   pattern (see get_binary_restart_structure(...)).
+  /// - Length and entries of the layout (see get_binary_restart_data(...)).
+  /// - Number of doubles and the doubles.
+  /// - Checksum of the time data, distribution, refinement pattern,
+  ///   layout and doubles.
+  //=========================================================================
+  void Problem::dump_binary(std::ofstream& dump_file) const
+  {
+    // Header
+    const char magic[8] = {'O', 'O', 'M', 'P', 'H', 'R', 'S', 'T'};
+    dump_file.write(magic, 8);
+    unsigned version = Binary_restart_format_version;
+    dump_file.write(reinterpret_cast<const char*>(&version), sizeof(unsigned));
+    unsigned byte_order_marker = 0x01020304;
+    dump_file.write(reinterpret_cast<const char*>(&byte_order_marker),
+                    sizeof(unsigned));
+    int n_proc = 1;
+    int my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    n_proc = this->communicator_pt()->nproc();
+    my_rank = this->communicator_pt()->my_rank();
 #endif
+    dump_file.write(reinterpret_cast<const char*>(&n_proc), sizeof(int));
+    dump_file.write(reinterpret_cast<const char*>(&my_rank), sizeof(int));
 
-    // Return verdict
-    if (passed)
+    // Time
+    unsigned long long checksum = Checksum::Initial_value;
+    unsigned unsteady_flag = (time_pt() != 0);
+    double time = 0.0;
+    Vector<double> dt;
+    if (unsteady_flag)
     {
-      return 0;
+      time = time_pt()->time();
+      unsigned n_dt = time_pt()->ndt();
+      dt.resize(n_dt);
+      for (unsigned i = 0; i < n_dt; i++)
+      {
+        dt[i] = time_pt()->dt(i);
+      }
     }
-    else
+    unsigned n_dt = dt.size();
+    dump_file.write(reinterpret_cast<const char*>(&unsteady_flag),
+                    sizeof(unsigned));
+    dump_file.write(reinterpret_cast<const char*>(&time), sizeof(double));
+    dump_file.write(reinterpret_cast<const char*>(&n_dt), sizeof(unsigned));
+    Checksum::update(checksum, &time, sizeof(double));
+    if (n_dt > 0)
     {
-      return 1;
+      dump_file.write(reinterpret_cast<const char*>(&dt[0]),
+                      n_dt * sizeof(double));
+      Checksum::update(checksum, &dt[0], n_dt * sizeof(double));
+    }
+
+    // Distribution and refinement pattern
+    Vector<unsigned> structure(3, 0);
+    structure[0] = distributed();
+#ifdef OOMPH_HAS_MPI
+    structure[1] = nbase_mesh_element();
+#endif
+    Vector<unsigned> non_halo_base_element;
+    Vector<unsigned> flat_packed_refinement_pattern;
+    get_binary_restart_structure(non_halo_base_element,
+                                 flat_packed_refinement_pattern);
+    structure[2] = non_halo_base_element.size();
+    structure.insert(structure.end(),
+                     non_halo_base_element.begin(),
+                     non_halo_base_element.end());
+    structure.push_back(flat_packed_refinement_pattern.size());
+    structure.insert(structure.end(),
+                     flat_packed_refinement_pattern.begin(),
+                     flat_packed_refinement_pattern.end());
+    unsigned long long n_structure = structure.size();
+    dump_file.write(reinterpret_cast<const char*>(&n_structure),
+                    sizeof(unsigned long long));
+    dump_file.write(reinterpret_cast<const char*>(&structure[0]),
+                    n_structure * sizeof(unsigned));
+    Checksum::update(checksum, &structure[0], n_structure * sizeof(unsigned));
+
+    // Layout and pointers to the values
+    Vector<unsigned> layout;
+    Vector<double*> restart_value_pt;
+    get_binary_restart_data(layout, restart_value_pt);
+
+    unsigned long long n_layout = layout.size();
+    dump_file.write(reinterpret_cast<const char*>(&n_layout),
+                    sizeof(unsigned long long));
+    dump_file.write(reinterpret_cast<const char*>(&layout[0]),
+                    n_layout * sizeof(unsigned));
+    Checksum::update(checksum, &layout[0], n_layout * sizeof(unsigned));
+
+    // Gather the values into contiguous storage and write them in one go
+    unsigned long long n_value = restart_value_pt.size();
+    dump_file.write(reinterpret_cast<const char*>(&n_value),
+                    sizeof(unsigned long long));
+    if (n_value > 0)
+    {
+      Vector<double> restart_value(n_value);
+      for (unsigned long long j = 0; j < n_value; j++)
+      {
+        restart_value[j] = *restart_value_pt[j];
+      }
+      dump_file.write(reinterpret_cast<const char*>(&restart_value[0]),
+                      n_value * sizeof(double));
+      Checksum::update(checksum, &restart_value[0], n_value * sizeof(double));
+    }
+
+    // Checksum
+    dump_file.write(reinterpret_cast<const char*>(&checksum),
+                    sizeof(unsigned long long));
+
+    if (dump_file.fail())
+    {
+      throw OomphLibError("Error while writing binary restart file.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
+  //=========================================================================
+  /// Read Problem data from a binary restart file written by
+  /// dump_binary(...). The entire file is read and its header and
+  /// checksum are checked before anything is changed. Then the Problem
+  /// is redistributed and refined as recorded in the file (format
+  /// version 2 onwards) and the layout of the Data is checked before the
+  /// values are overwritten. Any errors are thrown on all processors.
+  /// Return flag to indicate if the restart was from a steady or
+  /// unsteady solution.
+  //=========================================================================
+  void Problem::read_binary(std::ifstream& restart_file,
+                            bool& unsteady_restart)
+  {
+    int n_proc = 1;
+    int my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    n_proc = this->communicator_pt()->nproc();
+    my_rank = this->communicator_pt()->my_rank();
+#endif
+
+    // Read the whole file (errors are collected so they can be thrown
+    // on all processors)
+    std::string error_message;
+    unsigned version = 0;
+    unsigned unsteady_flag = 0;
+    double time = 0.0;
+    Vector<double> dt;
+    Vector<unsigned> structure;
+    Vector<unsigned> layout_read;
+    Vector<double> restart_value;
+    try
+    {
+      if (!restart_file.is_open())
+      {
+        throw OomphLibError("Binary restart file isn't open.\n",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Header
+      char magic[8];
+      restart_file.read(magic, 8);
+      if (restart_file.fail() || (std::string(magic, 8) != "OOMPHRST"))
+      {
+        throw OomphLibError("File is not a binary oomph-lib restart file.\n",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+      restart_file.read(reinterpret_cast<char*>(&version), sizeof(unsigned));
+      unsigned byte_order_marker = 0;
+      restart_file.read(reinterpret_cast<char*>(&byte_order_marker),
+                        sizeof(unsigned));
+      if (byte_order_marker != 0x01020304)
+      {
+        throw OomphLibError(
+          "Binary restart file was written on a machine with different "
+          "byte order.\nConvert it to the text format (using "
+          "convert_binary_restart_file(...))\non the original machine.\n",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+      if (version > Binary_restart_format_version)
+      {
+        std::ostringstream error_stream;
+        error_stream << "Binary restart file has format version " << version
+                     << " but we can only read versions up to "
+                     << Binary_restart_format_version << std::endl;
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+      int n_proc_read = 0;
+      int my_rank_read = 0;
+      restart_file.read(reinterpret_cast<char*>(&n_proc_read), sizeof(int));
+      restart_file.read(reinterpret_cast<char*>(&my_rank_read), sizeof(int));
+      if ((n_proc_read != n_proc) || (my_rank_read != my_rank))
+      {
+        std::ostringstream error_stream;
+        error_stream << "Binary restart file was written by processor "
+                     << my_rank_read << " of " << n_proc_read
+                     << " but is being read by processor " << my_rank
+                     << " of " << n_proc << ".\nBinary restarts require "
+                     << "the same number of processors.\n";
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Time
+      unsigned long long checksum = Checksum::Initial_value;
+      unsigned n_dt = 0;
+      restart_file.read(reinterpret_cast<char*>(&unsteady_flag),
+                        sizeof(unsigned));
+      restart_file.read(reinterpret_cast<char*>(&time), sizeof(double));
+      restart_file.read(reinterpret_cast<char*>(&n_dt), sizeof(unsigned));
+      Checksum::update(checksum, &time, sizeof(double));
+      if (restart_file.fail())
+      {
+        throw OomphLibError("Binary restart file is truncated.\n",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+      dt.resize(n_dt);
+      if (n_dt > 0)
+      {
+        restart_file.read(reinterpret_cast<char*>(&dt[0]),
+                          n_dt * sizeof(double));
+        Checksum::update(checksum, &dt[0], n_dt * sizeof(double));
+      }
+
+      // Distribution and refinement pattern (not in version 1), layout
+      // and values: Read them in one go each (after checking that the
+      // file is large enough; their lengths could be corrupted)
+      std::streampos position = restart_file.tellg();
+      restart_file.seekg(0, std::ios::end);
+      unsigned long long n_byte_left = restart_file.tellg() - position;
+      restart_file.seekg(position);
+      unsigned n_block = 3;
+      if (version < 2)
+      {
+        n_block = 2;
+      }
+      for (unsigned b = 0; b < n_block; b++)
+      {
+        unsigned long long n_entry = 0;
+        restart_file.read(reinterpret_cast<char*>(&n_entry),
+                          sizeof(unsigned long long));
+        unsigned entry_size = sizeof(unsigned);
+        if (b == n_block - 1)
+        {
+          entry_size = sizeof(double);
+        }
+        if (restart_file.fail() ||
+            (n_entry > n_byte_left / (unsigned long long)(entry_size)))
+        {
+          throw OomphLibError(
+            "Binary restart file is truncated or corrupted.\n",
+            OOMPH_CURRENT_FUNCTION,
+            OOMPH_EXCEPTION_LOCATION);
+        }
+        if (n_entry == 0) continue;
+        char* block_pt = 0;
+        if (b == n_block - 1)
+        {
+          restart_value.resize(n_entry);
+          block_pt = reinterpret_cast<char*>(&restart_value[0]);
+        }
+        else if (b == n_block - 2)
+        {
+          layout_read.resize(n_entry);
+          block_pt = reinterpret_cast<char*>(&layout_read[0]);
+        }
+        else
+        {
+          structure.resize(n_entry);
+          block_pt = reinterpret_cast<char*>(&structure[0]);
+        }
+        restart_file.read(block_pt, n_entry * entry_size);
+        Checksum::update(checksum, block_pt, n_entry * entry_size);
+      }
+
+      // Validate the checksum before changing anything
+      unsigned long long checksum_read = 0;
+      restart_file.read(reinterpret_cast<char*>(&checksum_read),
+                        sizeof(unsigned long long));
+      if (restart_file.fail() || (checksum_read != checksum))
+      {
+        throw OomphLibError(
+          "Binary restart file is truncated or corrupted (checksum "
+          "mismatch).\n",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+    catch (OomphLibError&)
+    {
+      // The error's description is issued when it goes out of scope
+      error_message = "Error while reading the binary restart file.\n";
+    }
+    checkpoint_collective_error_check(error_message);
+
+    // Unpack the distribution and refinement pattern
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    if (version >= 2)
+    {
+      // (Entries are only accessed after checking that they're
+      // there: The checksum doesn't protect against bugs)
+      unsigned n_structure = structure.size();
+      unsigned distributed_flag = 0;
+      unsigned n_base_element = 0;
+      Vector<unsigned> non_halo_base_element;
+      Vector<Vector<Vector<unsigned>>> to_be_refined(n_mesh);
+      bool corrupted = (n_structure < 3);
+      unsigned k = 0;
+      if (!corrupted)
+      {
+        distributed_flag = structure[0];
+        n_base_element = structure[1];
+        k = 3 + structure[2];
+        corrupted = (k >= n_structure);
+      }
+      if (!corrupted)
+      {
+        non_halo_base_element.assign(structure.begin() + 3,
+                                     structure.begin() + k);
+        k++;
+        corrupted = (k >= n_structure);
+      }
+      if ((!corrupted) && (structure[k] != n_mesh))
+      {
+        std::ostringstream error_stream;
+        error_stream << "Binary restart file contains the refinement "
+                     << "patterns of " << structure[k] << " meshes\nbut the "
+                     << "Problem has " << n_mesh << ".\n";
+        error_message = error_stream.str();
+      }
+      k++;
+      for (unsigned m = 0;
+           (m < n_mesh) && (!corrupted) && (error_message == "");
+           m++)
+      {
+        corrupted = (k >= n_structure);
+        if (corrupted) break;
+        unsigned n_level = structure[k];
+        k++;
+        to_be_refined[m].resize(n_level);
+        for (unsigned l = 0; (l < n_level) && (!corrupted); l++)
+        {
+          corrupted = (k >= n_structure) || (k + structure[k] >= n_structure);
+          if (corrupted) break;
+          unsigned n_refined = structure[k];
+          k++;
+          to_be_refined[m][l].assign(structure.begin() + k,
+                                     structure.begin() + k + n_refined);
+          k += n_refined;
+        }
+      }
+      if ((error_message == "") && (corrupted || (k != n_structure)))
+      {
+        error_message = "Distribution or refinement pattern in binary "
+                        "restart file is corrupted.\n";
+      }
+
+      // Check that the Problem is set up in the same way
+      if ((error_message == "") &&
+          ((distributed_flag != unsigned(distributed()))
+#ifdef OOMPH_HAS_MPI
+           || (n_base_element != nbase_mesh_element())
+#endif
+             ))
+      {
+        std::ostringstream error_stream;
+        error_stream << "Binary restart file was written by a ";
+        if (distributed_flag == 0)
+        {
+          error_stream << "non-";
+        }
+        error_stream << "distributed Problem with " << n_base_element
+                     << " base elements.\nHas the Problem been set up "
+                     << "(and distributed) in the same way?\n";
+        error_message = error_stream.str();
+      }
+      checkpoint_collective_error_check(error_message);
+
+      // Redistribute and refine as when the file was written
+#ifdef OOMPH_HAS_MPI
+      if (distributed())
+      {
+        load_balance_as_in_binary_restart(non_halo_base_element);
+      }
+#endif
+      refine_as_in_restart(to_be_refined);
+    }
+
+    // Check the layout
+    Vector<unsigned> layout;
+    Vector<double*> restart_value_pt;
+    get_binary_restart_data(layout, restart_value_pt);
+    unsigned long long n_layout = layout.size();
+    if (layout_read.size() != n_layout)
+    {
+      error_message =
+        "Layout of the Data in the binary restart file differs from that\n"
+        "of the Problem. Have the meshes been set up in the same way\n"
+        "as when the file was written?\n";
+    }
+    for (unsigned long long j = 0; (j < n_layout) && (error_message == "");
+         j++)
+    {
+      if (layout_read[j] != layout[j])
+      {
+        std::ostringstream error_stream;
+        error_stream
+          << "Layout of the Data in the binary restart file differs from that\n"
+          << "of the Problem (first difference in entry " << j << " of "
+          << n_layout << ": " << layout_read[j] << " vs. " << layout[j]
+          << ").\nHave the meshes been set up in the same way\n"
+          << "as when the file was written?\n";
+        error_message = error_stream.str();
+      }
+    }
+    unsigned long long n_value = restart_value_pt.size();
+    if ((error_message == "") && (restart_value.size() != n_value))
+    {
+      error_message = "Number of values in binary restart file differs from "
+                      "that in the Problem.\n";
+    }
+
+    // Set the time
+    unsteady_restart = (unsteady_flag == 1);
+    if ((error_message == "") && unsteady_restart && (time_pt() == 0))
+    {
+      error_message = "Binary restart file is from an unsteady run but the "
+                      "Problem has no Time object.\n";
+    }
+    checkpoint_collective_error_check(error_message);
+    if (unsteady_restart)
+    {
+      time_pt()->time() = time;
+      time_pt()->resize(dt.size());
+
+      // Initialise timestep -- also sets the weights for all timesteppers
+      // in the problem.
+      initialise_dt(dt);
+    }
+
+    // Scatter the values
+    for (unsigned long long j = 0; j < n_value; j++)
+    {
+      *restart_value_pt[j] = restart_value[j];
+    }
+  }
+
+
+  //=========================================================================
+  /// Convert a binary restart file (written by dump_binary(...)) to
+  /// the text format written by dump(...) by reading it into this
+  /// Problem and dumping it again.
+  //=========================================================================
+  void Problem::convert_binary_restart_file(
+    const std::string& binary_file_name, const std::string& text_file_name)
+  {
+    std::ifstream binary_file(binary_file_name.c_str(), std::ios::binary);
+    if (!binary_file.is_open())
+    {
+      std::string error_message = "Couldn't open file " + binary_file_name;
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    read_binary(binary_file);
+    binary_file.close();
+
+    dump(text_file_name);
+  }
+
+
+  //=========================================================================
+  /// Helper function for checkpoints: Append the restart data of the
+  /// specified Data to the vector. The layout (number of Lagrangian
+  /// coordinates, positions, values and history values) is included
+  /// so it can be checked when the data is read.
+  //=========================================================================
+  void Problem::pack_checkpoint_data(Data* const& data_pt,
+                                     Vector<double>& data)
+  {
+    Node* nod_pt = dynamic_cast<Node*>(data_pt);
+    if (nod_pt != 0)
+    {
+      // Lagrangian coordinates
+      SolidNode* solid_nod_pt = dynamic_cast<SolidNode*>(nod_pt);
+      if (solid_nod_pt != 0)
+      {
+        unsigned n_lagrangian = solid_nod_pt->nlagrangian();
+        unsigned n_lagrangian_type = solid_nod_pt->nlagrangian_type();
+        data.push_back(double(n_lagrangian * n_lagrangian_type));
+        for (unsigned i = 0; i < n_lagrangian; i++)
+        {
+          for (unsigned k = 0; k < n_lagrangian_type; k++)
+          {
+            data.push_back(solid_nod_pt->xi_gen(k, i));
+          }
+        }
+      }
+      else
+      {
+        data.push_back(0.0);
+      }
+
+      // Positions
+      unsigned n_dim = nod_pt->ndim();
+      unsigned n_position_type = nod_pt->nposition_type();
+      unsigned n_position_time =
+        nod_pt->position_time_stepper_pt()->ntstorage();
+      data.push_back(double(n_dim * n_position_type));
+      data.push_back(double(n_position_time));
+      for (unsigned t = 0; t < n_position_time; t++)
+      {
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          for (unsigned k = 0; k < n_position_type; k++)
+          {
+            data.push_back(nod_pt->x_gen(t, k, i));
+          }
+        }
+      }
+    }
+
+    // Values
+    unsigned n_value = data_pt->nvalue();
+    unsigned n_time = data_pt->ntstorage();
+    data.push_back(double(n_value));
+    data.push_back(double(n_time));
+    for (unsigned t = 0; t < n_time; t++)
+    {
+      for (unsigned i = 0; i < n_value; i++)
+      {
+        data.push_back(*data_pt->value_pt(t, i));
+      }
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for checkpoints: Check that entry index of data
+  /// (a layout entry written by pack_checkpoint_data(...)) is equal to
+  /// the expected value and increment index
+  //=========================================================================
+  void Problem::check_checkpoint_layout(const Vector<double>& data,
+                                        unsigned long& index,
+                                        const unsigned& expected_value)
+  {
+    if ((index >= data.size()) || (unsigned(data[index]) != expected_value))
+    {
+      throw OomphLibError(
+        "Layout of the Data in the checkpoint differs from that of the "
+        "Problem.\nAre the meshes refined in the same way as when the "
+        "checkpoint was written?\n",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+    index++;
+  }
+
+
+  //=========================================================================
+  /// Helper function for checkpoints: Check that data contains at least
+  /// n_entry entries, starting at entry index
+  //=========================================================================
+  void Problem::check_checkpoint_size(const Vector<double>& data,
+                                      const unsigned long& index,
+                                      const unsigned long& n_entry)
+  {
+    if (index + n_entry > data.size())
+    {
+      throw OomphLibError("Checkpoint record is too short.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for checkpoints: Set the restart data of the
+  /// specified Data from data (written by pack_checkpoint_data(...)),
+  /// starting at entry index (which is incremented). The layout
+  /// of the Data must agree with that recorded in the data.
+  //=========================================================================
+  void Problem::unpack_checkpoint_data(Data* const& data_pt,
+                                       const Vector<double>& data,
+                                       unsigned long& index)
+  {
+    Node* nod_pt = dynamic_cast<Node*>(data_pt);
+    if (nod_pt != 0)
+    {
+      // Lagrangian coordinates
+      SolidNode* solid_nod_pt = dynamic_cast<SolidNode*>(nod_pt);
+      unsigned n_lagrangian = 0;
+      unsigned n_lagrangian_type = 0;
+      if (solid_nod_pt != 0)
+      {
+        n_lagrangian = solid_nod_pt->nlagrangian();
+        n_lagrangian_type = solid_nod_pt->nlagrangian_type();
+      }
+      check_checkpoint_layout(data, index, n_lagrangian * n_lagrangian_type);
+      check_checkpoint_size(data, index, n_lagrangian * n_lagrangian_type);
+      for (unsigned i = 0; i < n_lagrangian; i++)
+      {
+        for (unsigned k = 0; k < n_lagrangian_type; k++)
+        {
+          solid_nod_pt->xi_gen(k, i) = data[index++];
+        }
+      }
+
+      // Positions
+      unsigned n_dim = nod_pt->ndim();
+      unsigned n_position_type = nod_pt->nposition_type();
+      unsigned n_position_time =
+        nod_pt->position_time_stepper_pt()->ntstorage();
+      check_checkpoint_layout(data, index, n_dim * n_position_type);
+      check_checkpoint_layout(data, index, n_position_time);
+      check_checkpoint_size(
+        data, index, n_position_time * n_dim * n_position_type);
+      for (unsigned t = 0; t < n_position_time; t++)
+      {
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          for (unsigned k = 0; k < n_position_type; k++)
+          {
+            nod_pt->x_gen(t, k, i) = data[index++];
+          }
+        }
+      }
+    }
+
+    // Values
+    unsigned n_value = data_pt->nvalue();
+    unsigned n_time = data_pt->ntstorage();
+    check_checkpoint_layout(data, index, n_value);
+    check_checkpoint_layout(data, index, n_time);
+    check_checkpoint_size(data, index, n_time * n_value);
+    for (unsigned t = 0; t < n_time; t++)
+    {
+      for (unsigned i = 0; i < n_value; i++)
+      {
+        *data_pt->value_pt(t, i) = data[index++];
+      }
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Get the
+  /// (partition-independent) numbers of the base elements. For
+  /// distributed problems these are the numbers assigned in
+  /// distribute(); otherwise we enumerate the elements in the same way
+  /// (consecutively through all (sub)meshes, apart from unstructured ones),
+  /// using the root elements of the forests in tree-based refineable
+  /// meshes, i.e. assuming that distribute() is called before the
+  /// mesh is refined.
+  //=========================================================================
+  void Problem::get_checkpoint_base_element_numbers(
+    std::map<GeneralisedElement*, unsigned>& base_element_number) const
+  {
+    base_element_number.clear();
+
+#ifdef OOMPH_HAS_MPI
+    if (distributed())
+    {
+      for (std::map<GeneralisedElement*, unsigned>::const_iterator it =
+             Base_mesh_element_number_plus_one.begin();
+           it != Base_mesh_element_number_plus_one.end();
+           it++)
+      {
+        // Zero indicates elements that have been pruned
+        if (it->second > 0)
+        {
+          base_element_number[it->first] = it->second - 1;
+        }
+      }
+      return;
+    }
+#endif
+
+    unsigned count = 0;
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      Mesh* m_pt = mesh_pt(m);
+
+      // Unstructured meshes don't have base elements
+      if (dynamic_cast<TriangleMeshBase*>(m_pt) != 0) continue;
+
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(m_pt);
+      if ((tree_mesh_pt != 0) && (tree_mesh_pt->forest_pt() != 0))
+      {
+        unsigned n_tree = tree_mesh_pt->forest_pt()->ntree();
+        for (unsigned i = 0; i < n_tree; i++)
+        {
+          base_element_number
+            [tree_mesh_pt->forest_pt()->tree_pt(i)->object_pt()] = count++;
+        }
+      }
+      else
+      {
+        unsigned n_element = m_pt->nelement();
+        for (unsigned e = 0; e < n_element; e++)
+        {
+          base_element_number[m_pt->element_pt(e)] = count++;
+        }
+      }
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Key
+  /// based on the (bitwise) Lagrangian coordinates of SolidNodes (they
+  /// don't change when the mesh deforms) or the nodal position of
+  /// other nodes
+  //=========================================================================
+  std::string Problem::checkpoint_position_key(Node* const& nod_pt)
+  {
+    std::ostringstream key;
+    key << std::hex;
+    SolidNode* solid_nod_pt = dynamic_cast<SolidNode*>(nod_pt);
+    if (solid_nod_pt != 0)
+    {
+      key << "L";
+      unsigned n_lagrangian = solid_nod_pt->nlagrangian();
+      for (unsigned i = 0; i < n_lagrangian; i++)
+      {
+        double xi = solid_nod_pt->xi(i);
+        unsigned long long bits = 0;
+        std::memcpy(&bits, &xi, sizeof(double));
+        key << bits << ",";
+      }
+    }
+    else
+    {
+      unsigned n_dim = nod_pt->ndim();
+      for (unsigned i = 0; i < n_dim; i++)
+      {
+        double x = nod_pt->x(i);
+        unsigned long long bits = 0;
+        std::memcpy(&bits, &x, sizeof(double));
+        key << bits << ",";
+      }
+    }
+    return key.str();
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Get the
+  /// partition-independent key for the specified element:
+  /// - FaceElements: Key of the bulk element plus face index.
+  /// - Elements in tree-based refineable meshes: Number of the base
+  ///   element from which the element was obtained by refinement, plus
+  ///   the son types along the path through the refinement tree.
+  /// - Other base elements: Number of the base element.
+  /// - Otherwise (e.g. unstructured meshes): The (sorted) position keys
+  ///   of the element's nodes (see checkpoint_position_key(...)).
+  //=========================================================================
+  std::string Problem::checkpoint_element_key(
+    GeneralisedElement* el_pt,
+    const std::map<GeneralisedElement*, unsigned>& base_element_number) const
+  {
+    std::ostringstream key;
+
+    FaceElement* face_el_pt = dynamic_cast<FaceElement*>(el_pt);
+    if ((face_el_pt != 0) && (face_el_pt->bulk_element_pt() != 0))
+    {
+      key << checkpoint_element_key(face_el_pt->bulk_element_pt(),
+                                    base_element_number)
+          << "F" << face_el_pt->face_index();
+      return key.str();
+    }
+
+    std::map<GeneralisedElement*, unsigned>::const_iterator it;
+    RefineableElement* ref_el_pt = dynamic_cast<RefineableElement*>(el_pt);
+    if ((ref_el_pt != 0) && (ref_el_pt->tree_pt() != 0))
+    {
+      // Climb up the tree until we reach a base element
+      Vector<int> son_type;
+      Tree* tree_pt = ref_el_pt->tree_pt();
+      while (tree_pt != 0)
+      {
+        it = base_element_number.find(tree_pt->object_pt());
+        if (it != base_element_number.end())
+        {
+          key << "B" << it->second;
+          for (int l = int(son_type.size()) - 1; l >= 0; l--)
+          {
+            key << "/" << son_type[l];
+          }
+          return key.str();
+        }
+        son_type.push_back(tree_pt->son_type());
+        tree_pt = tree_pt->father_pt();
+      }
+    }
+    else
+    {
+      it = base_element_number.find(el_pt);
+      if (it != base_element_number.end())
+      {
+        key << "B" << it->second;
+        return key.str();
+      }
+    }
+
+    // Fallback: Use the positions of the nodes
+    FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(el_pt);
+    if ((fe_pt == 0) || (fe_pt->nnode() == 0))
+    {
+      throw OomphLibError(
+        "Can't determine a partition-independent key for element that is\n"
+        "neither a base element nor a FiniteElement with nodes.\n",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+    unsigned n_node = fe_pt->nnode();
+    Vector<std::string> node_key(n_node);
+    for (unsigned j = 0; j < n_node; j++)
+    {
+      node_key[j] = checkpoint_position_key(fe_pt->node_pt(j));
+    }
+    std::sort(node_key.begin(), node_key.end());
+    key << "X";
+    for (unsigned j = 0; j < n_node; j++)
+    {
+      key << node_key[j] << ";";
+    }
+    return key.str();
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Get the
+  /// keys of all records and the Data associated with each record:
+  /// - Non-halo nodes in mesh m: "M[m]:N" plus the smallest key of the
+  ///   form [element key]N[local node number] over all elements
+  ///   (incl. halo elements) that contain the node; nodes that aren't
+  ///   part of any element are keyed by their position.
+  /// - Internal data of non-halo elements in mesh m: "M[m]:E" plus the
+  ///   element key.
+  /// - Global data (if requested): "G[g]".
+  //=========================================================================
+  void Problem::get_checkpoint_records(Vector<std::string>& key,
+                                       Vector<Vector<Data*>>& record_data_pt,
+                                       const bool& include_global_data) const
+  {
+    key.clear();
+    record_data_pt.clear();
+
+    std::map<GeneralisedElement*, unsigned> base_element_number;
+    get_checkpoint_base_element_numbers(base_element_number);
+
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      Mesh* m_pt = mesh_pt(m);
+      std::ostringstream prefix_stream;
+      prefix_stream << "M" << m << ":";
+      std::string prefix = prefix_stream.str();
+
+      // Element keys and the nodes' canonical keys
+      std::map<Node*, std::string> node_key;
+      unsigned n_element = m_pt->nelement();
+      Vector<std::string> element_key(n_element);
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        GeneralisedElement* el_pt = m_pt->element_pt(e);
+        element_key[e] = checkpoint_element_key(el_pt, base_element_number);
+        FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(el_pt);
+        if (fe_pt != 0)
+        {
+          unsigned n_node = fe_pt->nnode();
+          for (unsigned j = 0; j < n_node; j++)
+          {
+            std::ostringstream candidate;
+            candidate << element_key[e] << "N" << j;
+            std::map<Node*, std::string>::iterator it =
+              node_key.find(fe_pt->node_pt(j));
+            if ((it == node_key.end()) || (candidate.str() < it->second))
+            {
+              node_key[fe_pt->node_pt(j)] = candidate.str();
+            }
+          }
+        }
+      }
+
+      // Nodes
+      unsigned n_node = m_pt->nnode();
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        Node* nod_pt = m_pt->node_pt(j);
+#ifdef OOMPH_HAS_MPI
+        if (nod_pt->is_halo()) continue;
+#endif
+        std::map<Node*, std::string>::iterator it = node_key.find(nod_pt);
+        if (it != node_key.end())
+        {
+          key.push_back(prefix + "N" + it->second);
+        }
+        else
+        {
+          key.push_back(prefix + "NP" + checkpoint_position_key(nod_pt));
+        }
+        record_data_pt.push_back(Vector<Data*>(1, nod_pt));
+      }
+
+      // Internal data
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        GeneralisedElement* el_pt = m_pt->element_pt(e);
+#ifdef OOMPH_HAS_MPI
+        if (el_pt->is_halo()) continue;
+#endif
+        unsigned n_internal = el_pt->ninternal_data();
+        if (n_internal > 0)
+        {
+          Vector<Data*> internal_data_pt(n_internal);
+          for (unsigned l = 0; l < n_internal; l++)
+          {
+            internal_data_pt[l] = el_pt->internal_data_pt(l);
+          }
+          key.push_back(prefix + "E" + element_key[e]);
+          record_data_pt.push_back(internal_data_pt);
+        }
+      }
+    }
+
+    // Global data
+    if (include_global_data)
+    {
+      unsigned n_global = Global_data_pt.size();
+      for (unsigned g = 0; g < n_global; g++)
+      {
+        std::ostringstream global_key;
+        global_key << "G" << g;
+        key.push_back(global_key.str());
+        record_data_pt.push_back(Vector<Data*>(1, Global_data_pt[g]));
+      }
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Get the
+  /// refinement patterns of the non-halo base elements in tree-based
+  /// refineable meshes, keyed by "M[m]:R" plus the key of the base
+  /// element. The pattern contains the number of sons of all nodes in the
+  /// base element's refinement tree, in the order in which they are
+  /// visited by Tree::stick_all_tree_nodes_into_vector(...), i.e. the
+  /// order in which TreeBasedRefineableMeshBase::get_refinement_pattern(...)
+  /// enumerates the elements.
+  //=========================================================================
+  void Problem::get_checkpoint_refinement_records(
+    Vector<std::string>& key, Vector<Vector<double>>& pattern) const
+  {
+    key.clear();
+    pattern.clear();
+
+    std::map<GeneralisedElement*, unsigned> base_element_number;
+    get_checkpoint_base_element_numbers(base_element_number);
+
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(mesh_pt(m));
+      if ((tree_mesh_pt == 0) || (tree_mesh_pt->forest_pt() == 0)) continue;
+
+      std::ostringstream prefix_stream;
+      prefix_stream << "M" << m << ":R";
+      std::string prefix = prefix_stream.str();
+
+      unsigned n_tree = tree_mesh_pt->forest_pt()->ntree();
+      for (unsigned i = 0; i < n_tree; i++)
+      {
+        Tree* root_pt = tree_mesh_pt->forest_pt()->tree_pt(i);
+        Vector<Tree*> all_tree_nodes_pt;
+        root_pt->stick_all_tree_nodes_into_vector(all_tree_nodes_pt);
+
+#ifdef OOMPH_HAS_MPI
+        // All leaves of a base element live on the same processor;
+        // the last tree node is a leaf
+        if (all_tree_nodes_pt.back()->object_pt()->is_halo()) continue;
+#endif
+
+        unsigned n_tree_node = all_tree_nodes_pt.size();
+        Vector<double> n_son(n_tree_node);
+        for (unsigned j = 0; j < n_tree_node; j++)
+        {
+          n_son[j] = all_tree_nodes_pt[j]->nsons();
+        }
+        key.push_back(prefix + checkpoint_element_key(root_pt->object_pt(),
+                                                      base_element_number));
+        pattern.push_back(n_son);
+      }
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Refine the
+  /// tree-based refineable meshes as in the checkpoint whose records
+  /// (read on this processor) are in bucket_record: Get the refinement
+  /// patterns of all base elements (incl. halo ones, which have to be
+  /// refined in the same way as their non-halo counterparts), convert
+  /// them into the meshes' refinement patterns (see
+  /// TreeBasedRefineableMeshBase::get_refinement_pattern(...)) and
+  /// rebuild the meshes from their base meshes if they're not already
+  /// refined in that way.
+  //=========================================================================
+  void Problem::refine_as_in_checkpoint(
+    const unsigned& n_bucket,
+    const std::map<std::string, Vector<double>>& bucket_record)
+  {
+    std::map<GeneralisedElement*, unsigned> base_element_number;
+    get_checkpoint_base_element_numbers(base_element_number);
+
+    // Keys of the refinement patterns of all base elements
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    Vector<std::string> key;
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(mesh_pt(m));
+      if ((tree_mesh_pt == 0) || (tree_mesh_pt->forest_pt() == 0)) continue;
+
+      std::ostringstream prefix_stream;
+      prefix_stream << "M" << m << ":R";
+      std::string prefix = prefix_stream.str();
+
+      unsigned n_tree = tree_mesh_pt->forest_pt()->ntree();
+      for (unsigned i = 0; i < n_tree; i++)
+      {
+        RefineableElement* root_el_pt =
+          tree_mesh_pt->forest_pt()->tree_pt(i)->object_pt();
+        key.push_back(prefix +
+                      checkpoint_element_key(root_el_pt, base_element_number));
+      }
+    }
+
+    // Get them
+    std::map<std::string, Vector<double>> record;
+    std::string error_message;
+    try
+    {
+      request_checkpoint_records(key, n_bucket, bucket_record, record);
+    }
+    catch (OomphLibError&)
+    {
+      // The error's description is issued when it goes out of scope
+      error_message = "Error in the refinement patterns of the checkpoint.\n";
+    }
+    unsigned n_key = key.size();
+    for (unsigned k = 0; (k < n_key) && (error_message == ""); k++)
+    {
+      if (record.find(key[k]) == record.end())
+      {
+        error_message = "The refinement pattern of base element " + key[k] +
+                        " is not in the checkpoint.\nHave the meshes been " +
+                        "set up in the same way as when the\ncheckpoint " +
+                        "was written?\n";
+      }
+    }
+    checkpoint_collective_error_check(error_message);
+
+    // Convert the refinement patterns of the base elements into those
+    // of the meshes
+    Vector<Vector<Vector<unsigned>>> to_be_refined(n_mesh);
+    unsigned k = 0;
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(mesh_pt(m));
+      if ((tree_mesh_pt == 0) || (tree_mesh_pt->forest_pt() == 0)) continue;
+
+      // Level and number of sons of all tree nodes in the forest (in
+      // the order of TreeForest::stick_all_tree_nodes_into_vector(...))
+      Vector<unsigned> level;
+      Vector<unsigned> n_son;
+      unsigned max_level = 0;
+      unsigned n_tree = tree_mesh_pt->forest_pt()->ntree();
+      for (unsigned i = 0; i < n_tree; i++)
+      {
+        const Vector<double>& pattern = record[key[k]];
+
+        // Number of sons that remain to be visited for the current
+        // node's ancestors
+        Vector<unsigned> n_son_left;
+        unsigned n_tree_node = pattern.size();
+        bool ok = (n_tree_node > 0);
+        for (unsigned j = 0; (j < n_tree_node) && ok; j++)
+        {
+          while ((!n_son_left.empty()) && (n_son_left.back() == 0))
+          {
+            n_son_left.pop_back();
+          }
+          ok = ((j == 0) || (!n_son_left.empty()));
+          level.push_back(n_son_left.size());
+          n_son.push_back(unsigned(pattern[j]));
+          max_level = std::max(max_level, level.back());
+          if (!n_son_left.empty()) n_son_left.back()--;
+          if (n_son.back() > 0) n_son_left.push_back(n_son.back());
+        }
+        for (unsigned l = 0; l < n_son_left.size(); l++)
+        {
+          ok = ok && (n_son_left[l] == 0);
+        }
+        if ((!ok) && (error_message == ""))
+        {
+          error_message = "The refinement pattern of base element " +
+                          key[k] + " in the checkpoint is corrupted.\n";
+        }
+        k++;
+      }
+
+      // Elements that are refined at each level (enumerated as in the
+      // mesh at that level)
+      to_be_refined[m].resize(max_level);
+      unsigned n_tree_node = level.size();
+      for (unsigned l = 0; l < max_level; l++)
+      {
+        unsigned el_count = 0;
+        for (unsigned j = 0; j < n_tree_node; j++)
+        {
+          if ((level[j] == l) || ((level[j] < l) && (n_son[j] == 0)))
+          {
+            if ((level[j] == l) && (n_son[j] > 0))
+            {
+              to_be_refined[m][l].push_back(el_count);
+            }
+            el_count++;
+          }
+        }
+      }
+    }
+    checkpoint_collective_error_check(error_message);
+
+    refine_as_in_restart(to_be_refined);
+  }
+
+
+  //=========================================================================
+  /// Helper function for restarts: Rebuild the tree-based refineable
+  /// (sub)meshes from their base meshes such that (sub)mesh m is refined
+  /// as specified by to_be_refined[m], unless all of them are already
+  /// refined in that way (on all processors).
+  //=========================================================================
+  void Problem::refine_as_in_restart(
+    Vector<Vector<Vector<unsigned>>>& to_be_refined)
+  {
+    // Is any mesh refined differently?
+    unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+    int refinement_required = 0;
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(mesh_pt(m));
+      if ((tree_mesh_pt == 0) || (tree_mesh_pt->forest_pt() == 0)) continue;
+
+      Vector<Vector<unsigned>> current_to_be_refined;
+      tree_mesh_pt->get_refinement_pattern(current_to_be_refined);
+      if (current_to_be_refined != to_be_refined[m])
+      {
+        refinement_required = 1;
+      }
+    }
+
+#ifdef OOMPH_HAS_MPI
+    if (this->communicator_pt()->nproc() > 1)
+    {
+      int local_refinement_required = refinement_required;
+      MPI_Allreduce(&local_refinement_required,
+                    &refinement_required,
+                    1,
+                    MPI_INT,
+                    MPI_MAX,
+                    this->communicator_pt()->mpi_comm());
+    }
+#endif
+    if (refinement_required == 0) return;
+
+    // Rebuild the meshes from their base meshes
+    actions_before_adapt();
+    for (unsigned m = 0; m < n_mesh; m++)
+    {
+      TreeBasedRefineableMeshBase* tree_mesh_pt =
+        dynamic_cast<TreeBasedRefineableMeshBase*>(mesh_pt(m));
+      if ((tree_mesh_pt != 0) && (tree_mesh_pt->forest_pt() != 0))
+      {
+        tree_mesh_pt->refine_base_mesh(to_be_refined[m]);
+      }
+    }
+    if (nsub_mesh() > 0)
+    {
+      rebuild_global_mesh();
+    }
+    actions_after_adapt();
+    oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Bucket
+  /// (out of n_bucket) in which the record with the specified key is
+  /// stored
+  //=========================================================================
+  unsigned Problem::checkpoint_bucket(const std::string& key,
+                                      const unsigned& n_bucket)
+  {
+    unsigned long long hash = Checksum::Initial_value;
+    Checksum::update(hash, key.data(), key.size());
+    return unsigned(hash % n_bucket);
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Append
+  /// record to byte buffer, as [key length][key][number of doubles]
+  /// [doubles]
+  //=========================================================================
+  void Problem::append_checkpoint_record(std::string& buffer,
+                                         const std::string& key,
+                                         const Vector<double>& data)
+  {
+    unsigned key_length = key.size();
+    buffer.append(reinterpret_cast<const char*>(&key_length),
+                  sizeof(unsigned));
+    buffer.append(key);
+    unsigned long long n_data = data.size();
+    buffer.append(reinterpret_cast<const char*>(&n_data),
+                  sizeof(unsigned long long));
+    if (n_data > 0)
+    {
+      buffer.append(reinterpret_cast<const char*>(&data[0]),
+                    n_data * sizeof(double));
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Add the
+  /// records in the byte buffer (written by append_checkpoint_record(...))
+  /// to the map. Duplicate keys are an error.
+  //=========================================================================
+  void Problem::parse_checkpoint_records(
+    const std::string& buffer, std::map<std::string, Vector<double>>& record)
+  {
+    unsigned long long n_byte = buffer.size();
+    unsigned long long offset = 0;
+    while (offset < n_byte)
+    {
+      unsigned key_length = 0;
+      unsigned long long n_data = 0;
+      bool ok = (offset + sizeof(unsigned) <= n_byte);
+      if (ok)
+      {
+        std::memcpy(&key_length, &buffer[offset], sizeof(unsigned));
+        offset += sizeof(unsigned);
+        ok = (offset + key_length + sizeof(unsigned long long) <= n_byte);
+      }
+      if (ok)
+      {
+        offset += key_length;
+        std::memcpy(&n_data, &buffer[offset], sizeof(unsigned long long));
+        offset += sizeof(unsigned long long);
+        ok = (offset + n_data * sizeof(double) <= n_byte);
+      }
+      if (!ok)
+      {
+        throw OomphLibError("Checkpoint record buffer is corrupted.\n",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+
+      std::string key(buffer, offset - sizeof(unsigned long long) - key_length,
+                      key_length);
+      if (record.find(key) != record.end())
+      {
+        std::string error_message =
+          "Duplicate key in partition-independent checkpoint: " + key + "\n";
+        throw OomphLibError(
+          error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+      Vector<double>& data = record[key];
+      data.resize(n_data);
+      if (n_data > 0)
+      {
+        std::memcpy(&data[0], &buffer[offset], n_data * sizeof(double));
+      }
+      offset += n_data * sizeof(double);
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Exchange
+  /// byte buffers between all processors (send_buffer[p] is sent to
+  /// processor p; received_buffer[p] is received from p). The (64 bit)
+  /// sizes are exchanged first; the buffers are then sent point-to-point
+  /// in chunks whose size fits into an int, so buffers (and the total
+  /// amount of data) may exceed 2GB.
+  //=========================================================================
+  void Problem::checkpoint_exchange(const Vector<std::string>& send_buffer,
+                                    Vector<std::string>& received_buffer) const
+  {
+    unsigned n_proc = send_buffer.size();
+    received_buffer.resize(n_proc);
+
+#ifdef OOMPH_HAS_MPI
+    if (n_proc > 1)
+    {
+      MPI_Comm comm = this->communicator_pt()->mpi_comm();
+      unsigned my_rank = this->communicator_pt()->my_rank();
+
+      // Exchange the sizes
+      Vector<unsigned long long> send_count(n_proc);
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        send_count[p] = send_buffer[p].size();
+      }
+      Vector<unsigned long long> receive_count(n_proc);
+      MPI_Alltoall(&send_count[0],
+                   1,
+                   MPI_UNSIGNED_LONG_LONG,
+                   &receive_count[0],
+                   1,
+                   MPI_UNSIGNED_LONG_LONG,
+                   comm);
+
+      // Exchange the data in chunks (messages between the same pair of
+      // processors arrive in the order in which they were sent)
+      const unsigned long long chunk_size = 1ull << 30;
+      Vector<MPI_Request> request;
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        if (p == my_rank) continue;
+        received_buffer[p].resize(receive_count[p]);
+        for (unsigned long long start = 0; start < receive_count[p];
+             start += chunk_size)
+        {
+          int count = std::min(chunk_size, receive_count[p] - start);
+          MPI_Request req;
+          MPI_Irecv(&received_buffer[p][start],
+                    count,
+                    MPI_CHAR,
+                    p,
+                    Checkpoint_exchange_tag,
+                    comm,
+                    &req);
+          request.push_back(req);
+        }
+      }
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        if (p == my_rank) continue;
+        for (unsigned long long start = 0; start < send_count[p];
+             start += chunk_size)
+        {
+          int count = std::min(chunk_size, send_count[p] - start);
+          MPI_Request req;
+          MPI_Isend(const_cast<char*>(send_buffer[p].data()) + start,
+                    count,
+                    MPI_CHAR,
+                    p,
+                    Checkpoint_exchange_tag,
+                    comm,
+                    &req);
+          request.push_back(req);
+        }
+      }
+      received_buffer[my_rank] = send_buffer[my_rank];
+      if (!request.empty())
+      {
+        MPI_Waitall(request.size(), &request[0], MPI_STATUSES_IGNORE);
+      }
+      return;
+    }
+#endif
+
+    received_buffer[0] = send_buffer[0];
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Request the
+  /// records with the specified keys from the processors that hold their
+  /// buckets (processor p holds the buckets b with b % nproc == p; its
+  /// records are in bucket_record), serve the other processors' requests
+  /// and add the replies to record. Missing records are skipped (they're
+  /// detected by the caller).
+  //=========================================================================
+  void Problem::request_checkpoint_records(
+    const Vector<std::string>& key,
+    const unsigned& n_bucket,
+    const std::map<std::string, Vector<double>>& bucket_record,
+    std::map<std::string, Vector<double>>& record) const
+  {
+    unsigned n_proc = 1;
+#ifdef OOMPH_HAS_MPI
+    n_proc = this->communicator_pt()->nproc();
+#endif
+
+    // Send the requests
+    Vector<std::string> request(n_proc);
+    unsigned n_key = key.size();
+    for (unsigned k = 0; k < n_key; k++)
+    {
+      request[checkpoint_bucket(key[k], n_bucket) % n_proc] += key[k] + "\n";
+    }
+    Vector<std::string> received_request;
+    checkpoint_exchange(request, received_request);
+    request.clear();
+
+    // Serve the requests
+    Vector<std::string> reply(n_proc);
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      std::istringstream request_stream(received_request[p]);
+      std::string requested_key;
+      while (std::getline(request_stream, requested_key))
+      {
+        std::map<std::string, Vector<double>>::const_iterator it =
+          bucket_record.find(requested_key);
+        if (it != bucket_record.end())
+        {
+          append_checkpoint_record(reply[p], it->first, it->second);
+        }
+      }
+    }
+    received_request.clear();
+    Vector<std::string> received_reply;
+    checkpoint_exchange(reply, received_reply);
+    reply.clear();
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      parse_checkpoint_records(received_reply[p], record);
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Throw the
+  /// specified error (if it's not empty) on all processors as soon as any
+  /// of them has encountered one, so nobody is left waiting in the
+  /// subsequent communication.
+  //=========================================================================
+  void Problem::checkpoint_collective_error_check(
+    const std::string& error_message) const
+  {
+    int local_error = (error_message != "");
+    int global_error = local_error;
+#ifdef OOMPH_HAS_MPI
+    if (this->communicator_pt()->nproc() > 1)
+    {
+      MPI_Allreduce(&local_error,
+                    &global_error,
+                    1,
+                    MPI_INT,
+                    MPI_MAX,
+                    this->communicator_pt()->mpi_comm());
+    }
+#endif
+    if (global_error == 0) return;
+
+    if (local_error)
+    {
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    throw OomphLibError(
+      "Error while reading the restart data on another processor.\n",
+      OOMPH_CURRENT_FUNCTION,
+      OOMPH_EXCEPTION_LOCATION);
+  }
+
+
+  //=========================================================================
+  /// Write a partition-independent checkpoint. Every processor sends its
+  /// records to the processor that owns the record's bucket; each
+  /// processor then writes its bucket (sorted by key) to
+  /// [file_stem]_bucket[b].dat. The records include the refinement
+  /// patterns of the base elements (see
+  /// get_checkpoint_refinement_records(...)). File format:
+  /// - Header: "OOMPHCPT", format version, byte order marker, number of
+  ///   buckets and index of the bucket.
+  /// - Unsteady flag, time, number of timesteps and the timesteps.
+  /// - Number of bytes and the records (see append_checkpoint_record(...)).
+  /// - Checksum of the time data and the records.
+  //=========================================================================
+  void Problem::dump_partition_independent_checkpoint(
+    const std::string& file_stem) const
+  {
+    unsigned n_proc = 1;
+    unsigned my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    n_proc = this->communicator_pt()->nproc();
+    my_rank = this->communicator_pt()->my_rank();
+#endif
+
+    // Get the records (the global data is written by processor 0)
+    Vector<std::string> key;
+    Vector<Vector<Data*>> record_data_pt;
+    get_checkpoint_records(key, record_data_pt, (my_rank == 0));
+
+    // Send them, and the refinement patterns, to the processors that own
+    // the buckets
+    unsigned n_bucket = n_proc;
+    Vector<std::string> send_buffer(n_proc);
+    Vector<std::string> pattern_key;
+    Vector<Vector<double>> pattern;
+    get_checkpoint_refinement_records(pattern_key, pattern);
+    unsigned n_pattern = pattern_key.size();
+    for (unsigned k = 0; k < n_pattern; k++)
+    {
+      append_checkpoint_record(
+        send_buffer[checkpoint_bucket(pattern_key[k], n_bucket)],
+        pattern_key[k],
+        pattern[k]);
+    }
+    pattern_key.clear();
+    pattern.clear();
+    Vector<double> data;
+    unsigned n_record = key.size();
+    for (unsigned k = 0; k < n_record; k++)
+    {
+      data.clear();
+      unsigned n_data = record_data_pt[k].size();
+      for (unsigned l = 0; l < n_data; l++)
+      {
+        pack_checkpoint_data(record_data_pt[k][l], data);
+      }
+      append_checkpoint_record(
+        send_buffer[checkpoint_bucket(key[k], n_bucket)], key[k], data);
+    }
+    Vector<std::string> received_buffer;
+    checkpoint_exchange(send_buffer, received_buffer);
+    send_buffer.clear();
+
+    // Sort the records in the bucket and assemble them
+    std::map<std::string, Vector<double>> record;
+    for (unsigned p = 0; p < n_proc; p++)
+    {
+      parse_checkpoint_records(received_buffer[p], record);
+    }
+    received_buffer.clear();
+    std::string contents;
+    for (std::map<std::string, Vector<double>>::iterator it = record.begin();
+         it != record.end();
+         it++)
+    {
+      append_checkpoint_record(contents, it->first, it->second);
+    }
+
+    // Write the bucket
+    std::ostringstream filename;
+    filename << file_stem << "_bucket" << my_rank << ".dat";
+    std::ofstream dump_file(filename.str().c_str(), std::ios::binary);
+    if (!dump_file.is_open())
+    {
+      std::string error_message = "Couldn't open file " + filename.str();
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    const char magic[8] = {'O', 'O', 'M', 'P', 'H', 'C', 'P', 'T'};
+    dump_file.write(magic, 8);
+    unsigned version = Binary_restart_format_version;
+    dump_file.write(reinterpret_cast<const char*>(&version), sizeof(unsigned));
+    unsigned byte_order_marker = 0x01020304;
+    dump_file.write(reinterpret_cast<const char*>(&byte_order_marker),
+                    sizeof(unsigned));
+    dump_file.write(reinterpret_cast<const char*>(&n_bucket), sizeof(unsigned));
+    dump_file.write(reinterpret_cast<const char*>(&my_rank), sizeof(unsigned));
+
+    unsigned long long checksum = Checksum::Initial_value;
+    unsigned unsteady_flag = (time_pt() != 0);
+    double time = 0.0;
+    Vector<double> dt;
+    if (unsteady_flag)
+    {
+      time = time_pt()->time();
+      unsigned n_dt = time_pt()->ndt();
+      dt.resize(n_dt);
+      for (unsigned i = 0; i < n_dt; i++)
+      {
+        dt[i] = time_pt()->dt(i);
+      }
+    }
+    unsigned n_dt = dt.size();
+    dump_file.write(reinterpret_cast<const char*>(&unsteady_flag),
+                    sizeof(unsigned));
+    dump_file.write(reinterpret_cast<const char*>(&time), sizeof(double));
+    dump_file.write(reinterpret_cast<const char*>(&n_dt), sizeof(unsigned));
+    Checksum::update(checksum, &time, sizeof(double));
+    if (n_dt > 0)
+    {
+      dump_file.write(reinterpret_cast<const char*>(&dt[0]),
+                      n_dt * sizeof(double));
+      Checksum::update(checksum, &dt[0], n_dt * sizeof(double));
+    }
+
+    unsigned long long n_byte = contents.size();
+    dump_file.write(reinterpret_cast<const char*>(&n_byte),
+                    sizeof(unsigned long long));
+    dump_file.write(contents.data(), n_byte);
+    Checksum::update(checksum, contents.data(), n_byte);
+    dump_file.write(reinterpret_cast<const char*>(&checksum),
+                    sizeof(unsigned long long));
+
+    if (dump_file.fail())
+    {
+      throw OomphLibError("Error while writing checkpoint file.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+  }
+
+
+  //=========================================================================
+  /// Helper function for partition-independent checkpoints: Read the
+  /// header (number of buckets and time data) and, if read_records is
+  /// true, the records of the specified bucket file (written by
+  /// dump_partition_independent_checkpoint(...)) into the map.
+  //=========================================================================
+  void Problem::read_checkpoint_bucket_file(
+    const std::string& filename,
+    unsigned& n_bucket,
+    unsigned& unsteady_flag,
+    double& time,
+    Vector<double>& dt,
+    std::map<std::string, Vector<double>>& record,
+    const bool& read_records)
+  {
+    std::ifstream restart_file(filename.c_str(), std::ios::binary);
+    if (!restart_file.is_open())
+    {
+      std::string error_message = "Couldn't open file " + filename;
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Header
+    char magic[8];
+    restart_file.read(magic, 8);
+    if (restart_file.fail() || (std::string(magic, 8) != "OOMPHCPT"))
+    {
+      std::string error_message =
+        filename + " is not an oomph-lib checkpoint file.\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    unsigned version = 0;
+    restart_file.read(reinterpret_cast<char*>(&version), sizeof(unsigned));
+    unsigned byte_order_marker = 0;
+    restart_file.read(reinterpret_cast<char*>(&byte_order_marker),
+                      sizeof(unsigned));
+    if (byte_order_marker != 0x01020304)
+    {
+      throw OomphLibError(
+        "Checkpoint file was written on a machine with different "
+        "byte order.\n",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+    if (version > Binary_restart_format_version)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Checkpoint file has format version " << version
+                   << " but we can only read versions up to "
+                   << Binary_restart_format_version << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    unsigned bucket = 0;
+    restart_file.read(reinterpret_cast<char*>(&n_bucket), sizeof(unsigned));
+    restart_file.read(reinterpret_cast<char*>(&bucket), sizeof(unsigned));
+
+    // Time
+    unsigned long long checksum = Checksum::Initial_value;
+    unsigned n_dt = 0;
+    restart_file.read(reinterpret_cast<char*>(&unsteady_flag),
+                      sizeof(unsigned));
+    restart_file.read(reinterpret_cast<char*>(&time), sizeof(double));
+    restart_file.read(reinterpret_cast<char*>(&n_dt), sizeof(unsigned));
+    if (restart_file.fail())
+    {
+      std::string error_message = "Checkpoint file " + filename +
+                                  " is truncated.\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    Checksum::update(checksum, &time, sizeof(double));
+    dt.resize(n_dt);
+    if (n_dt > 0)
+    {
+      restart_file.read(reinterpret_cast<char*>(&dt[0]),
+                        n_dt * sizeof(double));
+      Checksum::update(checksum, &dt[0], n_dt * sizeof(double));
+    }
+    if (!read_records) return;
+
+    // Records
+    unsigned long long n_byte = 0;
+    restart_file.read(reinterpret_cast<char*>(&n_byte),
+                      sizeof(unsigned long long));
+    std::string contents;
+    if (!restart_file.fail())
+    {
+      contents.resize(n_byte);
+      if (n_byte > 0)
+      {
+        restart_file.read(&contents[0], n_byte);
+      }
+      Checksum::update(checksum, contents.data(), n_byte);
+    }
+    unsigned long long checksum_read = 0;
+    restart_file.read(reinterpret_cast<char*>(&checksum_read),
+                      sizeof(unsigned long long));
+    if (restart_file.fail() || (checksum_read != checksum))
+    {
+      std::string error_message = "Checkpoint file " + filename +
+                                  " is truncated or corrupted (checksum "
+                                  "mismatch).\n";
+      throw OomphLibError(
+        error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    parse_checkpoint_records(contents, record);
+  }
+
+
+  //=========================================================================
+  /// Read a partition-independent checkpoint written by
+  /// dump_partition_independent_checkpoint(...), possibly on a different
+  /// number of processors. Processor p reads the buckets b with
+  /// b % nproc == p, and serves the records requested by the other
+  /// processors. The tree-based refineable meshes are refined as in the
+  /// checkpoint before the values are set. Halo data is then copied from
+  /// the haloed counterparts. Errors are reported on all processors
+  /// before the next exchange so nobody waits for a processor that has
+  /// given up.
+  /// Return flag to indicate if the restart was from a steady or unsteady
+  /// solution.
+  //=========================================================================
+  void Problem::read_partition_independent_checkpoint(
+    const std::string& file_stem, bool& unsteady_restart)
+  {
+    unsigned n_proc = 1;
+    unsigned my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    n_proc = this->communicator_pt()->nproc();
+    my_rank = this->communicator_pt()->my_rank();
+#endif
+
+    // Number of buckets and time data from the header of bucket 0, then
+    // the buckets this processor is responsible for
+    unsigned n_bucket = 0;
+    unsigned unsteady_flag = 0;
+    double time = 0.0;
+    Vector<double> dt;
+    std::map<std::string, Vector<double>> bucket_record;
+    std::string error_message;
+    try
+    {
+      read_checkpoint_bucket_file(file_stem + "_bucket0.dat",
+                                  n_bucket,
+                                  unsteady_flag,
+                                  time,
+                                  dt,
+                                  bucket_record,
+                                  false);
+      for (unsigned b = my_rank; b < n_bucket; b += n_proc)
+      {
+        std::ostringstream filename;
+        filename << file_stem << "_bucket" << b << ".dat";
+        unsigned n_bucket_read = 0;
+        unsigned unsteady_flag_read = 0;
+        double time_read = 0.0;
+        Vector<double> dt_read;
+        read_checkpoint_bucket_file(filename.str(),
+                                    n_bucket_read,
+                                    unsteady_flag_read,
+                                    time_read,
+                                    dt_read,
+                                    bucket_record,
+                                    true);
+        if (n_bucket_read != n_bucket)
+        {
+          error_message =
+            "Inconsistent number of buckets in " + filename.str() + "\n";
+          break;
+        }
+      }
+    }
+    catch (OomphLibError&)
+    {
+      // The error's description is issued when it goes out of scope
+      error_message = "Error while reading the checkpoint files.\n";
+    }
+    checkpoint_collective_error_check(error_message);
+
+    // Refine the meshes as in the checkpoint
+    refine_as_in_checkpoint(n_bucket, bucket_record);
+
+    // Get the records required here from the processors that hold the
+    // buckets
+    Vector<std::string> key;
+    Vector<Vector<Data*>> record_data_pt;
+    get_checkpoint_records(key, record_data_pt, true);
+    std::map<std::string, Vector<double>> record;
+    try
+    {
+      request_checkpoint_records(key, n_bucket, bucket_record, record);
+    }
+    catch (OomphLibError&)
+    {
+      // The error's description is issued when it goes out of scope
+      error_message = "Error in the records of the checkpoint.\n";
+    }
+    bucket_record.clear();
+    checkpoint_collective_error_check(error_message);
+
+    // Check that all records were found (on all processors, so we don't
+    // hang in the halo exchange below)
+    unsigned n_record = key.size();
+    std::string missing_key;
+    unsigned n_missing = 0;
+    for (unsigned k = 0; k < n_record; k++)
+    {
+      if (record.find(key[k]) == record.end())
+      {
+        if (n_missing == 0) missing_key = key[k];
+        n_missing++;
+      }
+    }
+    unsigned n_missing_total = n_missing;
+#ifdef OOMPH_HAS_MPI
+    if (n_proc > 1)
+    {
+      MPI_Allreduce(&n_missing,
+                    &n_missing_total,
+                    1,
+                    MPI_UNSIGNED,
+                    MPI_SUM,
+                    this->communicator_pt()->mpi_comm());
+    }
+#endif
+    if (n_missing_total > 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << n_missing_total << " records required by the Problem "
+                   << "are not in the checkpoint";
+      if (n_missing > 0)
+      {
+        error_stream << " (e.g. " << missing_key << ")";
+      }
+      error_stream << ".\nHave the meshes been set up in the "
+                   << "same way as when the\ncheckpoint was written?\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Set the values
+    try
+    {
+      for (unsigned k = 0; (k < n_record) && (error_message == ""); k++)
+      {
+        const Vector<double>& data = record[key[k]];
+        unsigned long index = 0;
+        unsigned n_data = record_data_pt[k].size();
+        for (unsigned l = 0; l < n_data; l++)
+        {
+          unpack_checkpoint_data(record_data_pt[k][l], data, index);
+        }
+        if (index != data.size())
+        {
+          error_message =
+            "Checkpoint record " + key[k] + " has the wrong size.\n";
+        }
+      }
+    }
+    catch (OomphLibError&)
+    {
+      // The error's description is issued when it goes out of scope
+      error_message = "Checkpoint record doesn't match the Problem.\n";
+    }
+    checkpoint_collective_error_check(error_message);
+
+#ifdef OOMPH_HAS_MPI
+    // Copy the haloed data to the halo counterparts: Pack the haloed
+    // nodes and internal data of haloed elements for each processor...
+    if (distributed())
+    {
+      unsigned n_mesh = std::max(unsigned(1), nsub_mesh());
+      Vector<std::string> send_buffer(n_proc);
+      Vector<double> data;
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        if (p == my_rank) continue;
+        data.clear();
+        for (unsigned m = 0; m < n_mesh; m++)
+        {
+          Mesh* m_pt = mesh_pt(m);
+          unsigned n_haloed_node = m_pt->nhaloed_node(p);
+          for (unsigned j = 0; j < n_haloed_node; j++)
+          {
+            pack_checkpoint_data(m_pt->haloed_node_pt(p, j), data);
+          }
+          Vector<GeneralisedElement*> haloed_el_pt =
+            m_pt->haloed_element_pt(p);
+          unsigned n_haloed_element = haloed_el_pt.size();
+          for (unsigned e = 0; e < n_haloed_element; e++)
+          {
+            unsigned n_internal = haloed_el_pt[e]->ninternal_data();
+            for (unsigned l = 0; l < n_internal; l++)
+            {
+              pack_checkpoint_data(haloed_el_pt[e]->internal_data_pt(l), data);
+            }
+          }
+        }
+        if (!data.empty())
+        {
+          send_buffer[p].assign(reinterpret_cast<const char*>(&data[0]),
+                                data.size() * sizeof(double));
+        }
+      }
+      Vector<std::string> received_buffer;
+      checkpoint_exchange(send_buffer, received_buffer);
+      send_buffer.clear();
+
+      // ...and unpack them into the halo counterparts (in the same order)
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        if (p == my_rank) continue;
+        data.resize(received_buffer[p].size() / sizeof(double));
+        if (!data.empty())
+        {
+          std::memcpy(
+            &data[0], received_buffer[p].data(), received_buffer[p].size());
+        }
+        unsigned long index = 0;
+        for (unsigned m = 0; m < n_mesh; m++)
+        {
+          Mesh* m_pt = mesh_pt(m);
+          unsigned n_halo_node = m_pt->nhalo_node(p);
+          for (unsigned j = 0; j < n_halo_node; j++)
+          {
+            unpack_checkpoint_data(m_pt->halo_node_pt(p, j), data, index);
+          }
+          Vector<GeneralisedElement*> halo_el_pt = m_pt->halo_element_pt(p);
+          unsigned n_halo_element = halo_el_pt.size();
+          for (unsigned e = 0; e < n_halo_element; e++)
+          {
+            unsigned n_internal = halo_el_pt[e]->ninternal_data();
+            for (unsigned l = 0; l < n_internal; l++)
+            {
+              unpack_checkpoint_data(
+                halo_el_pt[e]->internal_data_pt(l), data, index);
+            }
+          }
+        }
+      }
+    }
+#endif
+
+    // Set the time
+    unsteady_restart = (unsteady_flag == 1);
+    if (unsteady_restart)
+    {
+      if (time_pt() == 0)
+      {
+        throw OomphLibError(
+          "Checkpoint is from an unsteady run but the Problem "
+          "has no Time object.\n",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+      time_pt()->time() = time;
+      time_pt()->resize(dt.size());
+
+      // Initialise timestep -- also sets the weights for all timesteppers
+      // in the problem.
+      initialise_dt(dt);
+    }
+  }
+
+
+  //===================================================================
+  /// Set all timesteps to the same value, dt, and assign
+  /// weights for all timesteppers in the problem.
+  //===================================================================
+  void Problem::initialise_dt(const double& dt)
+  {
+    // Initialise the timesteps in the Problem's time object
+    Time_pt->initialise_dt(dt);
+
+    // Find out how many timesteppers there are
+    unsigned n_time_steppers = ntime_stepper();
+
+    // Loop over them all and set the weights
+    for (unsigned i = 0; i < n_time_steppers; i++)
+    {
+      time_stepper_pt(i)->set_weights();
+      if (time_stepper_pt(i)->adaptive_flag())
+      {
+        time_stepper_pt(i)->set_error_weights();
+      }
+    }
+  }
+
+  //=========================================================================
+  /// Set the value of the timesteps to be equal to the values passed in
+  /// a vector and assign weights for all timesteppers in the problem
+  //========================================================================
+  void Problem::initialise_dt(const Vector<double>& dt)
+  {
+    // Initialise the timesteps in the Problem's time object
+    Time_pt->initialise_dt(dt);
+
+    // Find out how many timesteppers there are
+    unsigned n_time_steppers = ntime_stepper();
+
+    // Loop over them all and set the weights
+    for (unsigned i = 0; i < n_time_steppers; i++)
+    {
+      time_stepper_pt(i)->set_weights();
+      if (time_stepper_pt(i)->adaptive_flag())
+      {
+        time_stepper_pt(i)->set_error_weights();
+      }
+    }
+  }
+
+  //========================================================
+  /// Self-test: Check meshes and global data. Return 0 for OK
+  //========================================================
+  unsigned Problem::self_test()
+  {
+    // Initialise
+    bool passed = true;
+
+    // Are there any submeshes?
+    unsigned Nmesh = nsub_mesh();
+
+    // Just one mesh: Check it
+    if (Nmesh == 0)
+    {
+      if (mesh_pt()->self_test() != 0)
+      {
+        passed = false;
+        oomph_info
+          << "\n ERROR: Failed Mesh::self_test() for single mesh in problem"
+          << std::endl;
+      }
+    }
+    // Loop over all submeshes and check them
+    else
+    {
+      for (unsigned imesh = 0; imesh < Nmesh; imesh++)
+      {
+        if (mesh_pt(imesh)->self_test() != 0)
+        {
+          passed = false;
+          oomph_info << "\n ERROR: Failed Mesh::self_test() for mesh imesh"
+                     << imesh << std::endl;
+        }
+      }
+    }
+
+
+    // Check global data
+    unsigned Nglobal = Global_data_pt.size();
+    for (unsigned iglobal = 0; iglobal < Nglobal; iglobal++)
+    {
+      if (Global_data_pt[iglobal]->self_test() != 0)
+      {
+        passed = false;
+        oomph_info
+          << "\n ERROR: Failed Data::self_test() for global data iglobal"
+          << iglobal << std::endl;
+      }
+    }
+
+
+#ifdef OOMPH_HAS_MPI
+
+    if (Problem_has_been_distributed)
+    {
+      // Note: This throws an error if it fails so no return is required.
+      DocInfo tmp_doc_info;
+      tmp_doc_info.disable_doc();
+      check_halo_schemes(tmp_doc_info);
+    }
+
+#endif
+
+    // Return verdict
+    if (passed)
+    {
+      return 0;
+    }
+    else
+    {
+      return 1;
     }
   }
 
@@ -16217,6 +19220,14 @@ namespace oomph
   //========================================================================
   void Problem::newton_solve(const unsigned& max_adapt)
   {
+#ifdef OOMPH_HAS_MPI
+    // Re-distribute the elements if the load has become too imbalanced
+    if (Automatic_load_balancing && Problem_has_been_distributed)
+    {
+      load_balance_if_imbalanced();
+    }
+#endif
+
     // Max number of solves
     unsigned max_solve = max_adapt + 1;
 
@@ -16433,17 +19444,31 @@ namespace oomph
   //========================================================================
   void Problem::synchronise_all_dofs()
   {
-    // Synchronise dofs themselves
-    bool do_halos = true;
-    bool do_external_halos = false;
-    this->synchronise_dofs(do_halos, do_external_halos);
+    // Start the synchronisation of the dofs themselves (and that
+    // required by the assembly handler)...
+    this->start_synchronise_all_dofs();
+
+    // ...and wait for it to complete
+    this->finish_synchronise_dofs();
+  }
 
 
-    do_halos = false;
-    do_external_halos = true;
-    this->synchronise_dofs(do_halos, do_external_halos);
+  //========================================================================
+  /// Start the split-phase synchronisation of all dofs (halo and
+  /// external halo) and perform any synchronisation required by the
+  /// assembly handler. The halo values are only guaranteed to be
+  /// up to date once finish_synchronise_dofs() has been called.
+  //========================================================================
+  void Problem::start_synchronise_all_dofs()
+  {
+    // Post the sends for the halo and external halo dofs
+    bool do_halos = true;
+    bool do_external_halos = true;
+    this->start_synchronise_dofs(do_halos, do_external_halos);
 
     // Now perform any synchronisation required by the assembly handler
+    // (this does not involve the halo dofs so can go ahead while
+    // their values are in transit)
     this->assembly_handler_pt()->synchronise();
   }
 
@@ -16457,240 +19482,585 @@ namespace oomph
   void Problem::synchronise_dofs(const bool& do_halos,
                                  const bool& do_external_halos)
   {
-    // Do we have submeshes?
-    unsigned n_mesh_loop = 1;
-    unsigned nmesh = nsub_mesh();
-    if (nmesh > 0)
+    this->start_synchronise_dofs(do_halos, do_external_halos);
+    this->finish_synchronise_dofs();
+  }
+
+
+  //========================================================================
+  /// Destructor: Free the persistent requests (unless MPI has already
+  /// been shut down)
+  //========================================================================
+  DofSynchronisationPlan::~DofSynchronisationPlan()
+  {
+    int mpi_is_finalised = 0;
+    MPI_Finalized(&mpi_is_finalised);
+    if (!mpi_is_finalised)
     {
-      n_mesh_loop = nmesh;
+      unsigned n_request = Request.size();
+      for (unsigned i = 0; i < n_request; i++)
+      {
+        MPI_Request_free(&Request[i]);
+      }
     }
+  }
 
-    // Local storage for number of processors and current processor
-    const int n_proc = this->communicator_pt()->nproc();
 
-    // If only one processor then return
-    if (n_proc == 1)
+  //========================================================================
+  /// Delete the persistent communication plans used to synchronise the
+  /// dofs. They are re-built when next required.
+  //========================================================================
+  void Problem::invalidate_dof_synchronisation_plans()
+  {
+    // Can't delete the buffers while communication is in progress
+    this->finish_synchronise_dofs();
+
+    for (std::map<unsigned, DofSynchronisationPlan*>::iterator it =
+           Dof_synchronisation_plan_pt.begin();
+         it != Dof_synchronisation_plan_pt.end();
+         it++)
     {
-      return;
+      delete it->second;
     }
+    Dof_synchronisation_plan_pt.clear();
+  }
 
-    const int my_rank = this->communicator_pt()->my_rank();
 
-    // Storage for number of data to be sent to each processor
-    Vector<int> send_n(n_proc, 0);
+  //========================================================================
+  /// \short Build the persistent communication plan for the synchronisation
+  /// of the dofs: Identify the neighbouring processors, collect the Data
+  /// whose values are exchanged with each of them (in the order in which
+  /// they are packed), exchange the message sizes (once!) and set up
+  /// persistent requests bound to fixed-size buffers. Bools control if we
+  /// deal with data associated with external halo/ed elements/nodes or the
+  /// "normal" halo/ed ones.
+  //========================================================================
+  DofSynchronisationPlan* Problem::build_dof_synchronisation_plan(
+    const bool& do_halos, const bool& do_external_halos)
+  {
+    // Local storage for number of processors and current processor
+    const int n_proc = this->communicator_pt()->nproc();
+    const int my_rank = this->communicator_pt()->my_rank();
 
-    // Storage for all values to be sent to all processors
-    Vector<double> send_data;
+    // Do we have submeshes?
+    unsigned n_mesh_loop = 1;
+    unsigned nmesh = nsub_mesh();
+    if (nmesh > 0)
+    {
+      n_mesh_loop = nmesh;
+    }
 
-    // Start location within send_data for data to be sent to each processor
-    Vector<int> send_displacement(n_proc, 0);
+    DofSynchronisationPlan* plan_pt = new DofSynchronisationPlan;
 
     // Loop over all processors
     for (int rank = 0; rank < n_proc; rank++)
     {
-      // Set the offset for the current processor
-      send_displacement[rank] = send_data.size();
-
       // Don't bother to do anything if the processor in the loop is the
       // current processor
-      if (rank != my_rank)
+      if (rank == my_rank)
+      {
+        continue;
+      }
+
+      // The Data to be sent to/received from the current processor.
+      // Note that we may have to send an empty message if haloed
+      // nodes/elements exist but don't store any values.
+      Vector<Data*> send_data_pt;
+      Vector<Data*> receive_data_pt;
+      Vector<Data*> external_send_data_pt;
+      Vector<Data*> external_receive_data_pt;
+      bool have_haloed_stuff = false;
+      bool have_halo_stuff = false;
+
+      // Loop over submeshes
+      for (unsigned imesh = 0; imesh < n_mesh_loop; imesh++)
       {
-        // Deal with sub-meshes one-by-one if required
-        Mesh* my_mesh_pt = 0;
+        Mesh* my_mesh_pt = (nmesh == 0) ? mesh_pt() : mesh_pt(imesh);
 
-        // Loop over submeshes
-        for (unsigned imesh = 0; imesh < n_mesh_loop; imesh++)
+        if (do_halos)
         {
-          if (nmesh == 0)
-          {
-            my_mesh_pt = mesh_pt();
-          }
-          else
+          // Haloed nodes...
+          unsigned n_nod = my_mesh_pt->nhaloed_node(rank);
+          for (unsigned n = 0; n < n_nod; n++)
           {
-            my_mesh_pt = mesh_pt(imesh);
+            send_data_pt.push_back(my_mesh_pt->haloed_node_pt(rank, n));
           }
 
-          if (do_halos)
+          // ...and the internal data of haloed elements
+          Vector<GeneralisedElement*> haloed_elem_pt =
+            my_mesh_pt->haloed_element_pt(rank);
+          unsigned nelem_haloed = haloed_elem_pt.size();
+          for (unsigned e = 0; e < nelem_haloed; e++)
           {
-            // How many of my nodes are haloed by the processor whose values
-            // are updated?
-            unsigned n_nod = my_mesh_pt->nhaloed_node(rank);
-            for (unsigned n = 0; n < n_nod; n++)
+            unsigned n_internal = haloed_elem_pt[e]->ninternal_data();
+            for (unsigned i = 0; i < n_internal; i++)
             {
-              // Add the data for each haloed node to the vector
-              my_mesh_pt->haloed_node_pt(rank, n)->add_values_to_vector(
-                send_data);
+              send_data_pt.push_back(haloed_elem_pt[e]->internal_data_pt(i));
             }
+          }
 
-            // Now loop over haloed elements and prepare to add their
-            // internal data to the big vector to be sent
-            Vector<GeneralisedElement*> haloed_elem_pt =
-              my_mesh_pt->haloed_element_pt(rank);
-            unsigned nelem_haloed = haloed_elem_pt.size();
-            for (unsigned e = 0; e < nelem_haloed; e++)
+          if ((n_nod + my_mesh_pt->nroot_haloed_element(rank)) > 0)
+          {
+            have_haloed_stuff = true;
+          }
+
+          // Same for the halo nodes...
+          n_nod = my_mesh_pt->nhalo_node(rank);
+          for (unsigned n = 0; n < n_nod; n++)
+          {
+            receive_data_pt.push_back(my_mesh_pt->halo_node_pt(rank, n));
+          }
+
+          // ...and the internal data of halo elements
+          Vector<GeneralisedElement*> halo_elem_pt =
+            my_mesh_pt->halo_element_pt(rank);
+          unsigned nelem_halo = halo_elem_pt.size();
+          for (unsigned e = 0; e < nelem_halo; e++)
+          {
+            unsigned n_internal = halo_elem_pt[e]->ninternal_data();
+            for (unsigned i = 0; i < n_internal; i++)
             {
-              haloed_elem_pt[e]->add_internal_data_values_to_vector(send_data);
+              receive_data_pt.push_back(halo_elem_pt[e]->internal_data_pt(i));
             }
           }
 
-          if (do_external_halos)
+          if ((n_nod + my_mesh_pt->nroot_halo_element(rank)) > 0)
           {
-            // How many of my nodes are externally haloed by the processor whose
-            // values are updated?  NB these nodes are on the external mesh.
-            unsigned n_ext_nod = my_mesh_pt->nexternal_haloed_node(rank);
-            for (unsigned n = 0; n < n_ext_nod; n++)
+            have_halo_stuff = true;
+          }
+        }
+
+        if (do_external_halos)
+        {
+          // External haloed nodes...
+          unsigned n_ext_nod = my_mesh_pt->nexternal_haloed_node(rank);
+          for (unsigned n = 0; n < n_ext_nod; n++)
+          {
+            send_data_pt.push_back(
+              my_mesh_pt->external_haloed_node_pt(rank, n));
+            external_send_data_pt.push_back(send_data_pt.back());
+          }
+
+          // ...and the internal data of external haloed elements
+          unsigned next_elem_haloed =
+            my_mesh_pt->nexternal_haloed_element(rank);
+          for (unsigned e = 0; e < next_elem_haloed; e++)
+          {
+            GeneralisedElement* el_pt =
+              my_mesh_pt->external_haloed_element_pt(rank, e);
+            unsigned n_internal = el_pt->ninternal_data();
+            for (unsigned i = 0; i < n_internal; i++)
             {
-              // Add data from each external haloed node to the vector
-              my_mesh_pt->external_haloed_node_pt(rank, n)
-                ->add_values_to_vector(send_data);
+              send_data_pt.push_back(el_pt->internal_data_pt(i));
+              external_send_data_pt.push_back(send_data_pt.back());
             }
+          }
 
-            // Now loop over haloed elements and prepare to send internal data
-            unsigned next_elem_haloed =
-              my_mesh_pt->nexternal_haloed_element(rank);
-            for (unsigned e = 0; e < next_elem_haloed; e++)
+          if ((n_ext_nod + next_elem_haloed) > 0)
+          {
+            have_haloed_stuff = true;
+          }
+
+          // Same for the external halo nodes...
+          n_ext_nod = my_mesh_pt->nexternal_halo_node(rank);
+          for (unsigned n = 0; n < n_ext_nod; n++)
+          {
+            receive_data_pt.push_back(
+              my_mesh_pt->external_halo_node_pt(rank, n));
+            external_receive_data_pt.push_back(receive_data_pt.back());
+          }
+
+          // ...and the internal data of external halo elements
+          unsigned next_elem_halo = my_mesh_pt->nexternal_halo_element(rank);
+          for (unsigned e = 0; e < next_elem_halo; e++)
+          {
+            GeneralisedElement* el_pt =
+              my_mesh_pt->external_halo_element_pt(rank, e);
+            unsigned n_internal = el_pt->ninternal_data();
+            for (unsigned i = 0; i < n_internal; i++)
             {
-              my_mesh_pt->external_haloed_element_pt(rank, e)
-                ->add_internal_data_values_to_vector(send_data);
+              receive_data_pt.push_back(el_pt->internal_data_pt(i));
+              external_receive_data_pt.push_back(receive_data_pt.back());
             }
           }
-        } // end of loop over meshes
+
+          if ((n_ext_nod + next_elem_halo) > 0)
+          {
+            have_halo_stuff = true;
+          }
+        }
+      } // end of loop over meshes
+
+      if (have_haloed_stuff)
+      {
+        plan_pt->Send_rank.push_back(rank);
+        plan_pt->Send_data_pt.push_back(send_data_pt);
+
+        // How many of the values belong to external haloed Data?
+        Vector<double> external_values;
+        unsigned n_data = external_send_data_pt.size();
+        for (unsigned j = 0; j < n_data; j++)
+        {
+          external_send_data_pt[j]->add_values_to_vector(external_values);
+        }
+        plan_pt->Nexternal_halo_send_value.push_back(external_values.size());
       }
+      if (have_halo_stuff)
+      {
+        plan_pt->Receive_rank.push_back(rank);
+        plan_pt->Receive_data_pt.push_back(receive_data_pt);
 
-      // Find the number of data added to the vector
-      send_n[rank] = send_data.size() - send_displacement[rank];
+        // How many of the values belong to external halo Data?
+        Vector<double> external_values;
+        unsigned n_data = external_receive_data_pt.size();
+        for (unsigned j = 0; j < n_data; j++)
+        {
+          external_receive_data_pt[j]->add_values_to_vector(external_values);
+        }
+        plan_pt->Nexternal_halo_receive_value.push_back(
+          external_values.size());
+      }
     }
 
+    // Pack the send buffers once to find out how much data is sent
+    // to each neighbour
+    const unsigned n_send = plan_pt->Send_rank.size();
+    plan_pt->Send_buffer.resize(n_send);
+    Vector<int> send_n(n_send, 0);
+    for (unsigned i = 0; i < n_send; i++)
+    {
+      unsigned n_data = plan_pt->Send_data_pt[i].size();
+      for (unsigned j = 0; j < n_data; j++)
+      {
+        plan_pt->Send_data_pt[i][j]->add_values_to_vector(
+          plan_pt->Send_buffer[i]);
+      }
+      send_n[i] = plan_pt->Send_buffer[i].size();
+    }
 
-    // Storage for the number of data to be received from each processor
-    Vector<int> receive_n(n_proc, 0);
+    // Tell the neighbours how much data to expect. This is the only
+    // communication of sizes; subsequent synchronisations re-use the plan.
+    const unsigned n_receive = plan_pt->Receive_rank.size();
+    Vector<int> receive_n(n_receive, 0);
+    Vector<MPI_Request> size_request(n_send + n_receive);
+    for (unsigned i = 0; i < n_receive; i++)
+    {
+      MPI_Irecv(&receive_n[i],
+                1,
+                MPI_INT,
+                plan_pt->Receive_rank[i],
+                Dof_synchronisation_tag,
+                this->communicator_pt()->mpi_comm(),
+                &size_request[i]);
+    }
+    for (unsigned i = 0; i < n_send; i++)
+    {
+      MPI_Isend(&send_n[i],
+                1,
+                MPI_INT,
+                plan_pt->Send_rank[i],
+                Dof_synchronisation_tag,
+                this->communicator_pt()->mpi_comm(),
+                &size_request[n_receive + i]);
+    }
+    if (n_send + n_receive > 0)
+    {
+      Vector<MPI_Status> size_status(n_send + n_receive);
+      MPI_Waitall(n_send + n_receive, &size_request[0], &size_status[0]);
+    }
 
-    // Now send numbers of data to be sent between all processors
-    MPI_Alltoall(&send_n[0],
-                 1,
-                 MPI_INT,
-                 &receive_n[0],
-                 1,
-                 MPI_INT,
-                 this->communicator_pt()->mpi_comm());
+    // Allocate the buffers (make sure they've got non-zero capacity so
+    // that their addresses remain valid) and bind the persistent requests
+    // to them
+    plan_pt->Receive_buffer.resize(n_receive);
+    plan_pt->Request.resize(n_receive + n_send);
+    for (unsigned i = 0; i < n_receive; i++)
+    {
+      plan_pt->Receive_buffer[i].reserve(std::max(receive_n[i], 1));
+      plan_pt->Receive_buffer[i].resize(receive_n[i]);
+      MPI_Recv_init(plan_pt->Receive_buffer[i].data(),
+                    receive_n[i],
+                    MPI_DOUBLE,
+                    plan_pt->Receive_rank[i],
+                    Dof_synchronisation_tag,
+                    this->communicator_pt()->mpi_comm(),
+                    &plan_pt->Request[i]);
+    }
+    for (unsigned i = 0; i < n_send; i++)
+    {
+      plan_pt->Send_buffer[i].reserve(std::max(send_n[i], 1));
+      MPI_Send_init(plan_pt->Send_buffer[i].data(),
+                    send_n[i],
+                    MPI_DOUBLE,
+                    plan_pt->Send_rank[i],
+                    Dof_synchronisation_tag,
+                    this->communicator_pt()->mpi_comm(),
+                    &plan_pt->Request[n_receive + i]);
+    }
 
-    // We now prepare the data to be received
-    // by working out the displacements from the received data
-    Vector<int> receive_displacement(n_proc, 0);
-    int receive_data_count = 0;
-    for (int rank = 0; rank < n_proc; ++rank)
+    return plan_pt;
+  }
+
+
+  //========================================================================
+  /// \short Start the split-phase synchronisation of the degrees of
+  /// freedom: Pack the haloed values (and/or the external haloed values)
+  /// for each processor that holds halo copies of them and start the
+  /// (persistent) non-blocking sends and receives. The halo values are
+  /// only overwritten when finish_synchronise_dofs() is called. Bools
+  /// control if we deal with data associated with external halo/ed
+  /// elements/nodes or the "normal" halo/ed ones.
+  //========================================================================
+  void Problem::start_synchronise_dofs(const bool& do_halos,
+                                       const bool& do_external_halos)
+  {
+    // Complete any previous synchronisation before starting a new one
+    if (Dof_synchronisation_is_pending)
     {
-      // Displacement is number of data received so far
-      receive_displacement[rank] = receive_data_count;
-      receive_data_count += receive_n[rank];
+      this->finish_synchronise_dofs();
     }
 
-    // Now resize the receive buffer for all data from all processors
-    // Make sure that it has a size of at least one
-    if (receive_data_count == 0)
+    // If only one processor then return
+    if (this->communicator_pt()->nproc() == 1)
     {
-      ++receive_data_count;
+      return;
     }
-    Vector<double> receive_data(receive_data_count);
 
-    // Make sure that the send buffer has size at least one
-    // so that we don't get a segmentation fault
-    if (send_data.size() == 0)
+    // Get the plan (build it if this is the first synchronisation since
+    // the equations were numbered)
+    const unsigned plan_index =
+      2 * unsigned(do_halos) + unsigned(do_external_halos);
+    DofSynchronisationPlan* plan_pt = 0;
+    std::map<unsigned, DofSynchronisationPlan*>::iterator it =
+      Dof_synchronisation_plan_pt.find(plan_index);
+    if (it == Dof_synchronisation_plan_pt.end())
     {
-      send_data.resize(1);
+      plan_pt = build_dof_synchronisation_plan(do_halos, do_external_halos);
+      Dof_synchronisation_plan_pt[plan_index] = plan_pt;
+    }
+    else
+    {
+      plan_pt = it->second;
     }
 
-    // Now send the data between all the processors
-    MPI_Alltoallv(&send_data[0],
-                  &send_n[0],
-                  &send_displacement[0],
-                  MPI_DOUBLE,
-                  &receive_data[0],
-                  &receive_n[0],
-                  &receive_displacement[0],
-                  MPI_DOUBLE,
-                  this->communicator_pt()->mpi_comm());
+    // Remember what we're synchronising so we can unpack the
+    // received data consistently
+    Pending_synchronisation_of_halos = do_halos;
+    Pending_synchronisation_of_external_halos = do_external_halos;
 
-    // Now use the received data to update the halo nodes
-    for (int send_rank = 0; send_rank < n_proc; send_rank++)
+    // Pack the data for all neighbours
+    const unsigned n_send = plan_pt->Send_rank.size();
+    for (unsigned i = 0; i < n_send; i++)
     {
-      // Don't bother to do anything for the processor corresponding to the
-      // current processor or if no data were received from this processor
-      if ((send_rank != my_rank) && (receive_n[send_rank] != 0))
+      Vector<double>& send_buffer = plan_pt->Send_buffer[i];
+#ifdef PARANOID
+      const double* const buffer_pt = send_buffer.data();
+      const unsigned n_planned = send_buffer.size();
+#endif
+      // Wipe the buffer (keeps the memory so the address doesn't change)
+      send_buffer.clear();
+      unsigned n_data = plan_pt->Send_data_pt[i].size();
+      for (unsigned j = 0; j < n_data; j++)
       {
-        // Counter for the data within the large array
-        unsigned count = receive_displacement[send_rank];
+        plan_pt->Send_data_pt[i][j]->add_values_to_vector(send_buffer);
+      }
+#ifdef PARANOID
+      if ((send_buffer.size() != n_planned) ||
+          (send_buffer.data() != buffer_pt))
+      {
+        std::ostringstream error_stream;
+        error_stream
+          << "The number of values to be sent to processor "
+          << plan_pt->Send_rank[i] << " (" << send_buffer.size() << ")\n"
+          << "differs from the one in the dof synchronisation plan ("
+          << n_planned << ").\nThe plan must be re-built (by calling "
+          << "Problem::invalidate_dof_synchronisation_plans())\n"
+          << "whenever the halo(ed) Data change.\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+    }
 
-        // Deal with sub-meshes one-by-one if required
-        Mesh* my_mesh_pt = 0;
+    // Start all the communication
+    const unsigned n_request = plan_pt->Request.size();
+    if (n_request > 0)
+    {
+      MPI_Startall(n_request, &plan_pt->Request[0]);
+    }
 
-        // Loop over submeshes
-        for (unsigned imesh = 0; imesh < n_mesh_loop; imesh++)
-        {
-          if (nmesh == 0)
-          {
-            my_mesh_pt = mesh_pt();
-          }
-          else
-          {
-            my_mesh_pt = mesh_pt(imesh);
-          }
+    // Record the communication volume (split into the contributions
+    // from the halo and external halo Data; the messages are attributed
+    // to the halo synchronisation if both are synchronised together)
+    if (CommunicationStatistics::Collect_communication_statistics)
+    {
+      const unsigned n_halo_message = do_halos ? 1 : 0;
+      for (unsigned i = 0; i < n_send; i++)
+      {
+        unsigned n_external = plan_pt->Nexternal_halo_send_value[i];
+        unsigned n_halo = plan_pt->Send_buffer[i].size() - n_external;
+        CommunicationStatistics::record_send(
+          CommunicationStatistics::Halo_synchronisation,
+          n_halo * sizeof(double),
+          n_halo_message);
+        CommunicationStatistics::record_send(
+          CommunicationStatistics::External_halo_synchronisation,
+          n_external * sizeof(double),
+          1 - n_halo_message);
+      }
+      const unsigned n_receive = plan_pt->Receive_rank.size();
+      for (unsigned i = 0; i < n_receive; i++)
+      {
+        unsigned n_external = plan_pt->Nexternal_halo_receive_value[i];
+        unsigned n_halo = plan_pt->Receive_buffer[i].size() - n_external;
+        CommunicationStatistics::record_receive(
+          CommunicationStatistics::Halo_synchronisation,
+          n_halo * sizeof(double),
+          n_halo_message);
+        CommunicationStatistics::record_receive(
+          CommunicationStatistics::External_halo_synchronisation,
+          n_external * sizeof(double),
+          1 - n_halo_message);
+      }
+    }
 
-          if (do_halos)
-          {
-            // How many of my nodes are halos whose non-halo counter
-            // parts live on processor send_rank?
-            unsigned n_nod = my_mesh_pt->nhalo_node(send_rank);
-            for (unsigned n = 0; n < n_nod; n++)
-            {
-              // Read in values for each halo node
-              my_mesh_pt->halo_node_pt(send_rank, n)
-                ->read_values_from_vector(receive_data, count);
-            }
+    // The synchronisation is now in progress
+    Dof_synchronisation_is_pending = true;
+  }
 
-            // Get number of halo elements whose non-halo is
-            // on process send_rank
-            Vector<GeneralisedElement*> halo_elem_pt =
-              my_mesh_pt->halo_element_pt(send_rank);
 
-            unsigned nelem_halo = halo_elem_pt.size();
-            for (unsigned e = 0; e < nelem_halo; e++)
-            {
-              halo_elem_pt[e]->read_internal_data_values_from_vector(
-                receive_data, count);
-            }
-          }
+  //========================================================================
+  /// \short Complete the split-phase synchronisation of the degrees of
+  /// freedom started by start_synchronise_dofs(...): Wait for the
+  /// communication to complete and use the received values to overwrite
+  /// the halo values. Does nothing if no synchronisation is pending.
+  //========================================================================
+  void Problem::finish_synchronise_dofs()
+  {
+    // Nothing to do?
+    if (!Dof_synchronisation_is_pending)
+    {
+      return;
+    }
+    Dof_synchronisation_is_pending = false;
 
-          if (do_external_halos)
-          {
-            // How many of my nodes are external halos whose external non-halo
-            // counterparts live on processor send_rank?
-            unsigned n_ext_nod = my_mesh_pt->nexternal_halo_node(send_rank);
+    // The plan used for the pending synchronisation
+    const unsigned plan_index =
+      2 * unsigned(Pending_synchronisation_of_halos) +
+      unsigned(Pending_synchronisation_of_external_halos);
+    DofSynchronisationPlan* plan_pt = Dof_synchronisation_plan_pt[plan_index];
 
-            // Copy into the values of the external halo nodes
-            // on the present processors
-            for (unsigned n = 0; n < n_ext_nod; n++)
-            {
-              // Read the data from the array into each halo node
-              my_mesh_pt->external_halo_node_pt(send_rank, n)
-                ->read_values_from_vector(receive_data, count);
-            }
+    // Wait for the communication to complete
+    const unsigned n_request = plan_pt->Request.size();
+    if (n_request > 0)
+    {
+      double t_start = CommunicationStatistics::timer();
+      Vector<MPI_Status> status(n_request);
+      MPI_Waitall(n_request, &plan_pt->Request[0], &status[0]);
+      CommunicationStatistics::record_wait_time(
+        Pending_synchronisation_of_halos ?
+          CommunicationStatistics::Halo_synchronisation :
+          CommunicationStatistics::External_halo_synchronisation,
+        CommunicationStatistics::timer() - t_start);
+    }
 
-            // Get number of halo elements whose non-halo is
-            // on process send_rank
-            unsigned next_elem_halo =
-              my_mesh_pt->nexternal_halo_element(send_rank);
-            for (unsigned e = 0; e < next_elem_halo; e++)
-            {
-              my_mesh_pt->external_halo_element_pt(send_rank, e)
-                ->read_internal_data_values_from_vector(receive_data, count);
-            }
+    // Now use the received data to update the halo Data
+    const unsigned n_receive = plan_pt->Receive_rank.size();
+    for (unsigned i = 0; i < n_receive; i++)
+    {
+      // Counter for the data within the buffer
+      unsigned count = 0;
+      unsigned n_data = plan_pt->Receive_data_pt[i].size();
+      for (unsigned j = 0; j < n_data; j++)
+      {
+        plan_pt->Receive_data_pt[i][j]->read_values_from_vector(
+          plan_pt->Receive_buffer[i], count);
+      }
+#ifdef PARANOID
+      if (count != plan_pt->Receive_buffer[i].size())
+      {
+        std::ostringstream error_stream;
+        error_stream
+          << "Only " << count << " of the "
+          << plan_pt->Receive_buffer[i].size()
+          << " values received from processor " << plan_pt->Receive_rank[i]
+          << "\nwere used to update the halo Data. The dof synchronisation "
+          << "plan must be re-built\n(by calling "
+          << "Problem::invalidate_dof_synchronisation_plans()) "
+          << "whenever the halo(ed) Data change.\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+    }
+  } // End of synchronise
+
+
+  //========================================================================
+  /// \short Helper function to split the elements in the range
+  /// [el_lo,el_hi_plus_one) that are to be assembled on this processor
+  /// into "interior" ones (whose dofs are all stored on this processor and
+  /// whose contribution can therefore be computed before the halo values
+  /// have been synchronised) and the remaining ones. On return,
+  /// element_order contains the element numbers with the first
+  /// n_interior_element entries referring to interior elements.
+  //========================================================================
+  void Problem::get_element_order_for_overlapped_assembly(
+    AssemblyHandler* const& assembly_handler_pt,
+    const unsigned long& el_lo,
+    const unsigned long& el_hi_plus_one,
+    Vector<unsigned long>& element_order,
+    unsigned long& n_interior_element)
+  {
+    // Range of globally-numbered dofs that are stored on this processor
+    const unsigned long first_row = Dof_distribution_pt->first_row();
+    const unsigned long last_row_plus_one =
+      first_row + Dof_distribution_pt->nrow_local();
+
+    // Storage for the elements that involve halo dofs
+    Vector<unsigned long> boundary_element;
+
+    element_order.clear();
+    element_order.reserve(el_hi_plus_one - el_lo);
+    for (unsigned long e = el_lo; e < el_hi_plus_one; e++)
+    {
+      GeneralisedElement* elem_pt = mesh_pt()->element_pt(e);
+
+      // Halo elements are ignored during assembly anyway so we
+      // can stick them into the interior without penalty
+      bool is_interior = true;
+      if (!elem_pt->is_halo())
+      {
+        // Only dofs can have changed since the last synchronisation, so
+        // the element is interior if all of its dofs are stored locally
+        const unsigned nvar = assembly_handler_pt->ndof(elem_pt);
+        for (unsigned i = 0; i < nvar; i++)
+        {
+          const unsigned long eqn_number =
+            assembly_handler_pt->eqn_number(elem_pt, i);
+          if ((eqn_number < first_row) || (eqn_number >= last_row_plus_one))
+          {
+            is_interior = false;
+            break;
           }
+        }
+      }
 
-        } // end of loop over meshes
+      if (is_interior)
+      {
+        element_order.push_back(e);
+      }
+      else
+      {
+        boundary_element.push_back(e);
       }
-    } // End of data is received
-  } // End of synchronise
+    }
+
+    // Interior elements come first
+    n_interior_element = element_order.size();
+    element_order.insert(
+      element_order.end(), boundary_element.begin(), boundary_element.end());
+  }
 
 
   //========================================================================
@@ -16740,6 +20110,7 @@ namespace oomph
     }
 
     // recv n_eqn from processors with rank less than my_rank
+    double t_wait_start = CommunicationStatistics::timer();
     Vector<unsigned> n_eqn_on_proc(my_rank);
     for (unsigned p = 0; p < my_rank; p++)
     {
@@ -16751,6 +20122,17 @@ namespace oomph
                Communicator_pt->mpi_comm(),
                MPI_STATUS_IGNORE);
     }
+    CommunicationStatistics::record_wait_time(
+      CommunicationStatistics::Equation_number_synchronisation,
+      CommunicationStatistics::timer() - t_wait_start);
+    CommunicationStatistics::record_send(
+      CommunicationStatistics::Equation_number_synchronisation,
+      n_send * sizeof(unsigned),
+      n_send);
+    CommunicationStatistics::record_receive(
+      CommunicationStatistics::Equation_number_synchronisation,
+      my_rank * sizeof(unsigned),
+      my_rank);
 
     double t_end = 0.0;
     if (Global_timings::Doc_comprehensive_timings)
@@ -16917,8 +20299,12 @@ namespace oomph
     // wait for the sends to complete
     if (n_send > 0)
     {
+      t_wait_start = CommunicationStatistics::timer();
       Vector<MPI_Status> send_status(n_send);
       MPI_Waitall(n_send, &send_req[0], &send_status[0]);
+      CommunicationStatistics::record_wait_time(
+        CommunicationStatistics::Equation_number_synchronisation,
+        CommunicationStatistics::timer() - t_wait_start);
     }
 
     if (Global_timings::Doc_comprehensive_timings)
@@ -17051,7 +20437,11 @@ namespace oomph
     // Storage for the number of data to be received from each processor
     Vector<int> receive_n(n_proc, 0);
 
+    // Number of equation numbers to be sent (before any padding)
+    unsigned long n_eqn_number_sent = send_data.size();
+
     // Communicate all numbers of data to be sent between all processors
+    double t_start = CommunicationStatistics::timer();
     MPI_Alltoall(&send_n[0],
                  1,
                  MPI_INT,
@@ -17097,6 +20487,24 @@ namespace oomph
                   MPI_LONG,
                   this->communicator_pt()->mpi_comm());
 
+    // Record the traffic in the two collectives
+    unsigned long n_eqn_number_received = 0;
+    for (int rank = 0; rank < n_proc; rank++)
+    {
+      n_eqn_number_received += receive_n[rank];
+    }
+    CommunicationStatistics::record_collective(
+      CommunicationStatistics::Equation_number_synchronisation,
+      n_proc * sizeof(int),
+      n_proc * sizeof(int));
+    CommunicationStatistics::record_collective(
+      CommunicationStatistics::Equation_number_synchronisation,
+      n_eqn_number_sent * sizeof(long),
+      n_eqn_number_received * sizeof(long));
+    CommunicationStatistics::record_wait_time(
+      CommunicationStatistics::Equation_number_synchronisation,
+      CommunicationStatistics::timer() - t_start);
+
 
     // Loop over all other processors to receive their
     // eqn numbers
@@ -17310,10 +20718,16 @@ namespace oomph
         }
         else
         {
-          // Use METIS to perform the partitioning
+          // Use METIS to perform the partitioning, using the specified
+          // (possibly incremental) repartitioning strategy
           unsigned objective = 0;
+          bool bypass_metis = false;
           METIS::partition_distributed_mesh(
-            this, objective, target_domain_for_local_non_halo_element);
+            this,
+            objective,
+            target_domain_for_local_non_halo_element,
+            bypass_metis,
+            Repartitioning_method_for_load_balancing);
         }
       }
 
@@ -17843,7 +21257,8 @@ namespace oomph
       } // if (n_mesh!=0)
 
       // Setup the map between "root" element and number in global mesh
-      // again
+      // again (the rebuilt global mesh uses the dense lookup scheme)
+      clear_locally_built_base_mesh_element_pt();
 
       // This map is only established for structured meshes, then we
       // need to check here the type of mesh
@@ -18051,10 +21466,7 @@ namespace oomph
       unsigned n_del = deleted_element_pt.size();
       for (unsigned e = 0; e < n_del; e++)
       {
-        GeneralisedElement* el_pt = deleted_element_pt[e];
-        unsigned old_el_number = Base_mesh_element_number_plus_one[el_pt] - 1;
-        Base_mesh_element_number_plus_one[el_pt] = 0;
-        Base_mesh_element_pt[old_el_number] = 0;
+        null_base_mesh_element(deleted_element_pt[e]);
       }
 
       // Has one of the meshes been pruned before distribution? If so
@@ -18092,10 +21504,7 @@ namespace oomph
         unsigned n_del = deleted_element_pt.size();
         for (unsigned e = 0; e < n_del; e++)
         {
-          GeneralisedElement* el_pt = deleted_element_pt[e];
-          unsigned old_el_number = Base_mesh_element_number_plus_one[el_pt] - 1;
-          Base_mesh_element_number_plus_one[el_pt] = 0;
-          Base_mesh_element_pt[old_el_number] = 0;
+          null_base_mesh_element(deleted_element_pt[e]);
         }
 
         // Setup the map between "root" element and number in global mesh again
@@ -18318,442 +21727,455 @@ namespace oomph
 
 
   //==========================================================================
-  /// Send refinement information between processors
+  /// Stream for the flat-packed refinement pattern of the base elements
+  /// that are sent to their new processors during load balancing. The
+  /// receiving processor decodes the pattern and records on which other
+  /// processors the element is haloed.
   //==========================================================================
-  void Problem::send_refinement_info_helper(
-    Vector<unsigned>& old_domain_for_base_element,
-    Vector<unsigned>& new_domain_for_base_element,
-    const unsigned& max_refinement_level_overall,
-    std::map<unsigned, Vector<unsigned>>& flat_packed_refinement_info_for_root,
-    Vector<Vector<Vector<unsigned>>>& refinement_info_for_root_elements)
+  class RootRefinementInfoStream : public LoadBalancingRecordStream
   {
-    // Number of processes etc.
-    const int n_proc = this->communicator_pt()->nproc();
-    const int my_rank = this->communicator_pt()->my_rank();
-
-    // Make space
-    unsigned n_base_element = old_domain_for_base_element.size();
-    refinement_info_for_root_elements.resize(n_base_element);
-
-    // Make space for list of domains that the refinement info
-    // is to be forwarded to
-    std::map<unsigned, Vector<unsigned>> halo_domain_of_haloed_base_element;
+  public:
+    /// \short Constructor: Pass the flat-packed refinement pattern of the
+    /// base elements that are sent from this processor, the halo domains
+    /// of the base elements in the new distribution and the storage
+    /// to be filled when records are received
+    RootRefinementInfoStream(
+      const unsigned& max_refinement_level_overall,
+      std::map<unsigned, Vector<unsigned>>&
+        flat_packed_refinement_info_for_root,
+      std::map<unsigned, Vector<unsigned>>& halo_domains,
+      std::map<unsigned, Vector<unsigned>>& halo_domain_of_haloed_base_element,
+      Vector<Vector<Vector<unsigned>>>& refinement_info_for_root_elements)
+      : Max_refinement_level_overall(max_refinement_level_overall),
+        Flat_packed_refinement_info_for_root_pt(
+          &flat_packed_refinement_info_for_root),
+        Halo_domains_pt(&halo_domains),
+        Halo_domain_of_haloed_base_element_pt(
+          &halo_domain_of_haloed_base_element),
+        Refinement_info_for_root_elements_pt(
+          &refinement_info_for_root_elements)
+    {
+    }
+
+    /// \short Append the base element number and its flat-packed
+    /// refinement pattern to send_buffer
+    void pack_record(const unsigned& p,
+                     const unsigned& e,
+                     Vector<unsigned>& send_buffer)
+    {
+      Vector<unsigned>& flat_packed =
+        (*Flat_packed_refinement_info_for_root_pt)[e];
+      unsigned n_additional_data = flat_packed.size();
+
+      // Add base element number
+      send_buffer.push_back(e);
 
-    // Find out haloed elements in new, redistributed problem
-    //-------------------------------------------------------
-
-    // halo_domains[e][j] = j-th halo domain associated with (haloed) element e
-    std::map<unsigned, Vector<unsigned>> halo_domains;
-
-    // Loop over sub meshes
-    unsigned n_sub_mesh = nsub_mesh();
-    unsigned max_mesh = std::max(n_sub_mesh, unsigned(1));
-    for (unsigned i_mesh = 0; i_mesh < max_mesh; i_mesh++)
-    {
-      // Choose the right mesh
-      Mesh* my_mesh_pt = 0;
-      if (n_sub_mesh == 0)
-      {
-        my_mesh_pt = mesh_pt();
-      }
-      else
-      {
-        my_mesh_pt = mesh_pt(i_mesh);
-      }
-
-      // Only work with structured meshes
-      TriangleMeshBase* sub_mesh_pt =
-        dynamic_cast<TriangleMeshBase*>(mesh_pt(i_mesh));
-      if (!(sub_mesh_pt != 0))
-      {
-        // Loop over processors to find haloed elements -- need to
-        // send their refinement patterns processors that hold their
-        // halo counterparts!
-        for (int p = 0; p < n_proc; p++)
-        {
-          Vector<GeneralisedElement*> haloed_elem_pt =
-            my_mesh_pt->haloed_element_pt(p);
-          unsigned nhaloed = haloed_elem_pt.size();
-          for (unsigned h = 0; h < nhaloed; h++)
-          {
-            // This element must send its refinement information to processor p
-            unsigned e = Base_mesh_element_number_plus_one[haloed_elem_pt[h]];
 #ifdef PARANOID
-            if (e == 0)
-            {
-              throw OomphLibError("Base_mesh_element_number_plus_one[...]=0",
-                                  OOMPH_CURRENT_FUNCTION,
-                                  OOMPH_EXCEPTION_LOCATION);
-            }
+      // Add number of flat-packed instructions to follow
+      send_buffer.push_back(n_additional_data);
 #endif
-            e -= 1;
-            halo_domains[e].push_back(p);
-          }
-        }
-      } // if (!(sub_mesh_pt!=0))
-    } // for (i_mesh<max_mesh)
-
-    // Accumulate relevant flat-packed refinement data to be sent to
-    //--------------------------------------------------------------
-    // various processors
-    //-------------------
-
-    // Map to accumulate unsigned data to be sent to each processor
-    // (map for sparsity)
-    std::map<unsigned, Vector<unsigned>> data_for_proc;
-
-    // Number of base elements to be sent to specified domain
-    Vector<unsigned> nbase_elements_for_proc(n_proc, 0);
 
-    // Total number of entries in send vector
-    unsigned count = 0;
-
-    // Loop over all base elements
-    //----------------------------
-    for (unsigned e = 0; e < n_base_element; e++)
-    {
-      // Is it one of mine (i.e. was it a non-halo element on this
-      //----------------------------------------------------------
-      // processor before re-distribution, and do I therefore hold
-      //----------------------------------------------------------
-      // refinement information for it)?
-      //--------------------------------
-      if (int(old_domain_for_base_element[e]) == my_rank)
+      // Add flat packed refinement data
+      for (unsigned j = 0; j < n_additional_data; j++)
       {
-        // Where does it go?
-        unsigned new_domain = new_domain_for_base_element[e];
+        send_buffer.push_back(flat_packed[j]);
+      }
+    }
 
-        // Keep counting
-        nbase_elements_for_proc[new_domain]++;
+    /// \short Decode the refinement pattern of the base element whose
+    /// record starts at receive_buffer[count]
+    void unpack_record(const Vector<unsigned>& receive_buffer,
+                       unsigned& count)
+    {
+      //  Get base element number
+      unsigned base_element_number = receive_buffer[count];
+      count++;
 
-        // If it stays local, deal with it here
-        if (int(new_domain) == my_rank)
-        {
-          // Record on which other procs/domains the refinement info for
-          // this element is required because it's haloed.
-          unsigned nhalo = halo_domains[e].size();
-          halo_domain_of_haloed_base_element[e].resize(nhalo);
-          for (unsigned j = 0; j < nhalo; j++)
-          {
-            halo_domain_of_haloed_base_element[e][j] = halo_domains[e][j];
-          }
+      // Record on which other procs/domains the refinement info for
+      // this element is required because it's haloed.
+      Vector<unsigned>& halo_domains =
+        (*Halo_domains_pt)[base_element_number];
+      (*Halo_domain_of_haloed_base_element_pt)[base_element_number] =
+        halo_domains;
 
-          // Provide storage for refinement pattern
-          refinement_info_for_root_elements[e].resize(
-            max_refinement_level_overall);
+      // Provide storage for refinement pattern
+      Vector<Vector<unsigned>>& refinement_info =
+        (*Refinement_info_for_root_elements_pt)[base_element_number];
+      refinement_info.resize(Max_refinement_level_overall);
 
+      // Get number of flat-packed instructions to follow
+      // (only used for check)
 #ifdef PARANOID
-          // Get number of additional data sent for check
-          unsigned n_additional_data =
-            flat_packed_refinement_info_for_root[e].size();
-#endif
+      unsigned n_additional_data = receive_buffer[count];
+      count++;
 
-          // Get number of tree nodes
-          unsigned n_tree_nodes = flat_packed_refinement_info_for_root[e][0];
+      // Counter for number of additional data (validation only)
+      unsigned first_count = count;
+#endif
 
-          // Counter for entries to be processed locally
-          unsigned local_count = 1; // (have already processed zero-th entry)
+      // Get number of tree nodes
+      unsigned n_tree_nodes = receive_buffer[count];
+      count++;
 
-          // Loop over levels and number of nodes in tree
-          for (unsigned level = 0; level < max_refinement_level_overall;
-               level++)
+      // Loop over levels and number of nodes in tree
+      for (unsigned level = 0; level < Max_refinement_level_overall; level++)
+      {
+        for (unsigned e = 0; e < n_tree_nodes; e++)
+        {
+          // Element exists at this level
+          if (receive_buffer[count] == 1)
           {
-            for (unsigned ee = 0; ee < n_tree_nodes; ee++)
-            {
-              // Element exists at this level
-              if (flat_packed_refinement_info_for_root[e][local_count] == 1)
-              {
-                local_count++;
+            count++;
 
-                // Element should be refined
-                if (flat_packed_refinement_info_for_root[e][local_count] == 1)
-                {
-                  refinement_info_for_root_elements[e][level].push_back(2);
-                  local_count++;
-                }
-                // Element should not be refined
-                else
-                {
-                  refinement_info_for_root_elements[e][level].push_back(1);
-                  local_count++;
-                }
-              }
-              // Element does not exist at this level
-              else
-              {
-                refinement_info_for_root_elements[e][level].push_back(0);
-                local_count++;
-              }
+            // Element should be refined
+            if (receive_buffer[count] == 1)
+            {
+              refinement_info[level].push_back(2);
             }
+            // Element should not be refined
+            else
+            {
+              refinement_info[level].push_back(1);
+            }
+            count++;
           }
-
-#ifdef PARANOID
-          if (n_additional_data != local_count)
+          // Element does not exist at this level
+          else
           {
-            std::stringstream error_message;
-            error_message << "Number of additional data: " << n_additional_data
-                          << " doesn't match that actually send: "
-                          << local_count << std::endl;
-            throw OomphLibError(error_message.str(),
-                                OOMPH_CURRENT_FUNCTION,
-                                OOMPH_EXCEPTION_LOCATION);
+            refinement_info[level].push_back(0);
+            count++;
           }
-#endif
         }
-        // Element in question is not one of mine so prepare for sending
-        //--------------------------------------------------------------
-        else
-        {
-          // Make space
-          unsigned current_size = data_for_proc[new_domain].size();
-          unsigned n_additional_data =
-            flat_packed_refinement_info_for_root[e].size();
-          data_for_proc[new_domain].reserve(current_size + n_additional_data +
-                                            2);
-
-          // Keep counting
-          count += n_additional_data + 2;
-
-          // Add base element number
-          data_for_proc[new_domain].push_back(e);
+      }
 
 #ifdef PARANOID
-          // Add number of flat-packed instructions to follow
-          data_for_proc[new_domain].push_back(n_additional_data);
-#endif
-
-          // Add flat packed refinement data
-          for (unsigned j = 0; j < n_additional_data; j++)
-          {
-            data_for_proc[new_domain].push_back(
-              flat_packed_refinement_info_for_root[e][j]);
-          }
-        }
+      if (n_additional_data != count - first_count)
+      {
+        std::stringstream error_message;
+        error_message << "Number of additional data: " << n_additional_data
+                      << " doesn't match that actually send: "
+                      << count - first_count << std::endl;
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
       }
+#endif
     }
 
+  private:
+    /// Max. refinement level of any element in the problem
+    unsigned Max_refinement_level_overall;
 
-    // Now do the actual send/receive
-    //-------------------------------
+    /// \short Pointer to the flat-packed refinement pattern of the base
+    /// elements that are sent from this processor
+    std::map<unsigned, Vector<unsigned>>*
+      Flat_packed_refinement_info_for_root_pt;
 
-    // Storage for number of data to be sent to each processor
-    Vector<int> send_n(n_proc, 0);
+    /// \short Pointer to the halo domains of the base elements in the new
+    /// distribution
+    std::map<unsigned, Vector<unsigned>>* Halo_domains_pt;
 
-    // Storage for all values to be sent to all processors
-    Vector<unsigned> send_data;
-    send_data.reserve(count);
+    /// \short Pointer to the halo domains of the received base elements
+    /// (to which their refinement pattern has to be forwarded)
+    std::map<unsigned, Vector<unsigned>>*
+      Halo_domain_of_haloed_base_element_pt;
 
-    // Start location within send_data for data to be sent to each processor
-    Vector<int> send_displacement(n_proc, 0);
+    /// Pointer to the decoded refinement pattern of the base elements
+    Vector<Vector<Vector<unsigned>>>* Refinement_info_for_root_elements_pt;
+  };
 
-    // Loop over all processors
-    for (int rank = 0; rank < n_proc; rank++)
+
+  //==========================================================================
+  /// Stream for the decoded refinement pattern of the haloed base
+  /// elements that is forwarded to their halo processors during load
+  /// balancing
+  //==========================================================================
+  class HaloRefinementInfoStream : public LoadBalancingRecordStream
+  {
+  public:
+    /// \short Constructor: Pass the (decoded) refinement pattern of the
+    /// base elements; it's read for the records that are sent and filled
+    /// in for the records that are received
+    HaloRefinementInfoStream(
+      const unsigned& max_refinement_level_overall,
+      Vector<Vector<Vector<unsigned>>>& refinement_info_for_root_elements)
+      : Max_refinement_level_overall(max_refinement_level_overall),
+        Refinement_info_for_root_elements_pt(
+          &refinement_info_for_root_elements)
     {
-      // Set the offset for the current processor
-      send_displacement[rank] = send_data.size();
+    }
 
-      // Don't bother to do anything if the processor in the loop is the
-      // current processor
-      if (rank != my_rank)
-      {
-        // Record how many base elements are to be sent
-        send_data.push_back(nbase_elements_for_proc[rank]);
+    /// \short Append the base element number and its refinement pattern
+    /// (in flat-packed form) to send_buffer
+    void pack_record(const unsigned& p,
+                     const unsigned& e,
+                     Vector<unsigned>& send_buffer)
+    {
+      Vector<Vector<unsigned>>& refinement_info =
+        (*Refinement_info_for_root_elements_pt)[e];
 
-        // Add data
-        unsigned n_data = data_for_proc[rank].size();
-        for (unsigned j = 0; j < n_data; j++)
+      // Write base element number
+      send_buffer.push_back(e);
+
+      // Write refinement info in flat-packed form
+      for (unsigned level = 0; level < Max_refinement_level_overall; level++)
+      {
+        // Number of entries at each level
+        unsigned n = refinement_info[level].size();
+        send_buffer.push_back(n);
+        for (unsigned j = 0; j < n; j++)
         {
-          send_data.push_back(data_for_proc[rank][j]);
+          send_buffer.push_back(refinement_info[level][j]);
         }
       }
+    }
 
-      // Find the number of data added to the vector
-      send_n[rank] = send_data.size() - send_displacement[rank];
+    /// \short Read the refinement pattern of the base element whose
+    /// record starts at receive_buffer[count]
+    void unpack_record(const Vector<unsigned>& receive_buffer,
+                       unsigned& count)
+    {
+      // Read base element number
+      unsigned base_element_number = receive_buffer[count];
+      count++;
+
+      // Provide storage for refinement pattern
+      Vector<Vector<unsigned>>& refinement_info =
+        (*Refinement_info_for_root_elements_pt)[base_element_number];
+      refinement_info.resize(Max_refinement_level_overall);
+
+      // Read refinement info in flat-packed form
+      for (unsigned level = 0; level < Max_refinement_level_overall; level++)
+      {
+        // Read number of entries at each level
+        unsigned n = receive_buffer[count];
+        count++;
+
+        // Read entries
+        for (unsigned j = 0; j < n; j++)
+        {
+          refinement_info[level].push_back(receive_buffer[count]);
+          count++;
+        }
+      }
     }
 
-    // Storage for the number of data to be received from each processor
-    Vector<int> receive_n(n_proc, 0);
+  private:
+    /// Max. refinement level of any element in the problem
+    unsigned Max_refinement_level_overall;
+
+    /// Pointer to the decoded refinement pattern of the base elements
+    Vector<Vector<Vector<unsigned>>>* Refinement_info_for_root_elements_pt;
+  };
+
+
+  //==========================================================================
+  /// Send refinement information between processors
+  //==========================================================================
+  void Problem::send_refinement_info_helper(
+    Vector<unsigned>& old_domain_for_base_element,
+    Vector<unsigned>& new_domain_for_base_element,
+    const unsigned& max_refinement_level_overall,
+    std::map<unsigned, Vector<unsigned>>& flat_packed_refinement_info_for_root,
+    Vector<Vector<Vector<unsigned>>>& refinement_info_for_root_elements)
+  {
+    // Number of processes etc.
+    const int n_proc = this->communicator_pt()->nproc();
+    const int my_rank = this->communicator_pt()->my_rank();
+
+    // Make space
+    unsigned n_base_element = old_domain_for_base_element.size();
+    refinement_info_for_root_elements.resize(n_base_element);
+
+    // Make space for list of domains that the refinement info
+    // is to be forwarded to
+    std::map<unsigned, Vector<unsigned>> halo_domain_of_haloed_base_element;
 
-    // Now send numbers of data to be sent between all processors
-    MPI_Alltoall(&send_n[0],
-                 1,
-                 MPI_INT,
-                 &receive_n[0],
-                 1,
-                 MPI_INT,
-                 this->communicator_pt()->mpi_comm());
+    // Find out haloed elements in new, redistributed problem
+    //-------------------------------------------------------
 
-    // We now prepare the data to be received
-    // by working out the displacements from the received data
-    Vector<int> receive_displacement(n_proc, 0);
-    int receive_data_count = 0;
-    for (int rank = 0; rank < n_proc; ++rank)
-    {
-      // Displacement is number of data received so far
-      receive_displacement[rank] = receive_data_count;
-      receive_data_count += receive_n[rank];
-    }
+    // halo_domains[e][j] = j-th halo domain associated with (haloed) element e
+    std::map<unsigned, Vector<unsigned>> halo_domains;
 
-    // Now resize the receive buffer for all data from all processors
-    // Make sure that it has a size of at least one
-    if (receive_data_count == 0)
+    // Loop over sub meshes
+    unsigned n_sub_mesh = nsub_mesh();
+    unsigned max_mesh = std::max(n_sub_mesh, unsigned(1));
+    for (unsigned i_mesh = 0; i_mesh < max_mesh; i_mesh++)
     {
-      ++receive_data_count;
-    }
-    Vector<unsigned> receive_data(receive_data_count);
+      // Choose the right mesh
+      Mesh* my_mesh_pt = 0;
+      if (n_sub_mesh == 0)
+      {
+        my_mesh_pt = mesh_pt();
+      }
+      else
+      {
+        my_mesh_pt = mesh_pt(i_mesh);
+      }
 
-    // Make sure that the send buffer has size at least one
-    // so that we don't get a segmentation fault
-    if (send_data.size() == 0)
-    {
-      send_data.resize(1);
-    }
+      // Only work with structured meshes
+      TriangleMeshBase* sub_mesh_pt =
+        dynamic_cast<TriangleMeshBase*>(mesh_pt(i_mesh));
+      if (!(sub_mesh_pt != 0))
+      {
+        // Loop over processors to find haloed elements -- need to
+        // send their refinement patterns processors that hold their
+        // halo counterparts!
+        for (int p = 0; p < n_proc; p++)
+        {
+          Vector<GeneralisedElement*> haloed_elem_pt =
+            my_mesh_pt->haloed_element_pt(p);
+          unsigned nhaloed = haloed_elem_pt.size();
+          for (unsigned h = 0; h < nhaloed; h++)
+          {
+            // This element must send its refinement information to processor p
+            unsigned e = Base_mesh_element_number_plus_one[haloed_elem_pt[h]];
+#ifdef PARANOID
+            if (e == 0)
+            {
+              throw OomphLibError("Base_mesh_element_number_plus_one[...]=0",
+                                  OOMPH_CURRENT_FUNCTION,
+                                  OOMPH_EXCEPTION_LOCATION);
+            }
+#endif
+            e -= 1;
+            halo_domains[e].push_back(p);
+          }
+        }
+      } // if (!(sub_mesh_pt!=0))
+    } // for (i_mesh<max_mesh)
 
-    // Now send the data between all the processors
-    MPI_Alltoallv(&send_data[0],
-                  &send_n[0],
-                  &send_displacement[0],
-                  MPI_UNSIGNED,
-                  &receive_data[0],
-                  &receive_n[0],
-                  &receive_displacement[0],
-                  MPI_UNSIGNED,
-                  this->communicator_pt()->mpi_comm());
+    // Collect the base elements whose refinement pattern is to be sent
+    //-----------------------------------------------------------------
+    // to their new owners
+    //--------------------
 
+    // Base elements to be sent to each processor (map for sparsity)
+    std::map<unsigned, Vector<unsigned>> base_element_for_proc;
 
-    // Now use the received data to update
-    //-----------------------------------
-    for (int send_rank = 0; send_rank < n_proc; send_rank++)
+    // Loop over all base elements
+    //----------------------------
+    for (unsigned e = 0; e < n_base_element; e++)
     {
-      // Don't bother to do anything for the processor corresponding to the
-      // current processor or if no data were received from this processor
-      if ((send_rank != my_rank) && (receive_n[send_rank] != 0))
+      // Is it one of mine (i.e. was it a non-halo element on this
+      //----------------------------------------------------------
+      // processor before re-distribution, and do I therefore hold
+      //----------------------------------------------------------
+      // refinement information for it)?
+      //--------------------------------
+      if (int(old_domain_for_base_element[e]) == my_rank)
       {
-        // Counter for the data within the large array
-        unsigned count = receive_displacement[send_rank];
+        // Where does it go?
+        unsigned new_domain = new_domain_for_base_element[e];
 
-        // Loop over base elements
-        unsigned nbase_element = receive_data[count];
-        count++;
-        for (unsigned b = 0; b < nbase_element; b++)
+        // If it stays local, deal with it here
+        if (int(new_domain) == my_rank)
         {
-          //  Get base element number
-          unsigned base_element_number = receive_data[count];
-          count++;
-
           // Record on which other procs/domains the refinement info for
           // this element is required because it's haloed.
-          unsigned nhalo = halo_domains[base_element_number].size();
-          halo_domain_of_haloed_base_element[base_element_number].resize(nhalo);
+          unsigned nhalo = halo_domains[e].size();
+          halo_domain_of_haloed_base_element[e].resize(nhalo);
           for (unsigned j = 0; j < nhalo; j++)
           {
-            halo_domain_of_haloed_base_element[base_element_number][j] =
-              halo_domains[base_element_number][j];
+            halo_domain_of_haloed_base_element[e][j] = halo_domains[e][j];
           }
 
           // Provide storage for refinement pattern
-          refinement_info_for_root_elements[base_element_number].resize(
+          refinement_info_for_root_elements[e].resize(
             max_refinement_level_overall);
 
-          // Get number of flat-packed instructions to follow
-          // (only used for check)
 #ifdef PARANOID
-          unsigned n_additional_data = receive_data[count];
-          count++;
-
-          // Counter for number of additional data (validation only)
-          unsigned check_count = 0;
+          // Get number of additional data sent for check
+          unsigned n_additional_data =
+            flat_packed_refinement_info_for_root[e].size();
 #endif
 
           // Get number of tree nodes
-          unsigned n_tree_nodes = receive_data[count];
-          count++;
+          unsigned n_tree_nodes = flat_packed_refinement_info_for_root[e][0];
 
-#ifdef PARANOID
-          check_count++;
-#endif
+          // Counter for entries to be processed locally
+          unsigned local_count = 1; // (have already processed zero-th entry)
 
           // Loop over levels and number of nodes in tree
           for (unsigned level = 0; level < max_refinement_level_overall;
                level++)
           {
-            for (unsigned e = 0; e < n_tree_nodes; e++)
+            for (unsigned ee = 0; ee < n_tree_nodes; ee++)
             {
               // Element exists at this level
-              if (receive_data[count] == 1)
+              if (flat_packed_refinement_info_for_root[e][local_count] == 1)
               {
-                count++;
-
-#ifdef PARANOID
-                check_count++;
-#endif
+                local_count++;
 
                 // Element should be refined
-                if (receive_data[count] == 1)
+                if (flat_packed_refinement_info_for_root[e][local_count] == 1)
                 {
-                  refinement_info_for_root_elements[base_element_number][level]
-                    .push_back(2);
-                  count++;
-
-#ifdef PARANOID
-                  check_count++;
-#endif
+                  refinement_info_for_root_elements[e][level].push_back(2);
+                  local_count++;
                 }
                 // Element should not be refined
                 else
                 {
-                  refinement_info_for_root_elements[base_element_number][level]
-                    .push_back(1);
-                  count++;
-
-#ifdef PARANOID
-                  check_count++;
-#endif
+                  refinement_info_for_root_elements[e][level].push_back(1);
+                  local_count++;
                 }
               }
               // Element does not exist at this level
               else
               {
-                refinement_info_for_root_elements[base_element_number][level]
-                  .push_back(0);
-                count++;
-
-#ifdef PARANOID
-                check_count++;
-#endif
+                refinement_info_for_root_elements[e][level].push_back(0);
+                local_count++;
               }
             }
           }
 
 #ifdef PARANOID
-          if (n_additional_data != check_count)
+          if (n_additional_data != local_count)
           {
             std::stringstream error_message;
             error_message << "Number of additional data: " << n_additional_data
                           << " doesn't match that actually send: "
-                          << check_count << std::endl;
+                          << local_count << std::endl;
             throw OomphLibError(error_message.str(),
                                 OOMPH_CURRENT_FUNCTION,
                                 OOMPH_EXCEPTION_LOCATION);
           }
 #endif
         }
+        // Element in question is not one of mine so prepare for sending
+        //--------------------------------------------------------------
+        else
+        {
+          base_element_for_proc[new_domain].push_back(e);
+        }
       }
     }
 
 
-    // Now send the fully assembled refinement info to halo elements
-    //---------------------------------------------------------------
+    // Now stream the data to the new owners of the base elements
+    //-----------------------------------------------------------
+    // in bounded-size messages that are processed as they arrive
+    //-----------------------------------------------------------
     {
-      // Accumulate data to be sent
-      //---------------------------
+      RootRefinementInfoStream record_stream(
+        max_refinement_level_overall,
+        flat_packed_refinement_info_for_root,
+        halo_domains,
+        halo_domain_of_haloed_base_element,
+        refinement_info_for_root_elements);
+      stream_records_for_load_balancing(
+        base_element_for_proc,
+        record_stream,
+        Load_balancing_refinement_info_tag);
+    }
 
-      // Map to accumulate data to be sent to other procs
-      // (map for sparsity)
-      std::map<unsigned, Vector<unsigned>> data_for_proc;
 
-      // Number of base elements to be sent to specified domain
-      Vector<unsigned> nbase_elements_for_proc(n_proc, 0);
+    // Now send the fully assembled refinement info to halo elements
+    //---------------------------------------------------------------
+    {
+      // Base elements whose refinement info is to be sent to each
+      // processor (map for sparsity)
+      std::map<unsigned, Vector<unsigned>> haloed_base_element_for_proc;
 
       // Loop over all haloed root elements and find out which
       // processors they have haloes on
@@ -18766,173 +22188,223 @@ namespace oomph
         unsigned base_element_number = (*it).first;
 
         // Loop over target domains
-        Vector<unsigned> domains = (*it).second;
+        Vector<unsigned>& domains = (*it).second;
         unsigned nd = domains.size();
         for (unsigned jd = 0; jd < nd; jd++)
         {
-          // Actual number of domain
-          unsigned d = domains[jd];
+          haloed_base_element_for_proc[domains[jd]].push_back(
+            base_element_number);
+        }
+      }
 
-          // Keep counting number of base elemements for domain
-          nbase_elements_for_proc[d]++;
+      // Stream the data in bounded-size messages that are processed
+      //--------------------------------------------------------------
+      // as they arrive
+      //---------------
+      HaloRefinementInfoStream record_stream(
+        max_refinement_level_overall, refinement_info_for_root_elements);
+      stream_records_for_load_balancing(
+        haloed_base_element_for_proc,
+        record_stream,
+        Load_balancing_halo_refinement_info_tag);
+    }
+  }
 
-          // Write base element number
-          data_for_proc[d].push_back(base_element_number);
 
-          // Write refinement info in flat-packed form
-          for (unsigned level = 0; level < max_refinement_level_overall;
-               level++)
-          {
-            // Number of entries at each level
-            unsigned n =
-              refinement_info_for_root_elements[base_element_number][level]
-                .size();
-            data_for_proc[d].push_back(n);
-            for (unsigned j = 0; j < n; j++)
-            {
-              data_for_proc[d].push_back(
-                refinement_info_for_root_elements[base_element_number][level]
-                                                 [j]);
-            }
-          }
-        }
+  //==========================================================================
+  /// Load balance helper routine: Stream the records for the base
+  /// elements listed in base_element_for_proc[p] to processor p and
+  /// unpack the records received from other processors as they arrive.
+  /// The records are packed into messages of at most
+  /// Max_message_size_for_load_balancing entries when there's a free
+  /// slot for them, and at most Max_n_message_in_flight_for_load_balancing
+  /// messages are in flight at any one time; we cycle through the
+  /// receiving processors so they all make progress. The receivers
+  /// don't know how many messages to expect so we use the "non-blocking
+  /// consensus" algorithm (see METIS::sparse_all_to_all(...)): the
+  /// messages are sent with synchronous sends and everything that
+  /// arrives is received until all processors have entered a
+  /// non-blocking barrier, which they do once all their own messages
+  /// have been received.
+  //==========================================================================
+  void Problem::stream_records_for_load_balancing(
+    std::map<unsigned, Vector<unsigned>>& base_element_for_proc,
+    LoadBalancingRecordStream& record_stream,
+    const int& tag)
+  {
+    MPI_Comm comm = this->communicator_pt()->mpi_comm();
+    double t_start = CommunicationStatistics::timer();
+
+    // Time spent packing and unpacking (rather than waiting)
+    double t_work = 0.0;
+
+    // Processors that we send records to and the number of records
+    // that have already been packed for each of them
+    Vector<unsigned> send_proc;
+    Vector<unsigned> n_packed;
+    for (std::map<unsigned, Vector<unsigned>>::iterator it =
+           base_element_for_proc.begin();
+         it != base_element_for_proc.end();
+         it++)
+    {
+      if (!(*it).second.empty())
+      {
+        send_proc.push_back((*it).first);
+        n_packed.push_back(0);
       }
+    }
+    unsigned n_send_proc = send_proc.size();
 
+    // Number of processors that still have records to be sent to them
+    unsigned n_send_proc_left = n_send_proc;
 
-      // Do the actual send
-      //-------------------
-
-      // Storage for number of data to be sent to each processor
-      Vector<int> send_n(n_proc, 0);
+    // The processor whose records are packed next
+    unsigned next_send_proc = 0;
 
-      // Storage for all values to be sent to all processors
-      Vector<unsigned> send_data;
-      send_data.reserve(count);
+    // Send buffers and requests for the messages in flight (the
+    // buffers are re-used once their message has been received)
+    unsigned n_slot =
+      std::max(Max_n_message_in_flight_for_load_balancing, unsigned(1));
+    Vector<Vector<unsigned>> send_buffer(n_slot);
+    Vector<MPI_Request> send_request(n_slot, MPI_REQUEST_NULL);
 
-      // Start location within send_data for data to be sent to each processor
-      Vector<int> send_displacement(n_proc, 0);
+    // Buffer for the current received message
+    Vector<unsigned> receive_buffer;
 
-      // Loop over all processors
-      for (int rank = 0; rank < n_proc; rank++)
+    bool entered_barrier = false;
+    MPI_Request barrier_request;
+    while (true)
+    {
+      // Pack and send further messages for the free slots
+      //--------------------------------------------------
+      for (unsigned s = 0; (s < n_slot) && (n_send_proc_left > 0); s++)
       {
-        // Set the offset for the current processor
-        send_displacement[rank] = send_data.size();
+        // Is the slot's previous message still in flight?
+        if (send_request[s] != MPI_REQUEST_NULL)
+        {
+          int sent = 0;
+          MPI_Test(&send_request[s], &sent, MPI_STATUS_IGNORE);
+          if (!sent)
+          {
+            continue;
+          }
+        }
 
-        // Don't bother to do anything if the processor in the loop is the
-        // current processor
-        if (rank != my_rank)
+        // Find the next processor that has records left
+        while (n_packed[next_send_proc] ==
+               base_element_for_proc[send_proc[next_send_proc]].size())
         {
-          // Record how many base elements are to be sent
-          send_data.push_back(nbase_elements_for_proc[rank]);
+          next_send_proc = (next_send_proc + 1) % n_send_proc;
+        }
+        unsigned p = send_proc[next_send_proc];
+        Vector<unsigned>& base_element = base_element_for_proc[p];
+        unsigned n_record = base_element.size();
+        unsigned& r = n_packed[next_send_proc];
 
-          // Add data
-          unsigned n_data = data_for_proc[rank].size();
-          for (unsigned j = 0; j < n_data; j++)
+        // Add records to the message until it's full
+        double t_pack_start = CommunicationStatistics::timer();
+        Vector<unsigned>& buffer = send_buffer[s];
+        buffer.clear();
+        while (r < n_record)
+        {
+          unsigned old_size = buffer.size();
+          record_stream.pack_record(p, base_element[r], buffer);
+          if ((old_size > 0) &&
+              (buffer.size() > Max_message_size_for_load_balancing))
           {
-            send_data.push_back(data_for_proc[rank][j]);
+            // Doesn't fit: Leave it for the next message
+            buffer.resize(old_size);
+            break;
           }
+          r++;
         }
-        // Find the number of data added to the vector
-        send_n[rank] = send_data.size() - send_displacement[rank];
-      }
-
-      // Storage for the number of data to be received from each processor
-      Vector<int> receive_n(n_proc, 0);
+        if (r == n_record)
+        {
+          n_send_proc_left--;
+        }
+        t_work += CommunicationStatistics::timer() - t_pack_start;
 
-      // Now send numbers of data to be sent between all processors
-      MPI_Alltoall(&send_n[0],
-                   1,
-                   MPI_INT,
-                   &receive_n[0],
-                   1,
-                   MPI_INT,
-                   this->communicator_pt()->mpi_comm());
+        // Send it
+        MPI_Issend(&buffer[0],
+                   buffer.size(),
+                   MPI_UNSIGNED,
+                   p,
+                   tag,
+                   comm,
+                   &send_request[s]);
+        CommunicationStatistics::record_send(
+          CommunicationStatistics::Load_balancing,
+          buffer.size() * sizeof(unsigned));
 
-      // We now prepare the data to be received
-      // by working out the displacements from the received data
-      Vector<int> receive_displacement(n_proc, 0);
-      int receive_data_count = 0;
-      for (int rank = 0; rank < n_proc; ++rank)
-      {
-        // Displacement is number of data received so far
-        receive_displacement[rank] = receive_data_count;
-        receive_data_count += receive_n[rank];
+        // Move on to the next processor
+        next_send_proc = (next_send_proc + 1) % n_send_proc;
       }
 
-      // Now resize the receive buffer for all data from all processors
-      // Make sure that it has a size of at least one
-      if (receive_data_count == 0)
-      {
-        ++receive_data_count;
+      // Receive and unpack whatever has arrived
+      //----------------------------------------
+      int message_waiting = 1;
+      while (message_waiting)
+      {
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &message_waiting, &status);
+        if (message_waiting)
+        {
+          int n_receive = 0;
+          MPI_Get_count(&status, MPI_UNSIGNED, &n_receive);
+          receive_buffer.resize(n_receive);
+          MPI_Recv(&receive_buffer[0],
+                   n_receive,
+                   MPI_UNSIGNED,
+                   status.MPI_SOURCE,
+                   tag,
+                   comm,
+                   MPI_STATUS_IGNORE);
+          CommunicationStatistics::record_receive(
+            CommunicationStatistics::Load_balancing,
+            n_receive * sizeof(unsigned));
+
+          // Loop over the records in the message
+          double t_unpack_start = CommunicationStatistics::timer();
+          unsigned count = 0;
+          while (count < unsigned(n_receive))
+          {
+            record_stream.unpack_record(receive_buffer, count);
+          }
+          t_work += CommunicationStatistics::timer() - t_unpack_start;
+        }
       }
-      Vector<unsigned> receive_data(receive_data_count);
 
-      // Make sure that the send buffer has size at least one
-      // so that we don't get a segmentation fault
-      if (send_data.size() == 0)
+      if (entered_barrier)
       {
-        send_data.resize(1);
+        // Everybody's messages have been received once the barrier
+        // has completed
+        int barrier_done = 0;
+        MPI_Test(&barrier_request, &barrier_done, MPI_STATUS_IGNORE);
+        if (barrier_done)
+        {
+          break;
+        }
       }
-
-      // Now send the data between all the processors
-      MPI_Alltoallv(&send_data[0],
-                    &send_n[0],
-                    &send_displacement[0],
-                    MPI_UNSIGNED,
-                    &receive_data[0],
-                    &receive_n[0],
-                    &receive_displacement[0],
-                    MPI_UNSIGNED,
-                    this->communicator_pt()->mpi_comm());
-
-
-      // Now use the received data
-      //------------------------
-      for (int send_rank = 0; send_rank < n_proc; send_rank++)
+      else if (n_send_proc_left == 0)
       {
-        // Don't bother to do anything for the processor corresponding to the
-        // current processor or if no data were received from this processor
-        if ((send_rank != my_rank) && (receive_n[send_rank] != 0))
+        // Enter the barrier once all our messages have been received
+        int sends_done = 0;
+        MPI_Testall(
+          n_slot, &send_request[0], &sends_done, MPI_STATUSES_IGNORE);
+        if (sends_done)
         {
-          // Counter for the data within the large array
-          unsigned count = receive_displacement[send_rank];
-
-          // Read number of base elements
-          unsigned nbase_element = receive_data[count];
-          count++;
-
-          for (unsigned e = 0; e < nbase_element; e++)
-          {
-            // Read base element number
-            unsigned base_element_number = receive_data[count];
-            count++;
-
-            // Provide storage for refinement pattern
-            refinement_info_for_root_elements[base_element_number].resize(
-              max_refinement_level_overall);
-
-            // Read refinement info in flat-packed form
-            for (unsigned level = 0; level < max_refinement_level_overall;
-                 level++)
-            {
-              // Read number of entries at each level
-              unsigned n = receive_data[count];
-              count++;
-
-              // Read entries
-              for (unsigned j = 0; j < n; j++)
-              {
-                refinement_info_for_root_elements[base_element_number][level]
-                  .push_back(receive_data[count]);
-                count++;
-              }
-            }
-          }
+          MPI_Ibarrier(comm, &barrier_request);
+          entered_barrier = true;
         }
       }
     }
+
+    CommunicationStatistics::record_wait_time(
+      CommunicationStatistics::Load_balancing,
+      CommunicationStatistics::timer() - t_start - t_work);
   }
 
+
   //==========================================================================
   /// Load balance helper routine: Send data to other
   /// processors during load balancing.
@@ -18954,6 +22426,7 @@ namespace oomph
     Vector<int> receive_n(n_proc, 0);
 
     // Now send numbers of data to be sent between all processors
+    double t_start = CommunicationStatistics::timer();
     MPI_Alltoall(&send_n[0],
                  1,
                  MPI_INT,
@@ -18961,6 +22434,13 @@ namespace oomph
                  1,
                  MPI_INT,
                  this->communicator_pt()->mpi_comm());
+    CommunicationStatistics::record_collective(
+      CommunicationStatistics::Load_balancing,
+      (n_proc - 1) * sizeof(int),
+      (n_proc - 1) * sizeof(int));
+    CommunicationStatistics::record_wait_time(
+      CommunicationStatistics::Load_balancing,
+      CommunicationStatistics::timer() - t_start);
 
     // We now prepare the data to be received
     // by working out the displacements from the received data
@@ -18989,6 +22469,7 @@ namespace oomph
     }
 
     // Now send the data between all the processors
+    t_start = CommunicationStatistics::timer();
     MPI_Alltoallv(&send_data[0],
                   &send_n[0],
                   &send_displacement[0],
@@ -18998,6 +22479,28 @@ namespace oomph
                   &receive_displacement[0],
                   MPI_DOUBLE,
                   this->communicator_pt()->mpi_comm());
+    if (CommunicationStatistics::Collect_communication_statistics)
+    {
+      // Data sent to/received from other processors
+      const int my_rank = comm_pt->my_rank();
+      unsigned long n_sent = 0;
+      unsigned long n_received = 0;
+      for (int p = 0; p < n_proc; p++)
+      {
+        if (p != my_rank)
+        {
+          n_sent += send_n[p];
+          n_received += receive_n[p];
+        }
+      }
+      CommunicationStatistics::record_collective(
+        CommunicationStatistics::Load_balancing,
+        n_sent * sizeof(double),
+        n_received * sizeof(double));
+      CommunicationStatistics::record_wait_time(
+        CommunicationStatistics::Load_balancing,
+        CommunicationStatistics::timer() - t_start);
+    }
 
     unsigned el_count = 0;
 
@@ -19033,7 +22536,7 @@ namespace oomph
           count++;
 
           // Get pointer to base/root element from reverse lookup scheme
-          GeneralisedElement* root_el_pt = Base_mesh_element_pt[base_el_no];
+          GeneralisedElement* root_el_pt = base_mesh_element_pt(base_el_no);
 
           // Vector for pointers to associated elements in batch
           Vector<GeneralisedElement*> batch_el_pt;
@@ -19237,7 +22740,10 @@ namespace oomph
     }
 
     // Now that this is done, we need to synchronise dofs to get
-    // the halo element and node values correct
+    // the halo element and node values correct (the halo(ed) lookup
+    // schemes have changed so any existing communication plans are
+    // out of date)
+    invalidate_dof_synchronisation_plans();
     bool do_halos = true;
     bool do_external_halos = false;
     this->synchronise_dofs(do_halos, do_external_halos);
@@ -19335,7 +22841,7 @@ namespace oomph
     //       sent point-to-point for non-halo elements,
     //       mesh refinement information also needs to be sent for
     //       halo elements which aren't known yet.
-    unsigned n_base_element = Base_mesh_element_pt.size();
+    unsigned n_base_element = nbase_mesh_element();
     Vector<int> old_domain_for_base_element_local(n_base_element, -1);
     Vector<int> new_domain_for_base_element_local(n_base_element, -1);
 
@@ -19595,12 +23101,12 @@ namespace oomph
       {
         std::ostringstream error_message;
         error_message << "Old domain for base element " << j << ": "
-                      << Base_mesh_element_pt[j]
+                      << base_mesh_element_pt(j)
                       << "or its incarnation as refineable el: "
                       << dynamic_cast<RefineableElement*>(
-                           Base_mesh_element_pt[j])
+                           base_mesh_element_pt(j))
                       << " which is of type "
-                      << typeid(*Base_mesh_element_pt[j]).name()
+                      << typeid(*base_mesh_element_pt(j)).name()
                       << " does not\n"
                       << "appear to have been assigned by any processor\n";
         throw OomphLibError(error_message.str(),
@@ -19615,7 +23121,7 @@ namespace oomph
         std::ostringstream error_message;
         error_message << "New domain for base element " << j
                       << "which is of type "
-                      << typeid(*Base_mesh_element_pt[j]).name()
+                      << typeid(*base_mesh_element_pt(j)).name()
                       << " does not\n"
                       << "appear to have been assigned by any processor\n";
         throw OomphLibError(error_message.str(),
@@ -20246,5 +23752,18 @@ namespace oomph
   bool Problem::Suppress_warning_about_actions_before_read_unstructured_meshes =
     false;
 
+  /// Definition of the version of the binary restart format (value
+  /// set in the header)
+  const unsigned Problem::Binary_restart_format_version;
+
+#ifdef OOMPH_HAS_MPI
+
+  /// Definition of the MPI tags used during load balancing (values set
+  /// in the header)
+  const int Problem::Load_balancing_refinement_info_tag;
+  const int Problem::Load_balancing_halo_refinement_info_tag;
+
+#endif
+
 
 } // namespace oomph
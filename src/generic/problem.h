@@ -87,6 +87,103 @@ namespace oomph
   // Forward definition for sum of matrices class
   class SumOfMatrices;
 
+#ifdef OOMPH_HAS_MPI
+
+  //=======================================================================
+  /// \short Persistent communication plan for the synchronisation of the
+  /// halo(ed) dofs in a distributed Problem. It is built once per
+  /// equation numbering (by Problem::build_dof_synchronisation_plan(...))
+  /// and stores, for each neighbouring processor only, the Data whose
+  /// values are exchanged, the associated (fixed-size) buffers and
+  /// persistent MPI requests bound to these buffers.
+  //=======================================================================
+  class DofSynchronisationPlan
+  {
+  public:
+    /// Constructor: Empty plan
+    DofSynchronisationPlan() {}
+
+    /// Broken copy constructor
+    DofSynchronisationPlan(const DofSynchronisationPlan& dummy)
+    {
+      BrokenCopy::broken_copy("DofSynchronisationPlan");
+    }
+
+    /// Broken assignment operator
+    void operator=(const DofSynchronisationPlan&)
+    {
+      BrokenCopy::broken_assign("DofSynchronisationPlan");
+    }
+
+    /// Destructor: Free the persistent requests
+    ~DofSynchronisationPlan();
+
+    /// Ranks of the processors that hold halo copies of our haloed data
+    Vector<int> Send_rank;
+
+    /// \short The (haloed) Data whose values are sent to Send_rank[i],
+    /// in the order in which they are packed
+    Vector<Vector<Data*>> Send_data_pt;
+
+    /// Send buffer for the values sent to Send_rank[i]
+    Vector<Vector<double>> Send_buffer;
+
+    /// Ranks of the processors that hold the non-halo copies of our halos
+    Vector<int> Receive_rank;
+
+    /// \short The (halo) Data whose values are received from
+    /// Receive_rank[i], in the order in which they are packed
+    Vector<Vector<Data*>> Receive_data_pt;
+
+    /// Receive buffer for the values received from Receive_rank[i]
+    Vector<Vector<double>> Receive_buffer;
+
+    /// \short Number of the values sent to Send_rank[i] that belong to
+    /// external haloed Data (only used for the communication statistics)
+    Vector<unsigned> Nexternal_halo_send_value;
+
+    /// \short Number of the values received from Receive_rank[i] that
+    /// belong to external halo Data (only used for the communication
+    /// statistics)
+    Vector<unsigned> Nexternal_halo_receive_value;
+
+    /// \short Persistent requests: the receives come first, followed by
+    /// the sends
+    Vector<MPI_Request> Request;
+  };
+
+
+  //=======================================================================
+  /// \short Base class for the objects that pack and unpack the
+  /// flat-packed records (one per base element) that are streamed
+  /// between processors during load balancing (see
+  /// Problem::stream_records_for_load_balancing(...)). The records are
+  /// only packed when there's space for them in a message, so the
+  /// complete data to be sent is never held in memory.
+  //=======================================================================
+  class LoadBalancingRecordStream
+  {
+  public:
+    /// Empty constructor
+    LoadBalancingRecordStream() {}
+
+    /// Empty virtual destructor
+    virtual ~LoadBalancingRecordStream() {}
+
+    /// \short Append the record for base element e that is to be sent
+    /// to processor p to send_buffer
+    virtual void pack_record(const unsigned& p,
+                             const unsigned& e,
+                             Vector<unsigned>& send_buffer) = 0;
+
+    /// \short Unpack the record that starts at receive_buffer[count]
+    /// and advance count to the start of the next one
+    virtual void unpack_record(const Vector<unsigned>& receive_buffer,
+                               unsigned& count) = 0;
+  };
+
+#endif
+
   /////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////
@@ -505,6 +602,20 @@ namespace oomph
     /// non-distributed problem.
     void recompute_load_balanced_assembly();
 
+    /// \short Helper function to order the elements in the range
+    /// [el_lo,el_hi_plus_one) for assembly while a split-phase
+    /// synchronisation of the dofs is pending: The first
+    /// n_interior_element entries of element_order are the elements whose
+    /// dofs are all stored on this processor; the remaining ones involve
+    /// halo dofs and can only be assembled once the synchronisation
+    /// has been completed.
+    void get_element_order_for_overlapped_assembly(
+      AssemblyHandler* const& assembly_handler_pt,
+      const unsigned long& el_lo,
+      const unsigned long& el_hi_plus_one,
+      Vector<unsigned long>& element_order,
+      unsigned long& n_interior_element);
+
     /// \short Boolean to switch on assessment of load imbalance in parallel
     /// assembly of distributed problem
     bool Doc_imbalance_in_parallel_assembly;
@@ -547,6 +658,160 @@ namespace oomph
     /// following the adjustment of this when pruning.
     Vector<GeneralisedElement*> Base_mesh_element_pt;
 
+    /// \short Sparse counterpart of Base_mesh_element_pt for problems
+    /// distributed with distribute_locally_built_problem(...): only the
+    /// base elements built on this processor are stored, keyed by their
+    /// number in the (never assembled) global mesh. Empty otherwise.
+    std::map<unsigned long, GeneralisedElement*>
+      Locally_built_base_mesh_element_pt;
+
+    /// \short Number of base elements in the global mesh of a problem
+    /// distributed with distribute_locally_built_problem(...); zero
+    /// otherwise.
+    unsigned long Nlocally_built_base_mesh_element;
+
+    /// \short Number of base elements in the global mesh (from whichever
+    /// of the two lookup schemes above is in use)
+    unsigned long nbase_mesh_element() const
+    {
+      if (Base_mesh_element_pt.empty())
+      {
+        return Nlocally_built_base_mesh_element;
+      }
+      return Base_mesh_element_pt.size();
+    }
+
+    /// \short Pointer to the e-th base element in the global mesh (from
+    /// whichever of the two lookup schemes above is in use). Null if it
+    /// doesn't exist on this processor.
+    GeneralisedElement* base_mesh_element_pt(const unsigned long& e) const
+    {
+      if (Base_mesh_element_pt.empty())
+      {
+        std::map<unsigned long, GeneralisedElement*>::const_iterator it =
+          Locally_built_base_mesh_element_pt.find(e);
+        if (it == Locally_built_base_mesh_element_pt.end())
+        {
+          return 0;
+        }
+        return it->second;
+      }
+      return Base_mesh_element_pt[e];
+    }
+
+    /// \short Null out the entries for the (deleted) element el_pt in the
+    /// base mesh lookup schemes
+    void null_base_mesh_element(GeneralisedElement* const& el_pt)
+    {
+      unsigned old_el_number = Base_mesh_element_number_plus_one[el_pt] - 1;
+      Base_mesh_element_number_plus_one[el_pt] = 0;
+      if (Base_mesh_element_pt.empty())
+      {
+        Locally_built_base_mesh_element_pt.erase(old_el_number);
+      }
+      else
+      {
+        Base_mesh_element_pt[old_el_number] = 0;
+      }
+    }
+
+    /// \short Wipe the sparse base mesh lookup scheme (before the dense
+    /// one, Base_mesh_element_pt, is set up for the global mesh)
+    void clear_locally_built_base_mesh_element_pt()
+    {
+      Locally_built_base_mesh_element_pt.clear();
+      Nlocally_built_base_mesh_element = 0;
+    }
+
+    /// \short Boolean to indicate that the synchronisation of the dofs
+    /// following a Newton update is to be overlapped with the subsequent
+    /// assembly. Default: false
+    bool Overlap_dof_synchronisation_with_assembly;
+
+    /// \short Boolean to indicate that actions_after_newton_step() and
+    /// actions_before_newton_convergence_check() only use locally stored
+    /// values and can therefore be called while the synchronisation of
+    /// the dofs is still in progress. Default: false (the synchronisation
+    /// is completed before these functions are called)
+    bool Newton_step_actions_only_use_local_values;
+
+    /// \short Boolean to indicate that a split-phase synchronisation of
+    /// the dofs has been started but not yet completed
+    bool Dof_synchronisation_is_pending;
+
+    /// \short Does the pending synchronisation of the dofs deal with the
+    /// "normal" halo/ed data?
+    bool Pending_synchronisation_of_halos;
+
+    /// \short Does the pending synchronisation of the dofs deal with the
+    /// external halo/ed data?
+    bool Pending_synchronisation_of_external_halos;
+
+    /// \short Persistent communication plans for the synchronisation of
+    /// the dofs, indexed by 2*do_halos+do_external_halos. Built on demand
+    /// and deleted when the equations are re-numbered.
+    std::map<unsigned, DofSynchronisationPlan*> Dof_synchronisation_plan_pt;
+
+    /// \short Helper function to build the persistent communication plan
+    /// for the synchronisation of the dofs. Bools control if we deal with
+    /// data associated with external halo/ed elements/nodes or the
+    /// "normal" halo/ed ones.
+    DofSynchronisationPlan* build_dof_synchronisation_plan(
+      const bool& do_halos, const bool& do_external_halos);
+
+    /// \short MPI tag used for the messages exchanged during the
+    /// synchronisation of the dofs
+    static const int Dof_synchronisation_tag = 4201;
+
+    /// \short Boolean to indicate that the problem is to be load
+    /// balanced automatically (see load_balance_if_imbalanced()).
+    /// Default: false
+    bool Automatic_load_balancing;
+
+    /// \short Max. load imbalance (in percent) tolerated before an
+    /// automatic load balancing is performed
+    double Max_imbalance_for_automatic_load_balancing;
+
+    /// \short Boolean to indicate that the imbalance is to be documented
+    /// once it has been measured after an automatic load balancing
+    bool Doc_imbalance_after_automatic_load_balancing;
+
+    /// \short Time spent in the linear solver on this processor since
+    /// the last (re-)assignment of the equation numbers
+    double Linear_solver_time_for_load_balancing;
+
+    /// \short Number of linear solves included in
+    /// Linear_solver_time_for_load_balancing
+    unsigned Nlinear_solve_for_load_balancing;
+
+    /// \short Strategy used to re-partition the problem during load
+    /// balancing (one of the values of the enumeration
+    /// METIS::Repartitioning_method). Default: partition from scratch
+    unsigned Repartitioning_method_for_load_balancing;
+
+    /// \short Max. number of entries in the messages that stream the
+    /// refinement pattern between processors during load balancing
+    unsigned Max_message_size_for_load_balancing;
+
+    /// \short Max. number of messages that a processor has in flight
+    /// (i.e. sent but not yet received) while streaming the refinement
+    /// pattern between processors during load balancing
+    unsigned Max_n_message_in_flight_for_load_balancing;
+
+    /// \short MPI tag used for the messages that send the refinement
+    /// pattern of the root elements to their new processors during load
+    /// balancing
+    static const int Load_balancing_refinement_info_tag = 4205;
+
+    /// \short MPI tag used for the messages that forward the refinement
+    /// pattern of haloed root elements to their halo processors during
+    /// load balancing
+    static const int Load_balancing_halo_refinement_info_tag = 4206;
+
+    /// \short MPI tag used for the messages exchanged while writing and
+    /// reading partition-independent checkpoints
+    static const int Checkpoint_exchange_tag = 4207;
+
 #endif
 
   protected:
@@ -670,6 +935,31 @@ namespace oomph
     /// matrix is zero. If it is then storage need not be allocated.
     double Numerical_zero_for_sparse_assembly;
 
+    /// \short Boolean flag to indicate if the elemental contributions
+    /// are to be computed by the rank's thread pool during the sparse
+    /// assembly. Initialised to false.
+    bool Use_threaded_assembly;
+
+    /// \short Number of elements whose contributions are computed
+    /// simultaneously (and stored) during threaded assembly, before
+    /// they are inserted into the global storage scheme.
+    unsigned Threaded_assembly_chunk_size;
+
+    /// \short Helper function for threaded assembly: Compute the
+    /// contributions of the (non-halo) elements whose numbers are
+    /// stored in element_number, using the rank's thread pool.
+    /// The contributions of the k-th element are returned in
+    /// el_residuals[k] and el_jacobian[k] (which must have been sized
+    /// appropriately); if doc_time is true the time
+    /// taken to compute them is returned in el_assembly_time[k].
+    void get_element_contributions_with_threads(
+      AssemblyHandler* const& assembly_handler_pt,
+      const Vector<unsigned long>& element_number,
+      Vector<Vector<Vector<double>>>& el_residuals,
+      Vector<Vector<DenseMatrix<double>>>& el_jacobian,
+      const bool& doc_time,
+      Vector<double>& el_assembly_time);
+
     /// \short Protected helper function that is used to assemble the Jacobian
     /// matrix in the case when the storage is row or column compressed.
     /// The boolean Flag indicates
@@ -875,6 +1165,45 @@ namespace oomph
       Elemental_assembly_time.clear();
     }
 
+    /// \short Return vector of the most-recent measured costs of the
+    /// elements (used for load balancing): their assembly time plus
+    /// their share of the time spent in the linear solver on this
+    /// processor (distributed over the non-halo elements in proportion to
+    /// their number of dofs). Zero sized if no Jacobian has been computed
+    /// since last re-assignment of equation numbers
+    Vector<double> elemental_load_balancing_cost();
+
+    /// \short Imbalance (in percent, defined as (max-min)/average, as in
+    /// the doc of the imbalance in parallel assembly) of the measured
+    /// costs of the non-halo elements on the various processors
+    /// (see elemental_load_balancing_cost()). Negative if the costs
+    /// have not been measured on all processors.
+    double load_imbalance();
+
+    /// \short Enable automatic load balancing: Before each (adaptive)
+    /// steady solve and before each timestep, the problem is load
+    /// balanced (using the measured costs of the elements as weights
+    /// for the partitioning) if the load imbalance exceeds
+    /// max_imbalance (in percent).
+    void enable_automatic_load_balancing(const double& max_imbalance = 20.0)
+    {
+      Automatic_load_balancing = true;
+      Max_imbalance_for_automatic_load_balancing = max_imbalance;
+    }
+
+    /// \short Disable automatic load balancing (default)
+    void disable_automatic_load_balancing()
+    {
+      Automatic_load_balancing = false;
+    }
+
+    /// \short Load balance the problem if the measured load imbalance
+    /// exceeds the threshold specified in
+    /// enable_automatic_load_balancing(...); doc the imbalance before
+    /// and (once it has been measured) after the load balancing.
+    /// Returns true if the problem was load balanced.
+    bool load_balance_if_imbalanced(const bool& report_stats = false);
+
   private:
     /// \short Load balance helper routine: Get data to be sent to other
     /// processors during load balancing and other information about
@@ -936,7 +1265,23 @@ namespace oomph
       Vector<double>& send_data,
       Vector<int>& send_displacement);
 
-    /// Send refinement information between processors
+    /// \short Load balance helper routine: Stream the records for the
+    /// base elements listed in base_element_for_proc[p] to processor p
+    /// and unpack the records that are received from other processors
+    /// as they arrive. The records are packed (by the stream) in
+    /// messages of at most Max_message_size_for_load_balancing entries
+    /// (records that are longer than this are sent in their own
+    /// message), and at most Max_n_message_in_flight_for_load_balancing
+    /// of these are sent at any one time. Must be called by all
+    /// processors.
+    void stream_records_for_load_balancing(
+      std::map<unsigned, Vector<unsigned>>& base_element_for_proc,
+      LoadBalancingRecordStream& record_stream,
+      const int& tag);
+
+    /// \short Send refinement information between processors (streamed
+    /// in bounded-size messages, see
+    /// stream_records_for_load_balancing(...))
     void send_refinement_info_helper(
       Vector<unsigned>& old_domain_for_base_element,
       Vector<unsigned>& new_domain_for_base_element,
@@ -1460,6 +1805,35 @@ namespace oomph
       Use_default_partition_in_load_balance = false;
     }
 
+    /// \short Access to the strategy used to re-partition the problem
+    /// during load balancing: one of the values of the enumeration
+    /// METIS::Repartitioning_method. The incremental strategies
+    /// (METIS::Scratch_remap_repartitioning and
+    /// METIS::Diffusive_repartitioning) minimise the number of
+    /// elements that are migrated. Default:
+    /// METIS::Scratch_repartitioning
+    unsigned& repartitioning_method_for_load_balancing()
+    {
+      return Repartitioning_method_for_load_balancing;
+    }
+
+    /// \short Access to the max. number of entries in the individual
+    /// messages that stream the refinement pattern between processors
+    /// during load balancing (bounds the size of the send/receive
+    /// buffers). Default: 65536
+    unsigned& max_message_size_for_load_balancing()
+    {
+      return Max_message_size_for_load_balancing;
+    }
+
+    /// \short Access to the max. number of messages that a processor
+    /// has in flight at any one time while streaming the refinement
+    /// pattern between processors during load balancing. Default: 8
+    unsigned& max_n_message_in_flight_for_load_balancing()
+    {
+      return Max_n_message_in_flight_for_load_balancing;
+    }
+
     /// \short Load balance helper routine: refine each new base (sub)mesh
     /// based upon the elements to be refined within each tree at each root
     /// on the current processor
@@ -1998,6 +2372,33 @@ namespace oomph
       return Jacobian_reuse_is_enabled;
     }
 
+    /// \short Enable threaded assembly: The elemental contributions to
+    /// the residuals and Jacobian are computed by the rank's thread pool
+    /// (see ThreadingHelpers) and then inserted into the global storage
+    /// scheme by a single thread. Only used by the default sparse
+    /// assembly method and by the assembly of distributed problems;
+    /// has no effect if the library was built without OpenMP support.
+    /// NOTE: The elements' get_jacobian(...) etc. must be thread-safe;
+    /// in particular they must not rely on finite differencing, which
+    /// perturbs the (shared) nodal values.
+    void enable_threaded_assembly()
+    {
+      Use_threaded_assembly = true;
+    }
+
+    /// \short Disable threaded assembly (default)
+    void disable_threaded_assembly()
+    {
+      Use_threaded_assembly = false;
+    }
+
+    /// \short Number of elements whose contributions are computed
+    /// simultaneously during threaded assembly
+    unsigned& threaded_assembly_chunk_size()
+    {
+      return Threaded_assembly_chunk_size;
+    }
+
     bool& use_predictor_values_as_initial_guess()
     {
       return Use_predictor_values_as_initial_guess;
@@ -2096,6 +2497,271 @@ namespace oomph
       dump(dump_stream);
     }
 
+    /// \short Dump time, timesteps and all Data values (incl. history
+    /// values), nodal positions and Lagrangian coordinates to a versioned,
+    /// checksummed binary restart file (one per processor; the
+    /// stream must have been opened in binary mode). Much faster and more
+    /// compact than dump(...). Like dump(...), the file also records the
+    /// base elements the processor is in charge of and the refinement
+    /// pattern of its tree-based refineable meshes, so read_binary(...)
+    /// can restore the distribution and the refinement (on the same
+    /// number of processors).
+    void dump_binary(std::ofstream& dump_file) const;
+
+    /// \short Dump Problem data to binary restart file with specified name
+    /// (see dump_binary(std::ofstream&))
+    void dump_binary(const std::string& dump_file_name) const
+    {
+      std::ofstream dump_stream(dump_file_name.c_str(), std::ios::binary);
+#ifdef PARANOID
+      if (!dump_stream.is_open())
+      {
+        std::string err = "Couldn't open file " + dump_file_name;
+        throw OomphLibError(
+          err, OOMPH_EXCEPTION_LOCATION, OOMPH_CURRENT_FUNCTION);
+      }
+#endif
+      dump_binary(dump_stream);
+    }
+
+    /// \short Read Problem data from a binary restart file written by
+    /// dump_binary(...) (stream must have been opened in binary mode;
+    /// must be called on all processors). The checksum is checked first.
+    /// Then a distributed Problem is load balanced so each processor is
+    /// in charge of the same base elements as when the file was written,
+    /// and the tree-based refineable meshes are refined as they were.
+    /// Following this, the layout of the Problem's Data must be identical
+    /// to that recorded in the file (this is checked). Errors are thrown
+    /// on all processors. Return flag to indicate if the restart was
+    /// from a steady or unsteady solution.
+    void read_binary(std::ifstream& restart_file, bool& unsteady_restart);
+
+    /// \short Read Problem data from a binary restart file written by
+    /// dump_binary(...)
+    void read_binary(std::ifstream& restart_file)
+    {
+      bool unsteady_restart;
+      read_binary(restart_file, unsteady_restart);
+    }
+
+    /// \short Convert a binary restart file (written by dump_binary(...))
+    /// to the text format written by dump(...): The binary data is read
+    /// into this Problem (which must therefore be in the state required by
+    /// read_binary(...)) which is then dumped.
+    void convert_binary_restart_file(const std::string& binary_file_name,
+                                     const std::string& text_file_name);
+
+    /// \short Version of the binary restart format written by
+    /// dump_binary(...). Version 2 added the distribution and the
+    /// refinement pattern; files in version 1 can still be read (as
+    /// long as the Problem is distributed and refined as when they were
+    /// written).
+    static const unsigned Binary_restart_format_version = 2;
+
+  private:
+    /// \short Helper function for binary restarts: Get the layout of all
+    /// restart data (number of nodes, values, history values, etc.) and
+    /// pointers to all doubles to be dumped/read (in the same order as
+    /// the layout)
+    void get_binary_restart_data(Vector<unsigned>& layout,
+                                 Vector<double*>& restart_value_pt) const;
+
+    /// \short Helper function for binary restarts: Get the numbers of
+    /// the base elements this processor is in charge of (empty if the
+    /// Problem isn't distributed) and the refinement patterns of the
+    /// tree-based refineable (sub)meshes, flat-packed: number of meshes,
+    /// then for each mesh the number of levels and for each level the
+    /// number of elements to be refined, followed by their numbers (as
+    /// in TreeBasedRefineableMeshBase::get_refinement_pattern(...)).
+    void get_binary_restart_structure(
+      Vector<unsigned>& non_halo_base_element,
+      Vector<unsigned>& flat_packed_refinement_pattern) const;
+
+#ifdef OOMPH_HAS_MPI
+    /// \short Helper function for binary restarts: Load balance the
+    /// (distributed) Problem such that each processor is in charge of
+    /// the base elements listed in non_halo_base_element (as recorded
+    /// when the file was written). Must be called on all processors.
+    void load_balance_as_in_binary_restart(
+      const Vector<unsigned>& non_halo_base_element);
+#endif
+
+    /// \short Helper function for restarts: Rebuild the tree-based
+    /// refineable (sub)meshes from their base meshes such that (sub)mesh
+    /// m is refined as specified by to_be_refined[m] (in the form
+    /// returned by TreeBasedRefineableMeshBase::get_refinement_pattern(...)),
+    /// unless they're all refined in that way already. Must be called on
+    /// all processors.
+    void refine_as_in_restart(Vector<Vector<Vector<unsigned>>>& to_be_refined);
+
+  public:
+    /// \short Write a partition-independent checkpoint (must be called on
+    /// all processors): All Data values (incl. history values), nodal
+    /// positions and Lagrangian coordinates are keyed by global IDs
+    /// that don't depend on the distribution of the Problem (base element
+    /// plus path through the refinement tree for elements in tree-based
+    /// refineable meshes; the keys of the adjacent elements for nodes;
+    /// Lagrangian coordinates (or, for non-solid nodes, the positions)
+    /// of the nodes for unstructured meshes). The refinement pattern of
+    /// each base element in tree-based refineable meshes is stored as
+    /// well. The records are hashed into buckets (one per processor) and
+    /// each processor writes one bucket to [file_stem]_bucket[b].dat, so
+    /// the output is done in parallel. The checkpoint can be read by
+    /// read_partition_independent_checkpoint(...) on any number of
+    /// processors, provided the meshes have been set up (and distributed,
+    /// in any way) from the same base meshes. NOTE: Pruning changes the
+    /// base elements so checkpoints can't be transferred between runs in
+    /// which halo elements were pruned; non-solid nodes in unstructured
+    /// meshes must not have moved.
+    void dump_partition_independent_checkpoint(
+      const std::string& file_stem) const;
+
+    /// \short Read a checkpoint written by
+    /// dump_partition_independent_checkpoint(...), possibly on a different
+    /// number of processors (must be called on all processors). Each
+    /// processor reads a subset of the bucket files and serves the records
+    /// requested by the other processors. The tree-based refineable
+    /// meshes are first refined as in the checkpoint (starting from
+    /// their base meshes); halo data is obtained from the processors
+    /// that hold the non-halo counterparts. Errors (e.g. missing or
+    /// corrupted files) are reported on all processors. Return flag to
+    /// indicate if the restart was from a steady or unsteady solution.
+    void read_partition_independent_checkpoint(const std::string& file_stem,
+                                               bool& unsteady_restart);
+
+    /// \short Read a checkpoint written by
+    /// dump_partition_independent_checkpoint(...)
+    void read_partition_independent_checkpoint(const std::string& file_stem)
+    {
+      bool unsteady_restart;
+      read_partition_independent_checkpoint(file_stem, unsteady_restart);
+    }
+
+  private:
+    /// \short Helper function for partition-independent checkpoints:
+    /// Get the (partition-independent) numbers of the base elements, i.e.
+    /// the elements that are numbered when the problem is distributed
+    void get_checkpoint_base_element_numbers(
+      std::map<GeneralisedElement*, unsigned>& base_element_number) const;
+
+    /// \short Helper function for partition-independent checkpoints:
+    /// Get the partition-independent key for the specified element
+    std::string checkpoint_element_key(
+      GeneralisedElement* el_pt,
+      const std::map<GeneralisedElement*, unsigned>& base_element_number) const;
+
+    /// \short Helper function for partition-independent checkpoints: Get the
+    /// keys of all records (non-halo nodes, non-halo elements with
+    /// internal data and, if requested, the global data) and the
+    /// Data associated with each record (the node, the element's
+    /// internal Data, or the global Data)
+    void get_checkpoint_records(Vector<std::string>& key,
+                                Vector<Vector<Data*>>& record_data_pt,
+                                const bool& include_global_data) const;
+
+    /// \short Helper function for partition-independent checkpoints: Get the
+    /// keys of the refinement patterns of the (non-halo) base elements in
+    /// tree-based refineable meshes and the patterns themselves (number
+    /// of sons of the nodes in the refinement tree, in the order in which
+    /// they're visited by Tree::stick_all_tree_nodes_into_vector(...))
+    void get_checkpoint_refinement_records(
+      Vector<std::string>& key, Vector<Vector<double>>& pattern) const;
+
+    /// \short Helper function for partition-independent checkpoints: Refine
+    /// the tree-based refineable meshes as in the checkpoint whose records
+    /// (read on this processor) are in bucket_record
+    void refine_as_in_checkpoint(
+      const unsigned& n_bucket,
+      const std::map<std::string, Vector<double>>& bucket_record);
+
+    /// \short Helper function for partition-independent checkpoints: Key
+    /// based on the (bitwise) Lagrangian coordinates of SolidNodes (which
+    /// don't change when the mesh moves) or the nodal position of other
+    /// nodes
+    static std::string checkpoint_position_key(Node* const& nod_pt);
+
+    /// \short Helper function for partition-independent checkpoints: Bucket
+    /// (out of n_bucket) in which the record with the specified key is
+    /// stored
+    static unsigned checkpoint_bucket(const std::string& key,
+                                      const unsigned& n_bucket);
+
+    /// \short Helper function for partition-independent checkpoints: Append
+    /// record (key and data) to byte buffer
+    static void append_checkpoint_record(std::string& buffer,
+                                         const std::string& key,
+                                         const Vector<double>& data);
+
+    /// \short Helper function for partition-independent checkpoints: Add
+    /// the records in the byte buffer to the map (keyed by the records'
+    /// keys). Duplicate keys are an error.
+    static void parse_checkpoint_records(
+      const std::string& buffer, std::map<std::string, Vector<double>>& record);
+
+    /// \short Helper function for partition-independent checkpoints: Read
+    /// the header (number of buckets and time data) and, if read_records
+    /// is true, the records of the specified bucket file
+    static void read_checkpoint_bucket_file(
+      const std::string& filename,
+      unsigned& n_bucket,
+      unsigned& unsteady_flag,
+      double& time,
+      Vector<double>& dt,
+      std::map<std::string, Vector<double>>& record,
+      const bool& read_records);
+
+    /// \short Helper function for partition-independent checkpoints:
+    /// Exchange byte buffers between all processors (send_buffer[p] is
+    /// sent to processor p; received_buffer[p] is received from p).
+    void checkpoint_exchange(const Vector<std::string>& send_buffer,
+                             Vector<std::string>& received_buffer) const;
+
+    /// \short Helper function for partition-independent checkpoints:
+    /// Request the records with the specified keys from the processors
+    /// that hold their buckets (processor p holds the buckets b with
+    /// b % nproc == p; its records are in bucket_record) and add the
+    /// replies to record. Missing records are skipped.
+    void request_checkpoint_records(
+      const Vector<std::string>& key,
+      const unsigned& n_bucket,
+      const std::map<std::string, Vector<double>>& bucket_record,
+      std::map<std::string, Vector<double>>& record) const;
+
+    /// \short Helper function for checkpoints and binary restarts: Throw
+    /// the specified error (if it's not empty) on all processors as soon
+    /// as any of them has encountered one, so nobody is left waiting in
+    /// the subsequent communication
+    void checkpoint_collective_error_check(
+      const std::string& error_message) const;
+
+    /// \short Helper function for checkpoints: Append the restart data of
+    /// the specified Data (incl. positions and Lagrangian coordinates
+    /// for (Solid)Nodes) to the vector
+    static void pack_checkpoint_data(Data* const& data_pt,
+                                     Vector<double>& data);
+
+    /// \short Helper function for checkpoints: Set the restart data of
+    /// the specified Data from data, starting at entry index (which is
+    /// incremented)
+    static void unpack_checkpoint_data(Data* const& data_pt,
+                                       const Vector<double>& data,
+                                       unsigned long& index);
+
+    /// \short Helper function for checkpoints: Check that entry index of
+    /// data (a layout entry written by pack_checkpoint_data(...)) is
+    /// equal to the expected value and increment index
+    static void check_checkpoint_layout(const Vector<double>& data,
+                                        unsigned long& index,
+                                        const unsigned& expected_value);
+
+    /// \short Helper function for checkpoints: Check that data contains
+    /// at least n_entry entries, starting at entry index
+    static void check_checkpoint_size(const Vector<double>& data,
+                                      const unsigned long& index,
+                                      const unsigned long& n_entry);
+
+  public:
+
 #ifdef OOMPH_HAS_MPI
 
     /// \short Get pointers to all possible halo data indexed by global
@@ -2116,6 +2782,70 @@ namespace oomph
     /// \short Perform all required synchronisation in solvers
     void synchronise_all_dofs();
 
+    /// \short Start the split-phase synchronisation of the degrees of
+    /// freedom: pack the haloed values and post non-blocking sends to the
+    /// processors that hold their halo counterparts. The halo values are
+    /// only overwritten when finish_synchronise_dofs() is called.
+    /// Bools control if we deal with data associated with external
+    /// halo/ed elements/nodes or the "normal" halo/ed ones.
+    void start_synchronise_dofs(const bool& do_halos,
+                                const bool& do_external_halos);
+
+    /// \short Delete the persistent communication plans used to
+    /// synchronise the dofs. They are re-built when next required. This
+    /// is done automatically when the equations are re-numbered but must be
+    /// called explicitly if the halo(ed) lookup schemes or the number of
+    /// values stored in halo(ed) Data are changed without re-numbering.
+    void invalidate_dof_synchronisation_plans();
+
+    /// \short Start the split-phase version of synchronise_all_dofs();
+    /// complete it with finish_synchronise_dofs().
+    void start_synchronise_all_dofs();
+
+    /// \short Complete a split-phase synchronisation of the degrees of
+    /// freedom: receive the non-halo values and use them to overwrite
+    /// the halo ones. Does nothing if no synchronisation is pending.
+    void finish_synchronise_dofs();
+
+    /// \short Is a split-phase synchronisation of the degrees of freedom
+    /// in progress, i.e. has start_synchronise_dofs(...) been called
+    /// without a subsequent call to finish_synchronise_dofs()?
+    bool dof_synchronisation_is_pending() const
+    {
+      return Dof_synchronisation_is_pending;
+    }
+
+    /// \short Enable the overlap of the synchronisation of the dofs
+    /// with the assembly in the Newton iteration: Following the update
+    /// of the dofs, the exchange of the halo values is only started. The
+    /// next assembly then computes the contributions from all elements
+    /// whose dofs are stored locally first, and only waits for the halo
+    /// values before dealing with the remaining ones. By default, the
+    /// exchange is completed before actions_after_newton_step() and
+    /// actions_before_newton_convergence_check() are called, so these
+    /// always see up-to-date halo values (and the overlap only covers
+    /// the assembly handler's synchronisation). Set the flag to true
+    /// if these functions only use locally stored values; the exchange
+    /// then remains in progress while they're executed. NOTE: Only the
+    /// synchronisation of the dofs is split-phase; all other
+    /// synchronisations (e.g. Mesh::synchronise_shared_nodes(...) and
+    /// DoubleVectorWithHaloEntries::synchronise()) remain blocking.
+    void enable_overlap_of_dof_synchronisation_with_assembly(
+      const bool& newton_step_actions_only_use_local_values = false)
+    {
+      Overlap_dof_synchronisation_with_assembly = true;
+      Newton_step_actions_only_use_local_values =
+        newton_step_actions_only_use_local_values;
+    }
+
+    /// \short Disable the overlap of the synchronisation of the dofs
+    /// with the assembly in the Newton iteration (default)
+    void disable_overlap_of_dof_synchronisation_with_assembly()
+    {
+      Overlap_dof_synchronisation_with_assembly = false;
+      Newton_step_actions_only_use_local_values = false;
+    }
+
     /// Check the halo/haloed node/element schemes
     void check_halo_schemes(DocInfo& doc_info);
 
@@ -2147,6 +2877,24 @@ namespace oomph
     /// details the partitioning
     Vector<unsigned> distribute(const bool& report_stats = false);
 
+    /// \short Memory-scalable alternative to distribute(...) for problems
+    /// whose (sub)meshes were built "locally" on each processor, i.e.
+    /// they only contain the elements the processor is in charge of plus
+    /// the halo layer (see METIS::get_elements_for_locally_built_mesh(...)
+    /// for a helper that identifies these from a block-distributed read
+    /// of the mesh connectivity). global_element_number[e] and
+    /// element_domain[e] specify the number of the e-th element of the
+    /// Problem's (global) mesh in the never-assembled global mesh and the
+    /// processor in charge of it. The halo lookup schemes are set up by
+    /// exchanges between neighbouring processors (see
+    /// Mesh::distribute_locally_built_mesh(...)), then the equation
+    /// numbers are assigned. Unlike distribute(), this doesn't call
+    /// actions_before_distribute() or actions_after_distribute().
+    void distribute_locally_built_problem(
+      const Vector<unsigned long>& global_element_number,
+      const Vector<unsigned>& element_domain,
+      const bool& report_stats = false);
+
     /// /short Partition the global mesh, return vector specifying the processor
     /// number for each element. Virtual so that it can be overloaded by
     /// any user; the default is to use METIS to perform the partitioning
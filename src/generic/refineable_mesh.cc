@@ -1271,9 +1271,11 @@ namespace oomph
       /// and for this reason the mesh writer might have decided not to
       /// set up this scheme. If so, we won't change this and suppress
       /// its creation...
+      /// (If it's been set up, we only mark it for re-setup when it's
+      /// next accessed.)
       if (Lookup_for_elements_next_boundary_is_setup)
       {
-        this->setup_boundary_element_info();
+        this->defer_boundary_element_info_setup();
       }
 
       if (Global_timings::Doc_comprehensive_timings)
@@ -4683,9 +4685,11 @@ namespace oomph
       /// Update the boundary element info -- this can be a costly procedure
       /// and for this reason the mesh writer might have decided not to set up
       /// this scheme. If so, we won't change this and suppress its creation...
+      /// (If it's been set up, we only mark it for re-setup when it's
+      /// next accessed.)
       if (Lookup_for_elements_next_boundary_is_setup)
       {
-        this->setup_boundary_element_info();
+        this->defer_boundary_element_info_setup();
       }
 
       if (Global_timings::Doc_comprehensive_timings)
@@ -576,9 +576,16 @@ namespace oomph
           Bin_array_pt->root_bin_array_pt()
             ->total_number_of_sample_points_visited_during_locate_zeta_from_top_level()++;
 
-          bool use_coordinate_as_initial_guess = true;
-          el_pt->locate_zeta(
-            zeta, sub_geom_object_pt, s, use_coordinate_as_initial_guess);
+          // Only bother with the Newton iteration if the element
+          // can contain the point
+          if (Bin_array_pt->root_bin_array_pt()
+                ->element_bounding_box_contains_zeta(
+                  (*Sample_point_pt)[i]->element_index_in_mesh(), zeta))
+          {
+            bool use_coordinate_as_initial_guess = true;
+            el_pt->locate_zeta(
+              zeta, sub_geom_object_pt, s, use_coordinate_as_initial_guess);
+          }
 
           // Always fail? (Used for debugging, e.g. to trace out
           // spiral path)
@@ -652,6 +659,15 @@ namespace oomph
   /// Offset of sample point container boundaries beyond max/min coords
   double SamplePointContainer::Percentage_offset = 5.0;
 
+  /// \short Only call FiniteElement::locate_zeta(...) for elements whose
+  /// bounding box contains the point to be located?
+  bool SamplePointContainer::Use_element_bounding_box_prefilter = false;
+
+  /// \short Amount by which the elements' bounding boxes are increased
+  /// in each direction (relative to their largest extent)
+  double SamplePointContainer::Relative_tolerance_for_element_bounding_box =
+    0.1;
+
 
   //==============================================================================
   /// Max. bin dimension (number of bins in coordinate directions)
@@ -827,6 +843,75 @@ namespace oomph
   }
 
 
+  //========================================================================
+  /// Setup the (inflated) bounding boxes of the elements in the mesh,
+  /// in terms of their intrinsic coordinates. The elements are sampled
+  /// at their vertices and edge midpoints (more if more sample points
+  /// are generated per element), so the boxes are inflated by
+  /// Relative_tolerance_for_element_bounding_box to allow for curved
+  /// element boundaries.
+  //========================================================================
+  void SamplePointContainer::setup_element_bounding_boxes()
+  {
+    // Get the lagrangian dimension
+    const unsigned n_lagrangian = ndim_zeta();
+
+    // Number of plot points (in each direction) used to sample the elements
+    const unsigned n_plot = std::max(Nsample_points_generated_per_element,
+                                     unsigned(3));
+
+    unsigned n_el = Mesh_pt->nelement();
+    Element_bounding_box.resize(2 * n_el * n_lagrangian);
+
+    // The elements are independent of each other
+    long n_element = n_el;
+#ifdef _OPENMP
+    bool use_threads = ThreadingHelpers::use_threads(n_el);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long e = 0; e < n_element; e++)
+    {
+      FiniteElement* el_pt = Mesh_pt->finite_element_pt(e);
+
+      Vector<double> zeta_min(n_lagrangian, DBL_MAX);
+      Vector<double> zeta_max(n_lagrangian, -DBL_MAX);
+      Vector<double> s_local(n_lagrangian);
+      Vector<double> zeta_global(n_lagrangian);
+      unsigned n_plot_points = el_pt->nplot_points(n_plot);
+      for (unsigned iplot = 0; iplot < n_plot_points; iplot++)
+      {
+        // Sample over the entire range of the element
+        bool use_equally_spaced_interior_sample_points = false;
+        el_pt->get_s_plot(
+          iplot, n_plot, s_local, use_equally_spaced_interior_sample_points);
+
+        // FiniteElement::locate_zeta(...) works with the intrinsic
+        // coordinates
+        el_pt->interpolated_zeta(s_local, zeta_global);
+        for (unsigned i = 0; i < n_lagrangian; i++)
+        {
+          zeta_min[i] = std::min(zeta_min[i], zeta_global[i]);
+          zeta_max[i] = std::max(zeta_max[i], zeta_global[i]);
+        }
+      }
+
+      // Inflate by a fraction of the largest extent
+      double max_extent = 0.0;
+      for (unsigned i = 0; i < n_lagrangian; i++)
+      {
+        max_extent = std::max(max_extent, zeta_max[i] - zeta_min[i]);
+      }
+      double offset = Relative_tolerance_for_element_bounding_box * max_extent;
+      for (unsigned i = 0; i < n_lagrangian; i++)
+      {
+        Element_bounding_box[2 * (e * n_lagrangian + i)] = zeta_min[i] - offset;
+        Element_bounding_box[2 * (e * n_lagrangian + i) + 1] =
+          zeta_max[i] + offset;
+      }
+    }
+  }
+
+
   //////////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////////////
@@ -955,7 +1040,8 @@ namespace oomph
 #endif
 
     // Initialise
-    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level = 0;
+    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level
+      .assign(1, 0);
     First_sample_point_to_actually_lookup_during_locate_zeta = 0;
     Last_sample_point_to_actually_lookup_during_locate_zeta = UINT_MAX;
     Multiplier_for_max_sample_point_to_actually_lookup_during_locate_zeta =
@@ -974,6 +1060,10 @@ namespace oomph
         t_start = TimingHelpers::timer();
       }
       fill_bin_array();
+      if (SamplePointContainer::Use_element_bounding_box_prefilter)
+      {
+        setup_element_bounding_boxes();
+      }
       if (SamplePointContainer::Enable_timing_of_setup)
       {
         double t_end = TimingHelpers::timer();
@@ -1881,26 +1971,37 @@ namespace oomph
   //==========================================================================
   void RefineableBinArray::fill_bin_array()
   {
-    // Fill 'em in:
+    const unsigned n_lagrangian = ndim_zeta();
+
+    // Offsets of the elements' sample points in the flat-packed storage
     unsigned nel = Mesh_pt->nelement();
+    Vector<unsigned> first_sample_point_in_element(nel + 1, 0);
     for (unsigned e = 0; e < nel; e++)
     {
-      FiniteElement* el_pt = Mesh_pt->finite_element_pt(e);
-
-      // Total number of sample point we will create
-      unsigned nplot =
-        el_pt->nplot_points(Nsample_points_generated_per_element);
+      first_sample_point_in_element[e + 1] =
+        first_sample_point_in_element[e] +
+        Mesh_pt->finite_element_pt(e)->nplot_points(
+          Nsample_points_generated_per_element);
+    }
 
-      /// For all the sample points we have to create ...
+    // Compute the coordinates of all sample points first: The elements
+    // are independent of each other so this can be done in parallel
+    unsigned n_sample_point = first_sample_point_in_element[nel];
+    Vector<double> sample_point_zeta(n_sample_point * n_lagrangian);
+    long n_element = nel;
+#ifdef _OPENMP
+    bool use_threads = ThreadingHelpers::use_threads(nel);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long e = 0; e < n_element; e++)
+    {
+      FiniteElement* el_pt = Mesh_pt->finite_element_pt(e);
+      Vector<double> zeta(n_lagrangian);
+      Vector<double> s(n_lagrangian);
+      unsigned first = first_sample_point_in_element[e];
+      unsigned nplot = first_sample_point_in_element[e + 1] - first;
       for (unsigned j = 0; j < nplot; j++)
       {
-        // ... create it: Pass element index in mesh (vector
-        // of elements and index of sample point within element
-        SamplePoint* new_sample_point_pt = new SamplePoint(e, j);
-
-        // Coordinates of this point
-        Vector<double> zeta(ndim_zeta());
-        Vector<double> s(ndim_zeta());
         bool use_equally_spaced_interior_sample_points =
           SamplePointContainer::Use_equally_spaced_interior_sample_points;
         el_pt->get_s_plot(j,
@@ -1915,6 +2016,33 @@ namespace oomph
         {
           el_pt->interpolated_zeta(s, zeta);
         }
+        for (unsigned i = 0; i < n_lagrangian; i++)
+        {
+          sample_point_zeta[(first + j) * n_lagrangian + i] = zeta[i];
+        }
+      }
+    }
+
+    // Now insert them into the (recursively refined) bins, which has to
+    // be done serially
+    Vector<double> zeta(n_lagrangian);
+    for (unsigned e = 0; e < nel; e++)
+    {
+      unsigned first = first_sample_point_in_element[e];
+      unsigned nplot = first_sample_point_in_element[e + 1] - first;
+
+      /// For all the sample points we have to create ...
+      for (unsigned j = 0; j < nplot; j++)
+      {
+        // ... create it: Pass element index in mesh (vector
+        // of elements and index of sample point within element
+        SamplePoint* new_sample_point_pt = new SamplePoint(e, j);
+
+        // Coordinates of this point
+        for (unsigned i = 0; i < n_lagrangian; i++)
+        {
+          zeta[i] = sample_point_zeta[(first + j) * n_lagrangian + i];
+        }
 
 #ifdef PARANOID
 
@@ -2014,7 +2142,7 @@ namespace oomph
       // Reset counter for number of sample points visited.
       // If we can't find the point we should at least make sure that
       // we've visited all the sample points before giving up.
-      Total_number_of_sample_points_visited_during_locate_zeta_from_top_level =
+      total_number_of_sample_points_visited_during_locate_zeta_from_top_level() =
         0;
 
       // Does the zeta coordinate lie within the current (top level!) bin
@@ -2132,7 +2260,7 @@ namespace oomph
     if (Depth == 0)
     {
       if (
-        Total_number_of_sample_points_visited_during_locate_zeta_from_top_level !=
+        total_number_of_sample_points_visited_during_locate_zeta_from_top_level() !=
         total_number_of_sample_points_computed_recursively())
       {
         if (max_search_radius() == DBL_MAX)
@@ -2140,7 +2268,7 @@ namespace oomph
           std::ostringstream error_message;
           error_message
             << "Zeta not found after visiting "
-            << Total_number_of_sample_points_visited_during_locate_zeta_from_top_level
+            << total_number_of_sample_points_visited_during_locate_zeta_from_top_level()
             << " sample points out of "
             << total_number_of_sample_points_computed_recursively() << std::endl
             << "Where are the missing sample points???\n";
@@ -2263,6 +2391,10 @@ namespace oomph
 
     // Now fill the bastard...
     fill_bin_array();
+    if (SamplePointContainer::Use_element_bounding_box_prefilter)
+    {
+      setup_element_bounding_boxes();
+    }
 
     if (SamplePointContainer::Enable_timing_of_setup)
     {
@@ -2283,22 +2415,7 @@ namespace oomph
   unsigned NonRefineableBinArray::
     total_number_of_sample_points_computed_recursively() const
   {
-    // Get pointer to map-based representation
-    const std::map<unsigned, Vector<std::pair<FiniteElement*, Vector<double>>>>*
-      map_pt = Bin_object_coord_pairs.map_pt();
-
-    // Initialise
-    unsigned count = 0;
-
-    // loop...
-    typedef std::map<
-      unsigned,
-      Vector<std::pair<FiniteElement*, Vector<double>>>>::const_iterator IT;
-    for (IT it = map_pt->begin(); it != map_pt->end(); it++)
-    {
-      count += (*it).second.size();
-    }
-    return count;
+    return Sample_point_element_index.size();
   }
 
 
@@ -2323,12 +2440,18 @@ namespace oomph
       {
         for (unsigned ix = 0; ix < nbin_x; ix++)
         {
-          unsigned nentry = Bin_object_coord_pairs[b].size();
-          for (unsigned e = 0; e < nentry; e++)
+          Vector<double> s(n_lagrangian);
+          Vector<double> zeta(n_lagrangian);
+          for (unsigned k = First_sample_point_in_bin[b];
+               k < First_sample_point_in_bin[b + 1];
+               k++)
           {
-            FiniteElement* el_pt = Bin_object_coord_pairs[b][e].first;
-            Vector<double> s(Bin_object_coord_pairs[b][e].second);
-            Vector<double> zeta(n_lagrangian);
+            FiniteElement* el_pt =
+              Mesh_pt->finite_element_pt(Sample_point_element_index[k]);
+            for (unsigned i = 0; i < n_lagrangian; i++)
+            {
+              s[i] = Sample_point_local_coord[k * n_lagrangian + i];
+            }
             if (Use_eulerian_coordinates_during_setup)
             {
               el_pt->interpolated_x(s, zeta);
@@ -2407,16 +2530,9 @@ namespace oomph
     // Flush all objects out of the bin structure
     flush_bins_of_objects();
 
-    // Temporary storage in bin
-    std::map<unsigned, Vector<std::pair<FiniteElement*, Vector<double>>>>
-      tmp_bin_object_coord_pairs;
-
     // Total number of bins
     unsigned ntotalbin = nbin();
 
-    // Initialise the structure that keep tracks of the occupided bins
-    Bin_object_coord_pairs.initialise(ntotalbin);
-
 
     // Issue warning about small number of bins
     if (!Suppress_warning_about_small_number_of_bins)
@@ -2511,115 +2627,264 @@ namespace oomph
       }
     }
 
-    /// Loop over subobjects (elements) to decide which bin they belong in...
+    // Offsets of the elements' sample points in the flat-packed storage
     unsigned n_sub = Mesh_pt->nelement();
+    Vector<unsigned> first_sample_point_in_element(n_sub + 1, 0);
     for (unsigned e = 0; e < n_sub; e++)
     {
-      // Cast to the element (sub-object) first
-      FiniteElement* el_pt =
-        dynamic_cast<FiniteElement*>(Mesh_pt->finite_element_pt(e));
+      first_sample_point_in_element[e + 1] =
+        first_sample_point_in_element[e] +
+        Mesh_pt->finite_element_pt(e)->nplot_points(
+          Nsample_points_generated_per_element);
+    }
+    unsigned n_sample_point = first_sample_point_in_element[n_sub];
 
-      // Get specified number of points within the element
-      unsigned n_plot_points =
-        el_pt->nplot_points(Nsample_points_generated_per_element);
+    // Local coordinates of the sample points and the bins they belong in
+    // (in the order of the elements)
+    Vector<double> local_coord_of_sample_point(n_sample_point * n_lagrangian);
+    Vector<unsigned> bin_of_sample_point(n_sample_point);
 
-      for (unsigned iplot = 0; iplot < n_plot_points; iplot++)
+    // Exceptions must not escape from the parallel region so record
+    // the first one and rethrow it afterwards
+    bool exception_thrown = false;
+    std::string exception_message;
+
+    /// Loop over subobjects (elements) to decide which bin they belong in...
+    /// (The elements are independent of each other)
+    long n_element = n_sub;
+#ifdef _OPENMP
+    bool use_threads = ThreadingHelpers::use_threads(n_sub);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long e = 0; e < n_element; e++)
+    {
+      try
       {
+        // Cast to the element (sub-object) first
+        FiniteElement* el_pt =
+          dynamic_cast<FiniteElement*>(Mesh_pt->finite_element_pt(e));
+
         // Storage for local and global coordinates
         Vector<double> local_coord(n_lagrangian, 0.0);
         Vector<double> global_coord(n_lagrangian, 0.0);
 
-        // Get local coordinate and interpolate to global
-        bool use_equally_spaced_interior_sample_points =
-          SamplePointContainer::Use_equally_spaced_interior_sample_points;
-        el_pt->get_s_plot(iplot,
-                          Nsample_points_generated_per_element,
-                          local_coord,
-                          use_equally_spaced_interior_sample_points);
-
-        // Now get appropriate global coordinate
-        if (Use_eulerian_coordinates_during_setup)
+        // Get specified number of points within the element
+        unsigned first = first_sample_point_in_element[e];
+        unsigned n_plot_points = first_sample_point_in_element[e + 1] - first;
+        for (unsigned iplot = 0; iplot < n_plot_points; iplot++)
         {
-          el_pt->interpolated_x(local_coord, global_coord);
-        }
-        else
-        {
-          el_pt->interpolated_zeta(local_coord, global_coord);
-        }
+          // Get local coordinate and interpolate to global
+          bool use_equally_spaced_interior_sample_points =
+            SamplePointContainer::Use_equally_spaced_interior_sample_points;
+          el_pt->get_s_plot(iplot,
+                            Nsample_points_generated_per_element,
+                            local_coord,
+                            use_equally_spaced_interior_sample_points);
 
-        // Which bin are the global coordinates in?
-        unsigned bin_number = 0;
-        unsigned multiplier = 1;
-        // Loop over the dimension
-        for (unsigned i = 0; i < n_lagrangian; i++)
-        {
-#ifdef PARANOID
-          if ((global_coord[i] < Min_and_max_coordinates[i].first) ||
-              (global_coord[i] > Min_and_max_coordinates[i].second))
+          // Now get appropriate global coordinate
+          if (Use_eulerian_coordinates_during_setup)
+          {
+            el_pt->interpolated_x(local_coord, global_coord);
+          }
+          else
           {
-            std::ostringstream error_message;
-            error_message
-              << "Bin sample point " << iplot << " in element " << e << "\n"
-              << "is outside bin limits in coordinate direction " << i << ":\n"
-              << "Sample point coordinate: " << global_coord[i] << "\n"
-              << "Max bin coordinate     : "
-              << Min_and_max_coordinates[i].second << "\n"
-              << "Min bin coordinate     : " << Min_and_max_coordinates[i].first
-              << "\n"
-              << "You should either setup the bin boundaries manually\n"
-              << "or increase the percentage offset by which the\n"
-              << "automatically computed bin limits are increased \n"
-              << "beyond their sampled max/mins. This is defined in\n"
-              << "the (public) namespace member\n\n"
-              << "SamplePointContainer::Percentage_offset \n\n which \n"
-              << "currently has the value: "
-              << SamplePointContainer::Percentage_offset << "\n";
-            throw OomphLibError(error_message.str(),
-                                OOMPH_CURRENT_FUNCTION,
-                                OOMPH_EXCEPTION_LOCATION);
+            el_pt->interpolated_zeta(local_coord, global_coord);
           }
 
+          // Which bin are the global coordinates in?
+          unsigned bin_number = 0;
+          unsigned multiplier = 1;
+          // Loop over the dimension
+          for (unsigned i = 0; i < n_lagrangian; i++)
+          {
+#ifdef PARANOID
+            if ((global_coord[i] < Min_and_max_coordinates[i].first) ||
+                (global_coord[i] > Min_and_max_coordinates[i].second))
+            {
+              std::ostringstream error_message;
+              error_message
+                << "Bin sample point " << iplot << " in element " << e << "\n"
+                << "is outside bin limits in coordinate direction " << i
+                << ":\n"
+                << "Sample point coordinate: " << global_coord[i] << "\n"
+                << "Max bin coordinate     : "
+                << Min_and_max_coordinates[i].second << "\n"
+                << "Min bin coordinate     : "
+                << Min_and_max_coordinates[i].first << "\n"
+                << "You should either setup the bin boundaries manually\n"
+                << "or increase the percentage offset by which the\n"
+                << "automatically computed bin limits are increased \n"
+                << "beyond their sampled max/mins. This is defined in\n"
+                << "the (public) namespace member\n\n"
+                << "SamplePointContainer::Percentage_offset \n\n which \n"
+                << "currently has the value: "
+                << SamplePointContainer::Percentage_offset << "\n";
+              throw OomphLibError(error_message.str(),
+                                  OOMPH_CURRENT_FUNCTION,
+                                  OOMPH_EXCEPTION_LOCATION);
+            }
+
 #endif
-          unsigned bin_number_i =
-            int(Dimensions_of_bin_array[i] *
-                ((global_coord[i] - Min_and_max_coordinates[i].first) /
-                 (Min_and_max_coordinates[i].second -
-                  Min_and_max_coordinates[i].first)));
-
-          // Buffer the case when the global coordinate is the maximum
-          // value
-          if (bin_number_i == Dimensions_of_bin_array[i])
+            unsigned bin_number_i =
+              int(Dimensions_of_bin_array[i] *
+                  ((global_coord[i] - Min_and_max_coordinates[i].first) /
+                   (Min_and_max_coordinates[i].second -
+                    Min_and_max_coordinates[i].first)));
+
+            // Buffer the case when the global coordinate is the maximum
+            // value
+            if (bin_number_i == Dimensions_of_bin_array[i])
+            {
+              bin_number_i -= 1;
+            }
+
+            // Add to the bin number
+            bin_number += multiplier * bin_number_i;
+
+            // Sort out the multiplier
+            multiplier *= Dimensions_of_bin_array[i];
+          }
+
+          // Record element-sample local coord pair and its bin
+          bin_of_sample_point[first + iplot] = bin_number;
+          for (unsigned i = 0; i < n_lagrangian; i++)
           {
-            bin_number_i -= 1;
+            local_coord_of_sample_point[(first + iplot) * n_lagrangian + i] =
+              local_coord[i];
           }
+        }
+      }
+      catch (std::exception& error)
+      {
+#ifdef _OPENMP
+#pragma omp critical(fill_bin_array_exception)
+#endif
+        {
+          if (!exception_thrown)
+          {
+            exception_thrown = true;
+            exception_message = error.what();
+          }
+        }
+      }
+    }
 
-          // Add to the bin number
-          bin_number += multiplier * bin_number_i;
+    if (exception_thrown)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Exception thrown while filling the bin array:\n"
+                   << exception_message;
+      throw OomphLibError(error_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
 
-          // Sort out the multiplier
-          multiplier *= Dimensions_of_bin_array[i];
+    // Now sort the sample points into the compact storage (by counting
+    // the number of sample points in each bin first). This retains the
+    // order of the sample points within each bin.
+    First_sample_point_in_bin.resize(ntotalbin + 1, 0);
+    for (unsigned k = 0; k < n_sample_point; k++)
+    {
+      First_sample_point_in_bin[bin_of_sample_point[k] + 1]++;
+    }
+    for (unsigned b = 0; b < ntotalbin; b++)
+    {
+      First_sample_point_in_bin[b + 1] += First_sample_point_in_bin[b];
+    }
+    Sample_point_element_index.resize(n_sample_point);
+    Sample_point_local_coord.resize(n_sample_point * n_lagrangian);
+    Vector<unsigned> next_sample_point_in_bin(First_sample_point_in_bin);
+    for (unsigned e = 0; e < n_sub; e++)
+    {
+      for (unsigned k = first_sample_point_in_element[e];
+           k < first_sample_point_in_element[e + 1];
+           k++)
+      {
+        unsigned k_new = next_sample_point_in_bin[bin_of_sample_point[k]]++;
+        Sample_point_element_index[k_new] = e;
+        for (unsigned i = 0; i < n_lagrangian; i++)
+        {
+          Sample_point_local_coord[k_new * n_lagrangian + i] =
+            local_coord_of_sample_point[k * n_lagrangian + i];
         }
+      }
+    }
+  }
+
 
-        // Add element-sample local coord pair to the calculated bin
-        tmp_bin_object_coord_pairs[bin_number].push_back(
-          std::make_pair(el_pt, local_coord));
+  //========================================================================
+  /// Get the contents of all (non-empty) bins in vector
+  //========================================================================
+  Vector<Vector<std::pair<FiniteElement*, Vector<double>>>>
+  NonRefineableBinArray::bin_content() const
+  {
+    const unsigned n_lagrangian = this->ndim_zeta();
+    Vector<Vector<std::pair<FiniteElement*, Vector<double>>>> all_vals;
+    unsigned n_bin = First_sample_point_in_bin.size();
+    if (n_bin != 0)
+    {
+      n_bin--;
+    }
+    for (unsigned b = 0; b < n_bin; b++)
+    {
+      unsigned n_entry = nsample_point_in_bin(b);
+      if (n_entry != 0)
+      {
+        Vector<std::pair<FiniteElement*, Vector<double>>> vals(n_entry);
+        for (unsigned j = 0; j < n_entry; j++)
+        {
+          unsigned k = First_sample_point_in_bin[b] + j;
+          vals[j].first =
+            Mesh_pt->finite_element_pt(Sample_point_element_index[k]);
+          vals[j].second.resize(n_lagrangian);
+          for (unsigned i = 0; i < n_lagrangian; i++)
+          {
+            vals[j].second[i] = Sample_point_local_coord[k * n_lagrangian + i];
+          }
+        }
+        all_vals.push_back(vals);
       }
     }
+    return all_vals;
+  }
 
-    // Finally copy filled vectors across -- wiping memory from temporary
-    // map as we go along is good and wouldn't be possible if we
-    // filled the SparseVector's internal map within that class.
-    typedef std::map<
-      unsigned,
-      Vector<std::pair<FiniteElement*, Vector<double>>>>::iterator IT;
-    for (IT it = tmp_bin_object_coord_pairs.begin();
-         it != tmp_bin_object_coord_pairs.end();
-         it++)
+
+  //========================================================================
+  /// Get the contents of all (non-empty) bins in a map, keyed by the
+  /// bin number
+  //========================================================================
+  const std::map<unsigned, Vector<std::pair<FiniteElement*, Vector<double>>>>*
+  NonRefineableBinArray::get_all_bins_content() const
+  {
+    const unsigned n_lagrangian = this->ndim_zeta();
+    Bin_content.clear();
+    unsigned n_bin = First_sample_point_in_bin.size();
+    if (n_bin != 0)
+    {
+      n_bin--;
+    }
+    for (unsigned b = 0; b < n_bin; b++)
     {
-      Bin_object_coord_pairs.set_value((*it).first, (*it).second);
-      // Make space immediately
-      (*it).second.clear();
+      unsigned n_entry = nsample_point_in_bin(b);
+      if (n_entry != 0)
+      {
+        Vector<std::pair<FiniteElement*, Vector<double>>>& vals =
+          Bin_content[b];
+        vals.resize(n_entry);
+        for (unsigned j = 0; j < n_entry; j++)
+        {
+          unsigned k = First_sample_point_in_bin[b] + j;
+          vals[j].first =
+            Mesh_pt->finite_element_pt(Sample_point_element_index[k]);
+          vals[j].second.resize(n_lagrangian);
+          for (unsigned i = 0; i < n_lagrangian; i++)
+          {
+            vals[j].second[i] = Sample_point_local_coord[k * n_lagrangian + i];
+          }
+        }
+      }
     }
+    return &Bin_content;
   }
 
 
@@ -2634,24 +2899,22 @@ namespace oomph
   {
     // Total number of bins
     n_bin = nbin();
-    n_empty = n_bin - Bin_object_coord_pairs.nnz();
-
-    // Get pointer to map-based representation
-    const std::map<unsigned, Vector<std::pair<FiniteElement*, Vector<double>>>>*
-      map_pt = Bin_object_coord_pairs.map_pt();
+    n_empty = 0;
 
     // Initialise
     max_n_entry = 0;
     min_n_entry = UINT_MAX;
     tot_n_entry = 0;
 
-    // Do stats
-    typedef std::map<
-      unsigned,
-      Vector<std::pair<FiniteElement*, Vector<double>>>>::const_iterator IT;
-    for (IT it = map_pt->begin(); it != map_pt->end(); it++)
+    // Do stats (on the non-empty bins)
+    for (unsigned b = 0; b < n_bin; b++)
     {
-      unsigned nentry = (*it).second.size();
+      unsigned nentry = nsample_point_in_bin(b);
+      if (nentry == 0)
+      {
+        n_empty++;
+        continue;
+      }
       if (nentry > max_n_entry) max_n_entry = nentry;
       if (nentry < min_n_entry) min_n_entry = nentry;
       tot_n_entry += nentry;
@@ -2670,22 +2933,32 @@ namespace oomph
     // oomph_info << "PROFILING GET_NEIGHBOURING_BINS_HELPER():" << std::endl;
     // profile_get_neighbouring_bins_helper();
 
+    const unsigned n_lagrangian = this->ndim_zeta();
+
     // Loop over all bins to check if they're empty
     std::list<unsigned> empty_bins;
     unsigned n_bin = nbin();
     std::vector<bool> was_empty_until_current_iteration(n_bin, false);
     for (unsigned i = 0; i < n_bin; i++)
     {
-      if (Bin_object_coord_pairs[i].size() == 0)
+      if (nsample_point_in_bin(i) == 0)
       {
         empty_bins.push_front(i);
         was_empty_until_current_iteration[i] = true;
       }
     }
 
+    // The (single) sample point that an empty bin is filled with
+    // (identified by its index in the compact storage); only assembled
+    // into the compact storage once all bins have been filled
+    Vector<int> diffused_sample_point(n_bin, -1);
+    unsigned n_diffused = 0;
+
     // Now keep processing the empty bins until there are none left
     unsigned iter = 0;
     Vector<unsigned> newly_filled_bin;
+    Vector<double> s(n_lagrangian);
+    Vector<double> x;
     while (empty_bins.size() != 0)
     {
       newly_filled_bin.clear();
@@ -2702,9 +2975,9 @@ namespace oomph
         get_neighbouring_bins_helper(bin, level, neighbour_bin);
         unsigned n_neigh = neighbour_bin.size();
 
-        // Find closest pair
+        // Find closest sample point
         double min_dist = DBL_MAX;
-        std::pair<FiniteElement*, Vector<double>> closest_pair;
+        unsigned closest_sample_point = 0;
         for (unsigned i = 0; i < n_neigh; i++)
         {
           unsigned neigh_bin = neighbour_bin[i];
@@ -2713,12 +2986,24 @@ namespace oomph
           // previous iteration, otherwise things can progate too fast
           if (!was_empty_until_current_iteration[neigh_bin])
           {
-            unsigned nbin_content = Bin_object_coord_pairs[neigh_bin].size();
-            for (unsigned j = 0; j < nbin_content; j++)
+            // Sample points in the neighbouring bin (either its own or
+            // the one it's been filled with)
+            unsigned k_first = First_sample_point_in_bin[neigh_bin];
+            unsigned k_last = First_sample_point_in_bin[neigh_bin + 1];
+            if (diffused_sample_point[neigh_bin] >= 0)
+            {
+              k_first = diffused_sample_point[neigh_bin];
+              k_last = k_first + 1;
+            }
+            for (unsigned k = k_first; k < k_last; k++)
             {
-              FiniteElement* el_pt = Bin_object_coord_pairs[neigh_bin][j].first;
-              Vector<double> s(Bin_object_coord_pairs[neigh_bin][j].second);
-              Vector<double> x(2);
+              FiniteElement* el_pt =
+                Mesh_pt->finite_element_pt(Sample_point_element_index[k]);
+              for (unsigned ii = 0; ii < n_lagrangian; ii++)
+              {
+                s[ii] = Sample_point_local_coord[k * n_lagrangian + ii];
+              }
+              x.resize(el_pt->nodal_dimension());
               el_pt->interpolated_x(s, x);
               // Get minimum distance of sample point from any of the vertices
               // of current bin
@@ -2731,7 +3016,7 @@ namespace oomph
               if (dist < min_dist)
               {
                 min_dist = dist;
-                closest_pair = Bin_object_coord_pairs[neigh_bin][j];
+                closest_sample_point = k;
               }
             }
           }
@@ -2740,9 +3025,8 @@ namespace oomph
         // Have we filled the bin?
         if (min_dist != DBL_MAX)
         {
-          Vector<std::pair<FiniteElement*, Vector<double>>> new_entry;
-          new_entry.push_back(closest_pair);
-          Bin_object_coord_pairs.set_value(bin, new_entry);
+          diffused_sample_point[bin] = closest_sample_point;
+          n_diffused++;
 
           // Record that we've filled it.
           newly_filled_bin.push_back(bin);
@@ -2765,13 +3049,50 @@ namespace oomph
       }
     }
 
+    // Now rebuild the compact storage, with the diffused sample points
+    // added to the previously empty bins
+    if (n_diffused > 0)
+    {
+      unsigned n_sample_point = Sample_point_element_index.size();
+      Vector<unsigned> first_sample_point_in_bin(n_bin + 1, 0);
+      Vector<unsigned> sample_point_element_index(n_sample_point + n_diffused);
+      Vector<double> sample_point_local_coord(
+        (n_sample_point + n_diffused) * n_lagrangian);
+      unsigned k_new = 0;
+      for (unsigned b = 0; b < n_bin; b++)
+      {
+        first_sample_point_in_bin[b] = k_new;
+        unsigned k_first = First_sample_point_in_bin[b];
+        unsigned k_last = First_sample_point_in_bin[b + 1];
+        if (diffused_sample_point[b] >= 0)
+        {
+          k_first = diffused_sample_point[b];
+          k_last = k_first + 1;
+        }
+        for (unsigned k = k_first; k < k_last; k++)
+        {
+          sample_point_element_index[k_new] = Sample_point_element_index[k];
+          for (unsigned i = 0; i < n_lagrangian; i++)
+          {
+            sample_point_local_coord[k_new * n_lagrangian + i] =
+              Sample_point_local_coord[k * n_lagrangian + i];
+          }
+          k_new++;
+        }
+      }
+      first_sample_point_in_bin[n_bin] = k_new;
+      First_sample_point_in_bin = first_sample_point_in_bin;
+      Sample_point_element_index = sample_point_element_index;
+      Sample_point_local_coord = sample_point_local_coord;
+    }
+
 
 #ifdef PARANOID
     // Loop over all bins to check if they're empty
     n_bin = nbin();
     for (unsigned i = 0; i < n_bin; i++)
     {
-      if (Bin_object_coord_pairs[i].size() == 0)
+      if (nsample_point_in_bin(i) == 0)
       {
         std::ostringstream error_message_stream;
         error_message_stream << "Bin " << i << " is still empty\n"
@@ -3093,7 +3414,7 @@ namespace oomph
     // starting from the beginning
     if (current_min_spiral_level() == 0)
     {
-      Total_number_of_sample_points_visited_during_locate_zeta_from_top_level =
+      total_number_of_sample_points_visited_during_locate_zeta_from_top_level() =
         0;
     }
 
@@ -3238,20 +3559,25 @@ namespace oomph
         if (do_it)
         {
           // Get the number of element-sample point pairs in this bin
-          unsigned n_sample =
-            Bin_object_coord_pairs[neighbour_bin[i_nbr]].size();
+          unsigned n_sample = nsample_point_in_bin(neighbour_bin[i_nbr]);
 
           // Don't do anything if this bin has no sample points
           if (n_sample > 0)
           {
+            unsigned k_first = First_sample_point_in_bin[neighbour_bin[i_nbr]];
             for (unsigned i_sam = 0; i_sam < n_sample; i_sam++)
             {
               // Get the element
-              FiniteElement* el_pt =
-                Bin_object_coord_pairs[neighbour_bin[i_nbr]][i_sam].first;
+              unsigned k = k_first + i_sam;
+              unsigned e = Sample_point_element_index[k];
+              FiniteElement* el_pt = Mesh_pt->finite_element_pt(e);
 
               // Get the local coordinate
-              s = Bin_object_coord_pairs[neighbour_bin[i_nbr]][i_sam].second;
+              s.resize(n_lagrangian);
+              for (unsigned i = 0; i < n_lagrangian; i++)
+              {
+                s[i] = Sample_point_local_coord[k * n_lagrangian + i];
+              }
 
               // History of sample points visited
               if (BinArray::Visited_sample_points_file.is_open())
@@ -3279,15 +3605,20 @@ namespace oomph
                   << " " << sqrt(dist) << std::endl;
               }
 
-              // Use this coordinate as the initial guess
-              bool use_coordinate_as_initial_guess = true;
+              // Only bother with the Newton iteration if the element
+              // can contain the point
+              if (element_bounding_box_contains_zeta(e, zeta))
+              {
+                // Use this coordinate as the initial guess
+                bool use_coordinate_as_initial_guess = true;
 
-              // Attempt to find zeta within a sub-object
-              el_pt->locate_zeta(
-                zeta, sub_geom_object_pt, s, use_coordinate_as_initial_guess);
+                // Attempt to find zeta within a sub-object
+                el_pt->locate_zeta(
+                  zeta, sub_geom_object_pt, s, use_coordinate_as_initial_guess);
+              }
 
 
-              Total_number_of_sample_points_visited_during_locate_zeta_from_top_level++;
+              total_number_of_sample_points_visited_during_locate_zeta_from_top_level()++;
 
               // Always fail? (Used for debugging, e.g. to trace out
               // spiral path)
@@ -3464,7 +3795,8 @@ namespace oomph
     }
 
     // Initialise
-    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level = 0;
+    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level
+      .assign(1, 0);
     First_sample_point_to_actually_lookup_during_locate_zeta = 0;
     Last_sample_point_to_actually_lookup_during_locate_zeta = UINT_MAX;
     Multiplier_for_max_sample_point_to_actually_lookup_during_locate_zeta =
@@ -3613,7 +3945,7 @@ namespace oomph
       // Reset counter for number of sample points visited.
       // If we can't find the point we should at least make sure that
       // we've visited all the sample points before giving up.
-      Total_number_of_sample_points_visited_during_locate_zeta_from_top_level =
+      total_number_of_sample_points_visited_during_locate_zeta_from_top_level() =
         0;
     }
 
@@ -3825,7 +4157,7 @@ namespace oomph
     Vector<double>& s)
   {
     // Reset counter for number of sample points visited.
-    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level = 0;
+    total_number_of_sample_points_visited_during_locate_zeta_from_top_level() = 0;
 
     // Initialise return to null -- if it's still null when we're
     // leaving we've failed!
@@ -235,7 +235,8 @@ public:
 #endif
       Nsample_points_generated_per_element(
         nsample_points_generated_per_element),
-      Total_number_of_sample_points_visited_during_locate_zeta_from_top_level(0)
+      Total_number_of_sample_points_visited_during_locate_zeta_from_top_level(
+        1, 0)
   {
     // Don't limit max. search radius
     Max_search_radius = DBL_MAX;
@@ -275,11 +276,22 @@ public:
 
 
   /// \short Counter to keep track of how many sample points we've
-  /// visited during top level call to locate_zeta. Virtual so it can be
-  /// overloaded for different versions.
+  /// visited during top level call to locate_zeta (by the calling
+  /// thread). Virtual so it can be overloaded for different versions.
   virtual unsigned& total_number_of_sample_points_visited_during_locate_zeta_from_top_level()
   {
-    return Total_number_of_sample_points_visited_during_locate_zeta_from_top_level;
+    return Total_number_of_sample_points_visited_during_locate_zeta_from_top_level
+      [ThreadingHelpers::thread_id()];
+  }
+
+  /// \short Provide storage for the counters of the sample points
+  /// visited, so that locate_zeta(...) can be called concurrently by
+  /// (at most) the specified number of threads. Must be called
+  /// outside any parallel region.
+  void setup_counters_for_threaded_locate_zeta(const unsigned& n_thread)
+  {
+    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level
+      .resize(std::max(n_thread, unsigned(1)), 0);
   }
 
   /// \short Total number of sample points in sample point container, possibly
@@ -287,6 +299,29 @@ public:
   virtual unsigned total_number_of_sample_points_computed_recursively()
     const = 0;
 
+  /// \short Can the e-th element in the mesh contain the point with
+  /// intrinsic coordinate zeta, i.e. is zeta inside the element's
+  /// (inflated) bounding box? Always true if the bounding boxes haven't
+  /// been set up (see Use_element_bounding_box_prefilter).
+  bool element_bounding_box_contains_zeta(const unsigned& e,
+                                          const Vector<double>& zeta) const
+  {
+    if (Element_bounding_box.size() == 0)
+    {
+      return true;
+    }
+    unsigned n_dim = zeta.size();
+    for (unsigned i = 0; i < n_dim; i++)
+    {
+      if ((zeta[i] < Element_bounding_box[2 * (e * n_dim + i)]) ||
+          (zeta[i] > Element_bounding_box[2 * (e * n_dim + i) + 1]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
   /// Dimension of the zeta ( =  dim of local coordinate of elements)
   virtual unsigned ndim_zeta() const = 0;
 
@@ -367,11 +402,27 @@ public:
   /// Offset of sample point container boundaries beyond max/min coords
   static double Percentage_offset;
 
+  /// \short Boolean flag to indicate that the (comparatively costly)
+  /// Newton-based FiniteElement::locate_zeta(...) is only to be called
+  /// for elements whose bounding box contains the point to be located.
+  static bool Use_element_bounding_box_prefilter;
+
+  /// \short Amount by which the elements' bounding boxes are increased
+  /// in each direction (relative to their largest extent) to allow for
+  /// curved element boundaries and for the tolerance in
+  /// FiniteElement::locate_zeta(...)
+  static double Relative_tolerance_for_element_bounding_box;
+
 protected:
   /// \short Helper function to compute the min and max coordinates for the
   /// mesh, in each dimension
   void setup_min_and_max_coordinates();
 
+  /// \short Helper function to compute the (inflated) bounding boxes of the
+  /// elements in the mesh, in terms of their intrinsic coordinates
+  /// (which are used by FiniteElement::locate_zeta(...))
+  void setup_element_bounding_boxes();
+
   /// Pointer to mesh from whose FiniteElements sample points are created
   Mesh* Mesh_pt;
 
@@ -395,9 +446,9 @@ protected:
   /// "Measure of" number of sample points generated in each element
   unsigned Nsample_points_generated_per_element;
 
-  /// \short Counter to keep track of how many sample points we've
-  /// visited during top level call to locate_zeta
-  unsigned
+  /// \short Counters (one per thread) to keep track of how many sample
+  /// points we've visited during top level call to locate_zeta
+  Vector<unsigned>
     Total_number_of_sample_points_visited_during_locate_zeta_from_top_level;
 
   /// \short Max radius beyond which we stop searching the bin. Initialised
@@ -406,6 +457,12 @@ protected:
   /// in bins whose closest vertex is at a distance greater than
   /// Max_search_radius from the point to be located.
   double Max_search_radius;
+
+  /// \short Bounding boxes of the elements in the mesh (only set up if
+  /// Use_element_bounding_box_prefilter is true): The min/max i-th
+  /// intrinsic coordinate of the e-th element are stored in entries
+  /// 2*(e*ndim_zeta()+i) and 2*(e*ndim_zeta()+i)+1.
+  Vector<double> Element_bounding_box;
 };
 
 
@@ -728,7 +785,8 @@ public:
   {
     if (Depth == 0)
     {
-      return Total_number_of_sample_points_visited_during_locate_zeta_from_top_level;
+      return SamplePointContainer::
+        total_number_of_sample_points_visited_during_locate_zeta_from_top_level();
     }
     else
     {
@@ -963,20 +1021,21 @@ public:
     int& bin_number,
     Vector<std::pair<FiniteElement*, Vector<double>>>& sample_point_pairs);
 
-  /// Get the contents of all bins in vector
-  Vector<Vector<std::pair<FiniteElement*, Vector<double>>>> bin_content() const
-  {
-    Vector<Vector<std::pair<FiniteElement*, Vector<double>>>> all_vals;
-    Bin_object_coord_pairs.get_all_values(all_vals);
-    return all_vals;
-  }
+  /// Get the contents of all (non-empty) bins in vector
+  Vector<Vector<std::pair<FiniteElement*, Vector<double>>>> bin_content() const;
 
-  /// Get the contents of all bins in vector
+  /// \short Get the contents of all (non-empty) bins in a map, keyed by the
+  /// bin number. The map is assembled from the compact storage of the
+  /// sample points when this function is called and remains valid until
+  /// it's called again (or the bins are refilled).
   const std::map<unsigned, Vector<std::pair<FiniteElement*, Vector<double>>>>* get_all_bins_content()
-    const
+    const;
+
+  /// Number of sample points in the i_bin-th bin
+  unsigned nsample_point_in_bin(const unsigned& i_bin) const
   {
-    // Return the content of the bins
-    return Bin_object_coord_pairs.map_pt();
+    return First_sample_point_in_bin[i_bin + 1] -
+           First_sample_point_in_bin[i_bin];
   }
 
   /// \short Fill bin by diffusion, populating each empty bin with the
@@ -1040,13 +1099,34 @@ private:
   /// for total number of bins in active use by any MeshAsGeomObject)
   void flush_bins_of_objects()
   {
-    Total_nbin_cells_counter -= Bin_object_coord_pairs.nnz();
-    Bin_object_coord_pairs.clear();
-  }
-
-  /// Storage for paired objects and coords in each bin
-  SparseVector<Vector<std::pair<FiniteElement*, Vector<double>>>>
-    Bin_object_coord_pairs;
+    if (First_sample_point_in_bin.size() != 0)
+    {
+      Total_nbin_cells_counter -= First_sample_point_in_bin.size() - 1;
+    }
+    First_sample_point_in_bin.clear();
+    Sample_point_element_index.clear();
+    Sample_point_local_coord.clear();
+    Bin_content.clear();
+  }
+
+  /// \short Compact (CSR-style) storage of the sample points in the bins:
+  /// The sample points in the i_bin-th bin are the ones with (flat-packed)
+  /// indices First_sample_point_in_bin[i_bin], ...,
+  /// First_sample_point_in_bin[i_bin+1]-1.
+  Vector<unsigned> First_sample_point_in_bin;
+
+  /// \short Index (in the mesh) of the element that contains the sample
+  /// point, for all sample points (ordered by bin)
+  Vector<unsigned> Sample_point_element_index;
+
+  /// \short Local coordinates of the sample points within their elements
+  /// (flat-packed; ndim_zeta() entries per sample point)
+  Vector<double> Sample_point_local_coord;
+
+  /// \short Map-based representation of the bins' contents, assembled on
+  /// demand by get_all_bins_content()
+  mutable std::map<unsigned, Vector<std::pair<FiniteElement*, Vector<double>>>>
+    Bin_content;
 
   /// \short Max. spiralling level (for efficiency; effect similar to
   /// max_search_radius)
@@ -129,6 +129,15 @@ namespace oomph
       Psi = Allocated_storage;
     }
 
+    /// \short Constructor for a two-index set of shape functions that
+    /// uses the (external) storage addressed by storage_pt, e.g. a
+    /// fixed-size array on the stack, rather than allocating its own.
+    /// The storage must have at least N*M entries and outlive the object.
+    Shape(double* const& storage_pt, const unsigned& N, const unsigned& M = 1)
+      : Psi(storage_pt), Allocated_storage(0), Index1(N), Index2(M)
+    {
+    }
+
     /// Broken copy constructor
     Shape(const Shape& shape)
     {
@@ -347,6 +356,15 @@ namespace oomph
       DPsi = Allocated_storage;
     }
 
+    /// \short Constructor for a single-index shape function that uses the
+    /// (external) storage addressed by storage_pt, e.g. a fixed-size
+    /// array on the stack, rather than allocating its own. The storage
+    /// must have at least N*P entries and outlive the object.
+    DShape(double* const& storage_pt, const unsigned& N, const unsigned& P)
+      : DPsi(storage_pt), Allocated_storage(0), Index1(N), Index2(1), Index3(P)
+    {
+    }
+
     /// Default constructor - just assigns a null pointers and zero index
     /// sizes.
     DShape() : DPsi(0), Allocated_storage(0), Index1(0), Index2(0), Index3(0) {}
@@ -26,6 +26,7 @@
 #include "mesh.h"
 #include "Telements.h"
 #include "tetgen_scaffold_mesh.h"
+#include "mapped_text_file.h"
 
 namespace oomph
 {
@@ -38,11 +39,13 @@ namespace oomph
   //======================================================================
   TetgenScaffoldMesh::TetgenScaffoldMesh(const std::string& node_file_name,
                                          const std::string& element_file_name,
-                                         const std::string& face_file_name)
+                                         const std::string& face_file_name,
+                                         const bool& topology_only)
+    : Topology_only(topology_only)
   {
     // Process the element file
     // --------------------------
-    std::ifstream element_file(element_file_name.c_str(), std::ios_base::in);
+    MappedTextFile element_file(element_file_name);
 
     // Check that the file actually opened correctly
 #ifdef PARANOID
@@ -57,12 +60,10 @@ namespace oomph
 
 
     // Read in number of elements
-    unsigned n_element;
-    element_file >> n_element;
+    unsigned n_element = element_file.read_unsigned();
 
     // Read in number of nodes per element
-    unsigned n_local_node;
-    element_file >> n_local_node;
+    unsigned n_local_node = element_file.read_unsigned();
 
     // Throw an error if we have anything but linear simplices
     if (n_local_node != 4)
@@ -77,61 +78,70 @@ namespace oomph
         error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
     }
 
-    // Dummy nodal attributes
-    unsigned dummy_attribute;
-
     // Element attributes may be used to distinguish internal regions
     // NOTE: This stores doubles because tetgen forces us to!
     Element_attribute.resize(n_element, 0.0);
 
-    // Dummy storage for element numbers
-    unsigned dummy_element_number;
-
     // Resize storage for the global node numbers listed element-by-element
     Global_node.resize(n_element * n_local_node);
 
-    // Initialise (global) node counter
-    unsigned k = 0;
     // Are there attributes?
-    unsigned attribute_flag;
-    element_file >> attribute_flag;
-
-    // If no attributes
-    if (attribute_flag == 0)
+    unsigned attribute_flag = element_file.read_unsigned();
+
+    // Locate the element records (one per line); they can then be parsed
+    // independently of each other
+    Vector<const char*> record_pt;
+    element_file.get_record_lines(n_element, record_pt);
+    const char* element_file_end_pt = element_file.end_pt();
+    long n_element_long = n_element;
+    bool parse_error = false;
+#ifdef _OPENMP
+    bool use_threads = ThreadingHelpers::use_threads(n_element);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long i = 0; i < n_element_long; i++)
     {
-      // Read in global node numbers
-      for (unsigned i = 0; i < n_element; i++)
+      // Exceptions mustn't escape from the parallel region
+      try
       {
-        element_file >> dummy_element_number;
+        const char* pt = record_pt[i];
+
+        // Skip the element number
+        MappedTextFile::parse_unsigned(pt, element_file_end_pt);
+
+        // Read in global node numbers
         for (unsigned j = 0; j < n_local_node; j++)
         {
-          element_file >> Global_node[k];
-          k++;
+          Global_node[i * n_local_node + j] =
+            MappedTextFile::parse_unsigned(pt, element_file_end_pt);
         }
-      }
-    }
-    // Otherwise read in the attributes as well
-    else
-    {
-      for (unsigned i = 0; i < n_element; i++)
-      {
-        element_file >> dummy_element_number;
-        for (unsigned j = 0; j < n_local_node; j++)
+
+        // Read in the (first) attribute
+        if (attribute_flag != 0)
         {
-          element_file >> Global_node[k];
-          k++;
+          Element_attribute[i] =
+            MappedTextFile::parse_double(pt, element_file_end_pt);
         }
-        element_file >> Element_attribute[i];
+      }
+      catch (OomphLibError&)
+      {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        parse_error = true;
       }
     }
-    element_file.close();
-
-    // Resize the Element vector
-    Element_pt.resize(n_element);
+    if (parse_error)
+    {
+      std::string error_msg("Failed to parse element file: ");
+      error_msg += "\"" + element_file_name + "\".";
+      throw OomphLibError(
+        error_msg, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
 
     // Process node file
     //--------------------
-    std::ifstream node_file(node_file_name.c_str(), std::ios_base::in);
+    MappedTextFile node_file(node_file_name);
 
     // Check that the file actually opened correctly
 #ifdef PARANOID
@@ -146,105 +156,85 @@ namespace oomph
 
 
     // Read in the number of nodes
-    unsigned n_node;
-    node_file >> n_node;
-
-    // Create a vector of boolean so as not to create the same node twice
-    std::vector<bool> done(n_node, false);
-
-    // Resize the Node vector
-    Node_pt.resize(n_node);
+    unsigned n_node = node_file.read_unsigned();
 
     // Set the spatial dimension of the nodes
-    unsigned dimension;
-    node_file >> dimension;
-
 #ifdef PARANOID
+    unsigned dimension = node_file.read_unsigned();
     if (dimension != 3)
     {
       throw OomphLibError("The dimesion of the nodes must be 3\n",
                           OOMPH_CURRENT_FUNCTION,
                           OOMPH_EXCEPTION_LOCATION);
     }
+#else
+    node_file.read_unsigned();
 #endif
 
-    // Flag for attributes
-    node_file >> attribute_flag;
+    // Number of attributes
+    attribute_flag = node_file.read_unsigned();
 
     // Flag for boundary markers
-    unsigned boundary_markers_flag;
-    node_file >> boundary_markers_flag;
-
-    // Dummy storage for the node number
-    unsigned dummy_node_number;
+    unsigned boundary_markers_flag = node_file.read_unsigned();
 
     // Create storage for nodal positions and boundary markers
     Vector<double> x_node(n_node);
     Vector<double> y_node(n_node);
     Vector<double> z_node(n_node);
-    Vector<unsigned> bound(n_node);
-
-    // Check if there are attributes
-    // If not
-    if (attribute_flag == 0)
+    Vector<unsigned> bound(n_node, 0);
+
+    // Locate and parse the node records (which are independent of each
+    // other)
+    node_file.get_record_lines(n_node, record_pt);
+    const char* node_file_end_pt = node_file.end_pt();
+    long n_node_long = n_node;
+#ifdef _OPENMP
+    use_threads = ThreadingHelpers::use_threads(n_node);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long i = 0; i < n_node_long; i++)
     {
-      // Are there boundary markers
-      if (boundary_markers_flag == 1)
+      // Exceptions mustn't escape from the parallel region
+      try
       {
-        for (unsigned i = 0; i < n_node; i++)
-        {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> z_node[i];
-          node_file >> bound[i];
-        }
-        node_file.close();
-      }
-      // Otherwise no boundary markers
-      else
-      {
-        for (unsigned i = 0; i < n_node; i++)
+        const char* pt = record_pt[i];
+
+        // Skip the node number
+        MappedTextFile::parse_unsigned(pt, node_file_end_pt);
+
+        // Coordinates
+        x_node[i] = MappedTextFile::parse_double(pt, node_file_end_pt);
+        y_node[i] = MappedTextFile::parse_double(pt, node_file_end_pt);
+        z_node[i] = MappedTextFile::parse_double(pt, node_file_end_pt);
+
+        // Skip the attributes
+        for (unsigned j = 0; j < attribute_flag; j++)
         {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> z_node[i];
-          bound[i] = 0;
+          MappedTextFile::parse_double(pt, node_file_end_pt);
         }
-        node_file.close();
-      }
-    }
-    // Otherwise there are attributes
-    else
-    {
-      if (boundary_markers_flag == 1)
-      {
-        for (unsigned i = 0; i < n_node; i++)
+
+        // Boundary marker
+        if (boundary_markers_flag == 1)
         {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> z_node[i];
-          node_file >> dummy_attribute;
-          node_file >> bound[i];
+          bound[i] = MappedTextFile::parse_unsigned(pt, node_file_end_pt);
         }
-        node_file.close();
       }
-      else
+      catch (OomphLibError&)
       {
-        for (unsigned i = 0; i < n_node; i++)
-        {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> z_node[i];
-          node_file >> dummy_attribute;
-          bound[i] = 0;
-        }
-        node_file.close();
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        parse_error = true;
       }
     }
+    if (parse_error)
+    {
+      std::string error_msg("Failed to parse node file: ");
+      error_msg += "\"" + node_file_name + "\".";
+      throw OomphLibError(
+        error_msg, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    record_pt.clear();
 
     // Determine highest boundary index
     //------------------------------------
@@ -265,7 +255,7 @@ namespace oomph
     //--------------------------------------------
 
     // Open face file
-    std::ifstream face_file(face_file_name.c_str(), std::ios_base::in);
+    MappedTextFile face_file(face_file_name);
 
     // Check that the file actually opened correctly
 #ifdef PARANOID
@@ -279,11 +269,10 @@ namespace oomph
 #endif
 
     // Number of faces in face file
-    unsigned n_face;
-    face_file >> n_face;
+    unsigned n_face = face_file.read_unsigned();
 
     // Boundary markers flag
-    face_file >> boundary_markers_flag;
+    boundary_markers_flag = face_file.read_unsigned();
 
     // Storage for the global node numbers (in the tetgen 1-based
     // numbering scheme!) of the first, second and third  node in
@@ -295,9 +284,6 @@ namespace oomph
     // Storage for the boundary marker for each face
     Vector<unsigned> face_boundary(n_face);
 
-    // Dummy for global face number
-    unsigned dummy_face_number;
-
     // Storage for the (boundary) faces associated with each node.
     // Nodes are indexed using Tetgen's 1-based scheme, which is why
     // there is a +1 here
@@ -306,11 +292,12 @@ namespace oomph
     // Extract information for each segment
     for (unsigned i = 0; i < n_face; i++)
     {
-      face_file >> dummy_face_number;
-      face_file >> first_node[i];
-      face_file >> second_node[i];
-      face_file >> third_node[i];
-      face_file >> face_boundary[i];
+      // Skip the face number
+      face_file.read_unsigned();
+      first_node[i] = face_file.read_unsigned();
+      second_node[i] = face_file.read_unsigned();
+      third_node[i] = face_file.read_unsigned();
+      face_boundary[i] = face_file.read_unsigned();
       if (face_boundary[i] > n_bound)
       {
         n_bound = face_boundary[i];
@@ -320,7 +307,6 @@ namespace oomph
       node_on_faces[second_node[i]].insert(i);
       node_on_faces[third_node[i]].insert(i);
     }
-    face_file.close();
 
     // Set number of boundaries
     if (n_bound > 0)
@@ -328,92 +314,17 @@ namespace oomph
       this->set_nboundary(n_bound);
     }
 
-    // Create the elements
-    unsigned counter = 0;
-    for (unsigned e = 0; e < n_element; e++)
-    {
-      Element_pt[e] = new TElement<3, 2>;
-      unsigned global_node_number = Global_node[counter];
-      if (done[global_node_number - 1] == false)
-      // ... -1 because node number begins at 1 in tetgen
-      {
-        // If the node is on a boundary, construct a boundary node
-        if ((boundary_markers_flag == 1) && (bound[global_node_number - 1] > 0))
-        {
-          // Construct the boundary ndoe
-          Node_pt[global_node_number - 1] =
-            finite_element_pt(e)->construct_boundary_node(3);
-
-          // Add to the boundary lookup scheme
-          add_boundary_node(bound[global_node_number - 1] - 1,
-                            Node_pt[global_node_number - 1]);
-        }
-        // Otherwise just construct a normal node
-        else
-        {
-          Node_pt[global_node_number - 1] =
-            finite_element_pt(e)->construct_node(3);
-        }
-
-        done[global_node_number - 1] = true;
-        Node_pt[global_node_number - 1]->x(0) = x_node[global_node_number - 1];
-        Node_pt[global_node_number - 1]->x(1) = y_node[global_node_number - 1];
-        Node_pt[global_node_number - 1]->x(2) = z_node[global_node_number - 1];
-      }
-      // Otherwise just copy the node numbr accross
-      else
-      {
-        finite_element_pt(e)->node_pt(3) = Node_pt[global_node_number - 1];
-      }
-      counter++;
-
-      // Loop over the other nodes
-      for (unsigned j = 0; j < (n_local_node - 1); j++)
-      {
-        global_node_number = Global_node[counter];
-        if (done[global_node_number - 1] == false)
-        // ... -1 because node number begins at 1 in tetgen
-        {
-          // If we're on a boundary
-          if ((boundary_markers_flag == 1) &&
-              (bound[global_node_number - 1] > 0))
-          {
-            // Construct the boundary ndoe
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_boundary_node(j);
-
-            // Add to the boundary lookup scheme
-            add_boundary_node(bound[global_node_number - 1] - 1,
-                              Node_pt[global_node_number - 1]);
-          }
-          else
-          {
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_node(j);
-          }
-          done[global_node_number - 1] = true;
-          Node_pt[global_node_number - 1]->x(0) =
-            x_node[global_node_number - 1];
-          Node_pt[global_node_number - 1]->x(1) =
-            y_node[global_node_number - 1];
-          Node_pt[global_node_number - 1]->x(2) =
-            z_node[global_node_number - 1];
-        }
-        // Otherwise copy the pointer over
-        else
-        {
-          finite_element_pt(e)->node_pt(j) = Node_pt[global_node_number - 1];
-        }
-        counter++;
-      }
-    }
+    // Create the vertex nodes (or just record their positions and
+    // boundaries)
+    setup_vertices(x_node, y_node, z_node, bound, boundary_markers_flag);
 
 
     // Resize the "matrix" that stores the boundary id for each
     // face in each element.
-    Face_boundary.resize(n_element);
-    Face_index.resize(n_element);
-    Edge_index.resize(n_element);
+    // (By default each face is NOT on a boundary)
+    Face_boundary.resize(4 * n_element, 0);
+    Face_index.resize(4 * n_element);
+    Edge_index.resize(6 * n_element);
 
 
     // 0-based index scheme used to construct a global lookup for
@@ -440,17 +351,6 @@ namespace oomph
     // Loop over the elements
     for (unsigned e = 0; e < n_element; e++)
     {
-      // Each element has four faces
-      Face_boundary[e].resize(4);
-      Face_index[e].resize(4);
-      // By default each face is NOT on a boundary
-      for (unsigned i = 0; i < 4; i++)
-      {
-        Face_boundary[e][i] = 0;
-      }
-
-      Edge_index[e].resize(6);
-
       // Read out the global node numbers of the nodes from
       // tetgen's 1-based numbering.
       // The offset is to match the offset used above
@@ -526,7 +426,7 @@ namespace oomph
         if (input.size() == 0)
         {
           // Allocate the next global index
-          Face_index[e][i] = Nglobal_face;
+          Face_index[4 * e + i] = Nglobal_face;
           // Associate the new face index with the nodes
           for (unsigned i2 = 0; i2 < 4; ++i2)
           {
@@ -544,11 +444,11 @@ namespace oomph
         {
           const unsigned global_face_index = *input.begin();
           // Set the face index
-          Face_index[e][i] = global_face_index;
+          Face_index[4 * e + i] = global_face_index;
           // Allocate the boundary index, if it's a boundary
           if (global_face_index < n_face)
           {
-            Face_boundary[e][i] = face_boundary[global_face_index];
+            Face_boundary[4 * e + i] = face_boundary[global_face_index];
             // Add the nodes to the boundary look-up scheme in
             // oomph-lib (0-based) index
             for (unsigned i2 = 0; i2 < 4; ++i2)
@@ -556,8 +456,8 @@ namespace oomph
               // Don't add the omitted node
               if (i2 != omitted_node)
               {
-                add_boundary_node(face_boundary[global_face_index] - 1,
-                                  Node_pt[glob_num[i2] - 1]);
+                add_vertex_to_boundary(face_boundary[global_face_index] - 1,
+                                       glob_num[i2] - 1);
               }
             }
           }
@@ -598,7 +498,7 @@ namespace oomph
         if (local_edge_index.size() == 0)
         {
           // Allocate the next global index
-          Edge_index[e][i] = Nglobal_edge;
+          Edge_index[6 * e + i] = Nglobal_edge;
           // Associate the new edge index with the nodes
           node_on_edges[first_global_num].insert(Nglobal_edge);
           node_on_edges[second_global_num].insert(Nglobal_edge);
@@ -609,7 +509,7 @@ namespace oomph
         else if (local_edge_index.size() == 1)
         {
           // Set the edge index from the result of the intersection
-          Edge_index[e][i] = local_edge_index[0];
+          Edge_index[6 * e + i] = local_edge_index[0];
         }
       }
 
@@ -720,7 +620,9 @@ namespace oomph
   /// that BoundaryNodes are constructed. Any additional boundaries are
   /// determined from the face boundary information.
   //======================================================================
-  TetgenScaffoldMesh::TetgenScaffoldMesh(tetgenio& tetgen_data)
+  TetgenScaffoldMesh::TetgenScaffoldMesh(tetgenio& tetgen_data,
+                                         const bool& topology_only)
+    : Topology_only(topology_only)
   {
     // Find the number of elements
     unsigned n_element = static_cast<unsigned>(tetgen_data.numberoftetrahedra);
@@ -782,18 +684,9 @@ namespace oomph
       }
     }
 
-    // Resize the Element vector
-    Element_pt.resize(n_element);
-
     // Read in the number of nodes
     unsigned n_node = tetgen_data.numberofpoints;
 
-    // Create a vector of boolean so as not to create the same node twice
-    std::vector<bool> done(n_node, false);
-
-    // Resize the Node vector
-    Node_pt.resize(n_node);
-
     // Flag for boundary markers
     unsigned boundary_markers_flag = 0;
     if (tetgen_data.pointmarkerlist != 0)
@@ -921,92 +814,17 @@ namespace oomph
       this->set_nboundary(n_bound);
     }
 
-    // Create the elements
-    unsigned counter = 0;
-    for (unsigned e = 0; e < n_element; e++)
-    {
-      Element_pt[e] = new TElement<3, 2>;
-      unsigned global_node_number = Global_node[counter];
-      if (done[global_node_number - 1] == false)
-      // ... -1 because node number begins at 1 in tetgen
-      {
-        // If the node is on a boundary, construct a boundary node
-        if ((boundary_markers_flag == 1) && (bound[global_node_number - 1] > 0))
-        {
-          // Construct the boundary ndoe
-          Node_pt[global_node_number - 1] =
-            finite_element_pt(e)->construct_boundary_node(3);
-
-          // Add to the boundary lookup scheme
-          add_boundary_node(bound[global_node_number - 1] - 1,
-                            Node_pt[global_node_number - 1]);
-        }
-        // Otherwise just construct a normal node
-        else
-        {
-          Node_pt[global_node_number - 1] =
-            finite_element_pt(e)->construct_node(3);
-        }
-
-        done[global_node_number - 1] = true;
-        Node_pt[global_node_number - 1]->x(0) = x_node[global_node_number - 1];
-        Node_pt[global_node_number - 1]->x(1) = y_node[global_node_number - 1];
-        Node_pt[global_node_number - 1]->x(2) = z_node[global_node_number - 1];
-      }
-      // Otherwise just copy the node numbr accross
-      else
-      {
-        finite_element_pt(e)->node_pt(3) = Node_pt[global_node_number - 1];
-      }
-      counter++;
-
-      // Loop over the other nodes
-      for (unsigned j = 0; j < (n_local_node - 1); j++)
-      {
-        global_node_number = Global_node[counter];
-        if (done[global_node_number - 1] == false)
-        // ... -1 because node number begins at 1 in tetgen
-        {
-          // If we're on a boundary
-          if ((boundary_markers_flag == 1) &&
-              (bound[global_node_number - 1] > 0))
-          {
-            // Construct the boundary ndoe
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_boundary_node(j);
-
-            // Add to the boundary lookup scheme
-            add_boundary_node(bound[global_node_number - 1] - 1,
-                              Node_pt[global_node_number - 1]);
-          }
-          else
-          {
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_node(j);
-          }
-          done[global_node_number - 1] = true;
-          Node_pt[global_node_number - 1]->x(0) =
-            x_node[global_node_number - 1];
-          Node_pt[global_node_number - 1]->x(1) =
-            y_node[global_node_number - 1];
-          Node_pt[global_node_number - 1]->x(2) =
-            z_node[global_node_number - 1];
-        }
-        // Otherwise copy the pointer over
-        else
-        {
-          finite_element_pt(e)->node_pt(j) = Node_pt[global_node_number - 1];
-        }
-        counter++;
-      }
-    }
+    // Create the vertex nodes (or just record their positions and
+    // boundaries)
+    setup_vertices(x_node, y_node, z_node, bound, boundary_markers_flag);
 
 
     // Resize the "matrix" that stores the boundary id for each
     // face in each element.
-    Face_boundary.resize(n_element);
-    Face_index.resize(n_element);
-    Edge_index.resize(n_element);
+    // (By default each face is NOT on a boundary)
+    Face_boundary.resize(4 * n_element, 0);
+    Face_index.resize(4 * n_element);
+    Edge_index.resize(6 * n_element);
 
 
     // 0-based index scheme used to construct a global lookup for
@@ -1033,17 +851,6 @@ namespace oomph
     // Loop over the elements
     for (unsigned e = 0; e < n_element; e++)
     {
-      // Each element has four faces
-      Face_boundary[e].resize(4);
-      Face_index[e].resize(4);
-      // By default each face is NOT on a boundary
-      for (unsigned i = 0; i < 4; i++)
-      {
-        Face_boundary[e][i] = 0;
-      }
-
-      Edge_index[e].resize(6);
-
       // Read out the global node numbers of the nodes from
       // tetgen's 1-based numbering.
       // The offset is to match the offset used above
@@ -1119,7 +926,7 @@ namespace oomph
         if (input.size() == 0)
         {
           // Allocate the next global index
-          Face_index[e][i] = Nglobal_face;
+          Face_index[4 * e + i] = Nglobal_face;
           // Associate the new face index with the nodes
           for (unsigned i2 = 0; i2 < 4; ++i2)
           {
@@ -1137,11 +944,11 @@ namespace oomph
         {
           const unsigned global_face_index = *input.begin();
           // Set the face index
-          Face_index[e][i] = global_face_index;
+          Face_index[4 * e + i] = global_face_index;
           // Allocate the boundary index, if it's a boundary
           if (global_face_index < n_face)
           {
-            Face_boundary[e][i] = face_boundary[global_face_index];
+            Face_boundary[4 * e + i] = face_boundary[global_face_index];
             // Add the nodes to the boundary look-up scheme in
             // oomph-lib (0-based) index
             for (unsigned i2 = 0; i2 < 4; ++i2)
@@ -1149,8 +956,8 @@ namespace oomph
               // Don't add the omitted node
               if (i2 != omitted_node)
               {
-                add_boundary_node(face_boundary[global_face_index] - 1,
-                                  Node_pt[glob_num[i2] - 1]);
+                add_vertex_to_boundary(face_boundary[global_face_index] - 1,
+                                       glob_num[i2] - 1);
               }
             }
           }
@@ -1191,7 +998,7 @@ namespace oomph
         if (local_edge_index.size() == 0)
         {
           // Allocate the next global index
-          Edge_index[e][i] = Nglobal_edge;
+          Edge_index[6 * e + i] = Nglobal_edge;
           // Associate the new edge index with the nodes
           node_on_edges[first_global_num].insert(Nglobal_edge);
           node_on_edges[second_global_num].insert(Nglobal_edge);
@@ -1202,7 +1009,7 @@ namespace oomph
         else if (local_edge_index.size() == 1)
         {
           // Set the edge index from the result of the intersection
-          Edge_index[e][i] = local_edge_index[0];
+          Edge_index[6 * e + i] = local_edge_index[0];
         }
       }
 
@@ -1305,4 +1112,148 @@ namespace oomph
   } // end of constructor
 
 
+  //======================================================================
+  /// \short Create the scaffold's linear tets and their vertex nodes from
+  /// the nodal positions and boundary markers (indexed by the 0-based
+  /// tetgen node number). In topology-only mode no elements or nodes are
+  /// built; we only record the vertex positions and the boundaries
+  /// the vertices are marked on.
+  //======================================================================
+  void TetgenScaffoldMesh::setup_vertices(
+    const Vector<double>& x_node,
+    const Vector<double>& y_node,
+    const Vector<double>& z_node,
+    const Vector<unsigned>& bound,
+    const unsigned& boundary_markers_flag)
+  {
+    unsigned n_node = x_node.size();
+    if (Topology_only)
+    {
+      Vertex_coordinate.resize(3 * n_node);
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        Vertex_coordinate[3 * j] = x_node[j];
+        Vertex_coordinate[3 * j + 1] = y_node[j];
+        Vertex_coordinate[3 * j + 2] = z_node[j];
+        if ((boundary_markers_flag == 1) && (bound[j] > 0))
+        {
+          Vertex_boundaries[j].insert(bound[j] - 1);
+        }
+      }
+      return;
+    }
+
+    // Number of elements and number of nodes per element
+    unsigned n_element = Element_attribute.size();
+    const unsigned n_local_node = 4;
+
+    // Resize the Element vector
+    Element_pt.resize(n_element);
+
+    // Create a vector of boolean so as not to create the same node twice
+    std::vector<bool> done(n_node, false);
+
+    // Resize the Node vector
+    Node_pt.resize(n_node);
+
+    // Create the elements
+    unsigned counter = 0;
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      Element_pt[e] = new TElement<3, 2>;
+      unsigned global_node_number = Global_node[counter];
+      if (done[global_node_number - 1] == false)
+      // ... -1 because node number begins at 1 in tetgen
+      {
+        // If the node is on a boundary, construct a boundary node
+        if ((boundary_markers_flag == 1) && (bound[global_node_number - 1] > 0))
+        {
+          // Construct the boundary ndoe
+          Node_pt[global_node_number - 1] =
+            finite_element_pt(e)->construct_boundary_node(3);
+
+          // Add to the boundary lookup scheme
+          add_boundary_node(bound[global_node_number - 1] - 1,
+                            Node_pt[global_node_number - 1]);
+        }
+        // Otherwise just construct a normal node
+        else
+        {
+          Node_pt[global_node_number - 1] =
+            finite_element_pt(e)->construct_node(3);
+        }
+
+        done[global_node_number - 1] = true;
+        Node_pt[global_node_number - 1]->x(0) = x_node[global_node_number - 1];
+        Node_pt[global_node_number - 1]->x(1) = y_node[global_node_number - 1];
+        Node_pt[global_node_number - 1]->x(2) = z_node[global_node_number - 1];
+      }
+      // Otherwise just copy the node numbr accross
+      else
+      {
+        finite_element_pt(e)->node_pt(3) = Node_pt[global_node_number - 1];
+      }
+      counter++;
+
+      // Loop over the other nodes
+      for (unsigned j = 0; j < (n_local_node - 1); j++)
+      {
+        global_node_number = Global_node[counter];
+        if (done[global_node_number - 1] == false)
+        // ... -1 because node number begins at 1 in tetgen
+        {
+          // If we're on a boundary
+          if ((boundary_markers_flag == 1) &&
+              (bound[global_node_number - 1] > 0))
+          {
+            // Construct the boundary ndoe
+            Node_pt[global_node_number - 1] =
+              finite_element_pt(e)->construct_boundary_node(j);
+
+            // Add to the boundary lookup scheme
+            add_boundary_node(bound[global_node_number - 1] - 1,
+                              Node_pt[global_node_number - 1]);
+          }
+          else
+          {
+            Node_pt[global_node_number - 1] =
+              finite_element_pt(e)->construct_node(j);
+          }
+          done[global_node_number - 1] = true;
+          Node_pt[global_node_number - 1]->x(0) =
+            x_node[global_node_number - 1];
+          Node_pt[global_node_number - 1]->x(1) =
+            y_node[global_node_number - 1];
+          Node_pt[global_node_number - 1]->x(2) =
+            z_node[global_node_number - 1];
+        }
+        // Otherwise copy the pointer over
+        else
+        {
+          finite_element_pt(e)->node_pt(j) = Node_pt[global_node_number - 1];
+        }
+        counter++;
+      }
+    }
+  }
+
+
+  //======================================================================
+  /// \short Add the vertex with 0-based tetgen node number j to
+  /// (0-based) boundary b
+  //======================================================================
+  void TetgenScaffoldMesh::add_vertex_to_boundary(const unsigned& b,
+                                                  const unsigned& j)
+  {
+    if (Topology_only)
+    {
+      Vertex_boundaries[j].insert(b);
+    }
+    else
+    {
+      add_boundary_node(b, Node_pt[j]);
+    }
+  }
+
+
 } // namespace oomph
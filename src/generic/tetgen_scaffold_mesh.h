@@ -43,19 +43,82 @@ namespace oomph
   {
   public:
     /// Empty constructor
-    TetgenScaffoldMesh() {}
-
-    /// \short Constructor: Pass the filename of the tetrahedra file
+    TetgenScaffoldMesh() : Topology_only(false) {}
+
+    /// \short Constructor: Pass the filename of the tetrahedra file.
+    /// If topology_only is true, the scaffold's elements and nodes are
+    /// not built; only the vertex positions and boundaries, and the
+    /// face/edge lookup schemes are set up. This is all that
+    /// TetgenMesh::build_from_scaffold(...) needs, and it avoids holding
+    /// a second copy of the mesh in memory while the final mesh is built.
     TetgenScaffoldMesh(const std::string& node_file_name,
                        const std::string& element_file_name,
-                       const std::string& face_file_name);
+                       const std::string& face_file_name,
+                       const bool& topology_only = false);
 
-    /// \short Constructor using direct tetgenio object
-    TetgenScaffoldMesh(tetgenio& tetgen_data);
+    /// \short Constructor using direct tetgenio object. topology_only
+    /// has the same meaning as in the file-based constructor.
+    TetgenScaffoldMesh(tetgenio& tetgen_data,
+                       const bool& topology_only = false);
 
     /// Empty destructor
     ~TetgenScaffoldMesh() {}
 
+    /// \short Number of linear tets in the scaffold (also valid in
+    /// topology-only mode, where no elements are built)
+    unsigned nscaffold_element() const
+    {
+      return Element_attribute.size();
+    }
+
+    /// \short Has the scaffold been built in topology-only mode, i.e.
+    /// without elements and nodes?
+    bool topology_only() const
+    {
+      return Topology_only;
+    }
+
+    /// \short Number of vertices, i.e. nodes in the tetgen input
+    unsigned nvertex() const
+    {
+      if (Topology_only)
+      {
+        return Vertex_coordinate.size() / 3;
+      }
+      return Node_pt.size();
+    }
+
+    /// \short i-th coordinate of the vertex with (0-based) tetgen node
+    /// number j
+    double vertex_coordinate(const unsigned& j, const unsigned& i) const
+    {
+      if (Topology_only)
+      {
+        return Vertex_coordinate[3 * j + i];
+      }
+      return Node_pt[j]->x(i);
+    }
+
+    /// \short Pointer to the set of (0-based) boundaries that the vertex
+    /// with (0-based) tetgen node number j is on; null if it's not on any
+    /// boundary
+    const std::set<unsigned>* vertex_boundaries_pt(const unsigned& j)
+    {
+      if (Topology_only)
+      {
+        std::map<unsigned, std::set<unsigned>>::const_iterator it =
+          Vertex_boundaries.find(j);
+        if (it == Vertex_boundaries.end())
+        {
+          return 0;
+        }
+        return &(it->second);
+      }
+      std::set<unsigned>* boundaries_pt = 0;
+      Node_pt[j]->get_boundaries_pt(boundaries_pt);
+      return boundaries_pt;
+    }
+
     /// \short Return the global node of each local node
     /// listed element-by-element e*n_local_node + n_local
     /// Note that the node numbers are indexed from 1
@@ -70,7 +133,7 @@ namespace oomph
     /// Will be reduced by one to identify the oomph-lib boundary.
     unsigned face_boundary(const unsigned& e, const unsigned& i) const
     {
-      return Face_boundary[e][i];
+      return Face_boundary[4 * e + i];
     }
 
     /// \short Return the number of internal edges
@@ -90,7 +153,7 @@ namespace oomph
     /// The global index starts from zero
     unsigned edge_index(const unsigned& e, const unsigned& i) const
     {
-      return Edge_index[e][i];
+      return Edge_index[6 * e + i];
     }
 
     /// \short Return the number of internal face
@@ -103,7 +166,7 @@ namespace oomph
     /// The global index starts from zero
     unsigned face_index(const unsigned& e, const unsigned& i) const
     {
-      return Face_index[e][i];
+      return Face_index[4 * e + i];
     }
 
     /// \short Return the attribute of the element e.
@@ -116,6 +179,29 @@ namespace oomph
 
 
   protected:
+    /// \short Create the scaffold's elements and vertex nodes or, in
+    /// topology-only mode, record the vertex positions and boundaries
+    void setup_vertices(const Vector<double>& x_node,
+                        const Vector<double>& y_node,
+                        const Vector<double>& z_node,
+                        const Vector<unsigned>& bound,
+                        const unsigned& boundary_markers_flag);
+
+    /// \short Add the vertex with (0-based) tetgen node number j to
+    /// (0-based) boundary b
+    void add_vertex_to_boundary(const unsigned& b, const unsigned& j);
+
+    /// \short Has the scaffold been built without elements and nodes?
+    bool Topology_only;
+
+    /// \short Vertex coordinates (x,y,z for each vertex in turn); only
+    /// used in topology-only mode
+    Vector<double> Vertex_coordinate;
+
+    /// \short Boundaries of the vertices that are on boundaries, keyed by
+    /// their (0-based) tetgen node number; only used in topology-only mode
+    std::map<unsigned, std::set<unsigned>> Vertex_boundaries;
+
     /// \short Storage for the number of global faces
     unsigned Nglobal_face;
 
@@ -129,17 +215,17 @@ namespace oomph
     /// on a boundary
     std::vector<bool> Edge_boundary;
 
-    /// \short Vector of vectors containing the boundary ids of the
-    /// elements' faces
-    Vector<Vector<unsigned>> Face_boundary;
+    /// \short Boundary ids of the elements' faces, listed
+    /// element-by-element (four per element)
+    Vector<unsigned> Face_boundary;
 
-    /// \short Vector of vectors containing the global edge index of
-    // the elements' edges
-    Vector<Vector<unsigned>> Edge_index;
+    /// \short Global edge indices of the elements' edges, listed
+    /// element-by-element (six per element)
+    Vector<unsigned> Edge_index;
 
-    /// \short Vector of vectors containing the global edge index of
-    // the elements' edges
-    Vector<Vector<unsigned>> Face_index;
+    /// \short Global face indices of the elements' faces, listed
+    /// element-by-element (four per element)
+    Vector<unsigned> Face_index;
 
     /// \short Vector of double attributes for each element.
     /// NOTE: This stores doubles because tetgen forces us to! We only
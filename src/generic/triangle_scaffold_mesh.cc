@@ -24,6 +24,7 @@
 // LIC//
 // LIC//====================================================================
 #include "triangle_scaffold_mesh.h"
+#include "mapped_text_file.h"
 
 
 namespace oomph
@@ -74,6 +75,111 @@ namespace oomph
     }
   }
 
+  //======================================================================
+  /// \short Create the scaffold's linear triangles and their vertex nodes
+  /// from the nodal positions and boundary markers (indexed by the
+  /// 0-based triangle node number). In topology-only mode no elements or
+  /// nodes are built; we only record the vertex positions and the
+  /// boundaries the vertices are marked on.
+  //======================================================================
+  void TriangleScaffoldMesh::setup_vertices(
+    const Vector<double>& x_node,
+    const Vector<double>& y_node,
+    const Vector<unsigned>& bound,
+    const unsigned& boundary_markers_flag)
+  {
+    unsigned n_node = x_node.size();
+    if (Topology_only)
+    {
+      Vertex_coordinate.resize(2 * n_node);
+      for (unsigned j = 0; j < n_node; j++)
+      {
+        Vertex_coordinate[2 * j] = x_node[j];
+        Vertex_coordinate[2 * j + 1] = y_node[j];
+        if ((boundary_markers_flag == 1) && (bound[j] > 0))
+        {
+          Vertex_boundaries[j].insert(bound[j] - 1);
+        }
+      }
+      return;
+    }
+
+    // Number of elements and number of nodes per element
+    unsigned n_element = Element_attribute.size();
+    const unsigned n_local_node = 3;
+
+    // Resize the Element vector
+    Element_pt.resize(n_element);
+
+    // Create a vector of boolean so as not to create the same node twice
+    std::vector<bool> done(n_node, false);
+
+    // Resize the Node vector
+    Node_pt.resize(n_node);
+
+
+    // Counter for nodes in the vector that lists
+    // the global node numbers of the elements' local nodes
+    unsigned counter = 0;
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      Element_pt[e] = new TElement<2, 2>;
+      for (unsigned j = 0; j < n_local_node; j++)
+      {
+        unsigned global_node_number = Global_node[counter];
+        if (done[global_node_number - 1] == false) //... -1 because node number
+        // begins at 1 in triangle
+        {
+          // If we are on the boundary
+          if ((boundary_markers_flag == 1) &&
+              (bound[global_node_number - 1] > 0))
+          {
+            // Construct a boundary node
+            Node_pt[global_node_number - 1] =
+              finite_element_pt(e)->construct_boundary_node(j);
+            // Add to the boundary node look-up scheme
+            add_boundary_node(bound[global_node_number - 1] - 1,
+                              Node_pt[global_node_number - 1]);
+          }
+          // Otherwise make an ordinary node
+          else
+          {
+            Node_pt[global_node_number - 1] =
+              finite_element_pt(e)->construct_node(j);
+          }
+          done[global_node_number - 1] = true;
+          Node_pt[global_node_number - 1]->x(0) =
+            x_node[global_node_number - 1];
+          Node_pt[global_node_number - 1]->x(1) =
+            y_node[global_node_number - 1];
+        }
+        else
+        {
+          finite_element_pt(e)->node_pt(j) = Node_pt[global_node_number - 1];
+        }
+        counter++;
+      }
+    }
+  }
+
+
+  //======================================================================
+  /// \short Add the vertex with 0-based triangle node number j to
+  /// (0-based) boundary b
+  //======================================================================
+  void TriangleScaffoldMesh::add_vertex_to_boundary(const unsigned& b,
+                                                    const unsigned& j)
+  {
+    if (Topology_only)
+    {
+      Vertex_boundaries[j].insert(b);
+    }
+    else
+    {
+      add_boundary_node(b, Node_pt[j]);
+    }
+  }
+
   //=====================================================================
   /// Constructor: Pass the filenames of the triangle files
   /// The assumptions are that the nodes have been assigned boundary
@@ -83,11 +189,13 @@ namespace oomph
   //=====================================================================
   TriangleScaffoldMesh::TriangleScaffoldMesh(const std::string& node_file_name,
                                              const std::string& ele_file_name,
-                                             const std::string& poly_file_name)
+                                             const std::string& poly_file_name,
+                                             const bool& topology_only)
+    : Topology_only(topology_only)
   {
     // Process element file
     //---------------------
-    std::ifstream element_file(ele_file_name.c_str(), std::ios_base::in);
+    MappedTextFile element_file(ele_file_name);
 
     // Check that the file actually opened correctly
     if (!element_file.is_open())
@@ -99,12 +207,10 @@ namespace oomph
     }
 
     // Number of elements
-    unsigned n_element;
-    element_file >> n_element;
+    unsigned n_element = element_file.read_unsigned();
 
     // Number of nodes per element
-    unsigned n_local_node;
-    element_file >> n_local_node;
+    unsigned n_local_node = element_file.read_unsigned();
     if (n_local_node != 3)
     {
       std::ostringstream error_stream;
@@ -117,64 +223,72 @@ namespace oomph
         error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
     }
 
-    // Dummy nodal attributes
-    unsigned dummy_attribute;
-
     // Element attributes may be used if we have internal boundaries
     Element_attribute.resize(n_element, 0.0);
 
-    // Dummy storage for element numbers
-    unsigned dummy_element_number;
-
     // Resize stoorage for global node numbers listed element-by-element
     Global_node.resize(n_element * n_local_node);
 
-#ifdef PARANOID
-    std::map<unsigned, bool> global_node_done;
-#endif
-
-    // Initialise counter
-    unsigned k = 0;
-
     // Are attributes specified?
-    unsigned attribute_flag;
-    element_file >> attribute_flag;
-
-    // Read global node numbers for all elements
-    if (attribute_flag == 0)
+    unsigned attribute_flag = element_file.read_unsigned();
+
+    // Locate the element records (one per line) and read global node
+    // numbers (and the first attribute) for all elements; the records are
+    // independent of each other
+    Vector<const char*> record_pt;
+    element_file.get_record_lines(n_element, record_pt);
+    const char* element_file_end_pt = element_file.end_pt();
+    long n_element_long = n_element;
+    bool parse_error = false;
+#ifdef _OPENMP
+    bool use_threads = ThreadingHelpers::use_threads(n_element);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long i = 0; i < n_element_long; i++)
     {
-      for (unsigned i = 0; i < n_element; i++)
+      // Exceptions mustn't escape from the parallel region
+      try
       {
-        element_file >> dummy_element_number;
+        const char* pt = record_pt[i];
+
+        // Skip the element number
+        MappedTextFile::parse_unsigned(pt, element_file_end_pt);
         for (unsigned j = 0; j < n_local_node; j++)
         {
-          element_file >> Global_node[k];
-#ifdef PARANOID
-          global_node_done[Global_node[k] - 1] = true;
-#endif
-          k++;
+          Global_node[i * n_local_node + j] =
+            MappedTextFile::parse_unsigned(pt, element_file_end_pt);
+        }
+        if (attribute_flag != 0)
+        {
+          Element_attribute[i] =
+            MappedTextFile::parse_double(pt, element_file_end_pt);
         }
       }
-    }
-    else
-    {
-      for (unsigned i = 0; i < n_element; i++)
+      catch (OomphLibError&)
       {
-        element_file >> dummy_element_number;
-        for (unsigned j = 0; j < n_local_node; j++)
-        {
-          element_file >> Global_node[k];
-#ifdef PARANOID
-          global_node_done[Global_node[k] - 1] = true;
+#ifdef _OPENMP
+#pragma omp critical
 #endif
-          k++;
-        }
-        element_file >> Element_attribute[i];
+        parse_error = true;
       }
     }
-    element_file.close();
+    if (parse_error)
+    {
+      std::string error_msg("Failed to parse element file: ");
+      error_msg += "\"" + ele_file_name + "\".";
+      throw OomphLibError(
+        error_msg, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
 
 #ifdef PARANOID
+    // Record which global nodes are listed in the element file
+    std::map<unsigned, bool> global_node_done;
+    unsigned n_global_node = Global_node.size();
+    for (unsigned k = 0; k < n_global_node; k++)
+    {
+      global_node_done[Global_node[k] - 1] = true;
+    }
+
     // Determine if the node numbering starts at 0 or 1 (triangle can do
     // either depending on input arguments). We can't (currently) handle
     // 0-based indexing so throw an error if it is being used.
@@ -192,12 +306,9 @@ namespace oomph
     }
 #endif
 
-    // Resize the Element vector
-    Element_pt.resize(n_element);
-
     // Process node file
     // -----------------
-    std::ifstream node_file(node_file_name.c_str(), std::ios_base::in);
+    MappedTextFile node_file(node_file_name);
 
     // Check that the file actually opened correctly
     if (!node_file.is_open())
@@ -209,18 +320,10 @@ namespace oomph
     }
 
     // Read number of nodes
-    unsigned n_node;
-    node_file >> n_node;
-
-    // Create a vector of boolean so as not to create the same node twice
-    std::vector<bool> done(n_node, false);
-
-    // Resize the Node vector
-    Node_pt.resize(n_node);
+    unsigned n_node = node_file.read_unsigned();
 
     // Spatial dimension of nodes
-    unsigned dimension;
-    node_file >> dimension;
+    unsigned dimension = node_file.read_unsigned();
 
 #ifdef PARANOID
     if (dimension != 2)
@@ -231,74 +334,64 @@ namespace oomph
     }
 #endif
 
-    // Flag for attributes
-    node_file >> attribute_flag;
+    // Number of attributes
+    attribute_flag = node_file.read_unsigned();
 
     // Flag for boundary markers
-    unsigned boundary_markers_flag;
-    node_file >> boundary_markers_flag;
-
-    // Dummy for node number
-    unsigned dummy_node_number;
+    unsigned boundary_markers_flag = node_file.read_unsigned();
 
     // Create storage for nodal posititions and boundary markers
     Vector<double> x_node(n_node);
     Vector<double> y_node(n_node);
-    Vector<unsigned> bound(n_node);
-
-    // Check if there are attributes
-    if (attribute_flag == 0)
+    Vector<unsigned> bound(n_node, 0);
+
+    // Locate and parse the node records (which are independent of each
+    // other)
+    node_file.get_record_lines(n_node, record_pt);
+    const char* node_file_end_pt = node_file.end_pt();
+    long n_node_long = n_node;
+#ifdef _OPENMP
+    use_threads = ThreadingHelpers::use_threads(n_node);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long i = 0; i < n_node_long; i++)
     {
-      if (boundary_markers_flag == 1)
+      // Exceptions mustn't escape from the parallel region
+      try
       {
-        for (unsigned i = 0; i < n_node; i++)
-        {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> bound[i];
-        }
-        node_file.close();
-      }
-      else
-      {
-        for (unsigned i = 0; i < n_node; i++)
+        const char* pt = record_pt[i];
+
+        // Skip the node number
+        MappedTextFile::parse_unsigned(pt, node_file_end_pt);
+        x_node[i] = MappedTextFile::parse_double(pt, node_file_end_pt);
+        y_node[i] = MappedTextFile::parse_double(pt, node_file_end_pt);
+
+        // Skip the attributes
+        for (unsigned j = 0; j < attribute_flag; j++)
         {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          bound[i] = 0;
+          MappedTextFile::parse_double(pt, node_file_end_pt);
         }
-        node_file.close();
-      }
-    }
-    else
-    {
-      if (boundary_markers_flag == 1)
-      {
-        for (unsigned i = 0; i < n_node; i++)
+        if (boundary_markers_flag == 1)
         {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> dummy_attribute;
-          node_file >> bound[i];
+          bound[i] = MappedTextFile::parse_unsigned(pt, node_file_end_pt);
         }
-        node_file.close();
       }
-      else
+      catch (OomphLibError&)
       {
-        for (unsigned i = 0; i < n_node; i++)
-        {
-          node_file >> dummy_node_number;
-          node_file >> x_node[i];
-          node_file >> y_node[i];
-          node_file >> dummy_attribute;
-          bound[i] = 0;
-        }
-        node_file.close();
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        parse_error = true;
       }
-    } // end
+    }
+    if (parse_error)
+    {
+      std::string error_msg("Failed to parse node file: ");
+      error_msg += "\"" + node_file_name + "\".";
+      throw OomphLibError(
+        error_msg, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    record_pt.clear();
 
 
     // Determine highest boundary index
@@ -474,56 +567,16 @@ namespace oomph
     }
 
 
-    // Create the elements
-    //--------------------
-
-    // Counter for nodes in the vector that lists
-    // the global node numbers of the elements' local nodes
-    unsigned counter = 0;
-    for (unsigned e = 0; e < n_element; e++)
-    {
-      Element_pt[e] = new TElement<2, 2>;
-      for (unsigned j = 0; j < n_local_node; j++)
-      {
-        unsigned global_node_number = Global_node[counter];
-        if (done[global_node_number - 1] == false) //... -1 because node number
-        // begins at 1 in triangle
-        {
-          // If we are on the boundary
-          if ((boundary_markers_flag == 1) &&
-              (bound[global_node_number - 1] > 0))
-          {
-            // Construct a boundary node
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_boundary_node(j);
-            // Add to the boundary node look-up scheme
-            add_boundary_node(bound[global_node_number - 1] - 1,
-                              Node_pt[global_node_number - 1]);
-          }
-          // Otherwise make an ordinary node
-          else
-          {
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_node(j);
-          }
-          done[global_node_number - 1] = true;
-          Node_pt[global_node_number - 1]->x(0) =
-            x_node[global_node_number - 1];
-          Node_pt[global_node_number - 1]->x(1) =
-            y_node[global_node_number - 1];
-        }
-        else
-        {
-          finite_element_pt(e)->node_pt(j) = Node_pt[global_node_number - 1];
-        }
-        counter++;
-      }
-    }
+    // Create the elements and their vertex nodes (or just record the
+    // vertex positions and boundaries)
+    //--------------------------------------------------------------
+    setup_vertices(x_node, y_node, bound, boundary_markers_flag);
 
     // Resize the "matrix" that stores the boundary id for each
     // edge in each element.
-    Edge_boundary.resize(n_element);
-    Edge_index.resize(n_element);
+    // (By default each edge is NOT on a boundary)
+    Edge_boundary.resize(3 * n_element, 0);
+    Edge_index.resize(3 * n_element);
 
     // Storage for the global node numbers (in triangle's 1-based
     // numbering scheme) for the zero-th, 1st, and 2nd node in each
@@ -540,15 +593,6 @@ namespace oomph
     // Loop over the elements
     for (unsigned e = 0; e < n_element; e++)
     {
-      // Each element has three edges
-      Edge_boundary[e].resize(3);
-      Edge_index[e].resize(3);
-      // By default each edge is NOT on a boundary
-      for (unsigned i = 0; i < 3; i++)
-      {
-        Edge_boundary[e][i] = 0;
-      }
-
       // Read out the global node numbers from the triangle data structure
       const unsigned element_offset = e * n_local_node;
       for (unsigned i = 0; i < 3; i++)
@@ -591,7 +635,7 @@ namespace oomph
         if (local_edge_index.size() == 0)
         {
           // Allocate the next global index
-          Edge_index[e][i] = Nglobal_edge;
+          Edge_index[3 * e + i] = Nglobal_edge;
           // Associate the new edge index with the nodes
           node_on_edges[glob_num[i]].insert(Nglobal_edge);
           node_on_edges[glob_num[(i + 1) % 3]].insert(Nglobal_edge);
@@ -602,17 +646,17 @@ namespace oomph
         else if (local_edge_index.size() == 1)
         {
           // Set the edge index
-          Edge_index[e][i] = local_edge_index[0];
+          Edge_index[3 * e + i] = local_edge_index[0];
           // Allocate the boundary index, if it is a segment
           if (local_edge_index[0] < n_segment)
           {
-            Edge_boundary[e][i] = segment_boundary[local_edge_index[0]];
+            Edge_boundary[3 * e + i] = segment_boundary[local_edge_index[0]];
             // Add the nodes to the boundary look-up scheme in
             // oomph-lib (0-based) index
-            add_boundary_node(segment_boundary[local_edge_index[0]] - 1,
-                              Node_pt[glob_num[i] - 1]);
-            add_boundary_node(segment_boundary[local_edge_index[0]] - 1,
-                              Node_pt[glob_num[(i + 1) % 3] - 1]);
+            add_vertex_to_boundary(segment_boundary[local_edge_index[0]] - 1,
+                                   glob_num[i] - 1);
+            add_vertex_to_boundary(segment_boundary[local_edge_index[0]] - 1,
+                                   glob_num[(i + 1) % 3] - 1);
           }
         }
       }
@@ -622,7 +666,7 @@ namespace oomph
 
     std::ostringstream error_stream;
     bool broken = false;
-    unsigned nnod = nnode();
+    unsigned nnod = nvertex();
     error_stream << "Checking presence of " << nnod << " global nodes\n";
     for (unsigned j = 0; j < nnod; j++)
     {
@@ -640,7 +684,10 @@ namespace oomph
     }
 
     // Check things and throw if mesh is broken...
-    check_mesh_integrity();
+    if (!Topology_only)
+    {
+      check_mesh_integrity();
+    }
 #endif
   }
 
@@ -650,7 +697,9 @@ namespace oomph
   /// \short Constructor: Pass a data structure obtained from the triangulate
   /// function
   //=====================================================================
-  TriangleScaffoldMesh::TriangleScaffoldMesh(TriangulateIO& triangle_data)
+  TriangleScaffoldMesh::TriangleScaffoldMesh(TriangulateIO& triangle_data,
+                                             const bool& topology_only)
+    : Topology_only(topology_only)
   {
     // Number of elements
     unsigned n_element = static_cast<unsigned>(triangle_data.numberoftriangles);
@@ -718,18 +767,9 @@ namespace oomph
       }
     }
 
-    // Resize the Element vector
-    Element_pt.resize(n_element);
-
     // Read number of nodes
     unsigned n_node = triangle_data.numberofpoints;
 
-    // Create a vector of boolean so as not to create the same node twice
-    std::vector<bool> done(n_node, false);
-
-    // Resize the Node vector
-    Node_pt.resize(n_node);
-
     // Flag for boundary markers
     unsigned boundary_markers_flag = 0;
     if (triangle_data.pointmarkerlist != 0)
@@ -848,57 +888,16 @@ namespace oomph
     }
 
 
-    // Create the elements
-    //--------------------
-
-    // Counter for nodes in the vector that lists
-    // the global node numbers of the elements' local nodes
-    unsigned counter = 0;
-    for (unsigned e = 0; e < n_element; e++)
-    {
-      Element_pt[e] = new TElement<2, 2>;
-      for (unsigned j = 0; j < n_local_node; j++)
-      {
-        unsigned global_node_number = Global_node[counter];
-        if (done[global_node_number - 1] == false) //... -1 because node number
-        // begins at 1 in triangle
-        {
-          // If we are on the boundary
-          if ((boundary_markers_flag == 1) &&
-              (bound[global_node_number - 1] > 0))
-          {
-            // Construct a boundary node
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_boundary_node(j);
-
-            // Add to the boundary node look-up scheme
-            add_boundary_node(bound[global_node_number - 1] - 1,
-                              Node_pt[global_node_number - 1]);
-          }
-          // Otherwise make an ordinary node
-          else
-          {
-            Node_pt[global_node_number - 1] =
-              finite_element_pt(e)->construct_node(j);
-          }
-          done[global_node_number - 1] = true;
-          Node_pt[global_node_number - 1]->x(0) =
-            x_node[global_node_number - 1];
-          Node_pt[global_node_number - 1]->x(1) =
-            y_node[global_node_number - 1];
-        }
-        else
-        {
-          finite_element_pt(e)->node_pt(j) = Node_pt[global_node_number - 1];
-        }
-        counter++;
-      }
-    }
+    // Create the elements and their vertex nodes (or just record the
+    // vertex positions and boundaries)
+    //--------------------------------------------------------------
+    setup_vertices(x_node, y_node, bound, boundary_markers_flag);
 
     // Resize the "matrix" that stores the boundary id for each
     // edge in each element.
-    Edge_boundary.resize(n_element);
-    Edge_index.resize(n_element);
+    // (By default each edge is NOT on a boundary)
+    Edge_boundary.resize(3 * n_element, 0);
+    Edge_index.resize(3 * n_element);
 
     // Storage for the global node numbers (in triangle's 1-based
     // numbering scheme) for the zero-th, 1st, and 2nd node in each
@@ -915,15 +914,6 @@ namespace oomph
     // Loop over the elements
     for (unsigned e = 0; e < n_element; e++)
     {
-      // Each element has three edges
-      Edge_boundary[e].resize(3);
-      Edge_index[e].resize(3);
-      // By default each edge is NOT on a boundary
-      for (unsigned i = 0; i < 3; i++)
-      {
-        Edge_boundary[e][i] = 0;
-      }
-
       // Read out the global node numbers from the triangle data structure
       const unsigned element_offset = e * n_local_node;
       for (unsigned i = 0; i < 3; i++)
@@ -967,7 +957,7 @@ namespace oomph
         if (local_edge_index.size() == 0)
         {
           // Allocate the next global index
-          Edge_index[e][i] = Nglobal_edge;
+          Edge_index[3 * e + i] = Nglobal_edge;
           // Associate the new edge index with the nodes
           node_on_edges[glob_num[i]].insert(Nglobal_edge);
           node_on_edges[glob_num[(i + 1) % 3]].insert(Nglobal_edge);
@@ -978,17 +968,17 @@ namespace oomph
         else if (local_edge_index.size() == 1)
         {
           // Set the edge index
-          Edge_index[e][i] = local_edge_index[0];
+          Edge_index[3 * e + i] = local_edge_index[0];
           // Allocate the boundary index, if it is a segment
           if (local_edge_index[0] < n_segment)
           {
-            Edge_boundary[e][i] = segment_boundary[local_edge_index[0]];
+            Edge_boundary[3 * e + i] = segment_boundary[local_edge_index[0]];
             // Add the nodes to the boundary look-up scheme in
             // oomph-lib (0-based) index
-            add_boundary_node(segment_boundary[local_edge_index[0]] - 1,
-                              Node_pt[glob_num[i] - 1]);
-            add_boundary_node(segment_boundary[local_edge_index[0]] - 1,
-                              Node_pt[glob_num[(i + 1) % 3] - 1]);
+            add_vertex_to_boundary(segment_boundary[local_edge_index[0]] - 1,
+                                   glob_num[i] - 1);
+            add_vertex_to_boundary(segment_boundary[local_edge_index[0]] - 1,
+                                   glob_num[(i + 1) % 3] - 1);
           }
         }
       }
@@ -998,7 +988,7 @@ namespace oomph
 
     std::ostringstream error_stream;
     bool broken = false;
-    unsigned nnod = nnode();
+    unsigned nnod = nvertex();
     error_stream << "Checking presence of " << nnod << " global nodes\n";
     for (unsigned j = 0; j < nnod; j++)
     {
@@ -1022,7 +1012,10 @@ namespace oomph
     }
 
     // Check things and throw if mesh is broken...
-    check_mesh_integrity();
+    if (!Topology_only)
+    {
+      check_mesh_integrity();
+    }
 #endif
   }
 
@@ -51,17 +51,24 @@ namespace oomph
   {
   public:
     /// Empty constructor
-    TriangleScaffoldMesh() {}
+    TriangleScaffoldMesh() : Topology_only(false) {}
 
-    /// \short Constructor: Pass the filenames of the triangle files
+    /// \short Constructor: Pass the filenames of the triangle files.
+    /// If topology_only is true, the scaffold's elements and nodes are
+    /// not built; only the vertex positions and boundaries, and the
+    /// edge lookup schemes are set up. This is all that
+    /// TriangleMesh::build_from_scaffold(...) needs.
     TriangleScaffoldMesh(const std::string& node_file_name,
                          const std::string& element_file_name,
-                         const std::string& poly_file_name);
+                         const std::string& poly_file_name,
+                         const bool& topology_only = false);
 
 #ifdef OOMPH_HAS_TRIANGLE_LIB
 
-    /// \short Constructor: Pass the TriangulateIO object
-    TriangleScaffoldMesh(TriangulateIO& triangle_data);
+    /// \short Constructor: Pass the TriangulateIO object. topology_only
+    /// has the same meaning as in the file-based constructor.
+    TriangleScaffoldMesh(TriangulateIO& triangle_data,
+                         const bool& topology_only = false);
 
 #endif
 
@@ -95,7 +102,7 @@ namespace oomph
     /// Will be reduced by one to identify the oomph-lib boundary.
     unsigned edge_boundary(const unsigned& e, const unsigned& i) const
     {
-      return Edge_boundary[e][i];
+      return Edge_boundary[3 * e + i];
     }
 
     /// \short Return the number of internal edges
@@ -108,7 +115,62 @@ namespace oomph
     /// The global index starts from zero
     unsigned edge_index(const unsigned& e, const unsigned& i) const
     {
-      return Edge_index[e][i];
+      return Edge_index[3 * e + i];
+    }
+
+    /// \short Number of linear triangles in the scaffold (also valid in
+    /// topology-only mode, where no elements are built)
+    unsigned nscaffold_element() const
+    {
+      return Element_attribute.size();
+    }
+
+    /// \short Has the scaffold been built in topology-only mode, i.e.
+    /// without elements and nodes?
+    bool topology_only() const
+    {
+      return Topology_only;
+    }
+
+    /// \short Number of vertices, i.e. nodes in the triangle input
+    unsigned nvertex() const
+    {
+      if (Topology_only)
+      {
+        return Vertex_coordinate.size() / 2;
+      }
+      return Node_pt.size();
+    }
+
+    /// \short i-th coordinate of the vertex with (0-based) triangle node
+    /// number j
+    double vertex_coordinate(const unsigned& j, const unsigned& i) const
+    {
+      if (Topology_only)
+      {
+        return Vertex_coordinate[2 * j + i];
+      }
+      return Node_pt[j]->x(i);
+    }
+
+    /// \short Pointer to the set of (0-based) boundaries that the vertex
+    /// with (0-based) triangle node number j is on; null if it's not on
+    /// any boundary
+    const std::set<unsigned>* vertex_boundaries_pt(const unsigned& j)
+    {
+      if (Topology_only)
+      {
+        std::map<unsigned, std::set<unsigned>>::const_iterator it =
+          Vertex_boundaries.find(j);
+        if (it == Vertex_boundaries.end())
+        {
+          return 0;
+        }
+        return &(it->second);
+      }
+      std::set<unsigned>* boundaries_pt = 0;
+      Node_pt[j]->get_boundaries_pt(boundaries_pt);
+      return boundaries_pt;
     }
 
     /// \short Return the attribute of the element e
@@ -128,19 +190,42 @@ namespace oomph
     /// and throws error if violated.
     void check_mesh_integrity();
 
+    /// \short Create the scaffold's elements and vertex nodes or, in
+    /// topology-only mode, record the vertex positions and boundaries
+    void setup_vertices(const Vector<double>& x_node,
+                        const Vector<double>& y_node,
+                        const Vector<unsigned>& bound,
+                        const unsigned& boundary_markers_flag);
+
+    /// \short Add the vertex with (0-based) triangle node number j to
+    /// (0-based) boundary b
+    void add_vertex_to_boundary(const unsigned& b, const unsigned& j);
+
+    /// \short Has the scaffold been built without elements and nodes?
+    bool Topology_only;
+
+    /// \short Vertex coordinates (x,y for each vertex in turn); only
+    /// used in topology-only mode
+    Vector<double> Vertex_coordinate;
+
+    /// \short Boundaries of the vertices that are on boundaries, keyed by
+    /// their (0-based) triangle node number; only used in topology-only
+    /// mode
+    std::map<unsigned, std::set<unsigned>> Vertex_boundaries;
+
     /// \short Number of internal edges
     unsigned Nglobal_edge;
 
     /// \short Storage for global node numbers listed element-by-element
     Vector<unsigned> Global_node;
 
-    /// \short Vector of vectors containing the boundary ids of the
-    /// elements' edges
-    Vector<Vector<unsigned>> Edge_boundary;
+    /// \short Boundary ids of the elements' edges, listed
+    /// element-by-element (three per element)
+    Vector<unsigned> Edge_boundary;
 
-    /// \short Vector of vectors containing the global edge index of
-    // the elements' edges
-    Vector<Vector<unsigned>> Edge_index;
+    /// \short Global edge indices of the elements' edges, listed
+    /// element-by-element (three per element)
+    Vector<unsigned> Edge_index;
 
     /// \short Vector of double attributes for each element
     Vector<double> Element_attribute;
@@ -166,6 +166,47 @@ namespace oomph
       } // end of plotpoint loop
     } // end scalar_value_paraview
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      if (i > 1)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Helmholtz elements only store 2 fields so i must be 0 or 1"
+          << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Vector of local coordinates
+      Vector<double> s(DIM);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+        std::complex<double> u(interpolated_u_helmholtz(s));
+
+        // Real part first, imaginary part second
+        if (i == 0)
+        {
+          value[iplot] = u.real();
+        }
+        else
+        {
+          value[iplot] = u.imag();
+        }
+      }
+    }
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
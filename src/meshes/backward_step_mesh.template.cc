@@ -176,7 +176,7 @@ namespace oomph
 
     // Re-setup lookup scheme that establishes which elements are located
     // on the mesh boundaries
-    this->setup_boundary_element_info();
+    this->defer_boundary_element_info_setup();
   }
 
 } // namespace oomph
@@ -1005,7 +1005,7 @@ namespace oomph
 
     // (Re-)setup lookup scheme that establishes which elements are located
     // on the mesh boundaries
-    this->setup_boundary_element_info();
+    this->defer_boundary_element_info_setup();
 
     // Flush the storage for elements and nodes in the auxiliary mesh
     // so it can be safely deleted
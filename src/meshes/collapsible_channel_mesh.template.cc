@@ -222,7 +222,7 @@ namespace oomph
 
     // Re-setup lookup scheme that establishes which elements are located
     // on the mesh boundaries (doesn't need to be wiped)
-    this->setup_boundary_element_info();
+    this->defer_boundary_element_info_setup();
 
     // We have only bothered to parametrise boundary 3
     this->Boundary_coordinate_exists[3] = true;
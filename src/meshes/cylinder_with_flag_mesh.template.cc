@@ -855,7 +855,7 @@ namespace oomph
 
 
     this->node_update();
-    setup_boundary_element_info();
+    defer_boundary_element_info_setup();
 
     // Set boundary coordinates on the flag
 
@@ -1306,7 +1306,7 @@ namespace oomph
 
     // Setup lookup scheme that establishes which elements are located
     // on the mesh boundaries
-    setup_boundary_element_info();
+    defer_boundary_element_info_setup();
 
     // If the user wishes the mesh setup time to be doc-ed
     if (MeshExtrusionHelpers::Mesh_extrusion_helper.doc_mesh_setup_time())
@@ -621,7 +621,7 @@ namespace oomph
     }
 
     // Setup boundary element lookup schemes
-    setup_boundary_element_info();
+    defer_boundary_element_info_setup();
   }
 
   ///////////////////////////////////////////////////////////////////////
@@ -279,7 +279,7 @@ namespace oomph
       }
 
       // Setup boundary element lookup schemes
-      this->setup_boundary_element_info();
+      this->defer_boundary_element_info_setup();
 
       // Nodal positions etc. were created in constructor for
       // RectangularMesh<...>. Only need to setup quadtree forest
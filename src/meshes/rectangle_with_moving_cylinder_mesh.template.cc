@@ -1757,7 +1757,7 @@ namespace oomph
     this->setup_quadtree_forest();
 
     // Setup boundary element lookup schemes
-    this->setup_boundary_element_info();
+    this->defer_boundary_element_info_setup();
 
     // Cleanup. NOTE: Can't delete Central_mesh_pt as it's responsible for
     // deleting Domain_pt but
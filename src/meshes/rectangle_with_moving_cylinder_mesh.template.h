@@ -299,7 +299,7 @@ namespace oomph
       }
 
       // Setup boundary element lookup schemes
-      this->setup_boundary_element_info();
+      this->defer_boundary_element_info_setup();
 
       // Setup quadtree forest for mesh refinement
       this->setup_quadtree_forest();
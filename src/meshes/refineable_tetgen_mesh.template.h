@@ -133,8 +133,8 @@ namespace oomph
 
       // Build triangulateio refined object
       tetrahedralize(tetswitches, tetgen_input_pt, this->Tetgenio_pt);
-      // Build scaffold
-      this->Tmp_mesh_pt = new TetgenScaffoldMesh(*this->Tetgenio_pt);
+      // Build (topology-only) scaffold
+      this->Tmp_mesh_pt = new TetgenScaffoldMesh(*this->Tetgenio_pt, true);
 
       // Convert mesh from scaffold to actual mesh
       this->build_from_scaffold(time_stepper_pt, use_attributes);
@@ -904,7 +904,7 @@ namespace oomph
 
     // Setup lookup scheme that establishes which elements are located
     // on the mesh boundaries
-    setup_boundary_element_info();
+    defer_boundary_element_info_setup();
   }
 
 } // namespace oomph
@@ -52,11 +52,11 @@ namespace oomph
     MeshChecker::assert_geometric_element<TElementGeometricBase, ELEMENT>(3);
 
     // Create space for elements
-    unsigned nelem = Tmp_mesh_pt->nelement();
+    unsigned nelem = Tmp_mesh_pt->nscaffold_element();
     Element_pt.resize(nelem);
 
     // Create space for nodes
-    unsigned nnode_scaffold = Tmp_mesh_pt->nnode();
+    unsigned nnode_scaffold = Tmp_mesh_pt->nvertex();
     Node_pt.resize(nnode_scaffold);
 
     // Set number of boundaries
@@ -79,13 +79,15 @@ namespace oomph
       Element_pt[e] = new ELEMENT;
     }
 
-    // Number of nodes per element
-    unsigned nnod_el = Tmp_mesh_pt->finite_element_pt(0)->nnode();
+    // Number of vertex nodes per element
+    const unsigned nnod_el = 4;
 
-    // Setup map to check the (pseudo-)global node number
-    // Nodes whose number is zero haven't been copied across
-    // into the mesh yet.
-    std::map<Node*, unsigned> global_number;
+    // New node associated with each vertex of the scaffold (indexed by
+    // the 0-based tetgen node number); null if not created yet. The
+    // vertex nodes are identified via the scaffold's global node
+    // numbers (rather than its nodes) so that the scaffold can be built
+    // in topology-only mode.
+    Vector<Node*> vertex_node_pt(nnode_scaffold, 0);
     unsigned global_count = 0;
 
     // Map of element attribute pairs
@@ -97,20 +99,18 @@ namespace oomph
       // Loop over all nodes in element
       for (unsigned j = 0; j < nnod_el; j++)
       {
-        // Pointer to node in the scaffold mesh
-        Node* scaffold_node_pt = Tmp_mesh_pt->finite_element_pt(e)->node_pt(j);
-
-        // Get the (pseudo-)global node number in scaffold mesh
-        // (It's zero [=default] if not visited this one yet)
-        unsigned j_global = global_number[scaffold_node_pt];
+        // The (0-based) tetgen node number of the j-th vertex. Tetgen
+        // lists the nodes that are our local nodes 3, 0, 1, 2 in turn
+        unsigned j_global =
+          Tmp_mesh_pt->global_node_number(e * nnod_el + (j + 1) % 4) - 1;
 
         // Haven't done this one yet
-        if (j_global == 0)
+        if (vertex_node_pt[j_global] == 0)
         {
           // Get pointer to set of mesh boundaries that this
-          // scaffold node occupies; NULL if the node is not on any boundary
-          std::set<unsigned>* boundaries_pt;
-          scaffold_node_pt->get_boundaries_pt(boundaries_pt);
+          // scaffold vertex occupies; NULL if it is not on any boundary
+          const std::set<unsigned>* boundaries_pt =
+            Tmp_mesh_pt->vertex_boundaries_pt(j_global);
 
           // Is it on boundaries?
           if (boundaries_pt != 0)
@@ -119,14 +119,9 @@ namespace oomph
             Node* new_node_pt =
               finite_element_pt(e)->construct_boundary_node(j, time_stepper_pt);
 
-            // Give it a number (not necessarily the global node
-            // number in the scaffold mesh -- we just need something
-            // to keep track...)
-            global_count++;
-            global_number[scaffold_node_pt] = global_count;
-
             // Add to boundaries
-            for (std::set<unsigned>::iterator it = boundaries_pt->begin();
+            for (std::set<unsigned>::const_iterator it =
+                   boundaries_pt->begin();
                  it != boundaries_pt->end();
                  ++it)
             {
@@ -138,29 +133,25 @@ namespace oomph
           {
             // Create new normal node
             finite_element_pt(e)->construct_node(j, time_stepper_pt);
-
-            // Give it a number (not necessarily the global node
-            // number in the scaffold mesh -- we just need something
-            // to keep track...)
-            global_count++;
-            global_number[scaffold_node_pt] = global_count;
           }
 
           // Copy new node, created using the NEW element's construct_node
-          // function into global storage, using the same global
-          // node number that we've just associated with the
-          // corresponding node in the scaffold mesh
-          Node_pt[global_count - 1] = finite_element_pt(e)->node_pt(j);
+          // function into global storage (in the order in which the
+          // nodes are visited)
+          Node* new_node_pt = finite_element_pt(e)->node_pt(j);
+          Node_pt[global_count] = new_node_pt;
+          vertex_node_pt[j_global] = new_node_pt;
+          global_count++;
 
           // Assign coordinates
-          Node_pt[global_count - 1]->x(0) = scaffold_node_pt->x(0);
-          Node_pt[global_count - 1]->x(1) = scaffold_node_pt->x(1);
-          Node_pt[global_count - 1]->x(2) = scaffold_node_pt->x(2);
+          new_node_pt->x(0) = Tmp_mesh_pt->vertex_coordinate(j_global, 0);
+          new_node_pt->x(1) = Tmp_mesh_pt->vertex_coordinate(j_global, 1);
+          new_node_pt->x(2) = Tmp_mesh_pt->vertex_coordinate(j_global, 2);
         }
         // This one has already been done: Copy across
         else
         {
-          finite_element_pt(e)->node_pt(j) = Node_pt[j_global - 1];
+          finite_element_pt(e)->node_pt(j) = vertex_node_pt[j_global];
         }
       }
 
@@ -254,7 +245,6 @@ namespace oomph
     {
       // Cache pointers to the elements
       FiniteElement* const elem_pt = this->finite_element_pt(e);
-      FiniteElement* const tmp_elem_pt = Tmp_mesh_pt->finite_element_pt(e);
 
       // The number of edge nodes is 4 + 6*(n_node1d-2)
       unsigned n_edge_node = 4 + 6 * (n_node_1d - 2);
@@ -327,11 +317,11 @@ namespace oomph
               // Find the local coordinates of the node
               elem_pt->local_coordinate_of_node(n, s);
 
-              // Find the coordinates of the new node from the exiting and
-              // fully-functional element in the scaffold mesh
+              // Find the coordinates of the new node from the (straight-
+              // sided) tet spanned by the element's vertex nodes
               for (unsigned i = 0; i < dim; ++i)
               {
-                new_node_pt->x(i) = tmp_elem_pt->interpolated_x(s, i);
+                new_node_pt->x(i) = linear_vertex_interpolation(elem_pt, s, i);
               }
 
               // Add the newly created node to the global node list
@@ -400,11 +390,11 @@ namespace oomph
               // Find the local coordinates of the node
               elem_pt->local_coordinate_of_node(n, s);
 
-              // Find the coordinates of the new node from the exiting and
-              // fully-functional element in the scaffold mesh
+              // Find the coordinates of the new node from the (straight-
+              // sided) tet spanned by the element's vertex nodes
               for (unsigned i = 0; i < dim; ++i)
               {
-                new_node_pt->x(i) = tmp_elem_pt->interpolated_x(s, i);
+                new_node_pt->x(i) = linear_vertex_interpolation(elem_pt, s, i);
               }
 
               // Add the newly created node to the global node list
@@ -431,11 +421,11 @@ namespace oomph
             // Find the local coordinates of the node
             elem_pt->local_coordinate_of_node(n, s);
 
-            // Find the coordinates of the new node from the existing
-            // and fully-functional element in the scaffold mesh
+            // Find the coordinates of the new node from the (straight-
+            // sided) tet spanned by the element's vertex nodes
             for (unsigned i = 0; i < dim; i++)
             {
-              new_node_pt->x(i) = tmp_elem_pt->interpolated_x(s, i);
+              new_node_pt->x(i) = linear_vertex_interpolation(elem_pt, s, i);
             }
           }
         } // End of enriched case
@@ -480,7 +470,9 @@ namespace oomph
       } // End of loop over faces
 
 
-      // Lookup scheme has now been setup
+      // Lookup scheme has now been setup (eagerly, since it's needed
+      // for the boundary coordinates; see
+      // Mesh::defer_boundary_element_info_setup())
       Lookup_for_elements_next_boundary_is_setup = true;
 
 
@@ -75,9 +75,9 @@ namespace oomph
       // Store timestepper used to build elements
       Time_stepper_pt = time_stepper_pt;
 
-      // Build scaffold
+      // Build (topology-only) scaffold
       Tmp_mesh_pt = new TetgenScaffoldMesh(
-        node_file_name, element_file_name, face_file_name);
+        node_file_name, element_file_name, face_file_name, true);
 
       // Convert mesh from scaffold to actual mesh
       build_from_scaffold(time_stepper_pt, use_attributes);
@@ -115,8 +115,8 @@ namespace oomph
       Tetgenio_exists = false;
       Tetgenio_pt = 0;
 
-      // Build scaffold
-      Tmp_mesh_pt = new TetgenScaffoldMesh(tetgen_data);
+      // Build (topology-only) scaffold
+      Tmp_mesh_pt = new TetgenScaffoldMesh(tetgen_data, true);
 
       // Convert mesh from scaffold to actual mesh
       build_from_scaffold(time_stepper_pt, use_attributes);
@@ -165,9 +165,9 @@ namespace oomph
       this->Tetgenio_exists = false;
       this->Tetgenio_pt = 0;
 
-      // Build scaffold
+      // Build (topology-only) scaffold
       Tmp_mesh_pt = new TetgenScaffoldMesh(
-        node_file_name, element_file_name, face_file_name);
+        node_file_name, element_file_name, face_file_name, true);
 
       // Convert mesh from scaffold to actual mesh
       build_from_scaffold(time_stepper_pt, use_attributes);
@@ -220,8 +220,8 @@ namespace oomph
       ;
       this->Tetgenio_pt = 0;
 
-      // Build scaffold
-      Tmp_mesh_pt = new TetgenScaffoldMesh(tetgen_data);
+      // Build (topology-only) scaffold
+      Tmp_mesh_pt = new TetgenScaffoldMesh(tetgen_data, true);
 
       // Convert mesh from scaffold to actual mesh
       build_from_scaffold(time_stepper_pt, use_attributes);
@@ -322,8 +322,8 @@ namespace oomph
       Tetgenio_pt = new tetgenio;
       tetrahedralize(tetswitches, &in, this->Tetgenio_pt);
 
-      // Build scaffold
-      Tmp_mesh_pt = new TetgenScaffoldMesh(*this->Tetgenio_pt);
+      // Build (topology-only) scaffold
+      Tmp_mesh_pt = new TetgenScaffoldMesh(*this->Tetgenio_pt, true);
 
       // If any of the objects are different regions then we need to use
       // the atributes
@@ -675,6 +675,24 @@ namespace oomph
     void build_from_scaffold(TimeStepper* time_stepper_pt,
                              const bool& use_attributes);
 
+    /// \short i-th coordinate of the point at local coordinate s in the
+    /// straight-sided tet spanned by the vertex nodes of the element
+    /// pointed to by elem_pt. This is what the linear scaffold element
+    /// would return, so the new nodes can be placed without it.
+    double linear_vertex_interpolation(FiniteElement* const& elem_pt,
+                                       const Vector<double>& s,
+                                       const unsigned& i) const
+    {
+      // Shape functions of TElement<3,2>
+      const double psi[4] = {s[0], s[1], s[2], 1.0 - s[0] - s[1] - s[2]};
+      double x = 0.0;
+      for (unsigned l = 0; l < 4; l++)
+      {
+        x += elem_pt->node_pt(l)->x(i) * psi[l];
+      }
+      return x;
+    }
+
     /// \short Function to setup the reverse look-up schemes
     void setup_reverse_lookup_schemes_for_faceted_surface(
       TetMeshFacetedSurface* const& faceted_surface_pt);
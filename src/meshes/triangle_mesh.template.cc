@@ -48,24 +48,15 @@ namespace oomph
     MeshChecker::assert_geometric_element<TElementGeometricBase, ELEMENT>(2);
 
     // Create space for elements
-    unsigned nelem = Tmp_mesh_pt->nelement();
+    unsigned nelem = Tmp_mesh_pt->nscaffold_element();
     Element_pt.resize(nelem);
 
     // Create space for nodes
-    unsigned nnode_scaffold = Tmp_mesh_pt->nnode();
+    unsigned nnode_scaffold = Tmp_mesh_pt->nvertex();
 
-    // Create a map storing the node_id of the mesh used to update the
-    // node position in the update_triangulateio function
-    std::map<Node*, unsigned> old_global_number;
-
-    // Store the TriangulateIO node id
-    for (unsigned inod = 0; inod < nnode_scaffold; inod++)
-    {
-      Node* old_node_pt = Tmp_mesh_pt->node_pt(inod);
-      old_global_number[old_node_pt] = inod;
-    }
-
-    // Initialize the old node id vector
+    // Initialize the old node id vector (the TriangulateIO node id
+    // of each vertex node, used to update the node position in the
+    // update_triangulateio function)
     Oomph_vertex_nodes_id.resize(nnode_scaffold);
 
     // Create space for nodes
@@ -93,13 +84,15 @@ namespace oomph
       Element_pt[e] = new ELEMENT;
     }
 
-    // Number of nodes per element from the scaffold mesh
-    unsigned nnod_el = Tmp_mesh_pt->finite_element_pt(0)->nnode();
+    // Number of vertex nodes per element
+    const unsigned nnod_el = 3;
 
-    // Setup map to check the (pseudo-)global node number
-    // Nodes whose number is zero haven't been copied across
-    // into the mesh yet.
-    std::map<Node*, unsigned> global_number;
+    // New node associated with each vertex of the scaffold (indexed by
+    // the 0-based TriangulateIO node id); null if not created yet. The
+    // vertex nodes are identified via the scaffold's global node
+    // numbers (rather than its nodes) so that the scaffold can be built
+    // in topology-only mode.
+    Vector<Node*> vertex_node_pt(nnode_scaffold, 0);
     unsigned global_count = 0;
 
     // Map of Element attribute pairs
@@ -119,24 +112,20 @@ namespace oomph
       // Loop over all nodes in element
       for (unsigned j = 0; j < nnod_el; j++)
       {
-        // Pointer to node in the scaffold mesh
-        Node* scaffold_node_pt = Tmp_mesh_pt->finite_element_pt(e)->node_pt(j);
-
-        // Get the (pseudo-)global node number in scaffold mesh
-        // (It's zero [=default] if not visited this one yet)
-        unsigned j_global = global_number[scaffold_node_pt];
+        // The (0-based) TriangulateIO node id of the j-th vertex
+        unsigned j_global =
+          Tmp_mesh_pt->global_node_number(e * nnod_el + j) - 1;
 
         // Haven't done this one yet
-        if (j_global == 0)
+        if (vertex_node_pt[j_global] == 0)
         {
-          // Find and store the node_id in the old nodes map
-          Oomph_vertex_nodes_id[global_count] =
-            old_global_number[scaffold_node_pt];
+          // Store the node_id of the vertex
+          Oomph_vertex_nodes_id[global_count] = j_global;
 
           // Get pointer to set of mesh boundaries that this
-          // scaffold node occupies; NULL if the node is not on any boundary
-          std::set<unsigned>* boundaries_pt;
-          scaffold_node_pt->get_boundaries_pt(boundaries_pt);
+          // scaffold vertex occupies; NULL if it is not on any boundary
+          const std::set<unsigned>* boundaries_pt =
+            Tmp_mesh_pt->vertex_boundaries_pt(j_global);
 
           // Storage for the new node
           Node* new_node_pt = 0;
@@ -149,7 +138,8 @@ namespace oomph
               finite_element_pt(e)->construct_boundary_node(j, time_stepper_pt);
 
             // Add to boundaries
-            for (std::set<unsigned>::iterator it = boundaries_pt->begin();
+            for (std::set<unsigned>::const_iterator it =
+                   boundaries_pt->begin();
                  it != boundaries_pt->end();
                  ++it)
             {
@@ -164,28 +154,23 @@ namespace oomph
               finite_element_pt(e)->construct_node(j, time_stepper_pt);
           }
 
-          // Give it a number (not necessarily the global node
-          // number in the scaffold mesh -- we just need something
-          // to keep track...)
-          global_count++;
-          global_number[scaffold_node_pt] = global_count;
-
           // Copy new node, created using the NEW element's construct_node
-          // function into global storage, using the same global
-          // node number that we've just associated with the
-          // corresponding node in the scaffold mesh
-          Node_pt[global_count - 1] = new_node_pt;
+          // function into global storage (in the order in which the
+          // nodes are visited)
+          Node_pt[global_count] = new_node_pt;
+          vertex_node_pt[j_global] = new_node_pt;
+          global_count++;
 
           // Assign coordinates
           for (unsigned i = 0; i < finite_element_pt(e)->dim(); i++)
           {
-            new_node_pt->x(i) = scaffold_node_pt->x(i);
+            new_node_pt->x(i) = Tmp_mesh_pt->vertex_coordinate(j_global, i);
           }
         }
         // This one has already been done: Copy accross
         else
         {
-          finite_element_pt(e)->node_pt(j) = Node_pt[j_global - 1];
+          finite_element_pt(e)->node_pt(j) = vertex_node_pt[j_global];
         }
       }
 
@@ -246,7 +231,6 @@ namespace oomph
     {
       // Cache pointers to the elements
       FiniteElement* const elem_pt = finite_element_pt(e);
-      FiniteElement* const tmp_elem_pt = Tmp_mesh_pt->finite_element_pt(e);
 
       // The number of edge nodes is  3*(nnode_1d-1)
       unsigned n_edge_node = 3 * (n_node_1d - 1);
@@ -261,11 +245,11 @@ namespace oomph
         // What are the node's local coordinates?
         elem_pt->local_coordinate_of_node(n, s);
 
-        // Find the coordinates of the new node from the existing
-        // and fully-functional element in the scaffold mesh
+        // Find the coordinates of the new node from the (straight-
+        // sided) triangle spanned by the element's vertex nodes
         for (unsigned i = 0; i < dim; i++)
         {
-          new_node_pt->x(i) = tmp_elem_pt->interpolated_x(s, i);
+          new_node_pt->x(i) = linear_vertex_interpolation(elem_pt, s, i);
         }
 
         // Add the node to the mesh's global look-up scheme
@@ -311,11 +295,11 @@ namespace oomph
             // What are the node's local coordinates?
             elem_pt->local_coordinate_of_node(n, s);
 
-            // Find the coordinates of the new node from the existing
-            // and fully-functional element in the scaffold mesh
+            // Find the coordinates of the new node from the (straight-
+            // sided) triangle spanned by the element's vertex nodes
             for (unsigned i = 0; i < dim; i++)
             {
-              new_node_pt->x(i) = tmp_elem_pt->interpolated_x(s, i);
+              new_node_pt->x(i) = linear_vertex_interpolation(elem_pt, s, i);
             }
 
             // Add to the global node list
@@ -488,9 +488,9 @@ namespace oomph
       // Store the attributes
       Use_attributes = should_use_attributes;
 
-      // Build scaffold
+      // Build (topology-only) scaffold
       this->Tmp_mesh_pt = new TriangleScaffoldMesh(
-        node_file_name, element_file_name, poly_file_name);
+        node_file_name, element_file_name, poly_file_name, true);
 
       // Convert mesh from scaffold to actual mesh
       build_from_scaffold(time_stepper_pt, should_use_attributes);
@@ -820,8 +820,8 @@ namespace oomph
       _FPU_SETCW(cw);
 #endif
 
-      // Build scaffold
-      this->Tmp_mesh_pt = new TriangleScaffoldMesh(Triangulateio);
+      // Build (topology-only) scaffold
+      this->Tmp_mesh_pt = new TriangleScaffoldMesh(Triangulateio, true);
 
       // Convert mesh from scaffold to actual mesh
       build_from_scaffold(time_stepper_pt, use_attributes);
@@ -1117,8 +1117,8 @@ namespace oomph
       unsigned nbound = nboundary();
       Boundary_coordinate_exists.resize(nbound, false);
 
-      // Now build the new scaffold
-      this->Tmp_mesh_pt = new TriangleScaffoldMesh(this->Triangulateio);
+      // Now build the new (topology-only) scaffold
+      this->Tmp_mesh_pt = new TriangleScaffoldMesh(this->Triangulateio, true);
 
       // Triangulation has been created -- remember to wipe it!
       Triangulateio_exists = true;
@@ -1197,6 +1197,24 @@ namespace oomph
     void build_from_scaffold(TimeStepper* time_stepper_pt,
                              const bool& use_attributes);
 
+    /// \short i-th coordinate of the point at local coordinate s in the
+    /// straight-sided triangle spanned by the vertex nodes of the element
+    /// pointed to by elem_pt. This is what the linear scaffold element
+    /// would return, so the new nodes can be placed without it.
+    double linear_vertex_interpolation(FiniteElement* const& elem_pt,
+                                       const Vector<double>& s,
+                                       const unsigned& i) const
+    {
+      // Shape functions of TElement<2,2>
+      const double psi[3] = {s[0], s[1], 1.0 - s[0] - s[1]};
+      double x = 0.0;
+      for (unsigned l = 0; l < 3; l++)
+      {
+        x += elem_pt->node_pt(l)->x(i) * psi[l];
+      }
+      return x;
+    }
+
 #ifdef OOMPH_HAS_TRIANGLE_LIB
 
     /// \short Helper function to create TriangulateIO object (return in
@@ -1324,8 +1342,8 @@ namespace oomph
       _FPU_SETCW(cw);
 #endif
 
-      // Build scaffold
-      this->Tmp_mesh_pt = new TriangleScaffoldMesh(Triangulateio);
+      // Build (topology-only) scaffold
+      this->Tmp_mesh_pt = new TriangleScaffoldMesh(Triangulateio, true);
 
       // If we have filled holes then we must use the attributes
       if (!regions_coordinates.empty())
@@ -2378,8 +2396,8 @@ namespace oomph
       _FPU_SETCW(cw);
 #endif
 
-      // Build scaffold
-      this->Tmp_mesh_pt = new TriangleScaffoldMesh(this->Triangulateio);
+      // Build (topology-only) scaffold
+      this->Tmp_mesh_pt = new TriangleScaffoldMesh(this->Triangulateio, true);
 
       // Convert mesh from scaffold to actual mesh
       this->build_from_scaffold(time_stepper_pt, use_attributes);
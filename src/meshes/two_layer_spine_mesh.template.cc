@@ -692,7 +692,7 @@ namespace oomph
       }*/
 
     // Setup the boundary information
-    this->setup_boundary_element_info();
+    this->defer_boundary_element_info_setup();
   }
 
 
@@ -28,6 +28,7 @@
 
 
 #include "../generic/Telements.h"
+#include "../generic/mapped_text_file.h"
 #include "xda_tet_mesh.template.h"
 
 
@@ -49,8 +50,10 @@ namespace oomph
     // Mesh can only be built with 3D Telements.
     MeshChecker::assert_geometric_element<TElementGeometricBase, ELEMENT>(3);
 
-    // Open and process xda input file
-    std::ifstream infile(xda_file_name.c_str(), std::ios_base::in);
+    // Open and process xda input file (comments aren't allowed in xda
+    // files)
+    MappedTextFile infile(xda_file_name);
+    infile.disable_comments();
     unsigned n_node;
     unsigned n_element;
     unsigned n_bound_face;
@@ -63,35 +66,41 @@ namespace oomph
         error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
     }
 
-    // Dummy storage to jump lines
-    char dummy[101];
-
     // Ignore file format
-    infile.getline(dummy, 100);
+    infile.skip_line();
 
     // Get number of elements
-    infile >> n_element;
+    n_element = infile.read_unsigned();
 
     // Ignore rest of line
-    infile.getline(dummy, 100);
+    infile.skip_line();
 
     // Get number of nodes
-    infile >> n_node;
+    n_node = infile.read_unsigned();
 
     // Ignore rest of line
-    infile.getline(dummy, 100);
+    infile.skip_line();
 
     // Ignore sum of element weights (whatever that is...)
-    infile.getline(dummy, 100);
+    infile.skip_line();
 
     // Get number of enumerated boundary faces on which boundary conditions
     // are applied.
-    infile >> n_bound_face;
+    n_bound_face = infile.read_unsigned();
 
     // Keep reading until "Title String"
-    while (dummy[0] != 'T')
+    std::string line = infile.read_line();
+    while ((line.size() == 0) || (line[0] != 'T'))
     {
-      infile.getline(dummy, 100);
+      if (infile.at_end())
+      {
+        std::ostringstream error_stream;
+        error_stream << "No \"Title String\" in " << xda_file_name << "\n";
+        throw OomphLibError(error_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+      line = infile.read_line();
     }
 
     // Make space for nodes and elements
@@ -99,8 +108,7 @@ namespace oomph
     Element_pt.resize(n_element);
 
     // Read first line with node labels and count them
-    std::string line;
-    std::getline(infile, line);
+    line = infile.read_line();
     std::istringstream ostr(line);
     std::istream_iterator<std::string> it(ostr);
     std::istream_iterator<std::string> end;
@@ -128,40 +136,82 @@ namespace oomph
     // Storage for the global node numbers listed element-by-element
     Vector<unsigned> global_node(n_element * nnod_el);
 
-    // Read in nodes
-    unsigned k = 0;
-
     // Copy across first nodes
     for (unsigned j = 0; j < nnod_el; j++)
     {
-      global_node[k] = first_node[k];
-      k++;
+      global_node[j] = first_node[j];
     }
 
-    // Read the other ones
-    for (unsigned i = 1; i < n_element; i++)
+    // Read the other ones: Locate the records (one per line), which can
+    // then be parsed independently of each other
+    Vector<const char*> record_pt;
+    infile.get_record_lines(n_element - 1, record_pt);
+    const char* end_pt = infile.end_pt();
+    long n_record = n_element - 1;
+    bool parse_error = false;
+#ifdef _OPENMP
+    bool use_threads = ThreadingHelpers::use_threads(n_record);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long i = 0; i < n_record; i++)
     {
-      for (unsigned j = 0; j < nnod_el; j++)
+      // Exceptions mustn't escape from the parallel region
+      try
       {
-        infile >> global_node[k];
-        k++;
+        const char* pt = record_pt[i];
+        for (unsigned j = 0; j < nnod_el; j++)
+        {
+          global_node[(i + 1) * nnod_el + j] =
+            MappedTextFile::parse_unsigned(pt, end_pt);
+        }
+      }
+      catch (OomphLibError&)
+      {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        parse_error = true;
       }
-      infile.getline(dummy, 100);
     }
 
-
     // Create storage for coordinates
     Vector<double> x_node(n_node);
     Vector<double> y_node(n_node);
     Vector<double> z_node(n_node);
 
-    // Get nodal coordinates
-    for (unsigned i = 0; i < n_node; i++)
+    // Get nodal coordinates (one node per line)
+    infile.get_record_lines(n_node, record_pt);
+    n_record = n_node;
+#ifdef _OPENMP
+    use_threads = ThreadingHelpers::use_threads(n_record);
+#pragma omp parallel for if (use_threads)
+#endif
+    for (long i = 0; i < n_record; i++)
     {
-      infile >> x_node[i];
-      infile >> y_node[i];
-      infile >> z_node[i];
+      // Exceptions mustn't escape from the parallel region
+      try
+      {
+        const char* pt = record_pt[i];
+        x_node[i] = MappedTextFile::parse_double(pt, end_pt);
+        y_node[i] = MappedTextFile::parse_double(pt, end_pt);
+        z_node[i] = MappedTextFile::parse_double(pt, end_pt);
+      }
+      catch (OomphLibError&)
+      {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        parse_error = true;
+      }
+    }
+    if (parse_error)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Failed to parse " << xda_file_name << "\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
     }
+    record_pt.clear();
 
 
     // Read in boundaries for faces
@@ -179,13 +229,13 @@ namespace oomph
     for (unsigned i = 0; i < n_bound_face; i++)
     {
       // Number of the element
-      infile >> element_nmbr;
+      element_nmbr = infile.read_unsigned();
 
       // Which side/face on the tet are we dealing with (xda enumeratation)?
-      infile >> side_nmbr;
+      side_nmbr = infile.read_unsigned();
 
       // What's the boundary ID?
-      infile >> bound_id;
+      bound_id = infile.read_unsigned();
 
       // Turn into zero-based oomph-lib mesh boundary id
       unsigned oomph_lib_bound_id = bound_id - 1;
@@ -154,6 +154,21 @@ namespace oomph
     }
 
 
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points. Broken virtual (as scalar_value_paraview(...)); overloaded
+    /// to resolve the ambiguity between the versions in the underlying
+    /// elements.
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      throw OomphLibError(
+        "This function hasn't been implemented for this element",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names.
@@ -886,6 +901,21 @@ namespace oomph
     }
 
 
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points. Broken virtual (as scalar_value_paraview(...)); overloaded
+    /// to resolve the ambiguity between the versions in the underlying
+    /// elements.
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+      throw OomphLibError(
+        "This function hasn't been implemented for this element",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names.
@@ -0,0 +1,684 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#include "augmented_lagrangian_preconditioner.h"
+
+namespace oomph
+{
+  //===========================================================================
+  /// Setup the augmented Lagrangian preconditioner: Extract the blocks,
+  /// assemble the inverse pressure mass matrix diagonal W^{-1}, form the
+  /// augmented velocity blocks F_aug = F - gamma G W^{-1} D (as replacement
+  /// dof blocks, so subsidiary block preconditioners see them too) and
+  /// set up the preconditioner for F_aug.
+  //===========================================================================
+  void AugmentedLagrangianNavierStokesPreconditioner::setup()
+  {
+    // Make sure any old data is deleted
+    clean_up_memory();
+
+#ifdef PARANOID
+    // paranoid check that the navier stokes mesh pt has been set
+    if (Navier_stokes_mesh_pt == 0)
+    {
+      std::ostringstream error_message;
+      error_message << "The navier stokes elements mesh pointer must be set.\n"
+                    << "Use method set_navier_stokes_mesh(...)";
+      throw OomphLibError(
+        error_message.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    if (dynamic_cast<CRDoubleMatrix*>(matrix_pt()) == 0)
+    {
+      std::ostringstream error_message;
+      error_message
+        << "AugmentedLagrangianNavierStokesPreconditioner only works with "
+        << "CRDoubleMatrix matrices" << std::endl;
+      throw OomphLibError(
+        error_message.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Set the mesh
+    this->set_nmesh(1);
+    this->set_mesh(0,
+                   Navier_stokes_mesh_pt,
+                   Allow_multiple_element_type_in_navier_stokes_mesh);
+
+    // Set up the block look up schemes: all velocity dof types are
+    // combined into block 0, the pressure forms block 1
+    double t_block_setup_start = TimingHelpers::timer();
+    unsigned ndof_types = 0;
+    if (this->is_subsidiary_block_preconditioner())
+    {
+      ndof_types = this->ndof_types();
+    }
+    else
+    {
+      ndof_types = this->ndof_types_in_mesh(0);
+    }
+    const unsigned n_velocity_dof_types = ndof_types - 1;
+    const unsigned pressure_dof_type = ndof_types - 1;
+
+    Vector<unsigned> dof_to_block_map(ndof_types, 0);
+    dof_to_block_map[pressure_dof_type] = 1;
+    this->block_setup(dof_to_block_map);
+
+    double t_block_setup_finish = TimingHelpers::timer();
+    if (Doc_time)
+    {
+      oomph_info << "Time for block_setup(...) [sec]: "
+                 << t_block_setup_finish - t_block_setup_start << "\n";
+    }
+
+    // Inverse pressure mass matrix diagonal
+    // -------------------------------------
+    double t_augment_start = TimingHelpers::timer();
+    assemble_inv_press_mass_matrix_diagonal();
+
+    // Build W^{-1} as a diagonal matrix
+    const LinearAlgebraDistribution* p_dist_pt =
+      this->block_distribution_pt(1);
+    unsigned p_nrow_local = p_dist_pt->nrow_local();
+    unsigned p_first_row = p_dist_pt->first_row();
+    Vector<int> inv_w_column_indices(p_nrow_local);
+    Vector<int> inv_w_row_start(p_nrow_local + 1);
+    for (unsigned i = 0; i < p_nrow_local; i++)
+    {
+      inv_w_column_indices[i] = p_first_row + i;
+      inv_w_row_start[i] = i;
+    }
+    inv_w_row_start[p_nrow_local] = p_nrow_local;
+    CRDoubleMatrix inv_w(p_dist_pt);
+    inv_w.build(p_dist_pt->nrow(),
+                Inv_w_diag_values,
+                inv_w_column_indices,
+                inv_w_row_start);
+
+    // Augment the velocity blocks
+    // ---------------------------
+    // Get the dof-level momentum blocks F_ij and the products
+    // G_i W^{-1} D_j. (Ignore any replacement blocks left from a previous
+    // setup.)
+    DenseMatrix<CRDoubleMatrix*> f_pt(
+      n_velocity_dof_types, n_velocity_dof_types, 0);
+    DenseMatrix<CRDoubleMatrix*> aug_pt(
+      n_velocity_dof_types, n_velocity_dof_types, 0);
+    {
+      Vector<CRDoubleMatrix*> g_inv_w_pt(n_velocity_dof_types, 0);
+      Vector<CRDoubleMatrix*> d_pt(n_velocity_dof_types, 0);
+      for (unsigned i = 0; i < n_velocity_dof_types; i++)
+      {
+        CRDoubleMatrix g_i;
+        this->get_dof_level_block(i, pressure_dof_type, g_i, true);
+        g_inv_w_pt[i] = new CRDoubleMatrix;
+        g_i.multiply(inv_w, *g_inv_w_pt[i]);
+
+        d_pt[i] = new CRDoubleMatrix;
+        this->get_dof_level_block(pressure_dof_type, i, *d_pt[i], true);
+      }
+
+      for (unsigned i = 0; i < n_velocity_dof_types; i++)
+      {
+        for (unsigned j = 0; j < n_velocity_dof_types; j++)
+        {
+          f_pt(i, j) = new CRDoubleMatrix;
+          this->get_dof_level_block(i, j, *f_pt(i, j), true);
+          aug_pt(i, j) = new CRDoubleMatrix;
+          g_inv_w_pt[i]->multiply(*d_pt[j], *aug_pt(i, j));
+        }
+      }
+
+      for (unsigned i = 0; i < n_velocity_dof_types; i++)
+      {
+        delete g_inv_w_pt[i];
+        delete d_pt[i];
+      }
+    }
+
+    // Choose gamma so the augmentation is as big as the momentum block
+    if (Use_norm_f_for_gamma)
+    {
+      double aug_norm = CRDoubleMatrixHelpers::inf_norm(aug_pt);
+#ifdef PARANOID
+      if (aug_norm == 0.0)
+      {
+        std::ostringstream error_message;
+        error_message << "The augmentation G W^{-1} D vanishes; "
+                      << "is there a pressure block?" << std::endl;
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      Gamma = CRDoubleMatrixHelpers::inf_norm(f_pt) / aug_norm;
+    }
+
+    // F_aug = F - gamma G W^{-1} D; store it (in aug_pt) as replacement
+    // dof blocks
+    for (unsigned i = 0; i < n_velocity_dof_types; i++)
+    {
+      for (unsigned j = 0; j < n_velocity_dof_types; j++)
+      {
+        double* value_pt = aug_pt(i, j)->value();
+        unsigned long nnz = aug_pt(i, j)->nnz();
+        for (unsigned long k = 0; k < nnz; k++)
+        {
+          value_pt[k] *= -Gamma;
+        }
+        f_pt(i, j)->add(*aug_pt(i, j), *aug_pt(i, j));
+        delete f_pt(i, j);
+        f_pt(i, j) = 0;
+
+        this->set_replacement_dof_block(i, j, aug_pt(i, j));
+      }
+    }
+
+    double t_augment_finish = TimingHelpers::timer();
+    if (Doc_time)
+    {
+      oomph_info << "Time to form augmented velocity block [sec]: "
+                 << t_augment_finish - t_augment_start
+                 << " (gamma = " << Gamma << ")\n";
+    }
+
+    // Matrix vector product with the gradient matrix G
+    CRDoubleMatrix* g_pt = new CRDoubleMatrix;
+    this->get_block(0, 1, *g_pt);
+    G_mat_vec_pt = new MatrixVectorProduct;
+    this->setup_matrix_vector_product(G_mat_vec_pt, g_pt, 1);
+    delete g_pt;
+    g_pt = 0;
+
+    // Set up the preconditioner for the augmented velocity block
+    // ----------------------------------------------------------
+    double t_velocity_prec_start = TimingHelpers::timer();
+
+    // if the velocity preconditioner has not been set
+    if (Velocity_preconditioner_pt == 0)
+    {
+      Velocity_preconditioner_pt = new SuperLUPreconditioner;
+      Using_default_velocity_preconditioner = true;
+    }
+
+    BlockPreconditioner<CRDoubleMatrix>* velocity_block_prec_pt =
+      dynamic_cast<BlockPreconditioner<CRDoubleMatrix>*>(
+        Velocity_preconditioner_pt);
+    Velocity_preconditioner_is_block_preconditioner =
+      (velocity_block_prec_pt != 0);
+
+    if (Velocity_preconditioner_is_block_preconditioner)
+    {
+      // The subsidiary preconditioner deals with the velocity dof types
+      // (and extracts the replaced, augmented blocks itself)
+      Vector<unsigned> dof_map(n_velocity_dof_types);
+      for (unsigned i = 0; i < n_velocity_dof_types; i++)
+      {
+        dof_map[i] = i;
+      }
+      velocity_block_prec_pt->turn_into_subsidiary_block_preconditioner(
+        this, dof_map);
+      velocity_block_prec_pt->setup(matrix_pt());
+    }
+    else
+    {
+      // Note: This uses the replaced blocks.
+      CRDoubleMatrix* f_aug_pt = new CRDoubleMatrix;
+      this->get_block(0, 0, *f_aug_pt);
+      Velocity_preconditioner_pt->setup(f_aug_pt);
+      delete f_aug_pt;
+      f_aug_pt = 0;
+    }
+
+    double t_velocity_prec_finish = TimingHelpers::timer();
+    if (Doc_time)
+    {
+      oomph_info << "Velocity sub-preconditioner setup time [sec]: "
+                 << t_velocity_prec_finish - t_velocity_prec_start << "\n";
+    }
+
+    // The replacement blocks are no longer needed
+    for (unsigned i = 0; i < n_velocity_dof_types; i++)
+    {
+      for (unsigned j = 0; j < n_velocity_dof_types; j++)
+      {
+        delete aug_pt(i, j);
+        aug_pt(i, j) = 0;
+      }
+    }
+
+    // Remember that the preconditioner has been setup so
+    // the stored information can be wiped when we
+    // come here next...
+    Preconditioner_has_been_setup = true;
+  }
+
+
+  //=======================================================================
+  /// Apply preconditioner to r: Solve the block upper triangular system
+  /// for the augmented equations, i.e.
+  ///
+  ///   z_p = (nu + gamma) W^{-1} r_p
+  ///   z_u = F_aug^{-1} ( r_u - G ( z_p + gamma W^{-1} r_p ) )
+  ///
+  /// where the term gamma G W^{-1} r_p transforms the right hand side
+  /// of the momentum equations into that of the augmented system.
+  //=======================================================================
+  void AugmentedLagrangianNavierStokesPreconditioner::preconditioner_solve(
+    const DoubleVector& r, DoubleVector& z)
+  {
+#ifdef PARANOID
+    if (Preconditioner_has_been_setup == false)
+    {
+      std::ostringstream error_message;
+      error_message << "setup() must be called before using "
+                    << "preconditioner_solve()";
+      throw OomphLibError(
+        error_message.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    if (z.built())
+    {
+      if (z.nrow() != r.nrow())
+      {
+        std::ostringstream error_message;
+        error_message << "The vectors z and r must have the same number of "
+                      << "of global rows";
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+#endif
+
+    // if z is not setup then give it the same distribution
+    if (!z.distribution_pt()->built())
+    {
+      z.build(r.distribution_pt(), 0.0);
+    }
+
+    // Step 1 - apply approximate Schur inverse to pressure unknowns
+    // -------------------------------------------------------------
+    DoubleVector r_p;
+    this->get_block_vector(1, r, r_p);
+
+    // z_p = (nu + gamma) W^{-1} r_p, and (in r_p) the argument of G,
+    // z_p + gamma W^{-1} r_p = (nu + 2 gamma) W^{-1} r_p
+    DoubleVector z_p(r_p.distribution_pt(), 0.0);
+    unsigned p_nrow_local = r_p.nrow_local();
+    double* r_p_pt = r_p.values_pt();
+    double* z_p_pt = z_p.values_pt();
+    for (unsigned i = 0; i < p_nrow_local; i++)
+    {
+      double inv_w_r = Inv_w_diag_values[i] * r_p_pt[i];
+      z_p_pt[i] = (Viscosity + Gamma) * inv_w_r;
+      r_p_pt[i] = (Viscosity + 2.0 * Gamma) * inv_w_r;
+    }
+    this->return_block_vector(1, z_p, z);
+
+    // Step 2 - apply augmented velocity block inverse to velocity unknowns
+    // --------------------------------------------------------------------
+    DoubleVector g_r_p;
+    G_mat_vec_pt->multiply(r_p, g_r_p);
+
+    DoubleVector r_u;
+    this->get_block_vector(0, r, r_u);
+    r_u -= g_r_p;
+
+    // use some Preconditioner's preconditioner solve
+    // and return
+    if (Velocity_preconditioner_is_block_preconditioner)
+    {
+      this->return_block_vector(0, r_u, z);
+      Velocity_preconditioner_pt->preconditioner_solve(z, z);
+    }
+    else
+    {
+      DoubleVector z_u;
+      Velocity_preconditioner_pt->preconditioner_solve(r_u, z_u);
+      this->return_block_vector(0, z_u, z);
+    }
+  }
+
+
+  //========================================================================
+  /// Helper function to assemble the inverse diagonal of the pressure
+  /// mass matrix from the elemental contributions defined in
+  /// NavierStokesElementWithDiagonalMassMatrices::
+  /// get_pressure_and_velocity_mass_matrix_diagonal(...). As in
+  /// NavierStokesSchurComplementPreconditioner::
+  /// assemble_inv_press_and_veloc_mass_matrix_diagonal(...), only the
+  /// rows of the pressure block stored on this processor are assembled:
+  /// Contributions to global equations for which this processor holds
+  /// the block lookup data are classified (i.e. mapped to their index in
+  /// the pressure block) here and sent to the processor that holds the
+  /// corresponding row of the pressure block; all other contributions
+  /// are first sent to the processor that can classify them (the one
+  /// that holds the equation in the master distribution).
+  //========================================================================
+  void AugmentedLagrangianNavierStokesPreconditioner::
+    assemble_inv_press_mass_matrix_diagonal()
+  {
+    // Storage for the (local rows of the) pressure mass matrix diagonal
+    const LinearAlgebraDistribution* p_dist_pt =
+      this->block_distribution_pt(1);
+    unsigned p_nrow_local = p_dist_pt->nrow_local();
+    Vector<double> p_values(p_nrow_local, 0.0);
+
+    // The global equations for which we have the block lookup data
+    const LinearAlgebraDistribution* master_dist_pt =
+      this->master_distribution_pt();
+    unsigned first_lookup_row = master_dist_pt->first_row();
+    unsigned end_lookup_row = first_lookup_row + master_dist_pt->nrow_local();
+
+    // Are the elements distributed (if not, every processor holds all
+    // elements and only deals with the equations it has the lookup data
+    // for)?
+    bool distributed = false;
+    unsigned n_proc = 1;
+#ifdef OOMPH_HAS_MPI
+    distributed = this->any_mesh_distributed();
+    n_proc = this->comm_pt()->nproc();
+#endif
+
+    // Classified contributions (and their indices in the pressure block)
+    // for the processors that hold the rows of the pressure block
+    Vector<Vector<double>> classified_values_send(n_proc);
+    Vector<Vector<unsigned>> classified_indices_send(n_proc);
+
+    // Unclassified contributions (and their global equation numbers) for
+    // the processors that hold the lookup data
+    Vector<Vector<double>> unclassified_values_send(n_proc);
+    Vector<Vector<unsigned>> unclassified_eqns_send(n_proc);
+
+    // get the contribution for each element
+    unsigned n_el = Navier_stokes_mesh_pt->nelement();
+    for (unsigned e = 0; e < n_el; e++)
+    {
+      GeneralisedElement* el_pt = Navier_stokes_mesh_pt->element_pt(e);
+
+#ifdef OOMPH_HAS_MPI
+      // Halo elements are dealt with by the processors that own them
+      if (distributed && el_pt->is_halo())
+      {
+        continue;
+      }
+#endif
+
+      // Elements that are not Navier-Stokes elements (e.g. flux control
+      // elements) don't contribute to the pressure mass matrix
+      NavierStokesElementWithDiagonalMassMatrices* cast_el_pt =
+        dynamic_cast<NavierStokesElementWithDiagonalMassMatrices*>(el_pt);
+      if (cast_el_pt == 0)
+      {
+        continue;
+      }
+
+      unsigned el_dof = el_pt->ndof();
+      Vector<double> el_pmm_diagonal(el_dof, 0.0);
+      Vector<double> el_vmm_diagonal(el_dof, 0.0);
+      cast_el_pt->get_pressure_and_velocity_mass_matrix_diagonal(
+        el_pmm_diagonal, el_vmm_diagonal, 1);
+      for (unsigned i = 0; i < el_dof; i++)
+      {
+        // Only the pressure dofs have (nonzero) entries
+        if (el_pmm_diagonal[i] == 0.0)
+        {
+          continue;
+        }
+        unsigned eqn_number = el_pt->eqn_number(i);
+        if ((eqn_number >= first_lookup_row) && (eqn_number < end_lookup_row))
+        {
+          classify_press_mass_matrix_contribution(eqn_number,
+                                                  el_pmm_diagonal[i],
+                                                  p_values,
+                                                  classified_values_send,
+                                                  classified_indices_send);
+        }
+        else if (distributed)
+        {
+          unsigned p = master_dist_pt->rank_of_global_row(eqn_number);
+          unclassified_values_send[p].push_back(el_pmm_diagonal[i]);
+          unclassified_eqns_send[p].push_back(eqn_number);
+        }
+      }
+    }
+
+#ifdef OOMPH_HAS_MPI
+    if (n_proc > 1)
+    {
+      // Send the unclassified contributions to the processors that hold
+      // their lookup data and classify them there...
+      Vector<double> values_recv;
+      Vector<unsigned> indices_recv;
+      exchange_press_mass_matrix_contributions(unclassified_values_send,
+                                               unclassified_eqns_send,
+                                               values_recv,
+                                               indices_recv);
+      unsigned n_recv = values_recv.size();
+      for (unsigned k = 0; k < n_recv; k++)
+      {
+        classify_press_mass_matrix_contribution(indices_recv[k],
+                                                values_recv[k],
+                                                p_values,
+                                                classified_values_send,
+                                                classified_indices_send);
+      }
+
+      // ...then send all classified contributions to the processors that
+      // hold the rows of the pressure block
+      exchange_press_mass_matrix_contributions(classified_values_send,
+                                               classified_indices_send,
+                                               values_recv,
+                                               indices_recv);
+      unsigned p_first_row = p_dist_pt->first_row();
+      n_recv = values_recv.size();
+      for (unsigned k = 0; k < n_recv; k++)
+      {
+        p_values[indices_recv[k] - p_first_row] += values_recv[k];
+      }
+    }
+#endif
+
+    // ...and invert
+    Inv_w_diag_values.resize(p_nrow_local);
+    for (unsigned i = 0; i < p_nrow_local; i++)
+    {
+#ifdef PARANOID
+      if (p_values[i] == 0.0)
+      {
+        std::ostringstream error_message;
+        error_message << "Zero entry in diagonal of pressure mass matrix\n"
+                      << "Index: " << i << std::endl;
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      Inv_w_diag_values[i] = 1.0 / p_values[i];
+    }
+  }
+
+
+  //========================================================================
+  /// Helper function for assemble_inv_press_mass_matrix_diagonal():
+  /// Classify the contribution to the pressure mass matrix diagonal for
+  /// the global equation eqn_number (for which this processor must hold
+  /// the block lookup data): Add it to p_values if the corresponding row
+  /// of the pressure block is stored on this processor; otherwise store
+  /// it (and its index in the pressure block) in values_send[p] and
+  /// indices_send[p] for the processor p that holds the row.
+  //========================================================================
+  void AugmentedLagrangianNavierStokesPreconditioner::
+    classify_press_mass_matrix_contribution(
+      const unsigned& eqn_number,
+      const double& contribution,
+      Vector<double>& p_values,
+      Vector<Vector<double>>& values_send,
+      Vector<Vector<unsigned>>& indices_send)
+  {
+    // Only deal with pressure dofs
+    if (this->block_number(eqn_number) != 1)
+    {
+      return;
+    }
+
+    unsigned index = this->index_in_block(eqn_number);
+    const LinearAlgebraDistribution* p_dist_pt =
+      this->block_distribution_pt(1);
+    unsigned p = 0;
+    unsigned my_rank = 0;
+#ifdef OOMPH_HAS_MPI
+    my_rank = this->comm_pt()->my_rank();
+    p = my_rank;
+    if (p_dist_pt->distributed())
+    {
+      p = p_dist_pt->rank_of_global_row(index);
+    }
+#endif
+    if (p == my_rank)
+    {
+      p_values[index - p_dist_pt->first_row()] += contribution;
+    }
+    else
+    {
+      values_send[p].push_back(contribution);
+      indices_send[p].push_back(index);
+    }
+  }
+
+
+#ifdef OOMPH_HAS_MPI
+  //========================================================================
+  /// Helper function for assemble_inv_press_mass_matrix_diagonal(): Send
+  /// the contributions values_send[p] (and their indices indices_send[p])
+  /// to processor p and return the contributions (and indices) received
+  /// from all other processors in values_recv and indices_recv. The send
+  /// buffers are wiped.
+  //========================================================================
+  void AugmentedLagrangianNavierStokesPreconditioner::
+    exchange_press_mass_matrix_contributions(
+      Vector<Vector<double>>& values_send,
+      Vector<Vector<unsigned>>& indices_send,
+      Vector<double>& values_recv,
+      Vector<unsigned>& indices_recv)
+  {
+    int n_proc = this->comm_pt()->nproc();
+    int my_rank = this->comm_pt()->my_rank();
+
+    // Flat-pack the data to be sent (nothing to ourselves)
+    Vector<int> send_n(n_proc, 0);
+    Vector<int> send_displacement(n_proc, 0);
+    Vector<double> flat_values_send;
+    Vector<unsigned> flat_indices_send;
+    for (int p = 0; p < n_proc; p++)
+    {
+      send_displacement[p] = flat_values_send.size();
+      if (p != my_rank)
+      {
+        send_n[p] = values_send[p].size();
+        flat_values_send.insert(
+          flat_values_send.end(), values_send[p].begin(), values_send[p].end());
+        flat_indices_send.insert(flat_indices_send.end(),
+                                 indices_send[p].begin(),
+                                 indices_send[p].end());
+      }
+      values_send[p].clear();
+      indices_send[p].clear();
+    }
+
+    // Tell everybody how much they'll receive from us
+    Vector<int> recv_n(n_proc, 0);
+    MPI_Alltoall(&send_n[0],
+                 1,
+                 MPI_INT,
+                 &recv_n[0],
+                 1,
+                 MPI_INT,
+                 this->comm_pt()->mpi_comm());
+    Vector<int> recv_displacement(n_proc, 0);
+    int n_recv_total = 0;
+    for (int p = 0; p < n_proc; p++)
+    {
+      recv_displacement[p] = n_recv_total;
+      n_recv_total += recv_n[p];
+    }
+
+    // Exchange the data (pad the buffers to avoid taking the address of
+    // the first entry of an empty vector)
+    flat_values_send.push_back(0.0);
+    flat_indices_send.push_back(0);
+    values_recv.resize(n_recv_total + 1);
+    indices_recv.resize(n_recv_total + 1);
+    MPI_Alltoallv(&flat_values_send[0],
+                  &send_n[0],
+                  &send_displacement[0],
+                  MPI_DOUBLE,
+                  &values_recv[0],
+                  &recv_n[0],
+                  &recv_displacement[0],
+                  MPI_DOUBLE,
+                  this->comm_pt()->mpi_comm());
+    MPI_Alltoallv(&flat_indices_send[0],
+                  &send_n[0],
+                  &send_displacement[0],
+                  MPI_UNSIGNED,
+                  &indices_recv[0],
+                  &recv_n[0],
+                  &recv_displacement[0],
+                  MPI_UNSIGNED,
+                  this->comm_pt()->mpi_comm());
+    values_recv.resize(n_recv_total);
+    indices_recv.resize(n_recv_total);
+  }
+#endif
+
+
+  //=========================================================================
+  /// Helper function to delete preconditioner data.
+  //=========================================================================
+  void AugmentedLagrangianNavierStokesPreconditioner::clean_up_memory()
+  {
+    if (Preconditioner_has_been_setup)
+    {
+      // delete matvecs
+      delete G_mat_vec_pt;
+      G_mat_vec_pt = 0;
+
+      // delete stuff from velocity solve
+      if (Using_default_velocity_preconditioner)
+      {
+        delete Velocity_preconditioner_pt;
+        Velocity_preconditioner_pt = 0;
+      }
+
+      Inv_w_diag_values.clear();
+
+      // Wipe the (now dangling) replacement blocks etc.
+      this->clear_block_preconditioner_base();
+
+      Preconditioner_has_been_setup = false;
+    }
+  }
+
+} // namespace oomph
@@ -0,0 +1,326 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#ifndef OOMPH_AUGMENTED_LAGRANGIAN_PRECONDITIONER_HEADER
+#define OOMPH_AUGMENTED_LAGRANGIAN_PRECONDITIONER_HEADER
+
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+// oomphlib headers
+#include "../generic/matrices.h"
+#include "../generic/block_preconditioner.h"
+#include "../generic/preconditioner.h"
+#include "../generic/SuperLU_preconditioner.h"
+#include "../generic/matrix_vector_product.h"
+#include "navier_stokes_elements.h"
+
+namespace oomph
+{
+  //==========================================================================
+  /// \short Augmented Lagrangian (grad-div) preconditioner for the
+  /// Navier-Stokes equations, discretised with elements of type
+  /// NavierStokesElementWithDiagonalMassMatrices (ideally with
+  /// discontinuous pressures, e.g. QCrouzeixRaviartElements).
+  ///
+  /// The linearised Jacobian takes the block form
+  ///
+  /// | F | G |
+  /// |---|---|
+  /// | D | 0 |
+  ///
+  /// where F is the momentum block, G the discrete gradient and D the
+  /// discrete divergence operator. We precondition the equivalent,
+  /// augmented system that is obtained by subtracting gamma G W^{-1}
+  /// times the continuity equation from the momentum equation, where
+  /// W is the diagonal of the pressure mass matrix. Its momentum block,
+  ///
+  ///   F_aug = F - gamma G W^{-1} D,
+  ///
+  /// is the algebraic counterpart of grad-div stabilisation. The
+  /// preconditioner takes the block upper triangular form
+  ///
+  /// | F_aug | G |
+  /// |-------|---|
+  /// |   0   | S |
+  ///
+  /// where S = W / (nu + gamma) and nu is the (dimensionless) viscosity,
+  /// which is 1 in oomph-lib's non-dimensionalisation. For sufficiently
+  /// large gamma this approximation of the Schur complement becomes
+  /// independent of the Reynolds number and the mesh size. [The minus
+  /// signs reflect the fact that oomph-lib's Navier-Stokes Jacobian is
+  /// the negative of the one normally used in the literature.]
+  ///
+  /// The linear systems involving F_aug can be solved "exactly" by
+  /// SuperLU (the default) or by any other Preconditioner (inexact
+  /// solver) specified via set_velocity_preconditioner(...). If this is
+  /// a block preconditioner it operates on the velocity dof types of
+  /// the augmented system.
+  ///
+  /// NOTE: The robustness with respect to the Reynolds number and the
+  /// mesh size relies on a large gamma, and F_aug becomes increasingly
+  /// ill-conditioned as gamma grows. Only the (default) exact solve with
+  /// SuperLU retains the robustness for large gamma: standard
+  /// (component-wise or scalar) algebraic multigrid methods deteriorate
+  /// as gamma increases because the grad-div term couples the velocity
+  /// components and has a large kernel (the discretely divergence-free
+  /// fields). A gamma-robust multigrid would require smoothers and
+  /// transfer operators that capture this kernel; no such (inexact)
+  /// solver for F_aug is provided here.
+  //==========================================================================
+  class AugmentedLagrangianNavierStokesPreconditioner
+    : public BlockPreconditioner<CRDoubleMatrix>
+  {
+  public:
+    /// Constructor - sets defaults for control flags
+    AugmentedLagrangianNavierStokesPreconditioner()
+      : BlockPreconditioner<CRDoubleMatrix>()
+    {
+      // Pick gamma such that the augmentation is as big as the
+      // momentum block
+      Use_norm_f_for_gamma = true;
+      Gamma = 1.0;
+
+      // Dimensionless viscosity
+      Viscosity = 1.0;
+
+      // By default we use SuperLU for the velocity block
+      Velocity_preconditioner_pt = 0;
+      Using_default_velocity_preconditioner = true;
+      Velocity_preconditioner_is_block_preconditioner = false;
+
+      // null the G matrix vector product helper
+      G_mat_vec_pt = 0;
+
+      Navier_stokes_mesh_pt = 0;
+      Allow_multiple_element_type_in_navier_stokes_mesh = false;
+
+      Preconditioner_has_been_setup = false;
+      Doc_time = false;
+    }
+
+    /// Destructor
+    virtual ~AugmentedLagrangianNavierStokesPreconditioner()
+    {
+      clean_up_memory();
+    }
+
+    /// Broken copy constructor
+    AugmentedLagrangianNavierStokesPreconditioner(
+      const AugmentedLagrangianNavierStokesPreconditioner&)
+    {
+      BrokenCopy::broken_copy("AugmentedLagrangianNavierStokesPreconditioner");
+    }
+
+    /// Broken assignment operator
+    void operator=(const AugmentedLagrangianNavierStokesPreconditioner&)
+    {
+      BrokenCopy::broken_assign(
+        "AugmentedLagrangianNavierStokesPreconditioner");
+    }
+
+    /// Setup the preconditioner
+    void setup();
+
+    /// \short for some reason we have to remind the compiler that there is a
+    /// setup() function in Preconditioner base class.
+    using Preconditioner::setup;
+
+    /// Apply preconditioner to Vector r
+    void preconditioner_solve(const DoubleVector& r, DoubleVector& z);
+
+    /// \short Specify the mesh containing the block-preconditionable
+    /// Navier-Stokes elements. The optional argument indicates if there
+    /// are multiple types of elements in the same mesh.
+    void set_navier_stokes_mesh(
+      Mesh* mesh_pt,
+      const bool& allow_multiple_element_type_in_navier_stokes_mesh = false)
+    {
+      Navier_stokes_mesh_pt = mesh_pt;
+      Allow_multiple_element_type_in_navier_stokes_mesh =
+        allow_multiple_element_type_in_navier_stokes_mesh;
+    }
+
+    /// \short Set the augmentation parameter gamma. This also switches off
+    /// the automatic choice via the infinity norms of the blocks.
+    void set_gamma(const double& gamma)
+    {
+#ifdef PARANOID
+      if (gamma <= 0.0)
+      {
+        std::ostringstream error_message;
+        error_message << "The augmentation parameter has to be positive "
+                      << "but gamma = " << gamma << std::endl;
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      Gamma = gamma;
+      Use_norm_f_for_gamma = false;
+    }
+
+    /// \short Choose gamma = ||F||_inf / ||G W^{-1} D||_inf in every
+    /// setup, so the augmentation grows with the Reynolds number
+    /// (default).
+    void use_norm_f_for_gamma()
+    {
+      Use_norm_f_for_gamma = true;
+    }
+
+    /// \short Read (const) function to get gamma (as used in the most
+    /// recent setup if it is computed from the norms)
+    double gamma() const
+    {
+      return Gamma;
+    }
+
+    /// \short Set the dimensionless viscosity nu in the Schur complement
+    /// approximation S = W / (nu + gamma); defaults to 1 (appropriate
+    /// for oomph-lib's non-dimensionalisation with unit viscosity ratio)
+    void set_viscosity(const double& viscosity)
+    {
+      Viscosity = viscosity;
+    }
+
+    /// \short Set a new preconditioner (inexact solver) for the augmented
+    /// velocity block. It is not deleted by this class.
+    void set_velocity_preconditioner(Preconditioner* new_velocity_prec_pt)
+    {
+      // If the default preconditioner has been used
+      // clean it up now...
+      if (Using_default_velocity_preconditioner)
+      {
+        delete Velocity_preconditioner_pt;
+      }
+      Velocity_preconditioner_pt = new_velocity_prec_pt;
+      Using_default_velocity_preconditioner = false;
+    }
+
+    ///\short Function to (re-)set the preconditioner (inexact solver) for
+    /// the augmented velocity block to SuperLU
+    void set_velocity_superlu_preconditioner()
+    {
+      if (!Using_default_velocity_preconditioner)
+      {
+        Velocity_preconditioner_pt = new SuperLUPreconditioner;
+        Using_default_velocity_preconditioner = true;
+      }
+    }
+
+    /// Enable documentation of time
+    void enable_doc_time()
+    {
+      Doc_time = true;
+    }
+
+    /// Disable documentation of time
+    void disable_doc_time()
+    {
+      Doc_time = false;
+    }
+
+    /// \short Helper function to delete preconditioner data.
+    void clean_up_memory();
+
+  private:
+    /// \short Helper function to assemble the inverse diagonal of the
+    /// pressure mass matrix (for the pressure dofs in block 1 that are
+    /// stored on this processor).
+    void assemble_inv_press_mass_matrix_diagonal();
+
+    /// \short Helper function for assemble_inv_press_mass_matrix_diagonal():
+    /// Add the contribution for the global equation eqn_number (whose
+    /// block lookup data must be stored on this processor) to p_values,
+    /// or store it (with its index in the pressure block) in
+    /// values_send[p] and indices_send[p] if the row of the pressure block
+    /// is stored on processor p.
+    void classify_press_mass_matrix_contribution(
+      const unsigned& eqn_number,
+      const double& contribution,
+      Vector<double>& p_values,
+      Vector<Vector<double>>& values_send,
+      Vector<Vector<unsigned>>& indices_send);
+
+#ifdef OOMPH_HAS_MPI
+    /// \short Helper function for assemble_inv_press_mass_matrix_diagonal():
+    /// Send values_send[p] and indices_send[p] to processor p (wiping
+    /// them) and return the data received from all other processors.
+    void exchange_press_mass_matrix_contributions(
+      Vector<Vector<double>>& values_send,
+      Vector<Vector<unsigned>>& indices_send,
+      Vector<double>& values_recv,
+      Vector<unsigned>& indices_recv);
+#endif
+
+    /// Pointer to the 'preconditioner' for the augmented velocity block
+    Preconditioner* Velocity_preconditioner_pt;
+
+    /// flag indicating whether the default velocity preconditioner is used
+    bool Using_default_velocity_preconditioner;
+
+    /// \short Boolean indicating whether the velocity preconditioner
+    /// is a block preconditioner
+    bool Velocity_preconditioner_is_block_preconditioner;
+
+    /// MatrixVectorProduct operator for G
+    MatrixVectorProduct* G_mat_vec_pt;
+
+    /// \short Inverse diagonal of the pressure mass matrix (local rows
+    /// of the pressure block)
+    Vector<double> Inv_w_diag_values;
+
+    /// The augmentation parameter
+    double Gamma;
+
+    /// \short Flag to indicate if gamma is computed from the infinity
+    /// norms of the momentum block and the augmentation
+    bool Use_norm_f_for_gamma;
+
+    /// The dimensionless viscosity
+    double Viscosity;
+
+    /// \short the pointer to the mesh of block preconditionable Navier
+    /// Stokes elements.
+    Mesh* Navier_stokes_mesh_pt;
+
+    /// \short Flag to indicate if there are multiple element types in the
+    /// Navier-Stokes mesh.
+    bool Allow_multiple_element_type_in_navier_stokes_mesh;
+
+    /// \short Control flag is true if the preconditioner has been setup
+    /// (used so we can wipe the data when the preconditioner is
+    /// called again)
+    bool Preconditioner_has_been_setup;
+
+    /// Set Doc_time to true for outputting results of timings
+    bool Doc_time;
+  };
+
+} // namespace oomph
+#endif
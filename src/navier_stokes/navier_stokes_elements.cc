@@ -59,6 +59,10 @@ namespace oomph
   template<unsigned DIM>
   Vector<double> NavierStokesEquations<DIM>::Default_Gravity_vector(DIM, 0.0);
 
+  /// Use the optimised assembly kernel (if the element provides one)?
+  template<unsigned DIM>
+  bool NavierStokesEquations<DIM>::Use_optimised_nst_kernel = true;
+
 
   //===================================================================
   /// Compute the diagonal of the velocity/pressure mass matrices.
@@ -1780,6 +1784,14 @@ namespace oomph
     // Return immediately if there are no dofs
     if (ndof() == 0) return;
 
+    // Use the element's optimised kernel if it has one
+    if (Use_optimised_nst_kernel && has_optimised_nst_kernel())
+    {
+      fill_in_optimised_residual_contribution_nst(
+        residuals, jacobian, mass_matrix, flag);
+      return;
+    }
+
     // Find out how many nodes there are
     unsigned n_node = nnode();
 
@@ -2077,6 +2089,385 @@ namespace oomph
     }
   }
 
+  //==============================================================
+  /// Compute the residuals for the Navier--Stokes equations
+  /// in elements with a fixed number of (velocity) nodes, NNODE, and
+  /// pressure dofs, NPRES; flag=1(or 0): do (or don't) compute the
+  /// Jacobian as well. flag=2: fill in the mass matrix too.
+  /// Same as fill_in_generic_residual_contribution_nst(...) but
+  /// the local equation numbers, nodal values and the timestepper
+  /// weights are extracted once per element; the shape functions (and
+  /// their derivatives) are premultiplied by the integration weight and
+  /// held in fixed-size arrays; and all the (velocity) entries in the
+  /// Jacobian associated with a given pair of nodes are computed
+  /// in one go.
+  //==============================================================
+  template<unsigned DIM>
+  template<unsigned NNODE, unsigned NPRES>
+  void NavierStokesEquations<DIM>::fill_in_fixed_size_residual_contribution_nst(
+    Vector<double>& residuals,
+    DenseMatrix<double>& jacobian,
+    DenseMatrix<double>& mass_matrix,
+    unsigned flag)
+  {
+#ifdef PARANOID
+    if ((nnode() != NNODE) || (npres_nst() != NPRES))
+    {
+      std::ostringstream error_stream;
+      error_stream << "Kernel is for elements with " << NNODE
+                   << " nodes and " << NPRES << " pressure dofs but\n"
+                   << "element has " << nnode() << " nodes and "
+                   << npres_nst() << " pressure dofs.\n";
+      throw OomphLibError(error_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Return immediately if there are no dofs
+    if (ndof() == 0) return;
+
+    // Get continuous time from timestepper of first node
+    double time = node_pt(0)->time_stepper_pt()->time_pt()->time();
+
+    // Get Physical Variables from Element
+    // Reynolds number must be multiplied by the density ratio
+    const double scaled_re = re() * density_ratio();
+    const double scaled_re_st = re_st() * density_ratio();
+    const double scaled_re_inv_fr = re_invfr() * density_ratio();
+    const double visc_ratio = viscosity_ratio();
+
+    // Local copies of the (scaled) gravity vector and the
+    // stress-divergence switch
+    double re_inv_fr_g[DIM];
+    double gamma[DIM];
+    const Vector<double>& G = g();
+    for (unsigned i = 0; i < DIM; i++)
+    {
+      re_inv_fr_g[i] = scaled_re_inv_fr * G[i];
+      gamma[i] = Gamma[i];
+    }
+
+    // Local equation numbers of the velocities and pressures
+    int u_local_eqn[NNODE][DIM];
+    int p_eqn[NPRES];
+
+    // Nodal velocities, positions, du/dt and mesh velocities
+    double u_nodal[NNODE][DIM];
+    double x_nodal[NNODE][DIM];
+    double dudt_nodal[NNODE][DIM];
+    double mesh_velocity_nodal[NNODE][DIM];
+
+    // Weight of the current value in the approximation of du/dt
+    double dudt_weight[NNODE];
+
+    // Pressure values
+    double p_value[NPRES];
+
+    // Extract the nodal data
+    for (unsigned l = 0; l < NNODE; l++)
+    {
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        const unsigned u_nodal_index = u_index_nst(i);
+        u_local_eqn[l][i] = nodal_local_eqn(l, u_nodal_index);
+        u_nodal[l][i] = raw_nodal_value(l, u_nodal_index);
+        x_nodal[l][i] = raw_nodal_position(l, i);
+        dudt_nodal[l][i] = du_dt_nst(l, i);
+        mesh_velocity_nodal[l][i] = 0.0;
+        if (!ALE_is_disabled)
+        {
+          mesh_velocity_nodal[l][i] = this->raw_dnodal_position_dt(l, i);
+        }
+      }
+      dudt_weight[l] = 0.0;
+      if (flag)
+      {
+        dudt_weight[l] = node_pt(l)->time_stepper_pt()->weight(1, 0);
+      }
+    }
+    for (unsigned l = 0; l < NPRES; l++)
+    {
+      p_eqn[l] = p_local_eqn(l);
+      p_value[l] = p_nst(l);
+    }
+
+    // Set up memory for the shape and test functions (and their
+    // derivatives) on the stack; the Shape/DShape objects only wrap it
+    double psif_storage[NNODE], testf_storage[NNODE];
+    double dpsifdx_storage[NNODE * DIM], dtestfdx_storage[NNODE * DIM];
+    Shape psif(psif_storage, NNODE), testf(testf_storage, NNODE);
+    DShape dpsifdx(dpsifdx_storage, NNODE, DIM);
+    DShape dtestfdx(dtestfdx_storage, NNODE, DIM);
+
+    // Set up memory for pressure shape and test functions
+    double psip_storage[NPRES], testp_storage[NPRES];
+    Shape psip(psip_storage, NPRES), testp(testp_storage, NPRES);
+
+    // Shape and test functions (and derivatives) premultiplied by
+    // the integration weight
+    double testf_w[NNODE];
+    double dpsifdx_w[NNODE][DIM];
+    double dtestfdx_w[NNODE][DIM];
+    double testp_w[NPRES];
+
+    // Number of integration points
+    unsigned n_intpt = integral_pt()->nweight();
+
+    // Set the Vector to hold local coordinates
+    Vector<double> s(DIM);
+
+    // Storage for position and body force (passed to user functions)
+    Vector<double> interpolated_x(DIM);
+    Vector<double> body_force(DIM);
+
+    // Loop over the integration points
+    for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+    {
+      // Assign values of s
+      for (unsigned i = 0; i < DIM; i++) s[i] = integral_pt()->knot(ipt, i);
+
+      // Get the integral weight
+      double w = integral_pt()->weight(ipt);
+
+      // Call the derivatives of the shape and test functions
+      double J = dshape_and_dtest_eulerian_at_knot_nst(
+        ipt, psif, dpsifdx, testf, dtestfdx);
+
+      // Call the pressure shape and test functions
+      pshape_nst(s, psip, testp);
+
+      // Premultiply the weights and the Jacobian
+      double W = w * J;
+
+      // Copy the (weighted) shape functions into the fixed-size arrays
+      for (unsigned l = 0; l < NNODE; l++)
+      {
+        testf_w[l] = testf[l] * W;
+        for (unsigned k = 0; k < DIM; k++)
+        {
+          dpsifdx_w[l][k] = dpsifdx(l, k) * W;
+          dtestfdx_w[l][k] = dtestfdx(l, k) * W;
+        }
+      }
+      for (unsigned l = 0; l < NPRES; l++)
+      {
+        testp_w[l] = testp[l] * W;
+      }
+
+      // Calculate local values of the pressure and velocity components
+      double interpolated_p = 0.0;
+      double interpolated_u[DIM];
+      double mesh_velocity[DIM];
+      double dudt[DIM];
+      double interpolated_dudx[DIM][DIM];
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        interpolated_u[i] = 0.0;
+        interpolated_x[i] = 0.0;
+        mesh_velocity[i] = 0.0;
+        dudt[i] = 0.0;
+        for (unsigned j = 0; j < DIM; j++)
+        {
+          interpolated_dudx[i][j] = 0.0;
+        }
+      }
+
+      // Calculate pressure
+      for (unsigned l = 0; l < NPRES; l++)
+      {
+        interpolated_p += p_value[l] * psip[l];
+      }
+
+      // Calculate velocities and derivatives
+      for (unsigned l = 0; l < NNODE; l++)
+      {
+        const double psi = psif[l];
+        for (unsigned i = 0; i < DIM; i++)
+        {
+          interpolated_u[i] += u_nodal[l][i] * psi;
+          interpolated_x[i] += x_nodal[l][i] * psi;
+          dudt[i] += dudt_nodal[l][i] * psi;
+          mesh_velocity[i] += mesh_velocity_nodal[l][i] * psi;
+          for (unsigned j = 0; j < DIM; j++)
+          {
+            interpolated_dudx[i][j] += u_nodal[l][i] * dpsifdx(l, j);
+          }
+        }
+      }
+
+      // Get the user-defined body force terms
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        body_force[i] = 0.0;
+      }
+      get_body_force_nst(time, ipt, s, interpolated_x, body_force);
+
+      // Get the user-defined source function
+      double source = get_source_nst(time, ipt, interpolated_x);
+
+      // Convective velocity (relative to the mesh)
+      double conv_velocity[DIM];
+      for (unsigned k = 0; k < DIM; k++)
+      {
+        conv_velocity[k] =
+          scaled_re * interpolated_u[k] - scaled_re_st * mesh_velocity[k];
+      }
+
+      // Pointwise contributions to the momentum residuals: f[i] multiplies
+      // the i-th test function; stress[i][k] its k-th derivative
+      double f[DIM];
+      double stress[DIM][DIM];
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        f[i] = body_force[i] + re_inv_fr_g[i] - scaled_re_st * dudt[i];
+        for (unsigned k = 0; k < DIM; k++)
+        {
+          f[i] -= conv_velocity[k] * interpolated_dudx[i][k];
+          stress[i][k] =
+            -visc_ratio *
+            (interpolated_dudx[i][k] + gamma[i] * interpolated_dudx[k][i]);
+        }
+        stress[i][i] += interpolated_p;
+      }
+
+
+      // MOMENTUM EQUATIONS
+      //------------------
+
+      // Loop over the test functions
+      for (unsigned l = 0; l < NNODE; l++)
+      {
+        // Loop over the velocity components
+        for (unsigned i = 0; i < DIM; i++)
+        {
+          int local_eqn = u_local_eqn[l][i];
+          if (local_eqn >= 0)
+          {
+            double residual = f[i] * testf_w[l];
+            for (unsigned k = 0; k < DIM; k++)
+            {
+              residual += stress[i][k] * dtestfdx_w[l][k];
+            }
+            residuals[local_eqn] += residual;
+          }
+        }
+
+        // CALCULATE THE JACOBIAN
+        if (flag)
+        {
+          // Loop over the velocity shape functions again
+          for (unsigned l2 = 0; l2 < NNODE; l2++)
+          {
+            // Contributions that are shared by all the velocity components:
+            // Laplacian, time-derivative and convective terms
+            double diag = 0.0;
+            double conv = 0.0;
+            for (unsigned k = 0; k < DIM; k++)
+            {
+              diag += visc_ratio * dpsifdx(l2, k) * dtestfdx_w[l][k];
+              conv += conv_velocity[k] * dpsifdx(l2, k);
+            }
+            diag += (scaled_re_st * dudt_weight[l2] * psif[l2] + conv) *
+                    testf_w[l];
+
+            // Mass matrix entry (if required)
+            double mass = scaled_re_st * psif[l2] * testf_w[l];
+
+            // Factor for the derivative of the convective term w.r.t.
+            // the convecting velocity
+            double re_psi_test = scaled_re * psif[l2] * testf_w[l];
+
+            for (unsigned i = 0; i < DIM; i++)
+            {
+              int local_eqn = u_local_eqn[l][i];
+              if (local_eqn < 0) continue;
+
+              for (unsigned i2 = 0; i2 < DIM; i2++)
+              {
+                int local_unknown = u_local_eqn[l2][i2];
+                if (local_unknown < 0) continue;
+
+                double jac_entry =
+                  visc_ratio * gamma[i] * dpsifdx(l2, i) * dtestfdx_w[l][i2] +
+                  re_psi_test * interpolated_dudx[i][i2];
+                if (i2 == i)
+                {
+                  jac_entry += diag;
+
+                  // Add the mass matrix term (only diagonal entries)
+                  // Note that this is positive because the mass matrix
+                  // is taken to the other side of the equation when
+                  // formulating the generalised eigenproblem.
+                  if (flag == 2)
+                  {
+                    mass_matrix(local_eqn, local_unknown) += mass;
+                  }
+                }
+                jacobian(local_eqn, local_unknown) -= jac_entry;
+              }
+            }
+          }
+
+          // Now loop over pressure shape functions
+          // This is the contribution from pressure gradient
+          for (unsigned l2 = 0; l2 < NPRES; l2++)
+          {
+            int local_unknown = p_eqn[l2];
+            if (local_unknown < 0) continue;
+            for (unsigned i = 0; i < DIM; i++)
+            {
+              int local_eqn = u_local_eqn[l][i];
+              if (local_eqn >= 0)
+              {
+                jacobian(local_eqn, local_unknown) +=
+                  psip[l2] * dtestfdx_w[l][i];
+              }
+            }
+          }
+        } // End of Jacobian calculation
+      } // End of loop over shape functions
+
+
+      // CONTINUITY EQUATION
+      //-------------------
+
+      // Divergence of the velocity minus the source
+      double aux = -source;
+      for (unsigned k = 0; k < DIM; k++)
+      {
+        aux += interpolated_dudx[k][k];
+      }
+
+      // Loop over the shape functions
+      for (unsigned l = 0; l < NPRES; l++)
+      {
+        int local_eqn = p_eqn[l];
+        if (local_eqn < 0) continue;
+
+        residuals[local_eqn] += aux * testp_w[l];
+
+        // CALCULATE THE JACOBIAN
+        if (flag)
+        {
+          for (unsigned l2 = 0; l2 < NNODE; l2++)
+          {
+            for (unsigned i2 = 0; i2 < DIM; i2++)
+            {
+              int local_unknown = u_local_eqn[l2][i2];
+              if (local_unknown >= 0)
+              {
+                jacobian(local_eqn, local_unknown) +=
+                  dpsifdx_w[l2][i2] * testp[l];
+              }
+            }
+          }
+        } // End of Jacobian calculation
+      } // End of loop over l
+    } // End of loop over integration points
+  }
+
+
   //==============================================================
   ///  Compute the derivatives of the residuals for the Navier--Stokes
   ///  equations with respect to a parameter;
@@ -2585,6 +2976,24 @@ namespace oomph
   }
 
 
+  //========================================================================
+  /// Optimised version of fill_in_generic_residual_contribution_nst(...):
+  /// 3^DIM velocity nodes and DIM+1 (discontinuous) pressure dofs.
+  //========================================================================
+  template<unsigned DIM>
+  void QCrouzeixRaviartElement<DIM>::
+    fill_in_optimised_residual_contribution_nst(
+      Vector<double>& residuals,
+      DenseMatrix<double>& jacobian,
+      DenseMatrix<double>& mass_matrix,
+      unsigned flag)
+  {
+    this->template fill_in_fixed_size_residual_contribution_nst<
+      (DIM == 2) ? 9 : 27,
+      DIM + 1>(residuals, jacobian, mass_matrix, flag);
+  }
+
+
   //=========================================================================
   ///  Add to the set \c paired_load_data pairs containing
   /// - the pointer to a Data object
@@ -2749,6 +3158,23 @@ namespace oomph
   template<>
   const unsigned QTaylorHoodElement<3>::Pconv[8] = {0, 2, 6, 8, 18, 20, 24, 26};
 
+
+  //========================================================================
+  /// Optimised version of fill_in_generic_residual_contribution_nst(...):
+  /// 3^DIM velocity nodes and 2^DIM (nodal) pressure dofs.
+  //========================================================================
+  template<unsigned DIM>
+  void QTaylorHoodElement<DIM>::fill_in_optimised_residual_contribution_nst(
+    Vector<double>& residuals,
+    DenseMatrix<double>& jacobian,
+    DenseMatrix<double>& mass_matrix,
+    unsigned flag)
+  {
+    this->template fill_in_fixed_size_residual_contribution_nst<
+      (DIM == 2) ? 9 : 27,
+      (DIM == 2) ? 4 : 8>(residuals, jacobian, mass_matrix, flag);
+  }
+
   //=========================================================================
   ///  Add to the set \c paired_load_data pairs containing
   /// - the pointer to a Data object
@@ -651,6 +651,43 @@ namespace oomph
       DenseMatrix<double>& mass_matrix,
       unsigned flag);
 
+    /// \short Does the element provide an optimised version of
+    /// fill_in_generic_residual_contribution_nst(...)? False by default.
+    virtual bool has_optimised_nst_kernel() const
+    {
+      return false;
+    }
+
+    /// \short Optimised version of fill_in_generic_residual_contribution_nst(
+    /// ...). Broken virtual; must be overloaded in elements for which
+    /// has_optimised_nst_kernel() returns true.
+    virtual void fill_in_optimised_residual_contribution_nst(
+      Vector<double>& residuals,
+      DenseMatrix<double>& jacobian,
+      DenseMatrix<double>& mass_matrix,
+      unsigned flag)
+    {
+      throw OomphLibError("No optimised kernel provided for this element.\n",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+
+    /// \short Version of fill_in_generic_residual_contribution_nst(...)
+    /// for elements with a fixed number of (velocity) nodes, NNODE, and
+    /// pressure dofs, NPRES. Equation numbers, nodal values and shape
+    /// functions are held in fixed-size arrays, the nodal data is
+    /// extracted once per element rather than once per integration point,
+    /// and the entries in the velocity block of the Jacobian are
+    /// assembled in a single pass over the pairs of nodes.
+    /// Flag=1 (or 0): do (or don't) compute the Jacobian as well.
+    /// Flag=2: Fill in mass matrix too.
+    template<unsigned NNODE, unsigned NPRES>
+    void fill_in_fixed_size_residual_contribution_nst(
+      Vector<double>& residuals,
+      DenseMatrix<double>& jacobian,
+      DenseMatrix<double>& mass_matrix,
+      unsigned flag);
+
 
     /// \short Compute the residuals for the associated pressure advection
     /// diffusion problem. Used by the Fp preconditioner.
@@ -703,6 +740,11 @@ namespace oomph
     // refineable navier--stokes
     static Vector<double> Gamma;
 
+    /// \short Static boolean flag to indicate if the optimised assembly
+    /// kernel is to be used (by all elements that provide one). Defaults
+    /// to true.
+    static bool Use_optimised_nst_kernel;
+
     // Access functions for the physical constants
 
     /// Reynolds number
@@ -926,6 +968,21 @@ namespace oomph
       ALE_is_disabled = false;
     }
 
+    /// \short Use the optimised assembly kernel for the residuals and
+    /// Jacobian in all elements that provide one (default).
+    static void enable_optimised_nst_kernel()
+    {
+      Use_optimised_nst_kernel = true;
+    }
+
+    /// \short Always use the generic assembly kernel for the residuals
+    /// and Jacobian (e.g. to compare timings/results against the
+    /// optimised one).
+    static void disable_optimised_nst_kernel()
+    {
+      Use_optimised_nst_kernel = false;
+    }
+
     /// \short Pressure at local pressure "node" n_p
     /// Uses suitably interpolated value for hanging nodes.
     virtual double p_nst(const unsigned& n_p) const = 0;
@@ -1068,6 +1125,50 @@ namespace oomph
     }
 
 
+    /// \short Return the values of the i-th scalar field at the plot points
+    /// (as written by scalar_value_paraview(...)), without the round trip
+    /// through the output stream.
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+#ifdef PARANOID
+      if (i > DIM)
+      {
+        std::stringstream error_stream;
+        error_stream << "These Navier Stokes elements only store " << DIM + 1
+                     << " fields, "
+                     << "but i is currently  " << i << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Vector of local coordinates
+      Vector<double> s(DIM);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Velocities
+        if (i < DIM)
+        {
+          value[iplot] = interpolated_u_nst(s, i);
+        }
+        // Pressure
+        else
+        {
+          value[iplot] = interpolated_p_nst(s);
+        }
+      }
+    }
+
+
     /// \short Write values of the i-th scalar field at the plot points. Needs
     /// to be implemented for each new specific element type.
     void scalar_value_fct_paraview(
@@ -1794,6 +1895,21 @@ namespace oomph
       RankFourTensor<double>& d_dtestdx_dX,
       DenseMatrix<double>& djacobian_dX) const;
 
+    /// \short The element provides an optimised version of
+    /// fill_in_generic_residual_contribution_nst(...)
+    bool has_optimised_nst_kernel() const
+    {
+      return true;
+    }
+
+    /// \short Optimised version of fill_in_generic_residual_contribution_nst(
+    /// ...), using the kernel for a fixed number of nodes and pressure dofs.
+    void fill_in_optimised_residual_contribution_nst(
+      Vector<double>& residuals,
+      DenseMatrix<double>& jacobian,
+      DenseMatrix<double>& mass_matrix,
+      unsigned flag);
+
 
   public:
     /// Constructor, there are DIM+1 internal values (for the pressure)
@@ -2352,6 +2468,21 @@ namespace oomph
       RankFourTensor<double>& d_dtestdx_dX,
       DenseMatrix<double>& djacobian_dX) const;
 
+    /// \short The element provides an optimised version of
+    /// fill_in_generic_residual_contribution_nst(...)
+    bool has_optimised_nst_kernel() const
+    {
+      return true;
+    }
+
+    /// \short Optimised version of fill_in_generic_residual_contribution_nst(
+    /// ...), using the kernel for a fixed number of nodes and pressure dofs.
+    void fill_in_optimised_residual_contribution_nst(
+      Vector<double>& residuals,
+      DenseMatrix<double>& jacobian,
+      DenseMatrix<double>& mass_matrix,
+      unsigned flag);
+
   public:
     /// Constructor, no internal data points
     QTaylorHoodElement() : QElement<DIM, 3>(), NavierStokesEquations<DIM>() {}
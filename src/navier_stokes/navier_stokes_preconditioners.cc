@@ -143,34 +143,20 @@ namespace oomph
   /// creates the matrices actually needed in the application of the
   /// preconditioner and deletes what can be deleted... Note that
   /// this preconditioner needs a CRDoubleMatrix.
+  ///
+  /// The operators are set up in two groups: Those that only depend
+  /// on the geometry (the pressure Poisson matrix B Q^{-1} B^T and its
+  /// preconditioner, the inverse mass matrix diagonals and the
+  /// gradient matrix B^T) and those that depend on the velocity (the
+  /// momentum block F, its preconditioner and, for the Fp version,
+  /// the pressure advection diffusion matrix). Either group may be
+  /// retained from the previous setup if this is enabled by the
+  /// reuse policy (see enable_reuse_of_geometric_blocks() and
+  /// set_velocity_block_refresh_interval(...)) and the mesh and
+  /// dof numbering haven't changed.
   //============================================================================
   void NavierStokesSchurComplementPreconditioner::setup()
   {
-    // For debugging...
-    bool doc_block_matrices = false;
-
-    // For output timing results - to be removed soon. Ray
-    bool raytime_flag = false;
-
-    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    // NOTE: In the interest of minimising memory usage, several containers
-    //       are recycled, therefore their content/meaning changes
-    //       throughout this function. The code is carefully annotated
-    //       but you'll have to read it line by line!
-    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    double t_clean_up_memory_start = TimingHelpers::timer();
-    // make sure any old data is deleted
-    clean_up_memory();
-    double t_clean_up_memory_end = TimingHelpers::timer();
-    double clean_up_memory_time =
-      t_clean_up_memory_end - t_clean_up_memory_start;
-    if (raytime_flag)
-    {
-      oomph_info << "LSC: clean_up_memory_time: " << clean_up_memory_time
-                 << std::endl;
-    }
-
-
 #ifdef PARANOID
     // paranoid check that the navier stokes mesh pt has been set
     if (Navier_stokes_mesh_pt == 0)
@@ -211,7 +197,7 @@ namespace oomph
 #endif
 
 
-    if (doc_block_matrices)
+    if (Doc_block_matrices)
     {
       std::stringstream junk;
       junk << "j_matrix" << comm_pt()->my_rank() << ".dat";
@@ -255,21 +241,268 @@ namespace oomph
                  << "\n";
     }
 
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: block_setup: " << block_setup_time << std::endl;
     }
 
 
-    // determine whether the F preconditioner is a block preconditioner (and
-    // therefore a subsidiary preconditioner)
-    BlockPreconditioner<CRDoubleMatrix>* F_block_preconditioner_pt =
-      dynamic_cast<BlockPreconditioner<CRDoubleMatrix>*>(F_preconditioner_pt);
-    F_preconditioner_is_block_preconditioner = true;
-    if (F_block_preconditioner_pt == 0)
+    // Which operators can be retained from the previous setup?
+    // --------------------------------------------------------
+    bool rebuild_geometric_blocks = true;
+    bool rebuild_velocity_blocks = true;
+    if (Reuse_geometric_blocks || (Velocity_block_refresh_interval > 1))
     {
-      F_preconditioner_is_block_preconditioner = false;
+      // Has the mesh (or the dof numbering) changed since the
+      // retained operators were set up?
+      unsigned long long signature = geometric_signature();
+      int mesh_has_changed = (signature != Geometric_signature);
+#ifdef OOMPH_HAS_MPI
+      // Everybody has to make the same decision
+      if (cr_matrix_pt->distributed())
+      {
+        int local_mesh_has_changed = mesh_has_changed;
+        MPI_Allreduce(&local_mesh_has_changed,
+                      &mesh_has_changed,
+                      1,
+                      MPI_INT,
+                      MPI_MAX,
+                      this->comm_pt()->mpi_comm());
+      }
+#endif
+      Geometric_signature = signature;
+
+      if (!mesh_has_changed)
+      {
+        if (Reuse_geometric_blocks && Geometric_blocks_are_set_up)
+        {
+          rebuild_geometric_blocks = false;
+        }
+        if (Velocity_blocks_are_set_up &&
+            (Nsetup_since_velocity_block_refresh + 1 <
+             Velocity_block_refresh_interval))
+        {
+          rebuild_velocity_blocks = false;
+        }
+      }
+    }
+
+    if (Doc_time)
+    {
+      oomph_info << "Reusing geometric blocks: " << !rebuild_geometric_blocks
+                 << "; reusing velocity blocks: " << !rebuild_velocity_blocks
+                 << std::endl;
+    }
+
+    // Make sure any old data is deleted
+    double t_clean_up_memory_start = TimingHelpers::timer();
+    if (rebuild_geometric_blocks)
+    {
+      clean_up_geometric_blocks();
+    }
+    if (rebuild_velocity_blocks)
+    {
+      clean_up_velocity_blocks();
+    }
+    double t_clean_up_memory_end = TimingHelpers::timer();
+    double clean_up_memory_time =
+      t_clean_up_memory_end - t_clean_up_memory_start;
+    if (Raytime_flag)
+    {
+      oomph_info << "LSC: clean_up_memory_time: " << clean_up_memory_time
+                 << std::endl;
+    }
+
+    // (Re-)build the operators
+    if (rebuild_geometric_blocks)
+    {
+      setup_geometric_blocks();
+    }
+    if (rebuild_velocity_blocks)
+    {
+      setup_velocity_blocks();
+      Nsetup_since_velocity_block_refresh = 0;
+    }
+    else
+    {
+      Nsetup_since_velocity_block_refresh++;
+    }
+
+    // Remember that the preconditioner has been setup so
+    // the stored information can be wiped when we
+    // come here next...
+    Preconditioner_has_been_setup = true;
+  }
+
+
+  //===========================================================================
+  /// Helper function to assemble the pressure advection diffusion matrix
+  /// Fp directly from the elemental contributions to the pressure block.
+  /// The elements' contributions only involve their (local) pressure
+  /// equations, so there is no need to pin the other dofs, or to assemble
+  /// via the Problem; the global pressure equations are mapped to their
+  /// rows/columns in the pressure block via the block lookup schemes.
+  /// Only for non-distributed problems/matrices.
+  //===========================================================================
+  void NavierStokesSchurComplementPreconditioner::
+    assemble_pressure_advection_diffusion_block(CRDoubleMatrix& fp_block)
+  {
+    // Identify pinned pressure dof and attach Robin BC elements
+    set_pinned_fp_pressure_eqn();
+    build_fp_robin_elements();
+
+    // The pressure block
+    LinearAlgebraDistribution* p_dist_pt = this->block_distribution_pt(1);
+    unsigned p_nrow = p_dist_pt->nrow();
+
+    // Storage for the entries in each row of the pressure block
+    Vector<std::map<unsigned, double>> row_map(p_nrow);
+
+    unsigned n_el = Navier_stokes_mesh_pt->nelement();
+    for (unsigned e = 0; e < n_el; e++)
+    {
+      TemplateFreeNavierStokesEquationsBase* el_pt =
+        dynamic_cast<TemplateFreeNavierStokesEquationsBase*>(
+          Navier_stokes_mesh_pt->element_pt(e));
+
+      // Elements that are not Navier-Stokes elements (e.g. flux control
+      // elements) don't contribute
+      if (el_pt == 0)
+      {
+        continue;
+      }
+
+      // Get the elemental contribution
+      unsigned el_dof = el_pt->ndof();
+      if (el_dof == 0)
+      {
+        continue;
+      }
+      Vector<double> el_residuals(el_dof, 0.0);
+      DenseMatrix<double> el_jacobian(el_dof, el_dof, 0.0);
+      el_pt->fill_in_pressure_advection_diffusion_jacobian(el_residuals,
+                                                           el_jacobian);
+
+      // Find the local pressure equations and their indices in the
+      // pressure block
+      Vector<unsigned> local_p_eqn;
+      Vector<unsigned> p_index;
+      local_p_eqn.reserve(el_dof);
+      p_index.reserve(el_dof);
+      for (unsigned i = 0; i < el_dof; i++)
+      {
+        unsigned eqn_number = el_pt->eqn_number(i);
+        if (this->block_number(eqn_number) == 1)
+        {
+          local_p_eqn.push_back(i);
+          p_index.push_back(this->index_in_block(eqn_number));
+        }
+      }
+
+      // Add the pressure-pressure entries
+      unsigned n_p = local_p_eqn.size();
+      for (unsigned i = 0; i < n_p; i++)
+      {
+        for (unsigned j = 0; j < n_p; j++)
+        {
+          double value = el_jacobian(local_p_eqn[i], local_p_eqn[j]);
+          if (value != 0.0)
+          {
+            row_map[p_index[i]][p_index[j]] += value;
+          }
+        }
+      }
+    }
+
+    // Kill Robin BC elements
+    delete_fp_robin_elements();
+
+    // Build the compressed row storage
+    unsigned long nnz = 0;
+    for (unsigned i = 0; i < p_nrow; i++)
+    {
+      nnz += row_map[i].size();
+    }
+    Vector<double> values;
+    Vector<int> column_indices;
+    Vector<int> row_start(p_nrow + 1);
+    values.reserve(nnz);
+    column_indices.reserve(nnz);
+    for (unsigned i = 0; i < p_nrow; i++)
+    {
+      row_start[i] = values.size();
+      for (std::map<unsigned, double>::iterator it = row_map[i].begin();
+           it != row_map[i].end();
+           it++)
+      {
+        column_indices.push_back(it->first);
+        values.push_back(it->second);
+      }
+      row_map[i].clear();
+    }
+    row_start[p_nrow] = values.size();
+
+    fp_block.build(p_dist_pt, p_nrow, values, column_indices, row_start);
+  }
+
+
+  //===========================================================================
+  /// Helper function: Checksum of the data that the geometric blocks
+  /// depend on: the variant of the preconditioner, the sizes of the
+  /// blocks, the numbers of elements and nodes in the Navier-Stokes mesh,
+  /// and the nodal positions and equation numbers.
+  //===========================================================================
+  unsigned long long NavierStokesSchurComplementPreconditioner::
+    geometric_signature() const
+  {
+    unsigned long long signature = Checksum::Initial_value;
+
+    Checksum::update(signature, &Use_LSC, sizeof(bool));
+    unsigned long nrow[2];
+    nrow[0] = this->block_distribution_pt(0)->nrow();
+    nrow[1] = this->block_distribution_pt(1)->nrow();
+    Checksum::update(signature, nrow, sizeof(nrow));
+
+    unsigned long n_element = Navier_stokes_mesh_pt->nelement();
+    unsigned long n_node = Navier_stokes_mesh_pt->nnode();
+    Checksum::update(signature, &n_element, sizeof(unsigned long));
+    Checksum::update(signature, &n_node, sizeof(unsigned long));
+
+    for (unsigned long j = 0; j < n_node; j++)
+    {
+      Node* nod_pt = Navier_stokes_mesh_pt->node_pt(j);
+      unsigned n_dim = nod_pt->ndim();
+      for (unsigned i = 0; i < n_dim; i++)
+      {
+        double x = nod_pt->x(i);
+        Checksum::update(signature, &x, sizeof(double));
+      }
+      unsigned n_value = nod_pt->nvalue();
+      for (unsigned i = 0; i < n_value; i++)
+      {
+        long eqn_number = nod_pt->eqn_number(i);
+        Checksum::update(signature, &eqn_number, sizeof(long));
+      }
     }
+    return signature;
+  }
+
+
+  //===========================================================================
+  /// Helper function: Set up the operators that only depend on the
+  /// geometry: The pressure Poisson matrix P = B Q^{-1} B^T and its
+  /// preconditioner, the matrix-vector products with Q^{-1} B^T and
+  /// B^T and (for the Fp version) the inverse pressure mass matrix
+  /// diagonal.
+  //===========================================================================
+  void NavierStokesSchurComplementPreconditioner::setup_geometric_blocks()
+  {
+    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    // NOTE: In the interest of minimising memory usage, several containers
+    //       are recycled, therefore their content/meaning changes
+    //       throughout this function. The code is carefully annotated
+    //       but you'll have to read it line by line!
+    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
     // Get B (the divergence block)
     double t_get_B_start = TimingHelpers::timer();
@@ -283,12 +516,12 @@ namespace oomph
       oomph_info << "Time to get B [sec]: " << get_B_time << "\n";
     }
 
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: get block B get_B_time: " << get_B_time << std::endl;
     }
 
-    if (doc_block_matrices)
+    if (Doc_block_matrices)
     {
       std::stringstream junk;
       junk << "b_matrix" << comm_pt()->my_rank() << ".dat";
@@ -299,20 +532,20 @@ namespace oomph
 
     // get the inverse velocity and pressure mass matrices
     CRDoubleMatrix* inv_v_mass_pt = 0;
-    CRDoubleMatrix* inv_p_mass_pt = 0;
 
     double ivmm_assembly_start_t = TimingHelpers::timer();
     if (Use_LSC)
     {
       // We only need the velocity mass matrix
       assemble_inv_press_and_veloc_mass_matrix_diagonal(
-        inv_p_mass_pt, inv_v_mass_pt, false);
+        Inv_p_mass_pt, inv_v_mass_pt, false);
     }
     else
     {
-      // We need both mass matrices
+      // We need both mass matrices; the pressure one is retained
+      // for the (re-)computation of E = Fp Qp^{-1}
       assemble_inv_press_and_veloc_mass_matrix_diagonal(
-        inv_p_mass_pt, inv_v_mass_pt, true);
+        Inv_p_mass_pt, inv_v_mass_pt, true);
     }
 
     double ivmm_assembly_finish_t = TimingHelpers::timer();
@@ -323,14 +556,14 @@ namespace oomph
       oomph_info << "Time to assemble inverse diagonal velocity and pressure"
                  << "mass matrices) [sec]: " << ivmm_assembly_time << "\n";
     }
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: ivmm_assembly_time: " << ivmm_assembly_time
                  << std::endl;
     }
 
 
-    if (doc_block_matrices)
+    if (Doc_block_matrices)
     {
       std::stringstream junk;
       junk << "inv_v_mass_matrix" << comm_pt()->my_rank() << ".dat";
@@ -350,12 +583,12 @@ namespace oomph
     {
       oomph_info << "Time to get Bt [sec]: " << t_get_Bt_time << std::endl;
     }
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: get block Bt: " << t_get_Bt_time << std::endl;
     }
 
-    if (doc_block_matrices)
+    if (Doc_block_matrices)
     {
       std::stringstream junk;
       junk << "bt_matrix" << comm_pt()->my_rank() << ".dat";
@@ -364,6 +597,20 @@ namespace oomph
     }
 
 
+    // form the matrix vector operator for Bt
+    double t_Bt_MV_start = TimingHelpers::timer();
+    Bt_mat_vec_pt = new MatrixVectorProduct;
+    this->setup_matrix_vector_product(Bt_mat_vec_pt, bt_pt, 1);
+    double t_Bt_MV_finish = TimingHelpers::timer();
+
+    double t_Bt_MV_time = t_Bt_MV_finish - t_Bt_MV_start;
+    if (Raytime_flag)
+    {
+      oomph_info << "LSC: MV product setup t_Bt_MV_time: " << t_Bt_MV_time
+                 << std::endl;
+    }
+
+
     // Build pressure Poisson matrix
     CRDoubleMatrix* p_matrix_pt = new CRDoubleMatrix;
 
@@ -385,7 +632,7 @@ namespace oomph
     }
     delete inv_v_mass_pt;
     inv_v_mass_pt = 0;
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: t_QBt_time (matrix multiplicaton): " << t_QBt_time
                  << std::endl;
@@ -406,7 +653,7 @@ namespace oomph
     delete b_pt;
     b_pt = 0;
 
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: t_p_time (matrix multiplication): " << t_p_time
                  << std::endl;
@@ -426,28 +673,102 @@ namespace oomph
                  << t_p_time2 << std::endl;
     }
 
-    // Kill gradient matrix B^T (it's been overwritten anyway and
-    // needs to be recomputed afresh below)
+    // Kill the product Q^{-1} B^T
     delete bt_pt;
     bt_pt = 0;
 
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: QBt (setup MV product): " << t_p_time2 << std::endl;
     }
 
+    // if the P preconditioner has not been setup
+    if (P_preconditioner_pt == 0)
+    {
+      P_preconditioner_pt = new SuperLUPreconditioner;
+      Using_default_p_preconditioner = true;
+    }
+
+    // Setup the preconditioner for the Pressure matrix
+    double t_p_prec_start = TimingHelpers::timer();
+
+    if (Doc_block_matrices)
+    {
+      std::stringstream junk;
+      junk << "p_matrix" << comm_pt()->my_rank() << ".dat";
+      p_matrix_pt->sparse_indexed_output_with_offset(junk.str());
+      oomph_info << "Done output of " << junk.str() << std::endl;
+    }
+
+    P_preconditioner_pt->setup(p_matrix_pt);
+    delete p_matrix_pt;
+    p_matrix_pt = 0;
+    double t_p_prec_finish = TimingHelpers::timer();
+
+    double t_p_prec_time = t_p_prec_finish - t_p_prec_start;
+    if (Doc_time)
+    {
+      oomph_info << "P sub-preconditioner setup time [sec]: " << t_p_prec_time
+                 << "\n";
+    }
+    if (Raytime_flag)
+    {
+      oomph_info << "LSC: p_prec setup time: " << t_p_prec_time << std::endl;
+    }
+
+    Geometric_blocks_are_set_up = true;
+  }
+
+
+  //===========================================================================
+  /// Helper function: Set up the operators that depend on the velocity:
+  /// The matrix-vector product with the momentum block F, the
+  /// preconditioner for F and (for the Fp version) the matrix-vector
+  /// product with E = Fp Qp^{-1}.
+  //===========================================================================
+  void NavierStokesSchurComplementPreconditioner::setup_velocity_blocks()
+  {
+    // determine whether the F preconditioner is a block preconditioner (and
+    // therefore a subsidiary preconditioner)
+    BlockPreconditioner<CRDoubleMatrix>* F_block_preconditioner_pt =
+      dynamic_cast<BlockPreconditioner<CRDoubleMatrix>*>(F_preconditioner_pt);
+    F_preconditioner_is_block_preconditioner = true;
+    if (F_block_preconditioner_pt == 0)
+    {
+      F_preconditioner_is_block_preconditioner = false;
+    }
+
     // Do we need the Fp stuff?
     if (!Use_LSC)
     {
-      // Get pressure advection diffusion matrix Fp and store in
-      // a "big" matrix (same size as the problem's Jacobian)
-      double t_get_Fp_start = TimingHelpers::timer();
-      CRDoubleMatrix full_fp_matrix;
-      get_pressure_advection_diffusion_matrix(full_fp_matrix);
+      // Can we assemble the pressure advection diffusion matrix directly
+      // in the pressure block? (The block lookup schemes only cover all
+      // equations if neither the problem nor the matrix are distributed.)
+      bool direct_fp_assembly = Use_direct_fp_assembly;
+#ifdef OOMPH_HAS_MPI
+      if (problem_pt()->distributed() ||
+          this->master_distribution_pt()->distributed())
+      {
+        direct_fp_assembly = false;
+      }
+#endif
 
-      // Now extract the pressure pressure block
+      double t_get_Fp_start = TimingHelpers::timer();
       CRDoubleMatrix* fp_matrix_pt = new CRDoubleMatrix;
-      this->get_block_other_matrix(1, 1, &full_fp_matrix, *fp_matrix_pt);
+      if (direct_fp_assembly)
+      {
+        assemble_pressure_advection_diffusion_block(*fp_matrix_pt);
+      }
+      else
+      {
+        // Get pressure advection diffusion matrix Fp and store in
+        // a "big" matrix (same size as the problem's Jacobian)
+        CRDoubleMatrix full_fp_matrix;
+        get_pressure_advection_diffusion_matrix(full_fp_matrix);
+
+        // Now extract the pressure pressure block
+        this->get_block_other_matrix(1, 1, &full_fp_matrix, *fp_matrix_pt);
+      }
       double t_get_Fp_finish = TimingHelpers::timer();
       if (Doc_time)
       {
@@ -458,7 +779,9 @@ namespace oomph
       // Build vector product of pressure advection diffusion matrix with
       // inverse pressure mass matrix
       CRDoubleMatrix* fp_qp_inv_pt = new CRDoubleMatrix;
-      fp_matrix_pt->multiply(*inv_p_mass_pt, *fp_qp_inv_pt);
+      fp_matrix_pt->multiply(*Inv_p_mass_pt, *fp_qp_inv_pt);
+      delete fp_matrix_pt;
+      fp_matrix_pt = 0;
 
       // Build the matvec operator for E = F_p Q_p^{-1}
       double t_Fp_Qp_inv_MV_start = TimingHelpers::timer();
@@ -471,9 +794,7 @@ namespace oomph
         oomph_info << "Time to build Fp Qp^{-1} matrix vector operator [sec]: "
                    << t_p_time << std::endl;
       }
-      // Kill pressure advection diffusion and inverse pressure mass matrices
-      delete inv_p_mass_pt;
-      inv_p_mass_pt = 0;
+      // Kill pressure advection diffusion matrix product
       delete fp_qp_inv_pt;
       fp_qp_inv_pt = 0;
     }
@@ -490,7 +811,7 @@ namespace oomph
     {
       oomph_info << "Time to get F [sec]: " << t_get_F_time << std::endl;
     }
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: get_block t_get_F_time: " << t_get_F_time
                  << std::endl;
@@ -508,7 +829,7 @@ namespace oomph
       oomph_info << "Time to build F Matrix Vector Operator [sec]: "
                  << t_F_MV_time << std::endl;
     }
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: MV product setup t_F_MV_time: " << t_F_MV_time
                  << std::endl;
@@ -522,81 +843,6 @@ namespace oomph
       f_pt = 0;
     }
 
-    // Rebuild Bt (remember that we temporarily overwrote
-    // it by its product with the inverse velocity mass matrix)
-    t_get_Bt_start = TimingHelpers::timer();
-    bt_pt = new CRDoubleMatrix;
-    this->get_block(0, 1, *bt_pt);
-    t_get_Bt_finish = TimingHelpers::timer();
-    double t_get_Bt_time2 = t_get_Bt_finish - t_get_Bt_start;
-    if (Doc_time)
-    {
-      oomph_info << "Time to get Bt [sec]: " << t_get_Bt_time2 << std::endl;
-    }
-    if (raytime_flag)
-    {
-      oomph_info << "LSC: get_block t_get_Bt_time2: " << t_get_Bt_time2
-                 << std::endl;
-    }
-
-
-    // form the matrix vector operator for Bt
-    double t_Bt_MV_start = TimingHelpers::timer();
-    Bt_mat_vec_pt = new MatrixVectorProduct;
-    this->setup_matrix_vector_product(Bt_mat_vec_pt, bt_pt, 1);
-
-    //  if(Doc_time)
-    //   {
-    //    oomph_info << "Time to build Bt Matrix Vector Operator [sec]: "
-    //               << t_Bt_MV_time << std::endl;
-    //   }
-
-    delete bt_pt;
-    bt_pt = 0;
-
-    double t_Bt_MV_finish = TimingHelpers::timer();
-
-    double t_Bt_MV_time = t_Bt_MV_finish - t_Bt_MV_start;
-    if (raytime_flag)
-    {
-      oomph_info << "LSC: MV product setup t_Bt_MV_time: " << t_Bt_MV_time
-                 << std::endl;
-    }
-
-    // if the P preconditioner has not been setup
-    if (P_preconditioner_pt == 0)
-    {
-      P_preconditioner_pt = new SuperLUPreconditioner;
-      Using_default_p_preconditioner = true;
-    }
-
-    // Setup the preconditioner for the Pressure matrix
-    double t_p_prec_start = TimingHelpers::timer();
-
-    if (doc_block_matrices)
-    {
-      std::stringstream junk;
-      junk << "p_matrix" << comm_pt()->my_rank() << ".dat";
-      p_matrix_pt->sparse_indexed_output_with_offset(junk.str());
-      oomph_info << "Done output of " << junk.str() << std::endl;
-    }
-
-    P_preconditioner_pt->setup(p_matrix_pt);
-    delete p_matrix_pt;
-    p_matrix_pt = 0;
-    double t_p_prec_finish = TimingHelpers::timer();
-
-    double t_p_prec_time = t_p_prec_finish - t_p_prec_start;
-    if (Doc_time)
-    {
-      oomph_info << "P sub-preconditioner setup time [sec]: " << t_p_prec_time
-                 << "\n";
-    }
-    if (raytime_flag)
-    {
-      oomph_info << "LSC: p_prec setup time: " << t_p_prec_time << std::endl;
-    }
-
 
     // Set up solver for solution of system with momentum matrix
     // ----------------------------------------------------------
@@ -640,15 +886,12 @@ namespace oomph
       oomph_info << "F sub-preconditioner setup time [sec]: " << t_f_prec_time
                  << "\n";
     }
-    if (raytime_flag)
+    if (Raytime_flag)
     {
       oomph_info << "LSC: f_prec setup time: " << t_f_prec_time << std::endl;
     }
 
-    // Remember that the preconditioner has been setup so
-    // the stored information can be wiped when we
-    // come here next...
-    Preconditioner_has_been_setup = true;
+    Velocity_blocks_are_set_up = true;
   }
 
 
@@ -1667,38 +1910,65 @@ namespace oomph
   }
 
   //=========================================================================
-  /// Helper function to delete preconditioner data.
+  /// Helper function to delete the operators that only depend on the
+  /// geometry
   //=========================================================================
-  void NavierStokesSchurComplementPreconditioner::clean_up_memory()
+  void NavierStokesSchurComplementPreconditioner::clean_up_geometric_blocks()
   {
-    if (Preconditioner_has_been_setup)
+    // delete matvecs
+    delete Bt_mat_vec_pt;
+    Bt_mat_vec_pt = 0;
+
+    delete QBt_mat_vec_pt;
+    QBt_mat_vec_pt = 0;
+
+    // delete the inverse pressure mass matrix
+    delete Inv_p_mass_pt;
+    Inv_p_mass_pt = 0;
+
+    // delete stuff from Schur complement approx
+    if (Using_default_p_preconditioner)
     {
-      // delete matvecs
-      delete Bt_mat_vec_pt;
-      Bt_mat_vec_pt = 0;
+      delete P_preconditioner_pt;
+      P_preconditioner_pt = 0;
+    }
+
+    Geometric_blocks_are_set_up = false;
+  }
+
 
-      delete F_mat_vec_pt;
-      F_mat_vec_pt = 0;
+  //=========================================================================
+  /// Helper function to delete the operators that depend on the velocity
+  //=========================================================================
+  void NavierStokesSchurComplementPreconditioner::clean_up_velocity_blocks()
+  {
+    // delete matvecs
+    delete F_mat_vec_pt;
+    F_mat_vec_pt = 0;
 
-      delete QBt_mat_vec_pt;
-      QBt_mat_vec_pt = 0;
+    delete E_mat_vec_pt;
+    E_mat_vec_pt = 0;
 
-      delete E_mat_vec_pt;
-      E_mat_vec_pt = 0;
+    // delete stuff from velocity solve
+    if (Using_default_f_preconditioner)
+    {
+      delete F_preconditioner_pt;
+      F_preconditioner_pt = 0;
+    }
 
-      // delete stuff from velocity solve
-      if (Using_default_f_preconditioner)
-      {
-        delete F_preconditioner_pt;
-        F_preconditioner_pt = 0;
-      }
+    Velocity_blocks_are_set_up = false;
+  }
 
-      // delete stuff from Schur complement approx
-      if (Using_default_p_preconditioner)
-      {
-        delete P_preconditioner_pt;
-        P_preconditioner_pt = 0;
-      }
+
+  //=========================================================================
+  /// Helper function to delete preconditioner data.
+  //=========================================================================
+  void NavierStokesSchurComplementPreconditioner::clean_up_memory()
+  {
+    if (Preconditioner_has_been_setup)
+    {
+      clean_up_geometric_blocks();
+      clean_up_velocity_blocks();
     }
   }
 
@@ -679,6 +679,10 @@ namespace oomph
       // Pin pressure dof in press adv diff problem for Fp precond
       Pin_first_pressure_dof_in_press_adv_diff = true;
 
+      // Assemble the Fp matrix directly in the pressure block (where
+      // possible)
+      Use_direct_fp_assembly = true;
+
       Navier_stokes_mesh_pt = 0;
 
       // Set default preconditioners (inexact solvers) -- they are
@@ -704,6 +708,21 @@ namespace oomph
       // Initially assume that there are no multiple element types in the
       // Navier-Stokes mesh
       Allow_multiple_element_type_in_navier_stokes_mesh = false;
+
+      // By default all operators are rebuilt in every call to setup()
+      Reuse_geometric_blocks = false;
+      Velocity_block_refresh_interval = 1;
+      Nsetup_since_velocity_block_refresh = 0;
+      Geometric_blocks_are_set_up = false;
+      Velocity_blocks_are_set_up = false;
+      Geometric_signature = 0;
+
+      // null the inverse pressure mass matrix (only for Fp variant)
+      Inv_p_mass_pt = 0;
+
+      // No debugging output
+      Doc_block_matrices = false;
+      Raytime_flag = false;
     }
 
     /// Destructor
@@ -803,6 +822,9 @@ namespace oomph
       }
       P_preconditioner_pt = new_p_preconditioner_pt;
       Using_default_p_preconditioner = false;
+
+      // The new preconditioner has to be set up
+      Geometric_blocks_are_set_up = false;
     }
 
     /// \short Function to (re-)set pressure matrix preconditioner  (inexact
@@ -813,6 +835,7 @@ namespace oomph
       {
         P_preconditioner_pt = new SuperLUPreconditioner;
         Using_default_p_preconditioner = true;
+        Geometric_blocks_are_set_up = false;
       }
     }
 
@@ -827,18 +850,46 @@ namespace oomph
       }
       F_preconditioner_pt = new_f_preconditioner_pt;
       Using_default_f_preconditioner = false;
+
+      // The new preconditioner has to be set up
+      Velocity_blocks_are_set_up = false;
     }
 
     /// Use LSC version of the preconditioner
     void use_lsc()
     {
       Use_LSC = true;
+      Geometric_blocks_are_set_up = false;
+      Velocity_blocks_are_set_up = false;
     }
 
     /// Use Fp version of the preconditioner
     void use_fp()
     {
       Use_LSC = false;
+      Geometric_blocks_are_set_up = false;
+      Velocity_blocks_are_set_up = false;
+    }
+
+    /// \short Assemble the pressure advection diffusion matrix for the Fp
+    /// version directly from the elemental contributions to the pressure
+    /// block (default). This bypasses the assembly via the Problem (which
+    /// requires the pinning of all non-pressure dofs and the temporary
+    /// replacement of the Problem's meshes and assembly handler) but is
+    /// only available if neither the problem nor the Jacobian are
+    /// distributed; otherwise we revert to the assembly via the Problem.
+    void enable_direct_fp_assembly()
+    {
+      Use_direct_fp_assembly = true;
+      Velocity_blocks_are_set_up = false;
+    }
+
+    /// \short Assemble the pressure advection diffusion matrix for the Fp
+    /// version via the Problem
+    void disable_direct_fp_assembly()
+    {
+      Use_direct_fp_assembly = false;
+      Velocity_blocks_are_set_up = false;
     }
 
     ///\short Function to (re-)set momentum matrix preconditioner (inexact
@@ -849,6 +900,7 @@ namespace oomph
       {
         F_preconditioner_pt = new SuperLUPreconditioner;
         Using_default_f_preconditioner = true;
+        Velocity_blocks_are_set_up = false;
       }
     }
 
@@ -867,16 +919,55 @@ namespace oomph
     /// \short Helper function to delete preconditioner data.
     void clean_up_memory();
 
+    /// \short Retain the operators that only depend on the geometry
+    /// (the pressure Poisson matrix B Q^{-1} B^T and its preconditioner,
+    /// the inverse mass matrix diagonals and B^T) between calls to
+    /// setup(), e.g. between Newton steps. They are rebuilt automatically
+    /// if the nodal positions or the equation numbering of the
+    /// Navier-Stokes mesh change.
+    void enable_reuse_of_geometric_blocks()
+    {
+      Reuse_geometric_blocks = true;
+    }
+
+    /// \short Rebuild all operators in every call to setup() (default)
+    void disable_reuse_of_geometric_blocks()
+    {
+      Reuse_geometric_blocks = false;
+    }
+
+    /// \short Only rebuild the velocity-dependent operators (the momentum
+    /// block F, its preconditioner and, for the Fp version, the pressure
+    /// advection diffusion matrix) in every n-th call to setup(); in
+    /// between the operators from the most recent refresh are retained,
+    /// so the preconditioner is based on a lagged velocity. The default
+    /// (n=1) rebuilds them every time. Changes to the mesh always
+    /// trigger a refresh.
+    void set_velocity_block_refresh_interval(const unsigned& n)
+    {
+#ifdef PARANOID
+      if (n == 0)
+      {
+        throw OomphLibError("Refresh interval must be positive",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      Velocity_block_refresh_interval = n;
+    }
+
     /// \short Use  Robin BC elements for the Fp preconditioner
     void enable_robin_for_fp()
     {
       Use_robin_for_fp = true;
+      Velocity_blocks_are_set_up = false;
     }
 
     /// \short Don't use Robin BC elements for the Fp preconditioenr
     void disable_robin_for_fp()
     {
       Use_robin_for_fp = false;
+      Velocity_blocks_are_set_up = false;
     }
 
     /// \short Set boolean indicating that we want to pin first pressure
@@ -887,6 +978,7 @@ namespace oomph
     void pin_first_pressure_dof_in_press_adv_diff()
     {
       Pin_first_pressure_dof_in_press_adv_diff = true;
+      Velocity_blocks_are_set_up = false;
     }
 
     /// \short Set boolean indicating that we do not want to pin first pressure
@@ -897,6 +989,7 @@ namespace oomph
     void unpin_first_pressure_dof_in_press_adv_diff()
     {
       Pin_first_pressure_dof_in_press_adv_diff = false;
+      Velocity_blocks_are_set_up = false;
     }
 
     /// \short Validate auxiliary pressure advection diffusion problem
@@ -971,7 +1064,50 @@ namespace oomph
 
 #endif
 
-      // Identify pinned pressure dof
+      // Identify pinned pressure dof and attach Robin BC elements
+      set_pinned_fp_pressure_eqn();
+      build_fp_robin_elements();
+
+      // Get "Jacobian" of the modified system
+      DoubleVector dummy_residuals;
+      problem_pt()->get_jacobian(dummy_residuals, fp_matrix);
+
+      // Kill Robin BC elements
+      delete_fp_robin_elements();
+
+      // Reset pin status
+      reset_pin_status();
+
+#ifdef OOMPH_HAS_MPI
+
+      // Reset start and end elements for the distributed
+      // assembly process
+      problem_pt()->set_first_and_last_element_for_assembly(
+        backed_up_first_el_for_assembly, backed_up_last_el_for_assembly);
+
+#endif
+
+      // Cleanup and reset assembly handler
+      delete problem_pt()->assembly_handler_pt();
+      problem_pt()->assembly_handler_pt() = backed_up_assembly_handler_pt;
+
+      // Re-instate submeshes. (No need to call rebuild_global_mesh()
+      // as it was never unbuilt).
+      for (unsigned i = 0; i < n_sub_mesh; i++)
+      {
+        problem_pt()->add_sub_mesh(backed_up_sub_mesh_pt[i]);
+      }
+
+
+      // Reset the problem's mesh pointer
+      problem_pt()->mesh_pt() = backed_up_mesh_pt;
+    }
+
+
+    /// \short Identify the pressure dof that is pinned in the pressure
+    /// advection diffusion problem (if any) and pass it to the elements
+    void set_pinned_fp_pressure_eqn()
+    {
       int pinned_pressure_eqn = -2;
       if (Pin_first_pressure_dof_in_press_adv_diff)
       {
@@ -1021,13 +1157,17 @@ namespace oomph
         // Set pinned pressure equation
         bulk_elem_pt->pinned_fp_pressure_eqn() = pinned_pressure_eqn;
       }
+    }
 
 
-      // Attach Robin BC elements
-      unsigned nbound = Navier_stokes_mesh_pt->nboundary();
+    /// \short Attach Robin BC elements for the pressure advection
+    /// diffusion problem (if required)
+    void build_fp_robin_elements()
+    {
       if (Use_robin_for_fp)
       {
         // Loop over all boundaries of Navier Stokes mesh
+        unsigned nbound = Navier_stokes_mesh_pt->nboundary();
         for (unsigned b = 0; b < nbound; b++)
         {
           // How many bulk elements are adjacent to boundary b?
@@ -1050,15 +1190,17 @@ namespace oomph
           } // end of loop over bulk elements adjacent to boundary b
         }
       }
+    }
 
-      // Get "Jacobian" of the modified system
-      DoubleVector dummy_residuals;
-      problem_pt()->get_jacobian(dummy_residuals, fp_matrix);
 
-      // Kill Robin BC elements
+    /// \short Delete the Robin BC elements for the pressure advection
+    /// diffusion problem (if any)
+    void delete_fp_robin_elements()
+    {
       if (Use_robin_for_fp)
       {
         // Loop over all boundaries of Navier Stokes mesh
+        unsigned nbound = Navier_stokes_mesh_pt->nboundary();
         for (unsigned b = 0; b < nbound; b++)
         {
           // How many bulk elements are adjacent to boundary b?
@@ -1077,33 +1219,6 @@ namespace oomph
           } // end of loop over bulk elements adjacent to boundary b
         }
       }
-
-      // Reset pin status
-      reset_pin_status();
-
-#ifdef OOMPH_HAS_MPI
-
-      // Reset start and end elements for the distributed
-      // assembly process
-      problem_pt()->set_first_and_last_element_for_assembly(
-        backed_up_first_el_for_assembly, backed_up_last_el_for_assembly);
-
-#endif
-
-      // Cleanup and reset assembly handler
-      delete problem_pt()->assembly_handler_pt();
-      problem_pt()->assembly_handler_pt() = backed_up_assembly_handler_pt;
-
-      // Re-instate submeshes. (No need to call rebuild_global_mesh()
-      // as it was never unbuilt).
-      for (unsigned i = 0; i < n_sub_mesh; i++)
-      {
-        problem_pt()->add_sub_mesh(backed_up_sub_mesh_pt[i]);
-      }
-
-
-      // Reset the problem's mesh pointer
-      problem_pt()->mesh_pt() = backed_up_mesh_pt;
     }
 
 
@@ -1198,6 +1313,32 @@ namespace oomph
       CRDoubleMatrix*& inv_v_mass_pt,
       const bool& do_both);
 
+    /// \short Helper function to assemble the pressure advection diffusion
+    /// matrix Fp directly from the elemental contributions to the pressure
+    /// block (without pinning any dofs or calling the Problem's assembly
+    /// routines). Only for non-distributed problems/matrices.
+    void assemble_pressure_advection_diffusion_block(CRDoubleMatrix& fp_block);
+
+    /// \short Helper function: Checksum of the data that the geometric
+    /// operators depend on (nodal positions and equation numbers etc.)
+    unsigned long long geometric_signature() const;
+
+    /// \short Helper function to set up the operators that only depend on
+    /// the geometry
+    void setup_geometric_blocks();
+
+    /// \short Helper function to set up the operators that depend on the
+    /// velocity
+    void setup_velocity_blocks();
+
+    /// \short Helper function to delete the operators that only depend on
+    /// the geometry
+    void clean_up_geometric_blocks();
+
+    /// \short Helper function to delete the operators that depend on the
+    /// velocity
+    void clean_up_velocity_blocks();
+
     /// \short Boolean indicating whether the momentum system preconditioner
     /// is a block preconditioner
     bool F_preconditioner_is_block_preconditioner;
@@ -1245,6 +1386,39 @@ namespace oomph
     /// Storage for the (non-const!) problem pointer for use in
     /// get_pressure_advection_diffusion_matrix().
     Problem* Problem_pt;
+
+    /// \short Assemble the Fp matrix directly in the pressure block
+    /// (if the problem isn't distributed)?
+    bool Use_direct_fp_assembly;
+
+    /// \short Inverse pressure mass matrix diagonal (only for Fp variant;
+    /// retained with the geometric operators)
+    CRDoubleMatrix* Inv_p_mass_pt;
+
+    /// Retain the geometric operators between calls to setup()?
+    bool Reuse_geometric_blocks;
+
+    /// Number of calls to setup() between refreshes of the velocity blocks
+    unsigned Velocity_block_refresh_interval;
+
+    /// Number of calls to setup() since the last velocity block refresh
+    unsigned Nsetup_since_velocity_block_refresh;
+
+    /// Are the geometric operators currently set up?
+    bool Geometric_blocks_are_set_up;
+
+    /// Are the velocity-dependent operators currently set up?
+    bool Velocity_blocks_are_set_up;
+
+    /// \short Checksum of the geometric data at the most recent call to
+    /// setup()
+    unsigned long long Geometric_signature;
+
+    /// For debugging: Output the block matrices during setup()
+    bool Doc_block_matrices;
+
+    /// For output timing results - to be removed soon. Ray
+    bool Raytime_flag;
   };
 
 
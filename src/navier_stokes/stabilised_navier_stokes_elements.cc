@@ -0,0 +1,587 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline functions for SUPG/PSPG-stabilised equal-order NS elements
+
+#include "stabilised_navier_stokes_elements.h"
+
+
+namespace oomph
+{
+  /// Default value for the scaling factor of the stabilisation parameter
+  template<unsigned DIM>
+  double
+    StabilisedNavierStokesEquations<DIM>::Default_stabilisation_scaling_factor =
+      1.0;
+
+
+  //==========================================================================
+  /// Define the shape functions (psi) and test functions (test) and
+  /// their derivatives w.r.t. global coordinates (dpsidx and dtestdx)
+  /// and return Jacobian of mapping (J). Additionally compute the
+  /// derivatives of dpsidx, dtestdx and J w.r.t. nodal coordinates.
+  ///
+  /// Galerkin: Test functions = shape functions
+  //==========================================================================
+  template<unsigned DIM>
+  double StabilisedNavierStokesEquations<DIM>::
+    dshape_and_dtest_eulerian_at_knot_nst(
+      const unsigned& ipt,
+      Shape& psi,
+      DShape& dpsidx,
+      RankFourTensor<double>& d_dpsidx_dX,
+      Shape& test,
+      DShape& dtestdx,
+      RankFourTensor<double>& d_dtestdx_dX,
+      DenseMatrix<double>& djacobian_dX) const
+  {
+    // Call the geometrical shape functions and derivatives
+    const double J = this->dshape_eulerian_at_knot(
+      ipt, psi, dpsidx, djacobian_dX, d_dpsidx_dX);
+
+    // Loop over the test functions and derivatives and set them equal to the
+    // shape functions
+    const unsigned n_node = this->nnode();
+    for (unsigned i = 0; i < n_node; i++)
+    {
+      test[i] = psi[i];
+
+      for (unsigned k = 0; k < DIM; k++)
+      {
+        dtestdx(i, k) = dpsidx(i, k);
+
+        for (unsigned p = 0; p < DIM; p++)
+        {
+          for (unsigned q = 0; q < n_node; q++)
+          {
+            d_dtestdx_dX(p, q, i, k) = d_dpsidx_dX(p, q, i, k);
+          }
+        }
+      }
+    }
+
+    // Return the jacobian
+    return J;
+  }
+
+
+  //==============================================================
+  ///  Compute the residuals for the Navier--Stokes
+  ///  equations, including the SUPG and PSPG stabilisation terms;
+  ///  flag=1(or 0): do (or don't) compute the Jacobian as well.
+  ///  flag=2: fill in the mass matrix too.
+  ///  The Galerkin terms are computed by
+  ///  NavierStokesEquations<DIM>::fill_in_generic_residual_contribution_nst;
+  ///  here we only add the stabilisation terms. The Jacobian includes the
+  ///  derivatives of the stabilisation parameter w.r.t. the velocities.
+  //==============================================================
+  template<unsigned DIM>
+  void StabilisedNavierStokesEquations<DIM>::
+    fill_in_generic_residual_contribution_nst(Vector<double>& residuals,
+                                              DenseMatrix<double>& jacobian,
+                                              DenseMatrix<double>& mass_matrix,
+                                              unsigned flag)
+  {
+    // Return immediately if there are no dofs
+    if (this->ndof() == 0) return;
+
+    // Add the Galerkin terms
+    NavierStokesEquations<DIM>::fill_in_generic_residual_contribution_nst(
+      residuals, jacobian, mass_matrix, flag);
+
+    // Scaling factor for the stabilisation parameter; bail out if
+    // the stabilisation has been switched off
+    const double tau_scaling = stabilisation_scaling_factor();
+    if (tau_scaling == 0.0) return;
+
+    // Find out how many nodes there are
+    unsigned n_node = this->nnode();
+
+    // Get continuous time from timestepper of first node
+    TimeStepper* time_stepper_pt = this->node_pt(0)->time_stepper_pt();
+    double time = time_stepper_pt->time_pt()->time();
+
+    // Find out how many pressure dofs there are
+    unsigned n_pres = this->npres_nst();
+
+    // Find the indices at which the local velocities are stored
+    unsigned u_nodal_index[DIM];
+    for (unsigned i = 0; i < DIM; i++)
+    {
+      u_nodal_index[i] = this->u_index_nst(i);
+    }
+
+    // Set up memory for the shape and test functions
+    Shape psif(n_node), testf(n_node);
+    DShape dpsifdx(n_node, DIM), dtestfdx(n_node, DIM);
+
+    // Set up memory for pressure shape and test functions
+    Shape psip(n_pres), testp(n_pres);
+    DShape dpsipdx(n_pres, DIM), dtestpdx(n_pres, DIM);
+
+    // Storage for the SUPG test functions and the advective derivatives
+    // of the shape functions
+    Vector<double> supg_testf(n_node);
+    Vector<double> advection_psif(n_node);
+
+    // Weight of the current value in the approximation of du/dt
+    Vector<double> dudt_weight(n_node, 0.0);
+    if (flag)
+    {
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        dudt_weight[l] = this->node_pt(l)->time_stepper_pt()->weight(1, 0);
+      }
+    }
+
+    // Number of integration points
+    unsigned n_intpt = this->integral_pt()->nweight();
+
+    // Set the Vector to hold local coordinates
+    Vector<double> s(DIM);
+
+    // Get Physical Variables from Element
+    // Reynolds number must be multiplied by the density ratio
+    double scaled_re = this->re() * this->density_ratio();
+    double scaled_re_st = this->re_st() * this->density_ratio();
+    double scaled_re_inv_fr = this->re_invfr() * this->density_ratio();
+    double visc_ratio = this->viscosity_ratio();
+    Vector<double> G = this->g();
+
+    // Element size
+    double h = stabilisation_element_size();
+    double h_sq = h * h;
+
+    // Time-derivative and viscous contributions to the (inverse square of
+    // the) stabilisation parameter
+    double tau_inv_sq_t_and_v = pow(4.0 * visc_ratio / h_sq, 2);
+    if (!time_stepper_pt->is_steady())
+    {
+      double dt = time_stepper_pt->time_pt()->dt();
+      tau_inv_sq_t_and_v += pow(2.0 * scaled_re_st / dt, 2);
+    }
+
+    // Integers to store the local equations and unknowns
+    int local_eqn = 0, local_unknown = 0;
+
+    // Loop over the integration points
+    for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+    {
+      // Assign values of s
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        s[i] = this->integral_pt()->knot(ipt, i);
+      }
+
+      // Get the integral weight
+      double w = this->integral_pt()->weight(ipt);
+
+      // Call the derivatives of the shape and test functions
+      double J = this->dshape_and_dtest_eulerian_at_knot_nst(
+        ipt, psif, dpsifdx, testf, dtestfdx);
+
+      // Call the pressure shape and test functions and their derivatives
+      this->dpshape_and_dptest_eulerian_nst(
+        s, psip, dpsipdx, testp, dtestpdx);
+
+      // Premultiply the weights and the Jacobian
+      double W = w * J;
+
+      // Calculate local values of the pressure gradient and velocity
+      // components
+      Vector<double> interpolated_dpdx(DIM, 0.0);
+      Vector<double> interpolated_u(DIM, 0.0);
+      Vector<double> interpolated_x(DIM, 0.0);
+      Vector<double> mesh_velocity(DIM, 0.0);
+      Vector<double> dudt(DIM, 0.0);
+      DenseMatrix<double> interpolated_dudx(DIM, DIM, 0.0);
+
+      // Calculate pressure gradient
+      for (unsigned l = 0; l < n_pres; l++)
+      {
+        double p_value = this->p_nst(l);
+        for (unsigned i = 0; i < DIM; i++)
+        {
+          interpolated_dpdx[i] += p_value * dpsipdx(l, i);
+        }
+      }
+
+      // Calculate velocities and derivatives
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        for (unsigned i = 0; i < DIM; i++)
+        {
+          double u_value = this->raw_nodal_value(l, u_nodal_index[i]);
+          interpolated_u[i] += u_value * psif[l];
+          interpolated_x[i] += this->raw_nodal_position(l, i) * psif[l];
+          dudt[i] += this->du_dt_nst(l, i) * psif[l];
+          for (unsigned j = 0; j < DIM; j++)
+          {
+            interpolated_dudx(i, j) += u_value * dpsifdx(l, j);
+          }
+        }
+      }
+
+      if (!this->ALE_is_disabled)
+      {
+        for (unsigned l = 0; l < n_node; l++)
+        {
+          for (unsigned i = 0; i < DIM; i++)
+          {
+            mesh_velocity[i] += this->raw_dnodal_position_dt(l, i) * psif[l];
+          }
+        }
+      }
+
+      // Get the user-defined body force terms
+      Vector<double> body_force(DIM);
+      this->get_body_force_nst(time, ipt, s, interpolated_x, body_force);
+
+      // (Scaled) convective velocity relative to the mesh
+      Vector<double> conv_velocity(DIM);
+      double conv_velocity_sq = 0.0;
+      for (unsigned k = 0; k < DIM; k++)
+      {
+        conv_velocity[k] =
+          scaled_re * interpolated_u[k] - scaled_re_st * mesh_velocity[k];
+        conv_velocity_sq += conv_velocity[k] * conv_velocity[k];
+      }
+
+      // Stabilisation parameter
+      double tau_inv_sq = tau_inv_sq_t_and_v + 4.0 * conv_velocity_sq / h_sq;
+      if (tau_inv_sq == 0.0) continue;
+      double tau = tau_scaling / sqrt(tau_inv_sq);
+
+      // Derivative of the stabilisation parameter w.r.t. the i-th velocity
+      // component is dtau_du[i] * psif[l] at node l
+      Vector<double> dtau_du(DIM);
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        dtau_du[i] = -4.0 * pow(tau, 3) * scaled_re * conv_velocity[i] /
+                     (tau_scaling * tau_scaling * h_sq);
+      }
+
+      // Strong form of the momentum residual (without the viscous terms)
+      Vector<double> strong_residual(DIM);
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        strong_residual[i] = scaled_re_st * dudt[i] + interpolated_dpdx[i] -
+                             body_force[i] - scaled_re_inv_fr * G[i];
+        for (unsigned k = 0; k < DIM; k++)
+        {
+          strong_residual[i] += conv_velocity[k] * interpolated_dudx(i, k);
+        }
+      }
+
+      // Advective derivatives of the test and shape functions
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        supg_testf[l] = 0.0;
+        advection_psif[l] = 0.0;
+        for (unsigned k = 0; k < DIM; k++)
+        {
+          supg_testf[l] += conv_velocity[k] * dtestfdx(l, k);
+          advection_psif[l] += conv_velocity[k] * dpsifdx(l, k);
+        }
+      }
+
+
+      // MOMENTUM EQUATIONS: SUPG TERMS
+      //-------------------------------
+
+      // Loop over the test functions
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        // Loop over the velocity components
+        for (unsigned i = 0; i < DIM; i++)
+        {
+          /*IF it's not a boundary condition*/
+          local_eqn = this->nodal_local_eqn(l, u_nodal_index[i]);
+          if (local_eqn >= 0)
+          {
+            residuals[local_eqn] -=
+              tau * supg_testf[l] * strong_residual[i] * W;
+
+            // CALCULATE THE JACOBIAN
+            if (flag)
+            {
+              // Loop over the velocity shape functions again
+              for (unsigned l2 = 0; l2 < n_node; l2++)
+              {
+                // Loop over the velocity components again
+                for (unsigned i2 = 0; i2 < DIM; i2++)
+                {
+                  // If at a non-zero degree of freedom add in the entry
+                  local_unknown = this->nodal_local_eqn(l2, u_nodal_index[i2]);
+                  if (local_unknown >= 0)
+                  {
+                    // Derivatives of the stabilisation parameter and
+                    // of the convective velocity in the test function
+                    double jac_entry =
+                      (dtau_du[i2] * supg_testf[l] +
+                       tau * scaled_re * dtestfdx(l, i2)) *
+                      psif[l2] * strong_residual[i];
+
+                    // Derivative of the convecting velocity in the
+                    // strong residual
+                    jac_entry += tau * supg_testf[l] * scaled_re * psif[l2] *
+                                 interpolated_dudx(i, i2);
+
+                    // Extra component if i2 = i
+                    if (i2 == i)
+                    {
+                      // du/dt and convective terms
+                      jac_entry += tau * supg_testf[l] *
+                                   (scaled_re_st * dudt_weight[l2] * psif[l2] +
+                                    advection_psif[l2]);
+
+                      // Mass matrix
+                      if (flag == 2)
+                      {
+                        mass_matrix(local_eqn, local_unknown) +=
+                          tau * supg_testf[l] * scaled_re_st * psif[l2] * W;
+                      }
+                    }
+
+                    jacobian(local_eqn, local_unknown) -= jac_entry * W;
+                  }
+                }
+              }
+
+              // Now loop over pressure shape functions
+              for (unsigned l2 = 0; l2 < n_pres; l2++)
+              {
+                local_unknown = this->p_local_eqn(l2);
+                if (local_unknown >= 0)
+                {
+                  jacobian(local_eqn, local_unknown) -=
+                    tau * supg_testf[l] * dpsipdx(l2, i) * W;
+                }
+              }
+            } /*End of Jacobian calculation*/
+          } // End of if not boundary condition statement
+        } // End of loop over dimension
+      } // End of loop over shape functions
+
+
+      // CONTINUITY EQUATION: PSPG TERMS
+      //--------------------------------
+
+      // Loop over the shape functions
+      for (unsigned l = 0; l < n_pres; l++)
+      {
+        local_eqn = this->p_local_eqn(l);
+        // If not a boundary conditions
+        if (local_eqn >= 0)
+        {
+          // Strong residual tested against the pressure gradient
+          double pspg = 0.0;
+          for (unsigned i = 0; i < DIM; i++)
+          {
+            pspg += dtestpdx(l, i) * strong_residual[i];
+          }
+
+          residuals[local_eqn] += tau * pspg * W;
+
+          /*CALCULATE THE JACOBIAN*/
+          if (flag)
+          {
+            /*Loop over the velocity shape functions*/
+            for (unsigned l2 = 0; l2 < n_node; l2++)
+            {
+              /*Loop over velocity components*/
+              for (unsigned i2 = 0; i2 < DIM; i2++)
+              {
+                /*If we're at a non-zero degree of freedom add it in*/
+                local_unknown = this->nodal_local_eqn(l2, u_nodal_index[i2]);
+                if (local_unknown >= 0)
+                {
+                  // Derivative of the stabilisation parameter
+                  double jac_entry = dtau_du[i2] * psif[l2] * pspg;
+
+                  // du/dt and convective terms
+                  jac_entry += tau * dtestpdx(l, i2) *
+                               (scaled_re_st * dudt_weight[l2] * psif[l2] +
+                                advection_psif[l2]);
+
+                  // Derivative of the convecting velocity
+                  for (unsigned i = 0; i < DIM; i++)
+                  {
+                    jac_entry += tau * dtestpdx(l, i) * scaled_re * psif[l2] *
+                                 interpolated_dudx(i, i2);
+                  }
+
+                  jacobian(local_eqn, local_unknown) += jac_entry * W;
+
+                  // Mass matrix
+                  if (flag == 2)
+                  {
+                    mass_matrix(local_eqn, local_unknown) -=
+                      tau * dtestpdx(l, i2) * scaled_re_st * psif[l2] * W;
+                  }
+                }
+              } /*End of loop over i2*/
+            } /*End of loop over l2*/
+
+            // Pressure-pressure block
+            for (unsigned l2 = 0; l2 < n_pres; l2++)
+            {
+              local_unknown = this->p_local_eqn(l2);
+              if (local_unknown >= 0)
+              {
+                double jac_entry = 0.0;
+                for (unsigned i = 0; i < DIM; i++)
+                {
+                  jac_entry += dtestpdx(l, i) * dpsipdx(l2, i);
+                }
+                jacobian(local_eqn, local_unknown) += tau * jac_entry * W;
+              }
+            }
+          } /*End of Jacobian calculation*/
+        } // End of if not boundary condition
+      } // End of loop over l
+    } // End of loop over integration points
+  }
+
+
+  //=========================================================================
+  ///  Add to the set \c paired_load_data pairs containing
+  /// - the pointer to a Data object
+  /// and
+  /// - the index of the value in that Data object
+  /// .
+  /// for all values (pressures, velocities) that affect the
+  /// load computed in the \c get_load(...) function.
+  //=========================================================================
+  template<unsigned DIM>
+  void StabilisedNavierStokesEquations<DIM>::identify_load_data(
+    std::set<std::pair<Data*, unsigned>>& paired_load_data)
+  {
+    // Find the index at which the velocity is stored
+    unsigned u_index[DIM];
+    for (unsigned i = 0; i < DIM; i++)
+    {
+      u_index[i] = this->u_index_nst(i);
+    }
+
+    // Loop over the nodes
+    unsigned n_node = this->nnode();
+    for (unsigned n = 0; n < n_node; n++)
+    {
+      // Loop over the velocity components and add pointer to their data
+      // and indices to the vectors
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        paired_load_data.insert(std::make_pair(this->node_pt(n), u_index[i]));
+      }
+    }
+
+    // Identify the pressure data
+    this->identify_pressure_data(paired_load_data);
+  }
+
+
+  //=========================================================================
+  ///  Add to the set \c paired_pressure_data pairs containing
+  /// - the pointer to a Data object
+  /// and
+  /// - the index of the value in that Data object
+  /// .
+  /// for pressure values that affect the
+  /// load computed in the \c get_load(...) function.
+  //=========================================================================
+  template<unsigned DIM>
+  void StabilisedNavierStokesEquations<DIM>::identify_pressure_data(
+    std::set<std::pair<Data*, unsigned>>& paired_pressure_data)
+  {
+    // Find the index at which the pressure is stored
+    unsigned p_index = static_cast<unsigned>(this->p_nodal_index_nst());
+
+    // The pressure is stored at every node
+    unsigned n_pres = npres_nst();
+    for (unsigned l = 0; l < n_pres; l++)
+    {
+      paired_pressure_data.insert(std::make_pair(this->node_pt(l), p_index));
+    }
+  }
+
+
+  //============================================================================
+  /// Create a list of pairs for all unknowns in this element,
+  /// so the first entry in each pair contains the global equation
+  /// number of the unknown, while the second one contains the number
+  /// of the "DOF type" that this unknown is associated with.
+  /// (Function can obviously only be called if the equation numbering
+  /// scheme has been set up.)
+  //============================================================================
+  template<unsigned DIM>
+  void StabilisedNavierStokesEquations<DIM>::get_dof_numbers_for_unknowns(
+    std::list<std::pair<unsigned long, unsigned>>& dof_lookup_list) const
+  {
+    // number of nodes
+    unsigned n_node = this->nnode();
+
+    // temporary pair (used to store dof lookup prior to being added to list)
+    std::pair<unsigned, unsigned> dof_lookup;
+
+    // loop over the nodes
+    for (unsigned n = 0; n < n_node; n++)
+    {
+      // loop over the velocities and the pressure
+      for (unsigned v = 0; v < DIM + 1; v++)
+      {
+        // determine local eqn number
+        int local_eqn_number = this->nodal_local_eqn(n, v);
+
+        // ignore pinned values
+        if (local_eqn_number >= 0)
+        {
+          // store dof lookup in temporary pair: Global equation number
+          // is the first entry in pair
+          dof_lookup.first = this->eqn_number(local_eqn_number);
+
+          // set dof numbers: Dof number is the second entry in pair
+          dof_lookup.second = v;
+
+          // add to list
+          dof_lookup_list.push_front(dof_lookup);
+        }
+      }
+    }
+  }
+
+
+  //====================================================================
+  //// Force build of templates
+  //====================================================================
+  template class StabilisedNavierStokesEquations<2>;
+  template class QStabilisedNavierStokesElement<2>;
+  template class TStabilisedNavierStokesElement<2>;
+
+  template class StabilisedNavierStokesEquations<3>;
+  template class QStabilisedNavierStokesElement<3>;
+  template class TStabilisedNavierStokesElement<3>;
+
+} // namespace oomph
@@ -0,0 +1,595 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for SUPG/PSPG-stabilised equal-order Navier Stokes elements
+
+#ifndef OOMPH_STABILISED_NAVIER_STOKES_ELEMENTS_HEADER
+#define OOMPH_STABILISED_NAVIER_STOKES_ELEMENTS_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+
+// OOMPH-LIB headers
+#include "../generic/Qelements.h"
+#include "../generic/Telements.h"
+#include "navier_stokes_elements.h"
+
+namespace oomph
+{
+  //==========================================================================
+  /// \short Navier--Stokes equations discretised with equal-order
+  /// interpolation for the velocities and the pressure, stabilised by
+  /// the SUPG (streamline-upwind/Petrov-Galerkin) and PSPG
+  /// (pressure-stabilising/Petrov-Galerkin) terms of Tezduyar et al.
+  /// The velocities and the pressure are stored as values
+  /// 0,...,DIM-1 and DIM at every node and interpolated by the
+  /// geometric shape functions.
+  ///
+  /// Added to the Galerkin residuals are
+  /// - the SUPG term: the strong form of the momentum residual,
+  ///   tested against tau (a . grad psi), where a is the (scaled)
+  ///   convective velocity relative to the mesh;
+  /// - the PSPG term: the strong form of the momentum residual,
+  ///   tested against tau grad psi_p, which provides a (consistent)
+  ///   pressure-pressure block in the Jacobian.
+  /// .
+  /// The stabilisation parameter is
+  /// \f[ \tau = \alpha \left[ \left(\frac{2 Re St}{\Delta t}\right)^2 +
+  /// \left(\frac{2 |{\bf a}|}{h}\right)^2 +
+  /// \left(\frac{4 \mu_r}{h^2}\right)^2 \right]^{-1/2} \f]
+  /// where h is the element size and \f$ \alpha \f$ is a user-definable
+  /// scaling factor (defaults to one). The viscous term is omitted
+  /// from the strong form of the residual because it vanishes (or is
+  /// neglected) for linear interpolation.
+  //==========================================================================
+  template<unsigned DIM>
+  class StabilisedNavierStokesEquations
+    : public virtual NavierStokesEquations<DIM>
+  {
+  private:
+    /// Static default value for the scaling factor of the stabilisation
+    /// parameter (one)
+    static double Default_stabilisation_scaling_factor;
+
+  protected:
+    /// Pointer to the scaling factor for the stabilisation parameter
+    double* Stabilisation_scaling_factor_pt;
+
+    /// \short Element size used in the stabilisation parameter:
+    /// Edge length of the (DIM-dimensional) cube with the same volume
+    /// as the element. Can be overloaded in derived elements.
+    virtual double stabilisation_element_size() const
+    {
+      return pow(this->size(), 1.0 / double(DIM));
+    }
+
+    /// \short Compute the residuals for the Navier--Stokes equations,
+    /// including the SUPG and PSPG terms.
+    /// Flag=1 (or 0): do (or don't) compute the Jacobian as well.
+    /// Flag=2: Fill in mass matrix too.
+    void fill_in_generic_residual_contribution_nst(
+      Vector<double>& residuals,
+      DenseMatrix<double>& jacobian,
+      DenseMatrix<double>& mass_matrix,
+      unsigned flag);
+
+    /// \short Velocity shape and test functions and their derivs
+    /// w.r.t. to global coords at local coordinate s (taken from geometry)
+    /// Return Jacobian of mapping between local and global coordinates.
+    double dshape_and_dtest_eulerian_nst(const Vector<double>& s,
+                                         Shape& psi,
+                                         DShape& dpsidx,
+                                         Shape& test,
+                                         DShape& dtestdx) const
+    {
+      // Call the geometrical shape functions and derivatives
+      double J = this->dshape_eulerian(s, psi, dpsidx);
+
+      // The test functions are equal to the shape functions
+      test = psi;
+      dtestdx = dpsidx;
+
+      // Return the jacobian
+      return J;
+    }
+
+    /// \short Velocity shape and test functions and their derivs
+    /// w.r.t. to global coords at ipt-th integation point (taken from
+    /// geometry). Return Jacobian of mapping between local and global
+    /// coordinates.
+    double dshape_and_dtest_eulerian_at_knot_nst(const unsigned& ipt,
+                                                 Shape& psi,
+                                                 DShape& dpsidx,
+                                                 Shape& test,
+                                                 DShape& dtestdx) const
+    {
+      // Call the geometrical shape functions and derivatives
+      double J = this->dshape_eulerian_at_knot(ipt, psi, dpsidx);
+
+      // The test functions are equal to the shape functions
+      test = psi;
+      dtestdx = dpsidx;
+
+      // Return the jacobian
+      return J;
+    }
+
+    /// \short Shape/test functions and derivs w.r.t. to global coords at
+    /// integration point ipt; return Jacobian of mapping (J). Also compute
+    /// derivatives of dpsidx, dtestdx and J w.r.t. nodal coordinates.
+    double dshape_and_dtest_eulerian_at_knot_nst(
+      const unsigned& ipt,
+      Shape& psi,
+      DShape& dpsidx,
+      RankFourTensor<double>& d_dpsidx_dX,
+      Shape& test,
+      DShape& dtestdx,
+      RankFourTensor<double>& d_dtestdx_dX,
+      DenseMatrix<double>& djacobian_dX) const;
+
+  public:
+    /// \short Constructor: Set the scaling factor for the stabilisation
+    /// parameter to its default value (one).
+    StabilisedNavierStokesEquations() : NavierStokesEquations<DIM>()
+    {
+      Stabilisation_scaling_factor_pt = &Default_stabilisation_scaling_factor;
+    }
+
+    /// Broken copy constructor
+    StabilisedNavierStokesEquations(
+      const StabilisedNavierStokesEquations<DIM>& dummy)
+    {
+      BrokenCopy::broken_copy("StabilisedNavierStokesEquations");
+    }
+
+    /// Broken assignment operator
+    void operator=(const StabilisedNavierStokesEquations<DIM>&)
+    {
+      BrokenCopy::broken_assign("StabilisedNavierStokesEquations");
+    }
+
+    /// Scaling factor for the stabilisation parameter
+    const double& stabilisation_scaling_factor() const
+    {
+      return *Stabilisation_scaling_factor_pt;
+    }
+
+    /// Pointer to the scaling factor for the stabilisation parameter
+    double*& stabilisation_scaling_factor_pt()
+    {
+      return Stabilisation_scaling_factor_pt;
+    }
+
+    /// \short Number of values (pinned or dofs) required at node n:
+    /// DIM velocities and the pressure.
+    unsigned required_nvalue(const unsigned& n) const
+    {
+      return DIM + 1;
+    }
+
+    /// Pressure shape functions at local coordinate s (equal order)
+    void pshape_nst(const Vector<double>& s, Shape& psi) const
+    {
+      this->shape(s, psi);
+    }
+
+    /// Pressure shape and test functions at local coordinate s
+    void pshape_nst(const Vector<double>& s, Shape& psi, Shape& test) const
+    {
+      // Call the pressure shape functions
+      this->pshape_nst(s, psi);
+
+      // Test functions are shape functions
+      test = psi;
+    }
+
+    /// \short Pressure shape and test functions and their derivs
+    /// w.r.t. to global coords at local coordinate s (taken from geometry).
+    /// Return Jacobian of mapping between local and global coordinates.
+    double dpshape_and_dptest_eulerian_nst(const Vector<double>& s,
+                                           Shape& ppsi,
+                                           DShape& dppsidx,
+                                           Shape& ptest,
+                                           DShape& dptestdx) const
+    {
+      // Call the geometrical shape functions and derivatives
+      double J = this->dshape_eulerian(s, ppsi, dppsidx);
+
+      // The test functions are equal to the shape functions
+      ptest = ppsi;
+      dptestdx = dppsidx;
+
+      // Return the jacobian
+      return J;
+    }
+
+    /// \short Set the value at which the pressure is stored in the nodes
+    int p_nodal_index_nst() const
+    {
+      return static_cast<int>(DIM);
+    }
+
+    /// Return the local equation numbers for the pressure values.
+    int p_local_eqn(const unsigned& n) const
+    {
+      return this->nodal_local_eqn(n, p_nodal_index_nst());
+    }
+
+    /// \short Access function for the pressure values at local pressure
+    /// node n_p (const version)
+    double p_nst(const unsigned& n_p) const
+    {
+      return this->nodal_value(n_p, p_nodal_index_nst());
+    }
+
+    /// \short Access function for the pressure values at local pressure
+    /// node n_p at time level t (const version)
+    double p_nst(const unsigned& t, const unsigned& n_p) const
+    {
+      return this->nodal_value(t, n_p, p_nodal_index_nst());
+    }
+
+    /// Return number of pressure values: One at each node.
+    unsigned npres_nst() const
+    {
+      return this->nnode();
+    }
+
+    /// Pin p_dof-th pressure dof and set it to value specified by p_value.
+    void fix_pressure(const unsigned& p_dof, const double& p_value)
+    {
+      this->node_pt(p_dof)->pin(p_nodal_index_nst());
+      this->node_pt(p_dof)->set_value(p_nodal_index_nst(), p_value);
+    }
+
+    /// \short Compute derivatives of elemental residual vector with respect
+    /// to nodal coordinates. The analytical version in
+    /// NavierStokesEquations only covers the Galerkin terms, so we use
+    /// finite differencing (default implementation in FiniteElement).
+    void get_dresidual_dnodal_coordinates(
+      RankThreeTensor<double>& dresidual_dnodal_coordinates)
+    {
+      FiniteElement::get_dresidual_dnodal_coordinates(
+        dresidual_dnodal_coordinates);
+    }
+
+    /// \short Hessian tensor vector products: Not implemented for the
+    /// stabilised equations (the version in NavierStokesEquations only
+    /// covers the Galerkin terms).
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      throw OomphLibError(
+        "Hessian vector products are not implemented for the stabilised "
+        "Navier-Stokes equations.\n",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+
+    /// \short  Add to the set \c paired_load_data pairs containing
+    /// - the pointer to a Data object
+    /// and
+    /// - the index of the value in that Data object
+    /// .
+    /// for all values (pressures, velocities) that affect the
+    /// load computed in the \c get_load(...) function.
+    void identify_load_data(
+      std::set<std::pair<Data*, unsigned>>& paired_load_data);
+
+    /// \short  Add to the set \c paired_pressure_data pairs
+    /// containing
+    /// - the pointer to a Data object
+    /// and
+    /// - the index of the value in that Data object
+    /// .
+    /// for all pressure values that affect the
+    /// load computed in the \c get_load(...) function.
+    void identify_pressure_data(
+      std::set<std::pair<Data*, unsigned>>& paired_pressure_data);
+
+    /// \short Returns the number of "DOF types" that degrees of freedom
+    /// in this element are sub-divided into: Velocity and pressure.
+    unsigned ndof_types() const
+    {
+      return DIM + 1;
+    }
+
+    /// \short Create a list of pairs for all unknowns in this element,
+    /// so that the first entry in each pair contains the global equation
+    /// number of the unknown, while the second one contains the number
+    /// of the "DOF type" that this unknown is associated with.
+    /// (Function can obviously only be called if the equation numbering
+    /// scheme has been set up.) Velocity=0,...,DIM-1; Pressure=DIM
+    void get_dof_numbers_for_unknowns(
+      std::list<std::pair<unsigned long, unsigned>>& dof_lookup_list) const;
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////
+
+
+  //==========================================================================
+  /// \short Stabilised Q1/Q1 Navier--Stokes elements: Bi/tri-linear
+  /// interpolation for velocities, pressure and positions, with SUPG/PSPG
+  /// stabilisation. They can be used within oomph-lib's block
+  /// preconditioning framework but, since the pressure-pressure block is
+  /// non-zero, the Jacobian can also be handled by general-purpose
+  /// (e.g. AMG or ILU) preconditioners.
+  //==========================================================================
+  template<unsigned DIM>
+  class QStabilisedNavierStokesElement
+    : public virtual QElement<DIM, 2>,
+      public virtual StabilisedNavierStokesEquations<DIM>
+  {
+  public:
+    /// Constructor, no internal data
+    QStabilisedNavierStokesElement()
+      : QElement<DIM, 2>(), StabilisedNavierStokesEquations<DIM>()
+    {
+    }
+
+    /// Broken copy constructor
+    QStabilisedNavierStokesElement(
+      const QStabilisedNavierStokesElement<DIM>& dummy)
+    {
+      BrokenCopy::broken_copy("QStabilisedNavierStokesElement");
+    }
+
+    /// Broken assignment operator
+    void operator=(const QStabilisedNavierStokesElement<DIM>&)
+    {
+      BrokenCopy::broken_assign("QStabilisedNavierStokesElement");
+    }
+
+    /// \short Build FaceElements that apply the Robin boundary condition
+    /// to the pressure advection diffusion problem required by
+    /// Fp preconditioner
+    void build_fp_press_adv_diff_robin_bc_element(const unsigned& face_index)
+    {
+      this->Pressure_advection_diffusion_robin_element_pt.push_back(
+        new FpPressureAdvDiffRobinBCElement<
+          QStabilisedNavierStokesElement<DIM>>(this, face_index));
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(std::ostream& outfile)
+    {
+      NavierStokesEquations<DIM>::output(outfile);
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(std::ostream& outfile, const unsigned& nplot)
+    {
+      NavierStokesEquations<DIM>::output(outfile, nplot);
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(FILE* file_pt)
+    {
+      NavierStokesEquations<DIM>::output(file_pt);
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(FILE* file_pt, const unsigned& nplot)
+    {
+      NavierStokesEquations<DIM>::output(file_pt, nplot);
+    }
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the 2D stabilised Q1/Q1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<QStabilisedNavierStokesElement<2>>
+    : public virtual QElement<1, 2>
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : QElement<1, 2>() {}
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the 3D stabilised Q1/Q1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<QStabilisedNavierStokesElement<3>>
+    : public virtual QElement<2, 2>
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : QElement<2, 2>() {}
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the FaceGeometry of the 2D stabilised Q1/Q1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<FaceGeometry<QStabilisedNavierStokesElement<2>>>
+    : public virtual PointElement
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : PointElement() {}
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the FaceGeometry of the 3D stabilised Q1/Q1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<FaceGeometry<QStabilisedNavierStokesElement<3>>>
+    : public virtual QElement<1, 2>
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : QElement<1, 2>() {}
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////
+
+
+  //==========================================================================
+  /// \short Stabilised P1/P1 Navier--Stokes elements: Linear interpolation
+  /// for velocities, pressure and positions on triangles/tetrahedra, with
+  /// SUPG/PSPG stabilisation.
+  //==========================================================================
+  template<unsigned DIM>
+  class TStabilisedNavierStokesElement
+    : public virtual TElement<DIM, 2>,
+      public virtual StabilisedNavierStokesEquations<DIM>
+  {
+  protected:
+    /// \short Element size used in the stabilisation parameter:
+    /// Length of the short sides of the right-angled triangle
+    /// (tetrahedron) with the same volume as the element.
+    double stabilisation_element_size() const
+    {
+      double factor = (DIM == 2) ? 2.0 : 6.0;
+      return pow(factor * this->size(), 1.0 / double(DIM));
+    }
+
+  public:
+    /// Constructor, no internal data
+    TStabilisedNavierStokesElement()
+      : TElement<DIM, 2>(), StabilisedNavierStokesEquations<DIM>()
+    {
+    }
+
+    /// Broken copy constructor
+    TStabilisedNavierStokesElement(
+      const TStabilisedNavierStokesElement<DIM>& dummy)
+    {
+      BrokenCopy::broken_copy("TStabilisedNavierStokesElement");
+    }
+
+    /// Broken assignment operator
+    void operator=(const TStabilisedNavierStokesElement<DIM>&)
+    {
+      BrokenCopy::broken_assign("TStabilisedNavierStokesElement");
+    }
+
+    /// \short Build FaceElements that apply the Robin boundary condition
+    /// to the pressure advection diffusion problem required by
+    /// Fp preconditioner
+    void build_fp_press_adv_diff_robin_bc_element(const unsigned& face_index)
+    {
+      this->Pressure_advection_diffusion_robin_element_pt.push_back(
+        new FpPressureAdvDiffRobinBCElement<
+          TStabilisedNavierStokesElement<DIM>>(this, face_index));
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(std::ostream& outfile)
+    {
+      NavierStokesEquations<DIM>::output(outfile);
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(std::ostream& outfile, const unsigned& nplot)
+    {
+      NavierStokesEquations<DIM>::output(outfile, nplot);
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(FILE* file_pt)
+    {
+      NavierStokesEquations<DIM>::output(file_pt);
+    }
+
+    /// Redirect output to NavierStokesEquations output
+    void output(FILE* file_pt, const unsigned& nplot)
+    {
+      NavierStokesEquations<DIM>::output(file_pt, nplot);
+    }
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the 2D stabilised P1/P1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<TStabilisedNavierStokesElement<2>>
+    : public virtual TElement<1, 2>
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : TElement<1, 2>() {}
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the 3D stabilised P1/P1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<TStabilisedNavierStokesElement<3>>
+    : public virtual TElement<2, 2>
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : TElement<2, 2>() {}
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the FaceGeometry of the 2D stabilised P1/P1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<FaceGeometry<TStabilisedNavierStokesElement<2>>>
+    : public virtual PointElement
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : PointElement() {}
+  };
+
+
+  //=======================================================================
+  /// Face geometry of the FaceGeometry of the 3D stabilised P1/P1 elements
+  //=======================================================================
+  template<>
+  class FaceGeometry<FaceGeometry<TStabilisedNavierStokesElement<3>>>
+    : public virtual TElement<1, 2>
+  {
+  public:
+    /// Constructor: Call constructor of base
+    FaceGeometry() : TElement<1, 2>() {}
+  };
+
+} // namespace oomph
+
+#endif
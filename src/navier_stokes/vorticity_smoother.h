@@ -1058,6 +1058,71 @@ namespace oomph
       } // for (unsigned iplot=0;iplot<num_plot_points;iplot++)
     } // End of scalar_value_paraview
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+#ifdef PARANOID
+      if (i >= nscalar_paraview())
+      {
+        // Using a std::stringstream object to create a string
+        std::stringstream error_stream;
+
+        // Create the error message
+        error_stream << "These VorticitySmoother elements only store "
+                     << ncont_interpolated_values() << " fields, "
+                     << "but i is currently: " << i << std::endl;
+
+        // Throw an error
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Vector of local coordinates
+      Vector<double> s(N_dim, 0.0);
+
+      // Get the number of plot points
+      unsigned num_plot_points = this->nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+
+      // Create a container for the vorticity and its derivatives
+      Vector<Vector<double>> vort_and_derivs =
+        create_container_for_vorticity_and_derivatives();
+
+      // Loop over plot points
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        this->get_s_plot(iplot, nplot, s);
+
+        // Velocities
+        if (i < N_dim)
+        {
+          value[iplot] = this->interpolated_u_nst(s, i);
+        }
+        // Pressure
+        else if (i == N_dim)
+        {
+          value[iplot] = this->interpolated_p_nst(s);
+        }
+        // Vorticity and required derivatives
+        else
+        {
+          // Get vorticity and its derivatives (reconstructed)
+          vorticity_and_its_derivs(s, vort_and_derivs);
+
+          // Get the ID in the storage associated with i-th recovered dof
+          std::pair<unsigned, unsigned> id =
+            recovered_dof_to_container_id(i - N_dim - 1);
+          value[iplot] = (vort_and_derivs[id.first])[id.second];
+        }
+      }
+    } // End of get_scalar_values_paraview
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
@@ -189,6 +189,50 @@ namespace oomph
       }
     }
 
+
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+#ifdef PARANOID
+      if (i > 1)
+      {
+        std::stringstream error_stream;
+        error_stream << "PML Helmholtz elements only store 2 fields (real "
+                        "and imaginary) "
+                     << "so i must be 0 or 1 rather "
+                     << "than " << i << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Vector of local coordinates
+      Vector<double> s(DIM);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+        std::complex<double> u(interpolated_u_pml_helmholtz(s));
+
+        // Real part first, imaginary part second
+        if (i == 0)
+        {
+          value[iplot] = u.real();
+        }
+        else
+        {
+          value[iplot] = u.imag();
+        }
+      }
+    }
+
     /// \short Write values of the i-th scalar field at the plot points. Needs
     /// to be implemented for each new specific element type.
     void scalar_value_fct_paraview(
@@ -151,6 +151,36 @@ namespace oomph
       }
     }
 
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...)), without the
+    /// round trip through the output stream.
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+#ifdef PARANOID
+      if (i != 0)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Poisson elements only store a single field so i must be 0 rather"
+          << " than " << i << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      unsigned local_loop = this->nplot_points_paraview(nplot);
+      value.resize(local_loop);
+      Vector<double> s(DIM);
+      for (unsigned j = 0; j < local_loop; j++)
+      {
+        // Get the local coordinate of the required plot point
+        this->get_s_plot(j, nplot, s);
+        value[j] = this->interpolated_u_poisson(s);
+      }
+    }
+
     /// \short Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
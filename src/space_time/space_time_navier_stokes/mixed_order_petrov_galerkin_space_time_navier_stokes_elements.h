@@ -1395,6 +1395,56 @@ namespace oomph
     } // End of scalar_value_paraview
 
 
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+#ifdef PARANOID
+      if (i > DIM)
+      {
+        // Create an output stream
+        std::stringstream error_stream;
+
+        // Create the error message
+        error_stream << "These Navier Stokes elements only store " << DIM + 1
+                     << " fields, "
+                     << "but i is currently  " << i << std::endl;
+
+        // Throw the error message
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Vector of local coordinates
+      Vector<double> s(DIM + 1, 0.0);
+
+      // How many plot points do we have in total?
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      value.resize(num_plot_points);
+
+      // Loop over plot points
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get the local coordinates of the iplot-th plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Velocities
+        if (i < DIM)
+        {
+          value[iplot] = interpolated_u_nst(s, i);
+        }
+        // Pressure
+        else
+        {
+          value[iplot] = interpolated_p_nst(s);
+        }
+      }
+    } // End of get_scalar_values_paraview
+
+
     /// \short Write values of the i_field-th scalar field at the plot points.
     /// Needs to be implemented for each new specific element type.
     void scalar_value_fct_paraview(
@@ -243,6 +243,42 @@ namespace oomph
     } // End of scalar_value_paraview
 
 
+    /// \short Return the values of the i-th scalar field at the plot
+    /// points (as written by scalar_value_paraview(...))
+    void get_scalar_values_paraview(const unsigned& i,
+                                    const unsigned& nplot,
+                                    Vector<double>& value) const
+    {
+#ifdef PARANOID
+      if (i != 0)
+      {
+        std::stringstream error_stream;
+        error_stream << "Space-time unsteady heat elements only store a single "
+                     << "field so i must be 0 rather than " << i << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Get the number of plot points
+      unsigned local_loop = this->nplot_points_paraview(nplot);
+      value.resize(local_loop);
+
+      // Storage for the local coordinates
+      Vector<double> s(SPATIAL_DIM + 1);
+
+      // Loop over the plot points
+      for (unsigned j = 0; j < local_loop; j++)
+      {
+        // Get the local coordinate of the required plot point
+        this->get_s_plot(j, nplot, s);
+
+        // Store the interpolated solution value
+        value[j] = this->interpolated_u_ust_heat(s);
+      }
+    } // End of get_scalar_values_paraview
+
+
     /// \short Write values of the i-th scalar field at the plot points. Needs
     /// to be implemented for each new specific element type.
     void scalar_value_fct_paraview(